@@ -0,0 +1,28 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkUtils.hpp"
+#include "linalg/Affine3.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> Affine3<T> makeView() {
+  return Affine3<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(0, 0, 0), Vec3<T>(0, 1, 0));
+}
+
+template <typename T> Affine3<T> makeModel() { return {2, 0.5, -1, 3, 0.25, 1, 0, -2, 1, -1, 0.5, 4}; }
+
+} // namespace
+
+// Affine * affine products, as Mat4 and as Affine3.
+LINALG_BINARY_BENCHMARK(Mat4AffineMultiply, makeView<T>().toMat4(), makeModel<T>().toMat4(), a * b);
+LINALG_BINARY_BENCHMARK(Affine3Multiply, makeView<T>(), makeModel<T>(), a * b);
+
+// Projection * view products.
+LINALG_BINARY_BENCHMARK(Mat4ViewProjection, Mat4<T>::Perspective(1, 1.5, 0.1, 100), makeView<T>().toMat4(), a * b);
+LINALG_BINARY_BENCHMARK(Mat4Affine3ViewProjection, Mat4<T>::Perspective(1, 1.5, 0.1, 100), makeView<T>(), a * b);
+LINALG_BINARY_BENCHMARK(PerspectiveViewProjection, PerspectiveProjection<T>(1, 1.5, 0.1, 100), makeView<T>(), a * b);
+
+// Compare with BM_Mat4InverseAffine.
+LINALG_UNARY_BENCHMARK(Affine3Inverse, makeModel<T>(), a.inverse());
+LINALG_UNARY_BENCHMARK(Affine3TransformPoint, makeModel<T>(), a.transformPoint(Vec3<T>(1, 2, 3)));
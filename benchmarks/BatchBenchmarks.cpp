@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+using bench::makePoints;
+using bench::makeTransform;
+
+namespace {
+
+template <typename T> void BM_TransformPoints(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const Mat4<T>              mat   = makeTransform<T>();
+  const std::vector<Vec3<T>> in    = makePoints<T>(count);
+  std::vector<Vec3<T>>       out(count);
+  for(auto _ : state) {
+    transformPoints(mat, in.data(), out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(2 * sizeof(Vec3<T>)));
+}
+
+template <typename T> void BM_TransformPointsLoop(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const Mat4<T>              mat   = makeTransform<T>();
+  const std::vector<Vec3<T>> in    = makePoints<T>(count);
+  std::vector<Vec3<T>>       out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = toVec3(mat * toVec4(in[i]));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(2 * sizeof(Vec3<T>)));
+}
+
+template <typename T> void BM_TransformDirections(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const Mat4<T>              mat   = makeTransform<T>();
+  const std::vector<Vec3<T>> in    = makePoints<T>(count);
+  std::vector<Vec3<T>>       out(count);
+  for(auto _ : state) {
+    transformDirections(mat, in.data(), out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(2 * sizeof(Vec3<T>)));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_TransformPoints, float)->Arg(4096)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_TransformPointsLoop, float)->Arg(4096)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_TransformDirections, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_TransformPoints, double)->Arg(4096)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_TransformPointsLoop, double)->Arg(4096)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_TransformDirections, double)->Arg(4096);
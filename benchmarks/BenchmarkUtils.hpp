@@ -0,0 +1,85 @@
+/**
+ * @file BenchmarkUtils.hpp
+ * @brief Helpers shared by the benchmark sources.
+ */
+#ifndef LINALG_BENCHMARK_UTILS_HPP
+#define LINALG_BENCHMARK_UTILS_HPP
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <vector>
+#include "linalg/Mat4.hpp"
+#include "linalg/Vec3.hpp"
+
+namespace bench {
+
+/**
+ * @brief Measures op(a) on one value. The input is passed through
+ * DoNotOptimize every iteration so the call cannot be hoisted or folded.
+ */
+template <typename A, typename Op> void runUnary(benchmark::State& state, A a, Op op) {
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    auto result = op(a);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Measures op(a, b) on two values.
+ */
+template <typename A, typename B, typename Op> void runBinary(benchmark::State& state, A a, B b, Op op) {
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(b);
+    auto result = op(a, b);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Returns the affine transform the batch benchmarks apply.
+ */
+template <typename T> linalg::Mat4<T> makeTransform() {
+  return linalg::Mat4<T>({{2, -1, 0.5, 3}, {0.25, 1, -2, -1}, {1, 0, 3, 2}, {0, 0, 0, 1}});
+}
+
+/**
+ * @brief Returns count points along a line.
+ */
+template <typename T> std::vector<linalg::Vec3<T>> makePoints(std::size_t count) {
+  std::vector<linalg::Vec3<T>> points(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const T t = static_cast<T>(i) * static_cast<T>(0.001);
+    points[i] = linalg::Vec3<T>(t, 1 - t, 2 * t);
+  }
+  return points;
+}
+
+} // namespace bench
+
+/**
+ * @brief Defines BM_<NAME> measuring EXPR on the value a = INIT, for float and
+ * double. EXPR and INIT may use T and the names a (by value).
+ */
+#define LINALG_UNARY_BENCHMARK(NAME, INIT, EXPR)                                                                       \
+  template <typename T> void BM_##NAME(benchmark::State& state) {                                                      \
+    bench::runUnary(state, INIT, [](decltype(INIT) a) { return EXPR; });                                               \
+  }                                                                                                                    \
+  BENCHMARK_TEMPLATE(BM_##NAME, float);                                                                                \
+  BENCHMARK_TEMPLATE(BM_##NAME, double)
+
+/**
+ * @brief Defines BM_<NAME> measuring EXPR on the values a = INIT_A and
+ * b = INIT_B, for float and double.
+ */
+#define LINALG_BINARY_BENCHMARK(NAME, INIT_A, INIT_B, EXPR)                                                            \
+  template <typename T> void BM_##NAME(benchmark::State& state) {                                                      \
+    bench::runBinary(state, INIT_A, INIT_B, [](decltype(INIT_A) a, decltype(INIT_B) b) { return EXPR; });              \
+  }                                                                                                                    \
+  BENCHMARK_TEMPLATE(BM_##NAME, float);                                                                                \
+  BENCHMARK_TEMPLATE(BM_##NAME, double)
+
+#endif // LINALG_BENCHMARK_UTILS_HPP
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "linalg/Bounds.hpp"
+
+using namespace linalg;
+
+namespace {
+
+constexpr std::size_t BOXES = 16384;
+
+std::vector<AABB<float>> makeBoxes() {
+  std::vector<AABB<float>> boxes(BOXES);
+  for(std::size_t i = 0; i < BOXES; ++i) {
+    const Vec3<float> center(static_cast<float>(i % 64) - 32, static_cast<float>(i / 64 % 16) - 8,
+                             -static_cast<float>(i / 1024) * 4);
+    boxes[i] = AABB<float>::FromCenterExtent(center, Vec3<float>(0.5F + 0.001F * static_cast<float>(i), 0.5F, 0.5F));
+  }
+  return boxes;
+}
+
+Frustum<float> makeFrustum() {
+  return Frustum<float>::FromMatrix(Mat4<float>::Perspective(1.2F, 1.5F, 0.5F, 50) *
+                                    Mat4<float>::LookAt(Vec3<float>(0, 0, 5), Vec3<float>(0, 0, 0)));
+}
+
+void BM_CullLoop(benchmark::State& state) {
+  const std::vector<AABB<float>> boxes   = makeBoxes();
+  const Frustum<float>           frustum = makeFrustum();
+  std::vector<std::uint32_t>     visible(BOXES);
+  for(auto _ : state) {
+    std::size_t count = 0;
+    for(std::size_t i = 0; i < BOXES; ++i) {
+      if(frustum.intersects(boxes[i])) {
+        visible[count++] = static_cast<std::uint32_t>(i);
+      }
+    }
+    benchmark::DoNotOptimize(count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BOXES));
+}
+
+void BM_CullSoA(benchmark::State& state) {
+  const std::vector<AABB<float>> aos     = makeBoxes();
+  const AABBSoA<float>           boxes   = AABBSoA<float>::FromAoS(aos.data(), aos.size());
+  const Frustum<float>           frustum = makeFrustum();
+  std::vector<std::uint32_t>     visible(BOXES);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(cull(frustum, boxes, visible.data()));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BOXES));
+}
+
+void BM_RayBoxesLoop(benchmark::State& state) {
+  const std::vector<AABB<float>> boxes = makeBoxes();
+  const Vec3<float>              origin(0.3F, -0.2F, 5);
+  const Vec3<float>              inv_direction(5, 10, -1);
+  std::vector<std::uint32_t>     hits(BOXES);
+  for(auto _ : state) {
+    std::size_t count = 0;
+    for(std::size_t i = 0; i < BOXES; ++i) {
+      float t;
+      if(boxes[i].intersectRay(origin, inv_direction, 100, t)) {
+        hits[count++] = static_cast<std::uint32_t>(i);
+      }
+    }
+    benchmark::DoNotOptimize(count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BOXES));
+}
+
+void BM_RayBoxesSoA(benchmark::State& state) {
+  const std::vector<AABB<float>> aos   = makeBoxes();
+  const AABBSoA<float>           boxes = AABBSoA<float>::FromAoS(aos.data(), aos.size());
+  std::vector<std::uint32_t>     hits(BOXES);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(
+        intersectRay(boxes, Vec3<float>(0.3F, -0.2F, 5), Vec3<float>(5, 10, -1), 100.0F, hits.data()));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BOXES));
+}
+
+void BM_AABBTransformed(benchmark::State& state) {
+  const AABB<float> box(Vec3<float>(-1, 0.5F, 2), Vec3<float>(3, 1, 4));
+  Mat4<float>       mat = Mat4<float>::LookAt(Vec3<float>(1, 2, 3), Vec3<float>(0, 0, 0));
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(mat);
+    benchmark::DoNotOptimize(box.transformed(mat));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_CullLoop);
+BENCHMARK(BM_CullSoA);
+BENCHMARK(BM_RayBoxesLoop);
+BENCHMARK(BM_RayBoxesSoA);
+BENCHMARK(BM_AABBTransformed);
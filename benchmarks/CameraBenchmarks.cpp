@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> std::vector<Camera<T>> makeCameras(std::size_t count) {
+  std::vector<Camera<T>> cameras;
+  for(std::size_t i = 0; i < count; ++i) {
+    const T angle = T(0.01) * T(i);
+    cameras.push_back({Vec3<T>(std::cos(angle), 1, std::sin(angle)), Vec3<T>(), Vec3<T>(0, 1, 0)});
+  }
+  return cameras;
+}
+
+// Reference: build both matrices and multiply them for every camera.
+template <typename T> void BM_ViewProjectionMat4(benchmark::State& state) {
+  const auto                   count   = static_cast<std::size_t>(state.range(0));
+  const std::vector<Camera<T>> cameras = makeCameras<T>(count);
+  std::vector<Mat4<T>>         out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = Mat4<T>::Perspective(T(1), T(1.5), T(0.1), T(100)) *
+               Mat4<T>::LookAt(cameras[i].eye, cameras[i].center, cameras[i].up);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_ViewProjection(benchmark::State& state) {
+  const auto                   count   = static_cast<std::size_t>(state.range(0));
+  const std::vector<Camera<T>> cameras = makeCameras<T>(count);
+  std::vector<Mat4<T>>         out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = viewProjection(cameras[i].eye, cameras[i].center, cameras[i].up, T(1), T(1.5), T(0.1), T(100));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_ViewProjections(benchmark::State& state) {
+  const auto                     count   = static_cast<std::size_t>(state.range(0));
+  const std::vector<Camera<T>>   cameras = makeCameras<T>(count);
+  std::vector<Mat4<T>>           out(count);
+  const PerspectiveProjection<T> projection(T(1), T(1.5), T(0.1), T(100));
+  for(auto _ : state) {
+    viewProjections(projection, cameras.data(), out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_ViewProjectionMat4, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_ViewProjection, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_ViewProjections, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_ViewProjectionMat4, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_ViewProjection, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_ViewProjections, double)->Arg(4096);
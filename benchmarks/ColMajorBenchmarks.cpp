@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+#include "linalg/ColMajor.hpp"
+
+using namespace linalg;
+
+namespace {
+
+constexpr std::size_t MATRICES = 4096;
+
+template <typename M> std::vector<M> makeModels() {
+  std::vector<M> models(MATRICES);
+  for(std::size_t i = 0; i < MATRICES; ++i) {
+    const float t = static_cast<float>(i) * 0.01F;
+    models[i]     = M(Mat4<float>(1, 0, 0, t, 0, 1, 0, -t, 0, 0, 1, 2 * t, 0, 0, 0, 1));
+  }
+  return models;
+}
+
+// Model-view-projection matrices computed row-major and transposed for upload.
+void BM_UploadRowMajor(benchmark::State& state) {
+  const std::vector<Mat4<float>> models    = makeModels<Mat4<float>>();
+  const Mat4<float>              view_proj = Mat4<float>::Perspective(1, 1.5F, 0.1F, 100) *
+                                Mat4<float>::LookAt(Vec3<float>(1, 2, 3), Vec3<float>(0, 0, 0));
+  std::vector<float> buffer(16 * MATRICES);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < MATRICES; ++i) {
+      const Mat4<float> mvp = (view_proj * models[i]).transposed();
+      std::memcpy(&buffer[16 * i], mvp.data(), 16 * sizeof(float));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(MATRICES));
+}
+
+// The same matrices computed column-major and copied as they are.
+void BM_UploadColMajor(benchmark::State& state) {
+  const std::vector<Mat4ColMajor<float>> models    = makeModels<Mat4ColMajor<float>>();
+  const Mat4ColMajor<float>              view_proj = Mat4ColMajor<float>::Perspective(1, 1.5F, 0.1F, 100) *
+                                        Mat4ColMajor<float>::LookAt(Vec3<float>(1, 2, 3), Vec3<float>(0, 0, 0));
+  std::vector<float> buffer(16 * MATRICES);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < MATRICES; ++i) {
+      const Mat4ColMajor<float> mvp = view_proj * models[i];
+      std::memcpy(&buffer[16 * i], mvp.data(), 16 * sizeof(float));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(MATRICES));
+}
+
+} // namespace
+
+BENCHMARK(BM_UploadRowMajor);
+BENCHMARK(BM_UploadColMajor);
@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "linalg/Dispatch.hpp"
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> std::vector<Vec3<T>> makeVectors(std::size_t count) {
+  std::vector<Vec3<T>> vectors(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const T t  = static_cast<T>(i) * static_cast<T>(0.001);
+    vectors[i] = Vec3<T>(t + 1, 1 - t, 2 * t);
+  }
+  return vectors;
+}
+
+/**
+ * @brief Activates isa for the duration of a benchmark, skipping it when the
+ * host does not support it.
+ */
+bool activate(benchmark::State& state, dispatch::Isa isa) {
+  if(!dispatch::isSupported(isa)) {
+    state.SkipWithError("instruction set not supported");
+    return false;
+  }
+  dispatch::setActiveIsa(isa);
+  state.SetLabel(dispatch::isaName(isa));
+  return true;
+}
+
+template <typename T, dispatch::Isa ISA> void BM_DispatchTransformPoints(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const Mat4<T>              mat   = Mat4<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(0, 0, 0));
+  const std::vector<Vec3<T>> in    = makeVectors<T>(count);
+  std::vector<Vec3<T>>       out(count);
+  if(activate(state, ISA)) {
+    for(auto _ : state) {
+      dispatch::transformPoints(mat, in.data(), out.data(), count);
+      benchmark::ClobberMemory();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T, dispatch::Isa ISA> void BM_DispatchNormalize(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<T>> in    = makeVectors<T>(count);
+  std::vector<Vec3<T>>       out(count);
+  if(activate(state, ISA)) {
+    for(auto _ : state) {
+      dispatch::normalized(in.data(), out.data(), count);
+      benchmark::ClobberMemory();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T, dispatch::Isa ISA> void BM_DispatchDot(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<T>> in    = makeVectors<T>(count);
+  std::vector<T>             out(count);
+  if(activate(state, ISA)) {
+    for(auto _ : state) {
+      dispatch::dot(in.data(), in.data(), out.data(), count);
+      benchmark::ClobberMemory();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T, dispatch::Isa ISA> void BM_DispatchMinMax(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<T>> in    = makeVectors<T>(count);
+  Vec3<T>                    lo;
+  Vec3<T>                    hi;
+  if(activate(state, ISA)) {
+    for(auto _ : state) {
+      dispatch::minMax(in.data(), count, lo, hi);
+      benchmark::DoNotOptimize(lo);
+      benchmark::DoNotOptimize(hi);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+#define LINALG_DISPATCH_BENCHMARKS(NAME, T)                                                                            \
+  BENCHMARK_TEMPLATE(NAME, T, dispatch::Isa::Scalar)->Arg(4096);                                                       \
+  BENCHMARK_TEMPLATE(NAME, T, dispatch::Isa::SSE2)->Arg(4096);                                                         \
+  BENCHMARK_TEMPLATE(NAME, T, dispatch::Isa::AVX2)->Arg(4096);                                                         \
+  BENCHMARK_TEMPLATE(NAME, T, dispatch::Isa::AVX512)->Arg(4096);                                                       \
+  BENCHMARK_TEMPLATE(NAME, T, dispatch::Isa::NEON)->Arg(4096)
+
+LINALG_DISPATCH_BENCHMARKS(BM_DispatchTransformPoints, float);
+LINALG_DISPATCH_BENCHMARKS(BM_DispatchTransformPoints, double);
+LINALG_DISPATCH_BENCHMARKS(BM_DispatchNormalize, float);
+LINALG_DISPATCH_BENCHMARKS(BM_DispatchNormalize, double);
+LINALG_DISPATCH_BENCHMARKS(BM_DispatchDot, float);
+LINALG_DISPATCH_BENCHMARKS(BM_DispatchDot, double);
+LINALG_DISPATCH_BENCHMARKS(BM_DispatchMinMax, float);
+LINALG_DISPATCH_BENCHMARKS(BM_DispatchMinMax, double);
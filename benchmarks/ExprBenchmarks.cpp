@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkUtils.hpp"
+#include "linalg/Expr.hpp"
+
+using namespace linalg;
+
+namespace {
+
+LINALG_BINARY_BENCHMARK(Vec3ChainEager, Vec3<T>(1, -2, 3), Vec3<T>(0.5, 4, -1),
+                        T(2) * a + (b - a) * T(3) - b / T(4));
+LINALG_BINARY_BENCHMARK(Vec3ChainLazy, Vec3<T>(1, -2, 3), Vec3<T>(0.5, 4, -1),
+                        (T(2) * lazy(a) + (lazy(b) - a) * T(3) - lazy(b) / T(4)).eval());
+LINALG_BINARY_BENCHMARK(Vec3ChainDotEager, Vec3<T>(1, -2, 3), Vec3<T>(0.5, 4, -1), dot(a - b, a + b));
+LINALG_BINARY_BENCHMARK(Vec3ChainDotLazy, Vec3<T>(1, -2, 3), Vec3<T>(0.5, 4, -1), dot(lazy(a) - b, lazy(a) + b));
+
+template <typename T> Mat4<T> makeMatrix(T seed) {
+  Mat4<T> mat;
+  for(int i = 0; i < 16; ++i) {
+    mat[i] = seed + static_cast<T>(i) * static_cast<T>(0.25);
+  }
+  return mat;
+}
+
+template <typename T> void BM_Mat4ChainVec4Eager(benchmark::State& state) {
+  Mat4<T>       proj  = makeMatrix<T>(1);
+  const Mat4<T> view  = makeMatrix<T>(-2);
+  const Mat4<T> model = makeMatrix<T>(0.5);
+  const Vec4<T> point(1, 2, 3, 1);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(proj);
+    Vec4<T> result = proj * view * model * point;
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T> void BM_Mat4ChainVec4Lazy(benchmark::State& state) {
+  Mat4<T>       proj  = makeMatrix<T>(1);
+  const Mat4<T> view  = makeMatrix<T>(-2);
+  const Mat4<T> model = makeMatrix<T>(0.5);
+  const Vec4<T> point(1, 2, 3, 1);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(proj);
+    Vec4<T> result = lazy(proj) * view * model * point;
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_Mat4ChainVec4Eager, float);
+BENCHMARK_TEMPLATE(BM_Mat4ChainVec4Eager, double);
+BENCHMARK_TEMPLATE(BM_Mat4ChainVec4Lazy, float);
+BENCHMARK_TEMPLATE(BM_Mat4ChainVec4Lazy, double);
+
+} // namespace
@@ -0,0 +1,19 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkUtils.hpp"
+#include "linalg/Generic.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> Mat4<T> makeMat4() { return Mat4<T>::Perspective(1, 1.5, 0.1, 100); }
+
+template <typename T> Mat3x4<T> makeMat3x4() { return {2, 0.5, -1, 3, 0.25, 1, 0, -2, 1, -1, 0.5, 4}; }
+
+} // namespace
+
+// Generic products compared with BM_Mat4Multiply and BM_Affine3Multiply.
+LINALG_BINARY_BENCHMARK(GenericMat4Multiply, (Mat<T, 4, 4>(makeMat4<T>())), (Mat<T, 4, 4>(makeMat4<T>())), a * b);
+LINALG_BINARY_BENCHMARK(GenericMat3x4Multiply4x3, makeMat3x4<T>(), makeMat3x4<T>().transposed(), a * b);
+LINALG_BINARY_BENCHMARK(GenericMat3x4MultiplyVec4, makeMat3x4<T>(), (Vec<T, 4>(1, 2, 3, 1)), a * b);
+LINALG_BINARY_BENCHMARK(GenericVec4Dot, (Vec<T, 4>(1, 2, 3, 4)), (Vec<T, 4>(-1, 0.5, 2, 3)), dot(a, b));
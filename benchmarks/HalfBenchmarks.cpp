@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "linalg/Half.hpp"
+
+using namespace linalg;
+
+namespace {
+
+std::vector<Vec3<float>> makeNormals(std::size_t count) {
+  std::vector<Vec3<float>> normals(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const float t = static_cast<float>(i) * 0.001F;
+    normals[i]    = Vec3<float>(t, 1 - t, 0.5F).normalized();
+  }
+  return normals;
+}
+
+// Storage read and compute array written, against the packed float layout.
+template <typename Storage> void BM_UnpackVec3(benchmark::State& state) {
+  const auto                     count   = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<float>> normals = makeNormals(count);
+  std::vector<Storage>           in(count);
+  pack(normals.data(), in.data(), count);
+  std::vector<Vec3<float>> out(count);
+  for(auto _ : state) {
+    unpack(in.data(), out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(Storage)));
+}
+
+template <typename Storage> void BM_PackVec3(benchmark::State& state) {
+  const auto                     count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<float>> in    = makeNormals(count);
+  std::vector<Storage>           out(count);
+  for(auto _ : state) {
+    pack(in.data(), out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(Storage)));
+}
+
+void BM_UnpackHalfVec3Loop(benchmark::State& state) {
+  const auto                     count   = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<float>> normals = makeNormals(count);
+  std::vector<HalfVec3>          in(count);
+  pack(normals.data(), in.data(), count);
+  std::vector<Vec3<float>> out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = in[i].load();
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_UnpackHalf(benchmark::State& state) {
+  const auto         count = static_cast<std::size_t>(state.range(0));
+  std::vector<Half>  in(count, Half(0.25F));
+  std::vector<float> out(count);
+  for(auto _ : state) {
+    unpack(in.data(), out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_PackHalf(benchmark::State& state) {
+  const auto         count = static_cast<std::size_t>(state.range(0));
+  std::vector<float> in(count, 0.25F);
+  std::vector<Half>  out(count);
+  for(auto _ : state) {
+    pack(in.data(), out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+// 4096 elements stay in cache; 2^21 elements stream from memory, where the
+// halved storage size shows.
+BENCHMARK_TEMPLATE(BM_UnpackVec3, HalfVec3)->Arg(4096)->Arg(1 << 21);
+BENCHMARK_TEMPLATE(BM_UnpackVec3, PackedVec3<float>)->Arg(4096)->Arg(1 << 21);
+BENCHMARK(BM_UnpackHalfVec3Loop)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_PackVec3, HalfVec3)->Arg(4096)->Arg(1 << 21);
+BENCHMARK_TEMPLATE(BM_PackVec3, PackedVec3<float>)->Arg(4096)->Arg(1 << 21);
+BENCHMARK(BM_UnpackHalf)->Arg(4096);
+BENCHMARK(BM_PackHalf)->Arg(4096);
@@ -0,0 +1,25 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkUtils.hpp"
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> Mat3<T> makeMatrix(T seed) {
+  return Mat3<T>(seed + 4, seed * 2, 1, -seed, seed + 3, 2, 1, seed / 2, seed + 5);
+}
+
+LINALG_UNARY_BENCHMARK(Mat3Transposed, makeMatrix<T>(1), a.transposed());
+LINALG_UNARY_BENCHMARK(Mat3Determinant, makeMatrix<T>(1), a.determinant());
+LINALG_UNARY_BENCHMARK(Mat3Inverse, makeMatrix<T>(1), a.inverse());
+LINALG_UNARY_BENCHMARK(Mat3Index, makeMatrix<T>(1), a(1, 2));
+LINALG_BINARY_BENCHMARK(Mat3Multiply, makeMatrix<T>(1), makeMatrix<T>(-2), a * b);
+LINALG_BINARY_BENCHMARK(Mat3MultiplyAssign, makeMatrix<T>(1), makeMatrix<T>(-2), a *= b);
+LINALG_BINARY_BENCHMARK(Mat3Vec3Multiply, makeMatrix<T>(1), Vec3<T>(1, 2, 3), a * b);
+LINALG_BINARY_BENCHMARK(Mat3Equal, makeMatrix<T>(1), makeMatrix<T>(-2), a == b);
+LINALG_BINARY_BENCHMARK(Mat3IsApprox, makeMatrix<T>(1), makeMatrix<T>(-2), a.isApprox(b, T(1e-6)));
+LINALG_BINARY_BENCHMARK(Mat3EqualSame, makeMatrix<T>(1), makeMatrix<T>(1), a == b);
+LINALG_BINARY_BENCHMARK(Mat3IsApproxSame, makeMatrix<T>(1), makeMatrix<T>(1), a.isApprox(b, T(1e-6)));
+
+} // namespace
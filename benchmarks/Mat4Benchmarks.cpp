@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkUtils.hpp"
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> Mat4<T> makeMatrix(T seed) {
+  Mat4<T> mat;
+  for(int i = 0; i < 16; ++i) {
+    mat[i] = seed + static_cast<T>(i) * static_cast<T>(0.25);
+  }
+  return mat;
+}
+
+template <typename T> void BM_Mat4Multiply(benchmark::State& state) {
+  Mat4<T>       a = makeMatrix<T>(1);
+  const Mat4<T> b = makeMatrix<T>(-2);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    Mat4<T> result = a * b;
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T> void BM_Mat4MultiplyScalar(benchmark::State& state) {
+  Mat4<T>       a = makeMatrix<T>(1);
+  const Mat4<T> b = makeMatrix<T>(-2);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    Mat4<T> result;
+    detail::Mat4ScalarKernels<T>::multiply(a.data(), b.data(), &result.m[0][0]);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T> void BM_Mat4Vec4Multiply(benchmark::State& state) {
+  const Mat4<T> mat = makeMatrix<T>(1);
+  Vec4<T>       vec(1, 2, 3, 4);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(vec);
+    Vec4<T> result = mat * vec;
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T> void BM_Mat4Vec4MultiplyScalar(benchmark::State& state) {
+  const Mat4<T> mat = makeMatrix<T>(1);
+  Vec4<T>       vec(1, 2, 3, 4);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(vec);
+    Vec4<T> result;
+    detail::Mat4ScalarKernels<T>::transform(mat.data(), &vec.x, &result.x);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T> Mat4<T> makeAffine() {
+  Mat4<T> mat = makeMatrix<T>(1);
+  mat.m[0][0] += 4;
+  mat.m[1][1] += 4;
+  mat.m[2][2] += 4;
+  mat.m[3][0] = mat.m[3][1] = mat.m[3][2] = 0;
+  mat.m[3][3]                             = 1;
+  return mat;
+}
+
+template <typename T> void BM_Mat4Inverse(benchmark::State& state) {
+  Mat4<T> mat = makeAffine<T>();
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(mat);
+    Mat4<T> result = mat.inverse();
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T> void BM_Mat4InverseScalar(benchmark::State& state) {
+  Mat4<T> mat = makeAffine<T>();
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(mat);
+    Mat4<T> result;
+    detail::Mat4ScalarKernels<T>::inverse(mat.data(), &result.m[0][0]);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T> void BM_Mat4InverseAffine(benchmark::State& state) {
+  Mat4<T> mat = makeAffine<T>();
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(mat);
+    Mat4<T> result = mat.inverseAffine();
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T> void BM_Mat4InverseRigid(benchmark::State& state) {
+  Mat4<T> mat = makeAffine<T>();
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(mat);
+    Mat4<T> result = mat.inverseRigid();
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+LINALG_UNARY_BENCHMARK(Mat4Transposed, makeMatrix<T>(1), a.transposed());
+LINALG_BINARY_BENCHMARK(Mat4MultiplyAssign, makeMatrix<T>(1), makeMatrix<T>(-2), a *= b);
+LINALG_BINARY_BENCHMARK(Mat4Equal, makeMatrix<T>(1), makeMatrix<T>(-2), a == b);
+LINALG_BINARY_BENCHMARK(Mat4IsApprox, makeMatrix<T>(1), makeMatrix<T>(-2), a.isApprox(b, T(1e-6)));
+LINALG_BINARY_BENCHMARK(Mat4EqualSame, makeMatrix<T>(1), makeMatrix<T>(1), a == b);
+LINALG_BINARY_BENCHMARK(Mat4IsApproxSame, makeMatrix<T>(1), makeMatrix<T>(1), a.isApprox(b, T(1e-6)));
+LINALG_BINARY_BENCHMARK(Mat4LookAt, Vec3<T>(1, 2, 3), Vec3<T>(-1, 0, 0.5), Mat4<T>::LookAt(a, b));
+LINALG_UNARY_BENCHMARK(Mat4Perspective, Vec2<T>(0.8, 1.5), Mat4<T>::Perspective(a.x, a.y, T(0.1), T(100)));
+LINALG_UNARY_BENCHMARK(Mat4Orthographic, Vec2<T>(4, 3), Mat4<T>::Orthographic(-a.x, a.x, -a.y, a.y, T(0.1), T(100)));
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Mat4Multiply, float);
+BENCHMARK_TEMPLATE(BM_Mat4MultiplyScalar, float);
+BENCHMARK_TEMPLATE(BM_Mat4Multiply, double);
+BENCHMARK_TEMPLATE(BM_Mat4MultiplyScalar, double);
+BENCHMARK_TEMPLATE(BM_Mat4Vec4Multiply, float);
+BENCHMARK_TEMPLATE(BM_Mat4Vec4MultiplyScalar, float);
+BENCHMARK_TEMPLATE(BM_Mat4Vec4Multiply, double);
+BENCHMARK_TEMPLATE(BM_Mat4Vec4MultiplyScalar, double);
+BENCHMARK_TEMPLATE(BM_Mat4Inverse, float);
+BENCHMARK_TEMPLATE(BM_Mat4InverseScalar, float);
+BENCHMARK_TEMPLATE(BM_Mat4InverseAffine, float);
+BENCHMARK_TEMPLATE(BM_Mat4InverseRigid, float);
+BENCHMARK_TEMPLATE(BM_Mat4Inverse, double);
+BENCHMARK_TEMPLATE(BM_Mat4InverseScalar, double);
+BENCHMARK_TEMPLATE(BM_Mat4InverseAffine, double);
+BENCHMARK_TEMPLATE(BM_Mat4InverseRigid, double);
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "linalg/Mat4.hpp"
+#include "linalg/Memory.hpp"
+
+using namespace linalg;
+
+namespace {
+
+// A frame building transient batches of matrices of varying sizes, alive until
+// the end of the frame.
+template <typename Vector, typename MakeVector> void runFrame(std::size_t count, const MakeVector& make) {
+  Vector batches[4] = {make(), make(), make(), make()};
+  for(std::size_t batch = 0; batch < 4; ++batch) {
+    Vector& matrices = batches[batch];
+    for(std::size_t i = 0; i < count * (batch + 1); ++i) {
+      matrices.push_back(Mat4d::Identity());
+    }
+    benchmark::DoNotOptimize(matrices.data());
+  }
+}
+
+void BM_FrameBatchesAlignedVector(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  for(auto _ : state) {
+    runFrame<AlignedVector<Mat4d>>(count, [] { return AlignedVector<Mat4d>(); });
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 10);
+}
+
+void BM_FrameBatchesArenaVector(benchmark::State& state) {
+  const auto     count = static_cast<std::size_t>(state.range(0));
+  MonotonicArena arena;
+  for(auto _ : state) {
+    runFrame<ArenaVector<Mat4d>>(count, [&arena] { return ArenaVector<Mat4d>(ArenaAllocator<Mat4d>(arena)); });
+    arena.reset();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 10);
+}
+
+} // namespace
+
+BENCHMARK(BM_FrameBatchesAlignedVector)->Arg(64)->Arg(4096);
+BENCHMARK(BM_FrameBatchesArenaVector)->Arg(64)->Arg(4096);
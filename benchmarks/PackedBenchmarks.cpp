@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> std::vector<Vec3<T>> makeVectors(std::size_t count) {
+  std::vector<Vec3<T>> vectors(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const T t  = static_cast<T>(i);
+    vectors[i] = Vec3<T>(t, t + 1, t + 2);
+  }
+  return vectors;
+}
+
+template <typename T> void BM_PackVec3(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<T>> in    = makeVectors<T>(count);
+  std::vector<PackedVec3<T>> out(count);
+  for(auto _ : state) {
+    pack(in.data(), out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) *
+                          static_cast<int64_t>(sizeof(Vec3<T>) + sizeof(PackedVec3<T>)));
+}
+
+template <typename T> void BM_UnpackVec3(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<T>> aos   = makeVectors<T>(count);
+  std::vector<PackedVec3<T>> in(count);
+  pack(aos.data(), in.data(), count);
+  std::vector<Vec3<T>> out(count);
+  for(auto _ : state) {
+    unpack(in.data(), out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) *
+                          static_cast<int64_t>(sizeof(Vec3<T>) + sizeof(PackedVec3<T>)));
+}
+
+template <typename T> void BM_PackVec3Loop(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<T>> in    = makeVectors<T>(count);
+  std::vector<PackedVec3<T>> out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = PackedVec3<T>(in[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_PackVec3, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_PackVec3Loop, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_UnpackVec3, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_PackVec3, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_UnpackVec3, double)->Arg(4096);
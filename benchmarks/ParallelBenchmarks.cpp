@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include <thread>
+#include <vector>
+#include "BenchmarkUtils.hpp"
+#include "linalg/Parallel.hpp"
+
+using namespace linalg;
+using bench::makePoints;
+using bench::makeTransform;
+
+namespace {
+
+// Arrays well beyond the last level cache; every benchmark runs once per
+// number of threads, from 1 to the number of hardware threads.
+constexpr std::size_t COUNT = std::size_t(1) << 21;
+
+void threadCounts(benchmark::internal::Benchmark* b) {
+  for(std::size_t threads = 1; threads <= ThreadPool::defaultConcurrency(); ++threads) {
+    b->Arg(static_cast<int64_t>(threads));
+  }
+  b->UseRealTime();
+}
+
+template <typename T> void BM_ParallelTransformPoints(benchmark::State& state) {
+  ThreadPool                 pool(static_cast<std::size_t>(state.range(0)));
+  const Mat4<T>              mat = makeTransform<T>();
+  const std::vector<Vec3<T>> in  = makePoints<T>(COUNT);
+  std::vector<Vec3<T>>       out(COUNT);
+  for(auto _ : state) {
+    transformPoints(pool, mat, in.data(), out.data(), COUNT);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(COUNT));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(COUNT * 2 * sizeof(Vec3<T>)));
+}
+
+template <typename T> void BM_ParallelNormalized(benchmark::State& state) {
+  ThreadPool                 pool(static_cast<std::size_t>(state.range(0)));
+  const std::vector<Vec3<T>> in = makePoints<T>(COUNT);
+  std::vector<Vec3<T>>       out(COUNT);
+  for(auto _ : state) {
+    normalized(pool, in.data(), out.data(), COUNT);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(COUNT));
+}
+
+template <typename T> void BM_ParallelSum(benchmark::State& state) {
+  ThreadPool                 pool(static_cast<std::size_t>(state.range(0)));
+  const std::vector<Vec3<T>> in = makePoints<T>(COUNT);
+  for(auto _ : state) {
+    Vec3<T> total = sum(pool, in.data(), COUNT);
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(COUNT));
+}
+
+template <typename T> void BM_ParallelMinMax(benchmark::State& state) {
+  ThreadPool                 pool(static_cast<std::size_t>(state.range(0)));
+  const std::vector<Vec3<T>> in = makePoints<T>(COUNT);
+  for(auto _ : state) {
+    Vec3<T> lo;
+    Vec3<T> hi;
+    minMax(pool, in.data(), COUNT, lo, hi);
+    benchmark::DoNotOptimize(lo);
+    benchmark::DoNotOptimize(hi);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(COUNT));
+}
+
+BENCHMARK_TEMPLATE(BM_ParallelTransformPoints, float)->Apply(threadCounts);
+BENCHMARK_TEMPLATE(BM_ParallelTransformPoints, double)->Apply(threadCounts);
+BENCHMARK_TEMPLATE(BM_ParallelNormalized, float)->Apply(threadCounts);
+BENCHMARK_TEMPLATE(BM_ParallelNormalized, double)->Apply(threadCounts);
+BENCHMARK_TEMPLATE(BM_ParallelSum, float)->Apply(threadCounts);
+BENCHMARK_TEMPLATE(BM_ParallelSum, double)->Apply(threadCounts);
+BENCHMARK_TEMPLATE(BM_ParallelMinMax, float)->Apply(threadCounts);
+BENCHMARK_TEMPLATE(BM_ParallelMinMax, double)->Apply(threadCounts);
+
+} // namespace
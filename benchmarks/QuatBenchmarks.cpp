@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> void BM_QuatFromEuler(benchmark::State& state) {
+  T angle = static_cast<T>(0.1);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(Quat<T>::FromEuler(angle, angle * 2, angle * 3));
+    angle += static_cast<T>(1e-6);
+  }
+}
+
+template <typename T> void BM_GetRotationMatrix(benchmark::State& state) {
+  T angle = static_cast<T>(0.1);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(getRotationMatrix(angle, angle * 2, angle * 3));
+    angle += static_cast<T>(1e-6);
+  }
+}
+
+template <typename T> void BM_QuatCompose(benchmark::State& state) {
+  const Quat<T> a = Quat<T>::FromEuler(0.1, 0.2, 0.3);
+  const Quat<T> b = Quat<T>::FromEuler(-0.4, 0.5, 0.6);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(a * b);
+  }
+}
+
+template <typename T> void BM_Mat3Compose(benchmark::State& state) {
+  const Mat3<T> a = getRotationMatrix<T>(0.1, 0.2, 0.3);
+  const Mat3<T> b = getRotationMatrix<T>(-0.4, 0.5, 0.6);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(a * b);
+  }
+}
+
+template <typename T> struct SlerpInputs {
+  explicit SlerpInputs(std::size_t count) : a(count), b(count), out(count) {
+    for(std::size_t i = 0; i < count; ++i) {
+      const T t = static_cast<T>(i) * static_cast<T>(1e-3);
+      a[i]      = Quat<T>::FromEuler(t, 2 * t, 0.5);
+      b[i]      = Quat<T>::FromEuler(-t, 0.3, t);
+    }
+  }
+
+  std::vector<Quat<T>> a;
+  std::vector<Quat<T>> b;
+  std::vector<Quat<T>> out;
+};
+
+template <typename T> void BM_BatchSlerp(benchmark::State& state) {
+  const auto     count = static_cast<std::size_t>(state.range(0));
+  SlerpInputs<T> in(count);
+  for(auto _ : state) {
+    slerp(in.a.data(), in.b.data(), static_cast<T>(0.4), in.out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The scalar loop the batch slerp replaces.
+template <typename T> void BM_ScalarSlerpLoop(benchmark::State& state) {
+  const auto     count = static_cast<std::size_t>(state.range(0));
+  SlerpInputs<T> in(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      in.out[i] = slerp(in.a[i], in.b[i], static_cast<T>(0.4));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_QuatFromEuler, float);
+BENCHMARK_TEMPLATE(BM_GetRotationMatrix, float);
+BENCHMARK_TEMPLATE(BM_QuatCompose, float);
+BENCHMARK_TEMPLATE(BM_Mat3Compose, float);
+BENCHMARK_TEMPLATE(BM_BatchSlerp, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_BatchSlerp, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_ScalarSlerpLoop, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_ScalarSlerpLoop, double)->Arg(4096);
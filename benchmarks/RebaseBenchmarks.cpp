@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "linalg/Rebase.hpp"
+
+using namespace linalg;
+
+namespace {
+
+const Vec3d ORIGIN(1.0e7, -2.5e6, 3.0e6);
+
+std::vector<Mat4d> makeModels(std::size_t count) {
+  std::vector<Mat4d> models(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const double t = static_cast<double>(i);
+    models[i]      = Mat4d(1, 0, 0, ORIGIN.x + t, 0, 1, 0, ORIGIN.y - t, 0, 0, 1, ORIGIN.z + 0.5 * t, 0, 0, 0, 1);
+  }
+  return models;
+}
+
+// Reference: translate in double then use the converting constructor.
+void BM_RebaseMat4Loop(benchmark::State& state) {
+  const auto               count  = static_cast<std::size_t>(state.range(0));
+  const std::vector<Mat4d> models = makeModels(count);
+  const Mat4d              view(1, 0, 0, -ORIGIN.x, 0, 1, 0, -ORIGIN.y, 0, 0, 1, -ORIGIN.z, 0, 0, 0, 1);
+  std::vector<Mat4f>       out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = Mat4f(view * models[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_RebaseMat4(benchmark::State& state) {
+  const auto               count  = static_cast<std::size_t>(state.range(0));
+  const std::vector<Mat4d> models = makeModels(count);
+  std::vector<Mat4f>       out(count);
+  for(auto _ : state) {
+    rebase(models.data(), ORIGIN, out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_NarrowMat4Loop(benchmark::State& state) {
+  const auto               count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Mat4d> in    = makeModels(count);
+  std::vector<Mat4f>       out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = Mat4f(in[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_NarrowMat4(benchmark::State& state) {
+  const auto               count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Mat4d> in    = makeModels(count);
+  std::vector<Mat4f>       out(count);
+  for(auto _ : state) {
+    narrow(in.data(), out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_RebaseVec3Loop(benchmark::State& state) {
+  const auto         count = static_cast<std::size_t>(state.range(0));
+  std::vector<Vec3d> in(count, ORIGIN + Vec3d(1, 2, 3));
+  std::vector<Vec3f> out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = Vec3f(in[i] - ORIGIN);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_RebaseVec3(benchmark::State& state) {
+  const auto         count = static_cast<std::size_t>(state.range(0));
+  std::vector<Vec3d> in(count, ORIGIN + Vec3d(1, 2, 3));
+  std::vector<Vec3f> out(count);
+  for(auto _ : state) {
+    rebase(in.data(), ORIGIN, out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_RebaseMat4Loop)->Arg(4096);
+BENCHMARK(BM_RebaseMat4)->Arg(4096);
+BENCHMARK(BM_NarrowMat4Loop)->Arg(4096);
+BENCHMARK(BM_NarrowMat4)->Arg(4096);
+BENCHMARK(BM_RebaseVec3Loop)->Arg(4096);
+BENCHMARK(BM_RebaseVec3)->Arg(4096);
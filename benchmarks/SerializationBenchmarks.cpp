@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "linalg/Serialization.hpp"
+
+using namespace linalg;
+
+namespace {
+
+// Writes count matrices to a file removed when the benchmark ends.
+template <typename T> struct MatrixFile {
+  std::string path;
+
+  explicit MatrixFile(std::size_t count) : path("linalg_benchmark_matrices.bin") {
+    std::vector<Mat4<T>> matrices(count);
+    for(std::size_t i = 0; i < count; ++i) {
+      matrices[i](0, 3) = static_cast<T>(i);
+    }
+    writeArray(path, matrices);
+  }
+
+  ~MatrixFile() { std::remove(path.c_str()); }
+};
+
+template <typename T> void BM_SerializationReadArray(benchmark::State& state) {
+  const MatrixFile<T> file(static_cast<std::size_t>(state.range(0)));
+  for(auto _ : state) {
+    const auto matrices = readArray<Mat4<T>>(file.path);
+    benchmark::DoNotOptimize(matrices.back());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Only the pages touched are read: here the header and the last element.
+template <typename T> void BM_SerializationMapArray(benchmark::State& state) {
+  const MatrixFile<T> file(static_cast<std::size_t>(state.range(0)));
+  for(auto _ : state) {
+    const MappedArray<Mat4<T>> matrices(file.path);
+    benchmark::DoNotOptimize(matrices[matrices.size() - 1]);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_SerializationMapArrayTouchAll(benchmark::State& state) {
+  const MatrixFile<T> file(static_cast<std::size_t>(state.range(0)));
+  for(auto _ : state) {
+    const MappedArray<Mat4<T>> matrices(file.path);
+    T                          sum = 0;
+    for(const Mat4<T>& m : matrices) {
+      sum += m(0, 3);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_SerializationReadArray, float)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_SerializationMapArray, float)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_SerializationMapArrayTouchAll, float)->Arg(100000);
@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> std::vector<T> makeAngles(std::size_t count, double scale) {
+  std::vector<T> angles(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    angles[i] = static_cast<T>(scale * std::sin(0.1 * static_cast<double>(i)));
+  }
+  return angles;
+}
+
+template <typename T> void BM_SincosStd(benchmark::State& state) {
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> x     = makeAngles<T>(count, 10);
+  std::vector<T>       s(count);
+  std::vector<T>       c(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      s[i] = std::sin(x[i]);
+      c[i] = std::cos(x[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_SincosPack(benchmark::State& state) {
+  using P                    = simd::NativePack<T>;
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> x     = makeAngles<T>(count, 10);
+  std::vector<T>       s(count);
+  std::vector<T>       c(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i + P::WIDTH <= count; i += P::WIDTH) {
+      P sin_x;
+      P cos_x;
+      simd::sincos(P::load(&x[i]), sin_x, cos_x);
+      sin_x.store(&s[i]);
+      cos_x.store(&c[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_ExpStd(benchmark::State& state) {
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> x     = makeAngles<T>(count, 20);
+  std::vector<T>       out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = std::exp(x[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_ExpPack(benchmark::State& state) {
+  using P                    = simd::NativePack<T>;
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> x     = makeAngles<T>(count, 20);
+  std::vector<T>       out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i + P::WIDTH <= count; i += P::WIDTH) {
+      simd::exp(P::load(&x[i])).store(&out[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_AcosStd(benchmark::State& state) {
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> x     = makeAngles<T>(count, 1);
+  std::vector<T>       out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = std::acos(x[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_AcosPack(benchmark::State& state) {
+  using P                    = simd::NativePack<T>;
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> x     = makeAngles<T>(count, 1);
+  std::vector<T>       out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i + P::WIDTH <= count; i += P::WIDTH) {
+      simd::acos(P::load(&x[i])).store(&out[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Reference: one getRotationMatrix() call, six libm calls, per matrix.
+template <typename T> void BM_RotationMatrixLoop(benchmark::State& state) {
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> x     = makeAngles<T>(count, 3);
+  const std::vector<T> y     = makeAngles<T>(count, 2);
+  const std::vector<T> z     = makeAngles<T>(count, 1);
+  std::vector<Mat3<T>> out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = getRotationMatrix(x[i], y[i], z[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_RotationMatrices(benchmark::State& state) {
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> x     = makeAngles<T>(count, 3);
+  const std::vector<T> y     = makeAngles<T>(count, 2);
+  const std::vector<T> z     = makeAngles<T>(count, 1);
+  std::vector<Mat3<T>> out(count);
+  for(auto _ : state) {
+    getRotationMatrices(x.data(), y.data(), z.data(), out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_SincosStd, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_SincosPack, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_SincosStd, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_SincosPack, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_ExpStd, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_ExpPack, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_AcosStd, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_AcosPack, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_RotationMatrixLoop, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_RotationMatrices, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_RotationMatrixLoop, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_RotationMatrices, double)->Arg(4096);
@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "linalg/Skinning.hpp"
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+constexpr std::uint32_t JOINTS = 64;
+
+template <typename T> std::vector<Mat4<T>> makeJoints() {
+  std::vector<Mat4<T>> joints;
+  for(std::uint32_t i = 0; i < JOINTS; ++i) {
+    joints.push_back(Mat4<T>::LookAt(Vec3<T>(1, T(i), 2), Vec3<T>(), Vec3<T>(0, 1, 0)));
+  }
+  return joints;
+}
+
+template <typename T> std::vector<JointInfluences<T>> makeInfluences(std::size_t count) {
+  std::vector<JointInfluences<T>> influences(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const auto j  = static_cast<std::uint32_t>(i * 2654435761U);
+    influences[i] = {{j % JOINTS, (j >> 8) % JOINTS, (j >> 16) % JOINTS, (j >> 24) % JOINTS},
+                     {T(0.4), T(0.3), T(0.2), T(0.1)}};
+  }
+  return influences;
+}
+
+// Reference: blend the four Mat4 with the general operators, then transform.
+template <typename T> void BM_SkinPointsMat4(benchmark::State& state) {
+  const auto                            count      = static_cast<std::size_t>(state.range(0));
+  const std::vector<Mat4<T>>            joints     = makeJoints<T>();
+  const std::vector<JointInfluences<T>> influences = makeInfluences<T>(count);
+  const std::vector<Vec3<T>>            in(count, Vec3<T>(1, 2, 3));
+  std::vector<Vec3<T>>                  out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      const JointInfluences<T>& inf = influences[i];
+      Vec4<T>                   sum(0, 0, 0, 0);
+      for(int k = 0; k < JointInfluences<T>::COUNT; ++k) {
+        sum += (joints[inf.joints[k]] * toVec4(in[i])) * inf.weights[k];
+      }
+      out[i] = toVec3(sum);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_SkinPoints(benchmark::State& state) {
+  const auto                            count      = static_cast<std::size_t>(state.range(0));
+  const std::vector<Mat4<T>>            joints     = makeJoints<T>();
+  const SkinningPalette<T>              palette(joints.data(), joints.size());
+  const std::vector<JointInfluences<T>> influences = makeInfluences<T>(count);
+  const std::vector<Vec3<T>>            in(count, Vec3<T>(1, 2, 3));
+  std::vector<Vec3<T>>                  out(count);
+  for(auto _ : state) {
+    skinPoints(palette, influences.data(), in.data(), out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_SkinVertices(benchmark::State& state) {
+  const auto                            count      = static_cast<std::size_t>(state.range(0));
+  const std::vector<Mat4<T>>            joints     = makeJoints<T>();
+  const SkinningPalette<T>              palette(joints.data(), joints.size());
+  const std::vector<JointInfluences<T>> influences = makeInfluences<T>(count);
+  const std::vector<Vec3<T>>            in(count, Vec3<T>(1, 2, 3));
+  std::vector<Vec3<T>>                  positions(count);
+  std::vector<Vec3<T>>                  normals(count);
+  for(auto _ : state) {
+    skinVertices(palette, influences.data(), in.data(), in.data(), positions.data(), normals.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Instancing: one matrix per element, picked from a large array.
+template <typename T> void BM_TransformIndexedMat4(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Mat4<T>> matrices(count, Mat4<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(), Vec3<T>(0, 1, 0)));
+  std::vector<std::uint32_t> indices(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    indices[i] = static_cast<std::uint32_t>((i * 2654435761U) % count);
+  }
+  const std::vector<Vec4<T>> in(count, Vec4<T>(1, 2, 3, 1));
+  std::vector<Vec4<T>>       out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = matrices[indices[i]] * in[i];
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_TransformIndexed(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Mat4<T>> matrices(count, Mat4<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(), Vec3<T>(0, 1, 0)));
+  std::vector<std::uint32_t> indices(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    indices[i] = static_cast<std::uint32_t>((i * 2654435761U) % count);
+  }
+  const std::vector<Vec4<T>> in(count, Vec4<T>(1, 2, 3, 1));
+  std::vector<Vec4<T>>       out(count);
+  for(auto _ : state) {
+    transformIndexed(matrices.data(), indices.data(), in.data(), out.data(), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_SkinPointsMat4, float)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_SkinPoints, float)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_SkinVertices, float)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_SkinPointsMat4, double)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_SkinPoints, double)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_TransformIndexedMat4, float)->Arg(1 << 18);
+BENCHMARK_TEMPLATE(BM_TransformIndexed, float)->Arg(1 << 18);
@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> std::vector<Vec3<T>> makeVectors(std::size_t count) {
+  std::vector<Vec3<T>> vectors(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const T t  = static_cast<T>(i) * static_cast<T>(0.001);
+    vectors[i] = Vec3<T>(t + 1, 1 - t, 2 * t);
+  }
+  return vectors;
+}
+
+template <typename T> void BM_SoANormalize(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<T>> aos   = makeVectors<T>(count);
+  const Vec3SoA<T>           in    = Vec3SoA<T>::FromAoS(aos.data(), count);
+  Vec3SoA<T>                 out(count);
+  for(auto _ : state) {
+    normalized(in, out);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_SoANormalizeFast(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<T>> aos   = makeVectors<T>(count);
+  const Vec3SoA<T>           in    = Vec3SoA<T>::FromAoS(aos.data(), count);
+  Vec3SoA<T>                 out(count);
+  for(auto _ : state) {
+    normalizedFast(in, out);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_AoSNormalizeLoop(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<T>> in    = makeVectors<T>(count);
+  std::vector<Vec3<T>>       out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = in[i].normalized();
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_SoADot(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<T>> aos   = makeVectors<T>(count);
+  const Vec3SoA<T>           a     = Vec3SoA<T>::FromAoS(aos.data(), count);
+  std::vector<T>             out(count);
+  for(auto _ : state) {
+    dot(a, a, out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_AoSDotLoop(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<T>> a     = makeVectors<T>(count);
+  std::vector<T>             out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = dot(a[i], a[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_SoARefract(benchmark::State& state) {
+  const auto                 count = static_cast<std::size_t>(state.range(0));
+  std::vector<Vec3<T>>       aos   = makeVectors<T>(count);
+  for(auto& v : aos) {
+    v.normalize();
+  }
+  const Vec3SoA<T> incident = Vec3SoA<T>::FromAoS(aos.data(), count);
+  Vec3SoA<T>       normal(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    normal.set(i, Vec3<T>(0, 1, 0));
+  }
+  Vec3SoA<T> out(count);
+  for(auto _ : state) {
+    refract(incident, normal, static_cast<T>(1.3), out);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_AoSRefractLoop(benchmark::State& state) {
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  std::vector<Vec3<T>> in    = makeVectors<T>(count);
+  for(auto& v : in) {
+    v.normalize();
+  }
+  const Vec3<T>        normal(0, 1, 0);
+  std::vector<Vec3<T>> out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = refract(in[i], normal, static_cast<T>(1.3));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_SoANormalize, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_SoANormalizeFast, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_AoSNormalizeLoop, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_SoADot, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_AoSDotLoop, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_SoARefract, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_AoSRefractLoop, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_SoANormalize, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_AoSNormalizeLoop, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_SoARefract, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_AoSRefractLoop, double)->Arg(4096);
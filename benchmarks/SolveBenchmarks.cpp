@@ -0,0 +1,187 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> Mat3<T> makeMat3(std::size_t i) {
+  const T t = static_cast<T>(i % 64);
+  return Mat3<T>(4 + t / 64, 2, -1, 3, 5, 2, -1, 4, 6 - t / 32);
+}
+
+template <typename T> Mat4<T> makeMat4(std::size_t i) {
+  const T t = static_cast<T>(i % 64);
+  return Mat4<T>(4 + t / 64, 2, -1, 1, 3, 5, 2, 0, -1, 4, 6, t / 16, 1, 0, 2, 5);
+}
+
+template <typename T> Mat3<T> makeSpd3(std::size_t i) {
+  const Mat3<T> a = makeMat3<T>(i);
+  return a * a.transposed();
+}
+
+// Reference: a.inverse() * b, one system at a time.
+template <typename T> void BM_Mat3InverseSolve(benchmark::State& state) {
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  std::vector<Mat3<T>> a;
+  for(std::size_t i = 0; i < count; ++i) {
+    a.push_back(makeMat3<T>(i));
+  }
+  const Vec3<T>        b(1, 2, 3);
+  std::vector<Vec3<T>> x(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      x[i] = a[i].inverse() * b;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_Mat3Solve(benchmark::State& state) {
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  std::vector<Mat3<T>> a;
+  for(std::size_t i = 0; i < count; ++i) {
+    a.push_back(makeMat3<T>(i));
+  }
+  const Vec3<T>        b(1, 2, 3);
+  std::vector<Vec3<T>> x(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      x[i] = solve(a[i], b);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_Mat3SolveBatched(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  Mat3SoA<T> a(count);
+  Vec3SoA<T> b(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    a.set(i, makeMat3<T>(i));
+    b.set(i, Vec3<T>(1, 2, 3));
+  }
+  Vec3SoA<T> x(count);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(solve(a, b, x));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_Mat3SolveCholeskyBatched(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  Mat3SoA<T> a(count);
+  Vec3SoA<T> b(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    a.set(i, makeSpd3<T>(i));
+    b.set(i, Vec3<T>(1, 2, 3));
+  }
+  Vec3SoA<T> x(count);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(solveCholesky(a, b, x));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_Mat4InverseSolve(benchmark::State& state) {
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  std::vector<Mat4<T>> a;
+  for(std::size_t i = 0; i < count; ++i) {
+    a.push_back(makeMat4<T>(i));
+  }
+  const Vec4<T>        b(1, 2, 3, 4);
+  std::vector<Vec4<T>> x(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      x[i] = a[i].inverse() * b;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_Mat4Solve(benchmark::State& state) {
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  std::vector<Mat4<T>> a;
+  for(std::size_t i = 0; i < count; ++i) {
+    a.push_back(makeMat4<T>(i));
+  }
+  const Vec4<T>        b(1, 2, 3, 4);
+  std::vector<Vec4<T>> x(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      x[i] = solve(a[i], b);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_Mat4SolveBatched(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  Mat4SoA<T> a(count);
+  Vec4SoA<T> b(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    a.set(i, makeMat4<T>(i));
+    b.set(i, Vec4<T>(1, 2, 3, 4));
+  }
+  Vec4SoA<T> x(count);
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(solve(a, b, x));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_SymmetricEigen(benchmark::State& state) {
+  const auto           count = static_cast<std::size_t>(state.range(0));
+  std::vector<Mat3<T>> a;
+  for(std::size_t i = 0; i < count; ++i) {
+    a.push_back(makeSpd3<T>(i));
+  }
+  std::vector<SymmetricEigen<T>> out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = symmetricEigen(a[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_SymmetricEigenBatched(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  Mat3SoA<T> a(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    a.set(i, makeSpd3<T>(i));
+  }
+  Vec3SoA<T> values(count);
+  Mat3SoA<T> vectors(count);
+  for(auto _ : state) {
+    symmetricEigen(a, values, vectors);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Mat3InverseSolve, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Mat3Solve, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Mat3SolveBatched, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Mat3SolveCholeskyBatched, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Mat4InverseSolve, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Mat4Solve, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Mat4SolveBatched, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_SymmetricEigen, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_SymmetricEigenBatched, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Mat3Solve, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Mat3SolveBatched, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Mat4Solve, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Mat4SolveBatched, double)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_SymmetricEigenBatched, double)->Arg(4096);
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "linalg/Stream.hpp"
+
+using namespace linalg;
+
+namespace {
+
+// Writes count points to a file removed when the benchmark ends.
+template <typename T> struct PointFile {
+  std::string path;
+
+  explicit PointFile(std::size_t count) : path("linalg_benchmark_points.bin") {
+    std::vector<Vec3<T>> points(count);
+    for(std::size_t i = 0; i < count; ++i) {
+      const T t = static_cast<T>(i % 1000);
+      points[i] = Vec3<T>(t, std::sin(t), -t / 2);
+    }
+    writeArray(path, points);
+  }
+
+  ~PointFile() { std::remove(path.c_str()); }
+};
+
+const char* OUTPUT_PATH = "linalg_benchmark_points_out.bin";
+
+template <typename T> Mat4<T> makeMatrix() { return Mat4<T>::LookAt(Vec3<T>(5, -6, 7), Vec3<T>(1, 2, 3)); }
+
+// Reference: load the whole file, transform, bound and write it back serially.
+template <typename T> void BM_StreamTransformInMemory(benchmark::State& state) {
+  const PointFile<T> file(static_cast<std::size_t>(state.range(0)));
+  const Mat4<T>      mat = makeMatrix<T>();
+  for(auto _ : state) {
+    AlignedVector<Vec3<T>> points = readArray<Vec3<T>>(file.path);
+    transformPoints(mat, points.data(), points.data(), points.size());
+    const AABB<T> box = AABB<T>::FromPoints(points.data(), points.size());
+    writeArray(OUTPUT_PATH, points);
+    benchmark::DoNotOptimize(box);
+  }
+  std::remove(OUTPUT_PATH);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_StreamTransform(benchmark::State& state) {
+  const PointFile<T> file(static_cast<std::size_t>(state.range(0)));
+  const Mat4<T>      mat = makeMatrix<T>();
+  for(auto _ : state) {
+    ArraySource<Vec3<T>> source(file.path);
+    ArraySink<Vec3<T>>   sink(OUTPUT_PATH);
+    const AABB<T>        box = transformPoints(source, mat, sink);
+    benchmark::DoNotOptimize(box);
+  }
+  std::remove(OUTPUT_PATH);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_StreamTransformParallel(benchmark::State& state) {
+  const PointFile<T> file(static_cast<std::size_t>(state.range(0)));
+  const Mat4<T>      mat = makeMatrix<T>();
+  ThreadPool         pool;
+  for(auto _ : state) {
+    ArraySource<Vec3<T>> source(file.path);
+    ArraySink<Vec3<T>>   sink(OUTPUT_PATH);
+    const AABB<T>        box = transformPoints(pool, source, mat, sink);
+    benchmark::DoNotOptimize(box);
+  }
+  std::remove(OUTPUT_PATH);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> void BM_StreamBounds(benchmark::State& state) {
+  const PointFile<T> file(static_cast<std::size_t>(state.range(0)));
+  for(auto _ : state) {
+    ArraySource<Vec3<T>> source(file.path);
+    const AABB<T>        box = streamBounds(source);
+    benchmark::DoNotOptimize(box);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+// The reader and writer threads run alongside the timed thread: report wall
+// time.
+BENCHMARK_TEMPLATE(BM_StreamTransformInMemory, float)->Arg(1 << 21)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_StreamTransform, float)->Arg(1 << 21)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_StreamTransformParallel, float)->Arg(1 << 21)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_StreamBounds, float)->Arg(1 << 21)->Unit(benchmark::kMillisecond)->UseRealTime();
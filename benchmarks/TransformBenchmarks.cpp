@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "linalg/Transform.hpp"
+
+using namespace linalg;
+
+namespace {
+
+constexpr std::size_t NODES = 1024;
+
+template <typename T> std::vector<Transform<T>> makeNodes() {
+  std::vector<Transform<T>> nodes;
+  for(std::size_t i = 0; i < NODES; ++i) {
+    const T t = static_cast<T>(i) * static_cast<T>(0.01);
+    nodes.emplace_back(Vec3<T>(t, 1, -t), Quat<T>::FromEuler(t, 2 * t, -t), Vec3<T>(1, 1 + t, 2));
+  }
+  return nodes;
+}
+
+// World and normal matrices of every node, rebuilt from the components every
+// frame with the general Mat4 products and inverse.
+template <typename T> void BM_NodeMatricesMat4(benchmark::State& state) {
+  const std::vector<Transform<T>> nodes = makeNodes<T>();
+  std::vector<Mat4<T>>            world(NODES);
+  std::vector<Mat3<T>>            normal(NODES);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < NODES; ++i) {
+      const Transform<T>& node = nodes[i];
+      const Vec3<T>&      t    = node.translation();
+      const Vec3<T>&      s    = node.scale();
+      world[i] = Mat4<T>(1, 0, 0, t.x, 0, 1, 0, t.y, 0, 0, 1, t.z, 0, 0, 0, 1) * node.rotation().toMat4() *
+                 Mat4<T>(s.x, 0, 0, 0, 0, s.y, 0, 0, 0, 0, s.z, 0, 0, 0, 0, 1);
+      normal[i] = world[i].inverse().topLeft3x3().transposed();
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NODES));
+}
+
+// Every node modified every frame: the matrices are composed directly.
+template <typename T> void BM_NodeMatricesDirty(benchmark::State& state) {
+  std::vector<Transform<T>> nodes = makeNodes<T>();
+  std::vector<Mat4<T>>      world(NODES);
+  std::vector<Mat3<T>>      normal(NODES);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < NODES; ++i) {
+      nodes[i].setRotation(nodes[i].rotation());
+      world[i]  = nodes[i].matrix();
+      normal[i] = nodes[i].normalMatrix();
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NODES));
+}
+
+// Static nodes: the cached matrices are returned.
+template <typename T> void BM_NodeMatricesCached(benchmark::State& state) {
+  const std::vector<Transform<T>> nodes = makeNodes<T>();
+  std::vector<Mat4<T>>            world(NODES);
+  std::vector<Mat3<T>>            normal(NODES);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < NODES; ++i) {
+      world[i]  = nodes[i].matrix();
+      normal[i] = nodes[i].normalMatrix();
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NODES));
+}
+
+BENCHMARK_TEMPLATE(BM_NodeMatricesMat4, float);
+BENCHMARK_TEMPLATE(BM_NodeMatricesMat4, double);
+BENCHMARK_TEMPLATE(BM_NodeMatricesDirty, float);
+BENCHMARK_TEMPLATE(BM_NodeMatricesDirty, double);
+BENCHMARK_TEMPLATE(BM_NodeMatricesCached, float);
+BENCHMARK_TEMPLATE(BM_NodeMatricesCached, double);
+
+} // namespace
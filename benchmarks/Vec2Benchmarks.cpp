@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkUtils.hpp"
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+LINALG_UNARY_BENCHMARK(Vec2Negate, Vec2<T>(1, 2), -a);
+LINALG_UNARY_BENCHMARK(Vec2MultiplyScalar, Vec2<T>(1, 2), a * T(1.5));
+LINALG_UNARY_BENCHMARK(Vec2MultiplyAssignScalar, Vec2<T>(1, 2), a *= T(1.5));
+LINALG_UNARY_BENCHMARK(Vec2DivideScalar, Vec2<T>(1, 2), a / T(1.5));
+LINALG_UNARY_BENCHMARK(Vec2DivideAssignScalar, Vec2<T>(1, 2), a /= T(1.5));
+LINALG_UNARY_BENCHMARK(Vec2SquaredLength, Vec2<T>(1, 2), a.squaredLength());
+LINALG_UNARY_BENCHMARK(Vec2Length, Vec2<T>(1, 2), a.length());
+LINALG_UNARY_BENCHMARK(Vec2Normalized, Vec2<T>(1, 2), a.normalized());
+LINALG_UNARY_BENCHMARK(Vec2Normalize, Vec2<T>(1, 2), (a.normalize(), a));
+LINALG_UNARY_BENCHMARK(Vec2LengthFast, Vec2<T>(1, 2), a.lengthFast());
+LINALG_UNARY_BENCHMARK(Vec2NormalizedFast, Vec2<T>(1, 2), a.normalizedFast());
+LINALG_UNARY_BENCHMARK(Vec2NormalizeFast, Vec2<T>(1, 2), (a.normalizeFast(), a));
+LINALG_UNARY_BENCHMARK(Vec2Index, Vec2<T>(1, 2), a[1]);
+LINALG_BINARY_BENCHMARK(Vec2Add, Vec2<T>(1, 2), Vec2<T>(3, -4), a + b);
+LINALG_BINARY_BENCHMARK(Vec2AddAssign, Vec2<T>(1, 2), Vec2<T>(3, -4), a += b);
+LINALG_BINARY_BENCHMARK(Vec2Subtract, Vec2<T>(1, 2), Vec2<T>(3, -4), a - b);
+LINALG_BINARY_BENCHMARK(Vec2SubtractAssign, Vec2<T>(1, 2), Vec2<T>(3, -4), a -= b);
+LINALG_BINARY_BENCHMARK(Vec2Equal, Vec2<T>(1, 2), Vec2<T>(3, -4), a == b);
+LINALG_BINARY_BENCHMARK(Vec2IsApprox, Vec2<T>(1, 2), Vec2<T>(3, -4), a.isApprox(b, T(1e-6)));
+
+} // namespace
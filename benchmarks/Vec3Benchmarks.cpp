@@ -0,0 +1,33 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkUtils.hpp"
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+LINALG_UNARY_BENCHMARK(Vec3Negate, Vec3<T>(1, 2, 3), -a);
+LINALG_UNARY_BENCHMARK(Vec3MultiplyScalar, Vec3<T>(1, 2, 3), a * T(1.5));
+LINALG_UNARY_BENCHMARK(Vec3MultiplyAssignScalar, Vec3<T>(1, 2, 3), a *= T(1.5));
+LINALG_UNARY_BENCHMARK(Vec3DivideScalar, Vec3<T>(1, 2, 3), a / T(1.5));
+LINALG_UNARY_BENCHMARK(Vec3DivideAssignScalar, Vec3<T>(1, 2, 3), a /= T(1.5));
+LINALG_UNARY_BENCHMARK(Vec3SquaredLength, Vec3<T>(1, 2, 3), a.squaredLength());
+LINALG_UNARY_BENCHMARK(Vec3Length, Vec3<T>(1, 2, 3), a.length());
+LINALG_UNARY_BENCHMARK(Vec3Normalized, Vec3<T>(1, 2, 3), a.normalized());
+LINALG_UNARY_BENCHMARK(Vec3Normalize, Vec3<T>(1, 2, 3), (a.normalize(), a));
+LINALG_UNARY_BENCHMARK(Vec3LengthFast, Vec3<T>(1, 2, 3), a.lengthFast());
+LINALG_UNARY_BENCHMARK(Vec3NormalizedFast, Vec3<T>(1, 2, 3), a.normalizedFast());
+LINALG_UNARY_BENCHMARK(Vec3NormalizeFast, Vec3<T>(1, 2, 3), (a.normalizeFast(), a));
+LINALG_UNARY_BENCHMARK(Vec3Index, Vec3<T>(1, 2, 3), a[1]);
+LINALG_UNARY_BENCHMARK(Vec3MinValue, Vec3<T>(1, 2, 3), a.minValue());
+LINALG_UNARY_BENCHMARK(Vec3MaxValue, Vec3<T>(1, 2, 3), a.maxValue());
+LINALG_UNARY_BENCHMARK(Vec3CwiseInverse, Vec3<T>(1, 2, 3), a.cwiseInverse());
+LINALG_BINARY_BENCHMARK(Vec3Cross, Vec3<T>(1, 2, 3), Vec3<T>(3, -4, 0.5), a.cross(b));
+LINALG_BINARY_BENCHMARK(Vec3Add, Vec3<T>(1, 2, 3), Vec3<T>(3, -4, 0.5), a + b);
+LINALG_BINARY_BENCHMARK(Vec3AddAssign, Vec3<T>(1, 2, 3), Vec3<T>(3, -4, 0.5), a += b);
+LINALG_BINARY_BENCHMARK(Vec3Subtract, Vec3<T>(1, 2, 3), Vec3<T>(3, -4, 0.5), a - b);
+LINALG_BINARY_BENCHMARK(Vec3SubtractAssign, Vec3<T>(1, 2, 3), Vec3<T>(3, -4, 0.5), a -= b);
+LINALG_BINARY_BENCHMARK(Vec3Equal, Vec3<T>(1, 2, 3), Vec3<T>(3, -4, 0.5), a == b);
+LINALG_BINARY_BENCHMARK(Vec3IsApprox, Vec3<T>(1, 2, 3), Vec3<T>(3, -4, 0.5), a.isApprox(b, T(1e-6)));
+
+} // namespace
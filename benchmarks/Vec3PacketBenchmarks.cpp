@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+std::vector<Vec3<float>> makeRays(std::size_t count) {
+  std::vector<Vec3<float>> rays(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const float t = static_cast<float>(i % 64) / 64.0F;
+    rays[i]       = Vec3<float>(t, -1.0F, 0.5F - t).normalized();
+  }
+  return rays;
+}
+
+template <typename P> void BM_PacketRefract(benchmark::State& state) {
+  const auto                     count    = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<float>> incident = makeRays(count);
+  std::vector<Vec3<float>>       out(count);
+  const P                        normal = P::Broadcast(Vec3<float>(0, 1, 0));
+  for(auto _ : state) {
+    for(std::size_t i = 0; i + P::WIDTH <= count; i += P::WIDTH) {
+      refract(P::Gather(&incident[i]), normal, 1.3F).scatter(&out[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ScalarRefract(benchmark::State& state) {
+  const auto                     count    = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<float>> incident = makeRays(count);
+  std::vector<Vec3<float>>       out(count);
+  const Vec3<float>              normal(0, 1, 0);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = refract(incident[i], normal, 1.3F);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename P> void BM_PacketNormalized(benchmark::State& state) {
+  const auto                     count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<float>> in    = makeRays(count);
+  std::vector<Vec3<float>>       out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i + P::WIDTH <= count; i += P::WIDTH) {
+      normalized(P::Gather(&in[i]) * 2.0F).scatter(&out[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename P> void BM_PacketNormalizedFast(benchmark::State& state) {
+  const auto                     count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Vec3<float>> in    = makeRays(count);
+  std::vector<Vec3<float>>       out(count);
+  for(auto _ : state) {
+    for(std::size_t i = 0; i + P::WIDTH <= count; i += P::WIDTH) {
+      normalizedFast(P::Gather(&in[i]) * 2.0F).scatter(&out[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_PacketNormalized, Vec3x8f)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_PacketNormalizedFast, Vec3x8f)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_PacketRefract, Vec3x4f)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_PacketRefract, Vec3x8f)->Arg(4096);
+BENCHMARK(BM_ScalarRefract)->Arg(4096);
@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkUtils.hpp"
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+LINALG_UNARY_BENCHMARK(Vec4Negate, Vec4<T>(1, 2, 3, 4), -a);
+LINALG_UNARY_BENCHMARK(Vec4MultiplyScalar, Vec4<T>(1, 2, 3, 4), a * T(1.5));
+LINALG_UNARY_BENCHMARK(Vec4MultiplyAssignScalar, Vec4<T>(1, 2, 3, 4), a *= T(1.5));
+LINALG_UNARY_BENCHMARK(Vec4DivideScalar, Vec4<T>(1, 2, 3, 4), a / T(1.5));
+LINALG_UNARY_BENCHMARK(Vec4DivideAssignScalar, Vec4<T>(1, 2, 3, 4), a /= T(1.5));
+LINALG_UNARY_BENCHMARK(Vec4SquaredLength, Vec4<T>(1, 2, 3, 4), a.squaredLength());
+LINALG_UNARY_BENCHMARK(Vec4Length, Vec4<T>(1, 2, 3, 4), a.length());
+LINALG_UNARY_BENCHMARK(Vec4Normalized, Vec4<T>(1, 2, 3, 4), a.normalized());
+LINALG_UNARY_BENCHMARK(Vec4Normalize, Vec4<T>(1, 2, 3, 4), (a.normalize(), a));
+LINALG_UNARY_BENCHMARK(Vec4LengthFast, Vec4<T>(1, 2, 3, 4), a.lengthFast());
+LINALG_UNARY_BENCHMARK(Vec4NormalizedFast, Vec4<T>(1, 2, 3, 4), a.normalizedFast());
+LINALG_UNARY_BENCHMARK(Vec4NormalizeFast, Vec4<T>(1, 2, 3, 4), (a.normalizeFast(), a));
+LINALG_UNARY_BENCHMARK(Vec4Index, Vec4<T>(1, 2, 3, 4), a[1]);
+LINALG_BINARY_BENCHMARK(Vec4Add, Vec4<T>(1, 2, 3, 4), Vec4<T>(3, -4, 0.5, 2), a + b);
+LINALG_BINARY_BENCHMARK(Vec4AddAssign, Vec4<T>(1, 2, 3, 4), Vec4<T>(3, -4, 0.5, 2), a += b);
+LINALG_BINARY_BENCHMARK(Vec4Subtract, Vec4<T>(1, 2, 3, 4), Vec4<T>(3, -4, 0.5, 2), a - b);
+LINALG_BINARY_BENCHMARK(Vec4SubtractAssign, Vec4<T>(1, 2, 3, 4), Vec4<T>(3, -4, 0.5, 2), a -= b);
+LINALG_BINARY_BENCHMARK(Vec4Equal, Vec4<T>(1, 2, 3, 4), Vec4<T>(3, -4, 0.5, 2), a == b);
+LINALG_BINARY_BENCHMARK(Vec4IsApprox, Vec4<T>(1, 2, 3, 4), Vec4<T>(3, -4, 0.5, 2), a.isApprox(b, T(1e-6)));
+
+} // namespace
@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkUtils.hpp"
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+LINALG_UNARY_BENCHMARK(ToVec3, Vec4<T>(1, 2, 3, 4), toVec3(a));
+LINALG_UNARY_BENCHMARK(ToVec4, Vec3<T>(1, 2, 3), toVec4(a));
+
+LINALG_BINARY_BENCHMARK(Vec2Dot, Vec2<T>(1, 2), Vec2<T>(3, -4), dot(a, b));
+LINALG_BINARY_BENCHMARK(Vec3Dot, Vec3<T>(1, 2, 3), Vec3<T>(3, -4, 0.5), dot(a, b));
+LINALG_BINARY_BENCHMARK(Vec4Dot, Vec4<T>(1, 2, 3, 4), Vec4<T>(3, -4, 0.5, 2), dot(a, b));
+
+LINALG_BINARY_BENCHMARK(Vec2CwiseMin, Vec2<T>(1, 2), Vec2<T>(3, -4), cwiseMin(a, b));
+LINALG_BINARY_BENCHMARK(Vec3CwiseMin, Vec3<T>(1, 2, 3), Vec3<T>(3, -4, 0.5), cwiseMin(a, b));
+LINALG_BINARY_BENCHMARK(Vec4CwiseMin, Vec4<T>(1, 2, 3, 4), Vec4<T>(3, -4, 0.5, 2), cwiseMin(a, b));
+LINALG_BINARY_BENCHMARK(Vec2CwiseMax, Vec2<T>(1, 2), Vec2<T>(3, -4), cwiseMax(a, b));
+LINALG_BINARY_BENCHMARK(Vec3CwiseMax, Vec3<T>(1, 2, 3), Vec3<T>(3, -4, 0.5), cwiseMax(a, b));
+LINALG_BINARY_BENCHMARK(Vec4CwiseMax, Vec4<T>(1, 2, 3, 4), Vec4<T>(3, -4, 0.5, 2), cwiseMax(a, b));
+LINALG_BINARY_BENCHMARK(Vec2CwiseClamp, Vec2<T>(1, 2), Vec2<T>(3, -4), cwiseClamp(a, -b, b));
+LINALG_BINARY_BENCHMARK(Vec3CwiseClamp, Vec3<T>(1, 2, 3), Vec3<T>(3, -4, 0.5), cwiseClamp(a, -b, b));
+LINALG_BINARY_BENCHMARK(Vec4CwiseClamp, Vec4<T>(1, 2, 3, 4), Vec4<T>(3, -4, 0.5, 2), cwiseClamp(a, -b, b));
+LINALG_BINARY_BENCHMARK(Vec2CwiseProduct, Vec2<T>(1, 2), Vec2<T>(3, -4), cwiseProduct(a, b));
+LINALG_BINARY_BENCHMARK(Vec3CwiseProduct, Vec3<T>(1, 2, 3), Vec3<T>(3, -4, 0.5), cwiseProduct(a, b));
+LINALG_BINARY_BENCHMARK(Vec4CwiseProduct, Vec4<T>(1, 2, 3, 4), Vec4<T>(3, -4, 0.5, 2), cwiseProduct(a, b));
+
+LINALG_UNARY_BENCHMARK(ScalarVec2Multiply, Vec2<T>(1, 2), T(1.5) * a);
+LINALG_UNARY_BENCHMARK(ScalarVec3Multiply, Vec3<T>(1, 2, 3), T(1.5) * a);
+LINALG_UNARY_BENCHMARK(ScalarVec4Multiply, Vec4<T>(1, 2, 3, 4), T(1.5) * a);
+
+LINALG_BINARY_BENCHMARK(Reflect, Vec3<T>(1, -1, 0).normalized(), Vec3<T>(0, 1, 0), reflect(a, b));
+LINALG_BINARY_BENCHMARK(Refract, Vec3<T>(1, -1, 0).normalized(), Vec3<T>(0, 1, 0), refract(a, b, T(0.75)));
+LINALG_BINARY_BENCHMARK(RefractTotalInternalReflection, Vec3<T>(1, -0.2, 0).normalized(), Vec3<T>(0, 1, 0),
+                        refract(a, b, T(1.5)));
+
+LINALG_UNARY_BENCHMARK(GetRotationMatrix, Vec3<T>(0.3, -1.1, 2.2), getRotationMatrix(a.x, a.y, a.z));
+
+} // namespace
@@ -0,0 +1,322 @@
+/**
+ * @file main_perf_gate.cpp
+ * @brief Throughput regression gate over the hot-path benchmarks.
+ *
+ * Runs the benchmarks listed in GATED_BENCHMARKS and compares their
+ * throughput (items or bytes per second) with the baseline stored for the
+ * instruction set the suite was compiled for, in baselines/<isa>.txt.
+ *
+ * Throughputs are compared as ratios to the throughput of BM_PerfReference in
+ * the same run, a scalar loop that does not use the library. This cancels the
+ * clock speed of the machine and most of the load from other processes. The
+ * baselines of one instruction set therefore carry over to other machines,
+ * though not exactly across microarchitectures. The best ratio over the
+ * repetitions of each benchmark is compared, which is the least sensitive to
+ * other load on the machine. Benchmarks slower than their baseline run a second
+ * time before being reported.
+ *
+ * The exit status is 1 when a benchmark is still slower than its baseline by
+ * more than the threshold or has no baseline. It is 77, reported as skipped by
+ * CTest, when there is no baseline file for the instruction set.
+ *
+ * Options, the others being passed to Google Benchmark:
+ * - --baseline=FILE: baseline file to use instead of baselines/<isa>.txt.
+ * - --threshold=FRACTION: tolerated slowdown, 0.35 by default.
+ * - --update: write the best ratios of two passes to the baseline file instead
+ *   of comparing them.
+ *
+ * Baseline files hold one "<benchmark> <counter> <ratio>" line per benchmark;
+ * lines starting with '#' are comments.
+ */
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "linalg/Simd.hpp"
+
+namespace {
+
+const int SKIPPED = 77;
+
+const char* const REFERENCE_BENCHMARK = "BM_PerfReference";
+
+// Mat4 products and inverses, batch transforms and normalizations: the
+// operations whose speed callers depend on.
+const char* const GATED_BENCHMARKS[] = {
+    "BM_Mat4Multiply<float>",
+    "BM_Mat4Multiply<double>",
+    "BM_Mat4Vec4Multiply<float>",
+    "BM_Mat4Inverse<float>",
+    "BM_Mat4Inverse<double>",
+    "BM_Mat4InverseAffine<float>",
+    "BM_TransformPoints<float>/4096",
+    "BM_TransformPoints<double>/4096",
+    "BM_TransformDirections<float>/4096",
+    "BM_Vec3Normalized<float>",
+    "BM_Vec3Normalized<double>",
+    "BM_SoANormalize<float>/4096",
+};
+
+// Dependent chain of scalar multiply-adds, which compilers cannot vectorize
+// without fast-math: its speed follows the clock and the load of the machine,
+// not the library.
+void BM_PerfReference(benchmark::State& state) {
+  const int STEPS = 1024;
+  double    x     = 1;
+  for(auto _ : state) {
+    for(int i = 0; i < STEPS; ++i) {
+      x = x * 0.999999 + 1e-6; // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+    }
+    benchmark::DoNotOptimize(x);
+  }
+  state.SetItemsProcessed(state.iterations() * STEPS);
+}
+BENCHMARK(BM_PerfReference);
+
+const char* isaName() {
+#if LINALG_HAS_AVX512F
+  return "avx512";
+#elif LINALG_HAS_AVX2
+  return "avx2";
+#elif LINALG_HAS_AVX
+  return "avx";
+#elif LINALG_HAS_SSE41
+  return "sse41";
+#elif LINALG_HAS_SSE2
+  return "sse2";
+#elif LINALG_HAS_NEON
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
+
+struct Throughput {
+  std::string counter;
+  double      value = 0;
+};
+
+std::string escapeRegex(const std::string& text) {
+  std::string escaped;
+  for(const char c : text) {
+    if(std::strchr("\\^$.|?*+()[]{}", c) != nullptr) {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+/**
+ * @brief Console reporter that also keeps the best throughput of each
+ * benchmark over the repetitions of a pass.
+ */
+class GateReporter : public benchmark::ConsoleReporter {
+public:
+  void ReportRuns(const std::vector<Run>& reports) override {
+    ConsoleReporter::ReportRuns(reports);
+    for(const Run& run : reports) {
+      if(run.run_type != Run::RT_Iteration || run.error_occurred) {
+        continue;
+      }
+      Throughput measured;
+      for(const char* counter : {"bytes_per_second", "items_per_second"}) {
+        const auto it = run.counters.find(counter);
+        if(it != run.counters.end()) {
+          measured.counter = counter;
+          measured.value   = it->second.value;
+          break;
+        }
+      }
+      if(measured.counter.empty()) {
+        continue;
+      }
+      Throughput& best = results[run.benchmark_name()];
+      if(measured.value > best.value) {
+        best = measured;
+      }
+    }
+  }
+
+  std::map<std::string, Throughput> results;
+};
+
+bool readBaseline(const std::string& path, std::map<std::string, Throughput>& baseline) {
+  std::ifstream file(path);
+  if(!file) {
+    return false;
+  }
+  std::string line;
+  while(std::getline(file, line)) {
+    if(line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    std::string        name;
+    Throughput         entry;
+    if(fields >> name >> entry.counter >> entry.value) {
+      baseline[name] = entry;
+    }
+  }
+  return true;
+}
+
+int writeBaseline(const std::string& path, const std::map<std::string, Throughput>& results) {
+  std::ofstream file(path);
+  if(!file) {
+    std::cerr << "Cannot write baseline file " << path << '\n';
+    return 1;
+  }
+  file << "# Throughput baselines of linalg_PerfGate for " << isaName() << " builds, as ratios to "
+       << REFERENCE_BENCHMARK << ".\n";
+  file << "# <benchmark> <counter> <ratio>, regenerate with `make perf-baseline`.\n";
+  for(const char* name : GATED_BENCHMARKS) {
+    const auto it = results.find(name);
+    if(it == results.end()) {
+      std::cerr << "No throughput measured for " << name << '\n';
+      return 1;
+    }
+    file << name << ' ' << it->second.counter << ' ' << it->second.value << '\n';
+  }
+  std::cout << "Wrote " << path << '\n';
+  return 0;
+}
+
+bool isRegression(const std::map<std::string, Throughput>& baseline, const std::map<std::string, Throughput>& results,
+                  const std::string& name, double threshold) {
+  const auto expected = baseline.find(name);
+  const auto measured = results.find(name);
+  return expected == baseline.end() || measured == results.end() ||
+         expected->second.counter != measured->second.counter ||
+         measured->second.value < (1 - threshold) * expected->second.value;
+}
+
+// Regex matching exactly the given benchmark names and the reference benchmark.
+std::string filterOf(const std::vector<std::string>& names) {
+  std::string filter = std::string("^(") + REFERENCE_BENCHMARK;
+  for(const std::string& name : names) {
+    filter += "|" + escapeRegex(name);
+  }
+  return filter + ")$";
+}
+
+/**
+ * @brief Runs one pass of the given benchmarks and the reference benchmark, and
+ * keeps in ratios the best ratio of each benchmark to the reference benchmark
+ * of the same pass.
+ * @return false if the reference benchmark reported no throughput.
+ */
+bool runPass(GateReporter& reporter, const std::vector<std::string>& names,
+             std::map<std::string, Throughput>& ratios) {
+  reporter.results.clear();
+  benchmark::RunSpecifiedBenchmarks(&reporter, filterOf(names));
+  const auto reference = reporter.results.find(REFERENCE_BENCHMARK);
+  if(reference == reporter.results.end() || reference->second.value <= 0) {
+    std::cerr << "No throughput measured for " << REFERENCE_BENCHMARK << '\n';
+    return false;
+  }
+  for(const auto& result : reporter.results) {
+    if(result.first == REFERENCE_BENCHMARK) {
+      continue;
+    }
+    const double ratio = result.second.value / reference->second.value;
+    Throughput&  best  = ratios[result.first];
+    if(ratio > best.value) {
+      best.counter = result.second.counter;
+      best.value   = ratio;
+    }
+  }
+  return true;
+}
+
+int compare(const std::map<std::string, Throughput>& baseline, const std::map<std::string, Throughput>& results,
+            double threshold) {
+  int failures = 0;
+  std::printf("\nThroughputs relative to %s\n%-40s %14s %14s %8s\n", REFERENCE_BENCHMARK, "Benchmark", "Baseline",
+              "Measured", "Change");
+  for(const char* name : GATED_BENCHMARKS) {
+    const bool failed   = isRegression(baseline, results, name, threshold);
+    const auto expected = baseline.find(name);
+    const auto measured = results.find(name);
+    failures += failed ? 1 : 0;
+    if(expected == baseline.end() || measured == results.end() ||
+       expected->second.counter != measured->second.counter) {
+      std::printf("%-40s %14s %14s %8s  FAIL (no baseline or measurement)\n", name, "-", "-", "-");
+      continue;
+    }
+    const double change = measured->second.value / expected->second.value - 1;
+    std::printf("%-40s %14.4g %14.4g %+7.1f%%%s\n", name, expected->second.value, measured->second.value,
+                100 * change, failed ? "  FAIL" : "");
+  }
+  std::printf("\n%d of %zu benchmarks slower than their baseline by more than %.0f%% (%s)\n", failures,
+              sizeof(GATED_BENCHMARKS) / sizeof(GATED_BENCHMARKS[0]), 100 * threshold, isaName());
+  return failures == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string baseline_path = std::string(LINALG_PERF_BASELINE_DIR) + "/" + isaName() + ".txt";
+  double      threshold     = 0.35;
+  bool        update        = false;
+
+  // The default comes first so that a repetition count given on the command line overrides it.
+  std::string        repetitions = "--benchmark_repetitions=5";
+  std::vector<char*> args        = {argv[0], &repetitions[0]};
+  for(int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if(arg.compare(0, 11, "--baseline=") == 0) {
+      baseline_path = arg.substr(11);
+    } else if(arg.compare(0, 12, "--threshold=") == 0) {
+      threshold = std::atof(arg.c_str() + 12);
+    } else if(arg == "--update") {
+      update = true;
+    } else {
+      args.push_back(argv[i]);
+    }
+  }
+
+  std::map<std::string, Throughput> baseline;
+  if(!update && !readBaseline(baseline_path, baseline)) {
+    std::cout << "No baseline for " << isaName() << " builds (" << baseline_path
+              << "), run linalg_PerfGate --update to record one\n";
+    return SKIPPED;
+  }
+
+  int count = static_cast<int>(args.size());
+  benchmark::Initialize(&count, args.data());
+  if(benchmark::ReportUnrecognizedArguments(count, args.data())) {
+    return 1;
+  }
+  GateReporter                      reporter;
+  std::map<std::string, Throughput> ratios;
+  if(!runPass(reporter, {std::begin(GATED_BENCHMARKS), std::end(GATED_BENCHMARKS)}, ratios)) {
+    return 1;
+  }
+
+  // A slowdown has to reproduce to fail the gate: the benchmarks that regressed
+  // run once more and keep the best of both passes. Baselines always take the
+  // best of two passes, so that one pass under load does not lower them.
+  std::vector<std::string> slower;
+  for(const char* name : GATED_BENCHMARKS) {
+    if(update || isRegression(baseline, ratios, name, threshold)) {
+      slower.push_back(name);
+    }
+  }
+  if(!slower.empty()) {
+    std::cout << "\nRunning " << (update ? "the" : "the slower") << ' ' << slower.size() << " benchmarks again\n";
+    if(!runPass(reporter, slower, ratios)) {
+      return 1;
+    }
+  }
+  benchmark::Shutdown();
+
+  return update ? writeBaseline(baseline_path, ratios) : compare(baseline, ratios, threshold);
+}
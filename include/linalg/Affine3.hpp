@@ -0,0 +1,456 @@
+/**
+ * @file Affine3.hpp
+ * @brief 3x4 affine matrix and perspective projection types.
+ *
+ * View matrices from Mat4::LookAt() and most model matrices have a constant
+ * bottom row of [0 0 0 1], and a perspective projection is mostly zeros. Affine3
+ * stores only the top three rows (48 bytes for float instead of 64), and
+ * PerspectiveProjection only its four non-constant elements, so that their
+ * products skip the structurally zero terms of the general Mat4 product.
+ */
+#ifndef LINALG_AFFINE3_HPP
+#define LINALG_AFFINE3_HPP
+
+#include <array>
+#include <cmath>
+#include <iostream>
+
+#include "Alignment.hpp"
+#include "Instrument.hpp"
+#include "Mat3.hpp"
+#include "Mat4.hpp"
+#include "Pack.hpp"
+#include "Vec3.hpp"
+#include "Vec4.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+/**
+ * @brief Computes out = a * b for 4-element rows, where a has `rows` rows and b
+ * is a 3x4 affine matrix with an implicit bottom row of [0 0 0 1].
+ *
+ * Each output row is a linear combination of the three rows of b plus the last
+ * element of the row of a, added to the translation column.
+ */
+template <typename T> inline void multiplyAffineRows(const T* a, const T* b, T* out, int rows) noexcept {
+  using P           = simd::Pack<T, 4>;
+  const T unit_w[4] = {0, 0, 0, 1};
+  const P b0        = P::load(b);
+  const P b1        = P::load(b + 4);
+  const P b2        = P::load(b + 8);
+  const P w         = P::load(unit_w);
+  for(int i = 0; i < rows; ++i) {
+    const T* row = a + 4 * i;
+    const P  r   = simd::madd(P::broadcast(row[0]), b0,
+                              simd::madd(P::broadcast(row[1]), b1,
+                                         simd::madd(P::broadcast(row[2]), b2, P::broadcast(row[3]) * w)));
+    r.store(out + 4 * i);
+  }
+}
+
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+
+/**
+ * @brief Affine transformation stored as the top three rows of a 4x4 matrix
+ * (row-major), the bottom row being implicitly [0 0 0 1].
+ * @tparam T The type of the elements in the matrix (e.g., float, double).
+ */
+template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Affine3 {
+  std::array<std::array<T, 4>, 3> m{};
+
+  /**
+   * @brief Default constructor initializes the matrix to the identity.
+   */
+  constexpr Affine3() noexcept : m{{{{1.0, 0.0, 0.0, 0.0}}, {{0.0, 1.0, 0.0, 0.0}}, {{0.0, 0.0, 1.0, 0.0}}}} {}
+
+  /**
+   * @brief Constructor that initializes the matrix element by element, in
+   * row-major order.
+   * @param m00 ... m23 The elements of the top three rows, mij being at row i
+   * and column j.
+   */
+  constexpr Affine3(T m00, T m01, T m02, T m03, T m10, T m11, T m12, T m13, T m20, T m21, T m22, T m23) noexcept
+      : m{{{{m00, m01, m02, m03}}, {{m10, m11, m12, m13}}, {{m20, m21, m22, m23}}}} {}
+
+  /**
+   * @brief Constructor that initializes the matrix from its linear part and its
+   * translation.
+   * @param linear The top-left 3x3 block.
+   * @param translation The last column.
+   */
+  constexpr Affine3(const Mat3<T>& linear, const Vec3<T>& translation) noexcept
+      : m{{{{linear.m[0][0], linear.m[0][1], linear.m[0][2], translation.x}},
+           {{linear.m[1][0], linear.m[1][1], linear.m[1][2], translation.y}},
+           {{linear.m[2][0], linear.m[2][1], linear.m[2][2], translation.z}}}} {}
+
+  /**
+   * @brief Constructor that keeps the top three rows of a 4x4 matrix.
+   * @param mat The matrix, assumed to have a bottom row of [0 0 0 1].
+   */
+  explicit constexpr Affine3(const Mat4<T>& mat) noexcept
+      : m{{{{mat.m[0][0], mat.m[0][1], mat.m[0][2], mat.m[0][3]}},
+           {{mat.m[1][0], mat.m[1][1], mat.m[1][2], mat.m[1][3]}},
+           {{mat.m[2][0], mat.m[2][1], mat.m[2][2], mat.m[2][3]}}}} {}
+
+  /**
+   * @brief Returns a pointer to the 12 row-major elements of the matrix.
+   */
+  const T* data() const noexcept { return &m[0][0]; }
+
+  /**
+   * @brief Accesses the element at (row, col), row being at most 2.
+   */
+  constexpr T& operator()(int row, int col) noexcept { return m[row][col]; }
+
+  /**
+   * @brief Accesses the element at (row, col), row being at most 2 (const
+   * version).
+   */
+  constexpr T operator()(int row, int col) const noexcept { return m[row][col]; }
+
+  bool operator==(const Affine3& other) const { return m == other.m; }
+
+  bool operator!=(const Affine3& other) const { return !(*this == other); }
+
+  /**
+   * @brief Returns the equivalent 4x4 matrix.
+   */
+  constexpr Mat4<T> toMat4() const noexcept {
+    return {m[0][0], m[0][1], m[0][2], m[0][3], m[1][0], m[1][1], m[1][2], m[1][3],
+            m[2][0], m[2][1], m[2][2], m[2][3], 0,       0,       0,       1};
+  }
+
+  /**
+   * @brief Returns the top-left 3x3 block.
+   */
+  constexpr Mat3<T> linear() const noexcept {
+    return {m[0][0], m[0][1], m[0][2], m[1][0], m[1][1], m[1][2], m[2][0], m[2][1], m[2][2]};
+  }
+
+  /**
+   * @brief Returns the translation, the last column.
+   */
+  constexpr Vec3<T> translation() const noexcept { return {m[0][3], m[1][3], m[2][3]}; }
+
+  /**
+   * @brief Multiplies this matrix by another affine matrix.
+   *
+   * Only the three stored rows are computed, each from the three rows of other:
+   * 36 multiplications instead of the 64 of the Mat4 product (12 four-wide
+   * multiply-adds instead of 16 with SIMD).
+   * @param other The matrix to multiply with.
+   * @return The affine matrix this * other.
+   */
+  Affine3 operator*(const Affine3& other) const noexcept {
+    Affine3 result;
+    detail::multiplyAffineRows(data(), other.data(), &result.m[0][0], 3);
+    return result;
+  }
+
+  /**
+   * @brief Multiplies this matrix by another affine matrix and assigns the
+   * result to this matrix.
+   * @param other The matrix to multiply with.
+   * @return A reference to this matrix after the multiplication.
+   */
+  Affine3& operator*=(const Affine3& other) noexcept {
+    *this = *this * other;
+    return *this;
+  }
+
+  /**
+   * @brief Transforms a point, A * p + t.
+   * @param point The point to transform.
+   * @return The transformed point.
+   */
+  Vec3<T> transformPoint(const Vec3<T>& point) const noexcept {
+    return {m[0][0] * point.x + m[0][1] * point.y + m[0][2] * point.z + m[0][3],
+            m[1][0] * point.x + m[1][1] * point.y + m[1][2] * point.z + m[1][3],
+            m[2][0] * point.x + m[2][1] * point.y + m[2][2] * point.z + m[2][3]};
+  }
+
+  /**
+   * @brief Transforms a direction, A * d, ignoring the translation.
+   * @param direction The direction to transform.
+   * @return The transformed direction.
+   */
+  Vec3<T> transformDirection(const Vec3<T>& direction) const noexcept {
+    return {m[0][0] * direction.x + m[0][1] * direction.y + m[0][2] * direction.z,
+            m[1][0] * direction.x + m[1][1] * direction.y + m[1][2] * direction.z,
+            m[2][0] * direction.x + m[2][1] * direction.y + m[2][2] * direction.z};
+  }
+
+  /**
+   * @brief Returns the inverse of the matrix.
+   *
+   * The inverse of the linear part is obtained from the cross products of its
+   * rows, as in Mat4::inverseAffine(), followed by the translation fixup
+   * -inverse(A) * t.
+   * @return The inverse, or the identity if the linear part is singular.
+   */
+  Affine3 inverse() const noexcept {
+    const Vec3<T> r0(m[0][0], m[0][1], m[0][2]);
+    const Vec3<T> r1(m[1][0], m[1][1], m[1][2]);
+    const Vec3<T> r2(m[2][0], m[2][1], m[2][2]);
+
+    // Columns of the adjugate of the linear part
+    const Vec3<T> c0 = r1.cross(r2);
+    const Vec3<T> c1 = r2.cross(r0);
+    const Vec3<T> c2 = r0.cross(r1);
+
+    const T det = r0.x * c0.x + r0.y * c0.y + r0.z * c0.z;
+    if(det == T(0)) {
+      LINALG_INSTRUMENT_COUNT(AffineInverseSingular);
+      return Affine3{};
+    }
+    const T inv_det = T(1) / det;
+    return withTranslationFixup(c0.x * inv_det, c1.x * inv_det, c2.x * inv_det, c0.y * inv_det, c1.y * inv_det,
+                                c2.y * inv_det, c0.z * inv_det, c1.z * inv_det, c2.z * inv_det);
+  }
+
+  /**
+   * @brief Returns the inverse of a rigid transformation, the transposed
+   * rotation followed by the translation fixup -transpose(R) * t.
+   * @return The inverse, assuming the linear part is a rotation.
+   */
+  Affine3 inverseRigid() const noexcept {
+    return withTranslationFixup(m[0][0], m[1][0], m[2][0], m[0][1], m[1][1], m[2][1], m[0][2], m[1][2], m[2][2]);
+  }
+
+  /**
+   * @brief Checks if this matrix is approximately equal to another matrix
+   * within a given epsilon.
+   * @param other The matrix to compare with.
+   * @param epsilon The tolerance for comparison.
+   * @return True if the matrices are approximately equal, false otherwise.
+   */
+  bool isApprox(const Affine3& other, T epsilon) const {
+    for(int i = 0; i < 3; ++i) {
+      for(int j = 0; j < 4; ++j) {
+        if(std::abs(m[i][j] - other.m[i][j]) > epsilon) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Returns the identity matrix.
+   */
+  static constexpr Affine3 Identity() noexcept { return Affine3{}; }
+
+  /**
+   * @brief Returns the view matrix of Mat4::LookAt().
+   * @param eye The position of the camera in world space.
+   * @param center The point in world space that the camera is looking at.
+   * @param up The up direction in world space.
+   */
+  static Affine3 LookAt(const Vec3<T>& eye, const Vec3<T>& center, const Vec3<T>& up) noexcept {
+    return Affine3(Mat4<T>::LookAt(eye, center, up));
+  }
+
+  /**
+   * @brief Returns the orthographic projection matrix of Mat4::Orthographic(),
+   * which is affine.
+   */
+  static constexpr Affine3 Orthographic(T left, T right, T bottom, T top, T near, T far) noexcept {
+    return Affine3(Mat4<T>::Orthographic(left, right, bottom, top, near, far));
+  }
+
+private:
+  // Builds the affine matrix with the given linear part and the translation
+  // -linear * t, t being the translation of this matrix.
+  Affine3 withTranslationFixup(T a00, T a01, T a02, T a10, T a11, T a12, T a20, T a21, T a22) const noexcept {
+    const T tx = m[0][3];
+    const T ty = m[1][3];
+    const T tz = m[2][3];
+    return {a00, a01, a02, -(a00 * tx + a01 * ty + a02 * tz), a10, a11, a12, -(a10 * tx + a11 * ty + a12 * tz),
+            a20, a21, a22, -(a20 * tx + a21 * ty + a22 * tz)};
+  }
+};
+
+/**
+ * @brief Multiplies a 4x4 matrix by an affine matrix.
+ *
+ * The implicit bottom row of b is not multiplied: the last element of each row
+ * of a is added to the translation column.
+ * @param a The left-hand side matrix, typically a projection.
+ * @param b The affine matrix, typically a view or model matrix.
+ * @return The 4x4 matrix a * b.
+ */
+template <typename T> inline Mat4<T> operator*(const Mat4<T>& a, const Affine3<T>& b) noexcept {
+  Mat4<T> result;
+  detail::multiplyAffineRows(a.data(), b.data(), &result.m[0][0], 4);
+  return result;
+}
+
+/**
+ * @brief Perspective projection stored as the four non-constant elements of
+ * the matrix of Mat4::Perspective():
+ *
+ *     [x_scale 0       0       0       ]
+ *     [0       y_scale 0       0       ]
+ *     [0       0       z_scale z_offset]
+ *     [0       0       -1      0       ]
+ *
+ * Multiplying it by a matrix scales two rows and combines the third with the
+ * fourth, instead of the 64 multiplications of the Mat4 product.
+ * @tparam T The type of the elements in the matrix (e.g., float, double).
+ */
+template <typename T> struct PerspectiveProjection {
+  T x_scale  = 1;
+  T y_scale  = 1;
+  T z_scale  = -1;
+  T z_offset = 0;
+
+  /**
+   * @brief Default constructor initializes a projection with a 90 degree
+   * field of view, an aspect ratio of 1, z_scale = -1 and z_offset = 0.
+   */
+  constexpr PerspectiveProjection() noexcept = default;
+
+  /**
+   * @brief Constructor with the same parameters as Mat4::Perspective().
+   * @param fov_y The vertical field of view in radians.
+   * @param aspect The aspect ratio (width/height).
+   * @param near The near clipping plane.
+   * @param far The far clipping plane.
+   */
+  PerspectiveProjection(T fov_y, T aspect, T near, T far) noexcept
+      : x_scale(T(1) / std::tan(fov_y / 2) / aspect), y_scale(T(1) / std::tan(fov_y / 2)),
+        z_scale(-(far + near) / (far - near)), z_offset(-(2 * far * near) / (far - near)) {}
+
+  /**
+   * @brief Returns a projection with an infinite far plane: the limit of
+   * Mat4::Perspective() as far grows, mapping near to -1 and infinity to 1.
+   * @param fov_y The vertical field of view in radians.
+   * @param aspect The aspect ratio (width/height).
+   * @param near The near clipping plane.
+   */
+  static PerspectiveProjection Infinite(T fov_y, T aspect, T near) noexcept {
+    return withDepth(fov_y, aspect, T(-1), -2 * near);
+  }
+
+  /**
+   * @brief Returns a reversed-Z projection for a [0, 1] depth range, mapping
+   * near to 1 and far to 0, which spreads the floating-point depth precision
+   * evenly with distance.
+   *
+   * The clip volume is that of Direct3D and Vulkan (or OpenGL with
+   * glClipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE)); Frustum::FromMatrix() assumes
+   * the OpenGL volume, for which its depth planes are conservative.
+   * @param fov_y The vertical field of view in radians.
+   * @param aspect The aspect ratio (width/height).
+   * @param near The near clipping plane.
+   * @param far The far clipping plane.
+   */
+  static PerspectiveProjection ReversedZ(T fov_y, T aspect, T near, T far) noexcept {
+    return withDepth(fov_y, aspect, near / (far - near), far * near / (far - near));
+  }
+
+  /**
+   * @brief Returns a reversed-Z projection with an infinite far plane, mapping
+   * near to 1 and infinity to 0 in a [0, 1] depth range.
+   * @param fov_y The vertical field of view in radians.
+   * @param aspect The aspect ratio (width/height).
+   * @param near The near clipping plane.
+   */
+  static PerspectiveProjection ReversedInfinite(T fov_y, T aspect, T near) noexcept {
+    return withDepth(fov_y, aspect, T(0), near);
+  }
+
+  /**
+   * @brief Returns the equivalent 4x4 matrix, that of Mat4::Perspective().
+   */
+  constexpr Mat4<T> toMat4() const noexcept {
+    return {x_scale, 0, 0, 0, 0, y_scale, 0, 0, 0, 0, z_scale, z_offset, 0, 0, -1, 0};
+  }
+
+  /**
+   * @brief Multiplies the projection by an affine matrix (the view-projection
+   * of a view matrix).
+   * @param view The affine matrix.
+   * @return The 4x4 matrix P * view.
+   */
+  Mat4<T> operator*(const Affine3<T>& view) const noexcept {
+    using P           = simd::Pack<T, 4>;
+    const T unit_w[4] = {0, 0, 0, 1};
+    return multiply(P::load(view.m[0].data()), P::load(view.m[1].data()), P::load(view.m[2].data()),
+                    P::load(unit_w));
+  }
+
+  /**
+   * @brief Multiplies the projection by a 4x4 matrix.
+   * @param mat The matrix.
+   * @return The 4x4 matrix P * mat.
+   */
+  Mat4<T> operator*(const Mat4<T>& mat) const noexcept {
+    using P = simd::Pack<T, 4>;
+    return multiply(P::load(mat.m[0].data()), P::load(mat.m[1].data()), P::load(mat.m[2].data()),
+                    P::load(mat.m[3].data()));
+  }
+
+  /**
+   * @brief Transforms a vector in homogeneous coordinates.
+   * @param vec The vector to transform.
+   * @return The clip space vector P * vec.
+   */
+  constexpr Vec4<T> operator*(const Vec4<T>& vec) const noexcept {
+    return {x_scale * vec.x, y_scale * vec.y, z_scale * vec.z + z_offset * vec.w, -vec.z};
+  }
+
+private:
+  // Projection with the scales of fov_y and aspect and the given depth mapping.
+  static PerspectiveProjection withDepth(T fov_y, T aspect, T z_scale, T z_offset) noexcept {
+    PerspectiveProjection projection;
+    projection.y_scale  = T(1) / std::tan(fov_y / 2);
+    projection.x_scale  = projection.y_scale / aspect;
+    projection.z_scale  = z_scale;
+    projection.z_offset = z_offset;
+    return projection;
+  }
+
+  // Rows of P * M from the rows of M.
+  Mat4<T> multiply(const simd::Pack<T, 4>& r0, const simd::Pack<T, 4>& r1, const simd::Pack<T, 4>& r2,
+                   const simd::Pack<T, 4>& r3) const noexcept {
+    using P = simd::Pack<T, 4>;
+    Mat4<T> result;
+    (P::broadcast(x_scale) * r0).store(result.m[0].data());
+    (P::broadcast(y_scale) * r1).store(result.m[1].data());
+    simd::madd(P::broadcast(z_scale), r2, P::broadcast(z_offset) * r3).store(result.m[2].data());
+    (-r2).store(result.m[3].data());
+    return result;
+  }
+};
+
+// GCOVR_EXCL_START
+/**
+ * @brief Overloaded output operator for Affine3.
+ * @param os The output stream.
+ * @param mat The Affine3 object to output.
+ * @return The output stream after writing the Affine3 object.
+ */
+template <typename T> inline std::ostream& operator<<(std::ostream& os, const Affine3<T>& mat) {
+  return os << "Affine3(\n"
+            << "  [" << mat.m[0][0] << ", " << mat.m[0][1] << ", " << mat.m[0][2] << ", " << mat.m[0][3] << "]\n"
+            << "  [" << mat.m[1][0] << ", " << mat.m[1][1] << ", " << mat.m[1][2] << ", " << mat.m[1][3] << "]\n"
+            << "  [" << mat.m[2][0] << ", " << mat.m[2][1] << ", " << mat.m[2][2] << ", " << mat.m[2][3] << "]\n"
+            << ")";
+}
+// GCOVR_EXCL_STOP
+
+using Affine3d = Affine3<double>;
+using Affine3f = Affine3<float>;
+
+} // namespace linalg
+
+#endif // LINALG_AFFINE3_HPP
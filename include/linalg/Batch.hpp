@@ -0,0 +1,77 @@
+/**
+ * @file Batch.hpp
+ * @brief Batched operations applying one operation to arrays of vectors.
+ */
+#ifndef LINALG_BATCH_HPP
+#define LINALG_BATCH_HPP
+
+#include <cstddef>
+
+#include "Mat4.hpp"
+#include "Mat4Kernels.hpp"
+#include "Vec3.hpp"
+#include "Vec4.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Transforms an array of points by a Mat4.
+ *
+ * Each point is transformed as toVec3(mat * toVec4(point)), without a
+ * perspective divide.
+ * @param mat The transformation matrix.
+ * @param in The input points.
+ * @param out The output points. It may be the same array as in but must not
+ * otherwise overlap it.
+ * @param count The number of points.
+ * @tparam T The type of the vector elements.
+ */
+template <typename T>
+inline void transformPoints(const Mat4<T>& mat, const Vec3<T>* in, Vec3<T>* out, std::size_t count) noexcept {
+  static_assert(sizeof(Vec3<T>) == 4 * sizeof(T), "Vec3 is expected to be padded to four elements");
+  detail::Mat4Kernels<T>::template transformArray<detail::HomogeneousW::One>(
+      mat.data(), reinterpret_cast<const T*>(in), reinterpret_cast<T*>(out), count);
+}
+
+/**
+ * @brief Transforms an array of directions by a Mat4.
+ *
+ * Each direction is transformed with a homogeneous coordinate of 0, so the
+ * translation part of the matrix is ignored.
+ * @param mat The transformation matrix.
+ * @param in The input directions.
+ * @param out The output directions. It may be the same array as in but must
+ * not otherwise overlap it.
+ * @param count The number of directions.
+ * @tparam T The type of the vector elements.
+ */
+template <typename T>
+inline void transformDirections(const Mat4<T>& mat, const Vec3<T>* in, Vec3<T>* out, std::size_t count) noexcept {
+  static_assert(sizeof(Vec3<T>) == 4 * sizeof(T), "Vec3 is expected to be padded to four elements");
+  detail::Mat4Kernels<T>::template transformArray<detail::HomogeneousW::Zero>(
+      mat.data(), reinterpret_cast<const T*>(in), reinterpret_cast<T*>(out), count);
+}
+
+/**
+ * @brief Transforms an array of Vec4 vectors by a Mat4.
+ * @param mat The transformation matrix.
+ * @param in The input vectors.
+ * @param out The output vectors. It may be the same array as in but must not
+ * otherwise overlap it.
+ * @param count The number of vectors.
+ * @tparam T The type of the vector elements.
+ */
+template <typename T>
+inline void transformVectors(const Mat4<T>& mat, const Vec4<T>* in, Vec4<T>* out, std::size_t count) noexcept {
+  static_assert(sizeof(Vec4<T>) == 4 * sizeof(T), "Vec4 is expected to hold exactly four elements");
+  detail::Mat4Kernels<T>::template transformArray<detail::HomogeneousW::Input>(
+      mat.data(), reinterpret_cast<const T*>(in), reinterpret_cast<T*>(out), count);
+}
+
+} // namespace linalg
+
+#endif // LINALG_BATCH_HPP
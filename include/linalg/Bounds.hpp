@@ -0,0 +1,635 @@
+/**
+ * @file Bounds.hpp
+ * @brief Bounding volumes (axis-aligned boxes, spheres and view frustums) and
+ * batched culling and ray tests.
+ *
+ * Culling tests thousands of boxes against the same frustum or ray every frame.
+ * AABBSoA stores the box corners as structure-of-arrays, so that cull() and
+ * intersectRay() test one box per SIMD lane.
+ */
+#ifndef LINALG_BOUNDS_HPP
+#define LINALG_BOUNDS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#include "Affine3.hpp"
+#include "Mat4.hpp"
+#include "Pack.hpp"
+#include "SoA.hpp"
+#include "Vec3.hpp"
+#include "Vec3Packet.hpp"
+#include "Vec4.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Axis-aligned bounding box.
+ *
+ * The default box is empty: its minimum is the largest value and its maximum
+ * the lowest, so that expanding it by a point gives the box of that point.
+ * @tparam T The type of the components (e.g., float, double).
+ */
+template <typename T> struct AABB {
+  Vec3<T> min = Vec3<T>::MaxBounds();
+  Vec3<T> max = Vec3<T>::MinBounds();
+
+  /**
+   * @brief Default constructor initializes an empty box.
+   */
+  AABB() noexcept = default;
+
+  /**
+   * @brief Constructor that initializes the box from its corners.
+   * @param min The minimum corner.
+   * @param max The maximum corner.
+   */
+  AABB(const Vec3<T>& min, const Vec3<T>& max) noexcept : min(min), max(max) {}
+
+  /**
+   * @brief Returns the box of an array of points.
+   * @param points The points.
+   * @param count The number of points.
+   * @return The smallest box containing the points, empty if count is zero.
+   */
+  static AABB FromPoints(const Vec3<T>* points, std::size_t count) noexcept {
+    AABB box;
+    for(std::size_t i = 0; i < count; ++i) {
+      box.expand(points[i]);
+    }
+    return box;
+  }
+
+  /**
+   * @brief Returns the box with the given center and half extent.
+   */
+  static AABB FromCenterExtent(const Vec3<T>& center, const Vec3<T>& half_extent) noexcept {
+    return {center - half_extent, center + half_extent};
+  }
+
+  /**
+   * @brief Checks whether the box is empty (its minimum exceeds its maximum
+   * along an axis).
+   */
+  bool isEmpty() const noexcept { return min.x > max.x || min.y > max.y || min.z > max.z; }
+
+  /**
+   * @brief Returns the center of the box.
+   */
+  Vec3<T> center() const noexcept { return (min + max) * T(0.5); }
+
+  /**
+   * @brief Returns the size of the box along each axis, max - min.
+   */
+  Vec3<T> extent() const noexcept { return max - min; }
+
+  /**
+   * @brief Returns half the size of the box along each axis.
+   */
+  Vec3<T> halfExtent() const noexcept { return (max - min) * T(0.5); }
+
+  /**
+   * @brief Grows the box to contain a point.
+   * @param point The point to include.
+   */
+  void expand(const Vec3<T>& point) noexcept {
+    min = {std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z)};
+    max = {std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z)};
+  }
+
+  /**
+   * @brief Grows the box to contain another box.
+   * @param other The box to include. Merging an empty box has no effect.
+   */
+  void merge(const AABB& other) noexcept {
+    min = {std::min(min.x, other.min.x), std::min(min.y, other.min.y), std::min(min.z, other.min.z)};
+    max = {std::max(max.x, other.max.x), std::max(max.y, other.max.y), std::max(max.z, other.max.z)};
+  }
+
+  /**
+   * @brief Returns the smallest box containing this box and another.
+   */
+  AABB merged(const AABB& other) const noexcept {
+    AABB box = *this;
+    box.merge(other);
+    return box;
+  }
+
+  /**
+   * @brief Checks whether a point lies in the box, boundary included.
+   */
+  bool contains(const Vec3<T>& point) const noexcept {
+    return point.x >= min.x && point.x <= max.x && point.y >= min.y && point.y <= max.y && point.z >= min.z &&
+           point.z <= max.z;
+  }
+
+  /**
+   * @brief Checks whether two boxes overlap, touching boxes included.
+   */
+  bool overlaps(const AABB& other) const noexcept {
+    return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y &&
+           min.z <= other.max.z && max.z >= other.min.z;
+  }
+
+  /**
+   * @brief Returns the box of this box transformed by an affine matrix.
+   *
+   * Uses Arvo's method: each output axis starts at the translation and adds,
+   * for each input axis, the smaller and the larger of the matrix element
+   * times the minimum and the maximum. This is 18 multiplications, instead of
+   * transforming the 8 corners.
+   * @param mat The matrix, assumed to have a bottom row of [0 0 0 1].
+   * @return The smallest box containing the transformed box; an empty box
+   * stays empty.
+   */
+  AABB transformed(const Mat4<T>& mat) const noexcept { return transformed(mat.m); }
+
+  /**
+   * @brief Returns the box of this box transformed by an affine matrix, with
+   * Arvo's method.
+   * @param mat The affine matrix.
+   */
+  AABB transformed(const Affine3<T>& mat) const noexcept { return transformed(mat.m); }
+
+  /**
+   * @brief Intersects a ray with the box, with the slab method.
+   * @param origin The origin of the ray.
+   * @param inv_direction The component-wise inverse of the ray direction
+   * (infinite for a zero component).
+   * @param t_max The largest ray parameter to consider.
+   * @param t_entry Receives the parameter at which the ray enters the box, 0 if
+   * the origin is inside.
+   * @return True if the ray hits the box for a parameter in [0, t_max].
+   * @note A ray lying exactly on a slab plane while parallel to it may be
+   * reported either way.
+   */
+  bool intersectRay(const Vec3<T>& origin, const Vec3<T>& inv_direction, T t_max, T& t_entry) const noexcept {
+    T t_near = 0;
+    T t_far  = t_max;
+    slab(min.x, max.x, origin.x, inv_direction.x, t_near, t_far);
+    slab(min.y, max.y, origin.y, inv_direction.y, t_near, t_far);
+    slab(min.z, max.z, origin.z, inv_direction.z, t_near, t_far);
+    t_entry = t_near;
+    return t_near <= t_far;
+  }
+
+private:
+  template <typename Rows> AABB transformed(const Rows& m) const noexcept {
+    if(isEmpty()) {
+      return *this;
+    }
+    const T lo[3] = {min.x, min.y, min.z};
+    const T hi[3] = {max.x, max.y, max.z};
+    T       out_lo[3];
+    T       out_hi[3];
+    for(int i = 0; i < 3; ++i) {
+      out_lo[i] = m[i][3];
+      out_hi[i] = m[i][3];
+      for(int j = 0; j < 3; ++j) {
+        const T a = m[i][j] * lo[j];
+        const T b = m[i][j] * hi[j];
+        out_lo[i] += std::min(a, b);
+        out_hi[i] += std::max(a, b);
+      }
+    }
+    return {{out_lo[0], out_lo[1], out_lo[2]}, {out_hi[0], out_hi[1], out_hi[2]}};
+  }
+
+  static void slab(T lo, T hi, T origin, T inv_direction, T& t_near, T& t_far) noexcept {
+    const T t0 = (lo - origin) * inv_direction;
+    const T t1 = (hi - origin) * inv_direction;
+    t_near     = std::max(t_near, std::min(t0, t1));
+    t_far      = std::min(t_far, std::max(t0, t1));
+  }
+};
+
+/**
+ * @brief Bounding sphere.
+ * @tparam T The type of the components (e.g., float, double).
+ */
+template <typename T> struct Sphere {
+  Vec3<T> center;
+  T       radius = 0;
+
+  /**
+   * @brief Default constructor initializes a sphere of radius 0 at the origin.
+   */
+  Sphere() noexcept : center(0, 0, 0) {}
+
+  /**
+   * @brief Constructor that initializes the sphere from its center and radius.
+   */
+  Sphere(const Vec3<T>& center, T radius) noexcept : center(center), radius(radius) {}
+
+  /**
+   * @brief Returns the sphere circumscribing a box.
+   * @param box The box, which must not be empty.
+   */
+  static Sphere FromAABB(const AABB<T>& box) noexcept { return {box.center(), box.halfExtent().length()}; }
+
+  /**
+   * @brief Checks whether a point lies in the sphere, boundary included.
+   */
+  bool contains(const Vec3<T>& point) const noexcept {
+    const Vec3<T> d = point - center;
+    return d.x * d.x + d.y * d.y + d.z * d.z <= radius * radius;
+  }
+
+  /**
+   * @brief Checks whether two spheres overlap, touching spheres included.
+   */
+  bool overlaps(const Sphere& other) const noexcept {
+    const Vec3<T> d = other.center - center;
+    const T       r = radius + other.radius;
+    return d.x * d.x + d.y * d.y + d.z * d.z <= r * r;
+  }
+
+  /**
+   * @brief Checks whether the sphere overlaps a box, from the squared distance
+   * between the center and the box (Arvo).
+   */
+  bool overlaps(const AABB<T>& box) const noexcept {
+    const T dx = std::max(std::max(box.min.x - center.x, center.x - box.max.x), T(0));
+    const T dy = std::max(std::max(box.min.y - center.y, center.y - box.max.y), T(0));
+    const T dz = std::max(std::max(box.min.z - center.z, center.z - box.max.z), T(0));
+    return dx * dx + dy * dy + dz * dz <= radius * radius;
+  }
+};
+
+/**
+ * @brief View frustum stored as six planes (a, b, c, d) with unit normals
+ * pointing inside: a point p is on the inner side of a plane when
+ * a * p.x + b * p.y + c * p.z + d >= 0.
+ *
+ * The planes are ordered left, right, bottom, top, near, far.
+ * @tparam T The type of the components (e.g., float, double).
+ */
+template <typename T> class Frustum {
+public:
+  static constexpr int PLANES = 6;
+
+  /**
+   * @brief Default constructor initializes the frustum of the identity matrix,
+   * the cube [-1, 1]^3.
+   */
+  Frustum() noexcept : Frustum(FromMatrix(Mat4<T>::Identity())) {}
+
+  /**
+   * @brief Extracts the frustum of a view-projection matrix (Gribb and
+   * Hartmann), such as Mat4::Perspective() * Mat4::LookAt().
+   *
+   * The planes are sums and differences of the fourth row with the other rows,
+   * for the OpenGL clip volume -w <= x, y, z <= w, normalized so that the plane
+   * equation is a signed distance.
+   * @param view_projection The matrix from world space to clip space.
+   */
+  static Frustum FromMatrix(const Mat4<T>& view_projection) noexcept {
+    const auto& m = view_projection.m;
+    Frustum     frustum(0);
+    for(int i = 0; i < 3; ++i) {
+      frustum.m_planes[2 * i]     = normalizedPlane(m[3][0] + m[i][0], m[3][1] + m[i][1], m[3][2] + m[i][2],
+                                                    m[3][3] + m[i][3]);
+      frustum.m_planes[2 * i + 1] = normalizedPlane(m[3][0] - m[i][0], m[3][1] - m[i][1], m[3][2] - m[i][2],
+                                                    m[3][3] - m[i][3]);
+    }
+    return frustum;
+  }
+
+  /**
+   * @brief Returns the plane at the given index, in the order left, right,
+   * bottom, top, near, far.
+   */
+  const Vec4<T>& plane(int index) const noexcept { return m_planes[index]; }
+
+  /**
+   * @brief Checks whether a point lies in the frustum, boundary included.
+   */
+  bool contains(const Vec3<T>& point) const noexcept {
+    for(const Vec4<T>& p : m_planes) {
+      if(p.x * point.x + p.y * point.y + p.z * point.z + p.w < 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Checks whether a box may be visible.
+   *
+   * The box is culled when it lies entirely outside one of the planes: the
+   * signed distance of its center is below minus its extent projected on the
+   * normal. Boxes near a frustum corner may be kept while outside; this is the
+   * usual conservative test.
+   * @param box The box, which must not be empty.
+   */
+  bool intersects(const AABB<T>& box) const noexcept {
+    const Vec3<T> c = box.center();
+    const Vec3<T> e = box.halfExtent();
+    for(const Vec4<T>& p : m_planes) {
+      const T distance = p.x * c.x + p.y * c.y + p.z * c.z + p.w;
+      const T radius   = std::abs(p.x) * e.x + std::abs(p.y) * e.y + std::abs(p.z) * e.z;
+      if(distance + radius < 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Checks whether a sphere may be visible, with the same conservative
+   * test as for boxes.
+   */
+  bool intersects(const Sphere<T>& sphere) const noexcept {
+    for(const Vec4<T>& p : m_planes) {
+      if(p.x * sphere.center.x + p.y * sphere.center.y + p.z * sphere.center.z + p.w + sphere.radius < 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  explicit Frustum(int /*uninitialized*/) noexcept {}
+
+  static Vec4<T> normalizedPlane(T a, T b, T c, T d) noexcept {
+    const T len = std::sqrt(a * a + b * b + c * c);
+    return len > 0 ? Vec4<T>(a / len, b / len, c / len, d / len) : Vec4<T>(a, b, c, d);
+  }
+
+  Vec4<T> m_planes[PLANES];
+};
+
+/**
+ * @brief Array of boxes stored as the structure-of-arrays of their minimum and
+ * maximum corners.
+ * @tparam T The type of the components (e.g., float, double).
+ */
+template <typename T> class AABBSoA {
+public:
+  /**
+   * @brief Constructs an empty container.
+   */
+  AABBSoA() = default;
+
+  /**
+   * @brief Constructs a container of count boxes with zero corners.
+   */
+  explicit AABBSoA(std::size_t count) : m_min(count), m_max(count) {}
+
+  /**
+   * @brief Creates a container from an array of boxes.
+   * @param in The boxes to copy.
+   * @param count The number of boxes.
+   */
+  static AABBSoA FromAoS(const AABB<T>* in, std::size_t count) {
+    AABBSoA soa(count);
+    for(std::size_t i = 0; i < count; ++i) {
+      soa.set(i, in[i]);
+    }
+    return soa;
+  }
+
+  /**
+   * @brief Returns the number of boxes.
+   */
+  std::size_t size() const noexcept { return m_min.size(); }
+
+  /**
+   * @brief Resizes the container, new boxes having zero corners.
+   */
+  void resize(std::size_t count) {
+    m_min.resize(count);
+    m_max.resize(count);
+  }
+
+  /**
+   * @brief Returns the box at the specified index.
+   */
+  AABB<T> get(std::size_t index) const noexcept { return {m_min.get(index), m_max.get(index)}; }
+
+  /**
+   * @brief Sets the box at the specified index.
+   */
+  void set(std::size_t index, const AABB<T>& box) noexcept {
+    m_min.set(index, box.min);
+    m_max.set(index, box.max);
+  }
+
+  /**
+   * @brief Returns the minimum corners.
+   */
+  const Vec3SoA<T>& min() const noexcept { return m_min; }
+
+  /**
+   * @brief Returns the maximum corners.
+   */
+  const Vec3SoA<T>& max() const noexcept { return m_max; }
+
+private:
+  Vec3SoA<T> m_min;
+  Vec3SoA<T> m_max;
+};
+
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+/**
+ * @brief Appends base + i to indices for every set bit i of bits.
+ */
+inline std::size_t appendIndices(int bits, std::size_t base, std::uint32_t* indices, std::size_t count) noexcept {
+  for(int lane = 0; bits != 0; ++lane, bits >>= 1) {
+    if((bits & 1) != 0) {
+      indices[count++] = static_cast<std::uint32_t>(base + static_cast<std::size_t>(lane));
+    }
+  }
+  return count;
+}
+
+template <typename T> struct CullBoxes {
+  const T*       plane;     ///< The 6 planes (a, b, c, d).
+  const T*       abs_plane; ///< The absolute values of the plane normals, 3 per plane.
+  const T*       lx;
+  const T*       ly;
+  const T*       lz;
+  const T*       hx;
+  const T*       hy;
+  const T*       hz;
+  std::uint32_t* visible;
+  std::size_t*   count;
+
+  // Mask of the lanes whose box is not entirely outside plane k.
+  template <typename P, typename V>
+  static typename P::Mask inside(const T* p, const T* a, const V& c, const V& e) noexcept {
+    const P distance = simd::madd(P::broadcast(p[0]), c.x,
+                                  simd::madd(P::broadcast(p[1]), c.y,
+                                             simd::madd(P::broadcast(p[2]), c.z, P::broadcast(p[3]))));
+    const P radius   = simd::madd(P::broadcast(a[0]), e.x,
+                                  simd::madd(P::broadcast(a[1]), e.y, P::broadcast(a[2]) * e.z));
+    return distance + radius >= P::broadcast(T(0));
+  }
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    using V               = Vec3Packet<T, P::WIDTH>;
+    const V          lo   = V::Load(lx + i, ly + i, lz + i);
+    const V          hi   = V::Load(hx + i, hy + i, hz + i);
+    const P          half = P::broadcast(T(0.5));
+    const V          c    = (lo + hi) * half;
+    const V          e    = (hi - lo) * half;
+    typename P::Mask mask = inside<P>(plane, abs_plane, c, e);
+    for(int k = 1; k < Frustum<T>::PLANES; ++k) {
+      mask = mask & inside<P>(plane + 4 * k, abs_plane + 3 * k, c, e);
+    }
+    *count = appendIndices(mask.bits(), i, visible, *count);
+  }
+};
+
+template <typename T> struct RayBoxes {
+  T              ox;
+  T              oy;
+  T              oz;
+  T              ix;
+  T              iy;
+  T              iz;
+  T              t_max;
+  const T*       lx;
+  const T*       ly;
+  const T*       lz;
+  const T*       hx;
+  const T*       hy;
+  const T*       hz;
+  std::uint32_t* hits;
+  std::size_t*   count;
+
+  template <typename P>
+  static void slab(const P& lo, const P& hi, T origin, T inv_direction, P& t_near, P& t_far) noexcept {
+    const P o  = P::broadcast(origin);
+    const P id = P::broadcast(inv_direction);
+    const P t0 = (lo - o) * id;
+    const P t1 = (hi - o) * id;
+    t_near     = simd::max(t_near, simd::min(t0, t1));
+    t_far      = simd::min(t_far, simd::max(t0, t1));
+  }
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    P t_near = P::broadcast(T(0));
+    P t_far  = P::broadcast(t_max);
+    slab(P::load(lx + i), P::load(hx + i), ox, ix, t_near, t_far);
+    slab(P::load(ly + i), P::load(hy + i), oy, iy, t_near, t_far);
+    slab(P::load(lz + i), P::load(hz + i), oz, iz, t_near, t_far);
+    *count = appendIndices((t_near <= t_far).bits(), i, hits, *count);
+  }
+};
+
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+
+/**
+ * @brief Culls an array of boxes against a frustum, one box per SIMD lane,
+ * with the test of Frustum::intersects().
+ * @param frustum The frustum.
+ * @param boxes The boxes, none of which may be empty.
+ * @param visible Receives the indices of the boxes that may be visible, in
+ * increasing order. It must hold boxes.size() indices.
+ * @return The number of visible boxes.
+ */
+template <typename T>
+inline std::size_t cull(const Frustum<T>& frustum, const AABBSoA<T>& boxes, std::uint32_t* visible) noexcept {
+  T plane[4 * Frustum<T>::PLANES];
+  T abs_plane[3 * Frustum<T>::PLANES];
+  for(int k = 0; k < Frustum<T>::PLANES; ++k) {
+    const Vec4<T>& p     = frustum.plane(k);
+    plane[4 * k]         = p.x;
+    plane[4 * k + 1]     = p.y;
+    plane[4 * k + 2]     = p.z;
+    plane[4 * k + 3]     = p.w;
+    abs_plane[3 * k]     = std::abs(p.x);
+    abs_plane[3 * k + 1] = std::abs(p.y);
+    abs_plane[3 * k + 2] = std::abs(p.z);
+  }
+  std::size_t count = 0;
+  detail::forEachPack<T>(boxes.size(), detail::CullBoxes<T>{plane, abs_plane, boxes.min().x(), boxes.min().y(),
+                                                            boxes.min().z(), boxes.max().x(), boxes.max().y(),
+                                                            boxes.max().z(), visible, &count});
+  return count;
+}
+
+/**
+ * @brief Intersects a ray with an array of boxes, one box per SIMD lane, with
+ * the slab method of AABB::intersectRay().
+ * @param boxes The boxes.
+ * @param origin The origin of the ray.
+ * @param inv_direction The component-wise inverse of the ray direction.
+ * @param t_max The largest ray parameter to consider.
+ * @param hits Receives the indices of the boxes hit for a parameter in
+ * [0, t_max], in increasing order. It must hold boxes.size() indices.
+ * @return The number of boxes hit.
+ */
+template <typename T>
+inline std::size_t intersectRay(const AABBSoA<T>& boxes, const Vec3<T>& origin, const Vec3<T>& inv_direction, T t_max,
+                                std::uint32_t* hits) noexcept {
+  std::size_t count = 0;
+  detail::forEachPack<T>(boxes.size(),
+                         detail::RayBoxes<T>{origin.x, origin.y, origin.z, inv_direction.x, inv_direction.y,
+                                             inv_direction.z, t_max, boxes.min().x(), boxes.min().y(),
+                                             boxes.min().z(), boxes.max().x(), boxes.max().y(), boxes.max().z(), hits,
+                                             &count});
+  return count;
+}
+
+/**
+ * @brief Intersects a packet of rays with one box, one ray per lane, with the
+ * slab method of AABB::intersectRay().
+ * @param box The box.
+ * @param origin The origins of the rays.
+ * @param inv_direction The component-wise inverses of the ray directions.
+ * @param t_max The largest ray parameter to consider, per lane.
+ * @param t_entry Receives the parameter at which each ray enters the box.
+ * @return The mask of the rays hitting the box for a parameter in [0, t_max].
+ */
+template <typename T, int N>
+inline typename Vec3Packet<T, N>::Mask intersectRay(const AABB<T>& box, const Vec3Packet<T, N>& origin,
+                                                    const Vec3Packet<T, N>& inv_direction,
+                                                    const simd::Pack<T, N>& t_max, simd::Pack<T, N>& t_entry) noexcept {
+  using P  = simd::Pack<T, N>;
+  P t_near = P::broadcast(T(0));
+  P t_far  = t_max;
+  const P bounds[6] = {P::broadcast(box.min.x), P::broadcast(box.max.x), P::broadcast(box.min.y),
+                       P::broadcast(box.max.y), P::broadcast(box.min.z), P::broadcast(box.max.z)};
+  const P o[3]      = {origin.x, origin.y, origin.z};
+  const P id[3]     = {inv_direction.x, inv_direction.y, inv_direction.z};
+  for(int k = 0; k < 3; ++k) {
+    const P t0 = (bounds[2 * k] - o[k]) * id[k];
+    const P t1 = (bounds[2 * k + 1] - o[k]) * id[k];
+    t_near     = simd::max(t_near, simd::min(t0, t1));
+    t_far      = simd::min(t_far, simd::max(t0, t1));
+  }
+  t_entry = t_near;
+  return t_near <= t_far;
+}
+
+// GCOVR_EXCL_START
+/**
+ * @brief Overloaded output operator for AABB.
+ */
+template <typename T> inline std::ostream& operator<<(std::ostream& os, const AABB<T>& box) {
+  return os << "AABB(" << box.min << ", " << box.max << ")";
+}
+// GCOVR_EXCL_STOP
+
+using AABBf    = AABB<float>;
+using AABBd    = AABB<double>;
+using Spheref  = Sphere<float>;
+using Sphered  = Sphere<double>;
+using Frustumf = Frustum<float>;
+using Frustumd = Frustum<double>;
+
+} // namespace linalg
+
+#endif // LINALG_BOUNDS_HPP
@@ -0,0 +1,198 @@
+/**
+ * @file Camera.hpp
+ * @brief Combined and batched view-projection matrices.
+ *
+ * viewProjection() builds P * V from the camera basis: the view is assembled as
+ * an Affine3 and multiplied by a PerspectiveProjection, which scales two rows
+ * and combines the depth row with the translation, instead of the 64
+ * multiplications of Mat4::Perspective() * Mat4::LookAt(). viewProjections()
+ * does the same for arrays of cameras, four cameras per SIMD register, for
+ * shadow cascades, cube-map faces or multi-view rendering.
+ */
+#ifndef LINALG_CAMERA_HPP
+#define LINALG_CAMERA_HPP
+
+#include <cstddef>
+
+#include "Affine3.hpp"
+#include "Mat4.hpp"
+#include "Pack.hpp"
+#include "Vec3.hpp"
+#include "Vec3Packet.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Camera placement with the parameters of Mat4::LookAt().
+ * @tparam T The type of the vector elements (e.g., float, double).
+ */
+template <typename T> struct Camera {
+  Vec3<T> eye;
+  Vec3<T> center;
+  Vec3<T> up;
+};
+
+/**
+ * @brief Returns projection * Mat4::LookAt(eye, center, up) without a Mat4
+ * product.
+ * @param projection The perspective projection, for instance
+ * PerspectiveProjection::ReversedZ().
+ * @param eye The position of the camera in world space.
+ * @param center The point in world space that the camera is looking at.
+ * @param up The up direction in world space.
+ * @return The matrix from world space to clip space.
+ * @tparam T The type of the elements in the matrix.
+ */
+template <typename T>
+inline Mat4<T> viewProjection(const PerspectiveProjection<T>& projection, const Vec3<T>& eye, const Vec3<T>& center,
+                              const Vec3<T>& up) noexcept {
+  const Vec3<T>    forward   = (center - eye).normalized();
+  const Vec3<T>    side      = forward.cross(up).normalized();
+  const Vec3<T>    up_vector = side.cross(forward);
+  const T          side_e    = side.x * eye.x + side.y * eye.y + side.z * eye.z;
+  const T          up_e      = up_vector.x * eye.x + up_vector.y * eye.y + up_vector.z * eye.z;
+  const T          forward_e = forward.x * eye.x + forward.y * eye.y + forward.z * eye.z;
+  const Affine3<T> view(side.x, side.y, side.z, -side_e, up_vector.x, up_vector.y, up_vector.z, -up_e, -forward.x,
+                        -forward.y, -forward.z, forward_e);
+  return projection * view;
+}
+
+/**
+ * @brief Returns Mat4::Perspective(fov_y, aspect, near, far) *
+ * Mat4::LookAt(eye, center, up) without a Mat4 product.
+ * @param eye The position of the camera in world space.
+ * @param center The point in world space that the camera is looking at.
+ * @param up The up direction in world space.
+ * @param fov_y The vertical field of view in radians.
+ * @param aspect The aspect ratio (width/height).
+ * @param near The near clipping plane.
+ * @param far The far clipping plane.
+ * @return The matrix from world space to clip space.
+ * @tparam T The type of the elements in the matrix.
+ */
+template <typename T>
+inline Mat4<T> viewProjection(const Vec3<T>& eye, const Vec3<T>& center, const Vec3<T>& up, T fov_y, T aspect, T near,
+                              T far) noexcept {
+  return viewProjection(PerspectiveProjection<T>(fov_y, aspect, near, far), eye, center, up);
+}
+
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+/**
+ * @brief Loads the same Vec3 member of four cameras, one camera per lane.
+ */
+template <typename T>
+inline Vec3Packet<T, 4> loadCameraMember(const Camera<T>* cameras, Vec3<T> Camera<T>::*member) noexcept {
+  using P = simd::Pack<T, 4>;
+  P x     = P::load(reinterpret_cast<const T*>(&(cameras[0].*member)));
+  P y     = P::load(reinterpret_cast<const T*>(&(cameras[1].*member)));
+  P z     = P::load(reinterpret_cast<const T*>(&(cameras[2].*member)));
+  P w     = P::load(reinterpret_cast<const T*>(&(cameras[3].*member)));
+  simd::transpose4(x, y, z, w);
+  return {x, y, z};
+}
+
+/**
+ * @brief Computes the view-projections of four cameras, one camera per lane.
+ *
+ * The padded Vec3 members of the cameras are transposed into one pack per
+ * component, the four bases are computed and normalized together, and the
+ * side, up and forward rows with their translations are transposed back, one
+ * pack per camera, before the projection scales them. A projection stride of 0
+ * uses the same projection for every camera.
+ */
+template <typename T>
+inline void viewProjectionLanes(const PerspectiveProjection<T>* projections, std::size_t projection_stride,
+                                const Camera<T>* cameras, Mat4<T>* out) noexcept {
+  static_assert(sizeof(Vec3<T>) == 4 * sizeof(T), "Vec3 is expected to be padded to four elements");
+  using P      = simd::Pack<T, 4>;
+  using Packet = Vec3Packet<T, 4>;
+
+  const Packet eye       = loadCameraMember(cameras, &Camera<T>::eye);
+  const Packet forward   = normalized(loadCameraMember(cameras, &Camera<T>::center) - eye);
+  const Packet side      = normalized(cross(forward, loadCameraMember(cameras, &Camera<T>::up)));
+  const Packet up_vector = cross(side, forward);
+
+  // Rows of the view matrices with the translation in the last lane, the
+  // forward row being the negated third row and the last row of P * V.
+  P side_rows[4]    = {side.x, side.y, side.z, -dot(side, eye)};
+  P up_rows[4]      = {up_vector.x, up_vector.y, up_vector.z, -dot(up_vector, eye)};
+  P forward_rows[4] = {forward.x, forward.y, forward.z, -dot(forward, eye)};
+  simd::transpose4(side_rows[0], side_rows[1], side_rows[2], side_rows[3]);
+  simd::transpose4(up_rows[0], up_rows[1], up_rows[2], up_rows[3]);
+  simd::transpose4(forward_rows[0], forward_rows[1], forward_rows[2], forward_rows[3]);
+
+  const T unit_w[4] = {0, 0, 0, 1};
+  const P w         = P::load(unit_w);
+  for(int i = 0; i < 4; ++i) {
+    const PerspectiveProjection<T>& projection = projections[i * projection_stride];
+    (P::broadcast(projection.x_scale) * side_rows[i]).store(out[i].m[0].data());
+    (P::broadcast(projection.y_scale) * up_rows[i]).store(out[i].m[1].data());
+    simd::madd(P::broadcast(-projection.z_scale), forward_rows[i], P::broadcast(projection.z_offset) * w)
+        .store(out[i].m[2].data());
+    forward_rows[i].store(out[i].m[3].data());
+  }
+}
+
+/**
+ * @brief Batched view-projections, four cameras at a time then one at a time.
+ */
+template <typename T>
+inline void viewProjectionArray(const PerspectiveProjection<T>* projections, std::size_t projection_stride,
+                                const Camera<T>* cameras, Mat4<T>* out, std::size_t count) noexcept {
+  std::size_t i = 0;
+  for(; i + 4 <= count; i += 4) {
+    viewProjectionLanes(projections + i * projection_stride, projection_stride, cameras + i, out + i);
+  }
+  for(; i < count; ++i) {
+    out[i] = viewProjection(projections[i * projection_stride], cameras[i].eye, cameras[i].center, cameras[i].up);
+  }
+}
+
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+
+/**
+ * @brief Computes the view-projections of an array of cameras sharing one
+ * projection, such as the faces of a cube map.
+ *
+ * Each output is viewProjection(projection, camera.eye, camera.center,
+ * camera.up), up to rounding.
+ * @param projection The projection of every camera.
+ * @param cameras The cameras.
+ * @param out The output matrices.
+ * @param count The number of cameras.
+ * @tparam T The type of the elements in the matrices.
+ */
+template <typename T>
+inline void viewProjections(const PerspectiveProjection<T>& projection, const Camera<T>* cameras, Mat4<T>* out,
+                            std::size_t count) noexcept {
+  detail::viewProjectionArray(&projection, 0, cameras, out, count);
+}
+
+/**
+ * @brief Computes the view-projections of an array of cameras, each with its own
+ * projection, such as shadow cascades or the eyes of a multi-view display.
+ * @param projections The projections, one per camera.
+ * @param cameras The cameras.
+ * @param out The output matrices.
+ * @param count The number of cameras.
+ * @tparam T The type of the elements in the matrices.
+ */
+template <typename T>
+inline void viewProjections(const PerspectiveProjection<T>* projections, const Camera<T>* cameras, Mat4<T>* out,
+                            std::size_t count) noexcept {
+  detail::viewProjectionArray(projections, 1, cameras, out, count);
+}
+
+using Camerad = Camera<double>;
+using Cameraf = Camera<float>;
+
+} // namespace linalg
+
+#endif // LINALG_CAMERA_HPP
@@ -0,0 +1,438 @@
+/**
+ * @file ColMajor.hpp
+ * @brief Column-major 3x3 and 4x4 matrices for GPU upload.
+ *
+ * Mat3 and Mat4 are stored row-major, while OpenGL and Vulkan expect
+ * column-major matrices. Mat3ColMajor and Mat4ColMajor have the same arithmetic
+ * API, but data() returns the elements in column-major order, so it can be
+ * passed to glUniformMatrix4fv() or copied into a uniform buffer as is.
+ *
+ * The column-major storage of a matrix is the row-major storage of its
+ * transpose, so the products and inverses reuse the row-major kernels on the
+ * transposed operands: (A * B)^T = B^T * A^T and inverse(A)^T = inverse(A^T).
+ */
+#ifndef LINALG_COLMAJOR_HPP
+#define LINALG_COLMAJOR_HPP
+
+#include <iostream>
+
+#include "Mat3.hpp"
+#include "Mat4.hpp"
+#include "Mat4Kernels.hpp"
+#include "Pack.hpp"
+#include "Vec3.hpp"
+#include "Vec4.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief 3x3 matrix stored in column-major order.
+ * @tparam T The type of the elements in the matrix (e.g., float, double).
+ */
+template <typename T> class Mat3ColMajor {
+public:
+  /**
+   * @brief Default constructor initializes the matrix to the identity matrix.
+   */
+  constexpr Mat3ColMajor() noexcept = default;
+
+  /**
+   * @brief Constructor that initializes the matrix element by element, in
+   * row-major order as for Mat3.
+   * @param m00 ... m22 The elements of the matrix, mij being at row i and
+   * column j.
+   */
+  constexpr Mat3ColMajor(T m00, T m01, T m02, T m10, T m11, T m12, T m20, T m21, T m22) noexcept
+      : m_transpose(m00, m10, m20, m01, m11, m21, m02, m12, m22) {}
+
+  /**
+   * @brief Constructor that converts a row-major matrix.
+   * @param mat The matrix to convert.
+   */
+  explicit constexpr Mat3ColMajor(const Mat3<T>& mat) noexcept : m_transpose(mat.transposed()) {}
+
+  /**
+   * @brief Returns the equivalent row-major matrix.
+   */
+  constexpr Mat3<T> toMat3() const noexcept { return m_transpose.transposed(); }
+
+  /**
+   * @brief Returns a pointer to the 9 column-major elements of the matrix.
+   */
+  const T* data() const noexcept { return m_transpose.data(); }
+
+  /**
+   * @brief Accesses the element at (row, col).
+   */
+  constexpr T& operator()(int row, int col) noexcept { return m_transpose(col, row); }
+
+  /**
+   * @brief Accesses the element at (row, col) (const version).
+   */
+  constexpr T operator()(int row, int col) const noexcept { return m_transpose(col, row); }
+
+  bool operator==(const Mat3ColMajor& other) const noexcept { return m_transpose == other.m_transpose; }
+
+  bool operator!=(const Mat3ColMajor& other) const noexcept { return !(*this == other); }
+
+  /**
+   * @brief Returns a transposed version of the matrix.
+   */
+  constexpr Mat3ColMajor transposed() const noexcept { return FromTransposed(m_transpose.transposed()); }
+
+  /**
+   * @brief Returns the determinant of the matrix.
+   */
+  T determinant() const noexcept { return m_transpose.determinant(); }
+
+  /**
+   * @brief Returns the inverse of the matrix.
+   * @return The inverse, or the identity matrix if the matrix is singular, as
+   * with Mat3::inverse().
+   */
+  Mat3ColMajor inverse() const { return FromTransposed(m_transpose.inverse()); }
+
+  /**
+   * @brief Returns the product of this matrix with another matrix.
+   * @param other The matrix to multiply with.
+   * @return The matrix this * other.
+   */
+  Mat3ColMajor operator*(const Mat3ColMajor& other) const noexcept {
+    return FromTransposed(other.m_transpose * m_transpose);
+  }
+
+  /**
+   * @brief Multiplies this matrix by another matrix and assigns the result to
+   * this matrix.
+   * @param other The matrix to multiply with.
+   * @return A reference to this matrix after the multiplication.
+   */
+  Mat3ColMajor& operator*=(const Mat3ColMajor& other) noexcept {
+    *this = *this * other;
+    return *this;
+  }
+
+  /**
+   * @brief Multiplies this matrix by a vector, as a linear combination of the
+   * columns.
+   * @param vec The vector to multiply.
+   * @return The vector this * vec.
+   */
+  Vec3<T> operator*(const Vec3<T>& vec) const noexcept {
+    const auto& c = m_transpose.m;
+    return {c[0][0] * vec.x + c[1][0] * vec.y + c[2][0] * vec.z, c[0][1] * vec.x + c[1][1] * vec.y + c[2][1] * vec.z,
+            c[0][2] * vec.x + c[1][2] * vec.y + c[2][2] * vec.z};
+  }
+
+  /**
+   * @brief Checks if this matrix is approximately equal to another matrix
+   * within a given epsilon.
+   * @param other The matrix to compare with.
+   * @param epsilon The tolerance for comparison.
+   * @return True if the matrices are approximately equal, false otherwise.
+   */
+  bool isApprox(const Mat3ColMajor& other, T epsilon) const { return m_transpose.isApprox(other.m_transpose, epsilon); }
+
+  /**
+   * @brief Returns the identity matrix.
+   */
+  static constexpr Mat3ColMajor Identity() noexcept { return Mat3ColMajor{}; }
+
+  /**
+   * @brief Creates a matrix from three rows.
+   */
+  static constexpr Mat3ColMajor FromRows(const Vec3<T>& row0, const Vec3<T>& row1, const Vec3<T>& row2) noexcept {
+    return FromTransposed(Mat3<T>::FromColumns(row0, row1, row2));
+  }
+
+  /**
+   * @brief Creates a matrix from three columns, stored as they are.
+   */
+  static constexpr Mat3ColMajor FromColumns(const Vec3<T>& col0, const Vec3<T>& col1, const Vec3<T>& col2) noexcept {
+    return FromTransposed(Mat3<T>::FromRows(col0, col1, col2));
+  }
+
+  /**
+   * @brief Creates a matrix whose column-major storage is the row-major storage
+   * of transpose, without transposing it.
+   * @param transpose The transpose of the matrix to create.
+   */
+  static constexpr Mat3ColMajor FromTransposed(const Mat3<T>& transpose) noexcept {
+    return Mat3ColMajor(transpose, 0);
+  }
+
+  /**
+   * @brief Returns the transpose of the matrix as a row-major matrix, whose
+   * storage is that of this matrix.
+   */
+  constexpr const Mat3<T>& asTransposed() const noexcept { return m_transpose; }
+
+private:
+  constexpr Mat3ColMajor(const Mat3<T>& transpose, int /*tag*/) noexcept : m_transpose(transpose) {}
+
+  Mat3<T> m_transpose;
+};
+
+/**
+ * @brief 4x4 matrix stored in column-major order.
+ * @tparam T The type of the elements in the matrix (e.g., float, double).
+ */
+template <typename T> class Mat4ColMajor {
+public:
+  /**
+   * @brief Default constructor initializes the matrix to the identity matrix.
+   */
+  constexpr Mat4ColMajor() noexcept = default;
+
+  /**
+   * @brief Constructor that initializes the matrix element by element, in
+   * row-major order as for Mat4.
+   * @param m00 ... m33 The elements of the matrix, mij being at row i and
+   * column j.
+   */
+  constexpr Mat4ColMajor(T m00, T m01, T m02, T m03, T m10, T m11, T m12, T m13, T m20, T m21, T m22, T m23, T m30,
+                         T m31, T m32, T m33) noexcept
+      : m_transpose(m00, m10, m20, m30, m01, m11, m21, m31, m02, m12, m22, m32, m03, m13, m23, m33) {}
+
+  /**
+   * @brief Constructor that converts a row-major matrix.
+   * @param mat The matrix to convert.
+   */
+  explicit Mat4ColMajor(const Mat4<T>& mat) noexcept : m_transpose(mat.transposed()) {}
+
+  /**
+   * @brief Returns the equivalent row-major matrix.
+   */
+  Mat4<T> toMat4() const noexcept { return m_transpose.transposed(); }
+
+  /**
+   * @brief Returns a pointer to the 16 column-major elements of the matrix.
+   */
+  const T* data() const noexcept { return m_transpose.data(); }
+
+  /**
+   * @brief Accesses the element at (row, col).
+   */
+  constexpr T& operator()(int row, int col) noexcept { return m_transpose(col, row); }
+
+  /**
+   * @brief Accesses the element at (row, col) (const version).
+   */
+  constexpr T operator()(int row, int col) const noexcept { return m_transpose(col, row); }
+
+  bool operator==(const Mat4ColMajor& other) const { return m_transpose == other.m_transpose; }
+
+  bool operator!=(const Mat4ColMajor& other) const { return !(*this == other); }
+
+  /**
+   * @brief Returns the column at the given index.
+   */
+  Vec4<T> column(int index) const noexcept {
+    const auto& c = m_transpose.m[index];
+    return {c[0], c[1], c[2], c[3]};
+  }
+
+  /**
+   * @brief Returns a transposed version of the matrix.
+   */
+  Mat4ColMajor transposed() const noexcept { return FromTransposed(m_transpose.transposed()); }
+
+  /**
+   * @brief Computes the inverse of the matrix, reporting whether it exists.
+   * @param result The matrix receiving the inverse. It may be this matrix and is
+   * left unmodified if the matrix is singular.
+   * @return True if the matrix is invertible, false if its determinant is zero.
+   */
+  bool tryInverse(Mat4ColMajor& result) const noexcept { return m_transpose.tryInverse(result.m_transpose); }
+
+  /**
+   * @brief Returns the inverse of the matrix.
+   * @return The inverse, or the identity matrix if the determinant is zero.
+   */
+  Mat4ColMajor inverse() const noexcept { return FromTransposed(m_transpose.inverse()); }
+
+  /**
+   * @brief Multiplies this matrix by another matrix.
+   * @param other The matrix to multiply with.
+   * @return The matrix this * other.
+   * @note Uses the SIMD kernels of Mat4Kernels.hpp, as Mat4::operator*().
+   */
+  Mat4ColMajor operator*(const Mat4ColMajor& other) const noexcept {
+    return FromTransposed(other.m_transpose * m_transpose);
+  }
+
+  /**
+   * @brief Multiplies this matrix by another matrix and assigns the result to
+   * this matrix.
+   * @param other The matrix to multiply with.
+   * @return A reference to this matrix after the multiplication.
+   */
+  Mat4ColMajor& operator*=(const Mat4ColMajor& other) noexcept {
+    *this = *this * other;
+    return *this;
+  }
+
+  /**
+   * @brief Multiplies this matrix by a vector, as a linear combination of the
+   * columns.
+   * @param vec The vector to multiply.
+   * @return The vector this * vec.
+   */
+  Vec4<T> operator*(const Vec4<T>& vec) const noexcept {
+    using P    = simd::Pack<T, 4>;
+    const T* c = m_transpose.data();
+    const P  r = simd::madd(P::broadcast(vec.x), P::load(c),
+                            simd::madd(P::broadcast(vec.y), P::load(c + 4),
+                                       simd::madd(P::broadcast(vec.z), P::load(c + 8),
+                                                  P::broadcast(vec.w) * P::load(c + 12))));
+    Vec4<T> result;
+    r.store(&result.x);
+    return result;
+  }
+
+  /**
+   * @brief Checks if this matrix is approximately equal to another matrix
+   * within a given epsilon.
+   * @param other The matrix to compare with.
+   * @param epsilon The tolerance for comparison.
+   * @return True if the matrices are approximately equal, false otherwise.
+   */
+  bool isApprox(const Mat4ColMajor& other, T epsilon) const { return m_transpose.isApprox(other.m_transpose, epsilon); }
+
+  /**
+   * @brief Returns the identity matrix.
+   */
+  static constexpr Mat4ColMajor Identity() noexcept { return Mat4ColMajor{}; }
+
+  /**
+   * @brief Returns the view matrix of Mat4::LookAt().
+   */
+  static Mat4ColMajor LookAt(const Vec3<T>& eye, const Vec3<T>& center, const Vec3<T>& up) noexcept {
+    return Mat4ColMajor(Mat4<T>::LookAt(eye, center, up));
+  }
+
+  /**
+   * @brief Returns the view matrix of Mat4::LookAt() with a default up
+   * direction.
+   */
+  static Mat4ColMajor LookAt(const Vec3<T>& eye, const Vec3<T>& center) noexcept {
+    return Mat4ColMajor(Mat4<T>::LookAt(eye, center));
+  }
+
+  /**
+   * @brief Returns the orthographic projection matrix of Mat4::Orthographic().
+   */
+  static Mat4ColMajor Orthographic(T left, T right, T bottom, T top, T near, T far) noexcept {
+    return Mat4ColMajor(Mat4<T>::Orthographic(left, right, bottom, top, near, far));
+  }
+
+  /**
+   * @brief Returns the perspective projection matrix of Mat4::Perspective().
+   */
+  static Mat4ColMajor Perspective(T fov_y, T aspect, T near, T far) noexcept {
+    return Mat4ColMajor(Mat4<T>::Perspective(fov_y, aspect, near, far));
+  }
+
+  /**
+   * @brief Creates a matrix from four rows.
+   */
+  static constexpr Mat4ColMajor FromRows(const Vec4<T>& row0, const Vec4<T>& row1, const Vec4<T>& row2,
+                                         const Vec4<T>& row3) noexcept {
+    return FromTransposed(Mat4<T>::FromColumns(row0, row1, row2, row3));
+  }
+
+  /**
+   * @brief Creates a matrix from four columns, stored as they are.
+   */
+  static constexpr Mat4ColMajor FromColumns(const Vec4<T>& col0, const Vec4<T>& col1, const Vec4<T>& col2,
+                                            const Vec4<T>& col3) noexcept {
+    return FromTransposed(Mat4<T>::FromRows(col0, col1, col2, col3));
+  }
+
+  /**
+   * @brief Creates a matrix whose column-major storage is the row-major storage
+   * of transpose, without transposing it.
+   * @param transpose The transpose of the matrix to create.
+   */
+  static constexpr Mat4ColMajor FromTransposed(const Mat4<T>& transpose) noexcept {
+    return Mat4ColMajor(transpose, 0);
+  }
+
+  /**
+   * @brief Returns the transpose of the matrix as a row-major matrix, whose
+   * storage is that of this matrix.
+   */
+  constexpr const Mat4<T>& asTransposed() const noexcept { return m_transpose; }
+
+private:
+  constexpr Mat4ColMajor(const Mat4<T>& transpose, int /*tag*/) noexcept : m_transpose(transpose) {}
+
+  Mat4<T> m_transpose;
+};
+
+/**
+ * @brief Multiplies a row-major matrix by a column-major matrix.
+ *
+ * The row-major operand is transposed once, into the column-major result.
+ * @return The column-major matrix a * b.
+ */
+template <typename T> inline Mat3ColMajor<T> operator*(const Mat3<T>& a, const Mat3ColMajor<T>& b) noexcept {
+  return Mat3ColMajor<T>::FromTransposed(b.asTransposed() * a.transposed());
+}
+
+/**
+ * @brief Multiplies a column-major matrix by a row-major matrix.
+ * @return The column-major matrix a * b.
+ */
+template <typename T> inline Mat3ColMajor<T> operator*(const Mat3ColMajor<T>& a, const Mat3<T>& b) noexcept {
+  return Mat3ColMajor<T>::FromTransposed(b.transposed() * a.asTransposed());
+}
+
+/**
+ * @brief Multiplies a row-major matrix by a column-major matrix.
+ *
+ * The row-major operand is transposed once, into the column-major result.
+ * @return The column-major matrix a * b.
+ */
+template <typename T> inline Mat4ColMajor<T> operator*(const Mat4<T>& a, const Mat4ColMajor<T>& b) noexcept {
+  return Mat4ColMajor<T>::FromTransposed(b.asTransposed() * a.transposed());
+}
+
+/**
+ * @brief Multiplies a column-major matrix by a row-major matrix.
+ * @return The column-major matrix a * b.
+ */
+template <typename T> inline Mat4ColMajor<T> operator*(const Mat4ColMajor<T>& a, const Mat4<T>& b) noexcept {
+  return Mat4ColMajor<T>::FromTransposed(b.transposed() * a.asTransposed());
+}
+
+// GCOVR_EXCL_START
+/**
+ * @brief Overloaded output operator for Mat3ColMajor, printed row by row as
+ * Mat3.
+ */
+template <typename T> inline std::ostream& operator<<(std::ostream& os, const Mat3ColMajor<T>& mat) {
+  return os << mat.toMat3();
+}
+
+/**
+ * @brief Overloaded output operator for Mat4ColMajor, printed row by row as
+ * Mat4.
+ */
+template <typename T> inline std::ostream& operator<<(std::ostream& os, const Mat4ColMajor<T>& mat) {
+  return os << mat.toMat4();
+}
+// GCOVR_EXCL_STOP
+
+using Mat3ColMajorf = Mat3ColMajor<float>;
+using Mat3ColMajord = Mat3ColMajor<double>;
+using Mat4ColMajorf = Mat4ColMajor<float>;
+using Mat4ColMajord = Mat4ColMajor<double>;
+
+} // namespace linalg
+
+#endif // LINALG_COLMAJOR_HPP
@@ -0,0 +1,142 @@
+/**
+ * @file Dispatch.hpp
+ * @brief Bulk kernels selected at runtime for the instruction sets of the
+ * host CPU.
+ *
+ * These functions are provided by the compiled linalg_dispatch library
+ * (CMake option LINALG_ENABLE_DISPATCH, target linalg::dispatch), not by the
+ * header-only library. Each kernel is built once per supported instruction set
+ * and the best one for the host is picked on first use from cpuid (x86) or
+ * the auxiliary vector (AArch64 Linux), so a single binary built for the
+ * baseline instruction set runs the AVX2 or AVX-512 kernels where available.
+ *
+ * The kernels are defined for float and double.
+ */
+#ifndef LINALG_DISPATCH_HPP
+#define LINALG_DISPATCH_HPP
+
+#include <cstddef>
+
+#include "Mat4.hpp"
+#include "Vec3.hpp"
+#include "Vec4.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+namespace dispatch {
+
+/**
+ * @brief Instruction sets the kernels are built for, from the least to the
+ * most capable on each architecture.
+ */
+enum class Isa {
+  Scalar, ///< Portable scalar code.
+  SSE2,   ///< x86 SSE2, 128-bit registers.
+  AVX2,   ///< x86 AVX2 with FMA, 256-bit registers.
+  AVX512, ///< x86 AVX-512F, 512-bit registers.
+  NEON,   ///< AArch64 Advanced SIMD, 128-bit registers.
+};
+
+/**
+ * @brief Returns the lower-case name of an instruction set, e.g. "avx2".
+ */
+const char* isaName(Isa isa) noexcept;
+
+/**
+ * @brief Checks if the kernels for an instruction set were built into the
+ * library and can run on the host CPU and operating system.
+ */
+bool isSupported(Isa isa) noexcept;
+
+/**
+ * @brief Returns the most capable supported instruction set, the one selected
+ * by default.
+ */
+Isa bestIsa() noexcept;
+
+/**
+ * @brief Returns the instruction set of the kernels currently in use.
+ */
+Isa activeIsa() noexcept;
+
+/**
+ * @brief Selects the kernels of an instruction set for all subsequent calls,
+ * e.g. to compare instruction sets or to work around a platform issue.
+ * @param isa The instruction set to use.
+ * @throws std::invalid_argument if the instruction set is not supported.
+ */
+void setActiveIsa(Isa isa);
+
+/**
+ * @brief Transforms an array of points by a Mat4, as transformPoints() in
+ * Batch.hpp (without a perspective divide).
+ * @param mat The transformation matrix.
+ * @param in The input points.
+ * @param out The output points. It may be the same array as in but must not
+ * otherwise overlap it.
+ * @param count The number of points.
+ */
+template <typename T>
+void transformPoints(const Mat4<T>& mat, const Vec3<T>* in, Vec3<T>* out, std::size_t count) noexcept;
+
+/**
+ * @brief Transforms an array of directions by a Mat4, ignoring its
+ * translation, as transformDirections() in Batch.hpp.
+ * @param mat The transformation matrix.
+ * @param in The input directions.
+ * @param out The output directions. It may be the same array as in but must
+ * not otherwise overlap it.
+ * @param count The number of directions.
+ */
+template <typename T>
+void transformDirections(const Mat4<T>& mat, const Vec3<T>* in, Vec3<T>* out, std::size_t count) noexcept;
+
+/**
+ * @brief Transforms an array of Vec4 vectors by a Mat4.
+ * @param mat The transformation matrix.
+ * @param in The input vectors.
+ * @param out The output vectors. It may be the same array as in but must not
+ * otherwise overlap it.
+ * @param count The number of vectors.
+ */
+template <typename T>
+void transformVectors(const Mat4<T>& mat, const Vec4<T>* in, Vec4<T>* out, std::size_t count) noexcept;
+
+/**
+ * @brief Normalizes an array of vectors. Zero-length vectors become zero, as
+ * with Vec3::normalized().
+ * @param in The input vectors.
+ * @param out The normalized vectors. It may be the same array as in but must
+ * not otherwise overlap it.
+ * @param count The number of vectors.
+ */
+template <typename T> void normalized(const Vec3<T>* in, Vec3<T>* out, std::size_t count) noexcept;
+
+/**
+ * @brief Computes the dot product of each pair of vectors.
+ * @param a The first vectors.
+ * @param b The second vectors.
+ * @param out The count dot products.
+ * @param count The number of vectors.
+ */
+template <typename T> void dot(const Vec3<T>* a, const Vec3<T>* b, T* out, std::size_t count) noexcept;
+
+/**
+ * @brief Computes the component-wise minimum and maximum of an array of
+ * vectors, i.e. the corners of their bounding box. NaN components are
+ * ignored.
+ * @param in The input vectors.
+ * @param count The number of vectors.
+ * @param min Receives the component-wise minimum.
+ * @param max Receives the component-wise maximum.
+ * @throws std::invalid_argument if count is zero.
+ */
+template <typename T> void minMax(const Vec3<T>* in, std::size_t count, Vec3<T>& min, Vec3<T>& max);
+
+} // namespace dispatch
+} // namespace linalg
+
+#endif // LINALG_DISPATCH_HPP
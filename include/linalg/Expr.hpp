@@ -0,0 +1,497 @@
+/**
+ * @file Expr.hpp
+ * @brief Opt-in lazy expressions for vector and matrix arithmetic.
+ *
+ * Wrapping an operand with lazy() turns the arithmetic built on it into an
+ * expression tree that is only evaluated when it is assigned to a vector or
+ * matrix (or on eval()). Element-wise vector chains are then computed in one
+ * pass, each component straight from the operands, and products of matrices
+ * applied to a vector are evaluated right to left, as matrix-vector products,
+ * without forming the matrix products:
+ *
+ * @code
+ * Vec3<float> r = eta * lazy(incident) + (eta * cos_i - cos_t) * lazy(normal);
+ * Vec4<float> p = lazy(projection) * view * model * point; // 3 Mat4 * Vec4
+ * @endcode
+ *
+ * Vector operands are copied into the expression, matrix operands are held by
+ * reference: like the expressions of other template libraries, an expression
+ * built on matrix temporaries must be evaluated before the end of the
+ * statement rather than stored with auto. This header is not included by
+ * linalg.hpp.
+ */
+#ifndef LINALG_EXPR_HPP
+#define LINALG_EXPR_HPP
+
+#include <cmath>
+#include <type_traits>
+
+#include "linalg.hpp"
+
+/**
+ * @brief Forces the inlining of the small functions expressions are made of,
+ * which compilers otherwise stop inlining as the expressions grow, leaving
+ * the tree to be materialized in memory.
+ */
+#if defined(_MSC_VER)
+#define LINALG_EXPR_INLINE __forceinline
+#else
+#define LINALG_EXPR_INLINE inline __attribute__((always_inline))
+#endif
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+namespace expr {
+
+/**
+ * @brief Compile-time access to the components of the vector types.
+ */
+template <typename V> struct VecTraits;
+
+template <typename T> struct VecTraits<Vec2<T>> {
+  using Scalar              = T;
+  static constexpr int SIZE = 2;
+
+  template <int I> static LINALG_EXPR_INLINE T get(const Vec2<T>& v) noexcept { return I == 0 ? v.x : v.y; }
+  template <typename E> static LINALG_EXPR_INLINE Vec2<T> build(const E& e) noexcept {
+    return {e.template get<0>(), e.template get<1>()};
+  }
+};
+
+template <typename T> struct VecTraits<Vec3<T>> {
+  using Scalar              = T;
+  static constexpr int SIZE = 3;
+
+  template <int I> static LINALG_EXPR_INLINE T get(const Vec3<T>& v) noexcept {
+    return I == 0 ? v.x : (I == 1 ? v.y : v.z);
+  }
+  template <typename E> static LINALG_EXPR_INLINE Vec3<T> build(const E& e) noexcept {
+    return {e.template get<0>(), e.template get<1>(), e.template get<2>()};
+  }
+};
+
+template <typename T> struct VecTraits<Vec4<T>> {
+  using Scalar              = T;
+  static constexpr int SIZE = 4;
+
+  template <int I> static LINALG_EXPR_INLINE T get(const Vec4<T>& v) noexcept {
+    return I == 0 ? v.x : (I == 1 ? v.y : (I == 2 ? v.z : v.w));
+  }
+  template <typename E> static LINALG_EXPR_INLINE Vec4<T> build(const E& e) noexcept {
+    return {e.template get<0>(), e.template get<1>(), e.template get<2>(), e.template get<3>()};
+  }
+};
+
+struct VecExprTag {};
+struct MatExprTag {};
+
+template <typename E> using IsVecExpr = std::is_base_of<VecExprTag, E>;
+template <typename E> using IsMatExpr = std::is_base_of<MatExprTag, E>;
+
+/**
+ * @brief Base class of the vector expressions, evaluating the derived
+ * expression component by component.
+ * @tparam Derived The expression type, providing template <int I> get().
+ * @tparam V The vector type the expression evaluates to.
+ */
+template <typename Derived, typename V> struct VecExpr : VecExprTag {
+  using Vector = V;
+  using Scalar = typename VecTraits<V>::Scalar;
+
+  /**
+   * @brief Evaluates the expression.
+   * @return The vector the expression computes.
+   */
+  LINALG_EXPR_INLINE V eval() const noexcept { return VecTraits<V>::build(static_cast<const Derived&>(*this)); }
+
+  /**
+   * @brief Evaluates the expression, so that it can be assigned to a vector.
+   */
+  LINALG_EXPR_INLINE operator V() const noexcept { return eval(); } // NOLINT(google-explicit-constructor)
+
+  /**
+   * @brief Returns the normalized result of the expression, as
+   * Vector::normalized().
+   */
+  V normalized() const noexcept { return eval().normalized(); }
+};
+
+/**
+ * @brief A vector operand of an expression, held by value.
+ */
+template <typename V> class VecLeaf : public VecExpr<VecLeaf<V>, V> {
+public:
+  LINALG_EXPR_INLINE explicit VecLeaf(const V& value) noexcept : m_value(value) {}
+
+  template <int I> LINALG_EXPR_INLINE typename VecTraits<V>::Scalar get() const noexcept {
+    return VecTraits<V>::template get<I>(m_value);
+  }
+
+private:
+  V m_value;
+};
+
+/**
+ * @brief The element-wise combination of two vector expressions by Op.
+ */
+template <typename Op, typename L, typename R>
+class VecBinary : public VecExpr<VecBinary<Op, L, R>, typename L::Vector> {
+public:
+  LINALG_EXPR_INLINE VecBinary(const L& lhs, const R& rhs) noexcept : m_lhs(lhs), m_rhs(rhs) {}
+
+  template <int I> LINALG_EXPR_INLINE typename L::Scalar get() const noexcept {
+    return Op::apply(m_lhs.template get<I>(), m_rhs.template get<I>());
+  }
+
+private:
+  L m_lhs;
+  R m_rhs;
+};
+
+/**
+ * @brief The combination of each component of a vector expression with a
+ * scalar by Op.
+ */
+template <typename Op, typename E> class VecScalar : public VecExpr<VecScalar<Op, E>, typename E::Vector> {
+public:
+  LINALG_EXPR_INLINE VecScalar(const E& expr, typename E::Scalar scalar) noexcept : m_expr(expr), m_scalar(scalar) {}
+
+  template <int I> LINALG_EXPR_INLINE typename E::Scalar get() const noexcept {
+    return Op::apply(m_expr.template get<I>(), m_scalar);
+  }
+
+private:
+  E                  m_expr;
+  typename E::Scalar m_scalar;
+};
+
+/**
+ * @brief The negation of a vector expression.
+ */
+template <typename E> class VecNegate : public VecExpr<VecNegate<E>, typename E::Vector> {
+public:
+  LINALG_EXPR_INLINE explicit VecNegate(const E& expr) noexcept : m_expr(expr) {}
+
+  template <int I> LINALG_EXPR_INLINE typename E::Scalar get() const noexcept { return -m_expr.template get<I>(); }
+
+private:
+  E m_expr;
+};
+
+struct Add {
+  template <typename T> static LINALG_EXPR_INLINE T apply(T a, T b) noexcept { return a + b; }
+};
+
+struct Subtract {
+  template <typename T> static LINALG_EXPR_INLINE T apply(T a, T b) noexcept { return a - b; }
+};
+
+struct Multiply {
+  template <typename T> static LINALG_EXPR_INLINE T apply(T a, T b) noexcept { return a * b; }
+};
+
+struct Divide {
+  template <typename T> static LINALG_EXPR_INLINE T apply(T a, T b) noexcept { return a / b; }
+};
+
+struct Min {
+  template <typename T> static LINALG_EXPR_INLINE T apply(T a, T b) noexcept { return std::fmin(a, b); }
+};
+
+struct Max {
+  template <typename T> static LINALG_EXPR_INLINE T apply(T a, T b) noexcept { return std::fmax(a, b); }
+};
+
+/**
+ * @brief Maps the operands accepted by the vector operators (vectors and
+ * vector expressions) to their expression type.
+ */
+template <typename X, typename Enable = void> struct VecOperand {};
+
+template <typename T> struct VecOperand<Vec2<T>> {
+  using Type = VecLeaf<Vec2<T>>;
+  static LINALG_EXPR_INLINE Type make(const Vec2<T>& v) noexcept { return Type(v); }
+};
+
+template <typename T> struct VecOperand<Vec3<T>> {
+  using Type = VecLeaf<Vec3<T>>;
+  static LINALG_EXPR_INLINE Type make(const Vec3<T>& v) noexcept { return Type(v); }
+};
+
+template <typename T> struct VecOperand<Vec4<T>> {
+  using Type = VecLeaf<Vec4<T>>;
+  static LINALG_EXPR_INLINE Type make(const Vec4<T>& v) noexcept { return Type(v); }
+};
+
+template <typename E> struct VecOperand<E, typename std::enable_if<IsVecExpr<E>::value>::type> {
+  using Type = E;
+  static LINALG_EXPR_INLINE const E& make(const E& e) noexcept { return e; }
+};
+
+/**
+ * @brief Result of a binary vector operator: defined when at least one
+ * operand is an expression and both evaluate to the same vector type.
+ */
+template <typename L, typename R, typename Result>
+using IfVecOperands =
+    typename std::enable_if<(IsVecExpr<L>::value || IsVecExpr<R>::value) &&
+                                std::is_same<typename VecOperand<L>::Type::Vector,
+                                             typename VecOperand<R>::Type::Vector>::value,
+                            Result>::type;
+
+template <typename Op, typename L, typename R>
+using VecBinaryOf = VecBinary<Op, typename VecOperand<L>::Type, typename VecOperand<R>::Type>;
+
+/**
+ * @brief Wraps a vector to build a lazy expression on it.
+ * @param v The vector, copied into the expression.
+ */
+template <typename T> LINALG_EXPR_INLINE VecLeaf<Vec2<T>> lazy(const Vec2<T>& v) noexcept {
+  return VecLeaf<Vec2<T>>(v);
+}
+
+/**
+ * @brief Wraps a vector to build a lazy expression on it.
+ * @param v The vector, copied into the expression.
+ */
+template <typename T> LINALG_EXPR_INLINE VecLeaf<Vec3<T>> lazy(const Vec3<T>& v) noexcept {
+  return VecLeaf<Vec3<T>>(v);
+}
+
+/**
+ * @brief Wraps a vector to build a lazy expression on it.
+ * @param v The vector, copied into the expression.
+ */
+template <typename T> LINALG_EXPR_INLINE VecLeaf<Vec4<T>> lazy(const Vec4<T>& v) noexcept {
+  return VecLeaf<Vec4<T>>(v);
+}
+
+/**
+ * @brief Returns the lazy element-wise sum of two vector expressions.
+ */
+template <typename L, typename R>
+LINALG_EXPR_INLINE IfVecOperands<L, R, VecBinaryOf<Add, L, R>> operator+(const L& lhs, const R& rhs) noexcept {
+  return {VecOperand<L>::make(lhs), VecOperand<R>::make(rhs)};
+}
+
+/**
+ * @brief Returns the lazy element-wise difference of two vector expressions.
+ */
+template <typename L, typename R>
+LINALG_EXPR_INLINE IfVecOperands<L, R, VecBinaryOf<Subtract, L, R>> operator-(const L& lhs, const R& rhs) noexcept {
+  return {VecOperand<L>::make(lhs), VecOperand<R>::make(rhs)};
+}
+
+/**
+ * @brief Returns the lazy element-wise product of two vector expressions.
+ */
+template <typename L, typename R>
+LINALG_EXPR_INLINE IfVecOperands<L, R, VecBinaryOf<Multiply, L, R>> cwiseProduct(const L& lhs, const R& rhs) noexcept {
+  return {VecOperand<L>::make(lhs), VecOperand<R>::make(rhs)};
+}
+
+/**
+ * @brief Returns the lazy element-wise minimum of two vector expressions.
+ */
+template <typename L, typename R>
+LINALG_EXPR_INLINE IfVecOperands<L, R, VecBinaryOf<Min, L, R>> cwiseMin(const L& lhs, const R& rhs) noexcept {
+  return {VecOperand<L>::make(lhs), VecOperand<R>::make(rhs)};
+}
+
+/**
+ * @brief Returns the lazy element-wise maximum of two vector expressions.
+ */
+template <typename L, typename R>
+LINALG_EXPR_INLINE IfVecOperands<L, R, VecBinaryOf<Max, L, R>> cwiseMax(const L& lhs, const R& rhs) noexcept {
+  return {VecOperand<L>::make(lhs), VecOperand<R>::make(rhs)};
+}
+
+/**
+ * @brief Returns the lazy negation of a vector expression.
+ */
+template <typename E, typename = typename std::enable_if<IsVecExpr<E>::value>::type>
+LINALG_EXPR_INLINE VecNegate<E> operator-(const E& expr) noexcept {
+  return VecNegate<E>(expr);
+}
+
+/**
+ * @brief Returns the lazy product of a vector expression and a scalar.
+ */
+template <typename E, typename = typename std::enable_if<IsVecExpr<E>::value>::type>
+LINALG_EXPR_INLINE VecScalar<Multiply, E> operator*(const E& expr, typename E::Scalar scalar) noexcept {
+  return {expr, scalar};
+}
+
+/**
+ * @brief Returns the lazy product of a scalar and a vector expression.
+ */
+template <typename E, typename = typename std::enable_if<IsVecExpr<E>::value>::type>
+LINALG_EXPR_INLINE VecScalar<Multiply, E> operator*(typename E::Scalar scalar, const E& expr) noexcept {
+  return {expr, scalar};
+}
+
+/**
+ * @brief Returns the lazy division of a vector expression by a scalar.
+ */
+template <typename E, typename = typename std::enable_if<IsVecExpr<E>::value>::type>
+LINALG_EXPR_INLINE VecScalar<Divide, E> operator/(const E& expr, typename E::Scalar scalar) noexcept {
+  return {expr, scalar};
+}
+
+namespace detail {
+
+template <int I> struct DotSum {
+  template <typename A, typename B> static LINALG_EXPR_INLINE typename A::Scalar sum(const A& a, const B& b) noexcept {
+    return DotSum<I - 1>::sum(a, b) + a.template get<I>() * b.template get<I>();
+  }
+};
+
+template <> struct DotSum<0> {
+  template <typename A, typename B> static LINALG_EXPR_INLINE typename A::Scalar sum(const A& a, const B& b) noexcept {
+    return a.template get<0>() * b.template get<0>();
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Computes the dot product of two vector expressions in one pass,
+ * without evaluating them.
+ */
+template <typename L, typename R>
+LINALG_EXPR_INLINE IfVecOperands<L, R, typename VecOperand<L>::Type::Scalar> dot(const L& lhs, const R& rhs) noexcept {
+  using Vector = typename VecOperand<L>::Type::Vector;
+  return detail::DotSum<VecTraits<Vector>::SIZE - 1>::sum(VecOperand<L>::make(lhs), VecOperand<R>::make(rhs));
+}
+
+/**
+ * @brief Base class of the matrix expressions.
+ * @tparam M The matrix type the expression evaluates to.
+ */
+template <typename M> struct MatExpr : MatExprTag {
+  using Matrix = M;
+};
+
+/**
+ * @brief A matrix operand of an expression, held by reference.
+ */
+template <typename M> class MatLeaf : public MatExpr<M> {
+public:
+  LINALG_EXPR_INLINE explicit MatLeaf(const M& mat) noexcept : m_mat(mat) {}
+
+  LINALG_EXPR_INLINE const M& eval() const noexcept { return m_mat; }
+
+  template <typename V> LINALG_EXPR_INLINE V apply(const V& vec) const noexcept { return m_mat * vec; }
+
+private:
+  const M& m_mat;
+};
+
+/**
+ * @brief The lazy product of two matrix expressions. It is either evaluated
+ * left to right into a matrix or applied to a vector right to left.
+ */
+template <typename L, typename R> class MatProduct : public MatExpr<typename L::Matrix> {
+public:
+  using Matrix = typename L::Matrix;
+
+  LINALG_EXPR_INLINE MatProduct(const L& lhs, const R& rhs) noexcept : m_lhs(lhs), m_rhs(rhs) {}
+
+  /**
+   * @brief Evaluates the product.
+   * @return The matrix the expression computes.
+   */
+  Matrix eval() const { return m_lhs.eval() * m_rhs.eval(); }
+
+  /**
+   * @brief Evaluates the product, so that it can be assigned to a matrix.
+   */
+  operator Matrix() const { return eval(); } // NOLINT(google-explicit-constructor)
+
+  /**
+   * @brief Applies the product to a vector as a chain of matrix-vector
+   * products.
+   */
+  template <typename V> LINALG_EXPR_INLINE V apply(const V& vec) const noexcept {
+    return m_lhs.apply(m_rhs.apply(vec));
+  }
+
+private:
+  L m_lhs;
+  R m_rhs;
+};
+
+/**
+ * @brief Maps the operands accepted by the matrix operators (matrices and
+ * matrix expressions) to their expression type.
+ */
+template <typename X, typename Enable = void> struct MatOperand {};
+
+template <typename T> struct MatOperand<Mat3<T>> {
+  using Type = MatLeaf<Mat3<T>>;
+  static LINALG_EXPR_INLINE Type make(const Mat3<T>& m) noexcept { return Type(m); }
+};
+
+template <typename T> struct MatOperand<Mat4<T>> {
+  using Type = MatLeaf<Mat4<T>>;
+  static LINALG_EXPR_INLINE Type make(const Mat4<T>& m) noexcept { return Type(m); }
+};
+
+template <typename E> struct MatOperand<E, typename std::enable_if<IsMatExpr<E>::value>::type> {
+  using Type = E;
+  static LINALG_EXPR_INLINE const E& make(const E& e) noexcept { return e; }
+};
+
+/**
+ * @brief Wraps a matrix to build a lazy expression on it.
+ * @param m The matrix, referenced by the expression.
+ */
+template <typename T> LINALG_EXPR_INLINE MatLeaf<Mat3<T>> lazy(const Mat3<T>& m) noexcept {
+  return MatLeaf<Mat3<T>>(m);
+}
+
+/**
+ * @brief Wraps a matrix to build a lazy expression on it.
+ * @param m The matrix, referenced by the expression.
+ */
+template <typename T> LINALG_EXPR_INLINE MatLeaf<Mat4<T>> lazy(const Mat4<T>& m) noexcept {
+  return MatLeaf<Mat4<T>>(m);
+}
+
+template <typename T> void lazy(const Mat3<T>&& m) = delete;
+template <typename T> void lazy(const Mat4<T>&& m) = delete;
+
+/**
+ * @brief Returns the lazy product of two matrix expressions.
+ */
+template <typename L, typename R>
+typename std::enable_if<(IsMatExpr<L>::value || IsMatExpr<R>::value) &&
+                            std::is_same<typename MatOperand<L>::Type::Matrix,
+                                         typename MatOperand<R>::Type::Matrix>::value,
+                        MatProduct<typename MatOperand<L>::Type, typename MatOperand<R>::Type>>::type
+LINALG_EXPR_INLINE operator*(const L& lhs, const R& rhs) noexcept {
+  return {MatOperand<L>::make(lhs), MatOperand<R>::make(rhs)};
+}
+
+/**
+ * @brief Applies a matrix expression to a vector expression. The vector is
+ * evaluated first, then multiplied by each matrix of the product from right to
+ * left.
+ * @return The transformed vector.
+ */
+template <typename L, typename R>
+typename std::enable_if<IsMatExpr<L>::value, typename VecOperand<R>::Type::Vector>::type
+LINALG_EXPR_INLINE operator*(const L& mat, const R& vec) noexcept {
+  return mat.apply(VecOperand<R>::make(vec).eval());
+}
+
+} // namespace expr
+
+using expr::lazy;
+
+} // namespace linalg
+
+#endif // LINALG_EXPR_HPP
@@ -0,0 +1,616 @@
+/**
+ * @file Generic.hpp
+ * @brief Dimension-generic Vec<T, N> and Mat<T, R, C> types.
+ *
+ * Vec2, Vec3, Vec4, Mat3 and Mat4 are written by hand for their sizes. Vec and
+ * Mat cover the other shapes (2x2 and 2x3 2D transforms, 3x4 skinning matrices,
+ * 4x3 transposes, ...) with the same operations. Their loops are unrolled at
+ * compile time by recursive templates, and operations on 4-element rows use
+ * simd::Pack<T, 4>. They convert explicitly to and from the fixed-size types of
+ * the same shape.
+ */
+#ifndef LINALG_GENERIC_HPP
+#define LINALG_GENERIC_HPP
+
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+
+#include "Affine3.hpp"
+#include "Mat3.hpp"
+#include "Mat4.hpp"
+#include "Pack.hpp"
+#include "Vec2.hpp"
+#include "Vec3.hpp"
+#include "Vec4.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+namespace detail {
+
+/**
+ * @brief Calls f(I), f(I + 1), ..., f(N - 1) through recursive instantiation, so
+ * that the loop is unrolled and every index is a constant after inlining.
+ */
+template <int I, int N> struct Unroll {
+  template <typename F> static void apply(const F& f) noexcept {
+    f(I);
+    Unroll<I + 1, N>::apply(f);
+  }
+};
+
+template <int N> struct Unroll<N, N> {
+  template <typename F> static void apply(const F& /*f*/) noexcept {}
+};
+
+template <int N, typename F> inline void unroll(const F& f) noexcept { Unroll<0, N>::apply(f); }
+
+/**
+ * @brief Checks that every type of a parameter pack converts to T.
+ */
+template <typename T, typename... Args> struct AllConvertible : std::true_type {};
+
+template <typename T, typename A, typename... Args>
+struct AllConvertible<T, A, Args...>
+    : std::integral_constant<bool, std::is_convertible<A, T>::value && AllConvertible<T, Args...>::value> {};
+
+/**
+ * @brief Alignment of Vec<T, N>: that of a SIMD register for 4 elements, so that
+ * the specialized operations load them in one instruction.
+ */
+template <typename T, int N> struct GenericAlignment {
+  static constexpr std::size_t VALUE = N == 4 ? 4 * sizeof(T) : alignof(T);
+};
+
+} // namespace detail
+
+/**
+ * @brief Vector of N elements of type T.
+ * @tparam T The type of the elements (e.g., float, double).
+ * @tparam N The number of elements.
+ */
+template <typename T, int N> struct alignas(detail::GenericAlignment<T, N>::VALUE) Vec {
+  static_assert(N > 0, "Vec requires at least one element.");
+
+  static constexpr int SIZE = N;
+
+  T v[N];
+
+  /**
+   * @brief Default constructor initializes every element to zero.
+   */
+  Vec() noexcept {
+    detail::unroll<N>([this](int i) { v[i] = T(0); });
+  }
+
+  /**
+   * @brief Constructor that initializes every element to the same value.
+   * @param value The value of the elements.
+   */
+  explicit Vec(T value) noexcept {
+    detail::unroll<N>([this, value](int i) { v[i] = value; });
+  }
+
+  /**
+   * @brief Constructor that initializes the elements one by one.
+   * @param first, rest The N elements.
+   */
+  template <typename... Args, typename std::enable_if<sizeof...(Args) + 1 == N && N != 1 &&
+                                                          detail::AllConvertible<T, Args...>::value,
+                                                      int>::type = 0>
+  constexpr Vec(T first, Args... rest) noexcept : v{first, static_cast<T>(rest)...} {}
+
+  /**
+   * @brief Constructor that converts a Vec2.
+   */
+  template <int M = N, typename std::enable_if<M == 2, int>::type = 0>
+  explicit constexpr Vec(const Vec2<T>& vec) noexcept : v{vec.x, vec.y} {}
+
+  /**
+   * @brief Constructor that converts a Vec3.
+   */
+  template <int M = N, typename std::enable_if<M == 3, int>::type = 0>
+  explicit constexpr Vec(const Vec3<T>& vec) noexcept : v{vec.x, vec.y, vec.z} {}
+
+  /**
+   * @brief Constructor that converts a Vec4.
+   */
+  template <int M = N, typename std::enable_if<M == 4, int>::type = 0>
+  explicit constexpr Vec(const Vec4<T>& vec) noexcept : v{vec.x, vec.y, vec.z, vec.w} {}
+
+  /**
+   * @brief Converts to a Vec2.
+   */
+  template <int M = N, typename std::enable_if<M == 2, int>::type = 0> explicit operator Vec2<T>() const noexcept {
+    return {v[0], v[1]};
+  }
+
+  /**
+   * @brief Converts to a Vec3.
+   */
+  template <int M = N, typename std::enable_if<M == 3, int>::type = 0> explicit operator Vec3<T>() const noexcept {
+    return {v[0], v[1], v[2]};
+  }
+
+  /**
+   * @brief Converts to a Vec4.
+   */
+  template <int M = N, typename std::enable_if<M == 4, int>::type = 0> explicit operator Vec4<T>() const noexcept {
+    return {v[0], v[1], v[2], v[3]};
+  }
+
+  /**
+   * @brief Returns a pointer to the N elements.
+   */
+  const T* data() const noexcept { return v; }
+
+  /**
+   * @brief Accesses the element at the given index.
+   */
+  T& operator[](int index) noexcept { return v[index]; }
+
+  /**
+   * @brief Accesses the element at the given index (const version).
+   */
+  constexpr T operator[](int index) const noexcept { return v[index]; }
+
+  bool operator==(const Vec& other) const noexcept {
+    bool equal = true;
+    detail::unroll<N>([&](int i) { equal = equal && v[i] == other.v[i]; });
+    return equal;
+  }
+
+  bool operator!=(const Vec& other) const noexcept { return !(*this == other); }
+
+  Vec operator-() const noexcept {
+    return map([](T a) { return -a; });
+  }
+
+  Vec operator+(const Vec& other) const noexcept {
+    return zip(other, [](T a, T b) { return a + b; });
+  }
+
+  Vec operator-(const Vec& other) const noexcept {
+    return zip(other, [](T a, T b) { return a - b; });
+  }
+
+  Vec operator*(T scalar) const noexcept {
+    return map([scalar](T a) { return a * scalar; });
+  }
+
+  Vec operator/(T scalar) const noexcept {
+    return map([scalar](T a) { return a / scalar; });
+  }
+
+  Vec& operator+=(const Vec& other) noexcept { return *this = *this + other; }
+
+  Vec& operator-=(const Vec& other) noexcept { return *this = *this - other; }
+
+  Vec& operator*=(T scalar) noexcept { return *this = *this * scalar; }
+
+  Vec& operator/=(T scalar) noexcept { return *this = *this / scalar; }
+
+  /**
+   * @brief Returns the squared length of the vector.
+   */
+  T squaredLength() const noexcept { return dot(*this, *this); }
+
+  /**
+   * @brief Returns the length of the vector.
+   */
+  T length() const noexcept { return std::sqrt(squaredLength()); }
+
+  /**
+   * @brief Returns the normalized vector, or zero if its length is zero, as
+   * with Vec3::normalized().
+   */
+  Vec normalized() const noexcept {
+    const T len = length();
+    return len > 0 ? *this * (T(1) / len) : Vec();
+  }
+
+  /**
+   * @brief Checks if this vector is approximately equal to another vector
+   * within a given epsilon.
+   */
+  bool isApprox(const Vec& other, T epsilon) const noexcept {
+    bool approx = true;
+    detail::unroll<N>([&](int i) { approx = approx && std::abs(v[i] - other.v[i]) < epsilon; });
+    return approx;
+  }
+
+  /**
+   * @brief Returns the vector with every element set to zero.
+   */
+  static Vec Zero() noexcept { return Vec(); }
+
+  /**
+   * @brief Returns the vector whose elements are f applied to those of this
+   * vector.
+   */
+  template <typename F> Vec map(const F& f) const noexcept {
+    Vec r;
+    detail::unroll<N>([&](int i) { r.v[i] = f(v[i]); });
+    return r;
+  }
+
+  /**
+   * @brief Returns the vector whose elements are f applied to those of this
+   * vector and other.
+   */
+  template <typename F> Vec zip(const Vec& other, const F& f) const noexcept {
+    Vec r;
+    detail::unroll<N>([&](int i) { r.v[i] = f(v[i], other.v[i]); });
+    return r;
+  }
+};
+
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+/**
+ * @brief Element-wise operations of Vec, specialized for 4 elements with
+ * simd::Pack<T, 4>.
+ */
+template <typename T, int N> struct VecOps {
+  static T dot(const Vec<T, N>& a, const Vec<T, N>& b) noexcept {
+    T sum = 0;
+    unroll<N>([&](int i) { sum += a.v[i] * b.v[i]; });
+    return sum;
+  }
+
+  static Vec<T, N> product(const Vec<T, N>& a, const Vec<T, N>& b) noexcept {
+    return a.zip(b, [](T x, T y) { return x * y; });
+  }
+
+  // std::fmin and std::fmax, written as comparisons so that they are inlined.
+  static Vec<T, N> min(const Vec<T, N>& a, const Vec<T, N>& b) noexcept {
+    return a.zip(b, [](T x, T y) { return y < x || x != x ? y : x; });
+  }
+
+  static Vec<T, N> max(const Vec<T, N>& a, const Vec<T, N>& b) noexcept {
+    return a.zip(b, [](T x, T y) { return y > x || x != x ? y : x; });
+  }
+};
+
+template <typename T> struct VecOps<T, 4> {
+  using P = simd::Pack<T, 4>;
+
+  static Vec<T, 4> store(const P& p) noexcept {
+    Vec<T, 4> r;
+    p.store(r.v);
+    return r;
+  }
+
+  static T dot(const Vec<T, 4>& a, const Vec<T, 4>& b) noexcept {
+    return simd::hsum(P::load(a.v) * P::load(b.v));
+  }
+
+  static Vec<T, 4> product(const Vec<T, 4>& a, const Vec<T, 4>& b) noexcept {
+    return store(P::load(a.v) * P::load(b.v));
+  }
+
+  static Vec<T, 4> min(const Vec<T, 4>& a, const Vec<T, 4>& b) noexcept {
+    return store(simd::fmin(P::load(a.v), P::load(b.v)));
+  }
+
+  static Vec<T, 4> max(const Vec<T, 4>& a, const Vec<T, 4>& b) noexcept {
+    return store(simd::fmax(P::load(a.v), P::load(b.v)));
+  }
+};
+
+/**
+ * @brief Adds a * b to out for one row, with simd::madd for 4 columns.
+ */
+template <typename T, int K> struct RowMadd {
+  static void apply(Vec<T, K>& out, const Vec<T, K>& b, T a) noexcept {
+    unroll<K>([&](int j) { out.v[j] += a * b.v[j]; });
+  }
+};
+
+template <typename T> struct RowMadd<T, 4> {
+  static void apply(Vec<T, 4>& out, const Vec<T, 4>& b, T a) noexcept {
+    using P = simd::Pack<T, 4>;
+    simd::madd(P::broadcast(a), P::load(b.v), P::load(out.v)).store(out.v);
+  }
+};
+
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+
+/**
+ * @brief Computes the dot product of two vectors.
+ */
+template <typename T, int N> inline T dot(const Vec<T, N>& a, const Vec<T, N>& b) noexcept {
+  return detail::VecOps<T, N>::dot(a, b);
+}
+
+/**
+ * @brief Multiplies a scalar by a vector.
+ */
+template <typename T, int N> inline Vec<T, N> operator*(T scalar, const Vec<T, N>& vec) noexcept {
+  return vec * scalar;
+}
+
+/**
+ * @brief Computes the element-wise product of two vectors.
+ */
+template <typename T, int N> inline Vec<T, N> cwiseProduct(const Vec<T, N>& a, const Vec<T, N>& b) noexcept {
+  return detail::VecOps<T, N>::product(a, b);
+}
+
+/**
+ * @brief Computes the element-wise minimum of two vectors. As std::fmin, a NaN
+ * element of one vector gives the element of the other.
+ */
+template <typename T, int N> inline Vec<T, N> cwiseMin(const Vec<T, N>& a, const Vec<T, N>& b) noexcept {
+  return detail::VecOps<T, N>::min(a, b);
+}
+
+/**
+ * @brief Computes the element-wise maximum of two vectors. As std::fmax, a NaN
+ * element of one vector gives the element of the other.
+ */
+template <typename T, int N> inline Vec<T, N> cwiseMax(const Vec<T, N>& a, const Vec<T, N>& b) noexcept {
+  return detail::VecOps<T, N>::max(a, b);
+}
+
+/**
+ * @brief Clamps each element of a vector between the elements of min and max.
+ */
+template <typename T, int N>
+inline Vec<T, N> cwiseClamp(const Vec<T, N>& a, const Vec<T, N>& min, const Vec<T, N>& max) noexcept {
+  return cwiseMin(cwiseMax(a, min), max);
+}
+
+/**
+ * @brief R x C matrix of elements of type T (row-major).
+ * @tparam T The type of the elements (e.g., float, double).
+ * @tparam R The number of rows.
+ * @tparam C The number of columns.
+ */
+template <typename T, int R, int C> struct Mat {
+  static_assert(R > 0 && C > 0, "Mat requires at least one row and one column.");
+
+  static constexpr int ROWS    = R;
+  static constexpr int COLUMNS = C;
+
+  Vec<T, C> rows[R];
+
+  /**
+   * @brief Default constructor initializes the matrix to the identity: ones on
+   * the main diagonal and zeros elsewhere.
+   */
+  Mat() noexcept {
+    detail::unroll<R>([this](int i) {
+      rows[i] = Vec<T, C>();
+      if(i < C) {
+        rows[i].v[i] = T(1);
+      }
+    });
+  }
+
+  /**
+   * @brief Constructor that initializes every element to the same value.
+   */
+  explicit Mat(T value) noexcept {
+    detail::unroll<R>([this, value](int i) { rows[i] = Vec<T, C>(value); });
+  }
+
+  /**
+   * @brief Constructor that initializes the matrix element by element, in
+   * row-major order.
+   * @param first, rest The R * C elements.
+   */
+  template <typename... Args, typename std::enable_if<sizeof...(Args) + 1 == R * C && R * C != 1 &&
+                                                          detail::AllConvertible<T, Args...>::value,
+                                                      int>::type = 0>
+  Mat(T first, Args... rest) noexcept {
+    const T values[R * C] = {first, static_cast<T>(rest)...};
+    detail::unroll<R * C>([&](int k) { rows[k / C].v[k % C] = values[k]; });
+  }
+
+  /**
+   * @brief Constructor that converts a Mat3.
+   */
+  template <int RR = R, int CC = C, typename std::enable_if<RR == 3 && CC == 3, int>::type = 0>
+  explicit Mat(const Mat3<T>& mat) noexcept {
+    detail::unroll<9>([&](int k) { rows[k / 3].v[k % 3] = mat.m[k / 3][k % 3]; });
+  }
+
+  /**
+   * @brief Constructor that converts a Mat4.
+   */
+  template <int RR = R, int CC = C, typename std::enable_if<RR == 4 && CC == 4, int>::type = 0>
+  explicit Mat(const Mat4<T>& mat) noexcept {
+    detail::unroll<16>([&](int k) { rows[k / 4].v[k % 4] = mat.m[k / 4][k % 4]; });
+  }
+
+  /**
+   * @brief Constructor that converts an Affine3 (its three stored rows).
+   */
+  template <int RR = R, int CC = C, typename std::enable_if<RR == 3 && CC == 4, int>::type = 0>
+  explicit Mat(const Affine3<T>& mat) noexcept {
+    detail::unroll<12>([&](int k) { rows[k / 4].v[k % 4] = mat.m[k / 4][k % 4]; });
+  }
+
+  /**
+   * @brief Converts to a Mat3.
+   */
+  template <int RR = R, int CC = C, typename std::enable_if<RR == 3 && CC == 3, int>::type = 0>
+  explicit operator Mat3<T>() const noexcept {
+    Mat3<T> mat;
+    detail::unroll<9>([&](int k) { mat.m[k / 3][k % 3] = rows[k / 3].v[k % 3]; });
+    return mat;
+  }
+
+  /**
+   * @brief Converts to a Mat4.
+   */
+  template <int RR = R, int CC = C, typename std::enable_if<RR == 4 && CC == 4, int>::type = 0>
+  explicit operator Mat4<T>() const noexcept {
+    Mat4<T> mat;
+    detail::unroll<16>([&](int k) { mat.m[k / 4][k % 4] = rows[k / 4].v[k % 4]; });
+    return mat;
+  }
+
+  /**
+   * @brief Converts to an Affine3.
+   */
+  template <int RR = R, int CC = C, typename std::enable_if<RR == 3 && CC == 4, int>::type = 0>
+  explicit operator Affine3<T>() const noexcept {
+    Affine3<T> mat;
+    detail::unroll<12>([&](int k) { mat.m[k / 4][k % 4] = rows[k / 4].v[k % 4]; });
+    return mat;
+  }
+
+  /**
+   * @brief Accesses the element at (row, col).
+   */
+  T& operator()(int row, int col) noexcept { return rows[row].v[col]; }
+
+  /**
+   * @brief Accesses the element at (row, col) (const version).
+   */
+  T operator()(int row, int col) const noexcept { return rows[row].v[col]; }
+
+  /**
+   * @brief Returns the column at the given index.
+   */
+  Vec<T, R> column(int index) const noexcept {
+    Vec<T, R> col;
+    detail::unroll<R>([&](int i) { col.v[i] = rows[i].v[index]; });
+    return col;
+  }
+
+  bool operator==(const Mat& other) const noexcept {
+    bool equal = true;
+    detail::unroll<R>([&](int i) { equal = equal && rows[i] == other.rows[i]; });
+    return equal;
+  }
+
+  bool operator!=(const Mat& other) const noexcept { return !(*this == other); }
+
+  Mat operator+(const Mat& other) const noexcept {
+    Mat r;
+    detail::unroll<R>([&](int i) { r.rows[i] = rows[i] + other.rows[i]; });
+    return r;
+  }
+
+  Mat operator-(const Mat& other) const noexcept {
+    Mat r;
+    detail::unroll<R>([&](int i) { r.rows[i] = rows[i] - other.rows[i]; });
+    return r;
+  }
+
+  Mat operator*(T scalar) const noexcept {
+    Mat r;
+    detail::unroll<R>([&](int i) { r.rows[i] = rows[i] * scalar; });
+    return r;
+  }
+
+  /**
+   * @brief Multiplies this matrix by a C x K matrix. Each output row is a linear
+   * combination of the rows of other.
+   * @param other The matrix to multiply with.
+   * @return The R x K matrix this * other.
+   */
+  template <int K> Mat<T, R, K> operator*(const Mat<T, C, K>& other) const noexcept {
+    Mat<T, R, K> result(T(0));
+    detail::unroll<R>([&](int i) {
+      Vec<T, K>& out = result.rows[i];
+      detail::unroll<C>([&](int k) { detail::RowMadd<T, K>::apply(out, other.rows[k], rows[i].v[k]); });
+    });
+    return result;
+  }
+
+  /**
+   * @brief Multiplies this matrix by a column vector.
+   * @param vec The vector, of C elements.
+   * @return The vector this * vec, of R elements.
+   */
+  Vec<T, R> operator*(const Vec<T, C>& vec) const noexcept {
+    Vec<T, R> result;
+    detail::unroll<R>([&](int i) { result.v[i] = dot(rows[i], vec); });
+    return result;
+  }
+
+  /**
+   * @brief Returns the transposed C x R matrix.
+   */
+  Mat<T, C, R> transposed() const noexcept {
+    Mat<T, C, R> result;
+    detail::unroll<C>([&](int j) { result.rows[j] = column(j); });
+    return result;
+  }
+
+  /**
+   * @brief Checks if this matrix is approximately equal to another matrix
+   * within a given epsilon.
+   */
+  bool isApprox(const Mat& other, T epsilon) const noexcept {
+    bool approx = true;
+    detail::unroll<R>([&](int i) { approx = approx && rows[i].isApprox(other.rows[i], epsilon); });
+    return approx;
+  }
+
+  /**
+   * @brief Returns the identity matrix.
+   */
+  static Mat Identity() noexcept { return Mat(); }
+
+  /**
+   * @brief Returns the matrix with every element set to zero.
+   */
+  static Mat Zero() noexcept { return Mat(T(0)); }
+};
+
+// GCOVR_EXCL_START
+/**
+ * @brief Overloaded output operator for Vec.
+ */
+template <typename T, int N> inline std::ostream& operator<<(std::ostream& os, const Vec<T, N>& vec) {
+  os << "Vec" << N << "(";
+  for(int i = 0; i < N; ++i) {
+    os << (i == 0 ? "" : ", ") << vec.v[i];
+  }
+  return os << ")";
+}
+
+/**
+ * @brief Overloaded output operator for Mat.
+ */
+template <typename T, int R, int C> inline std::ostream& operator<<(std::ostream& os, const Mat<T, R, C>& mat) {
+  os << "Mat" << R << "x" << C << "(\n";
+  for(int i = 0; i < R; ++i) {
+    os << "  [";
+    for(int j = 0; j < C; ++j) {
+      os << (j == 0 ? "" : ", ") << mat.rows[i].v[j];
+    }
+    os << "]\n";
+  }
+  return os << ")";
+}
+// GCOVR_EXCL_STOP
+
+template <typename T> using Mat2x2 = Mat<T, 2, 2>;
+template <typename T> using Mat2x3 = Mat<T, 2, 3>;
+template <typename T> using Mat3x4 = Mat<T, 3, 4>;
+template <typename T> using Mat4x3 = Mat<T, 4, 3>;
+
+using Mat2x2f = Mat2x2<float>;
+using Mat2x2d = Mat2x2<double>;
+using Mat2x3f = Mat2x3<float>;
+using Mat2x3d = Mat2x3<double>;
+using Mat3x4f = Mat3x4<float>;
+using Mat3x4d = Mat3x4<double>;
+using Mat4x3f = Mat4x3<float>;
+using Mat4x3d = Mat4x3<double>;
+
+} // namespace linalg
+
+#endif // LINALG_GENERIC_HPP
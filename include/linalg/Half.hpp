@@ -0,0 +1,592 @@
+/**
+ * @file Half.hpp
+ * @brief Half precision storage types for vectors and matrices.
+ *
+ * Normals, texture coordinates and animation data rarely need more than the
+ * 11 significant bits of an IEEE 754 binary16 value. The half types store them
+ * in 16 bits per element with no padding, half the size of the packed float
+ * types, so arrays of them move half the bytes through memory. They are storage
+ * only: convert to the float compute types with load() and store(), or in bulk
+ * with pack() and unpack(), which use the F16C or NEON conversion instructions
+ * when they are available.
+ */
+#ifndef LINALG_HALF_HPP
+#define LINALG_HALF_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "Mat3.hpp"
+#include "Mat4.hpp"
+#include "Packed.hpp"
+#include "Simd.hpp"
+#include "Vec2.hpp"
+#include "Vec3.hpp"
+#include "Vec4.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+namespace detail {
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+/**
+ * @brief Converts a float to the bits of the nearest half, rounding ties to
+ * even like the hardware conversions.
+ *
+ * Values beyond the half range become infinities, values below the smallest
+ * subnormal become zeros of the same sign and NaNs stay quiet NaNs.
+ */
+inline std::uint16_t floatToHalfBits(float value) noexcept {
+  std::uint32_t f;
+  std::memcpy(&f, &value, sizeof(f));
+  const auto sign = static_cast<std::uint16_t>((f >> 16) & 0x8000U);
+  f &= 0x7FFFFFFFU;
+
+  if(f >= 0x7F800000U) {
+    const std::uint32_t nan = f > 0x7F800000U ? 0x0200U | ((f >> 13) & 0x03FFU) : 0U;
+    return static_cast<std::uint16_t>(sign | 0x7C00U | nan);
+  }
+  // 65520 is halfway between the largest half and the next power of two.
+  if(f >= 0x477FF000U) {
+    return static_cast<std::uint16_t>(sign | 0x7C00U);
+  }
+  if(f >= 0x38800000U) {
+    // Normal half: rebias the exponent, round the 13 dropped mantissa bits. A
+    // carry out of the mantissa correctly increments the exponent.
+    std::uint32_t       h   = (f >> 13) - (112U << 10);
+    const std::uint32_t rem = f & 0x1FFFU;
+    if(rem > 0x1000U || (rem == 0x1000U && (h & 1U) != 0)) {
+      ++h;
+    }
+    return static_cast<std::uint16_t>(sign | h);
+  }
+  // At most half the smallest subnormal, 2^-25: rounds to zero.
+  if(f <= 0x33000000U) {
+    return sign;
+  }
+  // Subnormal half, in units of 2^-24. Rounding up may produce the smallest
+  // normal, whose encoding follows the largest subnormal.
+  const std::uint32_t mantissa = (f & 0x007FFFFFU) | 0x00800000U;
+  const std::uint32_t shift    = 126U - (f >> 23);
+  std::uint32_t       h        = mantissa >> shift;
+  const std::uint32_t rem      = mantissa & ((1U << shift) - 1U);
+  const std::uint32_t halfway  = 1U << (shift - 1U);
+  if(rem > halfway || (rem == halfway && (h & 1U) != 0)) {
+    ++h;
+  }
+  return static_cast<std::uint16_t>(sign | h);
+}
+
+/**
+ * @brief Converts the bits of a half to a float. The conversion is exact; NaNs
+ * become quiet NaNs.
+ */
+inline float halfBitsToFloat(std::uint16_t bits) noexcept {
+  const std::uint32_t sign     = static_cast<std::uint32_t>(bits & 0x8000U) << 16;
+  const std::uint32_t exponent = (bits >> 10) & 0x1FU;
+  const std::uint32_t mantissa = bits & 0x03FFU;
+
+  std::uint32_t f;
+  if(exponent == 0x1FU) {
+    f = sign | 0x7F800000U | (mantissa != 0 ? 0x00400000U | (mantissa << 13) : 0U);
+  } else if(exponent != 0) {
+    f = sign | ((exponent + 112U) << 23) | (mantissa << 13);
+  } else {
+    // Zero or subnormal: mantissa * 2^-24 is exact in float.
+    const float magnitude = static_cast<float>(mantissa) * 5.9604644775390625e-8F;
+    std::memcpy(&f, &magnitude, sizeof(f));
+    f |= sign;
+  }
+  float value;
+  std::memcpy(&value, &f, sizeof(value));
+  return value;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+} // namespace detail
+
+/**
+ * @brief IEEE 754 half precision (binary16) storage for a float.
+ * @note The default constructor leaves the value uninitialized so that large
+ * arrays are cheap to allocate; use Half{} for zero.
+ */
+struct Half {
+  std::uint16_t bits;
+
+  Half() = default;
+
+  /**
+   * @brief Constructor that stores a float, rounded to the nearest half.
+   * @param value The value to store.
+   */
+  explicit Half(float value) noexcept : bits(detail::floatToHalfBits(value)) {}
+
+  /**
+   * @brief Creates a half from its binary16 encoding.
+   * @param bits The encoding.
+   */
+  static Half FromBits(std::uint16_t bits) noexcept {
+    Half half;
+    half.bits = bits;
+    return half;
+  }
+
+  /**
+   * @brief Returns the stored value as a float.
+   */
+  float load() const noexcept { return detail::halfBitsToFloat(bits); }
+
+  /**
+   * @brief Stores a float, rounded to the nearest half.
+   * @param value The value to store.
+   */
+  void store(float value) noexcept { bits = detail::floatToHalfBits(value); }
+
+  /**
+   * @brief Converts the stored value to a float.
+   */
+  explicit operator float() const noexcept { return load(); }
+};
+
+/**
+ * @brief Half precision storage for a Vec2<float>.
+ * @note The default constructor leaves the elements uninitialized so that large
+ * arrays are cheap to allocate; use HalfVec2{} for zero.
+ */
+struct HalfVec2 {
+  Half x;
+  Half y;
+
+  HalfVec2() = default;
+
+  /**
+   * @brief Constructor that stores a Vec2, rounded to half precision.
+   * @param v The vector to store.
+   */
+  explicit HalfVec2(const Vec2<float>& v) noexcept : x(v.x), y(v.y) {}
+
+  /**
+   * @brief Returns the stored vector as a Vec2.
+   */
+  Vec2<float> load() const noexcept { return {x.load(), y.load()}; }
+
+  /**
+   * @brief Stores a Vec2, rounded to half precision.
+   * @param v The vector to store.
+   */
+  void store(const Vec2<float>& v) noexcept {
+    x.store(v.x);
+    y.store(v.y);
+  }
+};
+
+/**
+ * @brief Half precision storage for a Vec3<float>.
+ * @note The default constructor leaves the elements uninitialized so that large
+ * arrays are cheap to allocate; use HalfVec3{} for zero.
+ */
+struct HalfVec3 {
+  Half x;
+  Half y;
+  Half z;
+
+  HalfVec3() = default;
+
+  /**
+   * @brief Constructor that stores a Vec3, rounded to half precision.
+   * @param v The vector to store.
+   */
+  explicit HalfVec3(const Vec3<float>& v) noexcept : x(v.x), y(v.y), z(v.z) {}
+
+  /**
+   * @brief Returns the stored vector as a Vec3.
+   */
+  Vec3<float> load() const noexcept { return {x.load(), y.load(), z.load()}; }
+
+  /**
+   * @brief Stores a Vec3, rounded to half precision.
+   * @param v The vector to store.
+   */
+  void store(const Vec3<float>& v) noexcept {
+    x.store(v.x);
+    y.store(v.y);
+    z.store(v.z);
+  }
+};
+
+/**
+ * @brief Half precision storage for a Vec4<float>.
+ * @note The default constructor leaves the elements uninitialized so that large
+ * arrays are cheap to allocate; use HalfVec4{} for zero.
+ */
+struct HalfVec4 {
+  Half x;
+  Half y;
+  Half z;
+  Half w;
+
+  HalfVec4() = default;
+
+  /**
+   * @brief Constructor that stores a Vec4, rounded to half precision.
+   * @param v The vector to store.
+   */
+  explicit HalfVec4(const Vec4<float>& v) noexcept : x(v.x), y(v.y), z(v.z), w(v.w) {}
+
+  /**
+   * @brief Returns the stored vector as a Vec4.
+   */
+  Vec4<float> load() const noexcept { return {x.load(), y.load(), z.load(), w.load()}; }
+
+  /**
+   * @brief Stores a Vec4, rounded to half precision.
+   * @param v The vector to store.
+   */
+  void store(const Vec4<float>& v) noexcept {
+    x.store(v.x);
+    y.store(v.y);
+    z.store(v.z);
+    w.store(v.w);
+  }
+};
+
+/**
+ * @brief Half precision storage for a Mat3<float> (row-major).
+ * @note The default constructor leaves the elements uninitialized so that large
+ * arrays are cheap to allocate.
+ */
+struct HalfMat3 {
+  std::array<std::array<Half, 3>, 3> m;
+
+  HalfMat3() = default;
+
+  /**
+   * @brief Constructor that stores a Mat3, rounded to half precision.
+   * @param mat The matrix to store.
+   */
+  explicit HalfMat3(const Mat3<float>& mat) noexcept { store(mat); }
+
+  /**
+   * @brief Returns the stored matrix as a Mat3.
+   */
+  Mat3<float> load() const noexcept {
+    Mat3<float> mat;
+    for(int i = 0; i < 3; ++i) {
+      for(int j = 0; j < 3; ++j) {
+        mat.m[i][j] = m[i][j].load();
+      }
+    }
+    return mat;
+  }
+
+  /**
+   * @brief Stores a Mat3, rounded to half precision.
+   * @param mat The matrix to store.
+   */
+  void store(const Mat3<float>& mat) noexcept {
+    for(int i = 0; i < 3; ++i) {
+      for(int j = 0; j < 3; ++j) {
+        m[i][j].store(mat.m[i][j]);
+      }
+    }
+  }
+};
+
+/**
+ * @brief Half precision storage for a Mat4<float> (row-major).
+ * @note The default constructor leaves the elements uninitialized so that large
+ * arrays are cheap to allocate.
+ */
+struct HalfMat4 {
+  std::array<std::array<Half, 4>, 4> m;
+
+  HalfMat4() = default;
+
+  /**
+   * @brief Constructor that stores a Mat4, rounded to half precision.
+   * @param mat The matrix to store.
+   */
+  explicit HalfMat4(const Mat4<float>& mat) noexcept { store(mat); }
+
+  /**
+   * @brief Returns the stored matrix as a Mat4.
+   */
+  Mat4<float> load() const noexcept {
+    Mat4<float> mat;
+    for(int i = 0; i < 4; ++i) {
+      for(int j = 0; j < 4; ++j) {
+        mat.m[i][j] = m[i][j].load();
+      }
+    }
+    return mat;
+  }
+
+  /**
+   * @brief Stores a Mat4, rounded to half precision.
+   * @param mat The matrix to store.
+   */
+  void store(const Mat4<float>& mat) noexcept {
+    for(int i = 0; i < 4; ++i) {
+      for(int j = 0; j < 4; ++j) {
+        m[i][j].store(mat.m[i][j]);
+      }
+    }
+  }
+};
+
+// The half layouts are part of the API: they are copied as raw bytes.
+static_assert(sizeof(Half) == 2 && alignof(Half) == 2, "Half must be 16 bits");
+static_assert(sizeof(HalfVec2) == 4 && sizeof(HalfVec3) == 6 && sizeof(HalfVec4) == 8, "HalfVec must not be padded");
+static_assert(sizeof(HalfMat3) == 18 && sizeof(HalfMat4) == 32, "HalfMat must not be padded");
+static_assert(std::is_trivial<Half>::value && std::is_trivial<HalfVec3>::value && std::is_trivial<HalfMat4>::value,
+              "Half types must be trivial");
+
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+#if LINALG_HAS_F16C || LINALG_HAS_NEON
+#if LINALG_HAS_F16C
+using Float4 = __m128;
+
+/**
+ * @brief Converts four consecutive halves to floats.
+ */
+inline Float4 loadHalf4(const Half* in) noexcept {
+  return _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in)));
+}
+
+/**
+ * @brief Converts four floats to halves, rounding ties to even, and stores them
+ * in four consecutive halves.
+ */
+inline void storeHalf4(Half* out, Float4 v) noexcept {
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+}
+
+inline Float4 loadFloat4(const float* in) noexcept { return _mm_loadu_ps(in); }
+inline void   storeFloat4(float* out, Float4 v) noexcept { _mm_storeu_ps(out, v); }
+#else
+using Float4 = float32x4_t;
+
+/**
+ * @brief Converts four consecutive halves to floats.
+ */
+inline Float4 loadHalf4(const Half* in) noexcept {
+  return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(&in->bits)));
+}
+
+/**
+ * @brief Converts four floats to halves, rounding ties to even, and stores them
+ * in four consecutive halves.
+ */
+inline void storeHalf4(Half* out, Float4 v) noexcept { vst1_u16(&out->bits, vreinterpret_u16_f16(vcvt_f16_f32(v))); }
+
+inline Float4 loadFloat4(const float* in) noexcept { return vld1q_f32(in); }
+inline void   storeFloat4(float* out, Float4 v) noexcept { vst1q_f32(out, v); }
+#endif
+
+/**
+ * @brief Converts arrays between float and Half, sixteen (AVX-512), eight (F16C)
+ * or four elements per iteration. The last few elements go through a zeroed
+ * buffer so that they are rounded by the same instructions.
+ */
+template <> struct PackKernels<float, Half> {
+  static void pack(const float* in, Half* out, std::size_t count) noexcept {
+    std::size_t i = 0;
+#if LINALG_HAS_AVX512F
+    for(; i + 16 <= count; i += 16) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                          _mm512_cvtps_ph(_mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+#if LINALG_HAS_F16C
+    for(; i + 8 <= count; i += 8) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                       _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+    for(; i + 4 <= count; i += 4) {
+      storeHalf4(out + i, loadFloat4(in + i));
+    }
+    if(i < count) {
+      float buffer[4] = {};
+      Half  halves[4];
+      std::memcpy(buffer, in + i, (count - i) * sizeof(float));
+      storeHalf4(halves, loadFloat4(buffer));
+      std::memcpy(out + i, halves, (count - i) * sizeof(Half));
+    }
+  }
+
+  static void unpack(const Half* in, float* out, std::size_t count) noexcept {
+    std::size_t i = 0;
+#if LINALG_HAS_AVX512F
+    for(; i + 16 <= count; i += 16) {
+      _mm512_storeu_ps(out + i, _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i))));
+    }
+#endif
+#if LINALG_HAS_F16C
+    for(; i + 8 <= count; i += 8) {
+      _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))));
+    }
+#endif
+    for(; i + 4 <= count; i += 4) {
+      storeFloat4(out + i, loadHalf4(in + i));
+    }
+    if(i < count) {
+      Half  halves[4] = {};
+      float buffer[4];
+      std::memcpy(halves, in + i, (count - i) * sizeof(Half));
+      storeFloat4(buffer, loadHalf4(halves));
+      std::memcpy(out + i, buffer, (count - i) * sizeof(float));
+    }
+  }
+};
+
+/**
+ * @brief Conversions for vectors of at most four halves whose compute type is
+ * padded to four floats.
+ *
+ * Each iteration converts four lanes. Lanes past the end of an element read the
+ * start of the next one (or the padding of the compute type) and are then
+ * overwritten, so only the last element needs a buffer.
+ */
+template <typename T, typename Packed> struct HalfVecKernels {
+  static_assert(sizeof(T) >= 4 * sizeof(float) && sizeof(Packed) <= 4 * sizeof(Half), "Unsupported half vector");
+
+  static void pack(const T* in, Packed* out, std::size_t count) noexcept {
+    if(count == 0) {
+      return;
+    }
+    for(std::size_t i = 0; i + 1 < count; ++i) {
+      storeHalf4(&out[i].x, loadFloat4(&in[i].x));
+    }
+    Half halves[4];
+    storeHalf4(halves, loadFloat4(&in[count - 1].x));
+    std::memcpy(&out[count - 1], halves, sizeof(Packed));
+  }
+
+  static void unpack(const Packed* in, T* out, std::size_t count) noexcept {
+    if(count == 0) {
+      return;
+    }
+    for(std::size_t i = 0; i + 1 < count; ++i) {
+      storeFloat4(&out[i].x, loadHalf4(&in[i].x));
+    }
+    Half halves[4] = {};
+    std::memcpy(halves, &in[count - 1], sizeof(Packed));
+    storeFloat4(&out[count - 1].x, loadHalf4(halves));
+  }
+};
+
+template <> struct PackKernels<Vec2<float>, HalfVec2> : HalfVecKernels<Vec2<float>, HalfVec2> {};
+template <> struct PackKernels<Vec3<float>, HalfVec3> : HalfVecKernels<Vec3<float>, HalfVec3> {};
+
+/**
+ * @brief Arrays of Vec4 and Mat4 are contiguous floats, converted in one pass.
+ */
+template <> struct PackKernels<Vec4<float>, HalfVec4> {
+  static void pack(const Vec4<float>* in, HalfVec4* out, std::size_t count) noexcept {
+    PackKernels<float, Half>::pack(&in->x, &out->x, 4 * count);
+  }
+
+  static void unpack(const HalfVec4* in, Vec4<float>* out, std::size_t count) noexcept {
+    PackKernels<float, Half>::unpack(&in->x, &out->x, 4 * count);
+  }
+};
+
+template <> struct PackKernels<Mat4<float>, HalfMat4> {
+  static void pack(const Mat4<float>* in, HalfMat4* out, std::size_t count) noexcept {
+    PackKernels<float, Half>::pack(in->data(), &out->m[0][0], 16 * count);
+  }
+
+  static void unpack(const HalfMat4* in, Mat4<float>* out, std::size_t count) noexcept {
+    PackKernels<float, Half>::unpack(&in->m[0][0], &out->m[0][0], 16 * count);
+  }
+};
+
+/**
+ * @brief Mat3 is padded to twelve floats: its nine elements are converted one
+ * matrix at a time.
+ */
+template <> struct PackKernels<Mat3<float>, HalfMat3> {
+  static void pack(const Mat3<float>* in, HalfMat3* out, std::size_t count) noexcept {
+    for(std::size_t i = 0; i < count; ++i) {
+      PackKernels<float, Half>::pack(in[i].data(), &out[i].m[0][0], 9);
+    }
+  }
+
+  static void unpack(const HalfMat3* in, Mat3<float>* out, std::size_t count) noexcept {
+    for(std::size_t i = 0; i < count; ++i) {
+      PackKernels<float, Half>::unpack(&in[i].m[0][0], &out[i].m[0][0], 9);
+    }
+  }
+};
+#endif
+
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+
+/**
+ * @brief Converts an array of floats, vectors or matrices to their half
+ * precision storage type, rounding ties to even.
+ * @param in The input array.
+ * @param out The output array. It must not overlap in.
+ * @param count The number of elements.
+ */
+inline void pack(const float* in, Half* out, std::size_t count) noexcept {
+  detail::PackKernels<float, Half>::pack(in, out, count);
+}
+inline void pack(const Vec2<float>* in, HalfVec2* out, std::size_t count) noexcept {
+  detail::PackKernels<Vec2<float>, HalfVec2>::pack(in, out, count);
+}
+inline void pack(const Vec3<float>* in, HalfVec3* out, std::size_t count) noexcept {
+  detail::PackKernels<Vec3<float>, HalfVec3>::pack(in, out, count);
+}
+inline void pack(const Vec4<float>* in, HalfVec4* out, std::size_t count) noexcept {
+  detail::PackKernels<Vec4<float>, HalfVec4>::pack(in, out, count);
+}
+inline void pack(const Mat3<float>* in, HalfMat3* out, std::size_t count) noexcept {
+  detail::PackKernels<Mat3<float>, HalfMat3>::pack(in, out, count);
+}
+inline void pack(const Mat4<float>* in, HalfMat4* out, std::size_t count) noexcept {
+  detail::PackKernels<Mat4<float>, HalfMat4>::pack(in, out, count);
+}
+
+/**
+ * @brief Converts an array of half precision values, vectors or matrices to
+ * their float compute type. The conversion is exact.
+ * @param in The input array.
+ * @param out The output array. It must not overlap in.
+ * @param count The number of elements.
+ */
+inline void unpack(const Half* in, float* out, std::size_t count) noexcept {
+  detail::PackKernels<float, Half>::unpack(in, out, count);
+}
+inline void unpack(const HalfVec2* in, Vec2<float>* out, std::size_t count) noexcept {
+  detail::PackKernels<Vec2<float>, HalfVec2>::unpack(in, out, count);
+}
+inline void unpack(const HalfVec3* in, Vec3<float>* out, std::size_t count) noexcept {
+  detail::PackKernels<Vec3<float>, HalfVec3>::unpack(in, out, count);
+}
+inline void unpack(const HalfVec4* in, Vec4<float>* out, std::size_t count) noexcept {
+  detail::PackKernels<Vec4<float>, HalfVec4>::unpack(in, out, count);
+}
+inline void unpack(const HalfMat3* in, Mat3<float>* out, std::size_t count) noexcept {
+  detail::PackKernels<Mat3<float>, HalfMat3>::unpack(in, out, count);
+}
+inline void unpack(const HalfMat4* in, Mat4<float>* out, std::size_t count) noexcept {
+  detail::PackKernels<Mat4<float>, HalfMat4>::unpack(in, out, count);
+}
+
+} // namespace linalg
+
+#endif // LINALG_HALF_HPP
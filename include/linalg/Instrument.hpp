@@ -0,0 +1,367 @@
+/**
+ * @file Instrument.hpp
+ * @brief Opt-in per-operation counters for profiling builds.
+ *
+ * Defining LINALG_INSTRUMENT makes the instrumented operations count their
+ * calls and their degenerate cases (zero-length normalization, singular
+ * inverses, total internal reflection) in thread-local counters, and
+ * LINALG_INSTRUMENT_TIMING additionally accumulates the time-stamp counter
+ * ticks spent in the matrix products and inverses. Without LINALG_INSTRUMENT
+ * the hooks expand to nothing and snapshot() returns zeros.
+ *
+ * The definitions change the bodies of inline functions, so they must be the
+ * same in every translation unit of a program: set them on the linalg target
+ * with the LINALG_ENABLE_INSTRUMENT and LINALG_ENABLE_INSTRUMENT_TIMING CMake
+ * options rather than in individual sources.
+ */
+#ifndef LINALG_INSTRUMENT_HPP
+#define LINALG_INSTRUMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#ifdef LINALG_INSTRUMENT
+#include <atomic>
+#include <mutex>
+#include <vector>
+#ifdef LINALG_INSTRUMENT_TIMING
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+#endif
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @namespace linalg::instrument
+ * @brief Operation counters of LINALG_INSTRUMENT builds.
+ */
+namespace instrument {
+
+/**
+ * @brief The instrumented operations and degenerate cases.
+ */
+enum class Counter : unsigned {
+  Mat3Multiply,                   ///< Mat3 * Mat3
+  Mat3Inverse,                    ///< Mat3::inverse()
+  Mat3InverseSingular,            ///< Mat3::inverse() returning the identity
+  Mat4Multiply,                   ///< Mat4 * Mat4
+  Mat4TransformVec4,              ///< Mat4 * Vec4
+  Mat4Inverse,                    ///< Mat4::inverse() and Mat4::tryInverse()
+  Mat4InverseSingular,            ///< Mat4::inverse() and Mat4::tryInverse() on singular matrices
+  AffineInverseSingular,          ///< Mat4::inverseAffine() and Affine3::inverse() returning the identity
+  Normalize,                      ///< normalize() and normalized() of Vec2, Vec3 and Vec4
+  NormalizeZeroLength,            ///< normalize() and normalized() of zero-length vectors
+  Refract,                        ///< refract() of Vec3 and of each lane of a Vec3Packet
+  RefractTotalInternalReflection, ///< refract() reflecting instead
+  Count
+};
+
+constexpr std::size_t COUNTER_COUNT = static_cast<std::size_t>(Counter::Count);
+
+/**
+ * @brief True when the library is built with LINALG_INSTRUMENT.
+ */
+#ifdef LINALG_INSTRUMENT
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+/**
+ * @brief True when the library is built with LINALG_INSTRUMENT_TIMING.
+ */
+#if defined(LINALG_INSTRUMENT) && defined(LINALG_INSTRUMENT_TIMING)
+constexpr bool TIMING = true;
+#else
+constexpr bool TIMING = false;
+#endif
+
+/**
+ * @brief Returns the name of a counter, as written by writeCsv().
+ */
+inline const char* counterName(Counter counter) noexcept {
+  static const char* const NAMES[COUNTER_COUNT] = {"Mat3Multiply",
+                                                   "Mat3Inverse",
+                                                   "Mat3InverseSingular",
+                                                   "Mat4Multiply",
+                                                   "Mat4TransformVec4",
+                                                   "Mat4Inverse",
+                                                   "Mat4InverseSingular",
+                                                   "AffineInverseSingular",
+                                                   "Normalize",
+                                                   "NormalizeZeroLength",
+                                                   "Refract",
+                                                   "RefractTotalInternalReflection"};
+  const auto index = static_cast<std::size_t>(counter);
+  return index < COUNTER_COUNT ? NAMES[index] : "Unknown";
+}
+
+/**
+ * @brief Counter values: the number of events and, for timed operations, the
+ * time-stamp counter ticks spent in them.
+ */
+struct Snapshot {
+  std::uint64_t counts[COUNTER_COUNT] = {};
+  std::uint64_t ticks[COUNTER_COUNT]  = {};
+
+  std::uint64_t count(Counter counter) const noexcept { return counts[static_cast<std::size_t>(counter)]; }
+  std::uint64_t tickCount(Counter counter) const noexcept { return ticks[static_cast<std::size_t>(counter)]; }
+
+  /**
+   * @brief Adds the values of another snapshot.
+   */
+  Snapshot& operator+=(const Snapshot& other) noexcept {
+    for(std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+      counts[i] += other.counts[i];
+      ticks[i] += other.ticks[i];
+    }
+    return *this;
+  }
+};
+
+/**
+ * @brief Writes a snapshot as CSV lines "counter,count,ticks", after a header
+ * line.
+ * @param os The output stream.
+ * @param snapshot The counter values.
+ * @return The output stream.
+ */
+inline std::ostream& writeCsv(std::ostream& os, const Snapshot& snapshot) {
+  os << "counter,count,ticks\n";
+  for(std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+    os << counterName(static_cast<Counter>(i)) << ',' << snapshot.counts[i] << ',' << snapshot.ticks[i] << '\n';
+  }
+  return os;
+}
+
+#ifdef LINALG_INSTRUMENT
+
+namespace detail {
+
+struct ThreadCounters;
+
+/**
+ * @brief The counters of the live threads and the totals of the exited ones.
+ */
+struct Registry {
+  std::mutex                   mutex;
+  std::vector<ThreadCounters*> threads;
+  Snapshot                     exited;
+};
+
+inline Registry& registry() {
+  static Registry instance;
+  return instance;
+}
+
+/**
+ * @brief Counters of one thread. Only the owning thread increments them, with
+ * relaxed loads and stores rather than atomic read-modify-writes; the atomics
+ * only make concurrent snapshots well defined.
+ */
+struct ThreadCounters {
+  std::atomic<std::uint64_t> counts[COUNTER_COUNT];
+  std::atomic<std::uint64_t> ticks[COUNTER_COUNT];
+
+  ThreadCounters() {
+    for(std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+      counts[i].store(0, std::memory_order_relaxed);
+      ticks[i].store(0, std::memory_order_relaxed);
+    }
+    Registry&                   r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.threads.push_back(this);
+  }
+
+  ~ThreadCounters() {
+    Registry&                   r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.exited += load();
+    for(std::size_t i = 0; i < r.threads.size(); ++i) {
+      if(r.threads[i] == this) {
+        r.threads[i] = r.threads.back();
+        r.threads.pop_back();
+        break;
+      }
+    }
+  }
+
+  ThreadCounters(const ThreadCounters&)            = delete;
+  ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+  Snapshot load() const noexcept {
+    Snapshot snapshot;
+    for(std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+      snapshot.counts[i] = counts[i].load(std::memory_order_relaxed);
+      snapshot.ticks[i]  = ticks[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+  }
+
+  void clear() noexcept {
+    for(std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+      counts[i].store(0, std::memory_order_relaxed);
+      ticks[i].store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
+inline ThreadCounters& threadCounters() {
+  static thread_local ThreadCounters counters;
+  return counters;
+}
+
+inline void increase(std::atomic<std::uint64_t>& value, std::uint64_t amount) noexcept {
+  value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Adds events to a counter of the calling thread.
+ */
+inline void add(Counter counter, std::uint64_t events) {
+  increase(threadCounters().counts[static_cast<std::size_t>(counter)], events);
+}
+
+/**
+ * @brief Returns the number of set bits of a lane mask.
+ */
+inline std::uint64_t countLanes(unsigned bits) noexcept {
+  std::uint64_t count = 0;
+  for(; bits != 0; bits &= bits - 1) {
+    ++count;
+  }
+  return count;
+}
+
+#ifdef LINALG_INSTRUMENT_TIMING
+/**
+ * @brief Reads the time-stamp counter, or a steady clock in nanoseconds where
+ * there is none.
+ */
+inline std::uint64_t readTicks() noexcept {
+#if(defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))) || defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                        std::chrono::steady_clock::now().time_since_epoch())
+                                        .count());
+#endif
+}
+
+/**
+ * @brief Counts one call and adds the ticks until its destruction.
+ */
+class ScopedTimer {
+public:
+  explicit ScopedTimer(Counter counter) : m_counter(counter), m_start(readTicks()) {}
+  ~ScopedTimer() {
+    ThreadCounters&   counters = threadCounters();
+    const std::size_t index    = static_cast<std::size_t>(m_counter);
+    increase(counters.ticks[index], readTicks() - m_start);
+    increase(counters.counts[index], 1);
+  }
+
+  ScopedTimer(const ScopedTimer&)            = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+  Counter       m_counter;
+  std::uint64_t m_start;
+};
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Returns the counters of the calling thread.
+ */
+inline Snapshot threadSnapshot() { return detail::threadCounters().load(); }
+
+/**
+ * @brief Returns the sum of the counters of every thread, including the threads
+ * that have exited since the last reset(). Events of other threads that are
+ * still running may or may not be included.
+ */
+inline Snapshot snapshot() {
+  detail::Registry&           r = detail::registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  Snapshot                    total = r.exited;
+  for(const detail::ThreadCounters* counters : r.threads) {
+    total += counters->load();
+  }
+  return total;
+}
+
+/**
+ * @brief Clears the counters of every thread. Events counted concurrently by
+ * other threads may survive the reset.
+ */
+inline void reset() {
+  detail::Registry&           r = detail::registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.exited = Snapshot();
+  for(detail::ThreadCounters* counters : r.threads) {
+    counters->clear();
+  }
+}
+
+#else
+
+inline Snapshot threadSnapshot() noexcept { return {}; }
+inline Snapshot snapshot() noexcept { return {}; }
+inline void     reset() noexcept {}
+
+#endif
+
+} // namespace instrument
+
+} // namespace linalg
+
+#ifdef LINALG_INSTRUMENT
+/**
+ * @brief Counts one event.
+ */
+#define LINALG_INSTRUMENT_COUNT(NAME) ::linalg::instrument::detail::add(::linalg::instrument::Counter::NAME, 1)
+/**
+ * @brief Counts one event when COND holds; COND is not evaluated otherwise.
+ */
+#define LINALG_INSTRUMENT_COUNT_IF(COND, NAME)                                                                         \
+  ((COND) ? LINALG_INSTRUMENT_COUNT(NAME) : static_cast<void>(0))
+/**
+ * @brief Counts EVENTS events.
+ */
+#define LINALG_INSTRUMENT_ADD(NAME, EVENTS)                                                                            \
+  ::linalg::instrument::detail::add(::linalg::instrument::Counter::NAME, static_cast<std::uint64_t>(EVENTS))
+/**
+ * @brief Counts the set bits of a lane mask.
+ */
+#define LINALG_INSTRUMENT_ADD_LANES(NAME, BITS) LINALG_INSTRUMENT_ADD(NAME, ::linalg::instrument::detail::countLanes(BITS))
+#ifdef LINALG_INSTRUMENT_TIMING
+/**
+ * @brief Counts a call of the enclosing scope and the ticks spent in it.
+ */
+#define LINALG_INSTRUMENT_SCOPE(NAME)                                                                                  \
+  const ::linalg::instrument::detail::ScopedTimer linalg_instrument_scope(::linalg::instrument::Counter::NAME)
+#else
+#define LINALG_INSTRUMENT_SCOPE(NAME) LINALG_INSTRUMENT_COUNT(NAME)
+#endif
+#else
+#define LINALG_INSTRUMENT_COUNT(NAME) static_cast<void>(0)
+#define LINALG_INSTRUMENT_COUNT_IF(COND, NAME) static_cast<void>(0)
+#define LINALG_INSTRUMENT_ADD(NAME, EVENTS) static_cast<void>(0)
+#define LINALG_INSTRUMENT_ADD_LANES(NAME, BITS) static_cast<void>(0)
+#define LINALG_INSTRUMENT_SCOPE(NAME) static_cast<void>(0)
+#endif
+
+#endif // LINALG_INSTRUMENT_HPP
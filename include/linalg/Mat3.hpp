@@ -7,12 +7,13 @@
 
 #include <array>
 #include <cmath>
-#include <immintrin.h>
 #include <initializer_list>
 #include <iostream>
 #include <stdexcept>
 
 #include "Alignment.hpp"
+#include "Instrument.hpp"
+#include "Tolerance.hpp"
 #include "Vec3.hpp"
 
 /**
@@ -40,6 +41,15 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 3>::VALUE) Mat3 {
   explicit constexpr Mat3(T value) noexcept
       : m{{{value, value, value}, {value, value, value}, {value, value, value}}} {}
 
+  /**
+   * @brief Constructor that initializes the matrix element by element, in
+   * row-major order.
+   * @param m00 ... m22 The elements of the matrix, mij being at row i and
+   * column j.
+   */
+  constexpr Mat3(T m00, T m01, T m02, T m10, T m11, T m12, T m20, T m21, T m22) noexcept
+      : m{{{{m00, m01, m02}}, {{m10, m11, m12}}, {{m20, m21, m22}}}} {}
+
   /**
    * @brief Constructor that initializes the matrix with an initializer list.
    * @param list An initializer list containing the rows of the matrix.
@@ -118,14 +128,7 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 3>::VALUE) Mat3 {
    * @return True if the matrices are equal, false otherwise.
    */
   bool operator==(const Mat3& other) const noexcept {
-    for(int i = 0; i < 3; ++i) {
-      for(int j = 0; j < 3; ++j) {
-        if(m[i][j] != other.m[i][j]) {
-          return false;
-        }
-      }
-    }
-    return true;
+    return detail::allLanes<T, 9>(data(), other.data(), detail::EqualLanes());
   }
 
   /**
@@ -139,18 +142,8 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 3>::VALUE) Mat3 {
    * @brief Returns a transposed version of the matrix.
    * @return A new Mat3 object that is the transpose of the current matrix.
    */
-  Mat3 transposed() const noexcept {
-    Mat3 result;
-    result.m[0][0] = m[0][0];
-    result.m[0][1] = m[1][0];
-    result.m[0][2] = m[2][0];
-    result.m[1][0] = m[0][1];
-    result.m[1][1] = m[1][1];
-    result.m[1][2] = m[2][1];
-    result.m[2][0] = m[0][2];
-    result.m[2][1] = m[1][2];
-    result.m[2][2] = m[2][2];
-    return result;
+  constexpr Mat3 transposed() const noexcept {
+    return {m[0][0], m[1][0], m[2][0], m[0][1], m[1][1], m[2][1], m[0][2], m[1][2], m[2][2]};
   }
 
   /**
@@ -165,13 +158,14 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 3>::VALUE) Mat3 {
   /**
    * @brief Returns the inverse of the matrix.
    * @return A new Mat3 object that is the inverse of the current matrix.
-   *         If the determinant is zero, returns an identity matrix.
+   *         If the magnitude of the determinant is below
+   *         Tolerance<T>::SingularDeterminant(), returns an identity matrix.
    */
   Mat3 inverse() const {
-    static constexpr T epsilon = 1e-6; // Small value to check for near-zero determinant
-
+    LINALG_INSTRUMENT_SCOPE(Mat3Inverse);
     const T det = determinant();
-    if(std::abs(det) < epsilon) {
+    if(std::abs(det) < Tolerance<T>::SingularDeterminant()) {
+      LINALG_INSTRUMENT_COUNT(Mat3InverseSingular);
       return Mat3{};
     }
     const T inv_det = 1.0 / det;
@@ -198,6 +192,7 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 3>::VALUE) Mat3 {
    * @return A new Mat3 object that is the result of the multiplication.
    */
   Mat3 operator*(const Mat3& other) const noexcept {
+    LINALG_INSTRUMENT_SCOPE(Mat3Multiply);
     Mat3 result;
     for(int i = 0; i < 3; ++i) {
       const auto& row = m[i];
@@ -226,15 +221,19 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 3>::VALUE) Mat3 {
    * @return True if the matrices are approximately equal, false otherwise.
    * @tparam T The type of the elements in the matrix.
    */
-  bool isApprox(const Mat3& other, T epsilon) const {
-    for(int i = 0; i < 3; ++i) {
-      for(int j = 0; j < 3; ++j) {
-        if(std::abs(m[i][j] - other.m[i][j]) > epsilon) {
-          return false;
-        }
-      }
-    }
-    return true;
+  bool isApprox(const Mat3& other, T epsilon) const noexcept {
+    return detail::allLanes<T, 9>(data(), other.data(), detail::AbsoluteLanes<T>{epsilon});
+  }
+
+  /**
+   * @brief Checks if this matrix is approximately equal to another matrix
+   * element by element with a tolerance policy.
+   * @param other The matrix to compare with.
+   * @param tolerance The absolute and relative tolerance of each element.
+   * @return True if the matrices are approximately equal, false otherwise.
+   */
+  bool isApprox(const Mat3& other, const Tolerance<T>& tolerance = Tolerance<T>::Default()) const noexcept {
+    return detail::allLanes<T, 9>(data(), other.data(), detail::ToleranceLanes<T>{tolerance});
   }
 
   /**
@@ -252,8 +251,8 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 3>::VALUE) Mat3 {
    * @tparam T The type of the elements in the matrix.
    * @note The rows are expected to be of type Vec3<T>.
    */
-  static Mat3 FromRows(const Vec3<T>& row1, const Vec3<T>& row2, const Vec3<T>& row3) {
-    return Mat3{{{row1.x, row1.y, row1.z}, {row2.x, row2.y, row2.z}, {row3.x, row3.y, row3.z}}};
+  static constexpr Mat3 FromRows(const Vec3<T>& row1, const Vec3<T>& row2, const Vec3<T>& row3) noexcept {
+    return {row1.x, row1.y, row1.z, row2.x, row2.y, row2.z, row3.x, row3.y, row3.z};
   }
 
   /**
@@ -265,8 +264,8 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 3>::VALUE) Mat3 {
    * @tparam T The type of the elements in the matrix.
    * @note The columns are expected to be of type Vec3<T>.
    */
-  static Mat3 FromColumns(const Vec3<T>& col1, const Vec3<T>& col2, const Vec3<T>& col3) {
-    return Mat3{{{col1.x, col2.x, col3.x}, {col1.y, col2.y, col3.y}, {col1.z, col2.z, col3.z}}};
+  static constexpr Mat3 FromColumns(const Vec3<T>& col1, const Vec3<T>& col2, const Vec3<T>& col3) noexcept {
+    return {col1.x, col2.x, col3.x, col1.y, col2.y, col3.y, col1.z, col2.z, col3.z};
   }
 };
 
@@ -7,12 +7,14 @@
 
 #include <array>
 #include <cmath>
-#include <immintrin.h>
 #include <initializer_list>
 #include <iostream>
 
 #include "Alignment.hpp"
+#include "Instrument.hpp"
 #include "Mat3.hpp"
+#include "Mat4Kernels.hpp"
+#include "Tolerance.hpp"
 #include "Vec3.hpp"
 #include "Vec4.hpp"
 
@@ -32,19 +34,29 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Mat4 {
   /**
    * @brief Default constructor initializes the matrix to the identity matrix.
    */
-  constexpr Mat4()
+  constexpr Mat4() noexcept
       : m{{{{1.0, 0.0, 0.0, 0.0}}, {{0.0, 1.0, 0.0, 0.0}}, {{0.0, 0.0, 1.0, 0.0}}, {{0.0, 0.0, 0.0, 1.0}}}} {}
 
   /**
    * @brief Constructor that initializes the matrix with a specific value.
    * @param value The value to initialize all elements of the matrix.
    */
-  explicit constexpr Mat4(T value)
+  explicit constexpr Mat4(T value) noexcept
       : m{{{{value, value, value, value}},
            {{value, value, value, value}},
            {{value, value, value, value}},
            {{value, value, value, value}}}} {}
 
+  /**
+   * @brief Constructor that initializes the matrix element by element, in
+   * row-major order.
+   * @param m00 ... m33 The elements of the matrix, mij being at row i and
+   * column j.
+   */
+  constexpr Mat4(T m00, T m01, T m02, T m03, T m10, T m11, T m12, T m13, T m20, T m21, T m22, T m23, T m30, T m31,
+                 T m32, T m33) noexcept
+      : m{{{{m00, m01, m02, m03}}, {{m10, m11, m12, m13}}, {{m20, m21, m22, m23}}, {{m30, m31, m32, m33}}}} {}
+
   /**
    * @brief Constructor that initializes the matrix with an initializer list.
    * @param list An initializer list containing the rows of the matrix.
@@ -67,16 +79,9 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Mat4 {
    * @brief Constructor that initializes the matrix from a Mat3.
    * @param mat The Mat3 to convert to a Mat4.
    */
-  explicit Mat4(const Mat3<T>& mat) {
-    for(int i = 0; i < 3; ++i) {
-      for(int j = 0; j < 3; ++j) {
-        m[i][j] = mat.m[i][j];
-      }
-    }
-    m[0][3] = m[1][3] = m[2][3] = 0.0;
-    m[3][0] = m[3][1] = m[3][2] = 0.0;
-    m[3][3]                     = 1.0;
-  }
+  explicit constexpr Mat4(const Mat3<T>& mat) noexcept
+      : Mat4(mat.m[0][0], mat.m[0][1], mat.m[0][2], 0, mat.m[1][0], mat.m[1][1], mat.m[1][2], 0, mat.m[2][0],
+             mat.m[2][1], mat.m[2][2], 0, 0, 0, 0, 1) {}
 
   /**
    * @brief Copy constructor.
@@ -131,15 +136,8 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Mat4 {
    * @param other The matrix to compare with.
    * @return True if the matrices are equal, false otherwise.
    */
-  bool operator==(const Mat4& other) const {
-    for(int i = 0; i < 4; ++i) {
-      for(int j = 0; j < 4; ++j) {
-        if(m[i][j] != other.m[i][j]) {
-          return false;
-        }
-      }
-    }
-    return true;
+  bool operator==(const Mat4& other) const noexcept {
+    return detail::allLanes<T, 16>(data(), other.data(), detail::EqualLanes());
   }
 
   /**
@@ -147,7 +145,7 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Mat4 {
    * @param other The matrix to compare with.
    * @return True if the matrices are not equal, false otherwise.
    */
-  bool operator!=(const Mat4& other) const { return !(*this == other); }
+  bool operator!=(const Mat4& other) const noexcept { return !(*this == other); }
 
   /**
    * @brief Returns a transposed version of the matrix.
@@ -176,92 +174,119 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Mat4 {
     return result;
   }
 
-  // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+  /**
+   * @brief Computes the inverse of the matrix, reporting whether it exists.
+   * @param result The matrix receiving the inverse. It may be this matrix and is
+   * left unmodified if the matrix is singular.
+   * @return True if the matrix is invertible, false if its determinant is zero.
+   */
+  bool tryInverse(Mat4& result) const noexcept {
+    LINALG_INSTRUMENT_SCOPE(Mat4Inverse);
+    const bool invertible = detail::Mat4Kernels<T>::inverse(data(), &result.m[0][0]);
+    LINALG_INSTRUMENT_COUNT_IF(!invertible, Mat4InverseSingular);
+    return invertible;
+  }
+
   /**
    * @brief Returns the inverse of the matrix.
    * @return A new Mat4 object that is the inverse of this matrix.
    *         If the determinant is zero, returns an identity matrix.
+   * @note Use tryInverse() to detect singular matrices.
    */
-  Mat4 inverse() const {
+  Mat4 inverse() const noexcept {
     Mat4 inv;
+    tryInverse(inv);
+    return inv;
+  }
 
-    inv[0] = m[1][1] * m[2][2] * m[3][3] - m[1][1] * m[2][3] * m[3][2] - m[2][1] * m[1][2] * m[3][3] +
-             m[2][1] * m[1][3] * m[3][2] + m[3][1] * m[1][2] * m[2][3] - m[3][1] * m[1][3] * m[2][2];
-
-    inv[1] = -m[0][1] * m[2][2] * m[3][3] + m[0][1] * m[2][3] * m[3][2] + m[2][1] * m[0][2] * m[3][3] -
-             m[2][1] * m[0][3] * m[3][2] - m[3][1] * m[0][2] * m[2][3] + m[3][1] * m[0][3] * m[2][2];
-
-    inv[2] = m[0][1] * m[1][2] * m[3][3] - m[0][1] * m[1][3] * m[3][2] - m[1][1] * m[0][2] * m[3][3] +
-             m[1][1] * m[0][3] * m[3][2] + m[3][1] * m[0][2] * m[1][3] - m[3][1] * m[0][3] * m[1][2];
-
-    inv[3] = -m[0][1] * m[1][2] * m[2][3] + m[0][1] * m[1][3] * m[2][2] + m[1][1] * m[0][2] * m[2][3] -
-             m[1][1] * m[0][3] * m[2][2] - m[2][1] * m[0][2] * m[1][3] + m[2][1] * m[0][3] * m[1][2];
-
-    inv[4] = -m[1][0] * m[2][2] * m[3][3] + m[1][0] * m[2][3] * m[3][2] + m[2][0] * m[1][2] * m[3][3] -
-             m[2][0] * m[1][3] * m[3][2] - m[3][0] * m[1][2] * m[2][3] + m[3][0] * m[1][3] * m[2][2];
-
-    inv[5] = m[0][0] * m[2][2] * m[3][3] - m[0][0] * m[2][3] * m[3][2] - m[2][0] * m[0][2] * m[3][3] +
-             m[2][0] * m[0][3] * m[3][2] + m[3][0] * m[0][2] * m[2][3] - m[3][0] * m[0][3] * m[2][2];
-
-    inv[6] = -m[0][0] * m[1][2] * m[3][3] + m[0][0] * m[1][3] * m[3][2] + m[1][0] * m[0][2] * m[3][3] -
-             m[1][0] * m[0][3] * m[3][2] - m[3][0] * m[0][2] * m[1][3] + m[3][0] * m[0][3] * m[1][2];
-
-    inv[7] = m[0][0] * m[1][2] * m[2][3] - m[0][0] * m[1][3] * m[2][2] - m[1][0] * m[0][2] * m[2][3] +
-             m[1][0] * m[0][3] * m[2][2] + m[2][0] * m[0][2] * m[1][3] - m[2][0] * m[0][3] * m[1][2];
-
-    inv[8] = m[1][0] * m[2][1] * m[3][3] - m[1][0] * m[2][3] * m[3][1] - m[2][0] * m[1][1] * m[3][3] +
-             m[2][0] * m[1][3] * m[3][1] + m[3][0] * m[1][1] * m[2][3] - m[3][0] * m[1][3] * m[2][1];
-
-    inv[9] = -m[0][0] * m[2][1] * m[3][3] + m[0][0] * m[2][3] * m[3][1] + m[2][0] * m[0][1] * m[3][3] -
-             m[2][0] * m[0][3] * m[3][1] - m[3][0] * m[0][1] * m[2][3] + m[3][0] * m[0][3] * m[2][1];
-
-    inv[10] = m[0][0] * m[1][1] * m[3][3] - m[0][0] * m[1][3] * m[3][1] - m[1][0] * m[0][1] * m[3][3] +
-              m[1][0] * m[0][3] * m[3][1] + m[3][0] * m[0][1] * m[1][3] - m[3][0] * m[0][3] * m[1][1];
-
-    inv[11] = -m[0][0] * m[1][1] * m[2][3] + m[0][0] * m[1][3] * m[2][1] + m[1][0] * m[0][1] * m[2][3] -
-              m[1][0] * m[0][3] * m[2][1] - m[2][0] * m[0][1] * m[1][3] + m[2][0] * m[0][3] * m[1][1];
-
-    inv[12] = -m[1][0] * m[2][1] * m[3][2] + m[1][0] * m[2][2] * m[3][1] + m[2][0] * m[1][1] * m[3][2] -
-              m[2][0] * m[1][2] * m[3][1] - m[3][0] * m[1][1] * m[2][2] + m[3][0] * m[1][2] * m[2][1];
-
-    inv[13] = m[0][0] * m[2][1] * m[3][2] - m[0][0] * m[2][2] * m[3][1] - m[2][0] * m[0][1] * m[3][2] +
-              m[2][0] * m[0][2] * m[3][1] + m[3][0] * m[0][1] * m[2][2] - m[3][0] * m[0][2] * m[2][1];
-
-    inv[14] = -m[0][0] * m[1][1] * m[3][2] + m[0][0] * m[1][2] * m[3][1] + m[1][0] * m[0][1] * m[3][2] -
-              m[1][0] * m[0][2] * m[3][1] - m[3][0] * m[0][1] * m[1][2] + m[3][0] * m[0][2] * m[1][1];
-
-    inv[15] = m[0][0] * m[1][1] * m[2][2] - m[0][0] * m[1][2] * m[2][1] - m[1][0] * m[0][1] * m[2][2] +
-              m[1][0] * m[0][2] * m[2][1] + m[2][0] * m[0][1] * m[1][2] - m[2][0] * m[0][2] * m[1][1];
-
-    T det = m[0][0] * inv[0] + m[0][1] * inv[4] + m[0][2] * inv[8] + m[0][3] * inv[12];
-
-    if(det == 0.0) {
+  /**
+   * @brief Returns the inverse of an affine matrix.
+   *
+   * The matrix is assumed to have a bottom row of [0 0 0 1]. The inverse is
+   * the inverse of the top-left 3x3 block, obtained from the cross products of
+   * its rows, followed by the translation fixup -inverse(A) * t.
+   * @return A new Mat4 object that is the inverse of this matrix.
+   *         If the top-left 3x3 block is singular, returns an identity matrix.
+   */
+  Mat4 inverseAffine() const noexcept {
+    const Vec3<T> r0(m[0][0], m[0][1], m[0][2]);
+    const Vec3<T> r1(m[1][0], m[1][1], m[1][2]);
+    const Vec3<T> r2(m[2][0], m[2][1], m[2][2]);
+
+    // Columns of the adjugate of the 3x3 block
+    const Vec3<T> c0 = r1.cross(r2);
+    const Vec3<T> c1 = r2.cross(r0);
+    const Vec3<T> c2 = r0.cross(r1);
+
+    const T det = r0.x * c0.x + r0.y * c0.y + r0.z * c0.z;
+    if(det == T(0)) {
+      LINALG_INSTRUMENT_COUNT(AffineInverseSingular);
       return Mat4{};
     }
+    const T inv_det = T(1) / det;
 
-    det = 1.0 / det;
+    Mat4 inv;
+    inv.m[0][0] = c0.x * inv_det;
+    inv.m[0][1] = c1.x * inv_det;
+    inv.m[0][2] = c2.x * inv_det;
+    inv.m[1][0] = c0.y * inv_det;
+    inv.m[1][1] = c1.y * inv_det;
+    inv.m[1][2] = c2.y * inv_det;
+    inv.m[2][0] = c0.z * inv_det;
+    inv.m[2][1] = c1.z * inv_det;
+    inv.m[2][2] = c2.z * inv_det;
+
+    const T tx  = m[0][3];
+    const T ty  = m[1][3];
+    const T tz  = m[2][3];
+    inv.m[0][3] = -(inv.m[0][0] * tx + inv.m[0][1] * ty + inv.m[0][2] * tz);
+    inv.m[1][3] = -(inv.m[1][0] * tx + inv.m[1][1] * ty + inv.m[1][2] * tz);
+    inv.m[2][3] = -(inv.m[2][0] * tx + inv.m[2][1] * ty + inv.m[2][2] * tz);
 
-    for(int i = 0; i < 16; ++i) {
-      inv[i] *= det;
-    }
+    return inv;
+  }
+
+  /**
+   * @brief Returns the inverse of a rigid transformation matrix.
+   *
+   * The matrix is assumed to be a rotation followed by a translation, with a
+   * bottom row of [0 0 0 1]. The inverse is the transposed rotation followed by
+   * the translation fixup -transpose(R) * t.
+   * @return A new Mat4 object that is the inverse of this matrix.
+   */
+  Mat4 inverseRigid() const noexcept {
+    Mat4 inv;
+    inv.m[0][0] = m[0][0];
+    inv.m[0][1] = m[1][0];
+    inv.m[0][2] = m[2][0];
+    inv.m[1][0] = m[0][1];
+    inv.m[1][1] = m[1][1];
+    inv.m[1][2] = m[2][1];
+    inv.m[2][0] = m[0][2];
+    inv.m[2][1] = m[1][2];
+    inv.m[2][2] = m[2][2];
+
+    const T tx  = m[0][3];
+    const T ty  = m[1][3];
+    const T tz  = m[2][3];
+    inv.m[0][3] = -(inv.m[0][0] * tx + inv.m[0][1] * ty + inv.m[0][2] * tz);
+    inv.m[1][3] = -(inv.m[1][0] * tx + inv.m[1][1] * ty + inv.m[1][2] * tz);
+    inv.m[2][3] = -(inv.m[2][0] * tx + inv.m[2][1] * ty + inv.m[2][2] * tz);
 
     return inv;
   }
-  // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
 
   /**
    * @brief Multiplies this matrix by another matrix.
    * @param other The matrix to multiply with.
    * @return A new Mat4 object that is the result of the multiplication.
+   * @note Uses the SIMD kernels of Mat4Kernels.hpp for float and double when
+   * the corresponding instruction sets are enabled.
    */
   Mat4 operator*(const Mat4& other) const {
+    LINALG_INSTRUMENT_SCOPE(Mat4Multiply);
     Mat4 result;
-    for(int i = 0; i < 4; ++i) {
-      for(int j = 0; j < 4; ++j) {
-        result.m[i][j] =
-            m[i][0] * other.m[0][j] + m[i][1] * other.m[1][j] + m[i][2] * other.m[2][j] + m[i][3] * other.m[3][j];
-      }
-    }
+    detail::Mat4Kernels<T>::multiply(data(), other.data(), &result.m[0][0]);
     return result;
   }
 
@@ -281,8 +306,8 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Mat4 {
    * 4x4 matrix.
    * @return A Mat3 object representing the top-left 3x3 submatrix.
    */
-  Mat3<T> topLeft3x3() const {
-    return Mat3{{m[0][0], m[0][1], m[0][2]}, {m[1][0], m[1][1], m[1][2]}, {m[2][0], m[2][1], m[2][2]}};
+  constexpr Mat3<T> topLeft3x3() const noexcept {
+    return {m[0][0], m[0][1], m[0][2], m[1][0], m[1][1], m[1][2], m[2][0], m[2][1], m[2][2]};
   }
 
   /**
@@ -293,22 +318,26 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Mat4 {
    * @return True if the matrices are approximately equal, false otherwise.
    * @tparam T The type of the elements in the matrix.
    */
-  bool isApprox(const Mat4& other, T epsilon) const {
-    for(int i = 0; i < 4; ++i) {
-      for(int j = 0; j < 4; ++j) {
-        if(std::abs(m[i][j] - other.m[i][j]) > epsilon) {
-          return false;
-        }
-      }
-    }
-    return true;
+  bool isApprox(const Mat4& other, T epsilon) const noexcept {
+    return detail::allLanes<T, 16>(data(), other.data(), detail::AbsoluteLanes<T>{epsilon});
+  }
+
+  /**
+   * @brief Checks if this matrix is approximately equal to another matrix
+   * element by element with a tolerance policy.
+   * @param other The matrix to compare with.
+   * @param tolerance The absolute and relative tolerance of each element.
+   * @return True if the matrices are approximately equal, false otherwise.
+   */
+  bool isApprox(const Mat4& other, const Tolerance<T>& tolerance = Tolerance<T>::Default()) const noexcept {
+    return detail::allLanes<T, 16>(data(), other.data(), detail::ToleranceLanes<T>{tolerance});
   }
 
   /**
    * @brief Returns the identity matrix.
    * @return A Mat4 object representing the identity matrix.
    */
-  static Mat4 Identity() { return Mat4{}; }
+  static constexpr Mat4 Identity() noexcept { return Mat4{}; }
 
   /**
    * @brief Returns a view matrix that transforms coordinates from world space
@@ -319,33 +348,15 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Mat4 {
    * @return A Mat4 object representing the view matrix.
    * @tparam T The type of the elements in the matrix.
    */
-  static Mat4 LookAt(const Vec3<T>& eye, const Vec3<T>& center, const Vec3<T>& up) {
+  static Mat4 LookAt(const Vec3<T>& eye, const Vec3<T>& center, const Vec3<T>& up) noexcept {
     const Vec3<T> forward   = (center - eye).normalized();
     const Vec3<T> side      = forward.cross(up).normalized();
     const Vec3<T> up_vector = side.cross(forward);
 
-    Mat4 look_at_matrix;
-    look_at_matrix.m[0][0] = side.x;
-    look_at_matrix.m[0][1] = side.y;
-    look_at_matrix.m[0][2] = side.z;
-    look_at_matrix.m[0][3] = -(side.x * eye.x + side.y * eye.y + side.z * eye.z);
-
-    look_at_matrix.m[1][0] = up_vector.x;
-    look_at_matrix.m[1][1] = up_vector.y;
-    look_at_matrix.m[1][2] = up_vector.z;
-    look_at_matrix.m[1][3] = -(up_vector.x * eye.x + up_vector.y * eye.y + up_vector.z * eye.z);
-
-    look_at_matrix.m[2][0] = -forward.x;
-    look_at_matrix.m[2][1] = -forward.y;
-    look_at_matrix.m[2][2] = -forward.z;
-    look_at_matrix.m[2][3] = (forward.x * eye.x + forward.y * eye.y + forward.z * eye.z);
-
-    look_at_matrix.m[3][0] = 0.0;
-    look_at_matrix.m[3][1] = 0.0;
-    look_at_matrix.m[3][2] = 0.0;
-    look_at_matrix.m[3][3] = 1.0;
-
-    return look_at_matrix;
+    return {side.x,      side.y,      side.z,      -(side.x * eye.x + side.y * eye.y + side.z * eye.z),
+            up_vector.x, up_vector.y, up_vector.z, -(up_vector.x * eye.x + up_vector.y * eye.y + up_vector.z * eye.z),
+            -forward.x,  -forward.y,  -forward.z,  (forward.x * eye.x + forward.y * eye.y + forward.z * eye.z),
+            0,           0,           0,           1};
   }
 
   /**
@@ -356,7 +367,7 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Mat4 {
    * @return A Mat4 object representing the view matrix.
    * @tparam T The type of the elements in the matrix.
    */
-  static Mat4 LookAt(const Vec3<T>& eye, const Vec3<T>& center) {
+  static Mat4 LookAt(const Vec3<T>& eye, const Vec3<T>& center) noexcept {
     const Vec3<T> forward = (center - eye).normalized();
 
     const Vec3<T> up_world = std::abs(forward.y) > 0.99 ? Vec3<T>(0.0, 0.0, 1.0) : Vec3<T>(0.0, 1.0, 0.0);
@@ -375,17 +386,9 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Mat4 {
    * @return A Mat4 object representing the orthographic projection matrix.
    * @tparam T The type of the elements in the matrix.
    */
-  static Mat4 Orthographic(T left, T right, T bottom, T top, T near, T far) {
-    Mat4 ortho;
-    ortho.m[0][0] = 2 / (right - left);
-    ortho.m[1][1] = 2 / (top - bottom);
-    ortho.m[2][2] = -2 / (far - near);
-
-    ortho.m[0][3] = -(right + left) / (right - left);
-    ortho.m[1][3] = -(top + bottom) / (top - bottom);
-    ortho.m[2][3] = -(far + near) / (far - near);
-
-    return ortho;
+  static constexpr Mat4 Orthographic(T left, T right, T bottom, T top, T near, T far) noexcept {
+    return {2 / (right - left), 0, 0, -(right + left) / (right - left), 0, 2 / (top - bottom), 0,
+            -(top + bottom) / (top - bottom), 0, 0, -2 / (far - near), -(far + near) / (far - near), 0, 0, 0, 1};
   }
 
   /**
@@ -397,17 +400,10 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Mat4 {
    * @return A Mat4 object representing the perspective projection matrix.
    * @tparam T The type of the elements in the matrix.
    */
-  static Mat4 Perspective(T fov_y, T aspect, T near, T far) {
-    T    inv_tan_half_fov_y = 1.0 / std::tan(fov_y / 2);
-    Mat4 persp;
-    persp.m[0][0] = inv_tan_half_fov_y / aspect;
-    persp.m[1][1] = inv_tan_half_fov_y;
-    persp.m[2][2] = -(far + near) / (far - near);
-    persp.m[2][3] = -(2 * far * near) / (far - near);
-    persp.m[3][2] = -1.0;
-    persp.m[3][3] = 0.0;
-
-    return persp;
+  static Mat4 Perspective(T fov_y, T aspect, T near, T far) noexcept {
+    const T inv_tan_half_fov_y = 1.0 / std::tan(fov_y / 2);
+    return {inv_tan_half_fov_y / aspect, 0, 0, 0, 0, inv_tan_half_fov_y, 0, 0, 0, 0, -(far + near) / (far - near),
+            -(2 * far * near) / (far - near), 0, 0, -1, 0};
   }
 
   /**
@@ -419,11 +415,10 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Mat4 {
    * @return A Mat4 object constructed from the provided rows.
    * @tparam T The type of the elements in the matrix.
    */
-  static Mat4 FromRows(const Vec4<T>& row0, const Vec4<T>& row1, const Vec4<T>& row2, const Vec4<T>& row3) {
-    return Mat4{{{row0.x, row0.y, row0.z, row0.w},
-                 {row1.x, row1.y, row1.z, row1.w},
-                 {row2.x, row2.y, row2.z, row2.w},
-                 {row3.x, row3.y, row3.z, row3.w}}};
+  static constexpr Mat4 FromRows(const Vec4<T>& row0, const Vec4<T>& row1, const Vec4<T>& row2,
+                                 const Vec4<T>& row3) noexcept {
+    return {row0.x, row0.y, row0.z, row0.w, row1.x, row1.y, row1.z, row1.w,
+            row2.x, row2.y, row2.z, row2.w, row3.x, row3.y, row3.z, row3.w};
   }
 
   /**
@@ -435,11 +430,10 @@ template <typename T> struct alignas(linalg::MatAlignment<T, 4>::VALUE) Mat4 {
    * @return A Mat4 object constructed from the provided columns.
    * @tparam T The type of the elements in the matrix.
    */
-  static Mat4 FromColumns(const Vec4<T>& col0, const Vec4<T>& col1, const Vec4<T>& col2, const Vec4<T>& col3) {
-    return Mat4{{{col0.x, col1.x, col2.x, col3.x},
-                 {col0.y, col1.y, col2.y, col3.y},
-                 {col0.z, col1.z, col2.z, col3.z},
-                 {col0.w, col1.w, col2.w, col3.w}}};
+  static constexpr Mat4 FromColumns(const Vec4<T>& col0, const Vec4<T>& col1, const Vec4<T>& col2,
+                                    const Vec4<T>& col3) noexcept {
+    return {col0.x, col1.x, col2.x, col3.x, col0.y, col1.y, col2.y, col3.y,
+            col0.z, col1.z, col2.z, col3.z, col0.w, col1.w, col2.w, col3.w};
   }
 };
 
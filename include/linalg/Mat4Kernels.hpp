@@ -0,0 +1,729 @@
+/**
+ * @file Mat4Kernels.hpp
+ * @brief Low-level kernels operating on row-major 4x4 matrices stored as 16
+ * contiguous elements.
+ *
+ * The generic kernels are plain scalar code. Explicit SIMD specializations are
+ * selected at compile time from the macros of Simd.hpp: SSE or NEON for float
+ * and AVX (with FMA when available) for double. Types or instruction sets without a
+ * specialization fall back to the scalar kernels.
+ */
+#ifndef LINALG_MAT4KERNELS_HPP
+#define LINALG_MAT4KERNELS_HPP
+
+#include <cstddef>
+
+#include "Simd.hpp"
+
+namespace linalg {
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+/**
+ * @brief Selects the homogeneous coordinate used by the array transform
+ * kernels.
+ */
+enum class HomogeneousW {
+  Zero,  ///< Directions: the fourth input element is ignored and taken as 0.
+  One,   ///< Points: the fourth input element is ignored and taken as 1.
+  Input, ///< Full vectors: the fourth input element is used as is.
+};
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+/**
+ * @brief Portable scalar implementation of the 4x4 matrix kernels.
+ * @tparam T The type of the matrix elements.
+ */
+template <typename T> struct Mat4ScalarKernels {
+  /**
+   * @brief Computes out = a * b.
+   * @param a The left-hand side matrix (16 row-major elements).
+   * @param b The right-hand side matrix (16 row-major elements).
+   * @param out The destination matrix, which must not alias a or b.
+   */
+  static void multiply(const T* a, const T* b, T* out) noexcept {
+    for(int i = 0; i < 4; ++i) {
+      const T* row = a + 4 * i;
+      for(int j = 0; j < 4; ++j) {
+        out[4 * i + j] = row[0] * b[j] + row[1] * b[4 + j] + row[2] * b[8 + j] + row[3] * b[12 + j];
+      }
+    }
+  }
+
+  /**
+   * @brief Computes out = m * v for a column vector v.
+   * @param m The matrix (16 row-major elements).
+   * @param v The vector (4 elements).
+   * @param out The destination vector, which must not alias v.
+   */
+  static void transform(const T* m, const T* v, T* out) noexcept {
+    out[0] = m[0] * v[0] + m[1] * v[1] + m[2] * v[2] + m[3] * v[3];
+    out[1] = m[4] * v[0] + m[5] * v[1] + m[6] * v[2] + m[7] * v[3];
+    out[2] = m[8] * v[0] + m[9] * v[1] + m[10] * v[2] + m[11] * v[3];
+    out[3] = m[12] * v[0] + m[13] * v[1] + m[14] * v[2] + m[15] * v[3];
+  }
+
+  /**
+   * @brief Computes the inverse of m by cofactor expansion.
+   * @param m The matrix (16 row-major elements).
+   * @param out The destination matrix, which may alias m.
+   * @return False if the determinant is zero, in which case out is left
+   * unmodified.
+   */
+  static bool inverse(const T* m, T* out) noexcept {
+    T inv[16];
+
+    inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] +
+             m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+
+    inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] -
+             m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+
+    inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] +
+             m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+
+    inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] -
+             m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+
+    inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] -
+             m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+
+    inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] +
+             m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+
+    inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] -
+             m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+
+    inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] +
+             m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+
+    inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] +
+             m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+
+    inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] -
+             m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+
+    inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] +
+              m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+
+    inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] -
+              m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+
+    inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] -
+              m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+
+    inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] +
+              m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+
+    inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] -
+              m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+
+    inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] +
+              m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+    T det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+
+    if(det == T(0)) {
+      return false;
+    }
+
+    det = T(1) / det;
+
+    for(int i = 0; i < 16; ++i) {
+      out[i] = inv[i] * det;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Transforms an array of 4-element records by m.
+   * @tparam W How the fourth element of each input record is interpreted.
+   * @param m The matrix (16 row-major elements).
+   * @param in The input records.
+   * @param out The output records. It may be the same array as in but must not
+   * otherwise overlap it. With HomogeneousW::Zero and HomogeneousW::One the
+   * fourth element of each output record is unspecified.
+   * @param count The number of records.
+   */
+  template <HomogeneousW W> static void transformArray(const T* m, const T* in, T* out, std::size_t count) noexcept {
+    for(std::size_t i = 0; i < count; ++i, in += 4, out += 4) {
+      const T x = in[0];
+      const T y = in[1];
+      const T z = in[2];
+      const T w = W == HomogeneousW::Input ? in[3] : (W == HomogeneousW::One ? T(1) : T(0));
+      out[0]    = m[0] * x + m[1] * y + m[2] * z + m[3] * w;
+      out[1]    = m[4] * x + m[5] * y + m[6] * z + m[7] * w;
+      out[2]    = m[8] * x + m[9] * y + m[10] * z + m[11] * w;
+      out[3]    = m[12] * x + m[13] * y + m[14] * z + m[15] * w;
+    }
+  }
+};
+
+/**
+ * @brief 4x4 matrix kernels used by Mat4, specialized for SIMD where possible.
+ * @tparam T The type of the matrix elements.
+ */
+template <typename T> struct Mat4Kernels : Mat4ScalarKernels<T> {};
+
+#if LINALG_HAS_SSE2
+/**
+ * @brief SSE specialization of the 4x4 kernels for float.
+ *
+ * Each row of the matrix fits in one 128-bit register; the multiply handles two
+ * rows per 256-bit register when AVX is available.
+ */
+template <> struct Mat4Kernels<float> {
+  /**
+   * @brief Computes a * b + c, fused when FMA is available.
+   */
+  static __m128 madd(__m128 a, __m128 b, __m128 c) noexcept {
+#if LINALG_HAS_FMA
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+  }
+
+#if LINALG_HAS_AVX
+  /**
+   * @brief Computes a * b + c on 256-bit registers, fused when FMA is
+   * available.
+   */
+  static __m256 madd(__m256 a, __m256 b, __m256 c) noexcept {
+#if LINALG_HAS_FMA
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+  }
+#endif
+
+#if LINALG_HAS_AVX512F
+  /**
+   * @brief Computes a * b + c on 512-bit registers.
+   */
+  static __m512 madd(__m512 a, __m512 b, __m512 c) noexcept { return _mm512_fmadd_ps(a, b, c); }
+#endif
+
+  /**
+   * @brief Computes out = a * b, each output row being a linear combination of
+   * the rows of b. With AVX two output rows are computed per 256-bit register.
+   */
+  static void multiply(const float* a, const float* b, float* out) noexcept {
+#if LINALG_HAS_AVX
+    const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b));
+    const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+    const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+    const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 12));
+
+    for(int i = 0; i < 2; ++i) {
+      const __m256 rows = _mm256_loadu_ps(a + 8 * i);
+      __m256       r    = _mm256_mul_ps(_mm256_permute_ps(rows, 0x00), b0);
+      r                 = madd(_mm256_permute_ps(rows, 0x55), b1, r);
+      r                 = madd(_mm256_permute_ps(rows, 0xAA), b2, r);
+      r                 = madd(_mm256_permute_ps(rows, 0xFF), b3, r);
+      _mm256_storeu_ps(out + 8 * i, r);
+    }
+#else
+    const __m128 b0 = _mm_loadu_ps(b);
+    const __m128 b1 = _mm_loadu_ps(b + 4);
+    const __m128 b2 = _mm_loadu_ps(b + 8);
+    const __m128 b3 = _mm_loadu_ps(b + 12);
+
+    for(int i = 0; i < 4; ++i) {
+      const float* row = a + 4 * i;
+      __m128       r   = _mm_mul_ps(_mm_set1_ps(row[0]), b0);
+      r                = madd(_mm_set1_ps(row[1]), b1, r);
+      r                = madd(_mm_set1_ps(row[2]), b2, r);
+      r                = madd(_mm_set1_ps(row[3]), b3, r);
+      _mm_storeu_ps(out + 4 * i, r);
+    }
+#endif
+  }
+
+  /**
+   * @brief Computes out = m * v as a linear combination of the columns of m.
+   */
+  static void transform(const float* m, const float* v, float* out) noexcept {
+    __m128 c0 = _mm_loadu_ps(m);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    __m128 r = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+    r        = madd(c1, _mm_set1_ps(v[1]), r);
+    r        = madd(c2, _mm_set1_ps(v[2]), r);
+    r        = madd(c3, _mm_set1_ps(v[3]), r);
+    _mm_storeu_ps(out, r);
+  }
+
+  /**
+   * @brief Multiplies two 2x2 row-major matrices packed in one register.
+   */
+  static __m128 mat2Mul(__m128 a, __m128 b) noexcept {
+    return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+                      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+  }
+
+  /**
+   * @brief Computes adj(a) * b for 2x2 row-major matrices packed in one
+   * register.
+   */
+  static __m128 mat2AdjMul(__m128 a, __m128 b) noexcept {
+    return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+                      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+  }
+
+  /**
+   * @brief Computes a * adj(b) for 2x2 row-major matrices packed in one
+   * register.
+   */
+  static __m128 mat2MulAdj(__m128 a, __m128 b) noexcept {
+    return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+                      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+  }
+
+  /**
+   * @brief Computes the inverse of m with the 2x2 block method.
+   *
+   * The matrix is split into the 2x2 blocks [A B; C D], each held in one
+   * register, and the inverse is assembled from their adjugates.
+   */
+  static bool inverse(const float* m, float* out) noexcept {
+    const __m128 r0 = _mm_loadu_ps(m);
+    const __m128 r1 = _mm_loadu_ps(m + 4);
+    const __m128 r2 = _mm_loadu_ps(m + 8);
+    const __m128 r3 = _mm_loadu_ps(m + 12);
+
+    const __m128 a = _mm_movelh_ps(r0, r1);
+    const __m128 b = _mm_movehl_ps(r1, r0);
+    const __m128 c = _mm_movelh_ps(r2, r3);
+    const __m128 d = _mm_movehl_ps(r3, r2);
+
+    // (|A|, |B|, |C|, |D|)
+    const __m128 det_sub = _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+        _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+    const __m128 det_a = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 det_b = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 det_c = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 det_d = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(3, 3, 3, 3));
+
+    const __m128 d_c = mat2AdjMul(d, c);
+    const __m128 a_b = mat2AdjMul(a, b);
+
+    __m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), mat2Mul(b, d_c));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), mat2Mul(c, a_b));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), mat2MulAdj(d, a_b));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), mat2MulAdj(a, d_c));
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+    __m128 tr = _mm_mul_ps(a_b, _mm_shuffle_ps(d_c, d_c, _MM_SHUFFLE(3, 1, 2, 0)));
+    tr        = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(2, 3, 0, 1)));
+    tr        = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 0, 3, 2)));
+    const __m128 det_m = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), tr);
+
+    if(_mm_cvtss_f32(det_m) == 0.0F) {
+      return false;
+    }
+
+    const __m128 r_det = _mm_div_ps(_mm_setr_ps(1.0F, -1.0F, -1.0F, 1.0F), det_m);
+    x                  = _mm_mul_ps(x, r_det);
+    y                  = _mm_mul_ps(y, r_det);
+    z                  = _mm_mul_ps(z, r_det);
+    w                  = _mm_mul_ps(w, r_det);
+
+    _mm_storeu_ps(out, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(out + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+    _mm_storeu_ps(out + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(out + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+    return true;
+  }
+
+  /**
+   * @brief Transforms one 4-element record held in p by the columns c0-c3.
+   */
+  template <HomogeneousW W>
+  static __m128 transformRecord(__m128 c0, __m128 c1, __m128 c2, __m128 c3, __m128 p) noexcept {
+    __m128 r = W == HomogeneousW::One ? c3 : _mm_setzero_ps();
+    r        = madd(c0, _mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0)), r);
+    r        = madd(c1, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)), r);
+    r        = madd(c2, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2)), r);
+    if(W == HomogeneousW::Input) {
+      r = madd(c3, _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3)), r);
+    }
+    return r;
+  }
+
+#if LINALG_HAS_AVX
+  /**
+   * @brief Transforms the two 4-element records held in p by the columns
+   * c0-c3, each duplicated in both 128-bit lanes.
+   */
+  template <HomogeneousW W>
+  static __m256 transformRecords(__m256 c0, __m256 c1, __m256 c2, __m256 c3, __m256 p) noexcept {
+    __m256 r = W == HomogeneousW::One ? c3 : _mm256_setzero_ps();
+    r        = madd(c0, _mm256_permute_ps(p, 0x00), r);
+    r        = madd(c1, _mm256_permute_ps(p, 0x55), r);
+    r        = madd(c2, _mm256_permute_ps(p, 0xAA), r);
+    if(W == HomogeneousW::Input) {
+      r = madd(c3, _mm256_permute_ps(p, 0xFF), r);
+    }
+    return r;
+  }
+#endif
+
+#if LINALG_HAS_AVX512F
+  /**
+   * @brief Transforms the four 4-element records held in p by the columns
+   * c0-c3, each duplicated in the four 128-bit lanes.
+   */
+  template <HomogeneousW W>
+  static __m512 transformRecords(__m512 c0, __m512 c1, __m512 c2, __m512 c3, __m512 p) noexcept {
+    __m512 r = W == HomogeneousW::One ? c3 : _mm512_setzero_ps();
+    r        = madd(c0, _mm512_permute_ps(p, 0x00), r);
+    r        = madd(c1, _mm512_permute_ps(p, 0x55), r);
+    r        = madd(c2, _mm512_permute_ps(p, 0xAA), r);
+    if(W == HomogeneousW::Input) {
+      r = madd(c3, _mm512_permute_ps(p, 0xFF), r);
+    }
+    return r;
+  }
+#endif
+
+  /**
+   * @brief Transforms an array of 4-element records by m, keeping the columns
+   * of m in registers. With AVX two records are processed per register and
+   * four per iteration, with AVX-512 four per register and eight per
+   * iteration.
+   */
+  template <HomogeneousW W>
+  static void transformArray(const float* m, const float* in, float* out, std::size_t count) noexcept {
+    __m128 c0 = _mm_loadu_ps(m);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    std::size_t i = 0;
+#if LINALG_HAS_AVX512F
+    const __m512 c0x4 = _mm512_broadcast_f32x4(c0);
+    const __m512 c1x4 = _mm512_broadcast_f32x4(c1);
+    const __m512 c2x4 = _mm512_broadcast_f32x4(c2);
+    const __m512 c3x4 = _mm512_broadcast_f32x4(c3);
+    for(; i + 8 <= count; i += 8) {
+      const __m512 p0 = _mm512_loadu_ps(in + 4 * i);
+      const __m512 p1 = _mm512_loadu_ps(in + 4 * i + 16);
+      _mm512_storeu_ps(out + 4 * i, transformRecords<W>(c0x4, c1x4, c2x4, c3x4, p0));
+      _mm512_storeu_ps(out + 4 * i + 16, transformRecords<W>(c0x4, c1x4, c2x4, c3x4, p1));
+    }
+#endif
+#if LINALG_HAS_AVX
+    const __m256 c0x2 = _mm256_insertf128_ps(_mm256_castps128_ps256(c0), c0, 1);
+    const __m256 c1x2 = _mm256_insertf128_ps(_mm256_castps128_ps256(c1), c1, 1);
+    const __m256 c2x2 = _mm256_insertf128_ps(_mm256_castps128_ps256(c2), c2, 1);
+    const __m256 c3x2 = _mm256_insertf128_ps(_mm256_castps128_ps256(c3), c3, 1);
+    for(; i + 4 <= count; i += 4) {
+      const __m256 p01 = _mm256_loadu_ps(in + 4 * i);
+      const __m256 p23 = _mm256_loadu_ps(in + 4 * i + 8);
+      _mm256_storeu_ps(out + 4 * i, transformRecords<W>(c0x2, c1x2, c2x2, c3x2, p01));
+      _mm256_storeu_ps(out + 4 * i + 8, transformRecords<W>(c0x2, c1x2, c2x2, c3x2, p23));
+    }
+#else
+    for(; i + 2 <= count; i += 2) {
+      const __m128 p0 = _mm_loadu_ps(in + 4 * i);
+      const __m128 p1 = _mm_loadu_ps(in + 4 * i + 4);
+      _mm_storeu_ps(out + 4 * i, transformRecord<W>(c0, c1, c2, c3, p0));
+      _mm_storeu_ps(out + 4 * i + 4, transformRecord<W>(c0, c1, c2, c3, p1));
+    }
+#endif
+    for(; i < count; ++i) {
+      _mm_storeu_ps(out + 4 * i, transformRecord<W>(c0, c1, c2, c3, _mm_loadu_ps(in + 4 * i)));
+    }
+  }
+};
+#endif
+
+#if LINALG_HAS_AVX
+/**
+ * @brief AVX specialization of the 4x4 kernels for double.
+ *
+ * Each row of the matrix fits in one 256-bit register.
+ */
+template <> struct Mat4Kernels<double> {
+  /**
+   * @brief Computes a * b + c, fused when FMA is available.
+   */
+  static __m256d madd(__m256d a, __m256d b, __m256d c) noexcept {
+#if LINALG_HAS_FMA
+    return _mm256_fmadd_pd(a, b, c);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+  }
+
+  /**
+   * @brief Transposes four rows held in 256-bit registers in place.
+   */
+  static void transpose(__m256d& r0, __m256d& r1, __m256d& r2, __m256d& r3) noexcept {
+    const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+    r0               = _mm256_permute2f128_pd(t0, t2, 0x20);
+    r1               = _mm256_permute2f128_pd(t1, t3, 0x20);
+    r2               = _mm256_permute2f128_pd(t0, t2, 0x31);
+    r3               = _mm256_permute2f128_pd(t1, t3, 0x31);
+  }
+
+  /**
+   * @brief Computes out = a * b, one output row per iteration as a linear
+   * combination of the rows of b.
+   */
+  static void multiply(const double* a, const double* b, double* out) noexcept {
+    const __m256d b0 = _mm256_loadu_pd(b);
+    const __m256d b1 = _mm256_loadu_pd(b + 4);
+    const __m256d b2 = _mm256_loadu_pd(b + 8);
+    const __m256d b3 = _mm256_loadu_pd(b + 12);
+
+    for(int i = 0; i < 4; ++i) {
+      const double* row = a + 4 * i;
+      __m256d       r   = _mm256_mul_pd(_mm256_broadcast_sd(row), b0);
+      r                 = madd(_mm256_broadcast_sd(row + 1), b1, r);
+      r                 = madd(_mm256_broadcast_sd(row + 2), b2, r);
+      r                 = madd(_mm256_broadcast_sd(row + 3), b3, r);
+      _mm256_storeu_pd(out + 4 * i, r);
+    }
+  }
+
+  /**
+   * @brief Computes out = m * v as a linear combination of the columns of m.
+   */
+  static void transform(const double* m, const double* v, double* out) noexcept {
+    __m256d c0 = _mm256_loadu_pd(m);
+    __m256d c1 = _mm256_loadu_pd(m + 4);
+    __m256d c2 = _mm256_loadu_pd(m + 8);
+    __m256d c3 = _mm256_loadu_pd(m + 12);
+    transpose(c0, c1, c2, c3);
+
+    __m256d r = _mm256_mul_pd(c0, _mm256_broadcast_sd(v));
+    r         = madd(c1, _mm256_broadcast_sd(v + 1), r);
+    r         = madd(c2, _mm256_broadcast_sd(v + 2), r);
+    r         = madd(c3, _mm256_broadcast_sd(v + 3), r);
+    _mm256_storeu_pd(out, r);
+  }
+
+#if LINALG_HAS_AVX2
+  /**
+   * @brief Returns the lanes i0-i3 of v.
+   */
+  template <int I0, int I1, int I2, int I3> static __m256d swizzle(__m256d v) noexcept {
+    return _mm256_permute4x64_pd(v, _MM_SHUFFLE(I3, I2, I1, I0));
+  }
+
+  /**
+   * @brief Multiplies two 2x2 row-major matrices packed in one register.
+   */
+  static __m256d mat2Mul(__m256d a, __m256d b) noexcept {
+    return madd(a, swizzle<0, 3, 0, 3>(b), _mm256_mul_pd(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+  }
+
+  /**
+   * @brief Computes adj(a) * b for 2x2 row-major matrices packed in one
+   * register.
+   */
+  static __m256d mat2AdjMul(__m256d a, __m256d b) noexcept {
+    return _mm256_sub_pd(_mm256_mul_pd(swizzle<3, 3, 0, 0>(a), b),
+                         _mm256_mul_pd(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+  }
+
+  /**
+   * @brief Computes a * adj(b) for 2x2 row-major matrices packed in one
+   * register.
+   */
+  static __m256d mat2MulAdj(__m256d a, __m256d b) noexcept {
+    return _mm256_sub_pd(_mm256_mul_pd(a, swizzle<3, 0, 3, 0>(b)),
+                         _mm256_mul_pd(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+  }
+
+  /**
+   * @brief Computes the inverse of m with the 2x2 block method of the float
+   * kernel, each 2x2 block [A B; C D] being held in one 256-bit register.
+   */
+  static bool inverse(const double* m, double* out) noexcept {
+    const __m256d r0 = _mm256_loadu_pd(m);
+    const __m256d r1 = _mm256_loadu_pd(m + 4);
+    const __m256d r2 = _mm256_loadu_pd(m + 8);
+    const __m256d r3 = _mm256_loadu_pd(m + 12);
+
+    const __m256d a = _mm256_permute2f128_pd(r0, r1, 0x20);
+    const __m256d b = _mm256_permute2f128_pd(r0, r1, 0x31);
+    const __m256d c = _mm256_permute2f128_pd(r2, r3, 0x20);
+    const __m256d d = _mm256_permute2f128_pd(r2, r3, 0x31);
+
+    // (|A|, |B|, |C|, |D|) from the four elements of each block, gathered one
+    // register per element position.
+    const __m256d top     = _mm256_permute2f128_pd(a, c, 0x20);
+    const __m256d top_bd  = _mm256_permute2f128_pd(b, d, 0x20);
+    const __m256d bot     = _mm256_permute2f128_pd(a, c, 0x31);
+    const __m256d bot_bd  = _mm256_permute2f128_pd(b, d, 0x31);
+    const __m256d e0      = _mm256_unpacklo_pd(top, top_bd);
+    const __m256d e1      = _mm256_unpackhi_pd(top, top_bd);
+    const __m256d e2      = _mm256_unpacklo_pd(bot, bot_bd);
+    const __m256d e3      = _mm256_unpackhi_pd(bot, bot_bd);
+    const __m256d det_sub = _mm256_sub_pd(_mm256_mul_pd(e0, e3), _mm256_mul_pd(e1, e2));
+    const __m256d det_a   = swizzle<0, 0, 0, 0>(det_sub);
+    const __m256d det_b   = swizzle<1, 1, 1, 1>(det_sub);
+    const __m256d det_c   = swizzle<2, 2, 2, 2>(det_sub);
+    const __m256d det_d   = swizzle<3, 3, 3, 3>(det_sub);
+
+    const __m256d d_c = mat2AdjMul(d, c);
+    const __m256d a_b = mat2AdjMul(a, b);
+
+    const __m256d x = _mm256_sub_pd(_mm256_mul_pd(det_d, a), mat2Mul(b, d_c));
+    const __m256d w = _mm256_sub_pd(_mm256_mul_pd(det_a, d), mat2Mul(c, a_b));
+    const __m256d y = _mm256_sub_pd(_mm256_mul_pd(det_b, c), mat2MulAdj(d, a_b));
+    const __m256d z = _mm256_sub_pd(_mm256_mul_pd(det_c, b), mat2MulAdj(a, d_c));
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+    __m256d tr = _mm256_mul_pd(a_b, swizzle<0, 2, 1, 3>(d_c));
+    tr         = _mm256_add_pd(tr, swizzle<1, 0, 3, 2>(tr));
+    tr         = _mm256_add_pd(tr, swizzle<2, 3, 0, 1>(tr));
+    const __m256d det_m = _mm256_sub_pd(madd(det_a, det_d, _mm256_mul_pd(det_b, det_c)), tr);
+
+    if(_mm256_cvtsd_f64(det_m) == 0.0) {
+      return false;
+    }
+
+    // The blocks of the inverse are the adjugates of x, y, z and w over |M|.
+    const __m256d r_det = _mm256_div_pd(_mm256_setr_pd(1.0, -1.0, -1.0, 1.0), det_m);
+    const __m256d ix    = _mm256_mul_pd(swizzle<3, 1, 2, 0>(x), r_det);
+    const __m256d iy    = _mm256_mul_pd(swizzle<3, 1, 2, 0>(y), r_det);
+    const __m256d iz    = _mm256_mul_pd(swizzle<3, 1, 2, 0>(z), r_det);
+    const __m256d iw    = _mm256_mul_pd(swizzle<3, 1, 2, 0>(w), r_det);
+
+    _mm256_storeu_pd(out, _mm256_permute2f128_pd(ix, iy, 0x20));
+    _mm256_storeu_pd(out + 4, _mm256_permute2f128_pd(ix, iy, 0x31));
+    _mm256_storeu_pd(out + 8, _mm256_permute2f128_pd(iz, iw, 0x20));
+    _mm256_storeu_pd(out + 12, _mm256_permute2f128_pd(iz, iw, 0x31));
+    return true;
+  }
+#else
+  /**
+   * @brief Computes the inverse of m with the scalar cofactor expansion.
+   */
+  static bool inverse(const double* m, double* out) noexcept { return Mat4ScalarKernels<double>::inverse(m, out); }
+#endif
+
+  /**
+   * @brief Transforms one 4-element record at p by the columns c0-c3.
+   */
+  template <HomogeneousW W>
+  static __m256d transformRecord(__m256d c0, __m256d c1, __m256d c2, __m256d c3, const double* p) noexcept {
+    __m256d r = W == HomogeneousW::One ? c3 : _mm256_setzero_pd();
+    r         = madd(c0, _mm256_broadcast_sd(p), r);
+    r         = madd(c1, _mm256_broadcast_sd(p + 1), r);
+    r         = madd(c2, _mm256_broadcast_sd(p + 2), r);
+    if(W == HomogeneousW::Input) {
+      r = madd(c3, _mm256_broadcast_sd(p + 3), r);
+    }
+    return r;
+  }
+
+  /**
+   * @brief Transforms an array of 4-element records by m, keeping the columns
+   * of m in registers and processing two records per iteration.
+   */
+  template <HomogeneousW W>
+  static void transformArray(const double* m, const double* in, double* out, std::size_t count) noexcept {
+    __m256d c0 = _mm256_loadu_pd(m);
+    __m256d c1 = _mm256_loadu_pd(m + 4);
+    __m256d c2 = _mm256_loadu_pd(m + 8);
+    __m256d c3 = _mm256_loadu_pd(m + 12);
+    transpose(c0, c1, c2, c3);
+
+    std::size_t i = 0;
+    for(; i + 2 <= count; i += 2) {
+      const __m256d r0 = transformRecord<W>(c0, c1, c2, c3, in + 4 * i);
+      const __m256d r1 = transformRecord<W>(c0, c1, c2, c3, in + 4 * i + 4);
+      _mm256_storeu_pd(out + 4 * i, r0);
+      _mm256_storeu_pd(out + 4 * i + 4, r1);
+    }
+    for(; i < count; ++i) {
+      _mm256_storeu_pd(out + 4 * i, transformRecord<W>(c0, c1, c2, c3, in + 4 * i));
+    }
+  }
+};
+#endif
+
+#if LINALG_HAS_NEON
+/**
+ * @brief NEON specialization of the multiply and transform kernels for float.
+ *
+ * Each row of the matrix fits in one 128-bit register. The inverse uses the
+ * scalar kernel.
+ */
+template <> struct Mat4Kernels<float> : Mat4ScalarKernels<float> {
+  /**
+   * @brief Computes out = a * b, each output row being a linear combination of
+   * the rows of b.
+   */
+  static void multiply(const float* a, const float* b, float* out) noexcept {
+    const float32x4_t b0 = vld1q_f32(b);
+    const float32x4_t b1 = vld1q_f32(b + 4);
+    const float32x4_t b2 = vld1q_f32(b + 8);
+    const float32x4_t b3 = vld1q_f32(b + 12);
+
+    for(int i = 0; i < 4; ++i) {
+      const float32x4_t row = vld1q_f32(a + 4 * i);
+      float32x4_t       r   = vmulq_laneq_f32(b0, row, 0);
+      r                     = vfmaq_laneq_f32(r, b1, row, 1);
+      r                     = vfmaq_laneq_f32(r, b2, row, 2);
+      r                     = vfmaq_laneq_f32(r, b3, row, 3);
+      vst1q_f32(out + 4 * i, r);
+    }
+  }
+
+  /**
+   * @brief Computes out = m * v as four row dot products reduced pairwise.
+   */
+  static void transform(const float* m, const float* v, float* out) noexcept {
+    const float32x4_t p  = vld1q_f32(v);
+    const float32x4_t r0 = vmulq_f32(vld1q_f32(m), p);
+    const float32x4_t r1 = vmulq_f32(vld1q_f32(m + 4), p);
+    const float32x4_t r2 = vmulq_f32(vld1q_f32(m + 8), p);
+    const float32x4_t r3 = vmulq_f32(vld1q_f32(m + 12), p);
+    vst1q_f32(out, vpaddq_f32(vpaddq_f32(r0, r1), vpaddq_f32(r2, r3)));
+  }
+
+  /**
+   * @brief Transforms an array of 4-element records by m, keeping the columns
+   * of m in registers.
+   */
+  template <HomogeneousW W>
+  static void transformArray(const float* m, const float* in, float* out, std::size_t count) noexcept {
+    const float32x4x4_t cols = vld4q_f32(m);
+    for(std::size_t i = 0; i < count; ++i) {
+      const float32x4_t p = vld1q_f32(in + 4 * i);
+      float32x4_t       r = W == HomogeneousW::One ? cols.val[3] : vdupq_n_f32(0.0F);
+      r                   = vfmaq_laneq_f32(r, cols.val[0], p, 0);
+      r                   = vfmaq_laneq_f32(r, cols.val[1], p, 1);
+      r                   = vfmaq_laneq_f32(r, cols.val[2], p, 2);
+      if(W == HomogeneousW::Input) {
+        r = vfmaq_laneq_f32(r, cols.val[3], p, 3);
+      }
+      vst1q_f32(out + 4 * i, r);
+    }
+  }
+};
+#endif
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+} // namespace linalg
+
+#endif // LINALG_MAT4KERNELS_HPP
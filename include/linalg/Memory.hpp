@@ -0,0 +1,296 @@
+/**
+ * @file Memory.hpp
+ * @brief Aligned memory allocation helpers.
+ *
+ * Before C++17, std::allocator ignores alignments above that of std::max_align_t,
+ * so std::vector<Mat4d> may hold misaligned matrices. AlignedVector uses
+ * AlignedAllocator to guarantee at least DEFAULT_ALIGNMENT, which covers every
+ * linalg type and SIMD register. MonotonicArena and ArenaVector serve transient
+ * per-frame batches from reused memory instead of the heap.
+ */
+#ifndef LINALG_MEMORY_HPP
+#define LINALG_MEMORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <vector>
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Default alignment of linalg allocations, one cache line.
+ */
+constexpr std::size_t DEFAULT_ALIGNMENT = 64;
+
+/**
+ * @brief Allocates a block of memory with the given alignment.
+ * @param size The size of the block in bytes.
+ * @param alignment The alignment of the block, a power of two.
+ * @return A pointer to the block, to be released with alignedFree().
+ * @throws std::bad_alloc if the allocation fails.
+ */
+inline void* alignedAlloc(std::size_t size, std::size_t alignment) {
+  // The original pointer is stored just before the aligned block, so the block
+  // starts at least one pointer past the start of the allocation.
+  const std::size_t align = alignment < alignof(void*) ? alignof(void*) : alignment;
+  if(size > std::numeric_limits<std::size_t>::max() - align) {
+    throw std::bad_alloc();
+  }
+  void* raw = std::malloc(size + align); // NOLINT(cppcoreguidelines-no-malloc)
+  if(raw == nullptr) {
+    throw std::bad_alloc();
+  }
+  const std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(raw) + align) & ~(std::uintptr_t(align) - 1);
+  void**               block   = reinterpret_cast<void**>(aligned);
+  block[-1]                    = raw;
+  return block;
+}
+
+/**
+ * @brief Releases a block allocated with alignedAlloc().
+ * @param ptr The block to release. Null pointers are ignored.
+ */
+inline void alignedFree(void* ptr) noexcept {
+  if(ptr != nullptr) {
+    std::free(static_cast<void**>(ptr)[-1]); // NOLINT(cppcoreguidelines-no-malloc)
+  }
+}
+
+/**
+ * @brief Standard allocator returning memory aligned to at least Alignment
+ * bytes.
+ * @tparam T The type of the allocated elements.
+ * @tparam Alignment The alignment of the allocations, a power of two.
+ */
+template <typename T, std::size_t Alignment = DEFAULT_ALIGNMENT> struct AlignedAllocator {
+  static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+  static_assert(Alignment >= alignof(T), "Alignment must not be lower than the alignment of T");
+
+  using value_type = T;
+
+  template <typename U> struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  constexpr AlignedAllocator() noexcept = default;
+
+  template <typename U> constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>& /*other*/) noexcept {}
+
+  /**
+   * @brief Allocates uninitialized storage for count elements.
+   * @throws std::bad_alloc if the allocation fails.
+   */
+  T* allocate(std::size_t count) {
+    if(count > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(alignedAlloc(count * sizeof(T), Alignment));
+  }
+
+  /**
+   * @brief Releases storage obtained from allocate().
+   */
+  void deallocate(T* ptr, std::size_t /*count*/) noexcept { alignedFree(ptr); }
+
+  template <typename U> constexpr bool operator==(const AlignedAllocator<U, Alignment>& /*other*/) const noexcept {
+    return true;
+  }
+
+  template <typename U> constexpr bool operator!=(const AlignedAllocator<U, Alignment>& /*other*/) const noexcept {
+    return false;
+  }
+};
+
+/**
+ * @brief std::vector whose storage is aligned to at least Alignment bytes.
+ * @tparam T The type of the elements.
+ * @tparam Alignment The alignment of the storage, a power of two.
+ */
+template <typename T, std::size_t Alignment = DEFAULT_ALIGNMENT>
+using AlignedVector = std::vector<T, AlignedAllocator<T, Alignment>>;
+
+/**
+ * @brief Arena handing out memory by bumping a pointer through large blocks.
+ *
+ * Individual allocations are never freed: reset() makes the whole arena
+ * available again at once, keeping the largest block so that a steady-state
+ * frame allocates nothing from the heap. The arena is not thread-safe.
+ */
+class MonotonicArena {
+public:
+  /**
+   * @brief Constructor.
+   * @param block_size The size of the first block in bytes. Later blocks double
+   * in size, or fit the requested allocation if it is larger.
+   */
+  explicit MonotonicArena(std::size_t block_size = 64 * 1024) noexcept // NOLINT(readability-magic-numbers)
+      : m_next_block_size(block_size < DEFAULT_ALIGNMENT ? DEFAULT_ALIGNMENT : block_size) {}
+
+  MonotonicArena(const MonotonicArena&)            = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  ~MonotonicArena() { release(); }
+
+  /**
+   * @brief Allocates a block of memory with the given alignment.
+   * @param size The size of the block in bytes.
+   * @param alignment The alignment of the block, a power of two.
+   * @return A pointer to the block, valid until reset() or release().
+   * @throws std::bad_alloc if a new block cannot be allocated.
+   */
+  void* allocate(std::size_t size, std::size_t alignment = DEFAULT_ALIGNMENT) {
+    const std::uintptr_t aligned = (m_cursor + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+    if(m_head == nullptr || aligned < m_cursor || aligned > m_end || size > m_end - aligned) {
+      return allocateFromNewBlock(size, alignment);
+    }
+    m_cursor = aligned + size;
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  /**
+   * @brief Makes all the memory of the arena available again. Frees every block
+   * but the largest.
+   */
+  void reset() noexcept {
+    if(m_head == nullptr) {
+      return;
+    }
+    Block* largest = m_head;
+    for(Block* block = m_head->next; block != nullptr; block = block->next) {
+      if(block->size > largest->size) {
+        largest = block;
+      }
+    }
+    for(Block* block = m_head; block != nullptr;) {
+      Block* next = block->next;
+      if(block != largest) {
+        alignedFree(block);
+      }
+      block = next;
+    }
+    largest->next = nullptr;
+    use(largest);
+  }
+
+  /**
+   * @brief Frees every block of the arena.
+   */
+  void release() noexcept {
+    for(Block* block = m_head; block != nullptr;) {
+      Block* next = block->next;
+      alignedFree(block);
+      block = next;
+    }
+    m_head   = nullptr;
+    m_cursor = 0;
+    m_end    = 0;
+  }
+
+  /**
+   * @brief Returns the number of bytes used in the current block.
+   */
+  std::size_t used() const noexcept { return m_head == nullptr ? 0 : m_cursor - begin(m_head); }
+
+  /**
+   * @brief Returns the total size of the blocks owned by the arena.
+   */
+  std::size_t capacity() const noexcept {
+    std::size_t total = 0;
+    for(const Block* block = m_head; block != nullptr; block = block->next) {
+      total += block->size;
+    }
+    return total;
+  }
+
+private:
+  // Header at the start of each block, followed by its usable bytes.
+  struct alignas(DEFAULT_ALIGNMENT) Block {
+    Block*      next;
+    std::size_t size;
+  };
+
+  static std::uintptr_t begin(const Block* block) noexcept { return reinterpret_cast<std::uintptr_t>(block + 1); }
+
+  void use(Block* block) noexcept {
+    m_head   = block;
+    m_cursor = begin(block);
+    m_end    = m_cursor + block->size;
+  }
+
+  void* allocateFromNewBlock(std::size_t size, std::size_t alignment) {
+    const std::size_t padding = alignment > DEFAULT_ALIGNMENT ? alignment : 0;
+    if(size > std::numeric_limits<std::size_t>::max() - sizeof(Block) - padding) {
+      throw std::bad_alloc();
+    }
+    std::size_t block_size = m_next_block_size;
+    if(block_size < size + padding) {
+      block_size = size + padding;
+    }
+    void*  raw   = alignedAlloc(sizeof(Block) + block_size, DEFAULT_ALIGNMENT);
+    Block* block = new(raw) Block{m_head, block_size};
+    use(block);
+    m_next_block_size = block_size * 2;
+    return allocate(size, alignment);
+  }
+
+  Block*         m_head   = nullptr;
+  std::uintptr_t m_cursor = 0;
+  std::uintptr_t m_end    = 0;
+  std::size_t    m_next_block_size;
+};
+
+/**
+ * @brief Standard allocator serving memory from a MonotonicArena.
+ *
+ * deallocate() is a no-op: the memory is reclaimed by MonotonicArena::reset().
+ * @tparam T The type of the allocated elements.
+ */
+template <typename T> struct ArenaAllocator {
+  using value_type = T;
+
+  template <typename U> struct rebind {
+    using other = ArenaAllocator<U>;
+  };
+
+  MonotonicArena* arena;
+
+  explicit ArenaAllocator(MonotonicArena& arena) noexcept : arena(&arena) {}
+
+  template <typename U> ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+  /**
+   * @brief Allocates uninitialized storage for count elements, aligned to at
+   * least DEFAULT_ALIGNMENT.
+   * @throws std::bad_alloc if the allocation fails.
+   */
+  T* allocate(std::size_t count) {
+    if(count > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_alloc();
+    }
+    const std::size_t alignment = alignof(T) > DEFAULT_ALIGNMENT ? alignof(T) : DEFAULT_ALIGNMENT;
+    return static_cast<T*>(arena->allocate(count * sizeof(T), alignment));
+  }
+
+  void deallocate(T* /*ptr*/, std::size_t /*count*/) noexcept {}
+
+  template <typename U> bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.arena; }
+
+  template <typename U> bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.arena; }
+};
+
+/**
+ * @brief std::vector allocating from a MonotonicArena, for transient batches.
+ * @tparam T The type of the elements.
+ */
+template <typename T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace linalg
+
+#endif // LINALG_MEMORY_HPP
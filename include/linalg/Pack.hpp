@@ -0,0 +1,940 @@
+/**
+ * @file Pack.hpp
+ * @brief Fixed-width SIMD packs of float or double lanes.
+ *
+ * Pack<T, N> holds N lanes of T. The generic template stores the lanes in a
+ * plain array and works for any width; Pack<float, 4> and Pack<double, 2> are
+ * specialized with SSE or NEON, Pack<float, 8> and Pack<double, 4> with AVX,
+ * Pack<float, 16> and Pack<double, 8> with AVX-512, when the corresponding
+ * instruction set is enabled. NativePack<T> is the widest specialized pack for
+ * T.
+ *
+ * Comparisons return a Pack<T, N>::Mask, which is consumed by select(), any(),
+ * all() and bits().
+ */
+#ifndef LINALG_PACK_HPP
+#define LINALG_PACK_HPP
+
+#include <cmath>
+#include <limits>
+
+#include "Simd.hpp"
+
+namespace linalg {
+namespace simd {
+inline namespace LINALG_SIMD_ABI {
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+/**
+ * @brief Generic pack of N lanes of T, implemented with scalar loops.
+ * @tparam T The type of the lanes.
+ * @tparam N The number of lanes.
+ */
+template <typename T, int N> struct Pack {
+  static constexpr int WIDTH = N;
+
+  /**
+   * @brief Per-lane boolean mask.
+   */
+  struct Mask {
+    static constexpr int WIDTH = N;
+
+    bool v[N];
+
+    /**
+     * @brief Returns the mask as an integer with bit i set when lane i is set.
+     */
+    int bits() const noexcept {
+      int r = 0;
+      for(int i = 0; i < N; ++i) {
+        r |= v[i] ? (1 << i) : 0;
+      }
+      return r;
+    }
+
+    Mask operator&(const Mask& other) const noexcept {
+      Mask r;
+      for(int i = 0; i < N; ++i) {
+        r.v[i] = v[i] && other.v[i];
+      }
+      return r;
+    }
+
+    Mask operator|(const Mask& other) const noexcept {
+      Mask r;
+      for(int i = 0; i < N; ++i) {
+        r.v[i] = v[i] || other.v[i];
+      }
+      return r;
+    }
+  };
+
+  T v[N];
+
+  /**
+   * @brief Loads N consecutive elements from memory (no alignment required).
+   */
+  static Pack load(const T* ptr) noexcept {
+    Pack r;
+    for(int i = 0; i < N; ++i) {
+      r.v[i] = ptr[i];
+    }
+    return r;
+  }
+
+  /**
+   * @brief Returns a pack with every lane set to value.
+   */
+  static Pack broadcast(T value) noexcept {
+    Pack r;
+    for(int i = 0; i < N; ++i) {
+      r.v[i] = value;
+    }
+    return r;
+  }
+
+  /**
+   * @brief Stores the N lanes to memory (no alignment required).
+   */
+  void store(T* ptr) const noexcept {
+    for(int i = 0; i < N; ++i) {
+      ptr[i] = v[i];
+    }
+  }
+
+  /**
+   * @brief Returns the value of one lane.
+   */
+  T lane(int index) const noexcept { return v[index]; }
+
+#define LINALG_PACK_BINARY_OP(OP)                                                                                      \
+  Pack operator OP(const Pack& other) const noexcept {                                                                 \
+    Pack r;                                                                                                            \
+    for(int i = 0; i < N; ++i) {                                                                                       \
+      r.v[i] = v[i] OP other.v[i];                                                                                     \
+    }                                                                                                                  \
+    return r;                                                                                                          \
+  }
+#define LINALG_PACK_COMPARE_OP(OP)                                                                                     \
+  Mask operator OP(const Pack& other) const noexcept {                                                                 \
+    Mask r;                                                                                                            \
+    for(int i = 0; i < N; ++i) {                                                                                       \
+      r.v[i] = v[i] OP other.v[i];                                                                                     \
+    }                                                                                                                  \
+    return r;                                                                                                          \
+  }
+
+  LINALG_PACK_BINARY_OP(+)
+  LINALG_PACK_BINARY_OP(-)
+  LINALG_PACK_BINARY_OP(*)
+  LINALG_PACK_BINARY_OP(/)
+  LINALG_PACK_COMPARE_OP(<)
+  LINALG_PACK_COMPARE_OP(<=)
+  LINALG_PACK_COMPARE_OP(>)
+  LINALG_PACK_COMPARE_OP(>=)
+  LINALG_PACK_COMPARE_OP(==)
+  LINALG_PACK_COMPARE_OP(!=)
+
+#undef LINALG_PACK_BINARY_OP
+#undef LINALG_PACK_COMPARE_OP
+
+  Pack operator-() const noexcept {
+    Pack r;
+    for(int i = 0; i < N; ++i) {
+      r.v[i] = -v[i];
+    }
+    return r;
+  }
+};
+
+/**
+ * @brief Lane-wise minimum. If either lane is NaN the lane of b is returned.
+ */
+template <typename T, int N> inline Pack<T, N> min(const Pack<T, N>& a, const Pack<T, N>& b) noexcept {
+  Pack<T, N> r;
+  for(int i = 0; i < N; ++i) {
+    r.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+  }
+  return r;
+}
+
+/**
+ * @brief Lane-wise maximum. If either lane is NaN the lane of b is returned.
+ */
+template <typename T, int N> inline Pack<T, N> max(const Pack<T, N>& a, const Pack<T, N>& b) noexcept {
+  Pack<T, N> r;
+  for(int i = 0; i < N; ++i) {
+    r.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i];
+  }
+  return r;
+}
+
+/**
+ * @brief Lane-wise square root.
+ */
+template <typename T, int N> inline Pack<T, N> sqrt(const Pack<T, N>& a) noexcept {
+  Pack<T, N> r;
+  for(int i = 0; i < N; ++i) {
+    r.v[i] = std::sqrt(a.v[i]);
+  }
+  return r;
+}
+
+/**
+ * @brief Approximate reciprocal square root of a float: the hardware estimate
+ * (rsqrtss, or vrsqrte on NEON) refined by Newton-Raphson, with a relative error
+ * of at most RSQRT_FAST_MAX_ULP units in the last place for normal positive
+ * inputs. Other inputs give unspecified results. Without SSE or NEON it is
+ * 1 / std::sqrt(x).
+ */
+inline float rsqrtFast(float x) noexcept {
+#if LINALG_HAS_SSE2
+  const float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+  // One Newton-Raphson step: y * (1.5 - 0.5 * x * y * y).
+  return y * (1.5F - 0.5F * x * y * y);
+#elif LINALG_HAS_NEON
+  float y = vrsqrtes_f32(x);
+  y *= vrsqrtss_f32(x * y, y);
+  return y * vrsqrtss_f32(x * y, y);
+#else
+  return 1 / std::sqrt(x);
+#endif
+}
+
+/**
+ * @brief Reciprocal square root of a double. There is no fast estimate for
+ * scalar doubles, so this is 1 / std::sqrt(x).
+ */
+inline double rsqrtFast(double x) noexcept { return 1 / std::sqrt(x); }
+
+/**
+ * @brief Bound on the error of the float rsqrtFast(), in units in the last
+ * place of the exact result. It follows from the documented accuracy of the
+ * estimates (2^-12 relative for rsqrtps); Intel implementations measure 4.
+ */
+constexpr int RSQRT_FAST_MAX_ULP = 7;
+
+/**
+ * @brief Returns true for the inputs on which rsqrtFast() meets its accuracy
+ * bound: positive, normal and finite values.
+ */
+template <typename T> inline bool rsqrtFastInRange(T x) noexcept {
+  return x >= std::numeric_limits<T>::min() && x <= std::numeric_limits<T>::max();
+}
+
+/**
+ * @brief Lane-wise approximate reciprocal square root, with the accuracy of
+ * rsqrtFast(float) for float lanes. Double lanes use 1 / sqrt except with
+ * AVX-512, whose estimate is refined to within RSQRT_FAST_MAX_ULP as well.
+ */
+template <typename T, int N> inline Pack<T, N> rsqrtFast(const Pack<T, N>& a) noexcept {
+  return Pack<T, N>::broadcast(T(1)) / sqrt(a);
+}
+
+/**
+ * @brief Lane-wise absolute value.
+ */
+template <typename T, int N> inline Pack<T, N> abs(const Pack<T, N>& a) noexcept {
+  Pack<T, N> r;
+  for(int i = 0; i < N; ++i) {
+    r.v[i] = std::fabs(a.v[i]);
+  }
+  return r;
+}
+
+/**
+ * @brief Computes a * b + c, fused when the instruction set allows it.
+ */
+template <typename T, int N>
+inline Pack<T, N> madd(const Pack<T, N>& a, const Pack<T, N>& b, const Pack<T, N>& c) noexcept {
+  return a * b + c;
+}
+
+/**
+ * @brief Picks the lanes of a where mask is set and the lanes of b elsewhere.
+ */
+template <typename T, int N>
+inline Pack<T, N> select(const typename Pack<T, N>::Mask& mask, const Pack<T, N>& a, const Pack<T, N>& b) noexcept {
+  Pack<T, N> r;
+  for(int i = 0; i < N; ++i) {
+    r.v[i] = mask.v[i] ? a.v[i] : b.v[i];
+  }
+  return r;
+}
+
+/**
+ * @brief Lane-wise minimum ignoring NaN, as std::fmin: a NaN lane of one input
+ * gives the lane of the other.
+ */
+template <typename T, int N> inline Pack<T, N> fmin(const Pack<T, N>& a, const Pack<T, N>& b) noexcept {
+  return select(b != b, a, min(a, b));
+}
+
+/**
+ * @brief Lane-wise maximum ignoring NaN, as std::fmax.
+ */
+template <typename T, int N> inline Pack<T, N> fmax(const Pack<T, N>& a, const Pack<T, N>& b) noexcept {
+  return select(b != b, a, max(a, b));
+}
+
+/**
+ * @brief Returns the sum of all lanes.
+ */
+template <typename T, int N> inline T hsum(const Pack<T, N>& a) noexcept {
+  T r = a.v[0];
+  for(int i = 1; i < N; ++i) {
+    r += a.v[i];
+  }
+  return r;
+}
+
+/**
+ * @brief Returns the minimum of all lanes.
+ */
+template <typename T, int N> inline T hmin(const Pack<T, N>& a) noexcept {
+  T r = a.v[0];
+  for(int i = 1; i < N; ++i) {
+    r = a.v[i] < r ? a.v[i] : r;
+  }
+  return r;
+}
+
+/**
+ * @brief Returns the maximum of all lanes.
+ */
+template <typename T, int N> inline T hmax(const Pack<T, N>& a) noexcept {
+  T r = a.v[0];
+  for(int i = 1; i < N; ++i) {
+    r = a.v[i] > r ? a.v[i] : r;
+  }
+  return r;
+}
+
+/**
+ * @brief Transposes the 4x4 blocks formed by the matching groups of four
+ * consecutive lanes of a, b, c and d: after the call lane j of group g of the
+ * k-th pack holds what was lane k of group g of the j-th pack. With four-lane
+ * packs this is a plain 4x4 transpose, turning four (x, y, z, w) records into
+ * one pack per component.
+ * @tparam N The number of lanes, a multiple of four.
+ */
+template <typename T, int N>
+inline void transpose4(Pack<T, N>& a, Pack<T, N>& b, Pack<T, N>& c, Pack<T, N>& d) noexcept {
+  static_assert(N % 4 == 0, "transpose4 requires groups of four lanes");
+  Pack<T, N>* rows[4] = {&a, &b, &c, &d};
+  for(int g = 0; g < N; g += 4) {
+    for(int j = 0; j < 4; ++j) {
+      for(int k = j + 1; k < 4; ++k) {
+        const T tmp       = rows[j]->v[g + k];
+        rows[j]->v[g + k] = rows[k]->v[g + j];
+        rows[k]->v[g + j] = tmp;
+      }
+    }
+  }
+}
+
+#define LINALG_PACK_SIMD_OPS(PACK, SCALAR, REG, PFX, SFX, CMP)                                                         \
+  static constexpr int WIDTH = static_cast<int>(sizeof(REG) / sizeof(SCALAR));                                         \
+                                                                                                                       \
+  struct Mask {                                                                                                        \
+    static constexpr int WIDTH = static_cast<int>(sizeof(REG) / sizeof(SCALAR));                                       \
+    REG                  v;                                                                                            \
+    int                  bits() const noexcept { return PFX##_movemask_##SFX(v); }                                     \
+    Mask operator&(const Mask& other) const noexcept { return {PFX##_and_##SFX(v, other.v)}; }                         \
+    Mask operator|(const Mask& other) const noexcept { return {PFX##_or_##SFX(v, other.v)}; }                          \
+  };                                                                                                                   \
+                                                                                                                       \
+  REG v;                                                                                                               \
+                                                                                                                       \
+  static PACK load(const SCALAR* ptr) noexcept { return {PFX##_loadu_##SFX(ptr)}; }                                    \
+  static PACK broadcast(SCALAR value) noexcept { return {PFX##_set1_##SFX(value)}; }                                   \
+  void        store(SCALAR* ptr) const noexcept { PFX##_storeu_##SFX(ptr, v); }                                        \
+  SCALAR      lane(int index) const noexcept {                                                                         \
+    SCALAR tmp[WIDTH];                                                                                                 \
+    store(tmp);                                                                                                        \
+    return tmp[index];                                                                                                 \
+  }                                                                                                                    \
+                                                                                                                       \
+  PACK operator+(const PACK& other) const noexcept { return {PFX##_add_##SFX(v, other.v)}; }                           \
+  PACK operator-(const PACK& other) const noexcept { return {PFX##_sub_##SFX(v, other.v)}; }                           \
+  PACK operator*(const PACK& other) const noexcept { return {PFX##_mul_##SFX(v, other.v)}; }                           \
+  PACK operator/(const PACK& other) const noexcept { return {PFX##_div_##SFX(v, other.v)}; }                           \
+  PACK operator-() const noexcept { return {PFX##_xor_##SFX(v, PFX##_set1_##SFX(SCALAR(-0.0)))}; }                     \
+  Mask operator<(const PACK& other) const noexcept { return {CMP(v, other.v, LT)}; }                                   \
+  Mask operator<=(const PACK& other) const noexcept { return {CMP(v, other.v, LE)}; }                                  \
+  Mask operator>(const PACK& other) const noexcept { return {CMP(other.v, v, LT)}; }                                   \
+  Mask operator>=(const PACK& other) const noexcept { return {CMP(other.v, v, LE)}; }                                  \
+  Mask operator==(const PACK& other) const noexcept { return {CMP(v, other.v, EQ)}; }                                  \
+  Mask operator!=(const PACK& other) const noexcept { return {CMP(v, other.v, NEQ)}; }
+
+#if LINALG_HAS_AVX
+#define LINALG_PACK_CMP_SSE_PS(A, B, OP) _mm_cmp_ps(A, B, LINALG_PACK_CMP_##OP)
+#define LINALG_PACK_CMP_SSE_PD(A, B, OP) _mm_cmp_pd(A, B, LINALG_PACK_CMP_##OP)
+#define LINALG_PACK_CMP_AVX_PS(A, B, OP) _mm256_cmp_ps(A, B, LINALG_PACK_CMP_##OP)
+#define LINALG_PACK_CMP_AVX_PD(A, B, OP) _mm256_cmp_pd(A, B, LINALG_PACK_CMP_##OP)
+#define LINALG_PACK_CMP_LT _CMP_LT_OQ
+#define LINALG_PACK_CMP_LE _CMP_LE_OQ
+#define LINALG_PACK_CMP_EQ _CMP_EQ_OQ
+#define LINALG_PACK_CMP_NEQ _CMP_NEQ_UQ
+#elif LINALG_HAS_SSE2
+#define LINALG_PACK_CMP_SSE_PS(A, B, OP) LINALG_PACK_CMP_SSE_PS_##OP(A, B)
+#define LINALG_PACK_CMP_SSE_PD(A, B, OP) LINALG_PACK_CMP_SSE_PD_##OP(A, B)
+#define LINALG_PACK_CMP_SSE_PS_LT(A, B) _mm_cmplt_ps(A, B)
+#define LINALG_PACK_CMP_SSE_PS_LE(A, B) _mm_cmple_ps(A, B)
+#define LINALG_PACK_CMP_SSE_PS_EQ(A, B) _mm_cmpeq_ps(A, B)
+#define LINALG_PACK_CMP_SSE_PS_NEQ(A, B) _mm_cmpneq_ps(A, B)
+#define LINALG_PACK_CMP_SSE_PD_LT(A, B) _mm_cmplt_pd(A, B)
+#define LINALG_PACK_CMP_SSE_PD_LE(A, B) _mm_cmple_pd(A, B)
+#define LINALG_PACK_CMP_SSE_PD_EQ(A, B) _mm_cmpeq_pd(A, B)
+#define LINALG_PACK_CMP_SSE_PD_NEQ(A, B) _mm_cmpneq_pd(A, B)
+#endif
+
+#if LINALG_HAS_SSE2
+/**
+ * @brief SSE pack of four float lanes.
+ */
+template <> struct Pack<float, 4> {
+  LINALG_PACK_SIMD_OPS(Pack, float, __m128, _mm, ps, LINALG_PACK_CMP_SSE_PS)
+};
+
+/**
+ * @brief SSE2 pack of two double lanes.
+ */
+template <> struct Pack<double, 2> {
+  LINALG_PACK_SIMD_OPS(Pack, double, __m128d, _mm, pd, LINALG_PACK_CMP_SSE_PD)
+};
+
+inline Pack<float, 4> min(const Pack<float, 4>& a, const Pack<float, 4>& b) noexcept { return {_mm_min_ps(a.v, b.v)}; }
+inline Pack<float, 4> max(const Pack<float, 4>& a, const Pack<float, 4>& b) noexcept { return {_mm_max_ps(a.v, b.v)}; }
+inline Pack<float, 4> sqrt(const Pack<float, 4>& a) noexcept { return {_mm_sqrt_ps(a.v)}; }
+inline Pack<float, 4> rsqrtFast(const Pack<float, 4>& a) noexcept {
+  const __m128 y = _mm_rsqrt_ps(a.v);
+  const __m128 h = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5F), a.v), y);
+  return {_mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5F), _mm_mul_ps(h, y)))};
+}
+inline Pack<float, 4> abs(const Pack<float, 4>& a) noexcept { return {_mm_andnot_ps(_mm_set1_ps(-0.0F), a.v)}; }
+
+inline Pack<double, 2> min(const Pack<double, 2>& a, const Pack<double, 2>& b) noexcept {
+  return {_mm_min_pd(a.v, b.v)};
+}
+inline Pack<double, 2> max(const Pack<double, 2>& a, const Pack<double, 2>& b) noexcept {
+  return {_mm_max_pd(a.v, b.v)};
+}
+inline Pack<double, 2> sqrt(const Pack<double, 2>& a) noexcept { return {_mm_sqrt_pd(a.v)}; }
+inline Pack<double, 2> abs(const Pack<double, 2>& a) noexcept { return {_mm_andnot_pd(_mm_set1_pd(-0.0), a.v)}; }
+
+inline Pack<float, 4> madd(const Pack<float, 4>& a, const Pack<float, 4>& b, const Pack<float, 4>& c) noexcept {
+#if LINALG_HAS_FMA
+  return {_mm_fmadd_ps(a.v, b.v, c.v)};
+#else
+  return {_mm_add_ps(_mm_mul_ps(a.v, b.v), c.v)};
+#endif
+}
+
+inline Pack<double, 2> madd(const Pack<double, 2>& a, const Pack<double, 2>& b, const Pack<double, 2>& c) noexcept {
+#if LINALG_HAS_FMA
+  return {_mm_fmadd_pd(a.v, b.v, c.v)};
+#else
+  return {_mm_add_pd(_mm_mul_pd(a.v, b.v), c.v)};
+#endif
+}
+
+inline Pack<float, 4> select(const Pack<float, 4>::Mask& mask, const Pack<float, 4>& a,
+                             const Pack<float, 4>& b) noexcept {
+#if LINALG_HAS_SSE41
+  return {_mm_blendv_ps(b.v, a.v, mask.v)};
+#else
+  return {_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v))};
+#endif
+}
+
+inline Pack<double, 2> select(const Pack<double, 2>::Mask& mask, const Pack<double, 2>& a,
+                              const Pack<double, 2>& b) noexcept {
+#if LINALG_HAS_SSE41
+  return {_mm_blendv_pd(b.v, a.v, mask.v)};
+#else
+  return {_mm_or_pd(_mm_and_pd(mask.v, a.v), _mm_andnot_pd(mask.v, b.v))};
+#endif
+}
+
+inline float hsum(const Pack<float, 4>& a) noexcept {
+  const __m128 t = _mm_add_ps(a.v, _mm_movehl_ps(a.v, a.v));
+  return _mm_cvtss_f32(_mm_add_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+}
+
+inline float hmin(const Pack<float, 4>& a) noexcept {
+  const __m128 t = _mm_min_ps(a.v, _mm_movehl_ps(a.v, a.v));
+  return _mm_cvtss_f32(_mm_min_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+}
+
+inline float hmax(const Pack<float, 4>& a) noexcept {
+  const __m128 t = _mm_max_ps(a.v, _mm_movehl_ps(a.v, a.v));
+  return _mm_cvtss_f32(_mm_max_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+}
+
+inline double hsum(const Pack<double, 2>& a) noexcept {
+  return _mm_cvtsd_f64(_mm_add_sd(a.v, _mm_unpackhi_pd(a.v, a.v)));
+}
+
+inline double hmin(const Pack<double, 2>& a) noexcept {
+  return _mm_cvtsd_f64(_mm_min_sd(a.v, _mm_unpackhi_pd(a.v, a.v)));
+}
+
+inline double hmax(const Pack<double, 2>& a) noexcept {
+  return _mm_cvtsd_f64(_mm_max_sd(a.v, _mm_unpackhi_pd(a.v, a.v)));
+}
+inline void transpose4(Pack<float, 4>& a, Pack<float, 4>& b, Pack<float, 4>& c, Pack<float, 4>& d) noexcept {
+  _MM_TRANSPOSE4_PS(a.v, b.v, c.v, d.v);
+}
+#endif
+
+#if LINALG_HAS_AVX
+/**
+ * @brief AVX pack of eight float lanes.
+ */
+template <> struct Pack<float, 8> {
+  LINALG_PACK_SIMD_OPS(Pack, float, __m256, _mm256, ps, LINALG_PACK_CMP_AVX_PS)
+};
+
+/**
+ * @brief AVX pack of four double lanes.
+ */
+template <> struct Pack<double, 4> {
+  LINALG_PACK_SIMD_OPS(Pack, double, __m256d, _mm256, pd, LINALG_PACK_CMP_AVX_PD)
+};
+
+inline Pack<float, 8> min(const Pack<float, 8>& a, const Pack<float, 8>& b) noexcept {
+  return {_mm256_min_ps(a.v, b.v)};
+}
+inline Pack<float, 8> max(const Pack<float, 8>& a, const Pack<float, 8>& b) noexcept {
+  return {_mm256_max_ps(a.v, b.v)};
+}
+inline Pack<float, 8> sqrt(const Pack<float, 8>& a) noexcept { return {_mm256_sqrt_ps(a.v)}; }
+inline Pack<float, 8> rsqrtFast(const Pack<float, 8>& a) noexcept {
+  const __m256 y = _mm256_rsqrt_ps(a.v);
+  const __m256 h = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5F), a.v), y);
+  return {_mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5F), _mm256_mul_ps(h, y)))};
+}
+inline Pack<float, 8> abs(const Pack<float, 8>& a) noexcept { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0F), a.v)}; }
+
+inline Pack<double, 4> min(const Pack<double, 4>& a, const Pack<double, 4>& b) noexcept {
+  return {_mm256_min_pd(a.v, b.v)};
+}
+inline Pack<double, 4> max(const Pack<double, 4>& a, const Pack<double, 4>& b) noexcept {
+  return {_mm256_max_pd(a.v, b.v)};
+}
+inline Pack<double, 4> sqrt(const Pack<double, 4>& a) noexcept { return {_mm256_sqrt_pd(a.v)}; }
+inline Pack<double, 4> abs(const Pack<double, 4>& a) noexcept { return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)}; }
+
+inline Pack<float, 8> madd(const Pack<float, 8>& a, const Pack<float, 8>& b, const Pack<float, 8>& c) noexcept {
+#if LINALG_HAS_FMA
+  return {_mm256_fmadd_ps(a.v, b.v, c.v)};
+#else
+  return {_mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v)};
+#endif
+}
+
+inline Pack<double, 4> madd(const Pack<double, 4>& a, const Pack<double, 4>& b, const Pack<double, 4>& c) noexcept {
+#if LINALG_HAS_FMA
+  return {_mm256_fmadd_pd(a.v, b.v, c.v)};
+#else
+  return {_mm256_add_pd(_mm256_mul_pd(a.v, b.v), c.v)};
+#endif
+}
+
+inline Pack<float, 8> select(const Pack<float, 8>::Mask& mask, const Pack<float, 8>& a,
+                             const Pack<float, 8>& b) noexcept {
+  return {_mm256_blendv_ps(b.v, a.v, mask.v)};
+}
+
+inline Pack<double, 4> select(const Pack<double, 4>::Mask& mask, const Pack<double, 4>& a,
+                              const Pack<double, 4>& b) noexcept {
+  return {_mm256_blendv_pd(b.v, a.v, mask.v)};
+}
+
+inline float hsum(const Pack<float, 8>& a) noexcept {
+  return hsum(Pack<float, 4>{_mm_add_ps(_mm256_castps256_ps128(a.v), _mm256_extractf128_ps(a.v, 1))});
+}
+
+inline float hmin(const Pack<float, 8>& a) noexcept {
+  return hmin(Pack<float, 4>{_mm_min_ps(_mm256_castps256_ps128(a.v), _mm256_extractf128_ps(a.v, 1))});
+}
+
+inline float hmax(const Pack<float, 8>& a) noexcept {
+  return hmax(Pack<float, 4>{_mm_max_ps(_mm256_castps256_ps128(a.v), _mm256_extractf128_ps(a.v, 1))});
+}
+
+inline double hsum(const Pack<double, 4>& a) noexcept {
+  return hsum(Pack<double, 2>{_mm_add_pd(_mm256_castpd256_pd128(a.v), _mm256_extractf128_pd(a.v, 1))});
+}
+
+inline double hmin(const Pack<double, 4>& a) noexcept {
+  return hmin(Pack<double, 2>{_mm_min_pd(_mm256_castpd256_pd128(a.v), _mm256_extractf128_pd(a.v, 1))});
+}
+
+inline double hmax(const Pack<double, 4>& a) noexcept {
+  return hmax(Pack<double, 2>{_mm_max_pd(_mm256_castpd256_pd128(a.v), _mm256_extractf128_pd(a.v, 1))});
+}
+/**
+ * @brief Transposes the two 4x4 blocks held in the 128-bit halves of a-d, with
+ * the in-lane unpack and shuffle sequence of _MM_TRANSPOSE4_PS.
+ */
+inline void transpose4(Pack<float, 8>& a, Pack<float, 8>& b, Pack<float, 8>& c, Pack<float, 8>& d) noexcept {
+  const __m256 t0 = _mm256_unpacklo_ps(a.v, b.v);
+  const __m256 t1 = _mm256_unpacklo_ps(c.v, d.v);
+  const __m256 t2 = _mm256_unpackhi_ps(a.v, b.v);
+  const __m256 t3 = _mm256_unpackhi_ps(c.v, d.v);
+  a.v             = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+  b.v             = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+  c.v             = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  d.v             = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+inline void transpose4(Pack<double, 4>& a, Pack<double, 4>& b, Pack<double, 4>& c, Pack<double, 4>& d) noexcept {
+  const __m256d t0 = _mm256_unpacklo_pd(a.v, b.v);
+  const __m256d t1 = _mm256_unpackhi_pd(a.v, b.v);
+  const __m256d t2 = _mm256_unpacklo_pd(c.v, d.v);
+  const __m256d t3 = _mm256_unpackhi_pd(c.v, d.v);
+  a.v              = _mm256_permute2f128_pd(t0, t2, 0x20);
+  b.v              = _mm256_permute2f128_pd(t1, t3, 0x20);
+  c.v              = _mm256_permute2f128_pd(t0, t2, 0x31);
+  d.v              = _mm256_permute2f128_pd(t1, t3, 0x31);
+}
+#endif
+
+#if LINALG_HAS_AVX512F
+#define LINALG_PACK_AVX512_OPS(PACK, SCALAR, REG, MASK, SFX)                                                           \
+  static constexpr int WIDTH = static_cast<int>(sizeof(REG) / sizeof(SCALAR));                                         \
+                                                                                                                       \
+  struct Mask {                                                                                                        \
+    static constexpr int WIDTH = static_cast<int>(sizeof(REG) / sizeof(SCALAR));                                       \
+    MASK                 v;                                                                                            \
+    int                  bits() const noexcept { return static_cast<int>(v); }                                         \
+    Mask operator&(const Mask& other) const noexcept { return {static_cast<MASK>(v & other.v)}; }                      \
+    Mask operator|(const Mask& other) const noexcept { return {static_cast<MASK>(v | other.v)}; }                      \
+  };                                                                                                                   \
+                                                                                                                       \
+  REG v;                                                                                                               \
+                                                                                                                       \
+  static PACK load(const SCALAR* ptr) noexcept { return {_mm512_loadu_##SFX(ptr)}; }                                   \
+  static PACK broadcast(SCALAR value) noexcept { return {_mm512_set1_##SFX(value)}; }                                  \
+  void        store(SCALAR* ptr) const noexcept { _mm512_storeu_##SFX(ptr, v); }                                       \
+  SCALAR      lane(int index) const noexcept {                                                                         \
+    SCALAR tmp[WIDTH];                                                                                                 \
+    store(tmp);                                                                                                        \
+    return tmp[index];                                                                                                 \
+  }                                                                                                                    \
+                                                                                                                       \
+  PACK operator+(const PACK& other) const noexcept { return {_mm512_add_##SFX(v, other.v)}; }                          \
+  PACK operator-(const PACK& other) const noexcept { return {_mm512_sub_##SFX(v, other.v)}; }                          \
+  PACK operator*(const PACK& other) const noexcept { return {_mm512_mul_##SFX(v, other.v)}; }                          \
+  PACK operator/(const PACK& other) const noexcept { return {_mm512_div_##SFX(v, other.v)}; }                          \
+  PACK operator-() const noexcept {                                                                                    \
+    return {_mm512_castsi512_##SFX(                                                                                    \
+        _mm512_xor_si512(_mm512_cast##SFX##_si512(v), _mm512_cast##SFX##_si512(_mm512_set1_##SFX(SCALAR(-0.0)))))};    \
+  }                                                                                                                    \
+  Mask operator<(const PACK& other) const noexcept { return {_mm512_cmp_##SFX##_mask(v, other.v, _CMP_LT_OQ)}; }       \
+  Mask operator<=(const PACK& other) const noexcept { return {_mm512_cmp_##SFX##_mask(v, other.v, _CMP_LE_OQ)}; }      \
+  Mask operator>(const PACK& other) const noexcept { return {_mm512_cmp_##SFX##_mask(other.v, v, _CMP_LT_OQ)}; }       \
+  Mask operator>=(const PACK& other) const noexcept { return {_mm512_cmp_##SFX##_mask(other.v, v, _CMP_LE_OQ)}; }      \
+  Mask operator==(const PACK& other) const noexcept { return {_mm512_cmp_##SFX##_mask(v, other.v, _CMP_EQ_OQ)}; }      \
+  Mask operator!=(const PACK& other) const noexcept { return {_mm512_cmp_##SFX##_mask(v, other.v, _CMP_NEQ_UQ)}; }
+
+/**
+ * @brief AVX-512 pack of sixteen float lanes. Masks are AVX-512 mask registers.
+ */
+template <> struct Pack<float, 16> {
+  LINALG_PACK_AVX512_OPS(Pack, float, __m512, __mmask16, ps)
+};
+
+/**
+ * @brief AVX-512 pack of eight double lanes.
+ */
+template <> struct Pack<double, 8> {
+  LINALG_PACK_AVX512_OPS(Pack, double, __m512d, __mmask8, pd)
+};
+
+#undef LINALG_PACK_AVX512_OPS
+
+inline Pack<float, 16> min(const Pack<float, 16>& a, const Pack<float, 16>& b) noexcept {
+  return {_mm512_min_ps(a.v, b.v)};
+}
+inline Pack<float, 16> max(const Pack<float, 16>& a, const Pack<float, 16>& b) noexcept {
+  return {_mm512_max_ps(a.v, b.v)};
+}
+inline Pack<float, 16> sqrt(const Pack<float, 16>& a) noexcept { return {_mm512_sqrt_ps(a.v)}; }
+inline Pack<float, 16> rsqrtFast(const Pack<float, 16>& a) noexcept {
+  const __m512 y = _mm512_rsqrt14_ps(a.v);
+  const __m512 h = _mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(0.5F), a.v), y);
+  return {_mm512_mul_ps(y, _mm512_fnmadd_ps(h, y, _mm512_set1_ps(1.5F)))};
+}
+inline Pack<float, 16> abs(const Pack<float, 16>& a) noexcept { return {_mm512_abs_ps(a.v)}; }
+
+inline Pack<double, 8> min(const Pack<double, 8>& a, const Pack<double, 8>& b) noexcept {
+  return {_mm512_min_pd(a.v, b.v)};
+}
+inline Pack<double, 8> max(const Pack<double, 8>& a, const Pack<double, 8>& b) noexcept {
+  return {_mm512_max_pd(a.v, b.v)};
+}
+inline Pack<double, 8> sqrt(const Pack<double, 8>& a) noexcept { return {_mm512_sqrt_pd(a.v)}; }
+inline Pack<double, 8> rsqrtFast(const Pack<double, 8>& a) noexcept {
+  // The 14-bit estimate needs two steps to reach double precision.
+  const __m512d half = _mm512_mul_pd(_mm512_set1_pd(0.5), a.v);
+  __m512d       y    = _mm512_rsqrt14_pd(a.v);
+  y                  = _mm512_mul_pd(y, _mm512_fnmadd_pd(_mm512_mul_pd(half, y), y, _mm512_set1_pd(1.5)));
+  return {_mm512_mul_pd(y, _mm512_fnmadd_pd(_mm512_mul_pd(half, y), y, _mm512_set1_pd(1.5)))};
+}
+inline Pack<double, 8> abs(const Pack<double, 8>& a) noexcept { return {_mm512_abs_pd(a.v)}; }
+
+inline Pack<float, 16> madd(const Pack<float, 16>& a, const Pack<float, 16>& b, const Pack<float, 16>& c) noexcept {
+  return {_mm512_fmadd_ps(a.v, b.v, c.v)};
+}
+
+inline Pack<double, 8> madd(const Pack<double, 8>& a, const Pack<double, 8>& b, const Pack<double, 8>& c) noexcept {
+  return {_mm512_fmadd_pd(a.v, b.v, c.v)};
+}
+
+inline Pack<float, 16> select(const Pack<float, 16>::Mask& mask, const Pack<float, 16>& a,
+                              const Pack<float, 16>& b) noexcept {
+  return {_mm512_mask_blend_ps(mask.v, b.v, a.v)};
+}
+
+inline Pack<double, 8> select(const Pack<double, 8>::Mask& mask, const Pack<double, 8>& a,
+                              const Pack<double, 8>& b) noexcept {
+  return {_mm512_mask_blend_pd(mask.v, b.v, a.v)};
+}
+
+inline float hsum(const Pack<float, 16>& a) noexcept { return _mm512_reduce_add_ps(a.v); }
+inline float hmin(const Pack<float, 16>& a) noexcept { return _mm512_reduce_min_ps(a.v); }
+inline float hmax(const Pack<float, 16>& a) noexcept { return _mm512_reduce_max_ps(a.v); }
+
+inline double hsum(const Pack<double, 8>& a) noexcept { return _mm512_reduce_add_pd(a.v); }
+inline double hmin(const Pack<double, 8>& a) noexcept { return _mm512_reduce_min_pd(a.v); }
+inline double hmax(const Pack<double, 8>& a) noexcept { return _mm512_reduce_max_pd(a.v); }
+inline void transpose4(Pack<float, 16>& a, Pack<float, 16>& b, Pack<float, 16>& c, Pack<float, 16>& d) noexcept {
+  const __m512 t0 = _mm512_unpacklo_ps(a.v, b.v);
+  const __m512 t1 = _mm512_unpacklo_ps(c.v, d.v);
+  const __m512 t2 = _mm512_unpackhi_ps(a.v, b.v);
+  const __m512 t3 = _mm512_unpackhi_ps(c.v, d.v);
+  a.v             = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+  b.v             = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+  c.v             = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  d.v             = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+/**
+ * @brief Transposes the two 4x4 blocks held in the 256-bit halves of a-d. The
+ * 128-bit blocks are regrouped by two shuffles since _mm512_shuffle_f64x2 takes
+ * its low half from the first operand only.
+ */
+inline void transpose4(Pack<double, 8>& a, Pack<double, 8>& b, Pack<double, 8>& c, Pack<double, 8>& d) noexcept {
+  const __m512d t0 = _mm512_unpacklo_pd(a.v, b.v);
+  const __m512d t1 = _mm512_unpackhi_pd(a.v, b.v);
+  const __m512d t2 = _mm512_unpacklo_pd(c.v, d.v);
+  const __m512d t3 = _mm512_unpackhi_pd(c.v, d.v);
+  const __m512d lo0 = _mm512_shuffle_f64x2(t0, t2, _MM_SHUFFLE(2, 0, 2, 0));
+  const __m512d lo1 = _mm512_shuffle_f64x2(t1, t3, _MM_SHUFFLE(2, 0, 2, 0));
+  const __m512d hi0 = _mm512_shuffle_f64x2(t0, t2, _MM_SHUFFLE(3, 1, 3, 1));
+  const __m512d hi1 = _mm512_shuffle_f64x2(t1, t3, _MM_SHUFFLE(3, 1, 3, 1));
+  a.v               = _mm512_shuffle_f64x2(lo0, lo0, _MM_SHUFFLE(3, 1, 2, 0));
+  b.v               = _mm512_shuffle_f64x2(lo1, lo1, _MM_SHUFFLE(3, 1, 2, 0));
+  c.v               = _mm512_shuffle_f64x2(hi0, hi0, _MM_SHUFFLE(3, 1, 2, 0));
+  d.v               = _mm512_shuffle_f64x2(hi1, hi1, _MM_SHUFFLE(3, 1, 2, 0));
+}
+#endif
+
+#if LINALG_HAS_NEON
+/**
+ * @brief NEON pack of four float lanes.
+ */
+template <> struct Pack<float, 4> {
+  static constexpr int WIDTH = 4;
+
+  struct Mask {
+    static constexpr int WIDTH = 4;
+    uint32x4_t           v;
+    int                  bits() const noexcept {
+      const uint32_t weights[4] = {1, 2, 4, 8};
+      return static_cast<int>(vaddvq_u32(vandq_u32(v, vld1q_u32(weights))));
+    }
+    Mask operator&(const Mask& other) const noexcept { return {vandq_u32(v, other.v)}; }
+    Mask operator|(const Mask& other) const noexcept { return {vorrq_u32(v, other.v)}; }
+  };
+
+  float32x4_t v;
+
+  static Pack load(const float* ptr) noexcept { return {vld1q_f32(ptr)}; }
+  static Pack broadcast(float value) noexcept { return {vdupq_n_f32(value)}; }
+  void        store(float* ptr) const noexcept { vst1q_f32(ptr, v); }
+  float       lane(int index) const noexcept {
+    float tmp[WIDTH];
+    store(tmp);
+    return tmp[index];
+  }
+
+  Pack operator+(const Pack& other) const noexcept { return {vaddq_f32(v, other.v)}; }
+  Pack operator-(const Pack& other) const noexcept { return {vsubq_f32(v, other.v)}; }
+  Pack operator*(const Pack& other) const noexcept { return {vmulq_f32(v, other.v)}; }
+  Pack operator/(const Pack& other) const noexcept { return {vdivq_f32(v, other.v)}; }
+  Pack operator-() const noexcept { return {vnegq_f32(v)}; }
+  Mask operator<(const Pack& other) const noexcept { return {vcltq_f32(v, other.v)}; }
+  Mask operator<=(const Pack& other) const noexcept { return {vcleq_f32(v, other.v)}; }
+  Mask operator>(const Pack& other) const noexcept { return {vcgtq_f32(v, other.v)}; }
+  Mask operator>=(const Pack& other) const noexcept { return {vcgeq_f32(v, other.v)}; }
+  Mask operator==(const Pack& other) const noexcept { return {vceqq_f32(v, other.v)}; }
+  Mask operator!=(const Pack& other) const noexcept { return {vmvnq_u32(vceqq_f32(v, other.v))}; }
+};
+
+/**
+ * @brief NEON pack of two double lanes.
+ */
+template <> struct Pack<double, 2> {
+  static constexpr int WIDTH = 2;
+
+  struct Mask {
+    static constexpr int WIDTH = 2;
+    uint64x2_t           v;
+    int                  bits() const noexcept {
+      const uint64_t weights[2] = {1, 2};
+      return static_cast<int>(vaddvq_u64(vandq_u64(v, vld1q_u64(weights))));
+    }
+    Mask operator&(const Mask& other) const noexcept { return {vandq_u64(v, other.v)}; }
+    Mask operator|(const Mask& other) const noexcept { return {vorrq_u64(v, other.v)}; }
+  };
+
+  float64x2_t v;
+
+  static Pack load(const double* ptr) noexcept { return {vld1q_f64(ptr)}; }
+  static Pack broadcast(double value) noexcept { return {vdupq_n_f64(value)}; }
+  void        store(double* ptr) const noexcept { vst1q_f64(ptr, v); }
+  double      lane(int index) const noexcept {
+    double tmp[WIDTH];
+    store(tmp);
+    return tmp[index];
+  }
+
+  Pack operator+(const Pack& other) const noexcept { return {vaddq_f64(v, other.v)}; }
+  Pack operator-(const Pack& other) const noexcept { return {vsubq_f64(v, other.v)}; }
+  Pack operator*(const Pack& other) const noexcept { return {vmulq_f64(v, other.v)}; }
+  Pack operator/(const Pack& other) const noexcept { return {vdivq_f64(v, other.v)}; }
+  Pack operator-() const noexcept { return {vnegq_f64(v)}; }
+  Mask operator<(const Pack& other) const noexcept { return {vcltq_f64(v, other.v)}; }
+  Mask operator<=(const Pack& other) const noexcept { return {vcleq_f64(v, other.v)}; }
+  Mask operator>(const Pack& other) const noexcept { return {vcgtq_f64(v, other.v)}; }
+  Mask operator>=(const Pack& other) const noexcept { return {vcgeq_f64(v, other.v)}; }
+  Mask operator==(const Pack& other) const noexcept { return {vceqq_f64(v, other.v)}; }
+  Mask operator!=(const Pack& other) const noexcept {
+    return {vreinterpretq_u64_u32(vmvnq_u32(vreinterpretq_u32_u64(vceqq_f64(v, other.v))))};
+  }
+};
+
+// min and max are written as comparisons so NaN lanes pick b, as documented
+// for the generic pack; vminq/vmaxq would propagate the NaN instead.
+inline Pack<float, 4> min(const Pack<float, 4>& a, const Pack<float, 4>& b) noexcept {
+  return {vbslq_f32(vcltq_f32(a.v, b.v), a.v, b.v)};
+}
+inline Pack<float, 4> max(const Pack<float, 4>& a, const Pack<float, 4>& b) noexcept {
+  return {vbslq_f32(vcgtq_f32(a.v, b.v), a.v, b.v)};
+}
+inline Pack<float, 4> sqrt(const Pack<float, 4>& a) noexcept { return {vsqrtq_f32(a.v)}; }
+inline Pack<float, 4> rsqrtFast(const Pack<float, 4>& a) noexcept {
+  float32x4_t y = vrsqrteq_f32(a.v);
+  y             = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a.v, y), y));
+  return {vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a.v, y), y))};
+}
+inline Pack<float, 4> abs(const Pack<float, 4>& a) noexcept { return {vabsq_f32(a.v)}; }
+
+inline Pack<double, 2> min(const Pack<double, 2>& a, const Pack<double, 2>& b) noexcept {
+  return {vbslq_f64(vcltq_f64(a.v, b.v), a.v, b.v)};
+}
+inline Pack<double, 2> max(const Pack<double, 2>& a, const Pack<double, 2>& b) noexcept {
+  return {vbslq_f64(vcgtq_f64(a.v, b.v), a.v, b.v)};
+}
+inline Pack<double, 2> sqrt(const Pack<double, 2>& a) noexcept { return {vsqrtq_f64(a.v)}; }
+inline Pack<double, 2> abs(const Pack<double, 2>& a) noexcept { return {vabsq_f64(a.v)}; }
+
+inline Pack<float, 4> madd(const Pack<float, 4>& a, const Pack<float, 4>& b, const Pack<float, 4>& c) noexcept {
+  return {vfmaq_f32(c.v, a.v, b.v)};
+}
+
+inline Pack<double, 2> madd(const Pack<double, 2>& a, const Pack<double, 2>& b, const Pack<double, 2>& c) noexcept {
+  return {vfmaq_f64(c.v, a.v, b.v)};
+}
+
+inline Pack<float, 4> select(const Pack<float, 4>::Mask& mask, const Pack<float, 4>& a,
+                             const Pack<float, 4>& b) noexcept {
+  return {vbslq_f32(mask.v, a.v, b.v)};
+}
+
+inline Pack<double, 2> select(const Pack<double, 2>::Mask& mask, const Pack<double, 2>& a,
+                              const Pack<double, 2>& b) noexcept {
+  return {vbslq_f64(mask.v, a.v, b.v)};
+}
+
+inline float hsum(const Pack<float, 4>& a) noexcept { return vaddvq_f32(a.v); }
+inline float hmin(const Pack<float, 4>& a) noexcept { return vminvq_f32(a.v); }
+inline float hmax(const Pack<float, 4>& a) noexcept { return vmaxvq_f32(a.v); }
+
+inline double hsum(const Pack<double, 2>& a) noexcept { return vaddvq_f64(a.v); }
+inline double hmin(const Pack<double, 2>& a) noexcept { return vminvq_f64(a.v); }
+inline double hmax(const Pack<double, 2>& a) noexcept { return vmaxvq_f64(a.v); }
+
+inline void transpose4(Pack<float, 4>& a, Pack<float, 4>& b, Pack<float, 4>& c, Pack<float, 4>& d) noexcept {
+  const float32x4_t t0 = vtrn1q_f32(a.v, b.v);
+  const float32x4_t t1 = vtrn2q_f32(a.v, b.v);
+  const float32x4_t t2 = vtrn1q_f32(c.v, d.v);
+  const float32x4_t t3 = vtrn2q_f32(c.v, d.v);
+  a.v = vreinterpretq_f32_f64(vtrn1q_f64(vreinterpretq_f64_f32(t0), vreinterpretq_f64_f32(t2)));
+  b.v = vreinterpretq_f32_f64(vtrn1q_f64(vreinterpretq_f64_f32(t1), vreinterpretq_f64_f32(t3)));
+  c.v = vreinterpretq_f32_f64(vtrn2q_f64(vreinterpretq_f64_f32(t0), vreinterpretq_f64_f32(t2)));
+  d.v = vreinterpretq_f32_f64(vtrn2q_f64(vreinterpretq_f64_f32(t1), vreinterpretq_f64_f32(t3)));
+}
+#endif
+
+#undef LINALG_PACK_SIMD_OPS
+
+/**
+ * @brief Returns the mask as an integer with bit i set when lane i is set.
+ */
+template <typename M> inline int bits(const M& mask) noexcept { return mask.bits(); }
+
+/**
+ * @brief Returns true if any lane of the mask is set.
+ */
+template <typename M> inline bool any(const M& mask) noexcept { return mask.bits() != 0; }
+
+/**
+ * @brief Returns true if every lane of the mask is set.
+ */
+template <typename M> inline bool all(const M& mask) noexcept { return mask.bits() == (1 << M::WIDTH) - 1; }
+
+/**
+ * @struct NativeWidth
+ * @brief Number of lanes of the widest specialized pack for T.
+ * @tparam T The type of the lanes.
+ */
+template <typename T> struct NativeWidth {
+  static constexpr int VALUE = 4;
+};
+
+template <> struct NativeWidth<float> {
+  static constexpr int VALUE = LINALG_HAS_AVX512F ? 16 : (LINALG_HAS_AVX ? 8 : 4);
+};
+
+template <> struct NativeWidth<double> {
+  static constexpr int VALUE = LINALG_HAS_AVX512F ? 8 : (LINALG_HAS_AVX ? 4 : 2);
+};
+
+/**
+ * @brief The widest specialized pack for T.
+ */
+template <typename T> using NativePack = Pack<T, NativeWidth<T>::VALUE>;
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+} // namespace LINALG_SIMD_ABI
+} // namespace simd
+} // namespace linalg
+
+#endif // LINALG_PACK_HPP
@@ -0,0 +1,358 @@
+/**
+ * @file Packed.hpp
+ * @brief Unpadded storage types for vectors and matrices.
+ *
+ * The compute types (Vec3, Mat3, ...) are over-aligned for SIMD, which pads
+ * Vec3<double> to 32 bytes and Mat3<float> to 48 bytes. The packed types hold
+ * the same elements with no padding and the alignment of T, so arrays of them
+ * take exactly N * sizeof(T) bytes per element and can be copied as raw bytes
+ * to GPU or file buffers. Convert to the compute types with load() and back
+ * with store(), or in bulk with pack() and unpack().
+ */
+#ifndef LINALG_PACKED_HPP
+#define LINALG_PACKED_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "Mat3.hpp"
+#include "Mat4.hpp"
+#include "Simd.hpp"
+#include "Vec2.hpp"
+#include "Vec3.hpp"
+#include "Vec4.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Unpadded storage for a Vec2.
+ * @tparam T The type of the vector elements (e.g., float, double).
+ * @note The default constructor leaves the elements uninitialized so that large
+ * arrays are cheap to allocate; use PackedVec2{} for zero.
+ */
+template <typename T> struct PackedVec2 {
+  T x;
+  T y;
+
+  PackedVec2() = default;
+
+  /**
+   * @brief Constructor that initializes the vector with specific x and y
+   * values.
+   */
+  constexpr PackedVec2(T x, T y) noexcept : x(x), y(y) {}
+
+  /**
+   * @brief Constructor that packs a Vec2.
+   * @param v The vector to store.
+   */
+  explicit constexpr PackedVec2(const Vec2<T>& v) noexcept : x(v.x), y(v.y) {}
+
+  /**
+   * @brief Returns the stored vector as a Vec2.
+   */
+  constexpr Vec2<T> load() const noexcept { return {x, y}; }
+
+  /**
+   * @brief Stores a Vec2.
+   * @param v The vector to store.
+   */
+  void store(const Vec2<T>& v) noexcept {
+    x = v.x;
+    y = v.y;
+  }
+};
+
+/**
+ * @brief Unpadded storage for a Vec3.
+ * @tparam T The type of the vector elements (e.g., float, double).
+ * @note The default constructor leaves the elements uninitialized so that large
+ * arrays are cheap to allocate; use PackedVec3{} for zero.
+ */
+template <typename T> struct PackedVec3 {
+  T x;
+  T y;
+  T z;
+
+  PackedVec3() = default;
+
+  /**
+   * @brief Constructor that initializes the vector with specific x, y, and z
+   * values.
+   */
+  constexpr PackedVec3(T x, T y, T z) noexcept : x(x), y(y), z(z) {}
+
+  /**
+   * @brief Constructor that packs a Vec3.
+   * @param v The vector to store.
+   */
+  explicit constexpr PackedVec3(const Vec3<T>& v) noexcept : x(v.x), y(v.y), z(v.z) {}
+
+  /**
+   * @brief Returns the stored vector as a Vec3.
+   */
+  constexpr Vec3<T> load() const noexcept { return {x, y, z}; }
+
+  /**
+   * @brief Stores a Vec3.
+   * @param v The vector to store.
+   */
+  void store(const Vec3<T>& v) noexcept {
+    x = v.x;
+    y = v.y;
+    z = v.z;
+  }
+};
+
+/**
+ * @brief Storage for a Vec4 with the alignment of T instead of the SIMD
+ * alignment.
+ * @tparam T The type of the vector elements (e.g., float, double).
+ * @note The default constructor leaves the elements uninitialized so that large
+ * arrays are cheap to allocate; use PackedVec4{} for zero.
+ */
+template <typename T> struct PackedVec4 {
+  T x;
+  T y;
+  T z;
+  T w;
+
+  PackedVec4() = default;
+
+  /**
+   * @brief Constructor that initializes the vector with specific x, y, z, and w
+   * values.
+   */
+  constexpr PackedVec4(T x, T y, T z, T w) noexcept : x(x), y(y), z(z), w(w) {}
+
+  /**
+   * @brief Constructor that packs a Vec4.
+   * @param v The vector to store.
+   */
+  explicit constexpr PackedVec4(const Vec4<T>& v) noexcept : x(v.x), y(v.y), z(v.z), w(v.w) {}
+
+  /**
+   * @brief Returns the stored vector as a Vec4.
+   */
+  constexpr Vec4<T> load() const noexcept { return {x, y, z, w}; }
+
+  /**
+   * @brief Stores a Vec4.
+   * @param v The vector to store.
+   */
+  void store(const Vec4<T>& v) noexcept {
+    x = v.x;
+    y = v.y;
+    z = v.z;
+    w = v.w;
+  }
+};
+
+/**
+ * @brief Unpadded storage for a Mat3 (row-major).
+ * @tparam T The type of the matrix elements (e.g., float, double).
+ * @note The default constructor leaves the elements uninitialized so that large
+ * arrays are cheap to allocate.
+ */
+template <typename T> struct PackedMat3 {
+  std::array<std::array<T, 3>, 3> m;
+
+  PackedMat3() = default;
+
+  /**
+   * @brief Constructor that packs a Mat3.
+   * @param mat The matrix to store.
+   */
+  explicit PackedMat3(const Mat3<T>& mat) noexcept { store(mat); }
+
+  /**
+   * @brief Returns the stored matrix as a Mat3.
+   */
+  Mat3<T> load() const noexcept {
+    Mat3<T> mat;
+    std::memcpy(&mat.m[0][0], &m[0][0], sizeof(m));
+    return mat;
+  }
+
+  /**
+   * @brief Stores a Mat3.
+   * @param mat The matrix to store.
+   */
+  void store(const Mat3<T>& mat) noexcept { std::memcpy(&m[0][0], mat.data(), sizeof(m)); }
+};
+
+/**
+ * @brief Storage for a Mat4 (row-major) with the alignment of T instead of the
+ * SIMD alignment.
+ * @tparam T The type of the matrix elements (e.g., float, double).
+ * @note The default constructor leaves the elements uninitialized so that large
+ * arrays are cheap to allocate.
+ */
+template <typename T> struct PackedMat4 {
+  std::array<std::array<T, 4>, 4> m;
+
+  PackedMat4() = default;
+
+  /**
+   * @brief Constructor that packs a Mat4.
+   * @param mat The matrix to store.
+   */
+  explicit PackedMat4(const Mat4<T>& mat) noexcept { store(mat); }
+
+  /**
+   * @brief Returns the stored matrix as a Mat4.
+   */
+  Mat4<T> load() const noexcept {
+    Mat4<T> mat;
+    std::memcpy(&mat.m[0][0], &m[0][0], sizeof(m));
+    return mat;
+  }
+
+  /**
+   * @brief Stores a Mat4.
+   * @param mat The matrix to store.
+   */
+  void store(const Mat4<T>& mat) noexcept { std::memcpy(&m[0][0], mat.data(), sizeof(m)); }
+};
+
+// The packed layouts are part of the API: they are copied as raw bytes.
+static_assert(sizeof(PackedVec2<float>) == 8 && sizeof(PackedVec2<double>) == 16, "PackedVec2 must not be padded");
+static_assert(sizeof(PackedVec3<float>) == 12 && sizeof(PackedVec3<double>) == 24, "PackedVec3 must not be padded");
+static_assert(sizeof(PackedVec4<float>) == 16 && sizeof(PackedVec4<double>) == 32, "PackedVec4 must not be padded");
+static_assert(sizeof(PackedMat3<float>) == 36 && sizeof(PackedMat3<double>) == 72, "PackedMat3 must not be padded");
+static_assert(sizeof(PackedMat4<float>) == 64 && sizeof(PackedMat4<double>) == 128, "PackedMat4 must not be padded");
+static_assert(std::is_trivial<PackedVec3<float>>::value && std::is_trivial<PackedMat3<float>>::value,
+              "Packed types must be trivial");
+
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+/**
+ * @brief Converts arrays between a compute type and its packed counterpart,
+ * one element at a time.
+ */
+template <typename T, typename Packed> struct PackKernels {
+  static void pack(const T* in, Packed* out, std::size_t count) noexcept {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = Packed(in[i]);
+    }
+  }
+
+  static void unpack(const Packed* in, T* out, std::size_t count) noexcept {
+    for(std::size_t i = 0; i < count; ++i) {
+      out[i] = in[i].load();
+    }
+  }
+};
+
+#if LINALG_HAS_SSE2
+/**
+ * @brief Vec3<float> conversions moving four vectors (three registers of
+ * packed data) per iteration.
+ */
+template <> struct PackKernels<Vec3<float>, PackedVec3<float>> {
+  static void pack(const Vec3<float>* in, PackedVec3<float>* out, std::size_t count) noexcept {
+    const float* src = &in[0].x;
+    float*       dst = &out[0].x;
+    std::size_t  i   = 0;
+    for(; i + 4 <= count; i += 4) {
+      const __m128 a = _mm_load_ps(src);
+      const __m128 b = _mm_load_ps(src + 4);
+      const __m128 c = _mm_load_ps(src + 8);
+      const __m128 d = _mm_load_ps(src + 12);
+      // a0 a1 a2 b0 | b1 b2 c0 c1 | c2 d0 d1 d2
+      const __m128 ab = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 2, 2));
+      const __m128 cd = _mm_shuffle_ps(c, d, _MM_SHUFFLE(0, 0, 2, 2));
+      _mm_storeu_ps(dst, _mm_shuffle_ps(a, ab, _MM_SHUFFLE(2, 0, 1, 0)));
+      _mm_storeu_ps(dst + 4, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 2, 1)));
+      _mm_storeu_ps(dst + 8, _mm_shuffle_ps(cd, d, _MM_SHUFFLE(2, 1, 2, 0)));
+      src += 16;
+      dst += 12;
+    }
+    for(; i < count; ++i) {
+      out[i] = PackedVec3<float>(in[i]);
+    }
+  }
+
+  static void unpack(const PackedVec3<float>* in, Vec3<float>* out, std::size_t count) noexcept {
+    const float* src = &in[0].x;
+    float*       dst = &out[0].x;
+    std::size_t  i   = 0;
+    for(; i + 4 <= count; i += 4) {
+      const __m128 p0 = _mm_loadu_ps(src);
+      const __m128 p1 = _mm_loadu_ps(src + 4);
+      const __m128 p2 = _mm_loadu_ps(src + 8);
+      // The fourth lane of each output lands in the padding of Vec3.
+      const __m128 b  = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 0, 3, 3));
+      _mm_store_ps(dst, p0);
+      _mm_store_ps(dst + 4, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 2, 1)));
+      _mm_store_ps(dst + 8, _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(0, 0, 3, 2)));
+      _mm_store_ps(dst + 12, _mm_shuffle_ps(p2, p2, _MM_SHUFFLE(3, 3, 2, 1)));
+      src += 12;
+      dst += 16;
+    }
+    for(; i < count; ++i) {
+      out[i] = in[i].load();
+    }
+  }
+};
+#endif
+
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+
+/**
+ * @brief Packs an array of compute vectors or matrices into their unpadded
+ * storage type.
+ * @param in The input array.
+ * @param out The output array. It must not overlap in.
+ * @param count The number of elements.
+ */
+template <typename T> inline void pack(const Vec2<T>* in, PackedVec2<T>* out, std::size_t count) noexcept {
+  detail::PackKernels<Vec2<T>, PackedVec2<T>>::pack(in, out, count);
+}
+template <typename T> inline void pack(const Vec3<T>* in, PackedVec3<T>* out, std::size_t count) noexcept {
+  detail::PackKernels<Vec3<T>, PackedVec3<T>>::pack(in, out, count);
+}
+template <typename T> inline void pack(const Vec4<T>* in, PackedVec4<T>* out, std::size_t count) noexcept {
+  detail::PackKernels<Vec4<T>, PackedVec4<T>>::pack(in, out, count);
+}
+template <typename T> inline void pack(const Mat3<T>* in, PackedMat3<T>* out, std::size_t count) noexcept {
+  detail::PackKernels<Mat3<T>, PackedMat3<T>>::pack(in, out, count);
+}
+template <typename T> inline void pack(const Mat4<T>* in, PackedMat4<T>* out, std::size_t count) noexcept {
+  detail::PackKernels<Mat4<T>, PackedMat4<T>>::pack(in, out, count);
+}
+
+/**
+ * @brief Unpacks an array of packed vectors or matrices into their compute
+ * type.
+ * @param in The input array.
+ * @param out The output array. It must not overlap in.
+ * @param count The number of elements.
+ */
+template <typename T> inline void unpack(const PackedVec2<T>* in, Vec2<T>* out, std::size_t count) noexcept {
+  detail::PackKernels<Vec2<T>, PackedVec2<T>>::unpack(in, out, count);
+}
+template <typename T> inline void unpack(const PackedVec3<T>* in, Vec3<T>* out, std::size_t count) noexcept {
+  detail::PackKernels<Vec3<T>, PackedVec3<T>>::unpack(in, out, count);
+}
+template <typename T> inline void unpack(const PackedVec4<T>* in, Vec4<T>* out, std::size_t count) noexcept {
+  detail::PackKernels<Vec4<T>, PackedVec4<T>>::unpack(in, out, count);
+}
+template <typename T> inline void unpack(const PackedMat3<T>* in, Mat3<T>* out, std::size_t count) noexcept {
+  detail::PackKernels<Mat3<T>, PackedMat3<T>>::unpack(in, out, count);
+}
+template <typename T> inline void unpack(const PackedMat4<T>* in, Mat4<T>* out, std::size_t count) noexcept {
+  detail::PackKernels<Mat4<T>, PackedMat4<T>>::unpack(in, out, count);
+}
+
+} // namespace linalg
+
+#endif // LINALG_PACKED_HPP
@@ -0,0 +1,422 @@
+/**
+ * @file Parallel.hpp
+ * @brief Multi-threaded versions of the bulk operations over arrays of
+ * vectors.
+ *
+ * The work is cut into chunks of about PARALLEL_CHUNK_BYTES of input, run by
+ * an Executor: the ThreadPool below, or any other scheduler implementing the
+ * interface. Reductions combine the result of each chunk in chunk order, and
+ * the chunks only depend on the number of elements, so sums are the same
+ * whatever the number of threads.
+ *
+ * This header is not included by linalg.hpp; it requires linking the
+ * platform threads library (Threads::Threads, linked by the linalg target).
+ */
+#ifndef LINALG_PARALLEL_HPP
+#define LINALG_PARALLEL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Memory.hpp"
+#include "linalg.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Size of the chunks of input the parallel operations are cut into,
+ * small enough for a chunk and its output to stay in the L2 cache of a core.
+ */
+constexpr std::size_t PARALLEL_CHUNK_BYTES = 64 * 1024;
+
+/**
+ * @brief Interface of the schedulers running the parallel operations.
+ */
+class Executor {
+public:
+  Executor()                           = default;
+  Executor(const Executor&)            = delete;
+  Executor& operator=(const Executor&) = delete;
+  Executor(Executor&&)                 = delete;
+  Executor& operator=(Executor&&)      = delete;
+  virtual ~Executor()                  = default;
+
+  /**
+   * @brief Returns the number of tasks the executor can run at the same time.
+   */
+  virtual std::size_t concurrency() const noexcept = 0;
+
+  /**
+   * @brief Runs task(i) for every i in [0, count), possibly concurrently, and
+   * returns once all of them have completed.
+   * @param count The number of tasks.
+   * @param task The task to run, called once per index.
+   * @throws The first exception thrown by a task, once the running tasks have
+   * completed. The tasks that had not started yet are skipped.
+   */
+  virtual void run(std::size_t count, const std::function<void(std::size_t)>& task) = 0;
+};
+
+/**
+ * @brief Fixed-size pool of worker threads. The calling thread takes part in
+ * the work, so a pool of n threads starts n - 1 workers and a pool of one
+ * thread runs everything sequentially.
+ *
+ * run() may be called from several threads, the calls are then served one
+ * after the other, but must not be called from one of its own tasks.
+ */
+class ThreadPool final : public Executor {
+public:
+  /**
+   * @brief Starts the worker threads.
+   * @param threads The number of threads running the tasks, including the
+   * calling thread.
+   * @throws std::invalid_argument if threads is zero.
+   */
+  explicit ThreadPool(std::size_t threads = defaultConcurrency()) {
+    if(threads == 0) {
+      throw std::invalid_argument("ThreadPool requires at least one thread.");
+    }
+    m_workers.reserve(threads - 1);
+    for(std::size_t i = 1; i < threads; ++i) {
+      m_workers.emplace_back([this] { workerLoop(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&)            = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&)                 = delete;
+  ThreadPool& operator=(ThreadPool&&)      = delete;
+
+  /**
+   * @brief Stops and joins the worker threads.
+   */
+  ~ThreadPool() override {
+    {
+      const std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for(std::thread& worker : m_workers) {
+      worker.join();
+    }
+  }
+
+  /**
+   * @brief Returns the number of hardware threads, or 1 if it is unknown.
+   */
+  static std::size_t defaultConcurrency() noexcept {
+    const unsigned threads = std::thread::hardware_concurrency();
+    return threads == 0 ? 1 : threads;
+  }
+
+  std::size_t concurrency() const noexcept override { return m_workers.size() + 1; }
+
+  void run(std::size_t count, const std::function<void(std::size_t)>& task) override {
+    if(m_workers.empty() || count <= 1) {
+      for(std::size_t i = 0; i < count; ++i) {
+        task(i);
+      }
+      return;
+    }
+
+    const std::lock_guard<std::mutex> run_lock(m_run_mutex);
+    {
+      const std::lock_guard<std::mutex> lock(m_mutex);
+      m_task   = &task;
+      m_count  = count;
+      m_active = m_workers.size();
+      m_error  = nullptr;
+      m_next.store(0, std::memory_order_relaxed);
+      ++m_generation;
+    }
+    m_wake.notify_all();
+    drain();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_active == 0; });
+    m_task = nullptr;
+    if(m_error) {
+      std::exception_ptr error = m_error;
+      m_error                  = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+
+private:
+  /**
+   * @brief Runs the tasks of the current job until none is left.
+   */
+  void drain() noexcept {
+    for(;;) {
+      const std::size_t i = m_next.fetch_add(1, std::memory_order_relaxed);
+      if(i >= m_count) {
+        return;
+      }
+      try {
+        (*m_task)(i);
+      } catch(...) {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_error) {
+          m_error = std::current_exception();
+        }
+        m_next.store(m_count, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void workerLoop() noexcept {
+    std::uint64_t seen = 0;
+    for(;;) {
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+        if(m_stop) {
+          return;
+        }
+        seen = m_generation;
+      }
+      drain();
+      {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        if(--m_active == 0) {
+          m_done.notify_one();
+        }
+      }
+    }
+  }
+
+  std::vector<std::thread>                m_workers;
+  std::mutex                              m_run_mutex;
+  std::mutex                              m_mutex;
+  std::condition_variable                 m_wake;
+  std::condition_variable                 m_done;
+  const std::function<void(std::size_t)>* m_task       = nullptr;
+  std::size_t                             m_count      = 0;
+  std::size_t                             m_active     = 0;
+  std::atomic<std::size_t>                m_next{0};
+  std::uint64_t                           m_generation = 0;
+  std::exception_ptr                      m_error;
+  bool                                    m_stop       = false;
+};
+
+/**
+ * @brief Returns the number of elements of type E in a chunk of
+ * PARALLEL_CHUNK_BYTES.
+ */
+template <typename E> constexpr std::size_t parallelChunkSize() noexcept {
+  return PARALLEL_CHUNK_BYTES / sizeof(E) > 0 ? PARALLEL_CHUNK_BYTES / sizeof(E) : 1;
+}
+
+/**
+ * @brief Calls f(begin, end) on consecutive ranges of [0, count) of at most
+ * chunk elements, in parallel.
+ * @param executor The executor running the chunks.
+ * @param count The number of elements.
+ * @param chunk The number of elements per range (0 is treated as 1).
+ * @param f The function processing a range.
+ */
+template <typename F> void parallelFor(Executor& executor, std::size_t count, std::size_t chunk, const F& f) {
+  if(count == 0) {
+    return;
+  }
+  chunk                    = chunk == 0 ? 1 : chunk;
+  const std::size_t chunks = (count + chunk - 1) / chunk;
+  executor.run(chunks, [&](std::size_t c) {
+    const std::size_t begin = c * chunk;
+    f(begin, begin + chunk < count ? begin + chunk : count);
+  });
+}
+
+/**
+ * @brief Reduces [0, count) in parallel: map(begin, end) reduces each range of
+ * at most chunk elements and the results are folded with combine in range
+ * order, starting from identity. The result only depends on count and chunk,
+ * not on the executor.
+ * @param executor The executor running the chunks.
+ * @param count The number of elements.
+ * @param chunk The number of elements per range (0 is treated as 1).
+ * @param identity The initial value of the fold.
+ * @param map The function reducing a range.
+ * @param combine The function combining two partial results.
+ * @return The reduced value, or identity if count is zero.
+ */
+template <typename R, typename Map, typename Combine>
+R parallelReduce(Executor& executor, std::size_t count, std::size_t chunk, const R& identity, const Map& map,
+                 const Combine& combine) {
+  if(count == 0) {
+    return identity;
+  }
+  chunk                    = chunk == 0 ? 1 : chunk;
+  const std::size_t chunks = (count + chunk - 1) / chunk;
+  AlignedVector<R> partials(chunks, identity);
+  executor.run(chunks, [&](std::size_t c) {
+    const std::size_t begin = c * chunk;
+    partials[c]             = map(begin, begin + chunk < count ? begin + chunk : count);
+  });
+  R result = identity;
+  for(const R& partial : partials) {
+    result = combine(result, partial);
+  }
+  return result;
+}
+
+/**
+ * @brief Transforms an array of points by a Mat4 in parallel, as
+ * transformPoints() in Batch.hpp.
+ * @param executor The executor running the chunks.
+ * @param mat The transformation matrix.
+ * @param in The input points.
+ * @param out The output points. It may be the same array as in but must not
+ * otherwise overlap it.
+ * @param count The number of points.
+ */
+template <typename T>
+void transformPoints(Executor& executor, const Mat4<T>& mat, const Vec3<T>* in, Vec3<T>* out, std::size_t count) {
+  parallelFor(executor, count, parallelChunkSize<Vec3<T>>(), [&](std::size_t begin, std::size_t end) {
+    transformPoints(mat, in + begin, out + begin, end - begin);
+  });
+}
+
+/**
+ * @brief Transforms an array of directions by a Mat4 in parallel, as
+ * transformDirections() in Batch.hpp.
+ * @param executor The executor running the chunks.
+ * @param mat The transformation matrix.
+ * @param in The input directions.
+ * @param out The output directions. It may be the same array as in but must
+ * not otherwise overlap it.
+ * @param count The number of directions.
+ */
+template <typename T>
+void transformDirections(Executor& executor, const Mat4<T>& mat, const Vec3<T>* in, Vec3<T>* out,
+                         std::size_t count) {
+  parallelFor(executor, count, parallelChunkSize<Vec3<T>>(), [&](std::size_t begin, std::size_t end) {
+    transformDirections(mat, in + begin, out + begin, end - begin);
+  });
+}
+
+/**
+ * @brief Transforms an array of Vec4 vectors by a Mat4 in parallel, as
+ * transformVectors() in Batch.hpp.
+ * @param executor The executor running the chunks.
+ * @param mat The transformation matrix.
+ * @param in The input vectors.
+ * @param out The output vectors. It may be the same array as in but must not
+ * otherwise overlap it.
+ * @param count The number of vectors.
+ */
+template <typename T>
+void transformVectors(Executor& executor, const Mat4<T>& mat, const Vec4<T>* in, Vec4<T>* out, std::size_t count) {
+  parallelFor(executor, count, parallelChunkSize<Vec4<T>>(), [&](std::size_t begin, std::size_t end) {
+    transformVectors(mat, in + begin, out + begin, end - begin);
+  });
+}
+
+/**
+ * @brief Normalizes an array of vectors in parallel, as Vec3::normalized().
+ * @param executor The executor running the chunks.
+ * @param in The input vectors.
+ * @param out The normalized vectors. It may be the same array as in but must
+ * not otherwise overlap it.
+ * @param count The number of vectors.
+ */
+template <typename T> void normalized(Executor& executor, const Vec3<T>* in, Vec3<T>* out, std::size_t count) {
+  parallelFor(executor, count, parallelChunkSize<Vec3<T>>(), [&](std::size_t begin, std::size_t end) {
+    for(std::size_t i = begin; i < end; ++i) {
+      out[i] = in[i].normalized();
+    }
+  });
+}
+
+/**
+ * @brief Computes the sum of an array of vectors in parallel. The result does
+ * not depend on the number of threads of the executor.
+ * @param executor The executor running the chunks.
+ * @param in The input vectors.
+ * @param count The number of vectors.
+ * @return The sum of the vectors, zero if count is zero.
+ */
+template <typename T> Vec3<T> sum(Executor& executor, const Vec3<T>* in, std::size_t count) {
+  return parallelReduce(
+      executor, count, parallelChunkSize<Vec3<T>>(), Vec3<T>(),
+      [&](std::size_t begin, std::size_t end) {
+        Vec3<T> acc;
+        for(std::size_t i = begin; i < end; ++i) {
+          acc += in[i];
+        }
+        return acc;
+      },
+      [](const Vec3<T>& a, const Vec3<T>& b) { return a + b; });
+}
+
+namespace detail {
+
+template <typename T> struct Bounds3 {
+  Vec3<T> lo;
+  Vec3<T> hi;
+};
+
+/**
+ * @brief Keeps the smaller value, or a if b is NaN. Unlike std::fmin it
+ * compiles to a single min instruction.
+ */
+template <typename T> inline T minIgnoringNaN(T a, T b) noexcept { return b < a ? b : a; }
+
+template <typename T> inline T maxIgnoringNaN(T a, T b) noexcept { return b > a ? b : a; }
+
+template <typename T> inline Bounds3<T> combineBounds(const Bounds3<T>& a, const Bounds3<T>& b) noexcept {
+  return {{minIgnoringNaN(a.lo.x, b.lo.x), minIgnoringNaN(a.lo.y, b.lo.y), minIgnoringNaN(a.lo.z, b.lo.z)},
+          {maxIgnoringNaN(a.hi.x, b.hi.x), maxIgnoringNaN(a.hi.y, b.hi.y), maxIgnoringNaN(a.hi.z, b.hi.z)}};
+}
+
+} // namespace detail
+
+/**
+ * @brief Computes the component-wise minimum and maximum of an array of
+ * vectors in parallel. NaN components are ignored; a component that is NaN in
+ * every vector gives +infinity as minimum and -infinity as maximum.
+ * @param executor The executor running the chunks.
+ * @param in The input vectors.
+ * @param count The number of vectors.
+ * @param min Receives the component-wise minimum.
+ * @param max Receives the component-wise maximum.
+ * @throws std::invalid_argument if count is zero.
+ */
+template <typename T>
+void minMax(Executor& executor, const Vec3<T>* in, std::size_t count, Vec3<T>& min, Vec3<T>& max) {
+  if(count == 0) {
+    throw std::invalid_argument("minMax requires at least one vector.");
+  }
+  const T                  inf    = std::numeric_limits<T>::infinity();
+  const detail::Bounds3<T> empty  = {Vec3<T>(inf), Vec3<T>(-inf)};
+  const detail::Bounds3<T> bounds = parallelReduce(
+      executor, count, parallelChunkSize<Vec3<T>>(), empty,
+      [&](std::size_t begin, std::size_t end) {
+        detail::Bounds3<T> acc = empty;
+        for(std::size_t i = begin; i < end; ++i) {
+          acc = detail::combineBounds(acc, {in[i], in[i]});
+        }
+        return acc;
+      },
+      &detail::combineBounds<T>);
+  min = bounds.lo;
+  max = bounds.hi;
+}
+
+} // namespace linalg
+
+#endif // LINALG_PARALLEL_HPP
@@ -0,0 +1,434 @@
+/**
+ * @file Quat.hpp
+ * @brief Header file for the Quat class, representing a rotation quaternion.
+ */
+#ifndef LINALG_QUAT_HPP
+#define LINALG_QUAT_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+#include "Alignment.hpp"
+#include "Mat3.hpp"
+#include "Mat4.hpp"
+#include "Pack.hpp"
+#include "SimdMath.hpp"
+#include "Vec3.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Quaternion x*i + y*j + z*k + w, used to represent rotations.
+ *
+ * Rotations follow the same conventions as the matrices of this library
+ * (column vectors, right-handed): q.toMat3() * v == q.rotate(v), and
+ * (a * b).rotate(v) == a.rotate(b.rotate(v)).
+ * @tparam T The type of the quaternion components (e.g., float, double).
+ */
+template <typename T> struct alignas(linalg::VecAlignment<T, 4>::VALUE) Quat {
+  T x, y, z, w;
+
+  /**
+   * @brief Default constructor initializes the quaternion to the identity
+   * rotation (0, 0, 0, 1).
+   */
+  constexpr Quat() noexcept : x(0.0), y(0.0), z(0.0), w(1.0) {}
+
+  /**
+   * @brief Constructor that initializes the quaternion with specific
+   * components.
+   * @param x The i component.
+   * @param y The j component.
+   * @param z The k component.
+   * @param w The real component.
+   */
+  constexpr Quat(T x, T y, T z, T w) noexcept : x(x), y(y), z(z), w(w) {}
+
+  /**
+   * @brief Constructor that initializes the quaternion from another Quat of a
+   * different type.
+   * @param other The Quat to copy from.
+   */
+  template <typename U>
+  explicit constexpr Quat(const Quat<U>& other) noexcept
+      : x(static_cast<T>(other.x)), y(static_cast<T>(other.y)), z(static_cast<T>(other.z)),
+        w(static_cast<T>(other.w)) {}
+
+  /**
+   * @brief Returns the identity rotation.
+   */
+  static constexpr Quat Identity() noexcept { return Quat{}; }
+
+  /**
+   * @brief Creates a rotation around an axis.
+   * @param axis The rotation axis (must be normalized).
+   * @param angle The angle in radians.
+   * @return A Quat representing the rotation.
+   */
+  static Quat FromAxisAngle(const Vec3<T>& axis, T angle) noexcept {
+    const T half = angle / 2;
+    const T s    = std::sin(half);
+    return {axis.x * s, axis.y * s, axis.z * s, std::cos(half)};
+  }
+
+  /**
+   * @brief Creates the rotation of getRotationMatrix(x_angle, y_angle, z_angle):
+   * around x, then y, then z.
+   * @param x_angle The angle in radians to rotate around the x-axis.
+   * @param y_angle The angle in radians to rotate around the y-axis.
+   * @param z_angle The angle in radians to rotate around the z-axis.
+   * @return A Quat representing the combined rotation.
+   */
+  static Quat FromEuler(T x_angle, T y_angle, T z_angle) noexcept {
+    const T sx = std::sin(x_angle / 2);
+    const T cx = std::cos(x_angle / 2);
+    const T sy = std::sin(y_angle / 2);
+    const T cy = std::cos(y_angle / 2);
+    const T sz = std::sin(z_angle / 2);
+    const T cz = std::cos(z_angle / 2);
+    // qz * qy * qx, expanded
+    return {sx * cy * cz - cx * sy * sz, cx * sy * cz + sx * cy * sz, cx * cy * sz - sx * sy * cz,
+            cx * cy * cz + sx * sy * sz};
+  }
+
+  /**
+   * @brief Creates a quaternion from a rotation matrix.
+   * @param mat The rotation matrix (must be orthonormal with determinant 1).
+   * @return A normalized Quat representing the same rotation.
+   */
+  static Quat FromMat3(const Mat3<T>& mat) noexcept {
+    const auto& m     = mat.m;
+    const T     trace = m[0][0] + m[1][1] + m[2][2];
+    // Branch on the largest diagonal term to keep the square root well
+    // conditioned.
+    if(trace > 0) {
+      const T s = std::sqrt(trace + 1) * 2;
+      return Quat((m[2][1] - m[1][2]) / s, (m[0][2] - m[2][0]) / s, (m[1][0] - m[0][1]) / s, s / 4).normalized();
+    }
+    if(m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+      const T s = std::sqrt(1 + m[0][0] - m[1][1] - m[2][2]) * 2;
+      return Quat(s / 4, (m[0][1] + m[1][0]) / s, (m[0][2] + m[2][0]) / s, (m[2][1] - m[1][2]) / s).normalized();
+    }
+    if(m[1][1] > m[2][2]) {
+      const T s = std::sqrt(1 + m[1][1] - m[0][0] - m[2][2]) * 2;
+      return Quat((m[0][1] + m[1][0]) / s, s / 4, (m[1][2] + m[2][1]) / s, (m[0][2] - m[2][0]) / s).normalized();
+    }
+    const T s = std::sqrt(1 + m[2][2] - m[0][0] - m[1][1]) * 2;
+    return Quat((m[0][2] + m[2][0]) / s, (m[1][2] + m[2][1]) / s, s / 4, (m[1][0] - m[0][1]) / s).normalized();
+  }
+
+  /**
+   * @brief Composes two rotations (Hamilton product).
+   * @param other The rotation applied first.
+   * @return A Quat applying other, then this rotation.
+   */
+  constexpr Quat operator*(const Quat& other) const noexcept {
+    return {w * other.x + x * other.w + y * other.z - z * other.y, w * other.y - x * other.z + y * other.w + z * other.x,
+            w * other.z + x * other.y - y * other.x + z * other.w, w * other.w - x * other.x - y * other.y - z * other.z};
+  }
+
+  /**
+   * @brief Composes this rotation with another one.
+   * @param other The rotation applied first.
+   * @return A reference to this quaternion after the operation.
+   */
+  Quat& operator*=(const Quat& other) noexcept {
+    *this = *this * other;
+    return *this;
+  }
+
+  constexpr Quat operator+(const Quat& other) const noexcept {
+    return {x + other.x, y + other.y, z + other.z, w + other.w};
+  }
+  constexpr Quat operator-(const Quat& other) const noexcept {
+    return {x - other.x, y - other.y, z - other.z, w - other.w};
+  }
+  constexpr Quat operator-() const noexcept { return {-x, -y, -z, -w}; }
+  constexpr Quat operator*(T scalar) const noexcept { return {x * scalar, y * scalar, z * scalar, w * scalar}; }
+
+  constexpr bool operator==(const Quat& other) const noexcept {
+    return x == other.x && y == other.y && z == other.z && w == other.w;
+  }
+  constexpr bool operator!=(const Quat& other) const noexcept { return !(*this == other); }
+
+  /**
+   * @brief Computes the dot product of two quaternions.
+   */
+  constexpr T dot(const Quat& other) const noexcept { return x * other.x + y * other.y + z * other.z + w * other.w; }
+
+  /**
+   * @brief Computes the squared length of the quaternion.
+   */
+  constexpr T squaredLength() const noexcept { return dot(*this); }
+
+  /**
+   * @brief Computes the length of the quaternion.
+   */
+  T length() const noexcept { return std::sqrt(squaredLength()); }
+
+  /**
+   * @brief Returns a normalized version of the quaternion.
+   * @return The normalized quaternion, or the identity if the length is zero.
+   */
+  Quat normalized() const noexcept {
+    const T len = length();
+    return len > 0.0 ? (*this * (1 / len)) : Quat{};
+  }
+
+  /**
+   * @brief Normalizes the quaternion in place.
+   * If the length is zero, the quaternion remains unchanged.
+   */
+  void normalize() noexcept {
+    const T len = length();
+    if(len > 0.0) {
+      *this = *this * (1 / len);
+    }
+  }
+
+  /**
+   * @brief Returns the conjugate, which is the inverse rotation for a unit
+   * quaternion.
+   */
+  constexpr Quat conjugate() const noexcept { return {-x, -y, -z, w}; }
+
+  /**
+   * @brief Returns the inverse of the quaternion.
+   * @return The inverse, or the identity if the length is zero.
+   */
+  Quat inverse() const noexcept {
+    const T len2 = squaredLength();
+    return len2 > 0.0 ? conjugate() * (1 / len2) : Quat{};
+  }
+
+  /**
+   * @brief Rotates a vector by this unit quaternion.
+   *
+   * Uses v + w * t + cross(q, t) with t = 2 * cross(q, v), which is cheaper than
+   * building the rotation matrix.
+   * @param v The vector to rotate.
+   * @return The rotated vector.
+   */
+  constexpr Vec3<T> rotate(const Vec3<T>& v) const noexcept {
+    return rotateWith(v, Vec3<T>(y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x) * T(2));
+  }
+
+  /**
+   * @brief Returns the rotation matrix of this unit quaternion.
+   */
+  Mat3<T> toMat3() const noexcept {
+    const T xx = x * x;
+    const T yy = y * y;
+    const T zz = z * z;
+    const T xy = x * y;
+    const T xz = x * z;
+    const T yz = y * z;
+    const T wx = w * x;
+    const T wy = w * y;
+    const T wz = w * z;
+
+    return {1 - 2 * (yy + zz), 2 * (xy - wz),     2 * (xz + wy),
+            2 * (xy + wz),     1 - 2 * (xx + zz), 2 * (yz - wx),
+            2 * (xz - wy),     2 * (yz + wx),     1 - 2 * (xx + yy)};
+  }
+
+  /**
+   * @brief Returns the homogeneous rotation matrix of this unit quaternion.
+   */
+  Mat4<T> toMat4() const noexcept { return Mat4<T>(toMat3()); }
+
+  /**
+   * @brief Checks if two quaternions are approximately equal, component-wise.
+   * @note q and -q represent the same rotation but are not approximately equal.
+   */
+  constexpr bool isApprox(const Quat& other, T epsilon) const noexcept {
+    return std::fabs(x - other.x) < epsilon && std::fabs(y - other.y) < epsilon && std::fabs(z - other.z) < epsilon &&
+           std::fabs(w - other.w) < epsilon;
+  }
+
+private:
+  constexpr Vec3<T> rotateWith(const Vec3<T>& v, const Vec3<T>& t) const noexcept {
+    return {v.x + w * t.x + (y * t.z - z * t.y), v.y + w * t.y + (z * t.x - x * t.z),
+            v.z + w * t.z + (x * t.y - y * t.x)};
+  }
+};
+
+// GCOVR_EXCL_START
+/**
+ * @brief Overloads the output stream operator for Quat.
+ * @param os The output stream.
+ * @param q The Quat object to print.
+ * @return The output stream after printing the quaternion.
+ * @tparam T The type of the quaternion components.
+ */
+template <typename T> inline std::ostream& operator<<(std::ostream& os, const Quat<T>& q) {
+  return os << "Quat(" << q.x << ", " << q.y << ", " << q.z << ", " << q.w << ")";
+}
+// GCOVR_EXCL_STOP
+
+/**
+ * @brief Rotates a vector by a unit quaternion.
+ */
+template <typename T> constexpr Vec3<T> operator*(const Quat<T>& q, const Vec3<T>& v) noexcept {
+  return q.rotate(v);
+}
+
+/**
+ * @brief Normalized linear interpolation between two rotations, along the
+ * shortest path.
+ * @param a The rotation at t = 0.
+ * @param b The rotation at t = 1.
+ * @param t The interpolation factor.
+ * @return The normalized interpolated rotation.
+ */
+template <typename T> inline Quat<T> nlerp(const Quat<T>& a, const Quat<T>& b, T t) noexcept {
+  const Quat<T> target = a.dot(b) < 0 ? -b : b;
+  return (a * (1 - t) + target * t).normalized();
+}
+
+namespace detail {
+
+/**
+ * @brief Computes the slerp weights of a and b for a cosine d >= 0 between
+ * them, falling back to nlerp weights when they are nearly parallel.
+ * @return True if the nlerp weights were used and the blend must be
+ * normalized.
+ */
+template <typename T> inline bool slerpWeights(T d, T t, T& wa, T& wb) noexcept {
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+  if(d > T(0.9995)) {
+    wa = 1 - t;
+    wb = t;
+    return true;
+  }
+  const T theta     = std::acos(d);
+  const T inv_sin_t = 1 / std::sqrt(1 - d * d);
+  wa                = std::sin((1 - t) * theta) * inv_sin_t;
+  wb                = std::sin(t * theta) * inv_sin_t;
+  return false;
+}
+
+} // namespace detail
+
+/**
+ * @brief Spherical linear interpolation between two rotations, along the
+ * shortest path.
+ * @param a The rotation at t = 0.
+ * @param b The rotation at t = 1.
+ * @param t The interpolation factor.
+ * @return The interpolated rotation, normalized if a and b are.
+ */
+template <typename T> inline Quat<T> slerp(const Quat<T>& a, const Quat<T>& b, T t) noexcept {
+  const T       d      = a.dot(b);
+  const Quat<T> target = d < 0 ? -b : b;
+  T             wa;
+  T             wb;
+  const bool    linear = detail::slerpWeights(std::fabs(d), t, wa, wb);
+  const Quat<T> r      = a * wa + target * wb;
+  return linear ? r.normalized() : r;
+}
+
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+/**
+ * @brief Pack used by the batch slerp: the native pack, at least four lanes
+ * wide so that transpose4() turns quaternion records into components.
+ */
+template <typename T>
+using SlerpPack = simd::Pack<T, (simd::NativeWidth<T>::VALUE < 4 ? 4 : simd::NativeWidth<T>::VALUE)>;
+
+/**
+ * @brief Interpolates P::WIDTH pairs of rotations starting at a and b, one pair
+ * per lane, with the weights of slerpWeights().
+ */
+template <typename P, typename T>
+inline void slerpLanes(const Quat<T>* a, const Quat<T>* b, T t, Quat<T>* out) noexcept {
+  using Mask           = typename P::Mask;
+  constexpr int STRIDE = P::WIDTH / 4; // Quaternions per pack.
+  P             qa[4];
+  P             qb[4];
+  for(int k = 0; k < 4; ++k) {
+    qa[k] = P::load(&a[k * STRIDE].x);
+    qb[k] = P::load(&b[k * STRIDE].x);
+  }
+  simd::transpose4(qa[0], qa[1], qa[2], qa[3]);
+  simd::transpose4(qb[0], qb[1], qb[2], qb[3]);
+
+  P signed_d = qa[0] * qb[0];
+  for(int k = 1; k < 4; ++k) {
+    signed_d = simd::madd(qa[k], qb[k], signed_d);
+  }
+  const Mask flip = signed_d < P::broadcast(0);
+  const P    d    = simd::abs(signed_d);
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+  const Mask linear = d > P::broadcast(T(0.9995));
+
+  // sin((1 - t) theta) = sin(theta) cos(t theta) - cos(theta) sin(t theta), so
+  // a single sincos gives both weights. The lanes where theta is 0 or d > 1
+  // rounds to NaN take the nlerp weights.
+  const P theta = simd::acos(d);
+  P       sin_tt;
+  P       cos_tt;
+  simd::sincos(P::broadcast(t) * theta, sin_tt, cos_tt);
+  const P wb_slerp = sin_tt / simd::sqrt(P::broadcast(1) - d * d);
+  const P wa       = simd::select(linear, P::broadcast(1 - t), cos_tt - d * wb_slerp);
+  const P wb_abs   = simd::select(linear, P::broadcast(t), wb_slerp);
+  const P wb       = simd::select(flip, -wb_abs, wb_abs);
+
+  P r[4];
+  P norm2 = P::broadcast(0);
+  for(int k = 0; k < 4; ++k) {
+    r[k]  = simd::madd(qa[k], wa, qb[k] * wb);
+    norm2 = simd::madd(r[k], r[k], norm2);
+  }
+  const P scale = simd::select(linear, P::broadcast(1) / simd::sqrt(norm2), P::broadcast(1));
+  for(int k = 0; k < 4; ++k) {
+    r[k] = r[k] * scale;
+  }
+  simd::transpose4(r[0], r[1], r[2], r[3]);
+  for(int k = 0; k < 4; ++k) {
+    r[k].store(&out[k * STRIDE].x);
+  }
+}
+
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+
+/**
+ * @brief Interpolates arrays of rotations with slerp.
+ *
+ * Each SIMD lane interpolates one pair: the quaternions are transposed into
+ * one pack per component and the weights use the vectorized acos() and
+ * sincos() of SimdMath.hpp. The pairs left after the last full group of
+ * SIMD width use the scalar slerp().
+ * @param a The rotations at t = 0.
+ * @param b The rotations at t = 1.
+ * @param t The interpolation factor, shared by all pairs.
+ * @param out The interpolated rotations. It may be the same array as a or b.
+ * @param count The number of rotations.
+ */
+template <typename T>
+inline void slerp(const Quat<T>* a, const Quat<T>* b, T t, Quat<T>* out, std::size_t count) noexcept {
+  using P = detail::SlerpPack<T>;
+  static_assert(sizeof(Quat<T>) == 4 * sizeof(T), "the batch slerp loads quaternions as contiguous components");
+  std::size_t i = 0;
+  for(; i + P::WIDTH <= count; i += P::WIDTH) {
+    detail::slerpLanes<P>(a + i, b + i, t, out + i);
+  }
+  for(; i < count; ++i) {
+    out[i] = slerp(a[i], b[i], t);
+  }
+}
+
+using Quatf = Quat<float>;
+using Quatd = Quat<double>;
+
+} // namespace linalg
+
+#endif // LINALG_QUAT_HPP
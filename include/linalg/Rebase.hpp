@@ -0,0 +1,173 @@
+/**
+ * @file Rebase.hpp
+ * @brief Bulk double to float conversion of points and matrices, optionally
+ * relative to an origin.
+ *
+ * Large worlds keep positions and transforms in double precision, but the
+ * float kernels and the GPU want floats, and a float 10 km from the origin only
+ * resolves about a millimetre. narrow() converts arrays of vectors and
+ * matrices four or eight elements per instruction. rebase() first moves them to
+ * a frame centred on an origin, usually the camera position, in double
+ * precision, so the float results keep their precision where they are viewed.
+ */
+#ifndef LINALG_REBASE_HPP
+#define LINALG_REBASE_HPP
+
+#include <cstddef>
+
+#include "Affine3.hpp"
+#include "Mat4.hpp"
+#include "Pack.hpp"
+#include "Simd.hpp"
+#include "Vec3.hpp"
+#include "Vec4.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+using Double4 = simd::Pack<double, 4>;
+
+/**
+ * @brief Rounds four doubles to the nearest floats and stores them.
+ */
+inline void storeNarrow4(float* out, const Double4& v) noexcept {
+#if LINALG_HAS_AVX
+  _mm_storeu_ps(out, _mm256_cvtpd_ps(v.v));
+#elif LINALG_HAS_SSE2
+  _mm_storeu_ps(out, _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(v.v)), _mm_cvtpd_ps(_mm_loadu_pd(v.v + 2))));
+#elif LINALG_HAS_NEON
+  vst1q_f32(out, vcombine_f32(vcvt_f32_f64(vld1q_f64(v.v)), vcvt_f32_f64(vld1q_f64(v.v + 2))));
+#else
+  for(int i = 0; i < 4; ++i) {
+    out[i] = static_cast<float>(v.v[i]);
+  }
+#endif
+}
+
+/**
+ * @brief Converts an array of doubles to floats, eight (AVX-512) or four
+ * elements per iteration.
+ */
+inline void narrowArray(const double* in, float* out, std::size_t count) noexcept {
+  std::size_t i = 0;
+#if LINALG_HAS_AVX512F
+  for(; i + 8 <= count; i += 8) {
+    _mm256_storeu_ps(out + i, _mm512_cvtpd_ps(_mm512_loadu_pd(in + i)));
+  }
+#endif
+  for(; i + 4 <= count; i += 4) {
+    storeNarrow4(out + i, Double4::load(in + i));
+  }
+  for(; i < count; ++i) {
+    out[i] = static_cast<float>(in[i]);
+  }
+}
+
+/**
+ * @brief Converts affine matrices after subtracting origin from their
+ * translations, the last lane of each row.
+ */
+inline void rebaseAffine(const Affine3<double>* in, const Vec3<double>& origin, Affine3<float>* out,
+                         std::size_t count) noexcept {
+  const double  translation[3][4] = {{0, 0, 0, -origin.x}, {0, 0, 0, -origin.y}, {0, 0, 0, -origin.z}};
+  const Double4 t0                = Double4::load(translation[0]);
+  const Double4 t1                = Double4::load(translation[1]);
+  const Double4 t2                = Double4::load(translation[2]);
+  for(std::size_t i = 0; i < count; ++i) {
+    storeNarrow4(out[i].m[0].data(), Double4::load(in[i].m[0].data()) + t0);
+    storeNarrow4(out[i].m[1].data(), Double4::load(in[i].m[1].data()) + t1);
+    storeNarrow4(out[i].m[2].data(), Double4::load(in[i].m[2].data()) + t2);
+  }
+}
+
+/**
+ * @brief Converts matrices after subtracting origin times the last row from the
+ * first three rows, which only changes the translation of affine matrices.
+ */
+inline void rebaseMat4(const Mat4<double>* in, const Vec3<double>& origin, Mat4<float>* out,
+                       std::size_t count) noexcept {
+  const Double4 ox = Double4::broadcast(-origin.x);
+  const Double4 oy = Double4::broadcast(-origin.y);
+  const Double4 oz = Double4::broadcast(-origin.z);
+  for(std::size_t i = 0; i < count; ++i) {
+    const Double4 r3 = Double4::load(in[i].m[3].data());
+    storeNarrow4(out[i].m[0].data(), simd::madd(ox, r3, Double4::load(in[i].m[0].data())));
+    storeNarrow4(out[i].m[1].data(), simd::madd(oy, r3, Double4::load(in[i].m[1].data())));
+    storeNarrow4(out[i].m[2].data(), simd::madd(oz, r3, Double4::load(in[i].m[2].data())));
+    storeNarrow4(out[i].m[3].data(), r3);
+  }
+}
+
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+
+/**
+ * @brief Converts an array of doubles, vectors or matrices to float, rounding to
+ * nearest.
+ *
+ * Same result as a static_cast of every element.
+ * @param in The input array.
+ * @param out The output array. It must not overlap in.
+ * @param count The number of elements.
+ */
+inline void narrow(const double* in, float* out, std::size_t count) noexcept { detail::narrowArray(in, out, count); }
+inline void narrow(const Vec3<double>* in, Vec3<float>* out, std::size_t count) noexcept {
+  static_assert(sizeof(Vec3<double>) == 4 * sizeof(double) && sizeof(Vec3<float>) == 4 * sizeof(float),
+                "Vec3 is expected to be padded to four elements");
+  // The padding lanes are converted along with the components.
+  detail::narrowArray(&in->x, &out->x, 4 * count);
+}
+inline void narrow(const Vec4<double>* in, Vec4<float>* out, std::size_t count) noexcept {
+  detail::narrowArray(&in->x, &out->x, 4 * count);
+}
+inline void narrow(const Affine3<double>* in, Affine3<float>* out, std::size_t count) noexcept {
+  detail::narrowArray(in->m[0].data(), out->m[0].data(), 12 * count);
+}
+inline void narrow(const Mat4<double>* in, Mat4<float>* out, std::size_t count) noexcept {
+  detail::narrowArray(in->data(), &out->m[0][0], 16 * count);
+}
+
+/**
+ * @brief Converts an array of points to float relative to an origin, out[i] =
+ * in[i] - origin computed in double precision.
+ * @param in The input points.
+ * @param origin The origin of the output frame, usually the camera position.
+ * @param out The output points. It must not overlap in.
+ * @param count The number of points.
+ */
+inline void rebase(const Vec3<double>* in, const Vec3<double>& origin, Vec3<float>* out, std::size_t count) noexcept {
+  const double          offset[4] = {origin.x, origin.y, origin.z, 0};
+  const detail::Double4 o         = detail::Double4::load(offset);
+  for(std::size_t i = 0; i < count; ++i) {
+    detail::storeNarrow4(&out[i].x, detail::Double4::load(&in[i].x) - o);
+  }
+}
+
+/**
+ * @brief Converts an array of transformations to float relative to an origin,
+ * out[i] = Translation(-origin) * in[i] computed in double precision.
+ *
+ * Render model matrices relative to the camera with the view matrix built at
+ * the origin, eye - origin, so that neither holds a large translation.
+ * @param in The input matrices.
+ * @param origin The origin of the output frame, usually the camera position.
+ * @param out The output matrices. It must not overlap in.
+ * @param count The number of matrices.
+ */
+inline void rebase(const Affine3<double>* in, const Vec3<double>& origin, Affine3<float>* out,
+                   std::size_t count) noexcept {
+  detail::rebaseAffine(in, origin, out, count);
+}
+inline void rebase(const Mat4<double>* in, const Vec3<double>& origin, Mat4<float>* out, std::size_t count) noexcept {
+  detail::rebaseMat4(in, origin, out, count);
+}
+
+} // namespace linalg
+
+#endif // LINALG_REBASE_HPP
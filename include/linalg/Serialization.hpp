@@ -0,0 +1,498 @@
+/**
+ * @file Serialization.hpp
+ * @brief Binary files of vector and matrix arrays, readable in place.
+ *
+ * A file holds one contiguous array of a Vec2/Vec3/Vec4/Mat3/Mat4 type or of
+ * its packed counterpart, stored exactly as in memory after a fixed 48-byte
+ * header describing the scalar type, shape, element size, alignment, count and
+ * byte order. The data starts at a 64-byte aligned offset, so MappedArray can
+ * map the file and use the elements without copying or parsing them: loading
+ * costs the page faults of the bytes actually touched.
+ *
+ * Files are written in the native byte order. The readers reject files of the
+ * other byte order instead of swapping them, which would require a copy.
+ */
+#ifndef LINALG_SERIALIZATION_HPP
+#define LINALG_SERIALIZATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LINALG_HAS_MMAP 1
+#else
+#define LINALG_HAS_MMAP 0
+#endif
+
+#include "Mat3.hpp"
+#include "Mat4.hpp"
+#include "Memory.hpp"
+#include "Packed.hpp"
+#include "Vec2.hpp"
+#include "Vec3.hpp"
+#include "Vec4.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Scalar type of the elements of a serialized array.
+ */
+enum class ScalarType : std::uint8_t { Float32 = 1, Float64 = 2 };
+
+/**
+ * @brief Byte order of a serialized array.
+ */
+enum class Endianness : std::uint8_t { Little = 1, Big = 2 };
+
+/**
+ * @brief Header at the start of a serialized array file.
+ *
+ * Vectors have cols == 1. The data starts at data_offset, a multiple of
+ * DEFAULT_ALIGNMENT, and holds count elements of element_size bytes.
+ */
+struct ArrayHeader {
+  static constexpr std::uint32_t MAGIC         = 0x474C4E4CU; // "LNLG" in little-endian order.
+  static constexpr std::uint32_t SWAPPED_MAGIC = 0x4C4E4C47U; // MAGIC as read on a host of the other byte order.
+  static constexpr std::uint16_t VERSION       = 1;
+
+  std::uint32_t magic        = MAGIC;
+  std::uint16_t version      = VERSION;
+  std::uint8_t  endianness   = 0;
+  std::uint8_t  scalar_type  = 0;
+  std::uint8_t  rows         = 0;
+  std::uint8_t  cols         = 0;
+  std::uint16_t alignment    = 0;
+  std::uint32_t element_size = 0;
+  std::uint64_t count        = 0;
+  std::uint64_t data_offset  = 0;
+  std::uint8_t  reserved[16] = {};
+};
+
+static_assert(sizeof(ArrayHeader) == 48, "ArrayHeader must have no padding");
+
+/**
+ * @brief Returns the byte order of the host.
+ */
+inline Endianness nativeEndianness() noexcept {
+  const std::uint16_t value = 1;
+  std::uint8_t        first = 0;
+  std::memcpy(&first, &value, 1);
+  return first == 1 ? Endianness::Little : Endianness::Big;
+}
+
+namespace detail {
+
+template <typename T> struct ScalarTypeOf;
+
+template <> struct ScalarTypeOf<float> {
+  static constexpr ScalarType VALUE = ScalarType::Float32;
+};
+
+template <> struct ScalarTypeOf<double> {
+  static constexpr ScalarType VALUE = ScalarType::Float64;
+};
+
+/**
+ * @brief Description of a serializable element type: its scalar type and shape.
+ */
+template <typename E> struct ArrayTraits;
+
+template <typename T, int R, int C> struct ArrayShape {
+  static constexpr ScalarType   SCALAR = ScalarTypeOf<T>::VALUE;
+  static constexpr std::uint8_t ROWS   = R;
+  static constexpr std::uint8_t COLS   = C;
+};
+
+template <typename T> struct ArrayTraits<Vec2<T>> : ArrayShape<T, 2, 1> {};
+template <typename T> struct ArrayTraits<Vec3<T>> : ArrayShape<T, 3, 1> {};
+template <typename T> struct ArrayTraits<Vec4<T>> : ArrayShape<T, 4, 1> {};
+template <typename T> struct ArrayTraits<Mat3<T>> : ArrayShape<T, 3, 3> {};
+template <typename T> struct ArrayTraits<Mat4<T>> : ArrayShape<T, 4, 4> {};
+template <typename T> struct ArrayTraits<PackedVec2<T>> : ArrayShape<T, 2, 1> {};
+template <typename T> struct ArrayTraits<PackedVec3<T>> : ArrayShape<T, 3, 1> {};
+template <typename T> struct ArrayTraits<PackedVec4<T>> : ArrayShape<T, 4, 1> {};
+template <typename T> struct ArrayTraits<PackedMat3<T>> : ArrayShape<T, 3, 3> {};
+template <typename T> struct ArrayTraits<PackedMat4<T>> : ArrayShape<T, 4, 4> {};
+
+/**
+ * @brief Offset of the data of an array of elements aligned to alignment.
+ */
+inline std::uint64_t dataOffset(std::size_t alignment) noexcept {
+  const std::size_t align = alignment > DEFAULT_ALIGNMENT ? alignment : DEFAULT_ALIGNMENT;
+  return (sizeof(ArrayHeader) + align - 1) / align * align;
+}
+
+/**
+ * @brief Checks that a header describes an array of E that fits in file_size
+ * bytes.
+ * @throws std::runtime_error if it does not.
+ */
+template <typename E> inline void validateHeader(const ArrayHeader& header, std::uint64_t file_size) {
+  using Traits = ArrayTraits<E>;
+  // The magic of a file written in the other byte order reads swapped, and the
+  // version field with it.
+  if(header.magic == ArrayHeader::SWAPPED_MAGIC ||
+     (header.magic == ArrayHeader::MAGIC && header.endianness != static_cast<std::uint8_t>(nativeEndianness()))) {
+    throw std::runtime_error("linalg: serialized array has a different byte order");
+  }
+  if(header.magic != ArrayHeader::MAGIC) {
+    throw std::runtime_error("linalg: not a serialized array");
+  }
+  if(header.version != ArrayHeader::VERSION) {
+    throw std::runtime_error("linalg: unsupported serialized array version");
+  }
+  if(header.scalar_type != static_cast<std::uint8_t>(Traits::SCALAR) || header.rows != Traits::ROWS ||
+     header.cols != Traits::COLS || header.element_size != sizeof(E) || header.alignment != alignof(E)) {
+    throw std::runtime_error("linalg: serialized array has a different element type");
+  }
+  if(header.data_offset % alignof(E) != 0 || header.data_offset < sizeof(ArrayHeader) ||
+     header.data_offset > file_size || header.count > (file_size - header.data_offset) / sizeof(E)) {
+    throw std::runtime_error("linalg: serialized array is truncated");
+  }
+}
+
+/// Returned by remainingBytes() for streams that cannot seek.
+constexpr std::uint64_t UNKNOWN_SIZE = std::numeric_limits<std::uint64_t>::max();
+
+/**
+ * @brief Returns the number of bytes left in a stream, leaving its position
+ * unchanged, or UNKNOWN_SIZE if it cannot seek.
+ */
+inline std::uint64_t remainingBytes(std::istream& is) {
+  const std::istream::pos_type start = is.tellg();
+  if(start == std::istream::pos_type(-1)) {
+    is.clear(is.rdstate() & ~std::ios::failbit);
+    return UNKNOWN_SIZE;
+  }
+  is.seekg(0, std::ios::end);
+  const std::istream::pos_type end = is.tellg();
+  is.clear(is.rdstate() & ~std::ios::failbit);
+  is.seekg(start);
+  if(end == std::istream::pos_type(-1) || end < start) {
+    return UNKNOWN_SIZE;
+  }
+  return static_cast<std::uint64_t>(end - start);
+}
+
+/// Largest number of bytes readArray() allocates ahead of the data it reads
+/// from a stream whose size is unknown.
+constexpr std::size_t READ_CHUNK_BYTES = std::size_t(1) << 20;
+
+} // namespace detail
+
+/**
+ * @brief Returns the header describing an array of count elements of type E.
+ */
+template <typename E> inline ArrayHeader makeArrayHeader(std::size_t count) noexcept {
+  using Traits = detail::ArrayTraits<E>;
+  ArrayHeader header;
+  header.endianness   = static_cast<std::uint8_t>(nativeEndianness());
+  header.scalar_type  = static_cast<std::uint8_t>(Traits::SCALAR);
+  header.rows         = Traits::ROWS;
+  header.cols         = Traits::COLS;
+  header.alignment    = static_cast<std::uint16_t>(alignof(E));
+  header.element_size = static_cast<std::uint32_t>(sizeof(E));
+  header.count        = count;
+  header.data_offset  = detail::dataOffset(alignof(E));
+  return header;
+}
+
+/**
+ * @brief Writes the header of an array of count elements and the padding up to
+ * its data, which the caller writes next.
+ * @throws std::runtime_error if the stream fails.
+ */
+template <typename E> inline void writeArrayHeader(std::ostream& os, std::size_t count) {
+  static_assert(std::is_trivially_copyable<E>::value, "Serialized elements must be trivially copyable");
+  const ArrayHeader header                     = makeArrayHeader<E>(count);
+  const char        padding[DEFAULT_ALIGNMENT] = {};
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for(std::uint64_t offset = sizeof(header); offset < header.data_offset; offset += sizeof(padding)) {
+    const std::uint64_t size = header.data_offset - offset;
+    os.write(padding, static_cast<std::streamsize>(size < sizeof(padding) ? size : sizeof(padding)));
+  }
+  if(!os) {
+    throw std::runtime_error("linalg: failed to write serialized array");
+  }
+}
+
+/**
+ * @brief Reads and checks the header of a serialized array, leaving the stream
+ * positioned at its data.
+ * @return The number of elements.
+ * @throws std::runtime_error if the stream does not hold an array of E.
+ */
+template <typename E> inline std::size_t readArrayHeader(std::istream& is) {
+  // The count is checked against the bytes left in seekable streams. In others,
+  // truncation is only detected when reading the data.
+  const std::uint64_t size = detail::remainingBytes(is);
+  ArrayHeader         header;
+  if(!is.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    throw std::runtime_error("linalg: serialized array is truncated");
+  }
+  detail::validateHeader<E>(header, size);
+  if(header.count > std::numeric_limits<std::size_t>::max() / sizeof(E)) {
+    throw std::runtime_error("linalg: serialized array is too large");
+  }
+  is.ignore(static_cast<std::streamsize>(header.data_offset - sizeof(header)));
+  return static_cast<std::size_t>(header.count);
+}
+
+/**
+ * @brief Writes an array of elements to a binary stream.
+ * @param os The stream, opened in binary mode.
+ * @param data The elements.
+ * @param count The number of elements.
+ * @throws std::runtime_error if the stream fails.
+ */
+template <typename E> inline void writeArray(std::ostream& os, const E* data, std::size_t count) {
+  writeArrayHeader<E>(os, count);
+  os.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(E)));
+  if(!os) {
+    throw std::runtime_error("linalg: failed to write serialized array");
+  }
+}
+
+/**
+ * @brief Writes an array of elements to a file, replacing its contents.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+template <typename E> inline void writeArray(const std::string& path, const E* data, std::size_t count) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if(!file) {
+    throw std::runtime_error("linalg: cannot open " + path + " for writing");
+  }
+  writeArray(file, data, count);
+}
+
+/**
+ * @brief Writes a vector of elements to a file, replacing its contents.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+template <typename E, typename Alloc>
+inline void writeArray(const std::string& path, const std::vector<E, Alloc>& elements) {
+  writeArray(path, elements.data(), elements.size());
+}
+
+/**
+ * @brief Reads a serialized array from a binary stream into memory.
+ *
+ * Unlike MappedArray, this copies the elements, but works on any stream.
+ * @tparam E The element type, which must match the serialized one.
+ * @param is The stream, opened in binary mode and positioned at the header.
+ * @return The elements.
+ * @throws std::runtime_error if the stream does not hold an array of E.
+ */
+template <typename E> inline AlignedVector<E> readArray(std::istream& is) {
+  const std::size_t count = readArrayHeader<E>(is);
+  AlignedVector<E>  elements;
+  // The count of a stream of unknown size is not checked: the elements are
+  // then allocated as they are read, so a forged count cannot allocate much
+  // more memory than the stream holds.
+  const std::size_t chunk =
+      detail::remainingBytes(is) != detail::UNKNOWN_SIZE ? count : detail::READ_CHUNK_BYTES / sizeof(E) + 1;
+  while(elements.size() < count) {
+    const std::size_t offset = elements.size();
+    const std::size_t size   = count - offset < chunk ? count - offset : chunk;
+    elements.resize(offset + size);
+    if(!is.read(reinterpret_cast<char*>(elements.data() + offset), static_cast<std::streamsize>(size * sizeof(E)))) {
+      throw std::runtime_error("linalg: serialized array is truncated");
+    }
+  }
+  return elements;
+}
+
+/**
+ * @brief Reads a serialized array from a file into memory.
+ * @throws std::runtime_error if the file cannot be read or does not hold an
+ * array of E.
+ */
+template <typename E> inline AlignedVector<E> readArray(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if(!file) {
+    throw std::runtime_error("linalg: cannot open " + path);
+  }
+  return readArray<E>(file);
+}
+
+/**
+ * @brief Read-only view of a contiguous array of elements.
+ */
+template <typename E> class Span {
+public:
+  constexpr Span() noexcept = default;
+  constexpr Span(const E* data, std::size_t size) noexcept : m_data(data), m_size(size) {}
+
+  constexpr const E* data() const noexcept { return m_data; }
+  constexpr std::size_t size() const noexcept { return m_size; }
+  constexpr bool empty() const noexcept { return m_size == 0; }
+
+  constexpr const E* begin() const noexcept { return m_data; }
+  constexpr const E* end() const noexcept { return m_data + m_size; }
+
+  const E& operator[](std::size_t index) const noexcept { return m_data[index]; }
+
+private:
+  const E*    m_data = nullptr;
+  std::size_t m_size = 0;
+};
+
+/**
+ * @brief Read-only file mapped in memory.
+ *
+ * On platforms without mmap, the file is read into an aligned buffer instead.
+ */
+class MappedFile {
+public:
+  MappedFile() noexcept = default;
+
+  /**
+   * @brief Maps a whole file.
+   * @throws std::runtime_error if the file cannot be opened or mapped.
+   */
+  explicit MappedFile(const std::string& path) {
+#if LINALG_HAS_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if(fd < 0) {
+      throw std::runtime_error("linalg: cannot open " + path);
+    }
+    struct stat info {};
+    if(::fstat(fd, &info) != 0) {
+      ::close(fd);
+      throw std::runtime_error("linalg: cannot stat " + path);
+    }
+    m_size = static_cast<std::size_t>(info.st_size);
+    if(m_size > 0) {
+      void* mapped = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if(mapped == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("linalg: cannot map " + path);
+      }
+      m_data = static_cast<const unsigned char*>(mapped);
+    }
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if(!file) {
+      throw std::runtime_error("linalg: cannot open " + path);
+    }
+    m_size = static_cast<std::size_t>(file.tellg());
+    file.seekg(0);
+    void* buffer = alignedAlloc(m_size, DEFAULT_ALIGNMENT);
+    if(!file.read(static_cast<char*>(buffer), static_cast<std::streamsize>(m_size))) {
+      alignedFree(buffer);
+      throw std::runtime_error("linalg: cannot read " + path);
+    }
+    m_data = static_cast<const unsigned char*>(buffer);
+#endif
+  }
+
+  MappedFile(const MappedFile&)            = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept : m_data(other.m_data), m_size(other.m_size) {
+    other.m_data = nullptr;
+    other.m_size = 0;
+  }
+
+  MappedFile& operator=(MappedFile&& other) noexcept {
+    if(this != &other) {
+      release();
+      m_data       = other.m_data;
+      m_size       = other.m_size;
+      other.m_data = nullptr;
+      other.m_size = 0;
+    }
+    return *this;
+  }
+
+  ~MappedFile() { release(); }
+
+  /**
+   * @brief Returns the first byte of the file, aligned to at least
+   * DEFAULT_ALIGNMENT.
+   */
+  const unsigned char* data() const noexcept { return m_data; }
+
+  /**
+   * @brief Returns the size of the file in bytes.
+   */
+  std::size_t size() const noexcept { return m_size; }
+
+private:
+  void release() noexcept {
+    if(m_data != nullptr) {
+#if LINALG_HAS_MMAP
+      ::munmap(const_cast<unsigned char*>(m_data), m_size); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+#else
+      alignedFree(const_cast<unsigned char*>(m_data)); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+#endif
+    }
+    m_data = nullptr;
+    m_size = 0;
+  }
+
+  const unsigned char* m_data = nullptr;
+  std::size_t          m_size = 0;
+};
+
+/**
+ * @brief Serialized array file mapped in memory, whose elements are used in
+ * place.
+ * @tparam E The element type, which must match the serialized one.
+ */
+template <typename E> class MappedArray {
+public:
+  /**
+   * @brief Maps a file written by writeArray() and checks its header.
+   * @throws std::runtime_error if the file cannot be mapped or does not hold an
+   * array of E.
+   */
+  explicit MappedArray(const std::string& path) : m_file(path) {
+    ArrayHeader header;
+    if(m_file.size() < sizeof(header)) {
+      throw std::runtime_error("linalg: serialized array is truncated");
+    }
+    std::memcpy(&header, m_file.data(), sizeof(header));
+    detail::validateHeader<E>(header, m_file.size());
+    m_elements = Span<E>(reinterpret_cast<const E*>(m_file.data() + header.data_offset),
+                         static_cast<std::size_t>(header.count));
+  }
+
+  /**
+   * @brief Returns the elements, valid as long as this array.
+   */
+  Span<E> span() const noexcept { return m_elements; }
+
+  const E* data() const noexcept { return m_elements.data(); }
+  std::size_t size() const noexcept { return m_elements.size(); }
+  const E* begin() const noexcept { return m_elements.begin(); }
+  const E* end() const noexcept { return m_elements.end(); }
+
+  const E& operator[](std::size_t index) const noexcept { return m_elements[index]; }
+
+private:
+  MappedFile m_file;
+  Span<E>    m_elements;
+};
+
+} // namespace linalg
+
+#endif // LINALG_SERIALIZATION_HPP
@@ -0,0 +1,91 @@
+/**
+ * @file Simd.hpp
+ * @brief Compile-time detection of the SIMD instruction sets available to the
+ * library.
+ *
+ * Each LINALG_HAS_* macro is always defined, to 1 when the corresponding
+ * instruction set is enabled by the compiler flags and to 0 otherwise. Define
+ * LINALG_DISABLE_SIMD before including any linalg header to force the scalar
+ * code paths.
+ *
+ * Code whose body depends on these macros lives in the inline namespace
+ * LINALG_SIMD_ABI, named after the enabled instruction sets, so translation
+ * units built with different flags (such as the kernels of the runtime
+ * dispatch library) do not share symbols. Only the simd and detail kernels are
+ * tagged this way: translation units built for a specific instruction set
+ * should use those and raw pointers rather than the vector and matrix classes.
+ */
+#ifndef LINALG_SIMD_HPP
+#define LINALG_SIMD_HPP
+
+#if !defined(LINALG_DISABLE_SIMD) &&                                                                                   \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define LINALG_HAS_SSE2 1
+#else
+#define LINALG_HAS_SSE2 0
+#endif
+
+#if LINALG_HAS_SSE2 && (defined(__SSE4_1__) || defined(__AVX__))
+#define LINALG_HAS_SSE41 1
+#else
+#define LINALG_HAS_SSE41 0
+#endif
+
+#if LINALG_HAS_SSE2 && defined(__AVX__)
+#define LINALG_HAS_AVX 1
+#else
+#define LINALG_HAS_AVX 0
+#endif
+
+#if LINALG_HAS_AVX && defined(__AVX2__)
+#define LINALG_HAS_AVX2 1
+#else
+#define LINALG_HAS_AVX2 0
+#endif
+
+#if LINALG_HAS_AVX && defined(__FMA__)
+#define LINALG_HAS_FMA 1
+#else
+#define LINALG_HAS_FMA 0
+#endif
+
+#if LINALG_HAS_AVX && defined(__F16C__)
+#define LINALG_HAS_F16C 1
+#else
+#define LINALG_HAS_F16C 0
+#endif
+
+#if LINALG_HAS_AVX2 && LINALG_HAS_FMA && defined(__AVX512F__)
+#define LINALG_HAS_AVX512F 1
+#else
+#define LINALG_HAS_AVX512F 0
+#endif
+
+// NEON is only used on AArch64, where it is part of the base instruction set
+// and provides the double precision and across-lane reductions.
+#if !defined(LINALG_DISABLE_SIMD) && (defined(__aarch64__) || defined(_M_ARM64)) && defined(__ARM_NEON)
+#define LINALG_HAS_NEON 1
+#else
+#define LINALG_HAS_NEON 0
+#endif
+
+#if LINALG_HAS_SSE2
+#include <immintrin.h>
+#elif LINALG_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+#define LINALG_SIMD_ABI_CAT(SSE2, SSE41, AVX, AVX2, FMA, F16C, AVX512F, NEON)                                         \
+  simd_abi_##SSE2##SSE41##AVX##AVX2##FMA##F16C##AVX512F##NEON
+#define LINALG_SIMD_ABI_NAME(SSE2, SSE41, AVX, AVX2, FMA, F16C, AVX512F, NEON)                                        \
+  LINALG_SIMD_ABI_CAT(SSE2, SSE41, AVX, AVX2, FMA, F16C, AVX512F, NEON)
+
+/**
+ * @brief Name of the inline namespace holding the code compiled for the
+ * enabled instruction sets, e.g. simd_abi_11111000 with AVX2 and FMA.
+ */
+#define LINALG_SIMD_ABI                                                                                                \
+  LINALG_SIMD_ABI_NAME(LINALG_HAS_SSE2, LINALG_HAS_SSE41, LINALG_HAS_AVX, LINALG_HAS_AVX2, LINALG_HAS_FMA,             \
+                       LINALG_HAS_F16C, LINALG_HAS_AVX512F, LINALG_HAS_NEON)
+
+#endif // LINALG_SIMD_HPP
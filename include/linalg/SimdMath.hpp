@@ -0,0 +1,323 @@
+/**
+ * @file SimdMath.hpp
+ * @brief Vectorized sine, cosine, tangent, arc cosine and exponential of packs.
+ *
+ * The functions evaluate polynomial approximations on every lane with the
+ * arithmetic of Pack, without branches or tables, so that a pack of eight
+ * lanes costs about as much as one libm call. They are not correctly rounded:
+ * the bound on the error of each function, in units in the last place of the
+ * exact result, was measured against long double references on millions of
+ * points of the documented range, with and without FMA. They
+ * rely on IEEE arithmetic and must not be compiled with -ffast-math.
+ */
+#ifndef LINALG_SIMD_MATH_HPP
+#define LINALG_SIMD_MATH_HPP
+
+#include <cmath>
+#include <limits>
+
+#include "Pack.hpp"
+#include "Simd.hpp"
+
+namespace linalg {
+namespace simd {
+inline namespace LINALG_SIMD_ABI {
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace detail {
+
+/**
+ * @brief Rounds every lane to the nearest integer, ties to even, by adding and
+ * subtracting 1.5 * 2^(mantissa bits). Exact for magnitudes below 2^22 (float)
+ * or 2^51 (double).
+ */
+template <typename T, int N> inline Pack<T, N> roundNearest(const Pack<T, N>& x) noexcept {
+  const Pack<T, N> magic = Pack<T, N>::broadcast(T(1.5) / std::numeric_limits<T>::epsilon());
+  return (x + magic) - magic;
+}
+
+/**
+ * @brief Returns 2^k for lanes holding integers k in the range of the normal
+ * exponents of T.
+ */
+template <typename T, int N> inline Pack<T, N> pow2(const Pack<T, N>& k) noexcept {
+  Pack<T, N> r;
+  for(int i = 0; i < N; ++i) {
+    r.v[i] = std::ldexp(T(1), static_cast<int>(k.v[i]));
+  }
+  return r;
+}
+
+#if LINALG_HAS_SSE2
+// The exponent is built in the integer lanes and reinterpreted.
+inline Pack<float, 4> pow2(const Pack<float, 4>& k) noexcept {
+  return {_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(k.v), _mm_set1_epi32(127)), 23))};
+}
+inline Pack<double, 2> pow2(const Pack<double, 2>& k) noexcept {
+  // Two 32-bit exponents, moved to the high halves of the 64-bit lanes.
+  const __m128i e = _mm_slli_epi32(_mm_add_epi32(_mm_cvtpd_epi32(k.v), _mm_set1_epi32(1023)), 20);
+  return {_mm_castsi128_pd(_mm_unpacklo_epi32(_mm_setzero_si128(), e))};
+}
+#endif
+
+#if LINALG_HAS_AVX
+inline Pack<float, 8> pow2(const Pack<float, 8>& k) noexcept {
+#if LINALG_HAS_AVX2
+  return {_mm256_castsi256_ps(
+      _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(k.v), _mm256_set1_epi32(127)), 23))};
+#else
+  // AVX has no 256-bit integer arithmetic.
+  const Pack<float, 4> lo = pow2(Pack<float, 4>{_mm256_castps256_ps128(k.v)});
+  const Pack<float, 4> hi = pow2(Pack<float, 4>{_mm256_extractf128_ps(k.v, 1)});
+  return {_mm256_insertf128_ps(_mm256_castps128_ps256(lo.v), hi.v, 1)};
+#endif
+}
+inline Pack<double, 4> pow2(const Pack<double, 4>& k) noexcept {
+  const __m128i e  = _mm_slli_epi32(_mm_add_epi32(_mm256_cvtpd_epi32(k.v), _mm_set1_epi32(1023)), 20);
+  const __m128i lo = _mm_unpacklo_epi32(_mm_setzero_si128(), e);
+  const __m128i hi = _mm_unpackhi_epi32(_mm_setzero_si128(), e);
+  return {_mm256_castsi256_pd(_mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1))};
+}
+#endif
+
+#if LINALG_HAS_AVX512F
+inline Pack<float, 16> pow2(const Pack<float, 16>& k) noexcept { return {_mm512_scalef_ps(_mm512_set1_ps(1.0F), k.v)}; }
+inline Pack<double, 8> pow2(const Pack<double, 8>& k) noexcept { return {_mm512_scalef_pd(_mm512_set1_pd(1.0), k.v)}; }
+#endif
+
+#if LINALG_HAS_NEON
+inline Pack<float, 4> pow2(const Pack<float, 4>& k) noexcept {
+  return {vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vcvtnq_s32_f32(k.v), vdupq_n_s32(127)), 23))};
+}
+inline Pack<double, 2> pow2(const Pack<double, 2>& k) noexcept {
+  return {vreinterpretq_f64_s64(vshlq_n_s64(vaddq_s64(vcvtnq_s64_f64(k.v), vdupq_n_s64(1023)), 52))};
+}
+#endif
+
+/**
+ * @brief Evaluates the polynomial of count coefficients, from the highest
+ * degree down, at x by Horner's scheme.
+ */
+template <typename T, int N>
+inline Pack<T, N> polynomial(const Pack<T, N>& x, const T* coefficients, int count) noexcept {
+  Pack<T, N> r = Pack<T, N>::broadcast(coefficients[0]);
+  for(int i = 1; i < count; ++i) {
+    r = madd(r, x, Pack<T, N>::broadcast(coefficients[i]));
+  }
+  return r;
+}
+
+/**
+ * @brief Approximations of each precision, after range reduction. The
+ * coefficients are those of the Cephes library.
+ */
+template <typename T> struct MathKernels;
+
+template <> struct MathKernels<float> {
+  // pi / 2 in four parts, the first three of at most 11 significant bits so
+  // that their products by quadrants below 2^13 are exact, with or without
+  // FMA. The sum is within 1e-19 of pi / 2.
+  static constexpr float PIO2_1    = 1.570312500e+00F;
+  static constexpr float PIO2_2    = 4.837512970e-04F;
+  static constexpr float PIO2_3    = 7.549533620e-08F;
+  static constexpr float PIO2_4    = 2.563344068e-12F;
+  static constexpr float PIO2      = 1.57079632679489661923F;
+  static constexpr float PI_LO     = -8.74227766e-8F;
+  static constexpr float LN2_HI    = 0.693359375F;
+  static constexpr float LN2_LO    = -2.12194440e-4F;
+  static constexpr float EXP_MAX   = 88.7228393F;
+  static constexpr float EXP_MIN   = -87.3365479F;
+  static constexpr float EXP_K_MAX = 127;
+
+  /**
+   * @brief Sine and cosine of r in [-pi / 4, pi / 4].
+   */
+  template <int N>
+  static void sincos(const Pack<float, N>& r, Pack<float, N>& s, Pack<float, N>& c) noexcept {
+    static const float SIN[] = {-1.9515295891e-4F, 8.3321608736e-3F, -1.6666654611e-1F};
+    static const float COS[] = {2.443315711809948e-5F, -1.388731625493765e-3F, 4.166664568298827e-2F};
+    using P                  = Pack<float, N>;
+    const P z                = r * r;
+    s                        = madd(polynomial(z, SIN, 3) * z, r, r);
+    c                        = madd(polynomial(z, COS, 3) * z, z, madd(z, P::broadcast(-0.5F), P::broadcast(1)));
+  }
+
+  /**
+   * @brief Arc sine of t in [-0.5, 0.5].
+   */
+  template <int N> static Pack<float, N> asin(const Pack<float, N>& t) noexcept {
+    static const float ASIN[] = {4.2163199048e-2F, 2.4181311049e-2F, 4.5470025998e-2F, 7.4953002686e-2F,
+                                 1.6666752422e-1F};
+    const Pack<float, N> z    = t * t;
+    return madd(polynomial(z, ASIN, 5) * z, t, t);
+  }
+
+  /**
+   * @brief exp(r) for r in [-ln(2) / 2, ln(2) / 2].
+   */
+  template <int N> static Pack<float, N> exp(const Pack<float, N>& r) noexcept {
+    static const float EXP[] = {1.9875691500e-4F, 1.3981999507e-3F, 8.3334519073e-3F,
+                                4.1665795894e-2F, 1.6666665459e-1F, 5.0000001201e-1F};
+    using P                  = Pack<float, N>;
+    return madd(polynomial(r, EXP, 6) * r, r, r + P::broadcast(1));
+  }
+};
+
+template <> struct MathKernels<double> {
+  // The first three parts have at most 33 significant bits: exact products by
+  // quadrants below 2^20. The sum is within 1e-48 of pi / 2.
+  static constexpr double PIO2_1    = 1.57079632673412561e+00;
+  static constexpr double PIO2_2    = 6.07710050630396598e-11;
+  static constexpr double PIO2_3    = 2.02226624871116646e-21;
+  static constexpr double PIO2_4    = 8.47842766036889957e-32;
+  static constexpr double PIO2      = 1.57079632679489661923;
+  static constexpr double PI_LO     = 1.2246467991473532e-16;
+  static constexpr double LN2_HI    = 6.93145751953125e-1;
+  static constexpr double LN2_LO    = 1.42860682030941723212e-6;
+  static constexpr double EXP_MAX   = 709.782712893383973;
+  static constexpr double EXP_MIN   = -708.396418532264106;
+  static constexpr double EXP_K_MAX = 1023;
+
+  template <int N>
+  static void sincos(const Pack<double, N>& r, Pack<double, N>& s, Pack<double, N>& c) noexcept {
+    static const double SIN[] = {1.58962301576546568060e-10, -2.50507477628578072866e-8, 2.75573136213857245213e-6,
+                                 -1.98412698295895385996e-4, 8.33333333332211858878e-3,  -1.66666666666666307295e-1};
+    static const double COS[] = {-1.13585365213876817300e-11, 2.08757008419747316778e-9, -2.75573141792967388112e-7,
+                                 2.48015872888517045348e-5,   -1.38888888888730564116e-3, 4.16666666666665929218e-2};
+    using P                   = Pack<double, N>;
+    const P z                 = r * r;
+    s                         = madd(polynomial(z, SIN, 6) * z, r, r);
+    c                         = madd(polynomial(z, COS, 6) * z, z, madd(z, P::broadcast(-0.5), P::broadcast(1)));
+  }
+
+  template <int N> static Pack<double, N> asin(const Pack<double, N>& t) noexcept {
+    static const double P_[] = {4.253011369004428248960e-3, -6.019598008014123785661e-1, 5.444622390564711410273e0,
+                                -1.626247967210700244449e1, 1.956261983317594739197e1,   -8.198089802484824371615e0};
+    static const double Q_[] = {1.0,
+                                -1.474091372988853791896e1,
+                                7.049610280856842141659e1,
+                                -1.471791292232726029859e2,
+                                1.395105614657485689735e2,
+                                -4.918853881490881290097e1};
+    const Pack<double, N> z  = t * t;
+    return madd(t, z * polynomial(z, P_, 6) / polynomial(z, Q_, 6), t);
+  }
+
+  template <int N> static Pack<double, N> exp(const Pack<double, N>& r) noexcept {
+    // Pade approximation exp(r) = 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2)).
+    static const double P_[] = {1.26177193074810590878e-4, 3.02994407707441961300e-2, 9.99999999999999999910e-1};
+    static const double Q_[] = {3.00198505138664455042e-6, 2.52448340349684104192e-3, 2.27265548208155028766e-1,
+                                2.00000000000000000009e0};
+    using P                  = Pack<double, N>;
+    const P z                = r * r;
+    const P p                = r * polynomial(z, P_, 3);
+    return madd(P::broadcast(2), p / (polynomial(z, Q_, 4) - p), P::broadcast(1));
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Computes the sine and cosine of every lane.
+ *
+ * The argument is reduced to [-pi / 4, pi / 4] around the nearest multiple of
+ * pi / 2, exactly enough for the results next to the zeros to keep their
+ * relative accuracy. The error is at most 2.5 ulp for |x| <= 8192 (float) or
+ * |x| <= 1e6 (double), and grows with |x| beyond. Infinite and NaN lanes give
+ * NaN.
+ * @param x The angles in radians.
+ * @param s Receives the sines.
+ * @param c Receives the cosines.
+ */
+template <typename T, int N> inline void sincos(const Pack<T, N>& x, Pack<T, N>& s, Pack<T, N>& c) noexcept {
+  using K = detail::MathKernels<T>;
+  using P = Pack<T, N>;
+  const P k = detail::roundNearest(x * P::broadcast(T(1) / K::PIO2));
+  P       r = madd(k, P::broadcast(-K::PIO2_1), x);
+  r         = madd(k, P::broadcast(-K::PIO2_2), r);
+  r         = madd(k, P::broadcast(-K::PIO2_3), r);
+  r         = madd(k, P::broadcast(-K::PIO2_4), r);
+  P sin_r;
+  P cos_r;
+  K::sincos(r, sin_r, cos_r);
+
+  // Quadrant k mod 4, as q in [-2, 2]: odd quadrants swap the sine and the
+  // cosine, quadrants 2 and 3 negate the sine, 1 and 2 the cosine.
+  using Mask            = typename P::Mask;
+  const P    q          = k - P::broadcast(4) * detail::roundNearest(k * P::broadcast(T(0.25)));
+  const Mask swap       = abs(q) == P::broadcast(1);
+  const Mask negate_sin = (q < P::broadcast(T(-0.5))) | (q > P::broadcast(T(1.5)));
+  const Mask negate_cos = (q > P::broadcast(T(0.5))) | (q < P::broadcast(T(-1.5)));
+  s                     = select(swap, cos_r, sin_r);
+  c                     = select(swap, sin_r, cos_r);
+  s                     = select(negate_sin, -s, s);
+  c                     = select(negate_cos, -c, c);
+}
+
+/**
+ * @brief Computes the tangent of every lane as the quotient of sincos().
+ *
+ * The error is at most 4.5 ulp over the range where sincos() is within
+ * 2.5 ulp.
+ */
+template <typename T, int N> inline Pack<T, N> tan(const Pack<T, N>& x) noexcept {
+  Pack<T, N> s;
+  Pack<T, N> c;
+  sincos(x, s, c);
+  return s / c;
+}
+
+/**
+ * @brief Computes the arc cosine of every lane, in [0, pi], with an error of at
+ * most 1.5 ulp. Lanes outside [-1, 1] give NaN.
+ */
+template <typename T, int N> inline Pack<T, N> acos(const Pack<T, N>& x) noexcept {
+  using K = detail::MathKernels<T>;
+  using P = Pack<T, N>;
+  // acos(x) = pi / 2 - asin(x) for |x| <= 0.5, and 2 asin(sqrt((1 - |x|) / 2))
+  // mirrored for x < 0 beyond.
+  const P                a        = abs(x);
+  const typename P::Mask large    = a > P::broadcast(T(0.5));
+  const P                t        = select(large, sqrt((P::broadcast(1) - a) * P::broadcast(T(0.5))), x);
+  const P                asin     = K::asin(t);
+  const P                twice    = asin + asin;
+  const P                pi_lo    = P::broadcast(K::PI_LO);
+  const P                mirrored = (P::broadcast(2 * K::PIO2) - twice) + pi_lo;
+  const P                small    = (P::broadcast(K::PIO2) - asin) + pi_lo * P::broadcast(T(0.5));
+  return select(large, select(x < P::broadcast(0), mirrored, twice), small);
+}
+
+/**
+ * @brief Computes e^x for every lane, with an error of at most 1.5 ulp (float)
+ * or 2 ulp (double).
+ *
+ * Results that overflow give +infinity; results below the smallest normal
+ * number flush to zero. NaN lanes give NaN.
+ */
+template <typename T, int N> inline Pack<T, N> exp(const Pack<T, N>& x) noexcept {
+  using K = detail::MathKernels<T>;
+  using P = Pack<T, N>;
+  const P hi = P::broadcast(K::EXP_MAX);
+  const P lo = P::broadcast(K::EXP_MIN);
+  // x = k ln(2) + r with |r| <= ln(2) / 2.
+  const P xc = min(max(x, lo), hi);
+  const P k  = detail::roundNearest(xc * P::broadcast(T(1.44269504088896340736)));
+  P       r  = madd(k, P::broadcast(-K::LN2_HI), xc);
+  r          = madd(k, P::broadcast(-K::LN2_LO), r);
+  // Near the overflow threshold k is one past the largest exponent.
+  const P k_max  = P::broadcast(K::EXP_K_MAX);
+  const P scaled = K::exp(r) * detail::pow2(min(k, k_max));
+  P       result = select(k > k_max, scaled * P::broadcast(2), scaled);
+  result         = select(x > hi, P::broadcast(std::numeric_limits<T>::infinity()), result);
+  result         = select(x < lo, P::broadcast(0), result);
+  return select(x != x, x, result);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+} // namespace LINALG_SIMD_ABI
+} // namespace simd
+} // namespace linalg
+
+#endif // LINALG_SIMD_MATH_HPP
@@ -0,0 +1,331 @@
+/**
+ * @file Skinning.hpp
+ * @brief Indexed transforms and linear blend skinning over arrays of vertices.
+ *
+ * transformIndexed() applies a per-element matrix picked from an array by index,
+ * as for instancing. The skinning functions blend up to four joint matrices per
+ * vertex. SkinningPalette stores the joint matrices column by column, so that
+ * the blended matrix is accumulated in four SIMD registers with one multiply-add
+ * per column and influence, and applied to the vertex with three more. Vertices
+ * are processed two per iteration to overlap the two dependency chains, and the
+ * matrices of upcoming vertices are prefetched.
+ */
+#ifndef LINALG_SKINNING_HPP
+#define LINALG_SKINNING_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Mat4.hpp"
+#include "Mat4Kernels.hpp"
+#include "Memory.hpp"
+#include "Pack.hpp"
+#include "Vec3.hpp"
+#include "Vec4.hpp"
+
+#if LINALG_HAS_SSE2 && defined(_MSC_VER) && !defined(__clang__)
+#include <xmmintrin.h>
+#endif
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Joints influencing a vertex and their weights.
+ *
+ * Unused influences have a weight of zero (and any valid joint index). The
+ * weights of a vertex are expected to sum to one.
+ * @tparam T The type of the weights (e.g., float, double).
+ */
+template <typename T> struct JointInfluences {
+  static constexpr int COUNT = 4;
+
+  std::uint32_t joints[COUNT];
+  T             weights[COUNT];
+};
+
+/**
+ * @brief Joint matrices prepared for skinning: each Mat4 is stored as its four
+ * columns.
+ * @tparam T The type of the matrix elements (e.g., float, double).
+ */
+template <typename T> class SkinningPalette {
+public:
+  static constexpr std::size_t STRIDE = 16;
+
+  SkinningPalette() = default;
+
+  /**
+   * @brief Constructor that prepares an array of joint matrices.
+   * @param joints The joint matrices, usually world * inverse bind pose.
+   * @param count The number of joints.
+   */
+  SkinningPalette(const Mat4<T>* joints, std::size_t count) { update(joints, count); }
+
+  /**
+   * @brief Replaces the joint matrices, reusing the storage if it is large
+   * enough.
+   * @param joints The joint matrices.
+   * @param count The number of joints.
+   */
+  void update(const Mat4<T>* joints, std::size_t count) {
+    m_columns.resize(count * STRIDE);
+    for(std::size_t i = 0; i < count; ++i) {
+      T* columns = m_columns.data() + i * STRIDE;
+      for(int r = 0; r < 4; ++r) {
+        for(int c = 0; c < 4; ++c) {
+          columns[4 * c + r] = joints[i].m[r][c];
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Returns the number of joints.
+   */
+  std::size_t size() const noexcept { return m_columns.size() / STRIDE; }
+
+  /**
+   * @brief Returns the 16 elements of a joint, column by column.
+   */
+  const T* columns(std::size_t joint) const noexcept { return m_columns.data() + joint * STRIDE; }
+
+  /**
+   * @brief Returns the matrix of a joint.
+   */
+  Mat4<T> matrix(std::size_t joint) const noexcept {
+    const T* c = columns(joint);
+    return Mat4<T>::FromColumns(Vec4<T>(c[0], c[1], c[2], c[3]), Vec4<T>(c[4], c[5], c[6], c[7]),
+                                Vec4<T>(c[8], c[9], c[10], c[11]), Vec4<T>(c[12], c[13], c[14], c[15]));
+  }
+
+private:
+  AlignedVector<T> m_columns;
+};
+
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+/**
+ * @brief Number of elements ahead whose matrices are prefetched.
+ */
+constexpr std::size_t SKINNING_PREFETCH_DISTANCE = 8;
+
+/**
+ * @brief Hints that the cache line holding ptr will be read soon.
+ */
+inline void prefetch(const void* ptr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(ptr);
+#elif LINALG_HAS_SSE2
+  _mm_prefetch(static_cast<const char*>(ptr), _MM_HINT_T0);
+#else
+  (void)ptr;
+#endif
+}
+
+/**
+ * @brief Prefetches every cache line of a matrix of 16 elements of T.
+ */
+template <typename T> inline void prefetchMatrix(const T* matrix) noexcept {
+  for(std::size_t offset = 0; offset < 16 * sizeof(T); offset += DEFAULT_ALIGNMENT) {
+    prefetch(reinterpret_cast<const char*>(matrix) + offset);
+  }
+}
+
+/**
+ * @brief Matrix blended from the columns of a SkinningPalette, held in four
+ * packs.
+ */
+template <typename T> struct BlendedMatrix {
+  using P = simd::Pack<T, 4>;
+
+  P c0, c1, c2, c3;
+
+  BlendedMatrix(const T* palette, const JointInfluences<T>& influences) noexcept {
+    const T* m = palette + influences.joints[0] * SkinningPalette<T>::STRIDE;
+    P        w = P::broadcast(influences.weights[0]);
+    c0         = w * P::load(m);
+    c1         = w * P::load(m + 4);
+    c2         = w * P::load(m + 8);
+    c3         = w * P::load(m + 12);
+    for(int k = 1; k < JointInfluences<T>::COUNT; ++k) {
+      m  = palette + influences.joints[k] * SkinningPalette<T>::STRIDE;
+      w  = P::broadcast(influences.weights[k]);
+      c0 = simd::madd(w, P::load(m), c0);
+      c1 = simd::madd(w, P::load(m + 4), c1);
+      c2 = simd::madd(w, P::load(m + 8), c2);
+      c3 = simd::madd(w, P::load(m + 12), c3);
+    }
+  }
+
+  P transformPoint(const Vec3<T>& p) const noexcept {
+    const P xy = simd::madd(c1, P::broadcast(p.y), simd::madd(c0, P::broadcast(p.x), c3));
+    return simd::madd(c2, P::broadcast(p.z), xy);
+  }
+
+  P transformDirection(const Vec3<T>& d) const noexcept {
+    return simd::madd(c2, P::broadcast(d.z), simd::madd(c1, P::broadcast(d.y), c0 * P::broadcast(d.x)));
+  }
+};
+
+template <typename T> inline void storeVec3(const simd::Pack<T, 4>& p, Vec3<T>& out) noexcept {
+  static_assert(sizeof(Vec3<T>) == 4 * sizeof(T), "Vec3 is expected to be padded to four elements");
+  p.store(&out.x);
+}
+
+template <typename T> inline void prefetchInfluences(const T* palette, const JointInfluences<T>& influences) noexcept {
+  for(int k = 0; k < JointInfluences<T>::COUNT; ++k) {
+    prefetchMatrix(palette + influences.joints[k] * SkinningPalette<T>::STRIDE);
+  }
+}
+
+/**
+ * @brief Runs vertex(i) for every vertex, two per iteration, prefetching the
+ * joints of the vertices SKINNING_PREFETCH_DISTANCE ahead.
+ */
+template <typename T, typename Vertex>
+inline void forEachSkinnedVertex(const SkinningPalette<T>& palette, const JointInfluences<T>* influences,
+                                 std::size_t count, const Vertex& vertex) noexcept {
+  const T*    columns = palette.columns(0);
+  std::size_t i       = 0;
+  for(; i + 2 <= count; i += 2) {
+    if(i + SKINNING_PREFETCH_DISTANCE + 1 < count) {
+      prefetchInfluences(columns, influences[i + SKINNING_PREFETCH_DISTANCE]);
+      prefetchInfluences(columns, influences[i + SKINNING_PREFETCH_DISTANCE + 1]);
+    }
+    const BlendedMatrix<T> a(columns, influences[i]);
+    const BlendedMatrix<T> b(columns, influences[i + 1]);
+    vertex(i, a);
+    vertex(i + 1, b);
+  }
+  if(i < count) {
+    vertex(i, BlendedMatrix<T>(columns, influences[i]));
+  }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+
+/**
+ * @brief Transforms each vector by the matrix selected by its index:
+ * out[i] = matrices[indices[i]] * in[i].
+ * @param matrices The matrices.
+ * @param indices The index of the matrix of each vector, smaller than the
+ * number of matrices.
+ * @param in The input vectors.
+ * @param out The output vectors. It may be the same array as in but must not
+ * otherwise overlap it.
+ * @param count The number of vectors.
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+inline void transformIndexed(const Mat4<T>* matrices, const std::uint32_t* indices, const Vec4<T>* in, Vec4<T>* out,
+                             std::size_t count) noexcept {
+  for(std::size_t i = 0; i < count; ++i) {
+    if(i + detail::SKINNING_PREFETCH_DISTANCE < count) {
+      detail::prefetchMatrix(matrices[indices[i + detail::SKINNING_PREFETCH_DISTANCE]].data());
+    }
+    const Vec4<T> v = in[i];
+    detail::Mat4Kernels<T>::transform(matrices[indices[i]].data(), &v.x, &out[i].x);
+  }
+}
+
+/**
+ * @brief Transforms each point by the matrix selected by its index:
+ * out[i] = toVec3(matrices[indices[i]] * toVec4(in[i])), without a perspective
+ * divide.
+ * @param matrices The matrices.
+ * @param indices The index of the matrix of each point.
+ * @param in The input points.
+ * @param out The output points. It may be the same array as in but must not
+ * otherwise overlap it.
+ * @param count The number of points.
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+inline void transformPointsIndexed(const Mat4<T>* matrices, const std::uint32_t* indices, const Vec3<T>* in,
+                                   Vec3<T>* out, std::size_t count) noexcept {
+  for(std::size_t i = 0; i < count; ++i) {
+    if(i + detail::SKINNING_PREFETCH_DISTANCE < count) {
+      detail::prefetchMatrix(matrices[indices[i + detail::SKINNING_PREFETCH_DISTANCE]].data());
+    }
+    const Vec4<T> p(in[i].x, in[i].y, in[i].z, T(1));
+    Vec4<T>       r;
+    detail::Mat4Kernels<T>::transform(matrices[indices[i]].data(), &p.x, &r.x);
+    out[i] = Vec3<T>(r.x, r.y, r.z);
+  }
+}
+
+/**
+ * @brief Skins points: out[i] = sum_k weights[k] * joints[k] * in[i], without a
+ * perspective divide.
+ * @param palette The joint matrices.
+ * @param influences The joints and weights of each point.
+ * @param in The input points, in bind pose.
+ * @param out The output points. It may be the same array as in but must not
+ * otherwise overlap it.
+ * @param count The number of points.
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+inline void skinPoints(const SkinningPalette<T>& palette, const JointInfluences<T>* influences, const Vec3<T>* in,
+                       Vec3<T>* out, std::size_t count) noexcept {
+  detail::forEachSkinnedVertex(palette, influences, count, [&](std::size_t i, const detail::BlendedMatrix<T>& m) {
+    detail::storeVec3(m.transformPoint(in[i]), out[i]);
+  });
+}
+
+/**
+ * @brief Skins directions, ignoring the translation of the joints. Normals are
+ * transformed correctly when the joints have no non-uniform scale, and should
+ * be renormalized afterwards.
+ * @param palette The joint matrices.
+ * @param influences The joints and weights of each direction.
+ * @param in The input directions, in bind pose.
+ * @param out The output directions. It may be the same array as in but must not
+ * otherwise overlap it.
+ * @param count The number of directions.
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+inline void skinDirections(const SkinningPalette<T>& palette, const JointInfluences<T>* influences,
+                           const Vec3<T>* in, Vec3<T>* out, std::size_t count) noexcept {
+  detail::forEachSkinnedVertex(palette, influences, count, [&](std::size_t i, const detail::BlendedMatrix<T>& m) {
+    detail::storeVec3(m.transformDirection(in[i]), out[i]);
+  });
+}
+
+/**
+ * @brief Skins positions and normals with a single blended matrix per vertex.
+ * @param palette The joint matrices.
+ * @param influences The joints and weights of each vertex.
+ * @param positions_in The input positions, in bind pose.
+ * @param normals_in The input normals, in bind pose.
+ * @param positions_out The output positions.
+ * @param normals_out The output normals, not renormalized.
+ * @param count The number of vertices.
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+inline void skinVertices(const SkinningPalette<T>& palette, const JointInfluences<T>* influences,
+                         const Vec3<T>* positions_in, const Vec3<T>* normals_in, Vec3<T>* positions_out,
+                         Vec3<T>* normals_out, std::size_t count) noexcept {
+  detail::forEachSkinnedVertex(palette, influences, count, [&](std::size_t i, const detail::BlendedMatrix<T>& m) {
+    const Vec3<T> position = positions_in[i];
+    const Vec3<T> normal   = normals_in[i];
+    detail::storeVec3(m.transformPoint(position), positions_out[i]);
+    detail::storeVec3(m.transformDirection(normal), normals_out[i]);
+  });
+}
+
+} // namespace linalg
+
+#endif // LINALG_SKINNING_HPP
@@ -0,0 +1,669 @@
+/**
+ * @file SoA.hpp
+ * @brief Structure-of-arrays containers for Vec3 and Vec4, with bulk
+ * operations vectorized across elements.
+ *
+ * Each component is stored in its own cache-line aligned array, so one SIMD
+ * register holds the same component of several consecutive vectors. The bulk
+ * operations mirror the per-vector API of Vec3.hpp, Vec4.hpp and linalg.hpp.
+ */
+#ifndef LINALG_SOA_HPP
+#define LINALG_SOA_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "Memory.hpp"
+#include "Pack.hpp"
+#include "Vec3.hpp"
+#include "Vec3Packet.hpp"
+#include "Vec4.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Array of Vec3 stored as three separate aligned arrays.
+ * @tparam T The type of the vector elements (e.g., float, double).
+ */
+template <typename T> class Vec3SoA {
+public:
+  using Storage = AlignedVector<T>;
+
+  /**
+   * @brief Constructs an empty container.
+   */
+  Vec3SoA() = default;
+
+  /**
+   * @brief Constructs a container of count zero vectors.
+   * @param count The number of vectors.
+   */
+  explicit Vec3SoA(std::size_t count) : m_x(count), m_y(count), m_z(count) {}
+
+  /**
+   * @brief Creates a container from an array of Vec3.
+   * @param in The vectors to copy.
+   * @param count The number of vectors.
+   * @return A Vec3SoA holding a copy of the vectors.
+   */
+  static Vec3SoA FromAoS(const Vec3<T>* in, std::size_t count) {
+    Vec3SoA soa(count);
+    for(std::size_t i = 0; i < count; ++i) {
+      soa.m_x[i] = in[i].x;
+      soa.m_y[i] = in[i].y;
+      soa.m_z[i] = in[i].z;
+    }
+    return soa;
+  }
+
+  /**
+   * @brief Copies the vectors to an array of Vec3.
+   * @param out The destination array, holding at least size() vectors.
+   */
+  void toAoS(Vec3<T>* out) const noexcept {
+    for(std::size_t i = 0; i < size(); ++i) {
+      out[i] = Vec3<T>(m_x[i], m_y[i], m_z[i]);
+    }
+  }
+
+  /**
+   * @brief Returns the number of vectors.
+   */
+  std::size_t size() const noexcept { return m_x.size(); }
+
+  /**
+   * @brief Resizes the container, new vectors being zero.
+   * @param count The new number of vectors.
+   */
+  void resize(std::size_t count) {
+    m_x.resize(count);
+    m_y.resize(count);
+    m_z.resize(count);
+  }
+
+  /**
+   * @brief Returns the vector at the specified index.
+   * @param index The index of the vector.
+   */
+  Vec3<T> get(std::size_t index) const noexcept { return {m_x[index], m_y[index], m_z[index]}; }
+
+  /**
+   * @brief Sets the vector at the specified index.
+   * @param index The index of the vector.
+   * @param value The new value of the vector.
+   */
+  void set(std::size_t index, const Vec3<T>& value) noexcept {
+    m_x[index] = value.x;
+    m_y[index] = value.y;
+    m_z[index] = value.z;
+  }
+
+  T*       x() noexcept { return m_x.data(); }
+  const T* x() const noexcept { return m_x.data(); }
+  T*       y() noexcept { return m_y.data(); }
+  const T* y() const noexcept { return m_y.data(); }
+  T*       z() noexcept { return m_z.data(); }
+  const T* z() const noexcept { return m_z.data(); }
+
+private:
+  Storage m_x;
+  Storage m_y;
+  Storage m_z;
+};
+
+/**
+ * @brief Array of Vec4 stored as four separate aligned arrays.
+ * @tparam T The type of the vector elements (e.g., float, double).
+ */
+template <typename T> class Vec4SoA {
+public:
+  using Storage = AlignedVector<T>;
+
+  /**
+   * @brief Constructs an empty container.
+   */
+  Vec4SoA() = default;
+
+  /**
+   * @brief Constructs a container of count zero vectors.
+   * @param count The number of vectors.
+   */
+  explicit Vec4SoA(std::size_t count) : m_x(count), m_y(count), m_z(count), m_w(count) {}
+
+  /**
+   * @brief Creates a container from an array of Vec4.
+   * @param in The vectors to copy.
+   * @param count The number of vectors.
+   * @return A Vec4SoA holding a copy of the vectors.
+   */
+  static Vec4SoA FromAoS(const Vec4<T>* in, std::size_t count) {
+    Vec4SoA soa(count);
+    for(std::size_t i = 0; i < count; ++i) {
+      soa.m_x[i] = in[i].x;
+      soa.m_y[i] = in[i].y;
+      soa.m_z[i] = in[i].z;
+      soa.m_w[i] = in[i].w;
+    }
+    return soa;
+  }
+
+  /**
+   * @brief Copies the vectors to an array of Vec4.
+   * @param out The destination array, holding at least size() vectors.
+   */
+  void toAoS(Vec4<T>* out) const noexcept {
+    for(std::size_t i = 0; i < size(); ++i) {
+      out[i] = Vec4<T>(m_x[i], m_y[i], m_z[i], m_w[i]);
+    }
+  }
+
+  /**
+   * @brief Returns the number of vectors.
+   */
+  std::size_t size() const noexcept { return m_x.size(); }
+
+  /**
+   * @brief Resizes the container, new vectors being zero.
+   * @param count The new number of vectors.
+   */
+  void resize(std::size_t count) {
+    m_x.resize(count);
+    m_y.resize(count);
+    m_z.resize(count);
+    m_w.resize(count);
+  }
+
+  /**
+   * @brief Returns the vector at the specified index.
+   * @param index The index of the vector.
+   */
+  Vec4<T> get(std::size_t index) const noexcept { return {m_x[index], m_y[index], m_z[index], m_w[index]}; }
+
+  /**
+   * @brief Sets the vector at the specified index.
+   * @param index The index of the vector.
+   * @param value The new value of the vector.
+   */
+  void set(std::size_t index, const Vec4<T>& value) noexcept {
+    m_x[index] = value.x;
+    m_y[index] = value.y;
+    m_z[index] = value.z;
+    m_w[index] = value.w;
+  }
+
+  T*       x() noexcept { return m_x.data(); }
+  const T* x() const noexcept { return m_x.data(); }
+  T*       y() noexcept { return m_y.data(); }
+  const T* y() const noexcept { return m_y.data(); }
+  T*       z() noexcept { return m_z.data(); }
+  const T* z() const noexcept { return m_z.data(); }
+  T*       w() noexcept { return m_w.data(); }
+  const T* w() const noexcept { return m_w.data(); }
+
+private:
+  Storage m_x;
+  Storage m_y;
+  Storage m_z;
+  Storage m_w;
+};
+
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+/**
+ * @brief Applies kernel to [0, count), NativePack<T>::WIDTH elements at a time
+ * and then one element at a time for the remainder.
+ * @param count The number of elements.
+ * @param kernel A functor with a member template apply<P>(index) processing
+ * elements [index, index + P::WIDTH).
+ */
+template <typename T, typename Kernel> inline void forEachPack(std::size_t count, const Kernel& kernel) noexcept {
+  using P       = simd::NativePack<T>;
+  std::size_t i = 0;
+  for(; i + P::WIDTH <= count; i += P::WIDTH) {
+    kernel.template apply<P>(i);
+  }
+  for(; i < count; ++i) {
+    kernel.template apply<simd::Pack<T, 1>>(i);
+  }
+}
+
+/**
+ * @brief Throws std::invalid_argument if two containers differ in size.
+ */
+inline void checkSameSize(std::size_t a, std::size_t b) {
+  if(a != b) {
+    throw std::invalid_argument("SoA containers must have the same size.");
+  }
+}
+
+template <typename T> struct SoA3Dot {
+  const T* ax;
+  const T* ay;
+  const T* az;
+  const T* bx;
+  const T* by;
+  const T* bz;
+  T*       out;
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    using V = Vec3Packet<T, P::WIDTH>;
+    dot(V::Load(ax + i, ay + i, az + i), V::Load(bx + i, by + i, bz + i)).store(out + i);
+  }
+};
+
+template <typename T> struct SoA3Cross {
+  const T* ax;
+  const T* ay;
+  const T* az;
+  const T* bx;
+  const T* by;
+  const T* bz;
+  T*       ox;
+  T*       oy;
+  T*       oz;
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    using V = Vec3Packet<T, P::WIDTH>;
+    cross(V::Load(ax + i, ay + i, az + i), V::Load(bx + i, by + i, bz + i)).store(ox + i, oy + i, oz + i);
+  }
+};
+
+template <typename T> struct SoA3Normalize {
+  const T* ax;
+  const T* ay;
+  const T* az;
+  T*       ox;
+  T*       oy;
+  T*       oz;
+  bool     keep_zero; ///< Zero-length vectors are left unchanged instead of set to zero.
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    const P    x    = P::load(ax + i);
+    const P    y    = P::load(ay + i);
+    const P    z    = P::load(az + i);
+    const P    len  = simd::sqrt(simd::madd(x, x, simd::madd(y, y, z * z)));
+    const P    inv  = P::broadcast(T(1)) / len;
+    const auto mask = len > P::broadcast(T(0));
+    const P    zero = P::broadcast(T(0));
+    simd::select(mask, x * inv, keep_zero ? x : zero).store(ox + i);
+    simd::select(mask, y * inv, keep_zero ? y : zero).store(oy + i);
+    simd::select(mask, z * inv, keep_zero ? z : zero).store(oz + i);
+  }
+};
+
+template <typename T> struct SoA3NormalizeFast {
+  const T* ax;
+  const T* ay;
+  const T* az;
+  T*       ox;
+  T*       oy;
+  T*       oz;
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    using V = Vec3Packet<T, P::WIDTH>;
+    normalizedFast(V::Load(ax + i, ay + i, az + i)).store(ox + i, oy + i, oz + i);
+  }
+};
+
+template <typename T> struct SoA3Reflect {
+  const T* ix;
+  const T* iy;
+  const T* iz;
+  const T* nx;
+  const T* ny;
+  const T* nz;
+  T*       ox;
+  T*       oy;
+  T*       oz;
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    using V = Vec3Packet<T, P::WIDTH>;
+    reflect(V::Load(ix + i, iy + i, iz + i), V::Load(nx + i, ny + i, nz + i)).store(ox + i, oy + i, oz + i);
+  }
+};
+
+template <typename T> struct SoA3Refract {
+  const T* ix;
+  const T* iy;
+  const T* iz;
+  const T* nx;
+  const T* ny;
+  const T* nz;
+  T*       ox;
+  T*       oy;
+  T*       oz;
+  T        eta;
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    using V = Vec3Packet<T, P::WIDTH>;
+    refract(V::Load(ix + i, iy + i, iz + i), V::Load(nx + i, ny + i, nz + i), eta).store(ox + i, oy + i, oz + i);
+  }
+};
+
+template <typename T> struct SoA4Dot {
+  const T* ax;
+  const T* ay;
+  const T* az;
+  const T* aw;
+  const T* bx;
+  const T* by;
+  const T* bz;
+  const T* bw;
+  T*       out;
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    const P r = simd::madd(
+        P::load(ax + i), P::load(bx + i),
+        simd::madd(P::load(ay + i), P::load(by + i), simd::madd(P::load(az + i), P::load(bz + i), P::load(aw + i) * P::load(bw + i))));
+    r.store(out + i);
+  }
+};
+
+template <typename T> struct SoA4Normalize {
+  const T* ax;
+  const T* ay;
+  const T* az;
+  const T* aw;
+  T*       ox;
+  T*       oy;
+  T*       oz;
+  T*       ow;
+  bool     keep_zero; ///< Zero-length vectors are left unchanged instead of set to zero.
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    const P    x    = P::load(ax + i);
+    const P    y    = P::load(ay + i);
+    const P    z    = P::load(az + i);
+    const P    w    = P::load(aw + i);
+    const P    len  = simd::sqrt(simd::madd(x, x, simd::madd(y, y, simd::madd(z, z, w * w))));
+    const P    inv  = P::broadcast(T(1)) / len;
+    const auto mask = len > P::broadcast(T(0));
+    const P    zero = P::broadcast(T(0));
+    simd::select(mask, x * inv, keep_zero ? x : zero).store(ox + i);
+    simd::select(mask, y * inv, keep_zero ? y : zero).store(oy + i);
+    simd::select(mask, z * inv, keep_zero ? z : zero).store(oz + i);
+    simd::select(mask, w * inv, keep_zero ? w : zero).store(ow + i);
+  }
+};
+
+/**
+ * @brief Element-wise clamp of one component array: min(max(a, lo), hi).
+ * Either bound may be null to skip it.
+ */
+template <typename T> struct SoAClamp {
+  const T* a;
+  const T* lo;
+  const T* hi;
+  T*       out;
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    P r = P::load(a + i);
+    if(lo != nullptr) {
+      r = simd::fmax(r, P::load(lo + i));
+    }
+    if(hi != nullptr) {
+      r = simd::fmin(r, P::load(hi + i));
+    }
+    r.store(out + i);
+  }
+};
+
+template <typename T> inline void clampArray(const T* a, const T* lo, const T* hi, T* out, std::size_t count) noexcept {
+  forEachPack<T>(count, SoAClamp<T>{a, lo, hi, out});
+}
+
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+
+/**
+ * @brief Computes the dot products of two arrays of vectors.
+ * @param a The first vectors.
+ * @param b The second vectors.
+ * @param out The destination array, holding at least a.size() elements.
+ * @throws std::invalid_argument if a and b differ in size.
+ */
+template <typename T> inline void dot(const Vec3SoA<T>& a, const Vec3SoA<T>& b, T* out) {
+  detail::checkSameSize(a.size(), b.size());
+  detail::forEachPack<T>(a.size(), detail::SoA3Dot<T>{a.x(), a.y(), a.z(), b.x(), b.y(), b.z(), out});
+}
+
+/**
+ * @brief Computes the cross products of two arrays of vectors.
+ * @param a The first vectors.
+ * @param b The second vectors.
+ * @param out The destination, resized to a.size(). It may be a or b.
+ * @throws std::invalid_argument if a and b differ in size.
+ */
+template <typename T> inline void cross(const Vec3SoA<T>& a, const Vec3SoA<T>& b, Vec3SoA<T>& out) {
+  detail::checkSameSize(a.size(), b.size());
+  out.resize(a.size());
+  detail::forEachPack<T>(
+      a.size(), detail::SoA3Cross<T>{a.x(), a.y(), a.z(), b.x(), b.y(), b.z(), out.x(), out.y(), out.z()});
+}
+
+/**
+ * @brief Normalizes an array of vectors; zero-length vectors become zero, as
+ * with Vec3::normalized().
+ * @param in The vectors to normalize.
+ * @param out The destination, resized to in.size(). It may be in.
+ */
+template <typename T> inline void normalized(const Vec3SoA<T>& in, Vec3SoA<T>& out) {
+  out.resize(in.size());
+  detail::forEachPack<T>(in.size(),
+                         detail::SoA3Normalize<T>{in.x(), in.y(), in.z(), out.x(), out.y(), out.z(), false});
+}
+
+/**
+ * @brief Approximately normalizes an array of vectors with simd::rsqrtFast(), with
+ * the accuracy of Vec3::normalizedFast(); the sqrt and division of normalized()
+ * are replaced by an estimate and a multiplication.
+ * @param in The vectors to normalize.
+ * @param out The destination, resized to in.size(). It may be in.
+ * @note Vectors whose squared length is zero, subnormal or overflows become zero.
+ */
+template <typename T> inline void normalizedFast(const Vec3SoA<T>& in, Vec3SoA<T>& out) {
+  out.resize(in.size());
+  detail::forEachPack<T>(in.size(),
+                         detail::SoA3NormalizeFast<T>{in.x(), in.y(), in.z(), out.x(), out.y(), out.z()});
+}
+
+/**
+ * @brief Normalizes an array of vectors in place; zero-length vectors are left
+ * unchanged, as with Vec3::normalize().
+ * @param vectors The vectors to normalize.
+ */
+template <typename T> inline void normalize(Vec3SoA<T>& vectors) noexcept {
+  detail::forEachPack<T>(vectors.size(), detail::SoA3Normalize<T>{vectors.x(), vectors.y(), vectors.z(), vectors.x(),
+                                                                  vectors.y(), vectors.z(), true});
+}
+
+/**
+ * @brief Computes the element-wise minimum of two arrays of vectors.
+ * @param a The first vectors.
+ * @param b The second vectors.
+ * @param out The destination, resized to a.size(). It may be a or b.
+ * @throws std::invalid_argument if a and b differ in size.
+ * @note As std::fmin, a NaN component of one input gives the component of the
+ * other.
+ */
+template <typename T> inline void cwiseMin(const Vec3SoA<T>& a, const Vec3SoA<T>& b, Vec3SoA<T>& out) {
+  detail::checkSameSize(a.size(), b.size());
+  out.resize(a.size());
+  detail::clampArray<T>(a.x(), nullptr, b.x(), out.x(), a.size());
+  detail::clampArray<T>(a.y(), nullptr, b.y(), out.y(), a.size());
+  detail::clampArray<T>(a.z(), nullptr, b.z(), out.z(), a.size());
+}
+
+/**
+ * @brief Computes the element-wise maximum of two arrays of vectors.
+ * @param a The first vectors.
+ * @param b The second vectors.
+ * @param out The destination, resized to a.size(). It may be a or b.
+ * @throws std::invalid_argument if a and b differ in size.
+ * @note As std::fmax, a NaN component of one input gives the component of the
+ * other.
+ */
+template <typename T> inline void cwiseMax(const Vec3SoA<T>& a, const Vec3SoA<T>& b, Vec3SoA<T>& out) {
+  detail::checkSameSize(a.size(), b.size());
+  out.resize(a.size());
+  detail::clampArray<T>(a.x(), b.x(), nullptr, out.x(), a.size());
+  detail::clampArray<T>(a.y(), b.y(), nullptr, out.y(), a.size());
+  detail::clampArray<T>(a.z(), b.z(), nullptr, out.z(), a.size());
+}
+
+/**
+ * @brief Clamps an array of vectors element-wise between two other arrays.
+ * @param a The vectors to clamp.
+ * @param min The lower bounds.
+ * @param max The upper bounds.
+ * @param out The destination, resized to a.size(). It may be any of the inputs.
+ * @throws std::invalid_argument if the inputs differ in size.
+ */
+template <typename T>
+inline void cwiseClamp(const Vec3SoA<T>& a, const Vec3SoA<T>& min, const Vec3SoA<T>& max, Vec3SoA<T>& out) {
+  detail::checkSameSize(a.size(), min.size());
+  detail::checkSameSize(a.size(), max.size());
+  out.resize(a.size());
+  detail::clampArray<T>(a.x(), min.x(), max.x(), out.x(), a.size());
+  detail::clampArray<T>(a.y(), min.y(), max.y(), out.y(), a.size());
+  detail::clampArray<T>(a.z(), min.z(), max.z(), out.z(), a.size());
+}
+
+/**
+ * @brief Reflects an array of incident vectors around an array of normals.
+ * @param incident The incident vectors (must be normalized).
+ * @param normal The normal vectors (must be normalized).
+ * @param out The destination, resized to incident.size(). It may be any of the
+ * inputs.
+ * @throws std::invalid_argument if the inputs differ in size.
+ */
+template <typename T> inline void reflect(const Vec3SoA<T>& incident, const Vec3SoA<T>& normal, Vec3SoA<T>& out) {
+  detail::checkSameSize(incident.size(), normal.size());
+  out.resize(incident.size());
+  detail::forEachPack<T>(incident.size(),
+                         detail::SoA3Reflect<T>{incident.x(), incident.y(), incident.z(), normal.x(), normal.y(),
+                                                normal.z(), out.x(), out.y(), out.z()});
+}
+
+/**
+ * @brief Refracts an array of incident vectors through surfaces with the given
+ * normals and refractive index ratio.
+ *
+ * Lanes in total internal reflection are reflected instead, as with refract()
+ * in linalg.hpp; both results are computed and blended without branching.
+ * @param incident The incident vectors (must be normalized).
+ * @param normal The normal vectors (must be normalized).
+ * @param eta The ratio of refractive indices (n1 / n2).
+ * @param out The destination, resized to incident.size(). It may be any of the
+ * inputs.
+ * @throws std::invalid_argument if the inputs differ in size.
+ */
+template <typename T>
+inline void refract(const Vec3SoA<T>& incident, const Vec3SoA<T>& normal, T eta, Vec3SoA<T>& out) {
+  detail::checkSameSize(incident.size(), normal.size());
+  out.resize(incident.size());
+  detail::forEachPack<T>(incident.size(),
+                         detail::SoA3Refract<T>{incident.x(), incident.y(), incident.z(), normal.x(), normal.y(),
+                                                normal.z(), out.x(), out.y(), out.z(), eta});
+}
+
+/**
+ * @brief Computes the dot products of two arrays of vectors.
+ * @param a The first vectors.
+ * @param b The second vectors.
+ * @param out The destination array, holding at least a.size() elements.
+ * @throws std::invalid_argument if a and b differ in size.
+ */
+template <typename T> inline void dot(const Vec4SoA<T>& a, const Vec4SoA<T>& b, T* out) {
+  detail::checkSameSize(a.size(), b.size());
+  detail::forEachPack<T>(a.size(),
+                         detail::SoA4Dot<T>{a.x(), a.y(), a.z(), a.w(), b.x(), b.y(), b.z(), b.w(), out});
+}
+
+/**
+ * @brief Normalizes an array of vectors; zero-length vectors become zero, as
+ * with Vec4::normalized().
+ * @param in The vectors to normalize.
+ * @param out The destination, resized to in.size(). It may be in.
+ */
+template <typename T> inline void normalized(const Vec4SoA<T>& in, Vec4SoA<T>& out) {
+  out.resize(in.size());
+  detail::forEachPack<T>(in.size(), detail::SoA4Normalize<T>{in.x(), in.y(), in.z(), in.w(), out.x(), out.y(),
+                                                             out.z(), out.w(), false});
+}
+
+/**
+ * @brief Normalizes an array of vectors in place; zero-length vectors are left
+ * unchanged, as with Vec4::normalize().
+ * @param vectors The vectors to normalize.
+ */
+template <typename T> inline void normalize(Vec4SoA<T>& vectors) noexcept {
+  detail::forEachPack<T>(vectors.size(),
+                         detail::SoA4Normalize<T>{vectors.x(), vectors.y(), vectors.z(), vectors.w(), vectors.x(),
+                                                  vectors.y(), vectors.z(), vectors.w(), true});
+}
+
+/**
+ * @brief Computes the element-wise minimum of two arrays of vectors.
+ * @param a The first vectors.
+ * @param b The second vectors.
+ * @param out The destination, resized to a.size(). It may be a or b.
+ * @throws std::invalid_argument if a and b differ in size.
+ * @note As std::fmin, a NaN component of one input gives the component of the
+ * other.
+ */
+template <typename T> inline void cwiseMin(const Vec4SoA<T>& a, const Vec4SoA<T>& b, Vec4SoA<T>& out) {
+  detail::checkSameSize(a.size(), b.size());
+  out.resize(a.size());
+  detail::clampArray<T>(a.x(), nullptr, b.x(), out.x(), a.size());
+  detail::clampArray<T>(a.y(), nullptr, b.y(), out.y(), a.size());
+  detail::clampArray<T>(a.z(), nullptr, b.z(), out.z(), a.size());
+  detail::clampArray<T>(a.w(), nullptr, b.w(), out.w(), a.size());
+}
+
+/**
+ * @brief Computes the element-wise maximum of two arrays of vectors.
+ * @param a The first vectors.
+ * @param b The second vectors.
+ * @param out The destination, resized to a.size(). It may be a or b.
+ * @throws std::invalid_argument if a and b differ in size.
+ * @note As std::fmax, a NaN component of one input gives the component of the
+ * other.
+ */
+template <typename T> inline void cwiseMax(const Vec4SoA<T>& a, const Vec4SoA<T>& b, Vec4SoA<T>& out) {
+  detail::checkSameSize(a.size(), b.size());
+  out.resize(a.size());
+  detail::clampArray<T>(a.x(), b.x(), nullptr, out.x(), a.size());
+  detail::clampArray<T>(a.y(), b.y(), nullptr, out.y(), a.size());
+  detail::clampArray<T>(a.z(), b.z(), nullptr, out.z(), a.size());
+  detail::clampArray<T>(a.w(), b.w(), nullptr, out.w(), a.size());
+}
+
+/**
+ * @brief Clamps an array of vectors element-wise between two other arrays.
+ * @param a The vectors to clamp.
+ * @param min The lower bounds.
+ * @param max The upper bounds.
+ * @param out The destination, resized to a.size(). It may be any of the inputs.
+ * @throws std::invalid_argument if the inputs differ in size.
+ */
+template <typename T>
+inline void cwiseClamp(const Vec4SoA<T>& a, const Vec4SoA<T>& min, const Vec4SoA<T>& max, Vec4SoA<T>& out) {
+  detail::checkSameSize(a.size(), min.size());
+  detail::checkSameSize(a.size(), max.size());
+  out.resize(a.size());
+  detail::clampArray<T>(a.x(), min.x(), max.x(), out.x(), a.size());
+  detail::clampArray<T>(a.y(), min.y(), max.y(), out.y(), a.size());
+  detail::clampArray<T>(a.z(), min.z(), max.z(), out.z(), a.size());
+  detail::clampArray<T>(a.w(), min.w(), max.w(), out.w(), a.size());
+}
+
+} // namespace linalg
+
+#endif // LINALG_SOA_HPP
@@ -0,0 +1,990 @@
+/**
+ * @file Solve.hpp
+ * @brief Linear solvers and a symmetric eigen-solver for 3x3 and 4x4 systems,
+ * one at a time or in batches.
+ *
+ * solve() uses an LU factorization with partial pivoting, which is more
+ * accurate than inverse() * b for ill-conditioned systems. For Mat4 it is also
+ * faster; for Mat3 the cofactor inverse() * b is faster, so prefer it when
+ * speed matters more than conditioning. solveCholesky() needs no pivoting and
+ * suits symmetric positive definite systems such as constraint and normal
+ * equations. symmetricEigen() diagonalizes a symmetric 3x3 matrix with cyclic
+ * Jacobi rotations, for instance the covariance of a point cluster.
+ *
+ * The batched overloads take Mat3SoA and Mat4SoA containers and solve one
+ * system per SIMD lane, following the same steps as the single-system
+ * functions with selects in place of branches.
+ */
+#ifndef LINALG_SOLVE_HPP
+#define LINALG_SOLVE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+#include "Mat3.hpp"
+#include "Mat4.hpp"
+#include "Pack.hpp"
+#include "SoA.hpp"
+#include "Tolerance.hpp"
+#include "Vec3.hpp"
+#include "Vec4.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Array of Mat3 stored as three Vec3SoA rows, one array per element.
+ * @tparam T The type of the matrix elements (e.g., float, double).
+ */
+template <typename T> class Mat3SoA {
+public:
+  /**
+   * @brief Constructs an empty container.
+   */
+  Mat3SoA() = default;
+
+  /**
+   * @brief Constructs a container of count zero matrices.
+   */
+  explicit Mat3SoA(std::size_t count) : m_rows{Vec3SoA<T>(count), Vec3SoA<T>(count), Vec3SoA<T>(count)} {}
+
+  /**
+   * @brief Creates a container from an array of matrices.
+   * @param in The matrices to copy.
+   * @param count The number of matrices.
+   */
+  static Mat3SoA FromAoS(const Mat3<T>* in, std::size_t count) {
+    Mat3SoA soa(count);
+    for(std::size_t i = 0; i < count; ++i) {
+      soa.set(i, in[i]);
+    }
+    return soa;
+  }
+
+  /**
+   * @brief Copies the matrices to an array of Mat3.
+   * @param out The destination array, holding at least size() matrices.
+   */
+  void toAoS(Mat3<T>* out) const noexcept {
+    for(std::size_t i = 0; i < size(); ++i) {
+      out[i] = get(i);
+    }
+  }
+
+  /**
+   * @brief Returns the number of matrices.
+   */
+  std::size_t size() const noexcept { return m_rows[0].size(); }
+
+  /**
+   * @brief Resizes the container, new matrices being zero.
+   */
+  void resize(std::size_t count) {
+    for(Vec3SoA<T>& row : m_rows) {
+      row.resize(count);
+    }
+  }
+
+  /**
+   * @brief Returns the matrix at the specified index.
+   */
+  Mat3<T> get(std::size_t index) const noexcept {
+    return Mat3<T>::FromRows(m_rows[0].get(index), m_rows[1].get(index), m_rows[2].get(index));
+  }
+
+  /**
+   * @brief Sets the matrix at the specified index.
+   */
+  void set(std::size_t index, const Mat3<T>& value) noexcept {
+    for(int i = 0; i < 3; ++i) {
+      m_rows[i].set(index, Vec3<T>(value.m[i][0], value.m[i][1], value.m[i][2]));
+    }
+  }
+
+  /**
+   * @brief Returns row i of every matrix.
+   */
+  Vec3SoA<T>&       row(int i) noexcept { return m_rows[i]; }
+  const Vec3SoA<T>& row(int i) const noexcept { return m_rows[i]; }
+
+private:
+  Vec3SoA<T> m_rows[3];
+};
+
+/**
+ * @brief Array of Mat4 stored as four Vec4SoA rows, one array per element.
+ * @tparam T The type of the matrix elements (e.g., float, double).
+ */
+template <typename T> class Mat4SoA {
+public:
+  /**
+   * @brief Constructs an empty container.
+   */
+  Mat4SoA() = default;
+
+  /**
+   * @brief Constructs a container of count zero matrices.
+   */
+  explicit Mat4SoA(std::size_t count)
+      : m_rows{Vec4SoA<T>(count), Vec4SoA<T>(count), Vec4SoA<T>(count), Vec4SoA<T>(count)} {}
+
+  /**
+   * @brief Creates a container from an array of matrices.
+   * @param in The matrices to copy.
+   * @param count The number of matrices.
+   */
+  static Mat4SoA FromAoS(const Mat4<T>* in, std::size_t count) {
+    Mat4SoA soa(count);
+    for(std::size_t i = 0; i < count; ++i) {
+      soa.set(i, in[i]);
+    }
+    return soa;
+  }
+
+  /**
+   * @brief Copies the matrices to an array of Mat4.
+   * @param out The destination array, holding at least size() matrices.
+   */
+  void toAoS(Mat4<T>* out) const noexcept {
+    for(std::size_t i = 0; i < size(); ++i) {
+      out[i] = get(i);
+    }
+  }
+
+  /**
+   * @brief Returns the number of matrices.
+   */
+  std::size_t size() const noexcept { return m_rows[0].size(); }
+
+  /**
+   * @brief Resizes the container, new matrices being zero.
+   */
+  void resize(std::size_t count) {
+    for(Vec4SoA<T>& row : m_rows) {
+      row.resize(count);
+    }
+  }
+
+  /**
+   * @brief Returns the matrix at the specified index.
+   */
+  Mat4<T> get(std::size_t index) const noexcept {
+    return Mat4<T>::FromRows(m_rows[0].get(index), m_rows[1].get(index), m_rows[2].get(index),
+                             m_rows[3].get(index));
+  }
+
+  /**
+   * @brief Sets the matrix at the specified index.
+   */
+  void set(std::size_t index, const Mat4<T>& value) noexcept {
+    for(int i = 0; i < 4; ++i) {
+      m_rows[i].set(index, Vec4<T>(value.m[i][0], value.m[i][1], value.m[i][2], value.m[i][3]));
+    }
+  }
+
+  /**
+   * @brief Returns row i of every matrix.
+   */
+  Vec4SoA<T>&       row(int i) noexcept { return m_rows[i]; }
+  const Vec4SoA<T>& row(int i) const noexcept { return m_rows[i]; }
+
+private:
+  Vec4SoA<T> m_rows[4];
+};
+
+/**
+ * @brief Eigen-decomposition of a symmetric 3x3 matrix, a = vectors *
+ * diag(values) * vectors^T.
+ * @tparam T The type of the elements (e.g., float, double).
+ */
+template <typename T> struct SymmetricEigen {
+  Vec3<T> values;  ///< The eigenvalues in decreasing order.
+  Mat3<T> vectors; ///< The unit eigenvectors as columns, forming a rotation.
+};
+
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+/**
+ * @brief Returns the pivot magnitude below which a matrix whose largest element
+ * magnitude is scale is treated as singular: Tolerance<T>::SingularDeterminant()
+ * times scale, and at least the smallest normal number so that the reciprocals
+ * of the pivots stay finite.
+ */
+template <typename T> inline T pivotThreshold(T scale) noexcept {
+  return std::max(Tolerance<T>::SingularDeterminant() * scale, std::numeric_limits<T>::min());
+}
+template <typename T, int W> inline simd::Pack<T, W> pivotThreshold(const simd::Pack<T, W>& scale) noexcept {
+  using P        = simd::Pack<T, W>;
+  const P scaled = P::broadcast(Tolerance<T>::SingularDeterminant()) * scale;
+  return simd::max(scaled, P::broadcast(std::numeric_limits<T>::min()));
+}
+
+/**
+ * @brief Returns the largest element magnitude of a, ignoring NaNs.
+ */
+template <typename T, int N> inline T maxMagnitude(const T (&a)[N][N]) noexcept {
+  T scale = 0;
+  for(int i = 0; i < N; ++i) {
+    for(int j = 0; j < N; ++j) {
+      scale = std::max(scale, std::abs(a[i][j]));
+    }
+  }
+  return scale;
+}
+
+/**
+ * @brief Step k of an LU factorization with partial pivoting of the system
+ * [a | b].
+ *
+ * Row k is exchanged with every larger candidate with conditional moves, then
+ * eliminated from the rows below. The reciprocal of the pivot replaces it for
+ * the back substitution. ok is cleared if the pivot magnitude is below
+ * threshold or NaN. The steps are called with constant indices so that the
+ * matrix is kept in registers.
+ */
+template <typename T, int N> inline void luStep(T (&a)[N][N], T (&b)[N], int k, T threshold, bool& ok) noexcept {
+  for(int i = k + 1; i < N; ++i) {
+    const bool swap = std::abs(a[i][k]) > std::abs(a[k][k]);
+    for(int j = k; j < N; ++j) {
+      const T row_k = a[k][j];
+      a[k][j]       = swap ? a[i][j] : row_k;
+      a[i][j]       = swap ? row_k : a[i][j];
+    }
+    const T b_k = b[k];
+    b[k]        = swap ? b[i] : b_k;
+    b[i]        = swap ? b_k : b[i];
+  }
+  ok      = ok & (std::abs(a[k][k]) >= threshold);
+  a[k][k] = T(1) / a[k][k];
+  for(int i = k + 1; i < N; ++i) {
+    const T factor = a[i][k] * a[k][k];
+    for(int j = k + 1; j < N; ++j) {
+      a[i][j] -= factor * a[k][j];
+    }
+    b[i] -= factor * b[k];
+  }
+}
+
+/**
+ * @brief Solves x from row i of the upper triangular system left by luStep().
+ */
+template <typename T, int N> inline void luBackSubstitute(const T (&a)[N][N], T (&b)[N], int i) noexcept {
+  T sum = b[i];
+  for(int j = i + 1; j < N; ++j) {
+    sum -= a[i][j] * b[j];
+  }
+  b[i] = sum * a[i][i];
+}
+
+/**
+ * @brief Solves a * x = b in place by LU factorization with partial pivoting.
+ *
+ * On return b holds x.
+ * @return false if a pivot is NaN or has a magnitude below pivotThreshold() of
+ * the largest element magnitude of a.
+ */
+template <typename T> inline bool luSolve(T (&a)[3][3], T (&b)[3]) noexcept {
+  const T threshold = pivotThreshold(maxMagnitude(a));
+  bool    ok        = true;
+  luStep(a, b, 0, threshold, ok);
+  luStep(a, b, 1, threshold, ok);
+  luStep(a, b, 2, threshold, ok);
+  luBackSubstitute(a, b, 2);
+  luBackSubstitute(a, b, 1);
+  luBackSubstitute(a, b, 0);
+  return ok;
+}
+template <typename T> inline bool luSolve(T (&a)[4][4], T (&b)[4]) noexcept {
+  const T threshold = pivotThreshold(maxMagnitude(a));
+  bool    ok        = true;
+  luStep(a, b, 0, threshold, ok);
+  luStep(a, b, 1, threshold, ok);
+  luStep(a, b, 2, threshold, ok);
+  luStep(a, b, 3, threshold, ok);
+  luBackSubstitute(a, b, 3);
+  luBackSubstitute(a, b, 2);
+  luBackSubstitute(a, b, 1);
+  luBackSubstitute(a, b, 0);
+  return ok;
+}
+
+/**
+ * @brief Solves a * x = b in place by Cholesky factorization a = L * L^T,
+ * reading only the lower triangle of a.
+ *
+ * On return b holds x.
+ * @return false if a squared diagonal element of L is NaN or below
+ * pivotThreshold() of the largest diagonal magnitude of a, which bounds the
+ * other elements of positive definite matrices. This is the case for matrices
+ * that are not positive definite.
+ */
+template <typename T, int N> inline bool choleskySolve(T (&a)[N][N], T (&b)[N]) noexcept {
+  T scale = 0;
+  for(int j = 0; j < N; ++j) {
+    scale = std::max(scale, std::abs(a[j][j]));
+  }
+  const T threshold = pivotThreshold(scale);
+  T       inv_diag[N];
+  // L overwrites the lower triangle of a.
+  for(int j = 0; j < N; ++j) {
+    T diag = a[j][j];
+    for(int k = 0; k < j; ++k) {
+      diag -= a[j][k] * a[j][k];
+    }
+    if(!(diag >= threshold)) {
+      return false;
+    }
+    inv_diag[j] = T(1) / std::sqrt(diag);
+    for(int i = j + 1; i < N; ++i) {
+      T sum = a[i][j];
+      for(int k = 0; k < j; ++k) {
+        sum -= a[i][k] * a[j][k];
+      }
+      a[i][j] = sum * inv_diag[j];
+    }
+  }
+  for(int i = 0; i < N; ++i) {
+    T sum = b[i];
+    for(int k = 0; k < i; ++k) {
+      sum -= a[i][k] * b[k];
+    }
+    b[i] = sum * inv_diag[i];
+  }
+  for(int i = N - 1; i >= 0; --i) {
+    T sum = b[i];
+    for(int k = i + 1; k < N; ++k) {
+      sum -= a[k][i] * b[k];
+    }
+    b[i] = sum * inv_diag[i];
+  }
+  return true;
+}
+
+/**
+ * @brief Applies the Jacobi rotation that zeroes the off-diagonal element
+ * (p, q) of a symmetric 3x3 matrix.
+ *
+ * The matrix is held as its diagonal d and its off-diagonal elements o, o[r]
+ * being the element whose row and column are not r. The rotation is
+ * accumulated into the columns p and q of v.
+ */
+template <typename T> inline void jacobiRotate(int p, int q, T (&d)[3], T (&o)[3], T (&v)[3][3]) noexcept {
+  const int r   = 3 - p - q;
+  const T   apq = o[r];
+  if(apq == 0) {
+    return;
+  }
+  // t = tan of the rotation angle, the smaller root of t^2 + 2 theta t - 1 = 0.
+  const T theta = (d[q] - d[p]) / (2 * apq);
+  const T t     = (theta < 0 ? T(-1) : T(1)) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+  const T c     = 1 / std::sqrt(t * t + 1);
+  const T s     = t * c;
+  const T tau   = s / (1 + c);
+
+  d[p] -= t * apq;
+  d[q] += t * apq;
+  o[r]        = 0;
+  const T arp = o[q];
+  const T arq = o[p];
+  o[q]        = arp - s * (arq + tau * arp);
+  o[p]        = arq + s * (arp - tau * arq);
+  for(int k = 0; k < 3; ++k) {
+    const T vkp = v[k][p];
+    const T vkq = v[k][q];
+    v[k][p]     = vkp - s * (vkq + tau * vkp);
+    v[k][q]     = vkq + s * (vkp - tau * vkq);
+  }
+}
+
+/**
+ * @brief Diagonalizes a symmetric 3x3 matrix with cyclic Jacobi sweeps, reading
+ * the upper triangle of a.
+ *
+ * The sweeps stop when the squared off-diagonal elements sum to at most
+ * epsilon^2 times the squared diagonal, after 4 or 5 sweeps at most. The
+ * eigenvalues are then sorted in decreasing order and the last eigenvector
+ * negated if needed so that v is a rotation.
+ */
+template <typename T>
+inline void jacobiEigen(const std::array<std::array<T, 3>, 3>& a, T (&d)[3], T (&v)[3][3]) noexcept {
+  constexpr int MAX_SWEEPS = 16;
+  const T       epsilon2   = std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon();
+
+  T o[3] = {a[1][2], a[0][2], a[0][1]};
+  d[0]   = a[0][0];
+  d[1]   = a[1][1];
+  d[2]   = a[2][2];
+  for(int i = 0; i < 3; ++i) {
+    for(int j = 0; j < 3; ++j) {
+      v[i][j] = i == j ? T(1) : T(0);
+    }
+  }
+  for(int sweep = 0; sweep < MAX_SWEEPS; ++sweep) {
+    const T off      = o[0] * o[0] + o[1] * o[1] + o[2] * o[2];
+    const T diagonal = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+    if(off <= epsilon2 * diagonal) {
+      break;
+    }
+    jacobiRotate(0, 1, d, o, v);
+    jacobiRotate(0, 2, d, o, v);
+    jacobiRotate(1, 2, d, o, v);
+  }
+
+  const int order[3][2] = {{0, 1}, {1, 2}, {0, 1}};
+  for(const auto& pair : order) {
+    if(d[pair[0]] < d[pair[1]]) {
+      std::swap(d[pair[0]], d[pair[1]]);
+      for(int k = 0; k < 3; ++k) {
+        std::swap(v[k][pair[0]], v[k][pair[1]]);
+      }
+    }
+  }
+  // det(v) = (v0 x v1) . v2 for the columns v0, v1 and v2.
+  const T det = v[0][2] * (v[1][0] * v[2][1] - v[2][0] * v[1][1]) +
+                v[1][2] * (v[2][0] * v[0][1] - v[0][0] * v[2][1]) +
+                v[2][2] * (v[0][0] * v[1][1] - v[1][0] * v[0][1]);
+  if(det < 0) {
+    for(int k = 0; k < 3; ++k) {
+      v[k][2] = -v[k][2];
+    }
+  }
+}
+
+/**
+ * @brief Solves a * x = b in place, one system per lane, by LU factorization
+ * with partial pivoting.
+ *
+ * On return b holds x. Rows are swapped with selects so that every lane pivots
+ * on its own largest element.
+ * @return The mask of the lanes whose pivots all have a magnitude of at least
+ * pivotThreshold() of the largest element magnitude of their matrix; the other
+ * lanes, NaN pivots included, hold garbage.
+ */
+template <typename T, int W, int N>
+inline typename simd::Pack<T, W>::Mask luSolveLanes(simd::Pack<T, W> (&a)[N][N], simd::Pack<T, W> (&b)[N]) noexcept {
+  using P       = simd::Pack<T, W>;
+  using Mask    = typename P::Mask;
+  const P one   = P::broadcast(T(1));
+  P       scale = P::broadcast(T(0));
+  for(int i = 0; i < N; ++i) {
+    for(int j = 0; j < N; ++j) {
+      scale = simd::fmax(scale, simd::abs(a[i][j]));
+    }
+  }
+  const P threshold = pivotThreshold(scale);
+  Mask    solved    = one == one;
+  for(int k = 0; k < N; ++k) {
+    for(int i = k + 1; i < N; ++i) {
+      const auto swap = simd::abs(a[i][k]) > simd::abs(a[k][k]);
+      for(int j = k; j < N; ++j) {
+        const P row_k = a[k][j];
+        a[k][j]       = simd::select(swap, a[i][j], row_k);
+        a[i][j]       = simd::select(swap, row_k, a[i][j]);
+      }
+      const P b_k = b[k];
+      b[k]        = simd::select(swap, b[i], b_k);
+      b[i]        = simd::select(swap, b_k, b[i]);
+    }
+    const Mask pivoted = simd::abs(a[k][k]) >= threshold;
+    solved             = solved & pivoted;
+    // The reciprocal of the pivot replaces it for the back substitution.
+    a[k][k] = one / simd::select(pivoted, a[k][k], one);
+    for(int i = k + 1; i < N; ++i) {
+      const P factor = a[i][k] * a[k][k];
+      for(int j = k + 1; j < N; ++j) {
+        a[i][j] = a[i][j] - factor * a[k][j];
+      }
+      b[i] = b[i] - factor * b[k];
+    }
+  }
+  for(int i = N - 1; i >= 0; --i) {
+    P sum = b[i];
+    for(int j = i + 1; j < N; ++j) {
+      sum = sum - a[i][j] * b[j];
+    }
+    b[i] = sum * a[i][i];
+  }
+  return solved;
+}
+
+/**
+ * @brief Solves a * x = b in place, one system per lane, by Cholesky
+ * factorization a = L * L^T, reading only the lower triangle of a.
+ *
+ * On return b holds x.
+ * @return The mask of the lanes whose squared diagonal of L is at least
+ * pivotThreshold() of the largest diagonal magnitude of their matrix, which
+ * fails for matrices that are not positive definite; the other lanes, NaN
+ * diagonals included, hold garbage.
+ */
+template <typename T, int W, int N>
+inline typename simd::Pack<T, W>::Mask choleskySolveLanes(simd::Pack<T, W> (&a)[N][N],
+                                                          simd::Pack<T, W> (&b)[N]) noexcept {
+  using P       = simd::Pack<T, W>;
+  using Mask    = typename P::Mask;
+  const P one   = P::broadcast(T(1));
+  P       scale = P::broadcast(T(0));
+  for(int j = 0; j < N; ++j) {
+    scale = simd::fmax(scale, simd::abs(a[j][j]));
+  }
+  const P threshold = pivotThreshold(scale);
+  Mask    solved    = one == one;
+  P       inv_diag[N];
+  // L overwrites the lower triangle of a.
+  for(int j = 0; j < N; ++j) {
+    P diag = a[j][j];
+    for(int k = 0; k < j; ++k) {
+      diag = diag - a[j][k] * a[j][k];
+    }
+    const Mask positive = diag >= threshold;
+    solved              = solved & positive;
+    inv_diag[j]         = one / simd::sqrt(simd::select(positive, diag, one));
+    for(int i = j + 1; i < N; ++i) {
+      P sum = a[i][j];
+      for(int k = 0; k < j; ++k) {
+        sum = sum - a[i][k] * a[j][k];
+      }
+      a[i][j] = sum * inv_diag[j];
+    }
+  }
+  for(int i = 0; i < N; ++i) {
+    P sum = b[i];
+    for(int k = 0; k < i; ++k) {
+      sum = sum - a[i][k] * b[k];
+    }
+    b[i] = sum * inv_diag[i];
+  }
+  for(int i = N - 1; i >= 0; --i) {
+    P sum = b[i];
+    for(int k = i + 1; k < N; ++k) {
+      sum = sum - a[k][i] * b[k];
+    }
+    b[i] = sum * inv_diag[i];
+  }
+  return solved;
+}
+
+/**
+ * @brief Applies the Jacobi rotation that zeroes the off-diagonal element
+ * (p, q) of a symmetric 3x3 matrix, one matrix per lane.
+ *
+ * The matrix is held as its diagonal d and its off-diagonal elements o, o[r]
+ * being the element whose row and column are not r. The rotation is
+ * accumulated into the columns p and q of v.
+ */
+template <typename T, int W>
+inline void jacobiRotateLanes(int p, int q, simd::Pack<T, W> (&d)[3], simd::Pack<T, W> (&o)[3],
+                              simd::Pack<T, W> (&v)[3][3]) noexcept {
+  using P           = simd::Pack<T, W>;
+  const int  r      = 3 - p - q;
+  const P    zero   = P::broadcast(T(0));
+  const P    one    = P::broadcast(T(1));
+  const P    apq    = o[r];
+  const auto rotate = apq != zero;
+
+  // t = tan of the rotation angle, the smaller root of t^2 + 2 theta t - 1 = 0.
+  const P theta     = (d[q] - d[p]) / (P::broadcast(T(2)) * simd::select(rotate, apq, one));
+  const P magnitude = one / (simd::abs(theta) + simd::sqrt(simd::madd(theta, theta, one)));
+  const P t         = simd::select(rotate, simd::select(theta < zero, -magnitude, magnitude), zero);
+  const P c         = one / simd::sqrt(simd::madd(t, t, one));
+  const P s         = t * c;
+  const P tau       = s / (one + c);
+
+  d[p]        = d[p] - t * apq;
+  d[q]        = d[q] + t * apq;
+  o[r]        = zero;
+  const P arp = o[q];
+  const P arq = o[p];
+  o[q]        = arp - s * simd::madd(tau, arp, arq);
+  o[p]        = arq + s * (arp - tau * arq);
+  for(int k = 0; k < 3; ++k) {
+    const P vkp = v[k][p];
+    const P vkq = v[k][q];
+    v[k][p]     = vkp - s * simd::madd(tau, vkp, vkq);
+    v[k][q]     = vkq + s * (vkp - tau * vkq);
+  }
+}
+
+/**
+ * @brief Swaps the eigenvalues i and j and their eigenvectors in the lanes
+ * where value i is the smaller.
+ */
+template <typename T, int W>
+inline void sortEigenPairLanes(int i, int j, simd::Pack<T, W> (&d)[3], simd::Pack<T, W> (&v)[3][3]) noexcept {
+  using P         = simd::Pack<T, W>;
+  const auto swap = d[i] < d[j];
+  const P    d_i  = d[i];
+  d[i]            = simd::select(swap, d[j], d_i);
+  d[j]            = simd::select(swap, d_i, d[j]);
+  for(int k = 0; k < 3; ++k) {
+    const P v_i = v[k][i];
+    v[k][i]     = simd::select(swap, v[k][j], v_i);
+    v[k][j]     = simd::select(swap, v_i, v[k][j]);
+  }
+}
+
+/**
+ * @brief Diagonalizes symmetric 3x3 matrices, one per lane, with cyclic Jacobi
+ * sweeps until every lane has converged, reading the upper triangle of a.
+ *
+ * A lane has converged when the squared off-diagonal elements sum to at most
+ * epsilon^2 times the squared diagonal, which takes 4 or 5 sweeps at most.
+ * The eigenvalues are then sorted in decreasing order and the last eigenvector
+ * negated if needed so that v is a rotation.
+ */
+template <typename T, int W>
+inline void jacobiEigenLanes(const simd::Pack<T, W> (&a)[3][3], simd::Pack<T, W> (&values)[3],
+                             simd::Pack<T, W> (&v)[3][3]) noexcept {
+  using P                  = simd::Pack<T, W>;
+  constexpr int MAX_SWEEPS = 16;
+  const P       zero       = P::broadcast(T(0));
+  const P       one        = P::broadcast(T(1));
+  const P       epsilon2   = P::broadcast(std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon());
+
+  P d[3] = {a[0][0], a[1][1], a[2][2]};
+  P o[3] = {a[1][2], a[0][2], a[0][1]};
+  for(int i = 0; i < 3; ++i) {
+    for(int j = 0; j < 3; ++j) {
+      v[i][j] = i == j ? one : zero;
+    }
+  }
+  for(int sweep = 0; sweep < MAX_SWEEPS; ++sweep) {
+    const P off      = simd::madd(o[0], o[0], simd::madd(o[1], o[1], o[2] * o[2]));
+    const P diagonal = simd::madd(d[0], d[0], simd::madd(d[1], d[1], d[2] * d[2]));
+    if((off <= epsilon2 * diagonal).bits() == (1 << W) - 1) {
+      break;
+    }
+    jacobiRotateLanes(0, 1, d, o, v);
+    jacobiRotateLanes(0, 2, d, o, v);
+    jacobiRotateLanes(1, 2, d, o, v);
+  }
+
+  sortEigenPairLanes(0, 1, d, v);
+  sortEigenPairLanes(1, 2, d, v);
+  sortEigenPairLanes(0, 1, d, v);
+  // det(v) = (v0 x v1) . v2 for the columns v0, v1 and v2.
+  const P det = v[0][2] * (v[1][0] * v[2][1] - v[2][0] * v[1][1]) +
+                v[1][2] * (v[2][0] * v[0][1] - v[0][0] * v[2][1]) +
+                v[2][2] * (v[0][0] * v[1][1] - v[1][0] * v[0][1]);
+  const auto reflected = det < zero;
+  for(int k = 0; k < 3; ++k) {
+    v[k][2]   = simd::select(reflected, -v[k][2], v[k][2]);
+    values[k] = d[k];
+  }
+}
+
+/**
+ * @brief Returns the number of unset lanes of a mask.
+ */
+template <typename Mask> inline std::size_t countUnset(const Mask& mask) noexcept {
+  std::size_t count = 0;
+  for(int bits = mask.bits(), i = 0; i < Mask::WIDTH; ++i, bits >>= 1) {
+    count += (bits & 1) == 0 ? 1 : 0;
+  }
+  return count;
+}
+
+/**
+ * @brief Pointers to the element arrays of Mat3SoA/Mat4SoA and Vec3SoA/Vec4SoA
+ * containers.
+ */
+template <typename T> inline void elementPointers(const Vec3SoA<T>& v, const T* (&out)[3]) noexcept {
+  out[0] = v.x();
+  out[1] = v.y();
+  out[2] = v.z();
+}
+template <typename T> inline void elementPointers(Vec3SoA<T>& v, T* (&out)[3]) noexcept {
+  out[0] = v.x();
+  out[1] = v.y();
+  out[2] = v.z();
+}
+template <typename T> inline void elementPointers(const Vec4SoA<T>& v, const T* (&out)[4]) noexcept {
+  out[0] = v.x();
+  out[1] = v.y();
+  out[2] = v.z();
+  out[3] = v.w();
+}
+template <typename T> inline void elementPointers(Vec4SoA<T>& v, T* (&out)[4]) noexcept {
+  out[0] = v.x();
+  out[1] = v.y();
+  out[2] = v.z();
+  out[3] = v.w();
+}
+template <typename Matrix, typename Pointer, int N>
+inline void elementPointers(Matrix& m, Pointer (&out)[N][N]) noexcept {
+  for(int i = 0; i < N; ++i) {
+    elementPointers(m.row(i), out[i]);
+  }
+}
+
+/**
+ * @brief Solves the systems of Mat3SoA/Mat4SoA and Vec3SoA/Vec4SoA containers,
+ * setting the solutions that fail to zero and counting them.
+ */
+template <typename T, int N, bool CHOLESKY> struct SoASolve {
+  const T*     a[N][N];
+  const T*     b[N];
+  T*           x[N];
+  std::size_t* failed;
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    P m[N][N];
+    P v[N];
+    for(int r = 0; r < N; ++r) {
+      for(int c = 0; c < N; ++c) {
+        m[r][c] = P::load(a[r][c] + i);
+      }
+      v[r] = P::load(b[r] + i);
+    }
+    const auto solved = CHOLESKY ? choleskySolveLanes(m, v) : luSolveLanes(m, v);
+    for(int r = 0; r < N; ++r) {
+      simd::select(solved, v[r], P::broadcast(T(0))).store(x[r] + i);
+    }
+    *failed += countUnset(solved);
+  }
+};
+
+template <typename T> struct SoAEigen {
+  const T* a[3][3];
+  T*       values[3];
+  T*       vectors[3][3];
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    P m[3][3];
+    for(int r = 0; r < 3; ++r) {
+      for(int c = 0; c < 3; ++c) {
+        m[r][c] = P::load(a[r][c] + i);
+      }
+    }
+    P d[3];
+    P v[3][3];
+    jacobiEigenLanes(m, d, v);
+    for(int r = 0; r < 3; ++r) {
+      d[r].store(values[r] + i);
+      for(int c = 0; c < 3; ++c) {
+        v[r][c].store(vectors[r][c] + i);
+      }
+    }
+  }
+};
+
+/**
+ * @brief Solves one system with the one-lane kernels, leaving x unchanged on
+ * failure.
+ */
+template <bool CHOLESKY, typename T, std::size_t N>
+inline bool solveSingle(const std::array<std::array<T, N>, N>& a, const T* b, T* x) noexcept {
+  constexpr int SIZE = static_cast<int>(N);
+  T             m[SIZE][SIZE];
+  T             v[SIZE];
+  for(int r = 0; r < SIZE; ++r) {
+    for(int c = 0; c < SIZE; ++c) {
+      m[r][c] = a[r][c];
+    }
+    v[r] = b[r];
+  }
+  if(!(CHOLESKY ? choleskySolve(m, v) : luSolve(m, v))) {
+    return false;
+  }
+  for(int r = 0; r < SIZE; ++r) {
+    x[r] = v[r];
+  }
+  return true;
+}
+
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+
+/**
+ * @brief Solves a * x = b by LU factorization with partial pivoting.
+ * @param a The matrix of the system.
+ * @param b The right-hand side.
+ * @param x The solution. It is left unchanged if the system is singular, and may
+ * be b.
+ * @return false if the system is singular, a pivot being NaN or below
+ * Tolerance<T>::SingularDeterminant() times the largest element magnitude of
+ * a, true otherwise. The test is relative, so a scaled identity is solvable at
+ * any magnitude.
+ * @tparam T The type of the elements (e.g., float, double).
+ */
+template <typename T> inline bool trySolve(const Mat3<T>& a, const Vec3<T>& b, Vec3<T>& x) noexcept {
+  return detail::solveSingle<false>(a.m, &b.x, &x.x);
+}
+template <typename T> inline bool trySolve(const Mat4<T>& a, const Vec4<T>& b, Vec4<T>& x) noexcept {
+  return detail::solveSingle<false>(a.m, &b.x, &x.x);
+}
+
+/**
+ * @brief Returns the solution of a * x = b by LU factorization with partial
+ * pivoting, or a zero vector if the system is singular (see trySolve()).
+ * @tparam T The type of the elements (e.g., float, double).
+ */
+template <typename T> inline Vec3<T> solve(const Mat3<T>& a, const Vec3<T>& b) noexcept {
+  Vec3<T> x(T(0));
+  trySolve(a, b, x);
+  return x;
+}
+template <typename T> inline Vec4<T> solve(const Mat4<T>& a, const Vec4<T>& b) noexcept {
+  Vec4<T> x(T(0));
+  trySolve(a, b, x);
+  return x;
+}
+
+/**
+ * @brief Solves a * x = b for a symmetric positive definite matrix by Cholesky
+ * factorization, reading only the lower triangle of a.
+ * @param a The matrix of the system.
+ * @param b The right-hand side.
+ * @param x The solution. It is left unchanged on failure, and may be b.
+ * @return false if a is not positive definite, a squared diagonal element of the
+ * factor being NaN or below Tolerance<T>::SingularDeterminant() times the
+ * largest diagonal magnitude of a, true otherwise.
+ * @tparam T The type of the elements (e.g., float, double).
+ */
+template <typename T> inline bool trySolveCholesky(const Mat3<T>& a, const Vec3<T>& b, Vec3<T>& x) noexcept {
+  return detail::solveSingle<true>(a.m, &b.x, &x.x);
+}
+template <typename T> inline bool trySolveCholesky(const Mat4<T>& a, const Vec4<T>& b, Vec4<T>& x) noexcept {
+  return detail::solveSingle<true>(a.m, &b.x, &x.x);
+}
+
+/**
+ * @brief Returns the solution of a * x = b for a symmetric positive definite
+ * matrix, or a zero vector on failure (see trySolveCholesky()).
+ * @tparam T The type of the elements (e.g., float, double).
+ */
+template <typename T> inline Vec3<T> solveCholesky(const Mat3<T>& a, const Vec3<T>& b) noexcept {
+  Vec3<T> x(T(0));
+  trySolveCholesky(a, b, x);
+  return x;
+}
+template <typename T> inline Vec4<T> solveCholesky(const Mat4<T>& a, const Vec4<T>& b) noexcept {
+  Vec4<T> x(T(0));
+  trySolveCholesky(a, b, x);
+  return x;
+}
+
+/**
+ * @brief Returns the eigenvalues and eigenvectors of a symmetric matrix,
+ * reading only its upper triangle.
+ * @param a The symmetric matrix.
+ * @return The eigenvalues in decreasing order and the eigenvectors as the
+ * columns of a rotation matrix, so that for a covariance matrix the first
+ * column is the principal axis.
+ * @tparam T The type of the elements (e.g., float, double).
+ */
+template <typename T> inline SymmetricEigen<T> symmetricEigen(const Mat3<T>& a) noexcept {
+  T                 d[3];
+  T                 v[3][3];
+  SymmetricEigen<T> result;
+  detail::jacobiEigen(a.m, d, v);
+  result.values = Vec3<T>(d[0], d[1], d[2]);
+  for(int r = 0; r < 3; ++r) {
+    for(int c = 0; c < 3; ++c) {
+      result.vectors.m[r][c] = v[r][c];
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Solves an array of systems a[i] * x[i] = b[i] by LU factorization with
+ * partial pivoting, one system per SIMD lane.
+ * @param a The matrices.
+ * @param b The right-hand sides.
+ * @param x The destination, resized to a.size(). It may be b. The solutions of
+ * singular systems, as trySolve() defines them, are set to zero.
+ * @return The number of singular systems.
+ * @throws std::invalid_argument if a and b differ in size.
+ * @tparam T The type of the elements (e.g., float, double).
+ */
+template <typename T> inline std::size_t solve(const Mat3SoA<T>& a, const Vec3SoA<T>& b, Vec3SoA<T>& x) {
+  detail::checkSameSize(a.size(), b.size());
+  x.resize(a.size());
+  std::size_t                   failed = 0;
+  detail::SoASolve<T, 3, false> kernel{};
+  detail::elementPointers(a, kernel.a);
+  detail::elementPointers(b, kernel.b);
+  detail::elementPointers(x, kernel.x);
+  kernel.failed = &failed;
+  detail::forEachPack<T>(a.size(), kernel);
+  return failed;
+}
+template <typename T> inline std::size_t solve(const Mat4SoA<T>& a, const Vec4SoA<T>& b, Vec4SoA<T>& x) {
+  detail::checkSameSize(a.size(), b.size());
+  x.resize(a.size());
+  std::size_t                   failed = 0;
+  detail::SoASolve<T, 4, false> kernel{};
+  detail::elementPointers(a, kernel.a);
+  detail::elementPointers(b, kernel.b);
+  detail::elementPointers(x, kernel.x);
+  kernel.failed = &failed;
+  detail::forEachPack<T>(a.size(), kernel);
+  return failed;
+}
+
+/**
+ * @brief Solves an array of symmetric positive definite systems by Cholesky
+ * factorization, one system per SIMD lane, reading only the lower triangles.
+ * @param a The matrices.
+ * @param b The right-hand sides.
+ * @param x The destination, resized to a.size(). It may be b. The solutions of
+ * the systems that are not positive definite are set to zero.
+ * @return The number of systems that are not positive definite.
+ * @throws std::invalid_argument if a and b differ in size.
+ * @tparam T The type of the elements (e.g., float, double).
+ */
+template <typename T> inline std::size_t solveCholesky(const Mat3SoA<T>& a, const Vec3SoA<T>& b, Vec3SoA<T>& x) {
+  detail::checkSameSize(a.size(), b.size());
+  x.resize(a.size());
+  std::size_t                  failed = 0;
+  detail::SoASolve<T, 3, true> kernel{};
+  detail::elementPointers(a, kernel.a);
+  detail::elementPointers(b, kernel.b);
+  detail::elementPointers(x, kernel.x);
+  kernel.failed = &failed;
+  detail::forEachPack<T>(a.size(), kernel);
+  return failed;
+}
+template <typename T> inline std::size_t solveCholesky(const Mat4SoA<T>& a, const Vec4SoA<T>& b, Vec4SoA<T>& x) {
+  detail::checkSameSize(a.size(), b.size());
+  x.resize(a.size());
+  std::size_t                  failed = 0;
+  detail::SoASolve<T, 4, true> kernel{};
+  detail::elementPointers(a, kernel.a);
+  detail::elementPointers(b, kernel.b);
+  detail::elementPointers(x, kernel.x);
+  kernel.failed = &failed;
+  detail::forEachPack<T>(a.size(), kernel);
+  return failed;
+}
+
+/**
+ * @brief Computes the eigen-decompositions of an array of symmetric matrices,
+ * one matrix per SIMD lane, as symmetricEigen() does.
+ * @param a The symmetric matrices; only their upper triangles are read.
+ * @param values The eigenvalues in decreasing order, resized to a.size().
+ * @param vectors The eigenvectors as columns, resized to a.size(). It may be a.
+ * @tparam T The type of the elements (e.g., float, double).
+ */
+template <typename T> inline void symmetricEigen(const Mat3SoA<T>& a, Vec3SoA<T>& values, Mat3SoA<T>& vectors) {
+  values.resize(a.size());
+  vectors.resize(a.size());
+  detail::SoAEigen<T> kernel{};
+  detail::elementPointers(a, kernel.a);
+  detail::elementPointers(values, kernel.values);
+  detail::elementPointers(vectors, kernel.vectors);
+  detail::forEachPack<T>(a.size(), kernel);
+}
+
+} // namespace linalg
+
+#endif // LINALG_SOLVE_HPP
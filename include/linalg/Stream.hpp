@@ -0,0 +1,535 @@
+/**
+ * @file Stream.hpp
+ * @brief Chunked pipelines over arrays larger than memory: a source, a stage
+ * run on each chunk, an optional sink.
+ *
+ * streamChunks() passes the elements of a source through a ring of
+ * STREAM_BUFFERS buffers of a chunk each. A reader thread fills the free
+ * buffers and a writer thread drains the processed ones to the sink while the
+ * calling thread runs the stage, so reading chunk n + 1, processing chunk n and
+ * writing chunk n - 1 overlap. Only the ring is held in memory, whatever the
+ * size of the array. The stage sees the chunks in order, on the calling thread,
+ * and can reduce them without synchronization.
+ *
+ * ArraySource and ArraySink stream the serialized arrays of Serialization.hpp.
+ * The transformPoints() and streamBounds() pipelines below run the batch kernels
+ * on each chunk, optionally spread over an Executor.
+ *
+ * This header is not included by linalg.hpp; like Parallel.hpp, it requires
+ * linking the platform threads library.
+ */
+#ifndef LINALG_STREAM_HPP
+#define LINALG_STREAM_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "Batch.hpp"
+#include "Bounds.hpp"
+#include "Memory.hpp"
+#include "Pack.hpp"
+#include "Parallel.hpp"
+#include "Serialization.hpp"
+#include "Vec3.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Default size of the chunks of a stream: large enough to amortize the
+ * handoffs between the threads, small enough for the buffers to stay in cache
+ * between the read, the stage and the write of a chunk.
+ */
+constexpr std::size_t STREAM_CHUNK_BYTES = 512 * 1024;
+
+/**
+ * @brief Number of chunk buffers of a stream: one being read, one being
+ * processed and one being written.
+ */
+constexpr std::size_t STREAM_BUFFERS = 3;
+
+/**
+ * @brief Returns the number of elements of type E in a chunk of
+ * STREAM_CHUNK_BYTES.
+ */
+template <typename E> constexpr std::size_t streamChunkSize() noexcept {
+  return STREAM_CHUNK_BYTES / sizeof(E) > 0 ? STREAM_CHUNK_BYTES / sizeof(E) : 1;
+}
+
+/**
+ * @brief Interface of the sources of elements read by streamChunks().
+ */
+template <typename E> class ChunkSource {
+public:
+  ChunkSource()                              = default;
+  ChunkSource(const ChunkSource&)            = delete;
+  ChunkSource& operator=(const ChunkSource&) = delete;
+  ChunkSource(ChunkSource&&)                 = delete;
+  ChunkSource& operator=(ChunkSource&&)      = delete;
+  virtual ~ChunkSource()                     = default;
+
+  /**
+   * @brief Reads the next elements. Called from the reader thread of the
+   * stream.
+   * @param out The buffer receiving the elements.
+   * @param capacity The number of elements the buffer holds.
+   * @return The number of elements read, at most capacity; zero once the
+   * source is exhausted.
+   */
+  virtual std::size_t read(E* out, std::size_t capacity) = 0;
+};
+
+/**
+ * @brief Interface of the sinks of elements written by streamChunks().
+ */
+template <typename E> class ChunkSink {
+public:
+  ChunkSink()                            = default;
+  ChunkSink(const ChunkSink&)            = delete;
+  ChunkSink& operator=(const ChunkSink&) = delete;
+  ChunkSink(ChunkSink&&)                 = delete;
+  ChunkSink& operator=(ChunkSink&&)      = delete;
+  virtual ~ChunkSink()                   = default;
+
+  /**
+   * @brief Writes the next elements. Called from the writer thread of the
+   * stream.
+   */
+  virtual void write(const E* data, std::size_t count) = 0;
+
+  /**
+   * @brief Completes the output once every element has been written. Called
+   * from the calling thread of streamChunks(), not after a failure.
+   */
+  virtual void finish() {}
+};
+
+/**
+ * @brief Source reading a serialized array (see writeArray()) chunk by chunk.
+ */
+template <typename E> class ArraySource final : public ChunkSource<E> {
+public:
+  /**
+   * @brief Reads the header of an array from a stream, which must outlive the
+   * source.
+   * @param is The stream, opened in binary mode and positioned at the header.
+   * @throws std::runtime_error if the stream does not hold an array of E.
+   */
+  explicit ArraySource(std::istream& is) : m_stream(&is) { m_remaining = m_size = readArrayHeader<E>(is); }
+
+  /**
+   * @brief Opens a serialized array file.
+   * @throws std::runtime_error if the file cannot be read or does not hold an
+   * array of E.
+   */
+  explicit ArraySource(const std::string& path)
+      : m_file(new std::ifstream(path, std::ios::binary)), m_stream(m_file.get()) {
+    if(!*m_file) {
+      throw std::runtime_error("linalg: cannot open " + path);
+    }
+    m_remaining = m_size = readArrayHeader<E>(*m_file);
+  }
+
+  /**
+   * @brief Returns the number of elements of the array.
+   */
+  std::size_t size() const noexcept { return m_size; }
+
+  /**
+   * @throws std::runtime_error if the array is truncated.
+   */
+  std::size_t read(E* out, std::size_t capacity) override {
+    const std::size_t count = capacity < m_remaining ? capacity : m_remaining;
+    if(count > 0 && !m_stream->read(reinterpret_cast<char*>(out), static_cast<std::streamsize>(count * sizeof(E)))) {
+      throw std::runtime_error("linalg: serialized array is truncated");
+    }
+    m_remaining -= count;
+    return count;
+  }
+
+private:
+  std::unique_ptr<std::ifstream> m_file;
+  std::istream*                  m_stream;
+  std::size_t                    m_size      = 0;
+  std::size_t                    m_remaining = 0;
+};
+
+/**
+ * @brief Sink writing a serialized array chunk by chunk, readable by
+ * readArray() and MappedArray once finished.
+ *
+ * The element count is not known up front: the header is written with a count
+ * of zero and rewritten by finish(), so the stream must be seekable.
+ */
+template <typename E> class ArraySink final : public ChunkSink<E> {
+public:
+  /**
+   * @brief Writes the header of an array to a stream, which must outlive the
+   * sink.
+   * @param os The stream, opened in binary mode.
+   * @throws std::runtime_error if the stream fails.
+   */
+  explicit ArraySink(std::ostream& os) : m_stream(&os) { start(); }
+
+  /**
+   * @brief Creates a serialized array file, replacing its contents.
+   * @throws std::runtime_error if the file cannot be written.
+   */
+  explicit ArraySink(const std::string& path)
+      : m_file(new std::ofstream(path, std::ios::binary | std::ios::trunc)), m_stream(m_file.get()) {
+    if(!*m_file) {
+      throw std::runtime_error("linalg: cannot open " + path + " for writing");
+    }
+    start();
+  }
+
+  /**
+   * @brief Returns the number of elements written so far.
+   */
+  std::size_t size() const noexcept { return m_size; }
+
+  /**
+   * @throws std::runtime_error if the stream fails.
+   */
+  void write(const E* data, std::size_t count) override {
+    if(!m_stream->write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(E)))) {
+      throw std::runtime_error("linalg: failed to write serialized array");
+    }
+    m_size += count;
+  }
+
+  /**
+   * @brief Rewrites the header with the number of elements written and flushes
+   * the stream.
+   * @throws std::runtime_error if the stream fails or is not seekable.
+   */
+  void finish() override {
+    const std::ostream::pos_type end = m_stream->tellp();
+    if(end == std::ostream::pos_type(-1) || !m_stream->seekp(m_start)) {
+      throw std::runtime_error("linalg: serialized array sink requires a seekable stream");
+    }
+    writeArrayHeader<E>(*m_stream, m_size);
+    if(!m_stream->seekp(end) || !m_stream->flush()) {
+      throw std::runtime_error("linalg: failed to write serialized array");
+    }
+  }
+
+private:
+  void start() {
+    m_start = m_stream->tellp();
+    writeArrayHeader<E>(*m_stream, 0);
+  }
+
+  std::unique_ptr<std::ofstream> m_file;
+  std::ostream*                  m_stream;
+  std::ostream::pos_type         m_start = 0;
+  std::size_t                    m_size  = 0;
+};
+
+namespace detail {
+
+/**
+ * @brief Runs a stream with an optional sink.
+ *
+ * The chunks go through the ring in order: chunk i uses buffer
+ * i % STREAM_BUFFERS, and is read once chunk i - STREAM_BUFFERS has been
+ * written. Without a sink, a chunk counts as written once processed.
+ */
+template <typename E, typename Stage>
+std::size_t runStream(ChunkSource<E>& source, ChunkSink<E>* sink, std::size_t chunk, const Stage& stage) {
+  chunk = chunk == 0 ? 1 : chunk;
+  AlignedVector<E> buffers[STREAM_BUFFERS];
+  std::size_t      counts[STREAM_BUFFERS] = {};
+  for(AlignedVector<E>& buffer : buffers) {
+    buffer.resize(chunk);
+  }
+
+  std::mutex              mutex;
+  std::condition_variable changed;
+  std::size_t             read      = 0;
+  std::size_t             processed = 0;
+  std::size_t             written   = 0;
+  bool                    exhausted = false;
+  bool                    done      = false;
+  bool                    stop      = false;
+  std::exception_ptr      error;
+
+  // Records the first error and wakes every thread up to stop.
+  const auto fail = [&](std::exception_ptr e) {
+    {
+      const std::lock_guard<std::mutex> lock(mutex);
+      if(!error) {
+        error = e;
+      }
+      stop = true;
+    }
+    changed.notify_all();
+  };
+
+  std::thread reader([&] {
+    for(;;) {
+      std::size_t slot;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return stop || read - written < STREAM_BUFFERS; });
+        if(stop) {
+          return;
+        }
+        slot = read % STREAM_BUFFERS;
+      }
+      std::size_t count;
+      try {
+        count = source.read(buffers[slot].data(), chunk);
+      } catch(...) {
+        fail(std::current_exception());
+        return;
+      }
+      {
+        const std::lock_guard<std::mutex> lock(mutex);
+        counts[slot] = count;
+        if(count == 0) {
+          exhausted = true;
+        } else {
+          ++read;
+        }
+      }
+      changed.notify_all();
+      if(count == 0) {
+        return;
+      }
+    }
+  });
+
+  std::thread writer;
+  if(sink != nullptr) {
+    writer = std::thread([&] {
+      for(;;) {
+        std::size_t slot;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          changed.wait(lock, [&] { return stop || done || written < processed; });
+          if(stop || written == processed) {
+            return;
+          }
+          slot = written % STREAM_BUFFERS;
+        }
+        try {
+          sink->write(buffers[slot].data(), counts[slot]);
+        } catch(...) {
+          fail(std::current_exception());
+          return;
+        }
+        {
+          const std::lock_guard<std::mutex> lock(mutex);
+          ++written;
+        }
+        changed.notify_all();
+      }
+    });
+  }
+
+  std::size_t total = 0;
+  for(;;) {
+    std::size_t slot;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [&] { return stop || exhausted || processed < read; });
+      if(stop || processed == read) {
+        break;
+      }
+      slot = processed % STREAM_BUFFERS;
+    }
+    try {
+      stage(buffers[slot].data(), counts[slot]);
+    } catch(...) {
+      fail(std::current_exception());
+      break;
+    }
+    total += counts[slot];
+    {
+      const std::lock_guard<std::mutex> lock(mutex);
+      ++processed;
+      if(sink == nullptr) {
+        written = processed;
+      }
+    }
+    changed.notify_all();
+  }
+  {
+    const std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+  }
+  changed.notify_all();
+  reader.join();
+  if(writer.joinable()) {
+    writer.join();
+  }
+
+  if(error) {
+    std::rethrow_exception(error);
+  }
+  if(sink != nullptr) {
+    sink->finish();
+  }
+  return total;
+}
+
+inline namespace LINALG_SIMD_ABI {
+
+/**
+ * @brief Grows a box to contain an array of points, loading each padded Vec3
+ * as one pack. NaN components are ignored.
+ */
+template <typename T> inline void expandBounds(AABB<T>& box, const Vec3<T>* points, std::size_t count) noexcept {
+  static_assert(sizeof(Vec3<T>) == 4 * sizeof(T), "Vec3 is expected to be padded to four elements");
+  using P      = simd::Pack<T, 4>;
+  T lo_init[4] = {box.min.x, box.min.y, box.min.z, 0};
+  T hi_init[4] = {box.max.x, box.max.y, box.max.z, 0};
+  P lo         = P::load(lo_init);
+  P hi         = P::load(hi_init);
+  for(std::size_t i = 0; i < count; ++i) {
+    // min and max return their second operand when the first is NaN.
+    const P p = P::load(&points[i].x);
+    lo        = simd::min(p, lo);
+    hi        = simd::max(p, hi);
+  }
+  lo.store(lo_init);
+  hi.store(hi_init);
+  box.min = Vec3<T>(lo_init[0], lo_init[1], lo_init[2]);
+  box.max = Vec3<T>(hi_init[0], hi_init[1], hi_init[2]);
+}
+
+/**
+ * @brief Transforms a chunk of points in place and grows a box to contain the
+ * results, one cache-sized range at a time so that the bounds read the points
+ * while they are still in cache.
+ */
+template <typename T>
+inline void transformAndExpand(const Mat4<T>& mat, Vec3<T>* points, std::size_t count, AABB<T>& box) noexcept {
+  const std::size_t range = parallelChunkSize<Vec3<T>>();
+  for(std::size_t begin = 0; begin < count; begin += range) {
+    const std::size_t size = count - begin < range ? count - begin : range;
+    transformPoints(mat, points + begin, points + begin, size);
+    expandBounds(box, points + begin, size);
+  }
+}
+
+} // namespace LINALG_SIMD_ABI
+
+} // namespace detail
+
+/**
+ * @brief Runs stage(data, count) on every chunk of a source in order and
+ * writes the chunks, as modified by the stage, to a sink.
+ *
+ * The source is read by a reader thread and the sink written by a writer
+ * thread, overlapping with the stage, which runs on the calling thread. At
+ * most STREAM_BUFFERS chunks are held in memory.
+ * @param source The source of the elements.
+ * @param sink The sink of the processed elements. finish() is called once the
+ * last chunk has been written.
+ * @param chunk The number of elements per chunk (0 is treated as 1).
+ * @param stage The function processing a chunk in place.
+ * @return The number of elements streamed.
+ * @throws The first exception thrown by the source, the stage or the sink,
+ * once the threads have stopped.
+ */
+template <typename E, typename Stage>
+std::size_t streamChunks(ChunkSource<E>& source, ChunkSink<E>& sink, std::size_t chunk, const Stage& stage) {
+  return detail::runStream(source, &sink, chunk, stage);
+}
+
+/**
+ * @brief Runs stage(data, count) on every chunk of a source in order, reading
+ * the next chunks while the stage runs. Use it for reductions.
+ * @param source The source of the elements.
+ * @param chunk The number of elements per chunk (0 is treated as 1).
+ * @param stage The function processing a chunk.
+ * @return The number of elements streamed.
+ * @throws The first exception thrown by the source or the stage, once the
+ * reader thread has stopped.
+ */
+template <typename E, typename Stage>
+std::size_t streamChunks(ChunkSource<E>& source, std::size_t chunk, const Stage& stage) {
+  return detail::runStream(source, static_cast<ChunkSink<E>*>(nullptr), chunk, stage);
+}
+
+/**
+ * @brief Transforms a stream of points by a Mat4, as transformPoints() in
+ * Batch.hpp, and computes the bounds of the transformed points.
+ * @param source The input points.
+ * @param mat The transformation matrix.
+ * @param sink The output points.
+ * @param chunk The number of points per chunk.
+ * @return The box of the transformed points, empty if the source is. NaN
+ * components are ignored.
+ * @throws The first exception thrown by the source or the sink.
+ */
+template <typename T>
+AABB<T> transformPoints(ChunkSource<Vec3<T>>& source, const Mat4<T>& mat, ChunkSink<Vec3<T>>& sink,
+                        std::size_t chunk = streamChunkSize<Vec3<T>>()) {
+  AABB<T> box;
+  streamChunks(source, sink, chunk,
+               [&](Vec3<T>* points, std::size_t count) { detail::transformAndExpand(mat, points, count, box); });
+  return box;
+}
+
+/**
+ * @brief Transforms a stream of points by a Mat4 and computes their bounds,
+ * processing each chunk in parallel on an executor.
+ * @param executor The executor running the ranges of each chunk.
+ * @param source The input points.
+ * @param mat The transformation matrix.
+ * @param sink The output points.
+ * @param chunk The number of points per chunk.
+ * @return The box of the transformed points, empty if the source is. NaN
+ * components are ignored.
+ * @throws The first exception thrown by the source or the sink.
+ */
+template <typename T>
+AABB<T> transformPoints(Executor& executor, ChunkSource<Vec3<T>>& source, const Mat4<T>& mat, ChunkSink<Vec3<T>>& sink,
+                        std::size_t chunk = streamChunkSize<Vec3<T>>()) {
+  AABB<T> box;
+  streamChunks(source, sink, chunk, [&](Vec3<T>* points, std::size_t count) {
+    box.merge(parallelReduce(
+        executor, count, parallelChunkSize<Vec3<T>>(), AABB<T>(),
+        [&](std::size_t begin, std::size_t end) {
+          AABB<T> range;
+          detail::transformAndExpand(mat, points + begin, end - begin, range);
+          return range;
+        },
+        [](const AABB<T>& a, const AABB<T>& b) { return a.merged(b); }));
+  });
+  return box;
+}
+
+/**
+ * @brief Computes the bounds of a stream of points.
+ * @param source The points.
+ * @param chunk The number of points per chunk.
+ * @return The box of the points, empty if the source is. NaN components are
+ * ignored.
+ * @throws The first exception thrown by the source.
+ */
+template <typename T>
+AABB<T> streamBounds(ChunkSource<Vec3<T>>& source, std::size_t chunk = streamChunkSize<Vec3<T>>()) {
+  AABB<T> box;
+  streamChunks(source, chunk, [&](Vec3<T>* points, std::size_t count) { detail::expandBounds(box, points, count); });
+  return box;
+}
+
+} // namespace linalg
+
+#endif // LINALG_STREAM_HPP
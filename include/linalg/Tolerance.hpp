@@ -0,0 +1,157 @@
+/**
+ * @file Tolerance.hpp
+ * @brief Comparison tolerances and branch-free SIMD element-wise comparisons.
+ *
+ * Tolerance<T> accepts two values when their difference is within an absolute
+ * bound or within a bound relative to their magnitude, so that a single policy
+ * works for both small and large elements and scales with the precision of T.
+ *
+ * The detail::allLanes() kernels compare arrays of elements in SIMD packs,
+ * combine the lane masks with bitwise ands and test the result once, instead
+ * of branching after every element. Mat3 and Mat4 use them for operator== and
+ * isApprox().
+ */
+#ifndef LINALG_TOLERANCE_HPP
+#define LINALG_TOLERANCE_HPP
+
+#include <cmath>
+#include <limits>
+
+#include "Pack.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Comparison policy accepting a and b when
+ * |a - b| <= max(absolute, relative * max(|a|, |b|)).
+ * @tparam T The type of the compared values (e.g., float, double).
+ */
+template <typename T> struct Tolerance {
+  T absolute;
+  T relative;
+
+  constexpr Tolerance(T absolute, T relative) noexcept : absolute(absolute), relative(relative) {}
+
+  /**
+   * @brief Returns a purely absolute tolerance, as the epsilon of isApprox().
+   */
+  static constexpr Tolerance Absolute(T epsilon) noexcept { return {epsilon, T(0)}; }
+
+  /**
+   * @brief Returns a relative tolerance of about n units in the last place.
+   * Values closer to zero than the smallest normal value are compared with an
+   * absolute bound of that value.
+   */
+  static constexpr Tolerance Ulps(unsigned n) noexcept {
+    return {std::numeric_limits<T>::min(), T(n) * std::numeric_limits<T>::epsilon()};
+  }
+
+  /**
+   * @brief Returns the default tolerance: 64 units in the last place relative
+   * to the larger magnitude, and the same bound absolute for elements of
+   * magnitude 1 or lower (about 7.6e-6 for float and 1.4e-14 for double).
+   */
+  static constexpr Tolerance Default() noexcept {
+    return {T(64) * std::numeric_limits<T>::epsilon(), T(64) * std::numeric_limits<T>::epsilon()};
+  }
+
+  /**
+   * @brief Returns the determinant magnitude below which a matrix is treated as
+   * singular.
+   */
+  static constexpr T SingularDeterminant() noexcept { return T(8) * std::numeric_limits<T>::epsilon(); }
+
+  /**
+   * @brief Checks if two values are equal within this tolerance. NaNs are never
+   * equal.
+   */
+  bool operator()(T a, T b) const noexcept {
+    const T magnitude = std::abs(a) > std::abs(b) ? std::abs(a) : std::abs(b);
+    const T bound     = relative * magnitude > absolute ? relative * magnitude : absolute;
+    return std::abs(a - b) <= bound;
+  }
+};
+
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+/**
+ * @brief Lane-wise exact equality.
+ */
+struct EqualLanes {
+  template <typename P> typename P::Mask operator()(const P& a, const P& b) const noexcept { return a == b; }
+};
+
+/**
+ * @brief Lane-wise |a - b| <= epsilon.
+ */
+template <typename T> struct AbsoluteLanes {
+  T epsilon;
+
+  template <typename P> typename P::Mask operator()(const P& a, const P& b) const noexcept {
+    return simd::abs(a - b) <= P::broadcast(epsilon);
+  }
+};
+
+/**
+ * @brief Lane-wise Tolerance<T> comparison.
+ */
+template <typename T> struct ToleranceLanes {
+  Tolerance<T> tolerance;
+
+  template <typename P> typename P::Mask operator()(const P& a, const P& b) const noexcept {
+    const P magnitude = simd::max(simd::abs(a), simd::abs(b));
+    const P bound     = simd::max(P::broadcast(tolerance.absolute), P::broadcast(tolerance.relative) * magnitude);
+    return simd::abs(a - b) <= bound;
+  }
+};
+
+/**
+ * @brief Checks that op holds for the lanes of the first N elements of a and b:
+ * as many packs of W lanes as fit, then the remainder with narrower packs.
+ */
+template <typename T, int N, int W, bool FITS = (N >= W)> struct AllLanes {
+  template <typename Op> static bool apply(const T* a, const T* b, const Op& op) noexcept {
+    using P                    = simd::Pack<T, W>;
+    static constexpr int PACKS = N / W;
+    typename P::Mask     mask  = op(P::load(a), P::load(b));
+    for(int i = 1; i < PACKS; ++i) {
+      mask = mask & op(P::load(a + i * W), P::load(b + i * W));
+    }
+    // A bitwise and keeps the check of the remainder branch-free.
+    return simd::all(mask) & AllLanes<T, N % W, W / 2>::apply(a + PACKS * W, b + PACKS * W, op);
+  }
+};
+
+template <typename T, int N, int W> struct AllLanes<T, N, W, false> {
+  template <typename Op> static bool apply(const T* a, const T* b, const Op& op) noexcept {
+    return AllLanes<T, N, W / 2>::apply(a, b, op);
+  }
+};
+
+template <typename T, int W> struct AllLanes<T, 0, W, false> {
+  template <typename Op> static bool apply(const T* /*a*/, const T* /*b*/, const Op& /*op*/) noexcept { return true; }
+};
+
+template <typename T> struct AllLanes<T, 0, 0, true> {
+  template <typename Op> static bool apply(const T* /*a*/, const T* /*b*/, const Op& /*op*/) noexcept { return true; }
+};
+
+/**
+ * @brief Checks that op holds for each of the N elements of a and b, starting
+ * with the widest native packs.
+ */
+template <typename T, int N, typename Op> inline bool allLanes(const T* a, const T* b, const Op& op) noexcept {
+  return AllLanes<T, N, simd::NativePack<T>::WIDTH>::apply(a, b, op);
+}
+
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+
+} // namespace linalg
+
+#endif // LINALG_TOLERANCE_HPP
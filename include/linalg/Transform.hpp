@@ -0,0 +1,248 @@
+/**
+ * @file Transform.hpp
+ * @brief Translation, rotation and scale transform with cached matrices.
+ *
+ * Scene graph nodes are usually described by a translation, a rotation and a
+ * scale, most of which do not change from one frame to the next. Transform
+ * stores these components and builds the matrices derived from them directly
+ * (no Mat4 products or general inverses), only when a component changed since
+ * they were last requested.
+ */
+#ifndef LINALG_TRANSFORM_HPP
+#define LINALG_TRANSFORM_HPP
+
+#include <cmath>
+
+#include "Mat3.hpp"
+#include "Mat4.hpp"
+#include "Quat.hpp"
+#include "Vec3.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief Transform applying a scale, then a rotation, then a translation
+ * (M = T * R * S).
+ *
+ * matrix(), inverseMatrix() and normalMatrix() are computed on first use and
+ * cached until one of the components is modified.
+ * @tparam T The type of the components (e.g., float, double).
+ * @note The const accessors update the caches, so a Transform must not be read
+ * from several threads while its matrices are dirty.
+ */
+template <typename T> class Transform {
+public:
+  /**
+   * @brief Default constructor initializes the transform to the identity.
+   */
+  Transform() noexcept : Transform(Vec3<T>(0, 0, 0), Quat<T>(), Vec3<T>(1, 1, 1)) {}
+
+  /**
+   * @brief Constructor that initializes the transform from its components.
+   * @param translation The translation.
+   * @param rotation The rotation (must be normalized).
+   * @param scale The scale along each local axis.
+   */
+  Transform(const Vec3<T>& translation, const Quat<T>& rotation, const Vec3<T>& scale) noexcept
+      : m_translation(translation), m_rotation(rotation), m_scale(scale) {}
+
+  /**
+   * @brief Decomposes an affine matrix without shear into a transform.
+   *
+   * The scale is the length of each column of the top-left 3x3 block. A negative
+   * determinant (a reflection) is carried by the x scale.
+   * @param mat The matrix, with a bottom row of [0 0 0 1] and non-zero scale.
+   * @return A Transform whose matrix() is mat, up to rounding.
+   */
+  static Transform FromMat4(const Mat4<T>& mat) noexcept {
+    const auto&   m = mat.m;
+    const Vec3<T> c0(m[0][0], m[1][0], m[2][0]);
+    const Vec3<T> c1(m[0][1], m[1][1], m[2][1]);
+    const Vec3<T> c2(m[0][2], m[1][2], m[2][2]);
+    Vec3<T>       scale(c0.length(), c1.length(), c2.length());
+    const Vec3<T> c12 = c1.cross(c2);
+    if(c0.x * c12.x + c0.y * c12.y + c0.z * c12.z < 0) {
+      scale.x = -scale.x;
+    }
+    const Mat3<T> rotation(c0.x / scale.x, c1.x / scale.y, c2.x / scale.z, c0.y / scale.x, c1.y / scale.y,
+                           c2.y / scale.z, c0.z / scale.x, c1.z / scale.y, c2.z / scale.z);
+    return {Vec3<T>(m[0][3], m[1][3], m[2][3]), Quat<T>::FromMat3(rotation), scale};
+  }
+
+  /**
+   * @brief Returns the translation.
+   */
+  const Vec3<T>& translation() const noexcept { return m_translation; }
+
+  /**
+   * @brief Returns the rotation.
+   */
+  const Quat<T>& rotation() const noexcept { return m_rotation; }
+
+  /**
+   * @brief Returns the scale.
+   */
+  const Vec3<T>& scale() const noexcept { return m_scale; }
+
+  /**
+   * @brief Sets the translation. Only matrix() and inverseMatrix() are
+   * invalidated: the normal matrix does not depend on it.
+   * @param translation The new translation.
+   */
+  void setTranslation(const Vec3<T>& translation) noexcept {
+    m_translation   = translation;
+    m_matrix_dirty  = true;
+    m_inverse_dirty = true;
+  }
+
+  /**
+   * @brief Sets the rotation.
+   * @param rotation The new rotation (must be normalized).
+   */
+  void setRotation(const Quat<T>& rotation) noexcept {
+    m_rotation = rotation;
+    invalidate();
+  }
+
+  /**
+   * @brief Sets the scale.
+   * @param scale The new scale along each local axis.
+   */
+  void setScale(const Vec3<T>& scale) noexcept {
+    m_scale = scale;
+    invalidate();
+  }
+
+  /**
+   * @brief Returns the matrix T * R * S.
+   *
+   * The columns of the top-left 3x3 block are those of the rotation matrix
+   * multiplied by the scale, and the last column is the translation.
+   */
+  const Mat4<T>& matrix() const noexcept {
+    if(m_matrix_dirty) {
+      updateRotation();
+      for(int i = 0; i < 3; ++i) {
+        m_matrix.m[i][0] = m_rotation_matrix.m[i][0] * m_scale.x;
+        m_matrix.m[i][1] = m_rotation_matrix.m[i][1] * m_scale.y;
+        m_matrix.m[i][2] = m_rotation_matrix.m[i][2] * m_scale.z;
+      }
+      m_matrix.m[0][3] = m_translation.x;
+      m_matrix.m[1][3] = m_translation.y;
+      m_matrix.m[2][3] = m_translation.z;
+      m_matrix_dirty   = false;
+    }
+    return m_matrix;
+  }
+
+  /**
+   * @brief Returns the inverse of matrix(), S^-1 * R^T * T^-1.
+   *
+   * The rows of the top-left 3x3 block are those of the transposed rotation
+   * divided by the scale, followed by the translation fixup.
+   * @return The inverse, or the identity if a scale component is zero.
+   */
+  const Mat4<T>& inverseMatrix() const noexcept {
+    if(m_inverse_dirty) {
+      if(isSingular()) {
+        m_inverse = Mat4<T>{};
+      } else {
+        updateRotation();
+        const T inv_scale[3] = {1 / m_scale.x, 1 / m_scale.y, 1 / m_scale.z};
+        for(int i = 0; i < 3; ++i) {
+          m_inverse.m[i][0] = m_rotation_matrix.m[0][i] * inv_scale[i];
+          m_inverse.m[i][1] = m_rotation_matrix.m[1][i] * inv_scale[i];
+          m_inverse.m[i][2] = m_rotation_matrix.m[2][i] * inv_scale[i];
+          m_inverse.m[i][3] = -(m_inverse.m[i][0] * m_translation.x + m_inverse.m[i][1] * m_translation.y +
+                                m_inverse.m[i][2] * m_translation.z);
+        }
+      }
+      m_inverse_dirty = false;
+    }
+    return m_inverse;
+  }
+
+  /**
+   * @brief Returns the matrix transforming normals, the inverse-transpose of
+   * the top-left 3x3 block of matrix().
+   *
+   * For R * S it is R * S^-1: the columns of the rotation divided by the scale.
+   * @return The normal matrix, or the identity if a scale component is zero.
+   */
+  const Mat3<T>& normalMatrix() const noexcept {
+    if(m_normal_dirty) {
+      if(isSingular()) {
+        m_normal = Mat3<T>{};
+      } else {
+        updateRotation();
+        const T inv_x = 1 / m_scale.x;
+        const T inv_y = 1 / m_scale.y;
+        const T inv_z = 1 / m_scale.z;
+        for(int i = 0; i < 3; ++i) {
+          m_normal.m[i][0] = m_rotation_matrix.m[i][0] * inv_x;
+          m_normal.m[i][1] = m_rotation_matrix.m[i][1] * inv_y;
+          m_normal.m[i][2] = m_rotation_matrix.m[i][2] * inv_z;
+        }
+      }
+      m_normal_dirty = false;
+    }
+    return m_normal;
+  }
+
+  /**
+   * @brief Transforms a point, R * (S * p) + t.
+   * @param point The point to transform.
+   * @return The transformed point.
+   */
+  Vec3<T> transformPoint(const Vec3<T>& point) const noexcept {
+    return m_rotation.rotate(Vec3<T>(point.x * m_scale.x, point.y * m_scale.y, point.z * m_scale.z)) + m_translation;
+  }
+
+  /**
+   * @brief Transforms a direction, R * (S * d), ignoring the translation.
+   * @param direction The direction to transform.
+   * @return The transformed direction.
+   */
+  Vec3<T> transformDirection(const Vec3<T>& direction) const noexcept {
+    return m_rotation.rotate(Vec3<T>(direction.x * m_scale.x, direction.y * m_scale.y, direction.z * m_scale.z));
+  }
+
+private:
+  void invalidate() noexcept {
+    m_rotation_dirty = true;
+    m_matrix_dirty   = true;
+    m_inverse_dirty  = true;
+    m_normal_dirty   = true;
+  }
+
+  bool isSingular() const noexcept { return m_scale.x == T(0) || m_scale.y == T(0) || m_scale.z == T(0); }
+
+  // The rotation matrix is shared by the three cached matrices.
+  void updateRotation() const noexcept {
+    if(m_rotation_dirty) {
+      m_rotation_matrix = m_rotation.toMat3();
+      m_rotation_dirty  = false;
+    }
+  }
+
+  Vec3<T> m_translation;
+  Quat<T> m_rotation;
+  Vec3<T> m_scale;
+
+  mutable Mat3<T> m_rotation_matrix;
+  mutable Mat4<T> m_matrix;
+  mutable Mat4<T> m_inverse;
+  mutable Mat3<T> m_normal;
+  mutable bool    m_rotation_dirty = true;
+  mutable bool    m_matrix_dirty   = true;
+  mutable bool    m_inverse_dirty  = true;
+  mutable bool    m_normal_dirty   = true;
+};
+
+} // namespace linalg
+
+#endif // LINALG_TRANSFORM_HPP
@@ -6,12 +6,13 @@
 #define LINALG_VEC3_HPP
 
 #include <cmath>
-#include <immintrin.h>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
 
 #include "Alignment.hpp"
+#include "Instrument.hpp"
+#include "Pack.hpp"
 
 /**
  * @namespace lin
@@ -218,6 +219,8 @@ template <typename T> struct alignas(linalg::VecAlignment<T, 3>::VALUE) Vec3 {
    */
   Vec3 normalized() const noexcept {
     const T len = length();
+    LINALG_INSTRUMENT_COUNT(Normalize);
+    LINALG_INSTRUMENT_COUNT_IF(!(len > 0.0), NormalizeZeroLength);
     return len > 0.0 ? (*this / len) : Vec3(0.0);
   }
 
@@ -227,11 +230,52 @@ template <typename T> struct alignas(linalg::VecAlignment<T, 3>::VALUE) Vec3 {
    */
   void normalize() noexcept {
     const T len = length();
+    LINALG_INSTRUMENT_COUNT(Normalize);
+    LINALG_INSTRUMENT_COUNT_IF(!(len > 0.0), NormalizeZeroLength);
     if(len > 0.0) {
       *this /= len;
     }
   }
 
+  /**
+   * @brief Computes an approximation of the length of the vector, multiplying
+   * the squared length by simd::rsqrtFast() of it instead of calling std::sqrt.
+   * @return The length, within simd::RSQRT_FAST_MAX_ULP + 2 units in the last
+   * place for float.
+   */
+  T lengthFast() const noexcept {
+    const T len2 = squaredLength();
+    return simd::rsqrtFastInRange(len2) ? len2 * simd::rsqrtFast(len2) : length();
+  }
+
+  /**
+   * @brief Returns an approximately normalized version of the vector.
+   *
+   * Multiplies by simd::rsqrtFast() of the squared length instead of dividing by
+   * the length. For float each component is within simd::RSQRT_FAST_MAX_ULP + 2
+   * units in the last place of normalized(); for double the result only differs
+   * by the rounding of the reciprocal. Zero, subnormal and overflowing squared
+   * lengths go through normalized().
+   * @return A new Vec3 object that is the normalized version of this vector.
+   */
+  Vec3 normalizedFast() const noexcept {
+    const T len2 = squaredLength();
+    return simd::rsqrtFastInRange(len2) ? *this * simd::rsqrtFast(len2) : normalized();
+  }
+
+  /**
+   * @brief Normalizes the vector in place, approximately (see normalizedFast()).
+   * If the length is zero, the vector remains unchanged.
+   */
+  void normalizeFast() noexcept {
+    const T len2 = squaredLength();
+    if(simd::rsqrtFastInRange(len2)) {
+      *this *= simd::rsqrtFast(len2);
+    } else {
+      normalize();
+    }
+  }
+
   /**
    * @brief Computes the cross product of this vector and another Vec3.
    * @param other The Vec3 to compute the cross product with.
@@ -246,7 +290,7 @@ template <typename T> struct alignas(linalg::VecAlignment<T, 3>::VALUE) Vec3 {
    * @return A new Vec3 object where each component is the inverse of the
    * corresponding component of this vector.
    */
-  constexpr Vec3 cwiseInverse() const noexcept { return {1.0 / x, 1.0 / y, 1.0 / z}; }
+  constexpr Vec3 cwiseInverse() const noexcept { return {T(1) / x, T(1) / y, T(1) / z}; }
 
   /**
    * @brief Computes the minimum value of the vector components.
@@ -0,0 +1,248 @@
+/**
+ * @file Vec3Packet.hpp
+ * @brief Packets of Vec3 with one SIMD lane per vector, for coherent ray
+ * tracing and other workloads processing several vectors in lockstep.
+ */
+#ifndef LINALG_VEC3PACKET_HPP
+#define LINALG_VEC3PACKET_HPP
+
+#include "Instrument.hpp"
+#include "Pack.hpp"
+#include "Vec3.hpp"
+
+/**
+ * @namespace linalg
+ * @brief Namespace for linear algebra utility functions and classes.
+ */
+namespace linalg {
+
+/**
+ * @brief N Vec3 vectors stored as one pack per component.
+ * @tparam T The type of the vector elements (e.g., float, double).
+ * @tparam N The number of vectors (lanes) in the packet.
+ */
+template <typename T, int N> struct Vec3Packet {
+  using PackType = simd::Pack<T, N>;
+  using Mask     = typename PackType::Mask;
+
+  static constexpr int WIDTH = N;
+
+  PackType x;
+  PackType y;
+  PackType z;
+
+  /**
+   * @brief Default constructor initializes every lane to (0, 0, 0).
+   */
+  Vec3Packet() noexcept : x(PackType::broadcast(0)), y(PackType::broadcast(0)), z(PackType::broadcast(0)) {}
+
+  /**
+   * @brief Constructor that initializes the packet from its component packs.
+   */
+  Vec3Packet(const PackType& x, const PackType& y, const PackType& z) noexcept : x(x), y(y), z(z) {}
+
+  /**
+   * @brief Returns a packet with every lane set to the same vector.
+   * @param v The vector to broadcast.
+   */
+  static Vec3Packet Broadcast(const Vec3<T>& v) noexcept {
+    return {PackType::broadcast(v.x), PackType::broadcast(v.y), PackType::broadcast(v.z)};
+  }
+
+  /**
+   * @brief Loads N consecutive vectors from structure-of-arrays storage.
+   * @param px Pointer to the x components.
+   * @param py Pointer to the y components.
+   * @param pz Pointer to the z components.
+   */
+  static Vec3Packet Load(const T* px, const T* py, const T* pz) noexcept {
+    return {PackType::load(px), PackType::load(py), PackType::load(pz)};
+  }
+
+  /**
+   * @brief Loads N consecutive vectors from an array of Vec3.
+   * @param in Pointer to the first vector.
+   */
+  static Vec3Packet Gather(const Vec3<T>* in) noexcept {
+    T px[N];
+    T py[N];
+    T pz[N];
+    for(int i = 0; i < N; ++i) {
+      px[i] = in[i].x;
+      py[i] = in[i].y;
+      pz[i] = in[i].z;
+    }
+    return Load(px, py, pz);
+  }
+
+  /**
+   * @brief Stores the N vectors to structure-of-arrays storage.
+   * @param px Pointer to the x components.
+   * @param py Pointer to the y components.
+   * @param pz Pointer to the z components.
+   */
+  void store(T* px, T* py, T* pz) const noexcept {
+    x.store(px);
+    y.store(py);
+    z.store(pz);
+  }
+
+  /**
+   * @brief Stores the N vectors to an array of Vec3.
+   * @param out Pointer to the first vector.
+   */
+  void scatter(Vec3<T>* out) const noexcept {
+    T px[N];
+    T py[N];
+    T pz[N];
+    store(px, py, pz);
+    for(int i = 0; i < N; ++i) {
+      out[i] = Vec3<T>(px[i], py[i], pz[i]);
+    }
+  }
+
+  /**
+   * @brief Returns the vector held in one lane.
+   * @param index The lane index.
+   */
+  Vec3<T> lane(int index) const noexcept { return {x.lane(index), y.lane(index), z.lane(index)}; }
+
+  Vec3Packet operator+(const Vec3Packet& other) const noexcept { return {x + other.x, y + other.y, z + other.z}; }
+  Vec3Packet operator-(const Vec3Packet& other) const noexcept { return {x - other.x, y - other.y, z - other.z}; }
+  Vec3Packet operator-() const noexcept { return {-x, -y, -z}; }
+
+  /**
+   * @brief Scales each lane by the matching lane of a pack.
+   */
+  Vec3Packet operator*(const PackType& scalar) const noexcept { return {x * scalar, y * scalar, z * scalar}; }
+
+  /**
+   * @brief Scales every lane by the same scalar.
+   */
+  Vec3Packet operator*(T scalar) const noexcept { return *this * PackType::broadcast(scalar); }
+};
+
+/**
+ * @brief Packet of four float vectors, one SSE register per component.
+ */
+using Vec3x4f = Vec3Packet<float, 4>;
+
+/**
+ * @brief Packet of eight float vectors, one AVX register per component (the
+ * generic scalar pack without AVX).
+ */
+using Vec3x8f = Vec3Packet<float, 8>;
+
+/**
+ * @brief Computes the dot product of each pair of lanes.
+ */
+template <typename T, int N>
+inline simd::Pack<T, N> dot(const Vec3Packet<T, N>& a, const Vec3Packet<T, N>& b) noexcept {
+  return simd::madd(a.x, b.x, simd::madd(a.y, b.y, a.z * b.z));
+}
+
+/**
+ * @brief Computes the cross product of each pair of lanes.
+ */
+template <typename T, int N>
+inline Vec3Packet<T, N> cross(const Vec3Packet<T, N>& a, const Vec3Packet<T, N>& b) noexcept {
+  return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+/**
+ * @brief Computes the length of each lane.
+ */
+template <typename T, int N> inline simd::Pack<T, N> length(const Vec3Packet<T, N>& a) noexcept {
+  return simd::sqrt(dot(a, a));
+}
+
+/**
+ * @brief Selects lanes of a where mask is set and lanes of b elsewhere.
+ */
+template <typename T, int N>
+inline Vec3Packet<T, N> select(const typename Vec3Packet<T, N>::Mask& mask, const Vec3Packet<T, N>& a,
+                               const Vec3Packet<T, N>& b) noexcept {
+  return {simd::select(mask, a.x, b.x), simd::select(mask, a.y, b.y), simd::select(mask, a.z, b.z)};
+}
+
+/**
+ * @brief Normalizes each lane; zero-length lanes become zero, as with
+ * Vec3::normalized().
+ */
+template <typename T, int N> inline Vec3Packet<T, N> normalized(const Vec3Packet<T, N>& a) noexcept {
+  using P     = simd::Pack<T, N>;
+  const P len = length(a);
+  const P inv = P::broadcast(T(1)) / len;
+  return select(len > P::broadcast(T(0)), a * inv, Vec3Packet<T, N>());
+}
+
+/**
+ * @brief Approximately normalizes each lane with simd::rsqrtFast() of the squared
+ * length, with the accuracy of Vec3::normalizedFast(). Lanes whose squared
+ * length is zero, subnormal or overflows become zero.
+ */
+template <typename T, int N> inline Vec3Packet<T, N> normalizedFast(const Vec3Packet<T, N>& a) noexcept {
+  using P                         = simd::Pack<T, N>;
+  const P                len2     = dot(a, a);
+  const typename P::Mask in_range = (len2 >= P::broadcast(std::numeric_limits<T>::min())) &
+                                    (len2 <= P::broadcast(std::numeric_limits<T>::max()));
+  return select(in_range, a * simd::rsqrtFast(len2), Vec3Packet<T, N>());
+}
+
+/**
+ * @brief Reflects each incident lane around the matching normal lane.
+ * @param incident The incident vectors (must be normalized).
+ * @param normal The normal vectors (must be normalized).
+ */
+template <typename T, int N>
+inline Vec3Packet<T, N> reflect(const Vec3Packet<T, N>& incident, const Vec3Packet<T, N>& normal) noexcept {
+  const simd::Pack<T, N> d = simd::Pack<T, N>::broadcast(T(-2)) * dot(incident, normal);
+  return {simd::madd(d, normal.x, incident.x), simd::madd(d, normal.y, incident.y),
+          simd::madd(d, normal.z, incident.z)};
+}
+
+/**
+ * @brief Refracts each incident lane through a surface with the matching
+ * normal lane and refractive index ratio eta.
+ *
+ * Lanes in total internal reflection are reflected instead, as with refract()
+ * in linalg.hpp; both results are computed and blended without branching.
+ * @param incident The incident vectors (must be normalized).
+ * @param normal The normal vectors (must be normalized).
+ * @param eta The ratio of refractive indices (n1 / n2).
+ */
+template <typename T, int N>
+inline Vec3Packet<T, N> refract(const Vec3Packet<T, N>& incident, const Vec3Packet<T, N>& normal, T eta) noexcept {
+  using P           = simd::Pack<T, N>;
+  const P    one    = P::broadcast(T(1));
+  const P    e      = P::broadcast(eta);
+  const P    cos_i  = -dot(normal, incident);
+  const P    sin2_t = e * e * (one - cos_i * cos_i);
+  const auto tir    = sin2_t > one;
+  LINALG_INSTRUMENT_ADD(Refract, N);
+  LINALG_INSTRUMENT_ADD_LANES(RefractTotalInternalReflection, static_cast<unsigned>(tir.bits()));
+  // Lanes in total internal reflection compute a discarded value.
+  const P                cos_t = simd::sqrt(simd::max(one - sin2_t, P::broadcast(T(0))));
+  const P                k     = e * cos_i - cos_t;
+  const Vec3Packet<T, N> refracted(simd::madd(e, incident.x, k * normal.x), simd::madd(e, incident.y, k * normal.y),
+                                   simd::madd(e, incident.z, k * normal.z));
+  return select(tir, reflect(incident, normal), normalized(refracted));
+}
+
+/**
+ * @brief Returns the component-wise minimum over the lanes of a packet.
+ */
+template <typename T, int N> inline Vec3<T> hmin(const Vec3Packet<T, N>& a) noexcept {
+  return {simd::hmin(a.x), simd::hmin(a.y), simd::hmin(a.z)};
+}
+
+/**
+ * @brief Returns the component-wise maximum over the lanes of a packet.
+ */
+template <typename T, int N> inline Vec3<T> hmax(const Vec3Packet<T, N>& a) noexcept {
+  return {simd::hmax(a.x), simd::hmax(a.y), simd::hmax(a.z)};
+}
+
+} // namespace linalg
+
+#endif // LINALG_VEC3PACKET_HPP
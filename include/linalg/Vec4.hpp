@@ -6,12 +6,13 @@
 #define LINALG_VEC4_HPP
 
 #include <cmath>
-#include <immintrin.h>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
 
 #include "Alignment.hpp"
+#include "Instrument.hpp"
+#include "Pack.hpp"
 
 /**
  * @namespace lin
@@ -234,6 +235,8 @@ template <typename T> struct alignas(linalg::VecAlignment<T, 4>::VALUE) Vec4 {
    */
   Vec4 normalized() const noexcept {
     const T len = length();
+    LINALG_INSTRUMENT_COUNT(Normalize);
+    LINALG_INSTRUMENT_COUNT_IF(!(len > 0.0), NormalizeZeroLength);
     return len > 0.0 ? (*this / len) : Vec4(0.0);
   }
 
@@ -243,11 +246,52 @@ template <typename T> struct alignas(linalg::VecAlignment<T, 4>::VALUE) Vec4 {
    */
   void normalize() noexcept {
     const T len = length();
+    LINALG_INSTRUMENT_COUNT(Normalize);
+    LINALG_INSTRUMENT_COUNT_IF(!(len > 0.0), NormalizeZeroLength);
     if(len > 0.0) {
       *this /= len;
     }
   }
 
+  /**
+   * @brief Computes an approximation of the length of the vector, multiplying
+   * the squared length by simd::rsqrtFast() of it instead of calling std::sqrt.
+   * @return The length, within simd::RSQRT_FAST_MAX_ULP + 2 units in the last
+   * place for float.
+   */
+  T lengthFast() const noexcept {
+    const T len2 = squaredLength();
+    return simd::rsqrtFastInRange(len2) ? len2 * simd::rsqrtFast(len2) : length();
+  }
+
+  /**
+   * @brief Returns an approximately normalized version of the vector.
+   *
+   * Multiplies by simd::rsqrtFast() of the squared length instead of dividing by
+   * the length. For float each component is within simd::RSQRT_FAST_MAX_ULP + 2
+   * units in the last place of normalized(); for double the result only differs
+   * by the rounding of the reciprocal. Zero, subnormal and overflowing squared
+   * lengths go through normalized().
+   * @return A new Vec4 object that is the normalized version of this vector.
+   */
+  Vec4 normalizedFast() const noexcept {
+    const T len2 = squaredLength();
+    return simd::rsqrtFastInRange(len2) ? *this * simd::rsqrtFast(len2) : normalized();
+  }
+
+  /**
+   * @brief Normalizes the vector in place, approximately (see normalizedFast()).
+   * If the length is zero, the vector remains unchanged.
+   */
+  void normalizeFast() noexcept {
+    const T len2 = squaredLength();
+    if(simd::rsqrtFastInRange(len2)) {
+      *this *= simd::rsqrtFast(len2);
+    } else {
+      normalize();
+    }
+  }
+
   /**
    * @brief Computes the minimum value of the vector components.
    * @return The minimum value among the x, y, z, and w components.
@@ -6,11 +6,30 @@
 #define LINALG_LINALG_HPP
 
 #include <cmath>
-
+#include <cstddef>
+
+#include "Affine3.hpp"
+#include "Batch.hpp"
+#include "Bounds.hpp"
+#include "Camera.hpp"
+#include "ColMajor.hpp"
+#include "Generic.hpp"
+#include "Half.hpp"
+#include "Instrument.hpp"
 #include "Mat3.hpp"
 #include "Mat4.hpp"
+#include "Mat4Kernels.hpp"
+#include "Packed.hpp"
+#include "Quat.hpp"
+#include "Rebase.hpp"
+#include "SimdMath.hpp"
+#include "Skinning.hpp"
+#include "SoA.hpp"
+#include "Solve.hpp"
+#include "Transform.hpp"
 #include "Vec2.hpp"
 #include "Vec3.hpp"
+#include "Vec3Packet.hpp"
 #include "Vec4.hpp"
 
 /**
@@ -250,7 +269,9 @@ template <typename T> inline Vec3<T> reflect(const Vec3<T>& incident, const Vec3
 template <typename T> inline Vec3<T> refract(const Vec3<T>& incident, const Vec3<T>& normal, T eta) {
   const T cos_i  = -dot(normal, incident);
   const T sin2_t = eta * eta * (1.0 - cos_i * cos_i);
+  LINALG_INSTRUMENT_COUNT(Refract);
   if(sin2_t > 1.0) {
+    LINALG_INSTRUMENT_COUNT(RefractTotalInternalReflection);
     return reflect(incident, normal);
   }
   const T cos_t = std::sqrt(1.0 - sin2_t);
@@ -262,12 +283,14 @@ template <typename T> inline Vec3<T> refract(const Vec3<T>& incident, const Vec3
  * @param mat The Mat4 matrix to multiply with.
  * @param vec The Vec4 vector to multiply.
  * @return A Vec4 vector resulting from the multiplication.
+ * @note Uses the SIMD kernels of Mat4Kernels.hpp for float and double when
+ * the corresponding instruction sets are enabled.
  */
 template <typename T> inline Vec4<T> operator*(const Mat4<T>& mat, const Vec4<T>& vec) {
-  return {mat.m[0][0] * vec.x + mat.m[0][1] * vec.y + mat.m[0][2] * vec.z + mat.m[0][3] * vec.w,
-          mat.m[1][0] * vec.x + mat.m[1][1] * vec.y + mat.m[1][2] * vec.z + mat.m[1][3] * vec.w,
-          mat.m[2][0] * vec.x + mat.m[2][1] * vec.y + mat.m[2][2] * vec.z + mat.m[2][3] * vec.w,
-          mat.m[3][0] * vec.x + mat.m[3][1] * vec.y + mat.m[3][2] * vec.z + mat.m[3][3] * vec.w};
+  LINALG_INSTRUMENT_SCOPE(Mat4TransformVec4);
+  Vec4<T> result;
+  detail::Mat4Kernels<T>::transform(mat.data(), &vec.x, &result.x);
+  return result;
 }
 
 /**
@@ -278,7 +301,7 @@ template <typename T> inline Vec4<T> operator*(const Mat4<T>& mat, const Vec4<T>
  * @param z_angle The angle in radians to rotate around the z-axis.
  * @return A Mat3 representing the combined rotation.
  */
-template <typename T> inline Mat3<T> getRotationMatrix(T x_angle, T y_angle, T z_angle) {
+template <typename T> inline Mat3<T> getRotationMatrix(T x_angle, T y_angle, T z_angle) noexcept {
   const T sin_x = std::sin(x_angle);
   const T cos_x = std::cos(x_angle);
   const T sin_y = std::sin(y_angle);
@@ -286,11 +309,71 @@ template <typename T> inline Mat3<T> getRotationMatrix(T x_angle, T y_angle, T z
   const T sin_z = std::sin(z_angle);
   const T cos_z = std::cos(z_angle);
 
-  const Mat3<T> rx = Mat3<T>({{1, 0, 0}, {0, cos_x, -sin_x}, {0, sin_x, cos_x}});
-  const Mat3<T> ry = Mat3<T>({{cos_y, 0, sin_y}, {0, 1, 0}, {-sin_y, 0, cos_y}});
-  const Mat3<T> rz = Mat3<T>({{cos_z, -sin_z, 0}, {sin_z, cos_z, 0}, {0, 0, 1}});
+  // rz * ry * rx, expanded
+  return {cos_y * cos_z, sin_x * sin_y * cos_z - cos_x * sin_z, cos_x * sin_y * cos_z + sin_x * sin_z,
+          cos_y * sin_z, sin_x * sin_y * sin_z + cos_x * cos_z, cos_x * sin_y * sin_z - sin_x * cos_z,
+          -sin_y,        sin_x * cos_y,                         cos_x * cos_y};
+}
+
+namespace detail {
+inline namespace LINALG_SIMD_ABI {
+
+template <typename T> struct RotationMatrices {
+  const T* x;
+  const T* y;
+  const T* z;
+  Mat3<T>* out;
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    P sin_x;
+    P cos_x;
+    P sin_y;
+    P cos_y;
+    P sin_z;
+    P cos_z;
+    simd::sincos(P::load(x + i), sin_x, cos_x);
+    simd::sincos(P::load(y + i), sin_y, cos_y);
+    simd::sincos(P::load(z + i), sin_z, cos_z);
+
+    const P sin_x_sin_y = sin_x * sin_y;
+    const P cos_x_sin_y = cos_x * sin_y;
+    const P elements[9] = {cos_y * cos_z, sin_x_sin_y * cos_z - cos_x * sin_z, cos_x_sin_y * cos_z + sin_x * sin_z,
+                           cos_y * sin_z, sin_x_sin_y * sin_z + cos_x * cos_z, cos_x_sin_y * sin_z - sin_x * cos_z,
+                           -sin_y,        sin_x * cos_y,                       cos_x * cos_y};
+    T       lanes[9][P::WIDTH];
+    for(int e = 0; e < 9; ++e) {
+      elements[e].store(lanes[e]);
+    }
+    for(int lane = 0; lane < P::WIDTH; ++lane) {
+      Mat3<T>& m = out[i + lane];
+      for(int e = 0; e < 9; ++e) {
+        m.m[e / 3][e % 3] = lanes[e][lane];
+      }
+    }
+  }
+};
 
-  return rz * ry * rx;
+} // namespace LINALG_SIMD_ABI
+} // namespace detail
+
+/**
+ * @brief Computes the rotation matrices of getRotationMatrix() for arrays of
+ * angles, with the vectorized simd::sincos() in place of the scalar sine and
+ * cosine.
+ *
+ * The elements are written directly, without the rz * ry * rx product. They
+ * match getRotationMatrix() to a few ulp for angles up to 8192 radians (float)
+ * or 1e6 radians (double).
+ * @param x_angles The angles in radians around the x-axis.
+ * @param y_angles The angles in radians around the y-axis.
+ * @param z_angles The angles in radians around the z-axis.
+ * @param out The destination array, holding at least count matrices.
+ * @param count The number of matrices.
+ */
+template <typename T>
+inline void getRotationMatrices(const T* x_angles, const T* y_angles, const T* z_angles, Mat3<T>* out,
+                                std::size_t count) noexcept {
+  detail::forEachPack<T>(count, detail::RotationMatrices<T>{x_angles, y_angles, z_angles, out});
 }
 
 } // namespace linalg
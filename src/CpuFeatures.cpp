@@ -0,0 +1,146 @@
+/**
+ * @file CpuFeatures.cpp
+ * @brief Detection of the instruction sets supported by the host CPU and
+ * operating system.
+ *
+ * On x86 the features come from cpuid, and the AVX register states must also
+ * be enabled by the operating system in XCR0. On AArch64 Linux NEON is read
+ * from the auxiliary vector (HWCAP); other AArch64 platforms always have it.
+ */
+#include "DispatchTable.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define LINALG_DISPATCH_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define LINALG_DISPATCH_X86 0
+#endif
+
+#if(defined(__aarch64__) || defined(_M_ARM64)) && defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace linalg {
+namespace dispatch {
+namespace detail {
+namespace {
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+#if LINALG_DISPATCH_X86
+struct CpuidRegisters {
+  unsigned eax;
+  unsigned ebx;
+  unsigned ecx;
+  unsigned edx;
+};
+
+CpuidRegisters cpuid(unsigned leaf, unsigned subleaf) noexcept {
+#if defined(_MSC_VER)
+  int r[4];
+  __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+  return {static_cast<unsigned>(r[0]), static_cast<unsigned>(r[1]), static_cast<unsigned>(r[2]),
+          static_cast<unsigned>(r[3])};
+#else
+  CpuidRegisters r{};
+  __cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+  return r;
+#endif
+}
+
+/**
+ * @brief Reads XCR0, the register states enabled by the operating system.
+ * Only valid when cpuid reports OSXSAVE.
+ */
+unsigned long long xcr0() noexcept {
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  unsigned eax = 0;
+  unsigned edx = 0;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+struct X86Features {
+  bool sse2;
+  bool avx2_fma;
+  bool avx512f;
+};
+
+X86Features detectX86() noexcept {
+  X86Features features{};
+  const unsigned max_leaf = cpuid(0, 0).eax;
+  if(max_leaf < 1) {
+    return features;
+  }
+  const CpuidRegisters leaf1 = cpuid(1, 0);
+  features.sse2              = (leaf1.edx & (1U << 26)) != 0;
+
+  const bool fma     = (leaf1.ecx & (1U << 12)) != 0;
+  const bool osxsave = (leaf1.ecx & (1U << 27)) != 0;
+  const bool avx     = (leaf1.ecx & (1U << 28)) != 0;
+  if(!osxsave || !avx || max_leaf < 7) {
+    return features;
+  }
+  // XMM and YMM state, then opmask and the upper ZMM states for AVX-512.
+  const unsigned long long xcr     = xcr0();
+  const bool               ymm_os  = (xcr & 0x6U) == 0x6U;
+  const bool               zmm_os  = ymm_os && (xcr & 0xE0U) == 0xE0U;
+  const CpuidRegisters     leaf7   = cpuid(7, 0);
+  const bool               avx2    = (leaf7.ebx & (1U << 5)) != 0;
+  const bool               avx512f = (leaf7.ebx & (1U << 16)) != 0;
+
+  features.avx2_fma = ymm_os && avx2 && fma;
+  features.avx512f  = features.avx2_fma && zmm_os && avx512f;
+  return features;
+}
+
+const X86Features& x86Features() noexcept {
+  static const X86Features features = detectX86();
+  return features;
+}
+#endif
+
+bool neonSupported() noexcept {
+#if(defined(__aarch64__) || defined(_M_ARM64)) && defined(__linux__)
+  return (getauxval(AT_HWCAP) & HWCAP_ASIMD) != 0;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+  return true;
+#else
+  return false;
+#endif
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+} // namespace
+
+bool cpuSupports(Isa isa) noexcept {
+  switch(isa) {
+  case Isa::Scalar:
+    return true;
+#if LINALG_DISPATCH_X86
+  case Isa::SSE2:
+    return x86Features().sse2;
+  case Isa::AVX2:
+    return x86Features().avx2_fma;
+  case Isa::AVX512:
+    return x86Features().avx512f;
+#endif
+  case Isa::NEON:
+    return neonSupported();
+  default:
+    return false;
+  }
+}
+
+} // namespace detail
+} // namespace dispatch
+} // namespace linalg
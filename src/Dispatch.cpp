@@ -0,0 +1,162 @@
+/**
+ * @file Dispatch.cpp
+ * @brief Selection of the kernel table and the public entry points of the
+ * linalg_dispatch library.
+ */
+#include "linalg/Dispatch.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+#include "DispatchTable.hpp"
+
+namespace linalg {
+namespace dispatch {
+namespace detail {
+namespace {
+
+/**
+ * @brief Returns the kernels of an instruction set, or nullptr if they are not
+ * built into the library.
+ */
+const Kernels* builtKernels(Isa isa) noexcept {
+  switch(isa) {
+  case Isa::Scalar:
+    return &scalarKernels();
+#if LINALG_DISPATCH_HAS_SSE2
+  case Isa::SSE2:
+    return &sse2Kernels();
+#endif
+#if LINALG_DISPATCH_HAS_AVX2
+  case Isa::AVX2:
+    return &avx2Kernels();
+#endif
+#if LINALG_DISPATCH_HAS_AVX512
+  case Isa::AVX512:
+    return &avx512Kernels();
+#endif
+#if LINALG_DISPATCH_HAS_NEON
+  case Isa::NEON:
+    return &neonKernels();
+#endif
+  default:
+    return nullptr;
+  }
+}
+
+/**
+ * @brief The kernels in use, initialized with the best supported instruction
+ * set on first use.
+ */
+std::atomic<const Kernels*>& activeKernels() noexcept {
+  static std::atomic<const Kernels*> active(builtKernels(bestIsa()));
+  return active;
+}
+
+template <typename T> const KernelTable<T>& table() noexcept;
+
+template <> const KernelTable<float>& table<float>() noexcept {
+  return activeKernels().load(std::memory_order_acquire)->f32;
+}
+
+template <> const KernelTable<double>& table<double>() noexcept {
+  return activeKernels().load(std::memory_order_acquire)->f64;
+}
+
+} // namespace
+} // namespace detail
+
+const char* isaName(Isa isa) noexcept {
+  switch(isa) {
+  case Isa::Scalar:
+    return "scalar";
+  case Isa::SSE2:
+    return "sse2";
+  case Isa::AVX2:
+    return "avx2";
+  case Isa::AVX512:
+    return "avx512";
+  case Isa::NEON:
+    return "neon";
+  default:
+    return "unknown";
+  }
+}
+
+bool isSupported(Isa isa) noexcept { return detail::builtKernels(isa) != nullptr && detail::cpuSupports(isa); }
+
+Isa bestIsa() noexcept {
+  static const Isa best = [] {
+    for(const Isa isa : {Isa::AVX512, Isa::AVX2, Isa::SSE2, Isa::NEON}) {
+      if(isSupported(isa)) {
+        return isa;
+      }
+    }
+    return Isa::Scalar;
+  }();
+  return best;
+}
+
+Isa activeIsa() noexcept { return detail::activeKernels().load(std::memory_order_acquire)->isa; }
+
+void setActiveIsa(Isa isa) {
+  if(!isSupported(isa)) {
+    throw std::invalid_argument(std::string("Instruction set not supported: ") + isaName(isa));
+  }
+  detail::activeKernels().store(detail::builtKernels(isa), std::memory_order_release);
+}
+
+template <typename T>
+void transformPoints(const Mat4<T>& mat, const Vec3<T>* in, Vec3<T>* out, std::size_t count) noexcept {
+  static_assert(sizeof(Vec3<T>) == 4 * sizeof(T), "Vec3 is expected to be padded to four elements");
+  detail::table<T>().transformPoints(mat.data(), reinterpret_cast<const T*>(in), reinterpret_cast<T*>(out), count);
+}
+
+template <typename T>
+void transformDirections(const Mat4<T>& mat, const Vec3<T>* in, Vec3<T>* out, std::size_t count) noexcept {
+  static_assert(sizeof(Vec3<T>) == 4 * sizeof(T), "Vec3 is expected to be padded to four elements");
+  detail::table<T>().transformDirections(mat.data(), reinterpret_cast<const T*>(in), reinterpret_cast<T*>(out),
+                                         count);
+}
+
+template <typename T>
+void transformVectors(const Mat4<T>& mat, const Vec4<T>* in, Vec4<T>* out, std::size_t count) noexcept {
+  static_assert(sizeof(Vec4<T>) == 4 * sizeof(T), "Vec4 is expected to hold exactly four elements");
+  detail::table<T>().transformVectors(mat.data(), reinterpret_cast<const T*>(in), reinterpret_cast<T*>(out), count);
+}
+
+template <typename T> void normalized(const Vec3<T>* in, Vec3<T>* out, std::size_t count) noexcept {
+  detail::table<T>().normalized(reinterpret_cast<const T*>(in), reinterpret_cast<T*>(out), count);
+}
+
+template <typename T> void dot(const Vec3<T>* a, const Vec3<T>* b, T* out, std::size_t count) noexcept {
+  detail::table<T>().dot(reinterpret_cast<const T*>(a), reinterpret_cast<const T*>(b), out, count);
+}
+
+template <typename T> void minMax(const Vec3<T>* in, std::size_t count, Vec3<T>& min, Vec3<T>& max) {
+  if(count == 0) {
+    throw std::invalid_argument("minMax requires at least one vector.");
+  }
+  T lo[3];
+  T hi[3];
+  detail::table<T>().minMax(reinterpret_cast<const T*>(in), count, lo, hi);
+  min = Vec3<T>(lo[0], lo[1], lo[2]);
+  max = Vec3<T>(hi[0], hi[1], hi[2]);
+}
+
+#define LINALG_DISPATCH_INSTANTIATE(T)                                                                                 \
+  template void transformPoints<T>(const Mat4<T>&, const Vec3<T>*, Vec3<T>*, std::size_t) noexcept;                    \
+  template void transformDirections<T>(const Mat4<T>&, const Vec3<T>*, Vec3<T>*, std::size_t) noexcept;                \
+  template void transformVectors<T>(const Mat4<T>&, const Vec4<T>*, Vec4<T>*, std::size_t) noexcept;                   \
+  template void normalized<T>(const Vec3<T>*, Vec3<T>*, std::size_t) noexcept;                                         \
+  template void dot<T>(const Vec3<T>*, const Vec3<T>*, T*, std::size_t) noexcept;                                      \
+  template void minMax<T>(const Vec3<T>*, std::size_t, Vec3<T>&, Vec3<T>&);
+
+LINALG_DISPATCH_INSTANTIATE(float)
+LINALG_DISPATCH_INSTANTIATE(double)
+
+#undef LINALG_DISPATCH_INSTANTIATE
+
+} // namespace dispatch
+} // namespace linalg
@@ -0,0 +1,22 @@
+/**
+ * @file DispatchAvx2.cpp
+ * @brief AVX2 kernels, built with AVX2 and FMA enabled.
+ */
+#include "DispatchKernels.hpp"
+
+#if !(LINALG_HAS_AVX2 && LINALG_HAS_FMA && !LINALG_HAS_AVX512F)
+#error "DispatchAvx2.cpp must be compiled with AVX2 and FMA and without AVX-512"
+#endif
+
+namespace linalg {
+namespace dispatch {
+namespace detail {
+
+const Kernels& avx2Kernels() noexcept {
+  static const Kernels kernels = makeKernels(Isa::AVX2);
+  return kernels;
+}
+
+} // namespace detail
+} // namespace dispatch
+} // namespace linalg
@@ -0,0 +1,22 @@
+/**
+ * @file DispatchAvx512.cpp
+ * @brief AVX-512 kernels, built with AVX-512F, AVX2 and FMA enabled.
+ */
+#include "DispatchKernels.hpp"
+
+#if !(LINALG_HAS_AVX512F)
+#error "DispatchAvx512.cpp must be compiled with AVX-512F, AVX2 and FMA"
+#endif
+
+namespace linalg {
+namespace dispatch {
+namespace detail {
+
+const Kernels& avx512Kernels() noexcept {
+  static const Kernels kernels = makeKernels(Isa::AVX512);
+  return kernels;
+}
+
+} // namespace detail
+} // namespace dispatch
+} // namespace linalg
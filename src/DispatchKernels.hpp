@@ -0,0 +1,265 @@
+/**
+ * @file DispatchKernels.hpp
+ * @brief Kernel implementations shared by the per-instruction-set translation
+ * units of the linalg_dispatch library.
+ *
+ * Each unit includes this file once, compiled with its own instruction set
+ * flags, and builds its table with makeKernels(). Everything defined here has
+ * internal linkage and the simd and detail code it relies on lives in the
+ * LINALG_SIMD_ABI namespace, so the copies built for different instruction
+ * sets are never merged at link time. The vector and matrix classes must not
+ * be used here for the same reason.
+ */
+#ifndef LINALG_SRC_DISPATCH_KERNELS_HPP
+#define LINALG_SRC_DISPATCH_KERNELS_HPP
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "DispatchTable.hpp"
+#include "linalg/Mat4Kernels.hpp"
+#include "linalg/Pack.hpp"
+
+namespace linalg {
+namespace dispatch {
+namespace detail {
+namespace {
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+using linalg::detail::HomogeneousW;
+
+template <typename T, HomogeneousW W>
+void transformArray(const T* m, const T* in, T* out, std::size_t count) noexcept {
+  linalg::detail::Mat4Kernels<T>::template transformArray<W>(m, in, out, count);
+}
+
+/**
+ * @brief The x, y and z components of P::WIDTH consecutive 4-element records,
+ * one pack per component.
+ *
+ * Packs of four or more lanes are filled with transpose4() from four whole
+ * record loads, which leaves the records interleaved: lane 4 * g + k holds
+ * record k * P::WIDTH / 4 + g. Element-wise kernels undo this by transposing
+ * back and the others through storeLanes(). Narrower packs are gathered one
+ * record at a time.
+ */
+template <typename P> struct Components {
+  P x;
+  P y;
+  P z;
+};
+
+template <typename P> using Transposed = std::integral_constant<bool, P::WIDTH % 4 == 0>;
+
+template <typename P, typename T> Components<P> gather(const T* in, std::true_type /*transposed*/) noexcept {
+  P x = P::load(in);
+  P y = P::load(in + P::WIDTH);
+  P z = P::load(in + 2 * P::WIDTH);
+  P w = P::load(in + 3 * P::WIDTH);
+  simd::transpose4(x, y, z, w);
+  return {x, y, z};
+}
+
+template <typename P, typename T> Components<P> gather(const T* in, std::false_type /*transposed*/) noexcept {
+  T x[P::WIDTH];
+  T y[P::WIDTH];
+  T z[P::WIDTH];
+  for(int i = 0; i < P::WIDTH; ++i, in += 4) {
+    x[i] = in[0];
+    y[i] = in[1];
+    z[i] = in[2];
+  }
+  return {P::load(x), P::load(y), P::load(z)};
+}
+
+template <typename P, typename T> Components<P> gather(const T* in) noexcept { return gather<P>(in, Transposed<P>()); }
+
+/**
+ * @brief Stores the records of c back, with a zero padding lane for packs
+ * filled by transpose4().
+ */
+template <typename P, typename T> void scatter(Components<P> c, T* out, std::true_type /*transposed*/) noexcept {
+  P w = P::broadcast(T(0));
+  simd::transpose4(c.x, c.y, c.z, w);
+  c.x.store(out);
+  c.y.store(out + P::WIDTH);
+  c.z.store(out + 2 * P::WIDTH);
+  w.store(out + 3 * P::WIDTH);
+}
+
+template <typename P, typename T>
+void scatter(const Components<P>& c, T* out, std::false_type /*transposed*/) noexcept {
+  T x[P::WIDTH];
+  T y[P::WIDTH];
+  T z[P::WIDTH];
+  c.x.store(x);
+  c.y.store(y);
+  c.z.store(z);
+  for(int i = 0; i < P::WIDTH; ++i, out += 4) {
+    out[0] = x[i];
+    out[1] = y[i];
+    out[2] = z[i];
+  }
+}
+
+template <typename P, typename T> void scatter(const Components<P>& c, T* out) noexcept {
+  scatter<P>(c, out, Transposed<P>());
+}
+
+/**
+ * @brief Stores one value per record of a pack computed from Components, in
+ * record order.
+ */
+template <typename P, typename T> void storeLanes(const P& p, T* out, std::true_type /*transposed*/) noexcept {
+  constexpr int RECORDS = P::WIDTH / 4;
+  if(RECORDS == 1) {
+    p.store(out);
+    return;
+  }
+  T lanes[P::WIDTH];
+  p.store(lanes);
+  for(int g = 0; g < RECORDS; ++g) {
+    for(int k = 0; k < 4; ++k) {
+      out[k * RECORDS + g] = lanes[4 * g + k];
+    }
+  }
+}
+
+template <typename P, typename T> void storeLanes(const P& p, T* out, std::false_type /*transposed*/) noexcept {
+  p.store(out);
+}
+
+template <typename P, typename T> void storeLanes(const P& p, T* out) noexcept {
+  storeLanes<P>(p, out, Transposed<P>());
+}
+
+/**
+ * @brief Applies kernel to the records [0, count), NativePack<T>::WIDTH
+ * records at a time and one at a time for the tail.
+ */
+template <typename T, typename Kernel> void forEachBlock(std::size_t count, const Kernel& kernel) noexcept {
+  using P       = simd::NativePack<T>;
+  std::size_t i = 0;
+  for(; i + P::WIDTH <= count; i += P::WIDTH) {
+    kernel.template apply<P>(i);
+  }
+  for(; i < count; ++i) {
+    kernel.template apply<simd::Pack<T, 1>>(i);
+  }
+}
+
+template <typename T> struct NormalizeKernel {
+  const T* in;
+  T*       out;
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    const Components<P> v    = gather<P>(in + 4 * i);
+    const P             zero = P::broadcast(T(0));
+    const P             len  = simd::sqrt(simd::madd(v.x, v.x, simd::madd(v.y, v.y, v.z * v.z)));
+    const P             inv  = P::broadcast(T(1)) / len;
+    const auto          keep = len > zero;
+    scatter<P>({simd::select(keep, v.x * inv, zero), simd::select(keep, v.y * inv, zero),
+                simd::select(keep, v.z * inv, zero)},
+               out + 4 * i);
+  }
+};
+
+template <typename T> void normalized(const T* in, T* out, std::size_t count) noexcept {
+  forEachBlock<T>(count, NormalizeKernel<T>{in, out});
+}
+
+template <typename T> struct DotKernel {
+  const T* a;
+  const T* b;
+  T*       out;
+
+  template <typename P> void apply(std::size_t i) const noexcept {
+    const Components<P> va = gather<P>(a + 4 * i);
+    const Components<P> vb = gather<P>(b + 4 * i);
+    storeLanes<P>(simd::madd(va.x, vb.x, simd::madd(va.y, vb.y, va.z * vb.z)), out + i);
+  }
+};
+
+template <typename T> void dot(const T* a, const T* b, T* out, std::size_t count) noexcept {
+  forEachBlock<T>(count, DotKernel<T>{a, b, out});
+}
+
+/**
+ * @brief Reduces whole records, several per pack: the padding lane of each
+ * record is reduced along and discarded at the end. The accumulators start at
+ * +/-infinity and take the new value as first operand so NaN lanes are
+ * skipped.
+ */
+template <typename T> void minMax(const T* in, std::size_t count, T* min, T* max) noexcept {
+  constexpr int WIDTH   = simd::NativeWidth<T>::VALUE < 4 ? 4 : simd::NativeWidth<T>::VALUE;
+  constexpr int RECORDS = WIDTH / 4;
+  using P               = simd::Pack<T, WIDTH>;
+
+  const T inf = std::numeric_limits<T>::infinity();
+  P       lo0 = P::broadcast(inf);
+  P       hi0 = P::broadcast(-inf);
+  P       lo1 = lo0;
+  P       hi1 = hi0;
+
+  std::size_t i = 0;
+  for(; i + 2 * RECORDS <= count; i += 2 * RECORDS) {
+    const P p0 = P::load(in + 4 * i);
+    const P p1 = P::load(in + 4 * i + WIDTH);
+    lo0        = simd::min(p0, lo0);
+    hi0        = simd::max(p0, hi0);
+    lo1        = simd::min(p1, lo1);
+    hi1        = simd::max(p1, hi1);
+  }
+  for(; i + RECORDS <= count; i += RECORDS) {
+    const P p = P::load(in + 4 * i);
+    lo0       = simd::min(p, lo0);
+    hi0       = simd::max(p, hi0);
+  }
+
+  T lows[WIDTH];
+  T highs[WIDTH];
+  simd::min(lo1, lo0).store(lows);
+  simd::max(hi1, hi0).store(highs);
+  for(int c = 0; c < 3; ++c) {
+    min[c] = inf;
+    max[c] = -inf;
+    for(int r = 0; r < RECORDS; ++r) {
+      min[c] = lows[4 * r + c] < min[c] ? lows[4 * r + c] : min[c];
+      max[c] = highs[4 * r + c] > max[c] ? highs[4 * r + c] : max[c];
+    }
+  }
+  for(; i < count; ++i) {
+    for(int c = 0; c < 3; ++c) {
+      const T value = in[4 * i + c];
+      min[c]        = value < min[c] ? value : min[c];
+      max[c]        = value > max[c] ? value : max[c];
+    }
+  }
+}
+
+template <typename T> KernelTable<T> makeTable() noexcept {
+  return {&transformArray<T, HomogeneousW::One>,
+          &transformArray<T, HomogeneousW::Zero>,
+          &transformArray<T, HomogeneousW::Input>,
+          &normalized<T>,
+          &dot<T>,
+          &minMax<T>};
+}
+
+/**
+ * @brief Returns the table of the kernels compiled in the including
+ * translation unit.
+ * @param isa The instruction set the unit is compiled for.
+ */
+Kernels makeKernels(Isa isa) noexcept { return {isa, makeTable<float>(), makeTable<double>()}; }
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+} // namespace
+} // namespace detail
+} // namespace dispatch
+} // namespace linalg
+
+#endif // LINALG_SRC_DISPATCH_KERNELS_HPP
@@ -0,0 +1,22 @@
+/**
+ * @file DispatchNeon.cpp
+ * @brief NEON kernels for AArch64, where NEON is part of the base instruction set.
+ */
+#include "DispatchKernels.hpp"
+
+#if !(LINALG_HAS_NEON)
+#error "DispatchNeon.cpp must be compiled for AArch64 with NEON"
+#endif
+
+namespace linalg {
+namespace dispatch {
+namespace detail {
+
+const Kernels& neonKernels() noexcept {
+  static const Kernels kernels = makeKernels(Isa::NEON);
+  return kernels;
+}
+
+} // namespace detail
+} // namespace dispatch
+} // namespace linalg
@@ -0,0 +1,21 @@
+/**
+ * @file DispatchScalar.cpp
+ * @brief Portable kernels, built with the SIMD code paths of the headers
+ * disabled.
+ */
+#define LINALG_DISABLE_SIMD
+
+#include "DispatchKernels.hpp"
+
+namespace linalg {
+namespace dispatch {
+namespace detail {
+
+const Kernels& scalarKernels() noexcept {
+  static const Kernels kernels = makeKernels(Isa::Scalar);
+  return kernels;
+}
+
+} // namespace detail
+} // namespace dispatch
+} // namespace linalg
@@ -0,0 +1,22 @@
+/**
+ * @file DispatchSse2.cpp
+ * @brief SSE2 kernels, built for the x86 baseline without AVX.
+ */
+#include "DispatchKernels.hpp"
+
+#if !(LINALG_HAS_SSE2 && !LINALG_HAS_AVX)
+#error "DispatchSse2.cpp must be compiled with SSE2 and without AVX"
+#endif
+
+namespace linalg {
+namespace dispatch {
+namespace detail {
+
+const Kernels& sse2Kernels() noexcept {
+  static const Kernels kernels = makeKernels(Isa::SSE2);
+  return kernels;
+}
+
+} // namespace detail
+} // namespace dispatch
+} // namespace linalg
@@ -0,0 +1,60 @@
+/**
+ * @file DispatchTable.hpp
+ * @brief Function tables filled by the per-instruction-set kernel translation
+ * units of the linalg_dispatch library.
+ */
+#ifndef LINALG_SRC_DISPATCH_TABLE_HPP
+#define LINALG_SRC_DISPATCH_TABLE_HPP
+
+#include <cstddef>
+
+#include "linalg/Dispatch.hpp"
+
+namespace linalg {
+namespace dispatch {
+namespace detail {
+
+/**
+ * @brief Kernels for one element type. Vec3 and Vec4 arrays are passed as
+ * records of four elements, matrices as 16 row-major elements.
+ * @tparam T The type of the elements.
+ */
+template <typename T> struct KernelTable {
+  void (*transformPoints)(const T* m, const T* in, T* out, std::size_t count) noexcept;
+  void (*transformDirections)(const T* m, const T* in, T* out, std::size_t count) noexcept;
+  void (*transformVectors)(const T* m, const T* in, T* out, std::size_t count) noexcept;
+  void (*normalized)(const T* in, T* out, std::size_t count) noexcept;
+  void (*dot)(const T* a, const T* b, T* out, std::size_t count) noexcept;
+  void (*minMax)(const T* in, std::size_t count, T* min, T* max) noexcept;
+};
+
+/**
+ * @brief The kernels of one instruction set.
+ */
+struct Kernels {
+  Isa                 isa;
+  KernelTable<float>  f32;
+  KernelTable<double> f64;
+};
+
+/**
+ * @brief Kernel tables of each instruction set. Only the functions of the
+ * instruction sets enabled in the build (LINALG_DISPATCH_HAS_*) are defined.
+ */
+const Kernels& scalarKernels() noexcept;
+const Kernels& sse2Kernels() noexcept;
+const Kernels& avx2Kernels() noexcept;
+const Kernels& avx512Kernels() noexcept;
+const Kernels& neonKernels() noexcept;
+
+/**
+ * @brief Checks if the host CPU and operating system support an instruction
+ * set, regardless of the kernels built into the library.
+ */
+bool cpuSupports(Isa isa) noexcept;
+
+} // namespace detail
+} // namespace dispatch
+} // namespace linalg
+
+#endif // LINALG_SRC_DISPATCH_TABLE_HPP
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> Affine3<T> makeAffine(T seed) {
+  return {1 + seed, 2, -1, 3 * seed, 0.5, -2, seed, 1, -1, 0.25, 2 - seed, -4};
+}
+
+} // namespace
+
+template <typename T> class Affine3Test : public ::testing::Test {};
+
+using Affine3Types = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(Affine3Test, Affine3Types);
+
+TYPED_TEST(Affine3Test, LayoutAndConversions) {
+  using T = TypeParam;
+  EXPECT_EQ(sizeof(Affine3<T>), 12 * sizeof(T));
+  EXPECT_EQ(Affine3<T>().toMat4(), Mat4<T>::Identity());
+
+  const Affine3<T> a = makeAffine<T>(1);
+  const Mat4<T>    m = a.toMat4();
+  EXPECT_EQ(Affine3<T>(m), a);
+  EXPECT_EQ(m.m[3][0], T(0));
+  EXPECT_EQ(m.m[3][3], T(1));
+  EXPECT_EQ(Affine3<T>(a.linear(), a.translation()), a);
+  EXPECT_EQ(a(1, 3), T(1));
+}
+
+TYPED_TEST(Affine3Test, MultiplyMatchesMat4) {
+  using T            = TypeParam;
+  const Affine3<T> a = makeAffine<T>(1);
+  const Affine3<T> b = makeAffine<T>(-2);
+  EXPECT_TRUE((a * b).toMat4().isApprox(a.toMat4() * b.toMat4(), T(1e-5)));
+
+  Affine3<T> c = a;
+  c *= b;
+  EXPECT_EQ(c, a * b);
+
+  const Mat4<T> projection = Mat4<T>::Perspective(T(1.2), T(1.5), T(0.1), T(100));
+  EXPECT_TRUE((projection * b).isApprox(projection * b.toMat4(), T(1e-5)));
+}
+
+TYPED_TEST(Affine3Test, TransformsPointsAndDirections) {
+  using T            = TypeParam;
+  const Affine3<T> a = makeAffine<T>(1);
+  const Vec3<T>    p(0.5, -1, 2);
+  const Vec4<T>    point = a.toMat4() * Vec4<T>(p.x, p.y, p.z, 1);
+  const Vec4<T>    dir   = a.toMat4() * Vec4<T>(p.x, p.y, p.z, 0);
+  EXPECT_TRUE(a.transformPoint(p).isApprox(toVec3(point), T(1e-5)));
+  EXPECT_TRUE(a.transformDirection(p).isApprox(toVec3(dir), T(1e-5)));
+}
+
+TYPED_TEST(Affine3Test, Inverse) {
+  using T            = TypeParam;
+  const Affine3<T> a = makeAffine<T>(1);
+  EXPECT_TRUE(a.inverse().toMat4().isApprox(a.toMat4().inverse(), T(1e-5)));
+  EXPECT_TRUE((a * a.inverse()).isApprox(Affine3<T>::Identity(), T(1e-5)));
+
+  const Affine3<T> view = Affine3<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(0, 0, 0), Vec3<T>(0, 1, 0));
+  EXPECT_EQ(view.toMat4(), Mat4<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(0, 0, 0), Vec3<T>(0, 1, 0)));
+  EXPECT_TRUE(view.inverseRigid().isApprox(view.inverse(), T(1e-5)));
+
+  const Affine3<T> singular(1, 2, 3, 4, 2, 4, 6, 8, 0, 0, 1, 0);
+  EXPECT_EQ(singular.inverse(), Affine3<T>::Identity());
+}
+
+TYPED_TEST(Affine3Test, OrthographicMatchesMat4) {
+  using T = TypeParam;
+  EXPECT_EQ(Affine3<T>::Orthographic(-2, 2, -1, 1, T(0.1), 10).toMat4(),
+            Mat4<T>::Orthographic(-2, 2, -1, 1, T(0.1), 10));
+}
+
+TYPED_TEST(Affine3Test, PerspectiveProjectionMatchesMat4) {
+  using T                                = TypeParam;
+  const PerspectiveProjection<T> proj(T(1.2), T(1.5), T(0.1), T(100));
+  const Mat4<T>                  full    = Mat4<T>::Perspective(T(1.2), T(1.5), T(0.1), T(100));
+  const T                        epsilon = T(1e-5);
+  EXPECT_TRUE(proj.toMat4().isApprox(full, epsilon));
+
+  const Affine3<T> view = Affine3<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(0, 0, 0), Vec3<T>(0, 1, 0));
+  EXPECT_TRUE((proj * view).isApprox(full * view.toMat4(), epsilon));
+
+  Mat4<T> mat;
+  for(int i = 0; i < 16; ++i) {
+    mat[i] = static_cast<T>(i) - 7;
+  }
+  EXPECT_TRUE((proj * mat).isApprox(full * mat, T(1e-4)));
+
+  const Vec4<T> v(1, -2, 3, 1);
+  EXPECT_TRUE((proj * v).isApprox(full * v, epsilon));
+  EXPECT_EQ(PerspectiveProjection<T>().toMat4(), Mat4<T>(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, -1, 0, 0, 0, -1, 0));
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> Mat4<T> makeTransform() {
+  return Mat4<T>({{2, -1, 0.5, 3}, {0.25, 1, -2, -1}, {1, 0, 3, 2}, {0.5, 0.25, 0, 1}});
+}
+
+template <typename T> std::vector<Vec3<T>> makePoints(std::size_t count) {
+  std::vector<Vec3<T>> points;
+  for(std::size_t i = 0; i < count; ++i) {
+    const T t = static_cast<T>(i);
+    points.emplace_back(t, -2 * t + 1, t * t / 4);
+  }
+  return points;
+}
+
+} // namespace
+
+template <typename T> class BatchTest : public ::testing::Test {};
+
+using BatchTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(BatchTest, BatchTypes);
+
+TYPED_TEST(BatchTest, TransformPointsMatchesMat4Vec4Product) {
+  using T               = TypeParam;
+  const Mat4<T> mat     = makeTransform<T>();
+  const T       epsilon = static_cast<T>(1e-4);
+
+  for(std::size_t count = 0; count < 10; ++count) {
+    const std::vector<Vec3<T>> in = makePoints<T>(count);
+    std::vector<Vec3<T>>       out(count);
+    transformPoints(mat, in.data(), out.data(), count);
+
+    for(std::size_t i = 0; i < count; ++i) {
+      EXPECT_TRUE(out[i].isApprox(toVec3(mat * toVec4(in[i])), epsilon)) << "count " << count << ", index " << i;
+    }
+  }
+}
+
+TYPED_TEST(BatchTest, TransformDirectionsIgnoresTranslation) {
+  using T                        = TypeParam;
+  const Mat4<T>              mat = makeTransform<T>();
+  const std::vector<Vec3<T>> in  = makePoints<T>(7);
+  std::vector<Vec3<T>>       out(in.size());
+  transformDirections(mat, in.data(), out.data(), in.size());
+
+  for(std::size_t i = 0; i < in.size(); ++i) {
+    const Vec4<T> expected = mat * Vec4<T>(in[i].x, in[i].y, in[i].z, 0);
+    EXPECT_TRUE(out[i].isApprox(toVec3(expected), static_cast<T>(1e-4)));
+  }
+}
+
+TYPED_TEST(BatchTest, TransformVectorsMatchesMat4Vec4Product) {
+  using T           = TypeParam;
+  const Mat4<T> mat = makeTransform<T>();
+  std::vector<Vec4<T>> in;
+  for(int i = 0; i < 7; ++i) {
+    in.emplace_back(static_cast<T>(i), static_cast<T>(1 - i), static_cast<T>(2 * i), static_cast<T>(i % 3));
+  }
+  std::vector<Vec4<T>> out(in.size());
+  transformVectors(mat, in.data(), out.data(), in.size());
+
+  for(std::size_t i = 0; i < in.size(); ++i) {
+    EXPECT_TRUE(out[i].isApprox(mat * in[i], static_cast<T>(1e-4)));
+  }
+}
+
+TYPED_TEST(BatchTest, TransformPointsInPlace) {
+  using T                             = TypeParam;
+  const Mat4<T>              mat      = makeTransform<T>();
+  const std::vector<Vec3<T>> original = makePoints<T>(9);
+  std::vector<Vec3<T>>       points   = original;
+  transformPoints(mat, points.data(), points.data(), points.size());
+
+  for(std::size_t i = 0; i < points.size(); ++i) {
+    EXPECT_TRUE(points[i].isApprox(toVec3(mat * toVec4(original[i])), static_cast<T>(1e-4)));
+  }
+}
@@ -0,0 +1,212 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> Mat4<T> makeViewProjection() {
+  return Mat4<T>::Perspective(T(1.2), T(1.5), T(0.5), T(50)) * Mat4<T>::LookAt(Vec3<T>(0, 0, 5), Vec3<T>(0, 0, 0));
+}
+
+// Boxes on a grid around the camera of makeViewProjection(), with varying sizes.
+template <typename T> std::vector<AABB<T>> makeBoxes() {
+  std::vector<AABB<T>> boxes;
+  for(int i = -6; i <= 6; ++i) {
+    for(int j = -6; j <= 6; ++j) {
+      for(int k = -12; k <= 12; k += 3) {
+        const Vec3<T> center(T(i) * 3, T(j) * 2, T(k) * 5);
+        const T       size = T(0.25) + T((i + j + k) & 3) * T(0.5);
+        boxes.push_back(AABB<T>::FromCenterExtent(center, Vec3<T>(size, size * 2, size)));
+      }
+    }
+  }
+  return boxes;
+}
+
+template <typename T> Vec3<T> inverse(const Vec3<T>& d) { return {T(1) / d.x, T(1) / d.y, T(1) / d.z}; }
+
+} // namespace
+
+template <typename T> class BoundsTest : public ::testing::Test {};
+
+using BoundsTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(BoundsTest, BoundsTypes);
+
+TYPED_TEST(BoundsTest, AABBAccumulation) {
+  using T = TypeParam;
+  AABB<T> box;
+  EXPECT_TRUE(box.isEmpty());
+  box.expand(Vec3<T>(1, -2, 3));
+  EXPECT_FALSE(box.isEmpty());
+  EXPECT_EQ(box.extent(), Vec3<T>(0, 0, 0));
+  box.expand(Vec3<T>(-1, 4, 3));
+  EXPECT_EQ(box.min, Vec3<T>(-1, -2, 3));
+  EXPECT_EQ(box.max, Vec3<T>(1, 4, 3));
+  EXPECT_EQ(box.center(), Vec3<T>(0, 1, 3));
+  EXPECT_EQ(box.extent(), Vec3<T>(2, 6, 0));
+  EXPECT_EQ(box.halfExtent(), Vec3<T>(1, 3, 0));
+
+  const Vec3<T> points[] = {Vec3<T>(1, -2, 3), Vec3<T>(-1, 4, 3)};
+  const AABB<T> from     = AABB<T>::FromPoints(points, 2);
+  EXPECT_EQ(from.min, box.min);
+  EXPECT_EQ(from.max, box.max);
+  EXPECT_TRUE(AABB<T>::FromPoints(points, 0).isEmpty());
+
+  const AABB<T> merged = box.merged(AABB<T>(Vec3<T>(0, 0, -1), Vec3<T>(5, 1, 0)));
+  EXPECT_EQ(merged.min, Vec3<T>(-1, -2, -1));
+  EXPECT_EQ(merged.max, Vec3<T>(5, 4, 3));
+  EXPECT_EQ(box.merged(AABB<T>()).max, box.max);
+
+  EXPECT_TRUE(merged.contains(Vec3<T>(5, 4, 3)));
+  EXPECT_FALSE(merged.contains(Vec3<T>(5, 4, 3.5)));
+  EXPECT_TRUE(merged.overlaps(AABB<T>(Vec3<T>(5, 4, 3), Vec3<T>(6, 6, 6))));
+  EXPECT_FALSE(merged.overlaps(AABB<T>(Vec3<T>(5.5, 0, 0), Vec3<T>(6, 6, 6))));
+}
+
+TYPED_TEST(BoundsTest, TransformedMatchesCorners) {
+  using T                  = TypeParam;
+  const AABB<T>    box(Vec3<T>(-1, 0.5, 2), Vec3<T>(3, 1, 4));
+  const Transform<T> model(Vec3<T>(1, -2, 3), Quat<T>::FromEuler(T(0.4), T(-1.1), T(2.0)), Vec3<T>(2, 1, -0.5));
+  const Mat4<T>&   mat = model.matrix();
+
+  AABB<T> corners;
+  for(int c = 0; c < 8; ++c) {
+    const Vec3<T> p((c & 1) != 0 ? box.max.x : box.min.x, (c & 2) != 0 ? box.max.y : box.min.y,
+                    (c & 4) != 0 ? box.max.z : box.min.z);
+    corners.expand(toVec3(mat * toVec4(p)));
+  }
+  const T       epsilon     = T(1e-5);
+  const AABB<T> transformed = box.transformed(mat);
+  EXPECT_TRUE(transformed.min.isApprox(corners.min, epsilon));
+  EXPECT_TRUE(transformed.max.isApprox(corners.max, epsilon));
+  const AABB<T> affine = box.transformed(Affine3<T>(mat));
+  EXPECT_TRUE(affine.min.isApprox(corners.min, epsilon));
+  EXPECT_TRUE(affine.max.isApprox(corners.max, epsilon));
+  EXPECT_TRUE(AABB<T>().transformed(mat).isEmpty());
+}
+
+TYPED_TEST(BoundsTest, Spheres) {
+  using T = TypeParam;
+  const Sphere<T> sphere(Vec3<T>(1, 0, 0), 2);
+  EXPECT_TRUE(sphere.contains(Vec3<T>(3, 0, 0)));
+  EXPECT_FALSE(sphere.contains(Vec3<T>(3, 0.5, 0)));
+  EXPECT_TRUE(sphere.overlaps(Sphere<T>(Vec3<T>(-2, 0, 0), 1)));
+  EXPECT_FALSE(sphere.overlaps(Sphere<T>(Vec3<T>(-2, 0, 0), T(0.9))));
+  EXPECT_TRUE(sphere.overlaps(AABB<T>(Vec3<T>(2, 1, -1), Vec3<T>(4, 4, 1))));
+  EXPECT_FALSE(sphere.overlaps(AABB<T>(Vec3<T>(3, 1.5, -1), Vec3<T>(4, 4, 1))));
+
+  const Sphere<T> bounding = Sphere<T>::FromAABB(AABB<T>(Vec3<T>(-1, -2, -2), Vec3<T>(1, 2, 2)));
+  EXPECT_EQ(bounding.center, Vec3<T>(0, 0, 0));
+  EXPECT_NEAR(bounding.radius, T(3), T(1e-6));
+}
+
+TYPED_TEST(BoundsTest, FrustumFromViewProjection) {
+  using T                 = TypeParam;
+  const Frustum<T> ndc;
+  EXPECT_TRUE(ndc.contains(Vec3<T>(1, -1, 1)));
+  EXPECT_FALSE(ndc.contains(Vec3<T>(0, 0, 1.01)));
+
+  const Frustum<T> frustum = Frustum<T>::FromMatrix(makeViewProjection<T>());
+  for(int k = 0; k < Frustum<T>::PLANES; ++k) {
+    const Vec4<T>& p = frustum.plane(k);
+    EXPECT_NEAR(p.x * p.x + p.y * p.y + p.z * p.z, T(1), T(1e-5));
+  }
+  // The camera is at z = 5 looking down -z, near 0.5 and far 50.
+  EXPECT_TRUE(frustum.contains(Vec3<T>(0, 0, 0)));
+  EXPECT_TRUE(frustum.contains(Vec3<T>(0, 0, -40)));
+  EXPECT_FALSE(frustum.contains(Vec3<T>(0, 0, 4.6)));
+  EXPECT_FALSE(frustum.contains(Vec3<T>(0, 0, -46)));
+  EXPECT_FALSE(frustum.contains(Vec3<T>(10, 0, 0)));
+  EXPECT_FALSE(frustum.contains(Vec3<T>(0, -10, 0)));
+
+  EXPECT_TRUE(frustum.intersects(AABB<T>(Vec3<T>(5, -1, -1), Vec3<T>(7, 1, 1))));
+  EXPECT_FALSE(frustum.intersects(AABB<T>(Vec3<T>(19, -1, -1), Vec3<T>(21, 1, 1))));
+  EXPECT_TRUE(frustum.intersects(AABB<T>(Vec3<T>(-100, -100, -100), Vec3<T>(100, 100, 100))));
+  EXPECT_TRUE(frustum.intersects(Sphere<T>(Vec3<T>(10, 0, 0), 5)));
+  EXPECT_FALSE(frustum.intersects(Sphere<T>(Vec3<T>(10, 0, 0), 1)));
+}
+
+TYPED_TEST(BoundsTest, BatchedCullMatchesScalar) {
+  using T                          = TypeParam;
+  const Frustum<T>           frustum = Frustum<T>::FromMatrix(makeViewProjection<T>());
+  const std::vector<AABB<T>> boxes   = makeBoxes<T>();
+  for(const std::size_t count : {std::size_t(0), std::size_t(5), std::size_t(17), boxes.size()}) {
+    const AABBSoA<T> soa = AABBSoA<T>::FromAoS(boxes.data(), count);
+    ASSERT_EQ(soa.size(), count);
+    std::vector<std::uint32_t> visible(count);
+    const std::size_t          n = cull(frustum, soa, visible.data());
+
+    std::vector<std::uint32_t> expected;
+    for(std::size_t i = 0; i < count; ++i) {
+      if(frustum.intersects(boxes[i])) {
+        expected.push_back(static_cast<std::uint32_t>(i));
+      }
+    }
+    visible.resize(n);
+    EXPECT_EQ(visible, expected) << "count " << count;
+  }
+  // Some boxes are culled and some are kept.
+  std::vector<std::uint32_t> visible(boxes.size());
+  const std::size_t          n = cull(frustum, AABBSoA<T>::FromAoS(boxes.data(), boxes.size()), visible.data());
+  EXPECT_GT(n, 0U);
+  EXPECT_LT(n, boxes.size());
+}
+
+TYPED_TEST(BoundsTest, RayIntersection) {
+  using T = TypeParam;
+  const AABB<T> box(Vec3<T>(-1, -1, -1), Vec3<T>(1, 1, 1));
+  T             t = -1;
+  EXPECT_TRUE(box.intersectRay(Vec3<T>(-5, 0, 0), inverse(Vec3<T>(1, 0, 0)), 100, t));
+  EXPECT_EQ(t, T(4));
+  EXPECT_FALSE(box.intersectRay(Vec3<T>(-5, 0, 0), inverse(Vec3<T>(1, 0, 0)), 3, t));
+  EXPECT_FALSE(box.intersectRay(Vec3<T>(-5, 0, 0), inverse(Vec3<T>(-1, 0, 0)), 100, t));
+  EXPECT_FALSE(box.intersectRay(Vec3<T>(-5, 2, 0), inverse(Vec3<T>(1, 0, 0)), 100, t));
+  EXPECT_TRUE(box.intersectRay(Vec3<T>(0, 0, 0), inverse(Vec3<T>(1, 2, 3)), 100, t));
+  EXPECT_EQ(t, T(0));
+}
+
+TYPED_TEST(BoundsTest, BatchedRayMatchesScalar) {
+  using T                          = TypeParam;
+  const std::vector<AABB<T>> boxes = makeBoxes<T>();
+  const AABBSoA<T>           soa   = AABBSoA<T>::FromAoS(boxes.data(), boxes.size());
+  const Vec3<T>              origin(T(0.3), T(-0.2), 5);
+  const Vec3<T>              inv_direction = inverse(Vec3<T>(T(0.2), T(0.1), -1).normalized());
+
+  std::vector<std::uint32_t> hits(boxes.size());
+  hits.resize(intersectRay(soa, origin, inv_direction, T(40), hits.data()));
+  std::vector<std::uint32_t> expected;
+  for(std::size_t i = 0; i < boxes.size(); ++i) {
+    T t;
+    if(boxes[i].intersectRay(origin, inv_direction, T(40), t)) {
+      expected.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+  EXPECT_EQ(hits, expected);
+  EXPECT_FALSE(expected.empty());
+}
+
+TEST(BoundsPacketTest, RayPacketMatchesScalar) {
+  using P = simd::Pack<float, 8>;
+  const AABB<float> box(Vec3<float>(-1, -1, -1), Vec3<float>(1, 1, 1));
+  Vec3<float>       origins[8];
+  Vec3<float>       inv_directions[8];
+  for(int i = 0; i < 8; ++i) {
+    origins[i]        = Vec3<float>(-5, static_cast<float>(i) * 0.4F - 1.5F, 0.25F);
+    inv_directions[i] = inverse(Vec3<float>(1, 0.05F * static_cast<float>(i), 0.01F));
+  }
+  P          t_entry = P::broadcast(0);
+  const auto mask    = intersectRay(box, Vec3x8f::Gather(origins), Vec3x8f::Gather(inv_directions), P::broadcast(100),
+                                    t_entry);
+  for(int i = 0; i < 8; ++i) {
+    float      t   = 0;
+    const bool hit = box.intersectRay(origins[i], inv_directions[i], 100, t);
+    EXPECT_EQ((mask.bits() >> i) & 1, hit ? 1 : 0) << i;
+    if(hit) {
+      EXPECT_FLOAT_EQ(t_entry.lane(i), t) << i;
+    }
+  }
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> std::vector<Camera<T>> makeCameras(std::size_t count) {
+  std::vector<Camera<T>> cameras;
+  for(std::size_t i = 0; i < count; ++i) {
+    const T angle = T(0.4) * T(i);
+    cameras.push_back({Vec3<T>(5 * std::cos(angle), T(i) * T(0.5) - 1, 5 * std::sin(angle)),
+                       Vec3<T>(T(0.1) * T(i), 0, 1), Vec3<T>(0, 1, T(0.1))});
+  }
+  return cameras;
+}
+
+// Depth in normalized device coordinates of the point at a distance in front
+// of the camera.
+template <typename T> T depthAt(const Mat4<T>& view_projection, const Camera<T>& camera, T distance) {
+  const Vec3<T> point = camera.eye + (camera.center - camera.eye).normalized() * distance;
+  const Vec4<T> clip  = view_projection * toVec4(point);
+  return clip.z / clip.w;
+}
+
+} // namespace
+
+template <typename T> class CameraTest : public ::testing::Test {};
+
+using CameraTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(CameraTest, CameraTypes);
+
+TYPED_TEST(CameraTest, ViewProjectionMatchesProduct) {
+  using T                           = TypeParam;
+  const T                      fov  = T(1.1);
+  const std::vector<Camera<T>> cams = makeCameras<T>(8);
+  for(const Camera<T>& c : cams) {
+    const Mat4<T> expected =
+        Mat4<T>::Perspective(fov, T(1.5), T(0.1), T(100)) * Mat4<T>::LookAt(c.eye, c.center, c.up);
+    EXPECT_TRUE(viewProjection(c.eye, c.center, c.up, fov, T(1.5), T(0.1), T(100)).isApprox(expected));
+    EXPECT_TRUE(viewProjection(PerspectiveProjection<T>(fov, T(1.5), T(0.1), T(100)), c.eye, c.center, c.up)
+                    .isApprox(expected));
+  }
+}
+
+TYPED_TEST(CameraTest, DepthVariants) {
+  using T                = TypeParam;
+  const Camera<T> camera = makeCameras<T>(3)[2];
+  const T         tol    = sizeof(T) == 4 ? T(1e-5) : T(1e-12);
+
+  const PerspectiveProjection<T> reversed = PerspectiveProjection<T>::ReversedZ(T(1), T(1), T(0.5), T(50));
+  const Mat4<T>                  rz       = viewProjection(reversed, camera.eye, camera.center, camera.up);
+  EXPECT_NEAR(depthAt(rz, camera, T(0.5)), T(1), tol);
+  EXPECT_NEAR(depthAt(rz, camera, T(50)), T(0), tol);
+  EXPECT_GT(depthAt(rz, camera, T(1)), depthAt(rz, camera, T(2)));
+
+  const PerspectiveProjection<T> infinite = PerspectiveProjection<T>::Infinite(T(1), T(1), T(0.5));
+  const Mat4<T>                  inf      = viewProjection(infinite, camera.eye, camera.center, camera.up);
+  EXPECT_NEAR(depthAt(inf, camera, T(0.5)), T(-1), tol);
+  EXPECT_LT(depthAt(inf, camera, T(1e4)), T(1));
+  EXPECT_NEAR(depthAt(inf, camera, T(1e4)), T(1), T(1e-3));
+  // The limit of the finite projection as far grows.
+  const PerspectiveProjection<T> far(T(1), T(1), T(0.5), T(1e7));
+  EXPECT_NEAR(infinite.z_scale, far.z_scale, T(1e-5));
+  EXPECT_NEAR(infinite.z_offset, far.z_offset, T(1e-5));
+
+  const PerspectiveProjection<T> reversed_infinite = PerspectiveProjection<T>::ReversedInfinite(T(1), T(1), T(0.5));
+  const Mat4<T> rinf = viewProjection(reversed_infinite, camera.eye, camera.center, camera.up);
+  EXPECT_NEAR(depthAt(rinf, camera, T(0.5)), T(1), tol);
+  EXPECT_GT(depthAt(rinf, camera, T(1e6)), T(0));
+  EXPECT_NEAR(depthAt(rinf, camera, T(1e6)), T(0), T(1e-5));
+
+  // Every variant keeps the field of view and aspect ratio.
+  const PerspectiveProjection<T> standard(T(1), T(1), T(0.5), T(50));
+  EXPECT_EQ(reversed.x_scale, standard.x_scale);
+  EXPECT_EQ(infinite.y_scale, standard.y_scale);
+  EXPECT_EQ(reversed_infinite.x_scale, standard.x_scale);
+}
+
+TYPED_TEST(CameraTest, BatchedMatchesSingle) {
+  using T = TypeParam;
+  // Covers full packs of every native width and a remainder.
+  const std::size_t                     count   = 37;
+  const std::vector<Camera<T>>          cameras = makeCameras<T>(count);
+  std::vector<PerspectiveProjection<T>> projections;
+  for(std::size_t i = 0; i < count; ++i) {
+    projections.push_back(PerspectiveProjection<T>::ReversedZ(T(0.5) + T(0.05) * T(i), T(1.25), T(0.1), T(10 + i)));
+  }
+  const PerspectiveProjection<T> shared(T(1.2), T(1.7), T(0.2), T(300));
+
+  std::vector<Mat4<T>> out_shared(count);
+  std::vector<Mat4<T>> out_each(count);
+  viewProjections(shared, cameras.data(), out_shared.data(), count);
+  viewProjections(projections.data(), cameras.data(), out_each.data(), count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const Camera<T>& c = cameras[i];
+    EXPECT_TRUE(out_shared[i].isApprox(viewProjection(shared, c.eye, c.center, c.up))) << i;
+    EXPECT_TRUE(out_each[i].isApprox(viewProjection(projections[i], c.eye, c.center, c.up))) << i;
+  }
+}
+
+TYPED_TEST(CameraTest, DegenerateCamera) {
+  using T = TypeParam;
+  // The eye on the target gives the same zero basis as Mat4::LookAt() in the
+  // batched and single versions.
+  std::vector<Camera<T>> cameras(16, Camera<T>{Vec3<T>(1, 2, 3), Vec3<T>(1, 2, 3), Vec3<T>(0, 1, 0)});
+  std::vector<Mat4<T>>   out(cameras.size());
+  const PerspectiveProjection<T> projection(T(1), T(1), T(0.1), T(10));
+  viewProjections(projection, cameras.data(), out.data(), cameras.size());
+  const Mat4<T> expected = projection * Mat4<T>::LookAt(cameras[0].eye, cameras[0].center, cameras[0].up);
+  for(const Mat4<T>& m : out) {
+    EXPECT_EQ(m, expected);
+  }
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "linalg/ColMajor.hpp"
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> Mat4<T> makeMat4() {
+  return {2, -1, 0.5, 3, 1, 4, -2, 0, 0.25, 1, 3, -1, 0, 2, 1, 1};
+}
+
+template <typename T> Mat3<T> makeMat3() { return {2, -1, 0.5, 1, 4, -2, 0.25, 1, 3}; }
+
+} // namespace
+
+template <typename T> class ColMajorTest : public ::testing::Test {};
+
+using ColMajorTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(ColMajorTest, ColMajorTypes);
+
+TYPED_TEST(ColMajorTest, DataIsColumnMajor) {
+  using T                   = TypeParam;
+  const Mat4<T>         m   = makeMat4<T>();
+  const Mat4ColMajor<T> col(m);
+  for(int r = 0; r < 4; ++r) {
+    for(int c = 0; c < 4; ++c) {
+      EXPECT_EQ(col.data()[4 * c + r], m(r, c));
+      EXPECT_EQ(col(r, c), m(r, c));
+    }
+  }
+  EXPECT_EQ(col.toMat4(), m);
+  EXPECT_EQ(col.column(1), Vec4<T>(-1, 4, 1, 2));
+  EXPECT_EQ(Mat4ColMajor<T>(2, -1, 0.5, 3, 1, 4, -2, 0, 0.25, 1, 3, -1, 0, 2, 1, 1), col);
+  EXPECT_EQ(Mat4ColMajor<T>::FromColumns(col.column(0), col.column(1), col.column(2), col.column(3)), col);
+  EXPECT_EQ(Mat4ColMajor<T>::FromRows(Vec4<T>(2, -1, 0.5, 3), Vec4<T>(1, 4, -2, 0), Vec4<T>(0.25, 1, 3, -1),
+                                      Vec4<T>(0, 2, 1, 1)),
+            col);
+  EXPECT_EQ(Mat4ColMajor<T>(), Mat4ColMajor<T>(Mat4<T>::Identity()));
+
+  Mat4ColMajor<T> edited = col;
+  edited(0, 3)           = 7;
+  EXPECT_EQ(edited.data()[12], T(7));
+
+  const Mat3<T>         m3 = makeMat3<T>();
+  const Mat3ColMajor<T> col3(m3);
+  for(int r = 0; r < 3; ++r) {
+    for(int c = 0; c < 3; ++c) {
+      EXPECT_EQ(col3.data()[3 * c + r], m3(r, c));
+    }
+  }
+  EXPECT_EQ(col3.toMat3(), m3);
+  EXPECT_EQ(Mat3ColMajor<T>(2, -1, 0.5, 1, 4, -2, 0.25, 1, 3), col3);
+}
+
+TYPED_TEST(ColMajorTest, ArithmeticMatchesRowMajor) {
+  using T                   = TypeParam;
+  const T               eps = T(1e-5);
+  const Mat4<T>         a   = makeMat4<T>();
+  const Mat4<T>         b   = Mat4<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(0, 0, 0));
+  const Mat4ColMajor<T> ca(a);
+  const Mat4ColMajor<T> cb(b);
+  EXPECT_TRUE((ca * cb).toMat4().isApprox(a * b, eps));
+  EXPECT_TRUE((a * cb).toMat4().isApprox(a * b, eps));
+  EXPECT_TRUE((ca * b).toMat4().isApprox(a * b, eps));
+  EXPECT_TRUE(ca.inverse().toMat4().isApprox(a.inverse(), eps));
+  EXPECT_EQ(ca.transposed().toMat4(), a.transposed());
+  Mat4ColMajor<T> c = ca;
+  c *= cb;
+  EXPECT_EQ(c, ca * cb);
+
+  Mat4ColMajor<T> inv;
+  EXPECT_TRUE(ca.tryInverse(inv));
+  EXPECT_FALSE(Mat4ColMajor<T>(Mat4<T>(1)).tryInverse(inv));
+
+  const Vec4<T> v(1, -2, 0.5, 1);
+  EXPECT_TRUE((ca * v).isApprox(a * v, eps));
+
+  const Mat3<T>         a3 = makeMat3<T>();
+  const Mat3<T>         b3 = b.topLeft3x3();
+  const Mat3ColMajor<T> ca3(a3);
+  const Mat3ColMajor<T> cb3(b3);
+  EXPECT_TRUE((ca3 * cb3).toMat3().isApprox(a3 * b3, eps));
+  EXPECT_TRUE((a3 * cb3).toMat3().isApprox(a3 * b3, eps));
+  EXPECT_TRUE((ca3 * b3).toMat3().isApprox(a3 * b3, eps));
+  EXPECT_TRUE(ca3.inverse().toMat3().isApprox(a3.inverse(), eps));
+  EXPECT_NEAR(ca3.determinant(), a3.determinant(), eps);
+  EXPECT_TRUE((ca3 * Vec3<T>(1, 2, 3)).isApprox(a3 * Vec3<T>(1, 2, 3), eps));
+}
+
+TYPED_TEST(ColMajorTest, FactoriesMatchRowMajor) {
+  using T = TypeParam;
+  EXPECT_EQ(Mat4ColMajor<T>::Perspective(1, 1.5, 0.1, 100).toMat4(), Mat4<T>::Perspective(1, 1.5, 0.1, 100));
+  EXPECT_EQ(Mat4ColMajor<T>::Orthographic(-1, 1, -2, 2, 0.1, 10).toMat4(),
+            Mat4<T>::Orthographic(-1, 1, -2, 2, 0.1, 10));
+  EXPECT_EQ(Mat4ColMajor<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(0, 0, 0), Vec3<T>(0, 1, 0)).toMat4(),
+            Mat4<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(0, 0, 0), Vec3<T>(0, 1, 0)));
+  // The storage is that of the transpose, with no copy.
+  const Mat4ColMajor<T> col = Mat4ColMajor<T>::FromTransposed(makeMat4<T>());
+  EXPECT_EQ(col.asTransposed(), makeMat4<T>());
+  EXPECT_EQ(col.data(), col.asTransposed().data());
+}
@@ -0,0 +1,195 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "linalg/Dispatch.hpp"
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+const std::vector<dispatch::Isa> ALL_ISAS = {dispatch::Isa::Scalar, dispatch::Isa::SSE2, dispatch::Isa::AVX2,
+                                             dispatch::Isa::AVX512, dispatch::Isa::NEON};
+
+template <typename T> std::vector<Vec3<T>> makeVec3s(std::size_t count) {
+  std::vector<Vec3<T>> vectors;
+  for(std::size_t i = 0; i < count; ++i) {
+    const T t = static_cast<T>(i);
+    vectors.emplace_back(t - 4, 2 - t / 2, t * t / 8 - 3);
+  }
+  return vectors;
+}
+
+template <typename T> Mat4<T> makeMatrix() {
+  return Mat4<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(0, 0, 0)) * Mat4<T>::Perspective(1, 1.5, 0.1, 100);
+}
+
+/**
+ * @brief Runs check once with each supported instruction set active, then
+ * restores the default one.
+ */
+template <typename Check> void forEachSupportedIsa(Check check) {
+  for(const dispatch::Isa isa : ALL_ISAS) {
+    if(dispatch::isSupported(isa)) {
+      dispatch::setActiveIsa(isa);
+      SCOPED_TRACE(dispatch::isaName(isa));
+      check();
+    }
+  }
+  dispatch::setActiveIsa(dispatch::bestIsa());
+}
+
+// Sizes covering empty arrays, scalar tails and several full packs.
+const std::vector<std::size_t> SIZES = {0, 1, 3, 4, 7, 8, 9, 16, 17, 35};
+
+} // namespace
+
+TEST(DispatchTest, SelectsASupportedIsa) {
+  EXPECT_TRUE(dispatch::isSupported(dispatch::Isa::Scalar));
+  EXPECT_TRUE(dispatch::isSupported(dispatch::bestIsa()));
+  EXPECT_EQ(dispatch::activeIsa(), dispatch::bestIsa());
+  if(dispatch::isSupported(dispatch::Isa::AVX512)) {
+    EXPECT_TRUE(dispatch::isSupported(dispatch::Isa::AVX2));
+  }
+  EXPECT_FALSE(dispatch::isSupported(dispatch::Isa::SSE2) && dispatch::isSupported(dispatch::Isa::NEON));
+}
+
+TEST(DispatchTest, SetActiveIsa) {
+  dispatch::setActiveIsa(dispatch::Isa::Scalar);
+  EXPECT_EQ(dispatch::activeIsa(), dispatch::Isa::Scalar);
+  dispatch::setActiveIsa(dispatch::bestIsa());
+  EXPECT_EQ(dispatch::activeIsa(), dispatch::bestIsa());
+
+  for(const dispatch::Isa isa : ALL_ISAS) {
+    if(!dispatch::isSupported(isa)) {
+      EXPECT_THROW(dispatch::setActiveIsa(isa), std::invalid_argument);
+    }
+  }
+  EXPECT_EQ(dispatch::activeIsa(), dispatch::bestIsa());
+}
+
+TEST(DispatchTest, IsaNames) {
+  EXPECT_EQ(std::string(dispatch::isaName(dispatch::Isa::Scalar)), "scalar");
+  EXPECT_EQ(std::string(dispatch::isaName(dispatch::Isa::SSE2)), "sse2");
+  EXPECT_EQ(std::string(dispatch::isaName(dispatch::Isa::AVX2)), "avx2");
+  EXPECT_EQ(std::string(dispatch::isaName(dispatch::Isa::AVX512)), "avx512");
+  EXPECT_EQ(std::string(dispatch::isaName(dispatch::Isa::NEON)), "neon");
+}
+
+template <typename T> class DispatchKernelTest : public ::testing::Test {};
+
+using DispatchTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DispatchKernelTest, DispatchTypes);
+
+TYPED_TEST(DispatchKernelTest, TransformsMatchBatch) {
+  using T           = TypeParam;
+  const Mat4<T> mat = makeMatrix<T>();
+  forEachSupportedIsa([&] {
+    for(const std::size_t count : SIZES) {
+      const std::vector<Vec3<T>> in = makeVec3s<T>(count);
+      std::vector<Vec4<T>>       in4;
+      for(const Vec3<T>& v : in) {
+        in4.emplace_back(v.x, v.y, v.z, v.x - v.y);
+      }
+      std::vector<Vec3<T>> points(count);
+      std::vector<Vec3<T>> directions(count);
+      std::vector<Vec4<T>> vectors(count);
+      dispatch::transformPoints(mat, in.data(), points.data(), count);
+      dispatch::transformDirections(mat, in.data(), directions.data(), count);
+      dispatch::transformVectors(mat, in4.data(), vectors.data(), count);
+
+      for(std::size_t i = 0; i < count; ++i) {
+        EXPECT_TRUE(points[i].isApprox(toVec3(mat * toVec4(in[i])), static_cast<T>(1e-4))) << "index " << i;
+        EXPECT_TRUE(directions[i].isApprox(toVec3(mat * Vec4<T>(in[i].x, in[i].y, in[i].z, 0)), static_cast<T>(1e-4)));
+        EXPECT_TRUE(vectors[i].isApprox(mat * in4[i], static_cast<T>(1e-4)));
+      }
+    }
+  });
+}
+
+TYPED_TEST(DispatchKernelTest, NormalizedMatchesVec3) {
+  using T = TypeParam;
+  forEachSupportedIsa([&] {
+    for(const std::size_t count : SIZES) {
+      std::vector<Vec3<T>> in = makeVec3s<T>(count);
+      if(count > 2) {
+        in[2] = Vec3<T>(0, 0, 0);
+      }
+      std::vector<Vec3<T>> out(count);
+      dispatch::normalized(in.data(), out.data(), count);
+      for(std::size_t i = 0; i < count; ++i) {
+        EXPECT_TRUE(out[i].isApprox(in[i].normalized(), static_cast<T>(1e-6))) << "index " << i;
+      }
+
+      dispatch::normalized(in.data(), in.data(), count);
+      for(std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(in[i], out[i]);
+      }
+    }
+  });
+}
+
+TYPED_TEST(DispatchKernelTest, DotMatchesVec3) {
+  using T = TypeParam;
+  forEachSupportedIsa([&] {
+    for(const std::size_t count : SIZES) {
+      const std::vector<Vec3<T>> a = makeVec3s<T>(count);
+      std::vector<Vec3<T>>       b(a.rbegin(), a.rend());
+      std::vector<T>             dots(count);
+      dispatch::dot(a.data(), b.data(), dots.data(), count);
+      for(std::size_t i = 0; i < count; ++i) {
+        EXPECT_NEAR(dots[i], dot(a[i], b[i]), static_cast<T>(1e-4)) << "index " << i;
+      }
+    }
+  });
+}
+
+TYPED_TEST(DispatchKernelTest, MinMaxMatchesCwise) {
+  using T = TypeParam;
+  forEachSupportedIsa([&] {
+    for(const std::size_t count : SIZES) {
+      if(count == 0) {
+        continue;
+      }
+      const std::vector<Vec3<T>> in           = makeVec3s<T>(count);
+      Vec3<T>                    expected_min = in[0];
+      Vec3<T>                    expected_max = in[0];
+      for(const Vec3<T>& v : in) {
+        expected_min = cwiseMin(expected_min, v);
+        expected_max = cwiseMax(expected_max, v);
+      }
+      Vec3<T> lo;
+      Vec3<T> hi;
+      dispatch::minMax(in.data(), count, lo, hi);
+      EXPECT_EQ(lo, expected_min) << "count " << count;
+      EXPECT_EQ(hi, expected_max) << "count " << count;
+    }
+  });
+}
+
+TYPED_TEST(DispatchKernelTest, MinMaxIgnoresNaN) {
+  using T                 = TypeParam;
+  std::vector<Vec3<T>> in = makeVec3s<T>(19);
+  in[0].x                 = std::numeric_limits<T>::quiet_NaN();
+  in[11].y                = std::numeric_limits<T>::quiet_NaN();
+  in[18].z                = std::numeric_limits<T>::quiet_NaN();
+  forEachSupportedIsa([&] {
+    Vec3<T> lo;
+    Vec3<T> hi;
+    dispatch::minMax(in.data(), in.size(), lo, hi);
+    EXPECT_FALSE(std::isnan(lo.x) || std::isnan(lo.y) || std::isnan(lo.z));
+    EXPECT_FALSE(std::isnan(hi.x) || std::isnan(hi.y) || std::isnan(hi.z));
+    EXPECT_EQ(lo.x, in[1].x);
+    EXPECT_EQ(hi.x, in[18].x);
+  });
+}
+
+TYPED_TEST(DispatchKernelTest, MinMaxOfNothingThrows) {
+  using T = TypeParam;
+  Vec3<T> lo;
+  Vec3<T> hi;
+  EXPECT_THROW(dispatch::minMax<T>(nullptr, 0, lo, hi), std::invalid_argument);
+}
@@ -0,0 +1,104 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include "linalg/Expr.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> Mat4<T> makeModel() { return {2, 0, 0, 1, 0, 2, 0, 2, 0, 0, 2, 3, 0, 0, 0, 1}; }
+
+template <typename T> Mat4<T> makeScale() { return {2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4, 0, 0, 0, 0, 1}; }
+
+template <typename T> bool matApprox(const Mat4<T>& a, const Mat4<T>& b, T epsilon) {
+  for(int i = 0; i < 16; ++i) {
+    if(std::fabs(a[i] - b[i]) > epsilon) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+template <typename T> class ExprTest : public ::testing::Test {};
+
+using ExprTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(ExprTest, ExprTypes);
+
+TYPED_TEST(ExprTest, ElementWiseChainMatchesEager) {
+  using T         = TypeParam;
+  const Vec3<T> a = Vec3<T>(1, -2, 3);
+  const Vec3<T> b = Vec3<T>(0.5, 4, -1);
+  const Vec3<T> c = Vec3<T>(-3, 2, 2);
+
+  const Vec3<T> lazy_result = T(2) * lazy(a) + (lazy(b) - c) * T(3) - -lazy(c) / T(4);
+  EXPECT_EQ(lazy_result, T(2) * a + (b - c) * T(3) - -c / T(4));
+
+  const Vec3<T> product = cwiseProduct(lazy(a), b + lazy(c));
+  EXPECT_EQ(product, cwiseProduct(a, b + c));
+  EXPECT_EQ(cwiseMin(lazy(a), b).eval(), cwiseMin(a, b));
+  EXPECT_EQ(cwiseMax(a, lazy(b)).eval(), cwiseMax(a, b));
+}
+
+TYPED_TEST(ExprTest, WorksForAllVectorSizes) {
+  using T          = TypeParam;
+  const Vec2<T> a2 = Vec2<T>(1, 2);
+  const Vec4<T> a4 = Vec4<T>(1, 2, 3, 4);
+  const Vec2<T> r2 = lazy(a2) * T(2) + a2;
+  const Vec4<T> r4 = lazy(a4) * T(2) - a4;
+  EXPECT_EQ(r2, Vec2<T>(3, 6));
+  EXPECT_EQ(r4, Vec4<T>(1, 2, 3, 4));
+  EXPECT_EQ(dot(lazy(a4), a4), dot(a4, a4));
+}
+
+TYPED_TEST(ExprTest, DotAndNormalized) {
+  using T         = TypeParam;
+  const Vec3<T> a = Vec3<T>(1, -2, 3);
+  const Vec3<T> b = Vec3<T>(0.5, 4, -1);
+  EXPECT_EQ(dot(lazy(a) + b, lazy(b)), dot(a + b, b));
+  EXPECT_EQ(dot(lazy(a), b), dot(a, b));
+  EXPECT_EQ((lazy(a) - b).normalized(), (a - b).normalized());
+  EXPECT_EQ((lazy(a) - a).normalized(), Vec3<T>(0, 0, 0));
+}
+
+TYPED_TEST(ExprTest, RefractExpression) {
+  using T                = TypeParam;
+  const Vec3<T> incident = Vec3<T>(1, -1, 0).normalized();
+  const Vec3<T> normal   = Vec3<T>(0, 1, 0);
+  const T       eta      = static_cast<T>(1.0 / 1.5);
+  const T       cos_i    = -dot(normal, incident);
+  const T       cos_t    = std::sqrt(1 - eta * eta * (1 - cos_i * cos_i));
+
+  const Vec3<T> refracted = (eta * lazy(incident) + (eta * cos_i - cos_t) * lazy(normal)).normalized();
+  EXPECT_TRUE(refracted.isApprox(refract(incident, normal, eta), static_cast<T>(1e-6)));
+}
+
+TYPED_TEST(ExprTest, MatrixChainAppliedRightToLeft) {
+  using T                 = TypeParam;
+  const Mat4<T> model     = makeModel<T>();
+  const Mat4<T> view      = Mat4<T>::LookAt(Vec3<T>(0, 2, 5), Vec3<T>(0, 0, 0));
+  const Mat4<T> proj      = Mat4<T>::Perspective(1, 1.5, 0.1, 100);
+  const Vec4<T> point     = Vec4<T>(0.5, -1, 2, 1);
+  const Vec4<T> expected  = proj * view * model * point;
+  const Vec4<T> from_lazy = lazy(proj) * view * model * point;
+  EXPECT_TRUE(from_lazy.isApprox(expected, static_cast<T>(1e-4)));
+
+  const Vec4<T> from_expr = lazy(proj) * (lazy(view) * model) * (lazy(point) * T(2));
+  EXPECT_TRUE(from_expr.isApprox(expected * T(2), static_cast<T>(1e-4)));
+}
+
+TYPED_TEST(ExprTest, MatrixChainEvaluatesToProduct) {
+  using T             = TypeParam;
+  const Mat4<T> a     = makeModel<T>();
+  const Mat4<T> b     = makeScale<T>();
+  const Mat4<T> c     = Mat4<T>::LookAt(Vec3<T>(0, 2, 5), Vec3<T>(0, 0, 0));
+  const Mat4<T> chain = lazy(a) * b * c;
+  EXPECT_TRUE(matApprox(chain, a * b * c, static_cast<T>(1e-5)));
+
+  const Mat3<T> r      = getRotationMatrix<T>(0.1, 0.2, 0.3);
+  const Mat3<T> s      = Mat3<T>(2, 0, 1, 0, 3, 0, 0, 0, 4);
+  const Vec3<T> v      = Vec3<T>(1, 2, 3);
+  const Vec3<T> result = lazy(r) * s * v;
+  EXPECT_TRUE(result.isApprox(r * (s * v), static_cast<T>(1e-6)));
+}
@@ -0,0 +1,189 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+template <typename T> class GenericTest : public ::testing::Test {};
+
+using GenericTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(GenericTest, GenericTypes);
+
+TYPED_TEST(GenericTest, VecConstructors) {
+  using T = TypeParam;
+  const Vec<T, 5> zero;
+  const Vec<T, 5> filled(T(2));
+  const Vec<T, 5> values(1, 2, 3, 4, 5);
+  for(int i = 0; i < 5; ++i) {
+    EXPECT_EQ(zero[i], T(0));
+    EXPECT_EQ(filled[i], T(2));
+    EXPECT_EQ(values[i], T(i + 1));
+  }
+  EXPECT_EQ((Vec<T, 5>::Zero()), zero);
+  EXPECT_NE(filled, zero);
+  EXPECT_EQ(values.data(), values.v);
+}
+
+TYPED_TEST(GenericTest, VecArithmetic) {
+  using T = TypeParam;
+  const Vec<T, 3> a(1, -2, 3);
+  const Vec<T, 3> b(4, 5, -6);
+  EXPECT_EQ(a + b, (Vec<T, 3>(5, 3, -3)));
+  EXPECT_EQ(a - b, (Vec<T, 3>(-3, -7, 9)));
+  EXPECT_EQ(-a, (Vec<T, 3>(-1, 2, -3)));
+  EXPECT_EQ(a * T(2), (Vec<T, 3>(2, -4, 6)));
+  EXPECT_EQ(T(2) * a, (Vec<T, 3>(2, -4, 6)));
+  EXPECT_EQ(a / T(2), (Vec<T, 3>(0.5, -1, 1.5)));
+
+  Vec<T, 3> c = a;
+  c += b;
+  c -= a;
+  c *= T(3);
+  c /= T(1.5);
+  EXPECT_EQ(c, b * T(2));
+}
+
+TYPED_TEST(GenericTest, VecMatchesFixedSizeTypes) {
+  using T = TypeParam;
+  const Vec3<T>   a(1, -2, 3);
+  const Vec3<T>   b(4, 5, -6);
+  const Vec4<T>   c(1, -2, 3, -4);
+  const Vec4<T>   d(-5, 6, 7, 8);
+  const Vec<T, 3> ga(a);
+  const Vec<T, 3> gb(b);
+  const Vec<T, 4> gc(c);
+  const Vec<T, 4> gd(d);
+
+  EXPECT_EQ(dot(ga, gb), dot(a, b));
+  EXPECT_EQ(dot(gc, gd), dot(c, d));
+  EXPECT_EQ(static_cast<Vec3<T>>(cwiseMin(ga, gb)), cwiseMin(a, b));
+  EXPECT_EQ(static_cast<Vec3<T>>(cwiseMax(ga, gb)), cwiseMax(a, b));
+  EXPECT_EQ(static_cast<Vec3<T>>(cwiseProduct(ga, gb)), cwiseProduct(a, b));
+  EXPECT_EQ(static_cast<Vec4<T>>(cwiseMin(gc, gd)), cwiseMin(c, d));
+  EXPECT_EQ(static_cast<Vec4<T>>(cwiseMax(gc, gd)), cwiseMax(c, d));
+  EXPECT_EQ(static_cast<Vec4<T>>(cwiseProduct(gc, gd)), cwiseProduct(c, d));
+  EXPECT_EQ(static_cast<Vec4<T>>(cwiseClamp(gc, Vec<T, 4>(T(-1)), Vec<T, 4>(T(2)))), Vec4<T>(1, -1, 2, -1));
+
+  EXPECT_NEAR(ga.length(), a.length(), T(1e-6));
+  EXPECT_TRUE(static_cast<Vec3<T>>(ga.normalized()).isApprox(a.normalized(), T(1e-6)));
+  EXPECT_EQ((Vec<T, 3>().normalized()), (Vec<T, 3>()));
+
+  const Vec2<T> e(3, 4);
+  EXPECT_EQ(static_cast<Vec2<T>>(Vec<T, 2>(e)), e);
+  EXPECT_EQ((Vec<T, 2>(e).squaredLength()), T(25));
+}
+
+// Checks cwiseMin and cwiseMax of N-element vectors against std::fmin and
+// std::fmax with NaN in a, in b and in both.
+template <typename T, int N> void expectMinMaxIgnoreNaN() {
+  const T   nan = std::numeric_limits<T>::quiet_NaN();
+  Vec<T, N> a;
+  Vec<T, N> b;
+  for(int i = 0; i < N; ++i) {
+    a[i] = i % 3 == 0 ? nan : T(i);
+    b[i] = i % 3 == 1 ? nan : T(2 - i);
+  }
+  a[N - 1] = b[N - 1] = nan;
+  const Vec<T, N> lo = cwiseMin(a, b);
+  const Vec<T, N> hi = cwiseMax(a, b);
+  for(int i = 0; i < N - 1; ++i) {
+    EXPECT_EQ(lo[i], std::fmin(a[i], b[i])) << N << ' ' << i;
+    EXPECT_EQ(hi[i], std::fmax(a[i], b[i])) << N << ' ' << i;
+  }
+  EXPECT_TRUE(std::isnan(lo[N - 1]) && std::isnan(hi[N - 1])) << N;
+}
+
+TYPED_TEST(GenericTest, VecMinMaxIgnoreNaN) {
+  using T = TypeParam;
+  expectMinMaxIgnoreNaN<T, 3>();
+  expectMinMaxIgnoreNaN<T, 4>();
+  expectMinMaxIgnoreNaN<T, 5>();
+}
+
+TYPED_TEST(GenericTest, VecIsApprox) {
+  using T = TypeParam;
+  const Vec<T, 5> a(1, 2, 3, 4, 5);
+  Vec<T, 5>       b = a;
+  b[4] += T(1e-3);
+  EXPECT_TRUE(a.isApprox(b, T(1e-2)));
+  EXPECT_FALSE(a.isApprox(b, T(1e-4)));
+}
+
+TYPED_TEST(GenericTest, MatConstructors) {
+  using T = TypeParam;
+  const Mat2x3<T> identity;
+  EXPECT_EQ(identity, Mat2x3<T>(1, 0, 0, 0, 1, 0));
+  EXPECT_EQ(Mat2x3<T>::Identity(), identity);
+  EXPECT_EQ(Mat4x3<T>::Identity(), Mat4x3<T>(1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0));
+  EXPECT_EQ(Mat2x3<T>::Zero(), Mat2x3<T>(T(0)));
+  EXPECT_NE(Mat2x3<T>::Zero(), identity);
+
+  Mat2x3<T> m(1, 2, 3, 4, 5, 6);
+  EXPECT_EQ(m(1, 2), T(6));
+  m(1, 2) = T(7);
+  EXPECT_EQ(m.rows[1], (Vec<T, 3>(4, 5, 7)));
+  EXPECT_EQ(m.column(1), (Vec<T, 2>(2, 5)));
+}
+
+TYPED_TEST(GenericTest, MatArithmetic) {
+  using T = TypeParam;
+  const Mat2x3<T> a(1, 2, 3, 4, 5, 6);
+  const Mat2x3<T> b(6, 5, 4, 3, 2, 1);
+  EXPECT_EQ(a + b, Mat2x3<T>(T(7)));
+  EXPECT_EQ(a - b, Mat2x3<T>(-5, -3, -1, 1, 3, 5));
+  EXPECT_EQ(a * T(2), Mat2x3<T>(2, 4, 6, 8, 10, 12));
+  EXPECT_EQ(a.transposed(), (Mat<T, 3, 2>(1, 4, 2, 5, 3, 6)));
+  EXPECT_EQ(a.transposed().transposed(), a);
+}
+
+TYPED_TEST(GenericTest, MatProducts) {
+  using T = TypeParam;
+  const Mat2x3<T>    a(1, 2, 3, 4, 5, 6);
+  const Mat<T, 3, 2> b(7, 8, 9, 10, 11, 12);
+  EXPECT_EQ(a * b, Mat2x2<T>(58, 64, 139, 154));
+  EXPECT_EQ((a * Vec<T, 3>(1, 0, -1)), (Vec<T, 2>(-2, -2)));
+
+  // 2D affine transform: a 2x3 matrix applied to a homogeneous point.
+  const Mat2x3<T> affine(0, -1, 5, 1, 0, -2);
+  EXPECT_EQ((affine * Vec<T, 3>(1, 2, 1)), (Vec<T, 2>(3, -1)));
+
+  // Four-column rows go through the SIMD path.
+  const Mat3x4<T> c(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12);
+  const Mat4x3<T> d = c.transposed();
+  EXPECT_EQ(c * d, (Mat<T, 3, 3>(30, 70, 110, 70, 174, 278, 110, 278, 446)));
+  EXPECT_EQ((d * Vec<T, 3>(1, 1, 1)), (Vec<T, 4>(15, 18, 21, 24)));
+  EXPECT_EQ((c * Vec<T, 4>(1, -1, 1, -1)), (Vec<T, 3>(-2, -2, -2)));
+}
+
+TYPED_TEST(GenericTest, MatMatchesFixedSizeTypes) {
+  using T = TypeParam;
+  const T            epsilon = T(1e-5);
+  const Mat4<T>      a       = Mat4<T>::Perspective(T(1.2), T(1.5), T(0.1), T(50));
+  const Mat4<T>      b       = Mat4<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(0, 0, 0), Vec3<T>(0, 1, 0));
+  const Mat<T, 4, 4> product = Mat<T, 4, 4>(a) * Mat<T, 4, 4>(b);
+  EXPECT_TRUE(static_cast<Mat4<T>>(product).isApprox(a * b, epsilon));
+  EXPECT_EQ(static_cast<Mat4<T>>(Mat<T, 4, 4>(a).transposed()), a.transposed());
+
+  const Vec4<T> v(1, -2, 3, 1);
+  EXPECT_TRUE(static_cast<Vec4<T>>(Mat<T, 4, 4>(a) * Vec<T, 4>(v)).isApprox(a * v, epsilon));
+
+  const Mat3<T> c(1, 2, 3, 0, 1, 4, 5, 6, 0);
+  EXPECT_EQ(static_cast<Mat3<T>>(Mat<T, 3, 3>(c) * Mat<T, 3, 3>(c)), c * c);
+
+  const Affine3<T> affine = Affine3<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(0, 0, 0), Vec3<T>(0, 1, 0));
+  const Mat3x4<T>  rows(affine);
+  EXPECT_EQ(static_cast<Affine3<T>>(rows), affine);
+  const Vec3<T> p(0.5, -1, 2);
+  EXPECT_TRUE(static_cast<Vec3<T>>(rows * Vec<T, 4>(Vec4<T>(p.x, p.y, p.z, 1))).isApprox(affine.transformPoint(p),
+                                                                                          epsilon));
+}
+
+TYPED_TEST(GenericTest, MatIsApprox) {
+  using T = TypeParam;
+  const Mat3x4<T> a(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12);
+  Mat3x4<T>       b = a;
+  b(2, 3) += T(1e-3);
+  EXPECT_TRUE(a.isApprox(b, T(1e-2)));
+  EXPECT_FALSE(a.isApprox(b, T(1e-4)));
+}
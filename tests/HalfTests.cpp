@@ -0,0 +1,210 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+#include "linalg/Half.hpp"
+
+using namespace linalg;
+
+namespace {
+
+std::uint16_t halfBits(float value) { return Half(value).bits; }
+
+float fromBits(std::uint16_t bits) { return Half::FromBits(bits).load(); }
+
+template <typename H> bool sameBits(const H& a, const H& b) { return std::memcmp(&a, &b, sizeof(H)) == 0; }
+
+bool isNaNBits(std::uint16_t bits) { return (bits & 0x7C00U) == 0x7C00U && (bits & 0x03FFU) != 0; }
+
+std::uint32_t floatBits(float value) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// Floats covering every half exponent, rounding boundaries and special values.
+std::vector<float> makeFloats() {
+  std::vector<float> values;
+  for(std::uint32_t bits = 0x32000000U; bits < 0x47900000U; bits += 0x1357U) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    values.push_back(value);
+    values.push_back(-value);
+  }
+  for(std::uint32_t h = 0; h < 0x7C00U; h += 7) {
+    // Exact halves and the midpoints to the next one.
+    const float value = fromBits(static_cast<std::uint16_t>(h));
+    const float next  = fromBits(static_cast<std::uint16_t>(h + 1));
+    values.push_back(value);
+    values.push_back((value + next) / 2);
+  }
+  values.push_back(std::numeric_limits<float>::infinity());
+  values.push_back(-std::numeric_limits<float>::infinity());
+  values.push_back(std::numeric_limits<float>::max());
+  values.push_back(std::numeric_limits<float>::denorm_min());
+  values.push_back(-0.0F);
+  return values;
+}
+
+} // namespace
+
+TEST(HalfTest, SizesAreUnpadded) {
+  EXPECT_EQ(sizeof(Half), 2U);
+  EXPECT_EQ(sizeof(HalfVec2), 4U);
+  EXPECT_EQ(sizeof(HalfVec3), 6U);
+  EXPECT_EQ(sizeof(HalfVec4), 8U);
+  EXPECT_EQ(sizeof(HalfMat3), 18U);
+  EXPECT_EQ(sizeof(HalfMat4), 32U);
+  EXPECT_EQ(Half{}.bits, 0U);
+}
+
+TEST(HalfTest, EveryHalfRoundTrips) {
+  for(std::uint32_t h = 0; h <= 0xFFFFU; ++h) {
+    const auto  bits  = static_cast<std::uint16_t>(h);
+    const float value = fromBits(bits);
+    if(isNaNBits(bits)) {
+      EXPECT_TRUE(std::isnan(value)) << std::hex << h;
+      EXPECT_TRUE(isNaNBits(halfBits(value))) << std::hex << h;
+    } else {
+      ASSERT_EQ(halfBits(value), bits) << std::hex << h;
+    }
+  }
+}
+
+TEST(HalfTest, SpecialValues) {
+  EXPECT_EQ(fromBits(0x3C00), 1.0F);
+  EXPECT_EQ(fromBits(0xC000), -2.0F);
+  EXPECT_EQ(fromBits(0x7BFF), 65504.0F);
+  EXPECT_EQ(fromBits(0x0001), std::ldexp(1.0F, -24));
+  EXPECT_EQ(fromBits(0x0400), std::ldexp(1.0F, -14));
+  EXPECT_EQ(fromBits(0x7C00), std::numeric_limits<float>::infinity());
+  EXPECT_EQ(floatBits(fromBits(0x8000)), floatBits(-0.0F));
+  EXPECT_EQ(static_cast<float>(Half(0.5F)), 0.5F);
+
+  EXPECT_EQ(halfBits(-0.0F), 0x8000U);
+  EXPECT_EQ(halfBits(1e10F), 0x7C00U);
+  EXPECT_EQ(halfBits(-std::numeric_limits<float>::infinity()), 0xFC00U);
+  EXPECT_TRUE(isNaNBits(halfBits(std::numeric_limits<float>::quiet_NaN())));
+}
+
+TEST(HalfTest, RoundsToNearestEven) {
+  // Ties between 1 and 1 + 2^-10 go to the even mantissa.
+  EXPECT_EQ(halfBits(1.0F + std::ldexp(1.0F, -11)), 0x3C00U);
+  EXPECT_EQ(halfBits(1.0F + 3 * std::ldexp(1.0F, -11)), 0x3C02U);
+  EXPECT_EQ(halfBits(1.0F + std::ldexp(1.0F, -11) + std::ldexp(1.0F, -20)), 0x3C01U);
+  // Overflow threshold.
+  EXPECT_EQ(halfBits(65519.0F), 0x7BFFU);
+  EXPECT_EQ(halfBits(65520.0F), 0x7C00U);
+  // Subnormals, the smallest normal and underflow.
+  EXPECT_EQ(halfBits(std::ldexp(1.0F, -25)), 0x0000U);
+  EXPECT_EQ(halfBits(std::ldexp(1.5F, -25)), 0x0001U);
+  EXPECT_EQ(halfBits(std::ldexp(3.0F, -25)), 0x0002U);
+  EXPECT_EQ(halfBits(std::ldexp(1.0F, -14) - std::ldexp(1.0F, -26)), 0x0400U);
+  EXPECT_EQ(halfBits(-std::ldexp(1.0F, -30)), 0x8000U);
+}
+
+TEST(HalfTest, BulkConversionMatchesScalar) {
+  const std::vector<float> values = makeFloats();
+  for(const std::size_t count : {std::size_t(0), std::size_t(1), std::size_t(3), std::size_t(7), std::size_t(8),
+                                 std::size_t(17), std::size_t(31), values.size()}) {
+    std::vector<Half> halves(count + 1, Half::FromBits(0x1234));
+    pack(values.data(), halves.data(), count);
+    for(std::size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(halves[i].bits, halfBits(values[i])) << "count " << count << ", value " << values[i];
+    }
+    EXPECT_EQ(halves[count].bits, 0x1234U) << "count " << count;
+
+    std::vector<float> floats(count + 1, 42.0F);
+    unpack(halves.data(), floats.data(), count);
+    for(std::size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(floats[i], halves[i].load()) << "count " << count << ", index " << i;
+    }
+    EXPECT_EQ(floats[count], 42.0F) << "count " << count;
+  }
+}
+
+TEST(HalfTest, LoadStoreVectorsAndMatrices) {
+  const Vec2<float> v2(0.5F, -1.25F);
+  const Vec3<float> v3(1, -2, 0.125F);
+  const Vec4<float> v4(1, 2, 3, -4);
+  EXPECT_EQ(HalfVec2(v2).load(), v2);
+  EXPECT_EQ(HalfVec3(v3).load(), v3);
+  EXPECT_EQ(HalfVec4(v4).load(), v4);
+
+  HalfVec3 h3{};
+  EXPECT_EQ(h3.load(), Vec3<float>(0, 0, 0));
+  h3.store(Vec3<float>(1.0F / 3, 0, 0));
+  EXPECT_NEAR(h3.load().x, 1.0F / 3, 1e-3F);
+  EXPECT_EQ(h3.y.bits, 0U);
+
+  const Mat3<float> m3({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}});
+  const Mat4<float> m4({{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}});
+  EXPECT_EQ(HalfMat3(m3).load(), m3);
+  EXPECT_EQ(HalfMat4(m4).load(), m4);
+  EXPECT_EQ(HalfMat3(m3).m[1][2].load(), 6.0F);
+}
+
+TEST(HalfTest, BulkPackUnpackVectors) {
+  for(std::size_t count = 0; count < 11; ++count) {
+    std::vector<Vec2<float>> in2;
+    std::vector<Vec3<float>> in3;
+    std::vector<Vec4<float>> in4;
+    for(std::size_t i = 0; i < count; ++i) {
+      const float t = static_cast<float>(i) + 0.1F;
+      in2.emplace_back(t, -t);
+      in3.emplace_back(t, 10 + t, -20 * t);
+      in4.emplace_back(t, 10 + t, -20 * t, 1);
+    }
+    std::vector<HalfVec2> half2(count + 1, HalfVec2{});
+    std::vector<HalfVec3> half3(count + 1, HalfVec3{});
+    std::vector<HalfVec4> half4(count + 1, HalfVec4{});
+    pack(in2.data(), half2.data(), count);
+    pack(in3.data(), half3.data(), count);
+    pack(in4.data(), half4.data(), count);
+
+    std::vector<Vec2<float>> out2(count);
+    std::vector<Vec3<float>> out3(count);
+    std::vector<Vec4<float>> out4(count);
+    unpack(half2.data(), out2.data(), count);
+    unpack(half3.data(), out3.data(), count);
+    unpack(half4.data(), out4.data(), count);
+    for(std::size_t i = 0; i < count; ++i) {
+      EXPECT_TRUE(sameBits(half2[i], HalfVec2(in2[i]))) << "count " << count << ", index " << i;
+      EXPECT_TRUE(sameBits(half3[i], HalfVec3(in3[i]))) << "count " << count << ", index " << i;
+      EXPECT_TRUE(sameBits(half4[i], HalfVec4(in4[i]))) << "count " << count << ", index " << i;
+      EXPECT_EQ(out2[i], half2[i].load());
+      EXPECT_EQ(out3[i], half3[i].load());
+      EXPECT_EQ(out4[i], half4[i].load());
+      EXPECT_TRUE(out3[i].isApprox(in3[i], 0.1F));
+    }
+    // Nothing is written past the end of the output.
+    EXPECT_EQ(half2[count].x.bits, 0U);
+    EXPECT_EQ(half3[count].x.bits, 0U);
+    EXPECT_EQ(half4[count].x.bits, 0U);
+  }
+}
+
+TEST(HalfTest, BulkPackUnpackMatrices) {
+  std::vector<Mat3<float>> in3(5);
+  std::vector<Mat4<float>> in4(5);
+  for(std::size_t i = 0; i < in3.size(); ++i) {
+    in3[i](0, 2) = static_cast<float>(i);
+    in4[i](3, 1) = static_cast<float>(i);
+  }
+  std::vector<HalfMat3> half3(in3.size());
+  std::vector<HalfMat4> half4(in4.size());
+  pack(in3.data(), half3.data(), in3.size());
+  pack(in4.data(), half4.data(), in4.size());
+
+  std::vector<Mat3<float>> out3(in3.size(), Mat3<float>(0));
+  std::vector<Mat4<float>> out4(in4.size(), Mat4<float>(0));
+  unpack(half3.data(), out3.data(), out3.size());
+  unpack(half4.data(), out4.data(), out4.size());
+  for(std::size_t i = 0; i < in3.size(); ++i) {
+    EXPECT_EQ(half3[i].m[0][2].load(), static_cast<float>(i));
+    EXPECT_EQ(out3[i], in3[i]);
+    EXPECT_EQ(out4[i], in4[i]);
+  }
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+using instrument::Counter;
+
+namespace {
+
+// Expected value of a counter: the events when instrumented, zero otherwise.
+std::uint64_t expected(std::uint64_t events) { return instrument::ENABLED ? events : 0; }
+
+} // namespace
+
+// This file is also built with LINALG_INSTRUMENT and LINALG_INSTRUMENT_TIMING
+// as the linalg_InstrumentTests executable.
+TEST(InstrumentTest, CountsCallsAndDegenerateCases) {
+  instrument::reset();
+
+  Vec3f zero(0.0F);
+  zero.normalize();
+  EXPECT_EQ(Vec3d(0.0).normalized(), Vec3d(0.0));
+  EXPECT_EQ(Vec2f(3, 4).normalized(), Vec2f(0.6F, 0.8F));
+  Vec4d(1, 0, 0, 0).normalized();
+
+  const Mat3d singular3(1, 2, 3, 2, 4, 6, 0, 0, 1);
+  EXPECT_EQ(singular3.inverse(), Mat3d::Identity());
+  Mat3d::Identity().inverse();
+
+  Mat4f singular4(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  Mat4f result;
+  EXPECT_FALSE(singular4.tryInverse(result));
+  EXPECT_EQ(singular4.inverse(), Mat4f::Identity());
+  Mat4f::Identity().inverse();
+  EXPECT_EQ(singular4.inverseAffine(), Mat4f::Identity());
+  EXPECT_EQ(Affine3f(Mat3f(0.0F), Vec3f(1, 2, 3)).inverse(), Affine3f::Identity());
+
+  const Vec3f normal(0, 1, 0);
+  const Vec3f grazing = Vec3f(1, -0.1F, 0).normalized();
+  refract(grazing, normal, 1.5F);
+  refract(Vec3f(0, -1, 0), normal, 1.5F);
+
+  const instrument::Snapshot counts = instrument::threadSnapshot();
+  // The refracted direction is normalized too.
+  EXPECT_EQ(counts.count(Counter::Normalize), expected(6));
+  EXPECT_EQ(counts.count(Counter::NormalizeZeroLength), expected(2));
+  EXPECT_EQ(counts.count(Counter::Mat3Inverse), expected(2));
+  EXPECT_EQ(counts.count(Counter::Mat3InverseSingular), expected(1));
+  EXPECT_EQ(counts.count(Counter::Mat4Inverse), expected(3));
+  EXPECT_EQ(counts.count(Counter::Mat4InverseSingular), expected(2));
+  EXPECT_EQ(counts.count(Counter::AffineInverseSingular), expected(2));
+  EXPECT_EQ(counts.count(Counter::Refract), expected(2));
+  EXPECT_EQ(counts.count(Counter::RefractTotalInternalReflection), expected(1));
+}
+
+TEST(InstrumentTest, CountsPacketLanes) {
+  instrument::reset();
+  const Vec3f           normal(0, 1, 0);
+  const Vec3f           incident[4] = {Vec3f(1, -0.1F, 0).normalized(), Vec3f(0, -1, 0), Vec3f(0, -1, 0),
+                                       Vec3f(0, -0.1F, 1).normalized()};
+  const Vec3Packet<float, 4> packet = Vec3Packet<float, 4>::Gather(incident);
+  refract(packet, Vec3Packet<float, 4>::Broadcast(normal), 1.5F);
+
+  const instrument::Snapshot counts = instrument::threadSnapshot();
+  EXPECT_EQ(counts.count(Counter::Refract), expected(4));
+  EXPECT_EQ(counts.count(Counter::RefractTotalInternalReflection), expected(2));
+}
+
+TEST(InstrumentTest, SnapshotSumsThreads) {
+  instrument::reset();
+  const Mat4d a = Mat4d::LookAt(Vec3d(1, 2, 3), Vec3d(), Vec3d(0, 1, 0));
+  Mat4d       product;
+  std::thread worker([&a, &product]() {
+    for(int i = 0; i < 10; ++i) {
+      product = a * a;
+    }
+  });
+  worker.join();
+  const Vec4d transformed = a * Vec4d(1, 0, 0, 1);
+  EXPECT_TRUE(std::isfinite(transformed.x + product.m[0][0]));
+
+  EXPECT_EQ(instrument::threadSnapshot().count(Counter::Mat4Multiply), 0U);
+  const instrument::Snapshot total = instrument::snapshot();
+  EXPECT_EQ(total.count(Counter::Mat4Multiply), expected(10));
+  EXPECT_EQ(total.count(Counter::Mat4TransformVec4), expected(1));
+  if(instrument::TIMING) {
+    EXPECT_GT(total.tickCount(Counter::Mat4Multiply), 0U);
+  } else {
+    EXPECT_EQ(total.tickCount(Counter::Mat4Multiply), 0U);
+  }
+
+  instrument::reset();
+  EXPECT_EQ(instrument::snapshot().count(Counter::Mat4Multiply), 0U);
+}
+
+TEST(InstrumentTest, WritesCsv) {
+  instrument::Snapshot snapshot;
+  snapshot.counts[static_cast<std::size_t>(Counter::Refract)] = 7;
+  snapshot.ticks[static_cast<std::size_t>(Counter::Refract)]  = 42;
+  std::ostringstream os;
+  instrument::writeCsv(os, snapshot);
+
+  std::istringstream lines(os.str());
+  std::string        line;
+  std::getline(lines, line);
+  EXPECT_EQ(line, "counter,count,ticks");
+  std::size_t rows = 0;
+  while(std::getline(lines, line)) {
+    ++rows;
+    if(line.compare(0, 8, "Refract,") == 0) {
+      EXPECT_EQ(line, "Refract,7,42");
+    }
+  }
+  EXPECT_EQ(rows, instrument::COUNTER_COUNT);
+  EXPECT_STREQ(instrument::counterName(Counter::Mat4InverseSingular), "Mat4InverseSingular");
+  EXPECT_STREQ(instrument::counterName(Counter::Count), "Unknown");
+}
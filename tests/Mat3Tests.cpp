@@ -168,3 +168,17 @@ TEST(Mat3dTest, InverseMatrixMultiplicationIdentity) {
   Mat3d product = mat * inv;
   EXPECT_TRUE(product.isApprox(Mat3d{}, 1e-6)); 
 }
+
+TEST(Mat3dTest, ElementConstructorIsConstexpr) {
+  constexpr Mat3d m(1, 2, 3, 4, 5, 6, 7, 8, 9);
+  static_assert(m(0, 1) == 2 && m(2, 0) == 7, "element constructor is row-major");
+  static_assert(noexcept(Mat3d(1, 2, 3, 4, 5, 6, 7, 8, 9)), "element constructor must not throw");
+  EXPECT_EQ(m, (Mat3d{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}));
+
+  constexpr Mat3d rows = Mat3d::FromRows({1, 2, 3}, {4, 5, 6}, {7, 8, 9});
+  constexpr Mat3d cols = Mat3d::FromColumns({1, 2, 3}, {4, 5, 6}, {7, 8, 9});
+  constexpr Mat3d t    = rows.transposed();
+  static_assert(rows(1, 2) == 6 && cols(1, 2) == 8 && t(1, 2) == 8, "factories are usable at compile time");
+  EXPECT_EQ(rows, m);
+  EXPECT_EQ(cols, t);
+}
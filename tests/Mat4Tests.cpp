@@ -154,6 +154,47 @@ TEST(Mat4dTest, MultiplicationAssign) {
   EXPECT_EQ(a, expected);
 }
 
+TEST(Mat4dTest, MultiplicationMatchesScalarKernel) {
+  Mat4d a({
+    {1, 2, 3, 4},
+    {5, 6, 7, 8},
+    {9, 10, 11, 12},
+    {13, 14, 15, 16}
+  });
+  Mat4d b({
+    {-1, 0.5, 2, 0},
+    {3, -2, 0, 1},
+    {0.25, 4, -3, 2},
+    {1, 1, 1, -1}
+  });
+
+  Mat4d expected;
+  detail::Mat4ScalarKernels<double>::multiply(a.data(), b.data(), &expected.m[0][0]);
+
+  EXPECT_TRUE((a * b).isApprox(expected, 1e-12));
+}
+
+TEST(Mat4fTest, MultiplicationMatchesScalarKernel) {
+  Mat4f a({
+    {1, 2, 3, 4},
+    {5, 6, 7, 8},
+    {9, 10, 11, 12},
+    {13, 14, 15, 16}
+  });
+  Mat4f b({
+    {-1, 0.5f, 2, 0},
+    {3, -2, 0, 1},
+    {0.25f, 4, -3, 2},
+    {1, 1, 1, -1}
+  });
+
+  Mat4f expected;
+  detail::Mat4ScalarKernels<float>::multiply(a.data(), b.data(), &expected.m[0][0]);
+
+  EXPECT_TRUE((a * b).isApprox(expected, 1e-5f));
+  EXPECT_EQ(Mat4f{} * b, b);
+}
+
 TEST(Mat4dTest, IsApproxEqualMatrices) {
   Mat4d a{
     {{1.0000001, 0.0, 0.0, 0.0},
@@ -234,6 +275,108 @@ TEST(Mat4dTest, InverseMatrixMultiplicationIdentity) {
   EXPECT_TRUE(product.isApprox(Mat4d{}, 1e-6));  
 }
 
+TEST(Mat4dTest, TryInverseReportsSingularMatrix) {
+  Mat4d singular{
+    {{1, 2, 3, 4},
+     {1, 2, 3, 4},
+     {5, 6, 7, 8},
+     {9, 10, 11, 12}}
+  };
+  Mat4d result(7.0);
+
+  EXPECT_FALSE(singular.tryInverse(result));
+  EXPECT_EQ(result, Mat4d(7.0));
+  EXPECT_EQ(singular.inverse(), Mat4d{});
+}
+
+TEST(Mat4dTest, TryInverseInPlace) {
+  Mat4d mat{
+    {{2, 0, 0, 1},
+     {0, 4, 0, 2},
+     {0, 0, 8, 3},
+     {0, 0, 0, 1}}
+  };
+  Mat4d inv = mat;
+
+  EXPECT_TRUE(inv.tryInverse(inv));
+  EXPECT_TRUE((mat * inv).isApprox(Mat4d{}, 1e-12));
+}
+
+TEST(Mat4fTest, InverseMatchesScalarKernel) {
+  Mat4f mat{
+    {{2, -1, 0, 3},
+     {1, 3, 2, -2},
+     {0, 1, 4, 1},
+     {1, 0, -1, 2}}
+  };
+  Mat4f expected;
+  ASSERT_TRUE(detail::Mat4ScalarKernels<float>::inverse(mat.data(), &expected.m[0][0]));
+
+  Mat4f inv;
+  ASSERT_TRUE(mat.tryInverse(inv));
+  EXPECT_TRUE(inv.isApprox(expected, 1e-5f));
+  EXPECT_TRUE((mat * inv).isApprox(Mat4f{}, 1e-5f));
+}
+
+TEST(Mat4dTest, InverseMatchesScalarKernel) {
+  Mat4d mat{
+    {{2, -1, 0, 3},
+     {1, 3, 2, -2},
+     {0, 1, 4, 1},
+     {1, 0, -1, 2}}
+  };
+  Mat4d expected;
+  ASSERT_TRUE(detail::Mat4ScalarKernels<double>::inverse(mat.data(), &expected.m[0][0]));
+
+  Mat4d inv;
+  ASSERT_TRUE(mat.tryInverse(inv));
+  EXPECT_TRUE(inv.isApprox(expected, 1e-12));
+  EXPECT_TRUE((mat * inv).isApprox(Mat4d{}, 1e-12));
+}
+
+TEST(Mat4fTest, TryInverseReportsSingularMatrix) {
+  Mat4f singular(1.0f);
+  Mat4f result(3.0f);
+
+  EXPECT_FALSE(singular.tryInverse(result));
+  EXPECT_EQ(result, Mat4f(3.0f));
+}
+
+TEST(Mat4dTest, InverseAffineMatchesGeneralInverse) {
+  Mat4d affine{
+    {{2, 1, 0, 5},
+     {0, 3, 1, -2},
+     {1, 0, 4, 7},
+     {0, 0, 0, 1}}
+  };
+
+  EXPECT_TRUE(affine.inverseAffine().isApprox(affine.inverse(), 1e-12));
+}
+
+TEST(Mat4dTest, InverseAffineSingularReturnsIdentity) {
+  Mat4d affine{
+    {{1, 2, 3, 5},
+     {2, 4, 6, -2},
+     {1, 0, 4, 7},
+     {0, 0, 0, 1}}
+  };
+
+  EXPECT_EQ(affine.inverseAffine(), Mat4d{});
+}
+
+TEST(Mat4dTest, InverseRigidMatchesGeneralInverse) {
+  const double angle = 0.7;
+  Mat4d rigid{
+    {{std::cos(angle), -std::sin(angle), 0, 1.5},
+     {std::sin(angle), std::cos(angle), 0, -3},
+     {0, 0, 1, 2},
+     {0, 0, 0, 1}}
+  };
+
+  EXPECT_TRUE(rigid.inverseRigid().isApprox(rigid.inverse(), 1e-12));
+  EXPECT_TRUE((rigid * rigid.inverseRigid()).isApprox(Mat4d{}, 1e-12));
+}
+
 TEST(Mat4dTest, FromRows) {
   Mat4d mat = Mat4d::FromRows(
     Vec4d(1.0, 2.0, 3.0, 10.0),
@@ -331,3 +474,27 @@ TEST(Mat4dTest, Mat4dTest_PerspectiveProjection) {
 
   EXPECT_TRUE(perspectiveMatrix.isApprox(expected, 1e-6));
 }
+
+TEST(Mat4dTest, ElementConstructorIsConstexpr) {
+  constexpr Mat4d m(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+  static_assert(m(0, 3) == 4 && m(3, 0) == 13, "element constructor is row-major");
+  static_assert(noexcept(Mat4d(Mat3d())), "Mat3 conversion must not throw");
+  EXPECT_EQ(m, Mat4d::FromRows({1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}));
+
+  constexpr Mat3d top = m.topLeft3x3();
+  static_assert(top(2, 2) == 11, "topLeft3x3 is usable at compile time");
+  constexpr Mat4d from3(top);
+  static_assert(from3(2, 1) == 10 && from3(3, 3) == 1 && from3(0, 3) == 0, "Mat3 conversion is usable at compile time");
+
+  constexpr Mat4d cols = Mat4d::FromColumns({1, 5, 9, 13}, {2, 6, 10, 14}, {3, 7, 11, 15}, {4, 8, 12, 16});
+  EXPECT_EQ(cols, m);
+}
+
+TEST(Mat4dTest, OrthographicIsConstexpr) {
+  constexpr Mat4d ortho = Mat4d::Orthographic(-2, 2, -1, 1, 0.5, 10);
+  static_assert(ortho(0, 0) == 0.5 && ortho(1, 1) == 1 && ortho(3, 3) == 1, "Orthographic is usable at compile time");
+  static_assert(noexcept(Mat4d::Perspective(1.0, 1.0, 0.1, 10.0)), "Perspective must not throw");
+  static_assert(noexcept(Mat4d::LookAt(Vec3d(0, 0, 1), Vec3d(0, 0, 0))), "LookAt must not throw");
+  EXPECT_DOUBLE_EQ(ortho(2, 2), -2 / 9.5);
+  EXPECT_DOUBLE_EQ(ortho(2, 3), -10.5 / 9.5);
+}
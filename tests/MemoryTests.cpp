@@ -0,0 +1,107 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+#include "linalg/Memory.hpp"
+
+using namespace linalg;
+
+TEST(MemoryTest, AlignedAllocRespectsAlignment) {
+  for(const std::size_t alignment : {1U, 2U, 8U, 16U, 64U, 256U}) {
+    for(const std::size_t size : {0U, 1U, 3U, 100U}) {
+      void* ptr = alignedAlloc(size, alignment);
+      ASSERT_NE(ptr, nullptr);
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0U) << "alignment " << alignment;
+      alignedFree(ptr);
+    }
+  }
+  alignedFree(nullptr);
+}
+
+TEST(MemoryTest, AlignedAllocatorWorksWithVector) {
+  std::vector<float, AlignedAllocator<float>> values;
+  for(int i = 0; i < 1000; ++i) {
+    values.push_back(static_cast<float>(i));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values.data()) % DEFAULT_ALIGNMENT, 0U);
+  }
+  EXPECT_EQ(values[999], 999.0F);
+
+  std::vector<double, AlignedAllocator<double, 32>> doubles(7, 1.5);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(doubles.data()) % 32, 0U);
+  EXPECT_TRUE(AlignedAllocator<float>() == AlignedAllocator<double>());
+}
+
+TEST(MemoryTest, AlignedAllocatorThrowsOnOverflow) {
+  AlignedAllocator<double> allocator;
+  EXPECT_THROW(allocator.allocate(static_cast<std::size_t>(-1)), std::bad_alloc);
+}
+
+TEST(MemoryTest, AlignedVectorAlignsOverAlignedTypes) {
+  struct alignas(32) Wide {
+    double v[4];
+  };
+  AlignedVector<Wide> wide(3);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(wide.data()) % DEFAULT_ALIGNMENT, 0U);
+  AlignedVector<float, 128> floats(5, 2.0F);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(floats.data()) % 128, 0U);
+}
+
+TEST(MemoryTest, MonotonicArenaBumpsAndAligns) {
+  MonotonicArena arena(256);
+  EXPECT_EQ(arena.used(), 0U);
+  EXPECT_EQ(arena.capacity(), 0U);
+
+  char* first  = static_cast<char*>(arena.allocate(3, 1));
+  char* second = static_cast<char*>(arena.allocate(5, 1));
+  EXPECT_EQ(second, first + 3);
+  void* aligned = arena.allocate(8, 32);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 32, 0U);
+  void* over_aligned = arena.allocate(8, 256);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(over_aligned) % 256, 0U);
+
+  // Larger than the block size: a dedicated block is allocated.
+  void* large = arena.allocate(10000);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % DEFAULT_ALIGNMENT, 0U);
+  EXPECT_GE(arena.capacity(), 10000U + 256U);
+}
+
+TEST(MemoryTest, MonotonicArenaResetKeepsLargestBlock) {
+  MonotonicArena arena(128);
+  for(int i = 0; i < 20; ++i) {
+    arena.allocate(100);
+  }
+  const std::size_t capacity = arena.capacity();
+  arena.reset();
+  EXPECT_EQ(arena.used(), 0U);
+  EXPECT_LT(arena.capacity(), capacity);
+  const std::size_t kept = arena.capacity();
+
+  // Allocations that fit in the kept block reuse it.
+  void* first = arena.allocate(64);
+  arena.reset();
+  EXPECT_EQ(arena.allocate(64), first);
+  EXPECT_EQ(arena.capacity(), kept);
+
+  arena.release();
+  EXPECT_EQ(arena.capacity(), 0U);
+  arena.reset();
+  EXPECT_EQ(arena.used(), 0U);
+}
+
+TEST(MemoryTest, ArenaVectorAllocatesFromArena) {
+  MonotonicArena      arena;
+  ArenaVector<double> values{ArenaAllocator<double>(arena)};
+  for(int i = 0; i < 100; ++i) {
+    values.push_back(i);
+  }
+  EXPECT_EQ(values[99], 99.0);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values.data()) % DEFAULT_ALIGNMENT, 0U);
+  EXPECT_GT(arena.used(), 100 * sizeof(double));
+
+  MonotonicArena other;
+  EXPECT_TRUE(ArenaAllocator<double>(arena) == ArenaAllocator<float>(arena));
+  EXPECT_TRUE(ArenaAllocator<double>(arena) != ArenaAllocator<double>(other));
+
+  ArenaAllocator<double> allocator(arena);
+  EXPECT_THROW(allocator.allocate(static_cast<std::size_t>(-1)), std::bad_alloc);
+  EXPECT_THROW(arena.allocate(static_cast<std::size_t>(-1) - 8), std::bad_alloc);
+}
@@ -0,0 +1,182 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <limits>
+#include "linalg/Pack.hpp"
+
+using namespace linalg;
+
+template <typename P> class PackTest : public ::testing::Test {};
+
+using PackTypes = ::testing::Types<simd::Pack<float, 4>, simd::Pack<float, 8>, simd::Pack<float, 16>,
+                                   simd::Pack<double, 2>, simd::Pack<double, 4>, simd::Pack<double, 8>,
+                                   simd::Pack<float, 3>, simd::NativePack<float>, simd::NativePack<double>>;
+TYPED_TEST_SUITE(PackTest, PackTypes);
+
+namespace {
+
+template <typename P> P iota(double start, double step) {
+  using T = decltype(P{}.lane(0));
+  T values[P::WIDTH];
+  for(int i = 0; i < P::WIDTH; ++i) {
+    values[i] = static_cast<T>(start + step * i);
+  }
+  return P::load(values);
+}
+
+// Distance in units in the last place between an approximation and the exact
+// value rounded to T.
+template <typename T> double ulpError(T approx, long double exact) {
+  const T rounded = static_cast<T>(exact);
+  return std::fabs(static_cast<double>(approx - rounded)) /
+         static_cast<double>(std::nextafter(rounded, std::numeric_limits<T>::infinity()) - rounded);
+}
+
+} // namespace
+
+TYPED_TEST(PackTest, LoadStoreRoundTrip) {
+  using P = TypeParam;
+  using T = decltype(P{}.lane(0));
+  T in[P::WIDTH];
+  T out[P::WIDTH];
+  for(int i = 0; i < P::WIDTH; ++i) {
+    in[i] = static_cast<T>(i * 1.5);
+  }
+  P::load(in).store(out);
+  for(int i = 0; i < P::WIDTH; ++i) {
+    EXPECT_EQ(out[i], in[i]);
+  }
+  EXPECT_EQ(P::broadcast(static_cast<T>(2.5)).lane(P::WIDTH - 1), static_cast<T>(2.5));
+}
+
+TYPED_TEST(PackTest, Arithmetic) {
+  using P   = TypeParam;
+  const P a = iota<P>(1.0, 1.0);
+  const P b = iota<P>(-2.0, 0.5);
+  for(int i = 0; i < P::WIDTH; ++i) {
+    EXPECT_DOUBLE_EQ((a + b).lane(i), a.lane(i) + b.lane(i));
+    EXPECT_DOUBLE_EQ((a - b).lane(i), a.lane(i) - b.lane(i));
+    EXPECT_DOUBLE_EQ((a * b).lane(i), a.lane(i) * b.lane(i));
+    EXPECT_DOUBLE_EQ((a / b).lane(i), a.lane(i) / b.lane(i));
+    EXPECT_DOUBLE_EQ((-a).lane(i), -a.lane(i));
+    EXPECT_NEAR(simd::madd(a, b, a).lane(i), a.lane(i) * b.lane(i) + a.lane(i), 1e-5);
+    EXPECT_DOUBLE_EQ(simd::min(a, b).lane(i), std::fmin(a.lane(i), b.lane(i)));
+    EXPECT_DOUBLE_EQ(simd::max(a, b).lane(i), std::fmax(a.lane(i), b.lane(i)));
+    EXPECT_DOUBLE_EQ(simd::abs(b).lane(i), std::fabs(b.lane(i)));
+    EXPECT_NEAR(simd::sqrt(a).lane(i), std::sqrt(a.lane(i)), 1e-6);
+  }
+}
+
+TYPED_TEST(PackTest, FminFmaxIgnoreNaN) {
+  using P       = TypeParam;
+  using T       = decltype(P{}.lane(0));
+  const T nan   = std::numeric_limits<T>::quiet_NaN();
+  T       a[P::WIDTH];
+  T       b[P::WIDTH];
+  // Lanes cycle through a NaN in a, in b, in both and in neither.
+  for(int i = 0; i < P::WIDTH; ++i) {
+    a[i] = i % 4 == 0 || i % 4 == 2 ? nan : static_cast<T>(i);
+    b[i] = i % 4 == 1 || i % 4 == 2 ? nan : static_cast<T>(2 - i);
+  }
+  const P pa = P::load(a);
+  const P pb = P::load(b);
+  for(int i = 0; i < P::WIDTH; ++i) {
+    const T lo = simd::fmin(pa, pb).lane(i);
+    const T hi = simd::fmax(pa, pb).lane(i);
+    if(i % 4 == 2) {
+      EXPECT_TRUE(std::isnan(lo) && std::isnan(hi)) << i;
+    } else {
+      EXPECT_EQ(lo, std::fmin(a[i], b[i])) << i;
+      EXPECT_EQ(hi, std::fmax(a[i], b[i])) << i;
+    }
+  }
+}
+
+TYPED_TEST(PackTest, RsqrtFastWithinBound) {
+  using P = TypeParam;
+  using T = decltype(P{}.lane(0));
+  // Geometric sweep over many octaves so that every lane sees varied mantissas.
+  for(int step = 0; step < 2000; ++step) {
+    const P a = iota<P>(std::pow(1.0173, step - 1000.0), 0.3);
+    const P r = simd::rsqrtFast(a);
+    for(int i = 0; i < P::WIDTH; ++i) {
+      const long double exact = 1 / std::sqrt(static_cast<long double>(a.lane(i)));
+      ASSERT_LE(ulpError<T>(r.lane(i), exact), simd::RSQRT_FAST_MAX_ULP) << a.lane(i);
+    }
+  }
+}
+
+TYPED_TEST(PackTest, ComparisonsAndSelect) {
+  using P   = TypeParam;
+  const P a = iota<P>(0.0, 1.0);
+  const P b = P::broadcast(static_cast<decltype(P{}.lane(0))>(1.0));
+
+  const auto less = a < b;
+  EXPECT_EQ(simd::bits(less), 1);
+  EXPECT_TRUE(simd::any(less));
+  EXPECT_FALSE(simd::all(less));
+  EXPECT_TRUE(simd::all(a >= P::broadcast(0)));
+  EXPECT_FALSE(simd::any(a != a));
+  EXPECT_EQ(simd::bits(a == b), 2);
+  EXPECT_EQ(simd::bits(a <= b), 3);
+  EXPECT_EQ(simd::bits((a > b) | (a < b)), (1 << P::WIDTH) - 1 - 2);
+  EXPECT_EQ(simd::bits((a >= b) & (a <= b)), 2);
+
+  const P selected = simd::select(less, b, a);
+  EXPECT_EQ(selected.lane(0), b.lane(0));
+  for(int i = 1; i < P::WIDTH; ++i) {
+    EXPECT_EQ(selected.lane(i), a.lane(i));
+  }
+}
+
+TYPED_TEST(PackTest, HorizontalReductions) {
+  using P   = TypeParam;
+  const P a = iota<P>(3.0, -1.0);
+  double  expected_sum = 0.0;
+  for(int i = 0; i < P::WIDTH; ++i) {
+    expected_sum += 3.0 - i;
+  }
+  EXPECT_DOUBLE_EQ(simd::hsum(a), expected_sum);
+  EXPECT_DOUBLE_EQ(simd::hmax(a), 3.0);
+  EXPECT_DOUBLE_EQ(simd::hmin(a), 3.0 - (P::WIDTH - 1));
+}
+
+template <typename P> class PackTransposeTest : public ::testing::Test {};
+
+using TransposablePackTypes = ::testing::Types<simd::Pack<float, 4>, simd::Pack<float, 8>, simd::Pack<float, 16>,
+                                               simd::Pack<double, 4>, simd::Pack<double, 8>, simd::Pack<float, 12>>;
+TYPED_TEST_SUITE(PackTransposeTest, TransposablePackTypes);
+
+TYPED_TEST(PackTransposeTest, Transpose4) {
+  using P = TypeParam;
+  P rows[4];
+  for(int k = 0; k < 4; ++k) {
+    rows[k] = iota<P>(100.0 * k, 1.0);
+  }
+  simd::transpose4(rows[0], rows[1], rows[2], rows[3]);
+  for(int j = 0; j < 4; ++j) {
+    for(int g = 0; g < P::WIDTH; g += 4) {
+      for(int k = 0; k < 4; ++k) {
+        EXPECT_EQ(rows[j].lane(g + k), 100.0 * k + g + j) << "pack " << j << " lane " << g + k;
+      }
+    }
+  }
+}
+
+TEST(RsqrtFastTest, ScalarWithinBound) {
+  // Every seventh float in [1, 4): the error pattern of the estimate repeats
+  // every two octaves.
+  for(std::uint32_t bits = 0x3F800000U; bits < 0x40800000U; bits += 7) {
+    float x;
+    std::memcpy(&x, &bits, sizeof(x));
+    const double exact = 1 / std::sqrt(static_cast<double>(x));
+    ASSERT_LE(ulpError<float>(simd::rsqrtFast(x), exact), simd::RSQRT_FAST_MAX_ULP) << x;
+  }
+  EXPECT_EQ(simd::rsqrtFast(4.0), 0.5);
+  EXPECT_TRUE(simd::rsqrtFastInRange(1.0F));
+  EXPECT_FALSE(simd::rsqrtFastInRange(0.0F));
+  EXPECT_FALSE(simd::rsqrtFastInRange(std::numeric_limits<float>::denorm_min()));
+  EXPECT_FALSE(simd::rsqrtFastInRange(std::numeric_limits<double>::infinity()));
+  EXPECT_FALSE(simd::rsqrtFastInRange(std::numeric_limits<double>::quiet_NaN()));
+}
@@ -0,0 +1,92 @@
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+#include "linalg/Packed.hpp"
+
+using namespace linalg;
+
+template <typename T> class PackedTest : public ::testing::Test {};
+
+using PackedTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(PackedTest, PackedTypes);
+
+TYPED_TEST(PackedTest, SizesAreUnpadded) {
+  using T = TypeParam;
+  EXPECT_EQ(sizeof(PackedVec2<T>), 2 * sizeof(T));
+  EXPECT_EQ(sizeof(PackedVec3<T>), 3 * sizeof(T));
+  EXPECT_EQ(sizeof(PackedVec4<T>), 4 * sizeof(T));
+  EXPECT_EQ(sizeof(PackedMat3<T>), 9 * sizeof(T));
+  EXPECT_EQ(sizeof(PackedMat4<T>), 16 * sizeof(T));
+  EXPECT_EQ(alignof(PackedVec3<T>), alignof(T));
+}
+
+TYPED_TEST(PackedTest, LoadStoreRoundTrip) {
+  using T = TypeParam;
+  const Vec2<T> v2(1, 2);
+  const Vec3<T> v3(1, 2, 3);
+  const Vec4<T> v4(1, 2, 3, 4);
+  EXPECT_EQ(PackedVec2<T>(v2).load(), v2);
+  EXPECT_EQ(PackedVec3<T>(v3).load(), v3);
+  EXPECT_EQ(PackedVec4<T>(v4).load(), v4);
+
+  PackedVec3<T> p3{};
+  EXPECT_EQ(p3.load(), Vec3<T>(0, 0, 0));
+  p3.store(v3);
+  const T raw[3] = {1, 2, 3};
+  EXPECT_EQ(std::memcmp(&p3, raw, sizeof(raw)), 0);
+
+  const Mat3<T> m3({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}});
+  const Mat4<T> m4({{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}});
+  EXPECT_EQ(PackedMat3<T>(m3).load(), m3);
+  EXPECT_EQ(PackedMat4<T>(m4).load(), m4);
+  EXPECT_EQ(PackedMat3<T>(m3).m[1][2], T(6));
+}
+
+TYPED_TEST(PackedTest, BulkPackUnpackVec3) {
+  using T = TypeParam;
+  for(std::size_t count = 0; count < 11; ++count) {
+    std::vector<Vec3<T>> in;
+    for(std::size_t i = 0; i < count; ++i) {
+      const T t = static_cast<T>(i);
+      in.emplace_back(t, 10 + t, 20 + t);
+    }
+    std::vector<PackedVec3<T>> packed(count);
+    pack(in.data(), packed.data(), count);
+
+    std::vector<T> expected;
+    for(const auto& v : in) {
+      expected.insert(expected.end(), {v.x, v.y, v.z});
+    }
+    EXPECT_EQ(std::memcmp(packed.data(), expected.data(), expected.size() * sizeof(T)), 0) << "count " << count;
+
+    std::vector<Vec3<T>> out(count);
+    unpack(packed.data(), out.data(), count);
+    for(std::size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(out[i], in[i]) << "count " << count << ", index " << i;
+    }
+  }
+}
+
+TYPED_TEST(PackedTest, BulkPackUnpackMatrices) {
+  using T = TypeParam;
+  std::vector<Mat3<T>> in3(5);
+  std::vector<Mat4<T>> in4(5);
+  for(std::size_t i = 0; i < in3.size(); ++i) {
+    in3[i](0, 2) = static_cast<T>(i);
+    in4[i](3, 1) = static_cast<T>(i);
+  }
+  std::vector<PackedMat3<T>> packed3(in3.size());
+  std::vector<PackedMat4<T>> packed4(in4.size());
+  pack(in3.data(), packed3.data(), in3.size());
+  pack(in4.data(), packed4.data(), in4.size());
+
+  std::vector<Mat3<T>> out3(in3.size(), Mat3<T>(0));
+  std::vector<Mat4<T>> out4(in4.size(), Mat4<T>(0));
+  unpack(packed3.data(), out3.data(), out3.size());
+  unpack(packed4.data(), out4.data(), out4.size());
+  for(std::size_t i = 0; i < in3.size(); ++i) {
+    EXPECT_EQ(packed3[i].m[0][2], static_cast<T>(i));
+    EXPECT_EQ(out3[i], in3[i]);
+    EXPECT_EQ(out4[i], in4[i]);
+  }
+}
@@ -0,0 +1,151 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "TestUtils.hpp"
+#include "linalg/Parallel.hpp"
+
+using namespace linalg;
+using test::makeVec3s;
+
+namespace {
+
+// Large enough for several chunks of every element type, and not a multiple
+// of the chunk size.
+constexpr std::size_t COUNT = 3 * parallelChunkSize<Vec3<float>>() + 123;
+
+} // namespace
+
+TEST(ThreadPoolTest, RunsEveryTaskOnce) {
+  for(const std::size_t threads : {1, 2, 4}) {
+    ThreadPool pool(threads);
+    EXPECT_EQ(pool.concurrency(), threads);
+    std::vector<std::atomic<int>> calls(1000);
+    for(int repeat = 0; repeat < 3; ++repeat) {
+      pool.run(calls.size(), [&](std::size_t i) { calls[i].fetch_add(1); });
+    }
+    for(const std::atomic<int>& count : calls) {
+      EXPECT_EQ(count.load(), 3);
+    }
+    pool.run(0, [](std::size_t) { FAIL(); });
+  }
+}
+
+TEST(ThreadPoolTest, RethrowsTaskException) {
+  ThreadPool pool(3);
+  EXPECT_THROW(pool.run(100,
+                        [](std::size_t i) {
+                          if(i == 42) {
+                            throw std::runtime_error("task failed");
+                          }
+                        }),
+               std::runtime_error);
+
+  // The pool stays usable after a failed run.
+  std::atomic<int> calls(0);
+  pool.run(10, [&](std::size_t) { calls.fetch_add(1); });
+  EXPECT_EQ(calls.load(), 10);
+}
+
+TEST(ThreadPoolTest, RequiresAThread) { EXPECT_THROW(ThreadPool(0), std::invalid_argument); }
+
+TEST(ParallelTest, ParallelForCoversRangeInChunks) {
+  ThreadPool       pool(4);
+  std::vector<int> hits(1001, 0);
+  std::atomic<int> ranges(0);
+  parallelFor(pool, hits.size(), 100, [&](std::size_t begin, std::size_t end) {
+    EXPECT_LE(end - begin, 100U);
+    for(std::size_t i = begin; i < end; ++i) {
+      ++hits[i];
+    }
+    ranges.fetch_add(1);
+  });
+  EXPECT_EQ(ranges.load(), 11);
+  for(const int hit : hits) {
+    EXPECT_EQ(hit, 1);
+  }
+}
+
+template <typename T> class ParallelKernelTest : public ::testing::Test {};
+
+using ParallelTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(ParallelKernelTest, ParallelTypes);
+
+TYPED_TEST(ParallelKernelTest, TransformsMatchBatch) {
+  using T                        = TypeParam;
+  const Mat4<T>              mat = Mat4<T>::LookAt(Vec3<T>(1, 2, 3), Vec3<T>(0, 0, 0));
+  const std::vector<Vec3<T>> in  = makeVec3s<T>(COUNT);
+  std::vector<Vec4<T>>       in4;
+  for(const Vec3<T>& v : in) {
+    in4.push_back(toVec4(v));
+  }
+  std::vector<Vec3<T>> expected_points(COUNT);
+  std::vector<Vec3<T>> expected_directions(COUNT);
+  std::vector<Vec4<T>> expected_vectors(COUNT);
+  transformPoints(mat, in.data(), expected_points.data(), COUNT);
+  transformDirections(mat, in.data(), expected_directions.data(), COUNT);
+  transformVectors(mat, in4.data(), expected_vectors.data(), COUNT);
+
+  ThreadPool           pool(3);
+  std::vector<Vec3<T>> points(COUNT);
+  std::vector<Vec3<T>> directions(COUNT);
+  std::vector<Vec4<T>> vectors(COUNT);
+  transformPoints(pool, mat, in.data(), points.data(), COUNT);
+  transformDirections(pool, mat, in.data(), directions.data(), COUNT);
+  transformVectors(pool, mat, in4.data(), vectors.data(), COUNT);
+  EXPECT_EQ(points, expected_points);
+  EXPECT_EQ(directions, expected_directions);
+  EXPECT_EQ(vectors, expected_vectors);
+}
+
+TYPED_TEST(ParallelKernelTest, NormalizedMatchesVec3) {
+  using T                 = TypeParam;
+  std::vector<Vec3<T>> in = makeVec3s<T>(COUNT);
+  ThreadPool           pool(4);
+  std::vector<Vec3<T>> out(COUNT);
+  normalized(pool, in.data(), out.data(), COUNT);
+  for(std::size_t i = 0; i < COUNT; ++i) {
+    ASSERT_EQ(out[i], in[i].normalized()) << "index " << i;
+  }
+  normalized(pool, in.data(), in.data(), COUNT);
+  EXPECT_EQ(in, out);
+}
+
+TYPED_TEST(ParallelKernelTest, SumIsDeterministic) {
+  using T                              = TypeParam;
+  const std::vector<Vec3<T>> in        = makeVec3s<T>(COUNT);
+  ThreadPool                 single(1);
+  const Vec3<T>              reference = sum(single, in.data(), COUNT);
+  for(const std::size_t threads : {2, 3, 4}) {
+    ThreadPool pool(threads);
+    EXPECT_EQ(sum(pool, in.data(), COUNT), reference) << threads << " threads";
+  }
+
+  Vec3<double> exact;
+  for(const Vec3<T>& v : in) {
+    exact += Vec3<double>(v);
+  }
+  EXPECT_TRUE(Vec3<double>(reference).isApprox(exact, 1e-3 * COUNT));
+  EXPECT_EQ(sum<T>(single, nullptr, 0), Vec3<T>());
+}
+
+TYPED_TEST(ParallelKernelTest, MinMaxMatchesCwise) {
+  using T                 = TypeParam;
+  std::vector<Vec3<T>> in = makeVec3s<T>(COUNT);
+  in[COUNT / 2].y         = std::numeric_limits<T>::quiet_NaN();
+  Vec3<T> expected_min    = in[0];
+  Vec3<T> expected_max    = in[0];
+  for(const Vec3<T>& v : in) {
+    expected_min = cwiseMin(expected_min, v);
+    expected_max = cwiseMax(expected_max, v);
+  }
+
+  ThreadPool pool(4);
+  Vec3<T>    lo;
+  Vec3<T>    hi;
+  minMax(pool, in.data(), COUNT, lo, hi);
+  EXPECT_EQ(lo, expected_min);
+  EXPECT_EQ(hi, expected_max);
+  EXPECT_THROW(minMax<T>(pool, nullptr, 0, lo, hi), std::invalid_argument);
+}
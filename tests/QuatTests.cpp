@@ -0,0 +1,140 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> bool matApprox(const Mat3<T>& a, const Mat3<T>& b, T epsilon) {
+  for(int i = 0; i < 9; ++i) {
+    if(std::fabs(a[i] - b[i]) > epsilon) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+template <typename T> class QuatTest : public ::testing::Test {};
+
+using QuatTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(QuatTest, QuatTypes);
+
+TYPED_TEST(QuatTest, DefaultIsIdentity) {
+  using T = TypeParam;
+  const Quat<T> q;
+  EXPECT_EQ(q, Quat<T>::Identity());
+  EXPECT_EQ(q.rotate(Vec3<T>(1, 2, 3)), Vec3<T>(1, 2, 3));
+  EXPECT_EQ(q.toMat3(), Mat3<T>::Identity());
+  EXPECT_EQ(q.toMat4(), Mat4<T>::Identity());
+}
+
+TYPED_TEST(QuatTest, AxisAngleRotatesVector) {
+  using T          = TypeParam;
+  const T       pi = static_cast<T>(3.14159265358979323846);
+  const Quat<T> q  = Quat<T>::FromAxisAngle(Vec3<T>(0, 0, 1), pi / 2);
+  EXPECT_TRUE(q.rotate(Vec3<T>(1, 0, 0)).isApprox(Vec3<T>(0, 1, 0), static_cast<T>(1e-6)));
+  EXPECT_TRUE((q * Vec3<T>(0, 1, 0)).isApprox(Vec3<T>(-1, 0, 0), static_cast<T>(1e-6)));
+  EXPECT_NEAR(q.length(), T(1), static_cast<T>(1e-6));
+}
+
+TYPED_TEST(QuatTest, FromEulerMatchesGetRotationMatrix) {
+  using T         = TypeParam;
+  const T       x = static_cast<T>(0.3);
+  const T       y = static_cast<T>(-1.1);
+  const T       z = static_cast<T>(2.4);
+  const Quat<T> q = Quat<T>::FromEuler(x, y, z);
+  const Mat3<T> r = getRotationMatrix(x, y, z);
+  EXPECT_TRUE(matApprox(q.toMat3(), r, static_cast<T>(1e-5)));
+
+  const Vec3<T> v(1, -2, 0.5);
+  EXPECT_TRUE(q.rotate(v).isApprox(r * v, static_cast<T>(1e-5)));
+}
+
+TYPED_TEST(QuatTest, CompositionMatchesMatrixProduct) {
+  using T         = TypeParam;
+  const Quat<T> a = Quat<T>::FromEuler(static_cast<T>(0.5), static_cast<T>(0.1), static_cast<T>(-0.7));
+  const Quat<T> b = Quat<T>::FromAxisAngle(Vec3<T>(1, 1, 0).normalized(), static_cast<T>(1.2));
+  EXPECT_TRUE(matApprox((a * b).toMat3(), a.toMat3() * b.toMat3(), static_cast<T>(1e-5)));
+
+  const Vec3<T> v(0.25, 3, -1);
+  EXPECT_TRUE((a * b).rotate(v).isApprox(a.rotate(b.rotate(v)), static_cast<T>(1e-5)));
+
+  Quat<T> c = a;
+  c *= b;
+  EXPECT_EQ(c, a * b);
+  EXPECT_TRUE((a * a.inverse()).isApprox(Quat<T>::Identity(), static_cast<T>(1e-6)));
+  EXPECT_TRUE(a.conjugate().isApprox(a.inverse(), static_cast<T>(1e-6)));
+}
+
+TYPED_TEST(QuatTest, FromMat3RoundTrip) {
+  using T = TypeParam;
+  // Angles exercising each branch of the matrix to quaternion conversion.
+  const std::vector<Vec3<T>> angles = {{0.1, 0.2, 0.3}, {3.0, 0.1, 0.2}, {0.1, 3.0, 0.2}, {0.2, 0.1, 3.0}};
+  for(const Vec3<T>& e : angles) {
+    const Quat<T> q    = Quat<T>::FromEuler(e.x, e.y, e.z);
+    const Quat<T> back = Quat<T>::FromMat3(q.toMat3());
+    // q and -q are the same rotation.
+    EXPECT_TRUE(back.isApprox(q, static_cast<T>(1e-5)) || back.isApprox(-q, static_cast<T>(1e-5))) << e;
+  }
+}
+
+TYPED_TEST(QuatTest, NormalizeAndZeroLength) {
+  using T = TypeParam;
+  Quat<T> q(0, 3, 0, 4);
+  EXPECT_TRUE(q.normalized().isApprox(Quat<T>(0, 0.6, 0, 0.8), static_cast<T>(1e-6)));
+  q.normalize();
+  EXPECT_NEAR(q.length(), T(1), static_cast<T>(1e-6));
+
+  Quat<T> zero(0, 0, 0, 0);
+  EXPECT_EQ(zero.normalized(), Quat<T>::Identity());
+  EXPECT_EQ(zero.inverse(), Quat<T>::Identity());
+  zero.normalize();
+  EXPECT_EQ(zero, Quat<T>(0, 0, 0, 0));
+}
+
+TYPED_TEST(QuatTest, SlerpInterpolatesAngle) {
+  using T          = TypeParam;
+  const T       pi = static_cast<T>(3.14159265358979323846);
+  const Vec3<T> axis(0, 1, 0);
+  const Quat<T> a = Quat<T>::FromAxisAngle(axis, 0);
+  const Quat<T> b = Quat<T>::FromAxisAngle(axis, pi / 2);
+  EXPECT_TRUE(slerp(a, b, T(0)).isApprox(a, static_cast<T>(1e-6)));
+  EXPECT_TRUE(slerp(a, b, T(1)).isApprox(b, static_cast<T>(1e-6)));
+  EXPECT_TRUE(slerp(a, b, T(0.25)).isApprox(Quat<T>::FromAxisAngle(axis, pi / 8), static_cast<T>(1e-6)));
+  // Shortest path: -b is the same rotation as b.
+  EXPECT_TRUE(slerp(a, -b, T(0.25)).isApprox(Quat<T>::FromAxisAngle(axis, pi / 8), static_cast<T>(1e-6)));
+  // Nearly parallel rotations fall back to normalized linear interpolation.
+  const Quat<T> c = Quat<T>::FromAxisAngle(axis, static_cast<T>(1e-3));
+  EXPECT_TRUE(slerp(a, c, T(0.5)).isApprox(nlerp(a, c, T(0.5)), static_cast<T>(1e-6)));
+  EXPECT_NEAR(nlerp(a, b, T(0.3)).length(), T(1), static_cast<T>(1e-6));
+}
+
+TYPED_TEST(QuatTest, BatchSlerpMatchesScalar) {
+  using T = TypeParam;
+  std::vector<Quat<T>> a;
+  std::vector<Quat<T>> b;
+  // Enough pairs for several groups of the widest pack plus a tail, with
+  // identical and nearly parallel pairs taking the nlerp fallback.
+  for(int i = 0; i < 37; ++i) {
+    const T t = static_cast<T>(i);
+    a.push_back(Quat<T>::FromEuler(t / 5, -t / 7, t / 3));
+    if(i % 4 == 0) {
+      b.push_back(a.back());
+    } else if(i % 9 == 0) {
+      b.push_back(a.back() * Quat<T>::FromAxisAngle(Vec3<T>(0, 0, 1), static_cast<T>(0.01)));
+    } else {
+      b.push_back(Quat<T>::FromEuler(-t / 4, t / 2, static_cast<T>(1.3)) * T(i % 2 == 0 ? 1 : -1));
+    }
+  }
+  std::vector<Quat<T>> out(a.size());
+  slerp(a.data(), b.data(), static_cast<T>(0.35), out.data(), a.size());
+  for(std::size_t i = 0; i < a.size(); ++i) {
+    EXPECT_TRUE(out[i].isApprox(slerp(a[i], b[i], static_cast<T>(0.35)), static_cast<T>(1e-5))) << i;
+  }
+  slerp(a.data(), b.data(), static_cast<T>(0.35), a.data(), a.size());
+  EXPECT_EQ(a, out);
+}
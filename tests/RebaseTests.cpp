@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "linalg/Rebase.hpp"
+
+using namespace linalg;
+
+namespace {
+
+// Coordinates of a scene about 10 000 km from the world origin.
+const Vec3d ORIGIN(1.0e7, -2.5e6, 3.0e6);
+
+Mat4d translation(const Vec3d& t) { return Mat4d(1, 0, 0, t.x, 0, 1, 0, t.y, 0, 0, 1, t.z, 0, 0, 0, 1); }
+
+} // namespace
+
+TEST(RebaseTest, NarrowMatchesStaticCast) {
+  // 13 elements exercise the vector loops and the scalar tail.
+  std::vector<double> values;
+  for(int i = 0; i < 13; ++i) {
+    values.push_back(1.0 / 3.0 * i - 2.0e5 * (i % 3) + 1.0e-40 * (i == 12));
+  }
+  std::vector<float> out(values.size());
+  narrow(values.data(), out.data(), values.size());
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(out[i], static_cast<float>(values[i]));
+  }
+
+  const Vec3d points[3] = {Vec3d(1.1, 2.2, 3.3), Vec3d(-4.4, 5.5, -6.6), ORIGIN};
+  Vec3f       narrowed_points[3];
+  narrow(points, narrowed_points, 3);
+  const Vec4d vectors[2] = {Vec4d(0.1, 0.2, 0.3, 0.4), Vec4d(1e10, -1e-10, 7, 1)};
+  Vec4f       narrowed_vectors[2];
+  narrow(vectors, narrowed_vectors, 2);
+  for(int i = 0; i < 3; ++i) {
+    EXPECT_EQ(narrowed_points[i], Vec3f(points[i]));
+  }
+  for(int i = 0; i < 2; ++i) {
+    EXPECT_EQ(narrowed_vectors[i], Vec4f(vectors[i]));
+  }
+
+  const Mat4d matrices[2] = {Mat4d::LookAt(Vec3d(1, 2, 3), Vec3d(), Vec3d(0, 1, 0)),
+                             Mat4d::Perspective(1.0, 1.5, 0.1, 100.0)};
+  Mat4f       narrowed_matrices[2];
+  narrow(matrices, narrowed_matrices, 2);
+  const Affine3d transforms[2] = {Affine3d::LookAt(Vec3d(1, 2, 3), Vec3d(), Vec3d(0, 1, 0)),
+                                  Affine3d(Mat3d(0.5), ORIGIN)};
+  Affine3f       narrowed_transforms[2];
+  narrow(transforms, narrowed_transforms, 2);
+  for(int i = 0; i < 2; ++i) {
+    EXPECT_EQ(narrowed_matrices[i], Mat4f(matrices[i]));
+    for(int r = 0; r < 3; ++r) {
+      for(int c = 0; c < 4; ++c) {
+        EXPECT_EQ(narrowed_transforms[i].m[r][c], static_cast<float>(transforms[i].m[r][c]));
+      }
+    }
+  }
+}
+
+TEST(RebaseTest, PointsKeepPrecisionNearOrigin) {
+  std::vector<Vec3d> points;
+  for(int i = 0; i < 5; ++i) {
+    points.push_back(ORIGIN + Vec3d(0.001 * i, -0.25 + i, 0.125 * i));
+  }
+  std::vector<Vec3f> out(points.size());
+  rebase(points.data(), ORIGIN, out.data(), points.size());
+  for(std::size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(out[i], Vec3f(points[i] - ORIGIN));
+  }
+  // Converting first rounds the millimetre offsets away.
+  EXPECT_EQ(static_cast<float>(points[1].x) - static_cast<float>(ORIGIN.x), 0.0F);
+  EXPECT_NEAR(out[1].x, 0.001F, 1e-9F);
+}
+
+TEST(RebaseTest, MatricesAreTranslatedBeforeNarrowing) {
+  const Mat4d rotation(0, -1, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1);
+  const Mat4d models[3] = {translation(ORIGIN + Vec3d(0.5, 0.25, -0.125)) * rotation, translation(ORIGIN),
+                           // A projective last row is rebased exactly too.
+                           Mat4d(1, 0, 0, 2, 0, 1, 0, 3, 0, 0, 1, 4, 0.5, 0, 0, 2)};
+  Mat4f       out[3];
+  rebase(models, ORIGIN, out, 3);
+  for(int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(out[i].isApprox(Mat4f(translation(-ORIGIN) * models[i]), 1e-6F)) << i;
+  }
+  EXPECT_EQ(out[0].m[0][3], 0.5F);
+  EXPECT_EQ(out[0].m[2][3], -0.125F);
+  EXPECT_EQ(out[1], Mat4f{});
+
+  const Affine3d transforms[2] = {Affine3d(Mat3d(2.0), ORIGIN + Vec3d(1, 2, 3)), Affine3d::Identity()};
+  Affine3f       rebased[2];
+  rebase(transforms, ORIGIN, rebased, 2);
+  EXPECT_TRUE(rebased[0].isApprox(Affine3f(Mat3f(2.0F), Vec3f(1, 2, 3)), 1e-6F));
+  EXPECT_TRUE(rebased[1].isApprox(Affine3f(Mat3f::Identity(), Vec3f(-ORIGIN)), 1e-6F));
+}
@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "TestUtils.hpp"
+#include "linalg/Serialization.hpp"
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+using test::ForwardOnlyBuffer;
+
+namespace {
+
+// Removes the file when the test ends.
+struct TempFile {
+  std::string path;
+
+  explicit TempFile(const std::string& name) : path(::testing::TempDir() + name) {}
+  ~TempFile() { std::remove(path.c_str()); }
+};
+
+template <typename T> std::vector<Mat4<T>> makeMatrices(std::size_t count) {
+  std::vector<Mat4<T>> matrices;
+  for(std::size_t i = 0; i < count; ++i) {
+    const T angle = T(i) * T(0.1);
+    matrices.push_back(Mat4<T>::LookAt(Vec3<T>(std::cos(angle), 1, std::sin(angle)), Vec3<T>(), Vec3<T>(0, 1, 0)));
+  }
+  return matrices;
+}
+
+// Reverses the bytes of an integer.
+template <typename U> U swapBytes(U value) {
+  unsigned char bytes[sizeof(U)];
+  std::memcpy(bytes, &value, sizeof(U));
+  std::reverse(std::begin(bytes), std::end(bytes));
+  std::memcpy(&value, bytes, sizeof(U));
+  return value;
+}
+
+// Header of an empty array of Vec3f as written on a host of the other byte order.
+ArrayHeader foreignHeader() {
+  ArrayHeader header  = makeArrayHeader<Vec3f>(0);
+  header.magic        = swapBytes(header.magic);
+  header.version      = swapBytes(header.version);
+  header.endianness   = static_cast<std::uint8_t>(nativeEndianness() == Endianness::Little ? Endianness::Big
+                                                                                           : Endianness::Little);
+  header.alignment    = swapBytes(header.alignment);
+  header.element_size = swapBytes(header.element_size);
+  header.data_offset  = swapBytes(header.data_offset);
+  return header;
+}
+
+// Serialized array of count matrices whose header announces forged_count.
+std::string forgeCount(std::size_t count, std::uint64_t forged_count) {
+  const std::vector<Mat4f> matrices = makeMatrices<float>(count);
+  std::ostringstream       os(std::ios::binary);
+  writeArray(os, matrices.data(), matrices.size());
+  std::string bytes  = os.str();
+  ArrayHeader header = makeArrayHeader<Mat4f>(count);
+  header.count       = forged_count;
+  std::memcpy(&bytes[0], &header, sizeof(header));
+  return bytes;
+}
+
+} // namespace
+
+template <typename T> class SerializationTest : public ::testing::Test {};
+
+using SerializationTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(SerializationTest, SerializationTypes);
+
+TYPED_TEST(SerializationTest, HeaderDescribesElements) {
+  using T                  = TypeParam;
+  const ArrayHeader header = makeArrayHeader<Vec3<T>>(7);
+  EXPECT_EQ(header.magic, ArrayHeader::MAGIC);
+  EXPECT_EQ(header.scalar_type, static_cast<std::uint8_t>(sizeof(T) == 4 ? ScalarType::Float32 : ScalarType::Float64));
+  EXPECT_EQ(header.rows, 3);
+  EXPECT_EQ(header.cols, 1);
+  EXPECT_EQ(header.element_size, sizeof(Vec3<T>));
+  EXPECT_EQ(header.alignment, alignof(Vec3<T>));
+  EXPECT_EQ(header.count, 7U);
+  EXPECT_EQ(header.data_offset % DEFAULT_ALIGNMENT, 0U);
+  EXPECT_EQ(makeArrayHeader<Mat3<T>>(1).cols, 3);
+  EXPECT_EQ(makeArrayHeader<PackedVec3<T>>(1).element_size, 3 * sizeof(T));
+}
+
+TYPED_TEST(SerializationTest, MappedArrayRoundTrips) {
+  using T = TypeParam;
+  const TempFile             file("linalg_mapped_matrices.bin");
+  const std::vector<Mat4<T>> matrices = makeMatrices<T>(100);
+  writeArray(file.path, matrices);
+
+  const MappedArray<Mat4<T>> mapped(file.path);
+  ASSERT_EQ(mapped.size(), matrices.size());
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.data()) % alignof(Mat4<T>), 0U);
+  for(std::size_t i = 0; i < matrices.size(); ++i) {
+    EXPECT_EQ(mapped[i], matrices[i]);
+  }
+
+  std::size_t count = 0;
+  for(const Mat4<T>& m : mapped.span()) {
+    EXPECT_EQ(m, matrices[count++]);
+  }
+  EXPECT_EQ(count, matrices.size());
+}
+
+TYPED_TEST(SerializationTest, StreamRoundTrips) {
+  using T = TypeParam;
+  const std::vector<Vec2<T>>       vec2 = {{1, 2}, {3, 4}, {-5, 6}};
+  const std::vector<PackedVec3<T>> packed(5, PackedVec3<T>(1, -2, 3));
+
+  std::stringstream stream;
+  writeArray(stream, vec2.data(), vec2.size());
+  writeArray(stream, packed.data(), packed.size());
+
+  const auto read_vec2 = readArray<Vec2<T>>(stream);
+  ASSERT_EQ(read_vec2.size(), vec2.size());
+  for(std::size_t i = 0; i < vec2.size(); ++i) {
+    EXPECT_EQ(read_vec2[i], vec2[i]);
+  }
+  const auto read_packed = readArray<PackedVec3<T>>(stream);
+  ASSERT_EQ(read_packed.size(), packed.size());
+  EXPECT_EQ(read_packed[4].load(), packed[4].load());
+}
+
+TYPED_TEST(SerializationTest, EmptyArray) {
+  using T = TypeParam;
+  const TempFile file("linalg_empty.bin");
+  writeArray(file.path, std::vector<Vec4<T>>());
+  const MappedArray<Vec4<T>> mapped(file.path);
+  EXPECT_EQ(mapped.size(), 0U);
+  EXPECT_TRUE(mapped.span().empty());
+  EXPECT_TRUE(readArray<Vec4<T>>(file.path).empty());
+}
+
+TYPED_TEST(SerializationTest, RejectsOtherElementTypes) {
+  using T     = TypeParam;
+  using Other = typename std::conditional<sizeof(T) == 4, double, float>::type;
+  const TempFile             file("linalg_rejected.bin");
+  const std::vector<Mat4<T>> matrices = makeMatrices<T>(4);
+  writeArray(file.path, matrices);
+
+  EXPECT_THROW(MappedArray<Mat3<T>>{file.path}, std::runtime_error);
+  EXPECT_THROW(MappedArray<Vec4<T>>{file.path}, std::runtime_error);
+  EXPECT_THROW(MappedArray<PackedMat4<T>>{file.path}, std::runtime_error);
+  EXPECT_THROW(MappedArray<Mat4<Other>>{file.path}, std::runtime_error);
+  EXPECT_THROW(readArray<Mat3<T>>(file.path), std::runtime_error);
+}
+
+TEST(SerializationFileTest, RejectsInvalidFiles) {
+  EXPECT_THROW(MappedArray<Vec3f>{::testing::TempDir() + "linalg_missing.bin"}, std::runtime_error);
+  EXPECT_THROW(readArray<Vec3f>(::testing::TempDir() + "linalg_missing.bin"), std::runtime_error);
+
+  // Not a serialized array.
+  const TempFile text("linalg_text.bin");
+  {
+    std::ofstream out(text.path, std::ios::binary);
+    out << "This is not a serialized array, but it is longer than the header of one.";
+  }
+  EXPECT_THROW(MappedArray<Vec3f>{text.path}, std::runtime_error);
+
+  // Shorter than a header.
+  const TempFile tiny("linalg_tiny.bin");
+  {
+    std::ofstream out(tiny.path, std::ios::binary);
+    out << "LNLG";
+  }
+  EXPECT_THROW(MappedArray<Vec3f>{tiny.path}, std::runtime_error);
+  EXPECT_THROW(readArray<Vec3f>(tiny.path), std::runtime_error);
+
+  // Header announcing more elements than the file holds.
+  const std::vector<Vec3f> points(10, Vec3f(1, 2, 3));
+  std::stringstream        stream;
+  writeArray(stream, points.data(), points.size());
+  const std::string bytes = stream.str();
+  const TempFile    truncated("linalg_truncated.bin");
+  {
+    std::ofstream out(truncated.path, std::ios::binary);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - sizeof(Vec3f)));
+  }
+  EXPECT_THROW(MappedArray<Vec3f>{truncated.path}, std::runtime_error);
+  EXPECT_THROW(readArray<Vec3f>(truncated.path), std::runtime_error);
+
+  // Other byte order.
+  ArrayHeader header = makeArrayHeader<Vec3f>(0);
+  header.endianness  = static_cast<std::uint8_t>(nativeEndianness() == Endianness::Little ? Endianness::Big
+                                                                                          : Endianness::Little);
+  std::stringstream swapped;
+  swapped.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  EXPECT_THROW(readArray<Vec3f>(swapped), std::runtime_error);
+
+  // A file of the other byte order has a swapped magic and is reported as such.
+  const ArrayHeader foreign = foreignHeader();
+  const TempFile    foreign_file("linalg_foreign.bin");
+  {
+    std::ofstream out(foreign_file.path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&foreign), sizeof(foreign));
+    out.write(std::string(64, '\0').data(), 64);
+  }
+  for(const auto& read : {std::function<void()>([&] { readArray<Vec3f>(foreign_file.path); }),
+                          std::function<void()>([&] { MappedArray<Vec3f>{foreign_file.path}; })}) {
+    try {
+      read();
+      ADD_FAILURE() << "A file of the other byte order was accepted";
+    } catch(const std::runtime_error& error) {
+      EXPECT_NE(std::string(error.what()).find("byte order"), std::string::npos) << error.what();
+    }
+  }
+
+  // Other version.
+  header         = makeArrayHeader<Vec3f>(0);
+  header.version = static_cast<std::uint16_t>(ArrayHeader::VERSION + 1);
+  std::stringstream future;
+  future.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  EXPECT_THROW(readArray<Vec3f>(future), std::runtime_error);
+}
+
+TEST(SerializationFileTest, RejectsForgedCounts) {
+  for(const std::uint64_t count : {std::uint64_t(5), std::uint64_t(1) << 24, std::uint64_t(1) << 40}) {
+    const std::string bytes = forgeCount(4, count);
+
+    // Seekable streams check the count before allocating.
+    std::istringstream is(bytes, std::ios::binary);
+    EXPECT_THROW(readArray<Mat4f>(is), std::runtime_error) << count;
+    std::istringstream header_only(bytes, std::ios::binary);
+    EXPECT_THROW(readArrayHeader<Mat4f>(header_only), std::runtime_error) << count;
+
+    // Others allocate as they read.
+    ForwardOnlyBuffer buffer(bytes);
+    std::istream      forward(&buffer);
+    EXPECT_THROW(readArray<Mat4f>(forward), std::runtime_error) << count;
+  }
+
+  // The count is checked against the bytes after the header, not from the start of the stream.
+  const std::string  bytes = forgeCount(4, 4);
+  std::istringstream is("prefix" + bytes, std::ios::binary);
+  is.ignore(6);
+  EXPECT_EQ(readArray<Mat4f>(is).size(), 4U);
+  ForwardOnlyBuffer buffer(bytes);
+  std::istream      forward(&buffer);
+  EXPECT_EQ(readArray<Mat4f>(forward).size(), 4U);
+}
+
+TEST(SerializationFileTest, MappedFileMoves) {
+  const TempFile           file("linalg_moved.bin");
+  const std::vector<Vec3f> points(3, Vec3f(1, 2, 3));
+  writeArray(file.path, points);
+
+  MappedFile        first(file.path);
+  const std::size_t size = first.size();
+  MappedFile        second(std::move(first));
+  EXPECT_EQ(first.data(), nullptr);
+  EXPECT_EQ(second.size(), size);
+
+  MappedFile third;
+  third = std::move(second);
+  EXPECT_EQ(second.data(), nullptr);
+  EXPECT_EQ(third.size(), size);
+  EXPECT_EQ(std::memcmp(third.data(), "LNLG", 4), 0);
+}
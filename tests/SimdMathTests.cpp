@@ -0,0 +1,160 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+#include "linalg/SimdMath.hpp"
+
+using namespace linalg;
+
+template <typename P> class SimdMathTest : public ::testing::Test {};
+
+using SimdMathTypes = ::testing::Types<simd::Pack<float, 4>, simd::Pack<float, 8>, simd::Pack<float, 16>,
+                                       simd::Pack<double, 2>, simd::Pack<double, 4>, simd::Pack<double, 8>,
+                                       simd::Pack<float, 3>, simd::NativePack<float>, simd::NativePack<double>>;
+TYPED_TEST_SUITE(SimdMathTest, SimdMathTypes);
+
+namespace {
+
+// Error of an approximation in units in the last place of the exact value.
+template <typename T> double ulpError(T approx, long double exact) {
+  if(exact == 0) {
+    return approx == 0 ? 0 : std::numeric_limits<double>::infinity();
+  }
+  const long double ulp = std::ldexp(1.0L, std::ilogb(exact) - (std::numeric_limits<T>::digits - 1));
+  return static_cast<double>(std::fabs(static_cast<long double>(approx) - exact) / ulp);
+}
+
+// Largest error of f over xs, padded to a whole number of packs.
+template <typename P, typename T, typename F, typename Exact>
+double worstError(std::vector<T> xs, F f, Exact exact) {
+  while(xs.size() % P::WIDTH != 0) {
+    xs.push_back(T(0.5));
+  }
+  double worst = 0;
+  for(std::size_t i = 0; i < xs.size(); i += P::WIDTH) {
+    const P r = f(P::load(&xs[i]));
+    for(int l = 0; l < P::WIDTH; ++l) {
+      worst = std::fmax(worst, ulpError(r.lane(l), exact(static_cast<long double>(xs[i + l]))));
+    }
+  }
+  return worst;
+}
+
+// Dense enough to find the worst cases of the polynomials to a few hundredths
+// of an ulp.
+const int SWEEP_POINTS = 1 << 18;
+
+template <typename T> std::vector<T> uniform(double lo, double hi) {
+  std::vector<T> xs(SWEEP_POINTS);
+  for(int i = 0; i < SWEEP_POINTS; ++i) {
+    xs[i] = static_cast<T>(lo + (hi - lo) * i / SWEEP_POINTS);
+  }
+  return xs;
+}
+
+// The values of T closest to multiples k pi / 2 in [-range, range], where the
+// sine or the cosine is near zero and the range reduction cancels. At most
+// 8193 quadrants are taken, evenly spread.
+template <typename T> std::vector<T> nearMultiplesOfHalfPi(double range) {
+  const long double half_pi = 1.57079632679489661923132169163975144L;
+  const long        k_max   = static_cast<long>(range / static_cast<double>(half_pi));
+  const long        step    = k_max / 4096 + 1;
+  std::vector<T>    xs;
+  for(long k = -k_max; k <= k_max; k += step) {
+    T x = static_cast<T>(static_cast<long double>(k) * half_pi);
+    for(int i = 0; i < 4; ++i) {
+      x = std::nextafter(x, -std::numeric_limits<T>::infinity());
+    }
+    for(int i = 0; i < 9; ++i, x = std::nextafter(x, std::numeric_limits<T>::infinity())) {
+      xs.push_back(x);
+    }
+  }
+  return xs;
+}
+
+// The range over which sincos() is documented to be within 2.5 ulp.
+template <typename T> double sincosRange() { return sizeof(T) == sizeof(float) ? 8192 : 1e6; }
+
+template <typename P> P sinOf(const P& x) {
+  P s;
+  P c;
+  simd::sincos(x, s, c);
+  return s;
+}
+
+template <typename P> P cosOf(const P& x) {
+  P s;
+  P c;
+  simd::sincos(x, s, c);
+  return c;
+}
+
+long double exactSin(long double x) { return std::sin(x); }
+long double exactCos(long double x) { return std::cos(x); }
+long double exactTan(long double x) { return std::tan(x); }
+
+} // namespace
+
+TYPED_TEST(SimdMathTest, SincosIsWithinTwoAndAHalfUlp) {
+  using P = TypeParam;
+  using T = decltype(P{}.lane(0));
+  for(const std::vector<T>& xs : {uniform<T>(-4, 4), uniform<T>(-sincosRange<T>(), sincosRange<T>()),
+                                  nearMultiplesOfHalfPi<T>(sincosRange<T>())}) {
+    EXPECT_LE(worstError<P>(xs, sinOf<P>, exactSin), 2.5);
+    EXPECT_LE(worstError<P>(xs, cosOf<P>, exactCos), 2.5);
+  }
+}
+
+TYPED_TEST(SimdMathTest, SincosQuadrants) {
+  using P = TypeParam;
+  using T = decltype(P{}.lane(0));
+  const T pi = static_cast<T>(3.14159265358979323846);
+  for(int k = -8; k <= 8; ++k) {
+    P s;
+    P c;
+    simd::sincos(P::broadcast(pi / 4 * k + T(0.1)), s, c);
+    EXPECT_NEAR(s.lane(0), std::sin(pi / 4 * k + T(0.1)), 4 * std::numeric_limits<T>::epsilon()) << k;
+    EXPECT_NEAR(c.lane(P::WIDTH - 1), std::cos(pi / 4 * k + T(0.1)), 4 * std::numeric_limits<T>::epsilon()) << k;
+  }
+  P s;
+  P c;
+  simd::sincos(P::broadcast(std::numeric_limits<T>::infinity()), s, c);
+  EXPECT_TRUE(std::isnan(s.lane(0)) && std::isnan(c.lane(0)));
+}
+
+TYPED_TEST(SimdMathTest, TanIsWithinFourAndAHalfUlp) {
+  using P   = TypeParam;
+  using T   = decltype(P{}.lane(0));
+  auto tan_ = [](const P& x) { return simd::tan(x); };
+  for(const std::vector<T>& xs : {uniform<T>(-4, 4), uniform<T>(-sincosRange<T>(), sincosRange<T>()),
+                                  nearMultiplesOfHalfPi<T>(sincosRange<T>())}) {
+    EXPECT_LE(worstError<P>(xs, tan_, exactTan), 4.5);
+  }
+}
+
+TYPED_TEST(SimdMathTest, AcosIsWithinOneAndAHalfUlp) {
+  using P = TypeParam;
+  using T = decltype(P{}.lane(0));
+  EXPECT_LE(worstError<P>(uniform<T>(-1, 1), [](const P& x) { return simd::acos(x); },
+                          [](long double x) { return std::acos(x); }),
+            1.5);
+  EXPECT_EQ(simd::acos(P::broadcast(1)).lane(0), T(0));
+  EXPECT_EQ(simd::acos(P::broadcast(-1)).lane(0), static_cast<T>(3.14159265358979323846));
+  EXPECT_TRUE(std::isnan(simd::acos(P::broadcast(T(1.5))).lane(0)));
+}
+
+TYPED_TEST(SimdMathTest, ExpIsWithinDocumentedUlp) {
+  using P              = TypeParam;
+  using T              = decltype(P{}.lane(0));
+  const double max_exp = std::log(static_cast<double>(std::numeric_limits<T>::max()));
+  const double min_exp = std::log(static_cast<double>(std::numeric_limits<T>::min()));
+  const double bound   = sizeof(T) == sizeof(float) ? 1.5 : 2.0;
+  auto         exp_    = [](const P& x) { return simd::exp(x); };
+  auto         exact   = [](long double x) { return std::exp(x); };
+  EXPECT_LE(worstError<P>(uniform<T>(min_exp, max_exp), exp_, exact), bound);
+  EXPECT_LE(worstError<P>(uniform<T>(-1, 1), exp_, exact), bound);
+  EXPECT_EQ(simd::exp(P::broadcast(0)).lane(0), T(1));
+  EXPECT_EQ(simd::exp(P::broadcast(static_cast<T>(max_exp + 1))).lane(0), std::numeric_limits<T>::infinity());
+  EXPECT_EQ(simd::exp(P::broadcast(-std::numeric_limits<T>::infinity())).lane(0), T(0));
+  EXPECT_TRUE(std::isnan(simd::exp(P::broadcast(std::numeric_limits<T>::quiet_NaN())).lane(0)));
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> std::vector<Mat4<T>> makeJoints(std::size_t count) {
+  std::vector<Mat4<T>> joints;
+  for(std::size_t i = 0; i < count; ++i) {
+    const T angle = T(0.3) * T(i);
+    joints.push_back(Mat4<T>::LookAt(Vec3<T>(std::cos(angle), T(i), std::sin(angle) + 2), Vec3<T>(), Vec3<T>(0, 1, 0)));
+  }
+  return joints;
+}
+
+template <typename T> std::vector<JointInfluences<T>> makeInfluences(std::size_t count, std::uint32_t joints) {
+  std::vector<JointInfluences<T>> influences(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const auto j  = static_cast<std::uint32_t>(i);
+    influences[i] = {{j % joints, (j * 7 + 1) % joints, (j * 3 + 2) % joints, 0},
+                     {T(0.5), T(0.25), T(0.25), T(0)}};
+  }
+  return influences;
+}
+
+template <typename T> std::vector<Vec3<T>> makePoints(std::size_t count) {
+  std::vector<Vec3<T>> points;
+  for(std::size_t i = 0; i < count; ++i) {
+    const T t = T(i);
+    points.emplace_back(t * T(0.1), T(1) - t * T(0.05), T(0.5) * t - 2);
+  }
+  return points;
+}
+
+// The blended matrix built with the general Mat4 arithmetic.
+template <typename T> Mat4<T> blend(const std::vector<Mat4<T>>& joints, const JointInfluences<T>& influences) {
+  Mat4<T> sum;
+  for(int e = 0; e < 16; ++e) {
+    sum[e] = 0;
+    for(int k = 0; k < JointInfluences<T>::COUNT; ++k) {
+      sum[e] += influences.weights[k] * joints[influences.joints[k]][e];
+    }
+  }
+  return sum;
+}
+
+} // namespace
+
+template <typename T> class SkinningTest : public ::testing::Test {};
+
+using SkinningTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(SkinningTest, SkinningTypes);
+
+TYPED_TEST(SkinningTest, PaletteStoresColumns) {
+  using T                           = TypeParam;
+  const std::vector<Mat4<T>> joints = makeJoints<T>(3);
+  const SkinningPalette<T>   palette(joints.data(), joints.size());
+  ASSERT_EQ(palette.size(), 3U);
+  for(std::size_t j = 0; j < joints.size(); ++j) {
+    EXPECT_EQ(palette.matrix(j), joints[j]);
+    EXPECT_EQ(palette.columns(j)[1], joints[j](1, 0));
+  }
+
+  SkinningPalette<T> empty;
+  EXPECT_EQ(empty.size(), 0U);
+  empty.update(joints.data(), 1);
+  EXPECT_EQ(empty.matrix(0), joints[0]);
+}
+
+TYPED_TEST(SkinningTest, TransformIndexedMatchesMat4) {
+  using T                             = TypeParam;
+  const std::size_t          count    = 37;
+  const std::vector<Mat4<T>> matrices = makeJoints<T>(5);
+  const std::vector<Vec3<T>> points   = makePoints<T>(count);
+  std::vector<std::uint32_t> indices(count);
+  std::vector<Vec4<T>>       vectors(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    indices[i] = static_cast<std::uint32_t>((i * 3) % matrices.size());
+    vectors[i] = Vec4<T>(points[i].x, points[i].y, points[i].z, T(i % 2));
+  }
+
+  std::vector<Vec4<T>> out(count);
+  transformIndexed(matrices.data(), indices.data(), vectors.data(), out.data(), count);
+  std::vector<Vec3<T>> out_points(count);
+  transformPointsIndexed(matrices.data(), indices.data(), points.data(), out_points.data(), count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const Mat4<T>& m = matrices[indices[i]];
+    EXPECT_TRUE(out[i].isApprox(m * vectors[i], T(1e-5))) << i;
+    EXPECT_TRUE(out_points[i].isApprox(toVec3(m * toVec4(points[i])), T(1e-5))) << i;
+  }
+
+  // In place.
+  transformIndexed(matrices.data(), indices.data(), vectors.data(), vectors.data(), count);
+  for(std::size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(vectors[i], out[i]);
+  }
+}
+
+TYPED_TEST(SkinningTest, SkinningMatchesBlendedMatrices) {
+  using T                    = TypeParam;
+  const T                    epsilon = T(1e-5);
+  const std::vector<Mat4<T>> joints  = makeJoints<T>(6);
+  const SkinningPalette<T>   palette(joints.data(), joints.size());
+  // Odd and above the prefetch distance, to cover the pairs and the tail.
+  const std::size_t                     count      = 21;
+  const std::vector<JointInfluences<T>> influences = makeInfluences<T>(count, 6);
+  const std::vector<Vec3<T>>            points     = makePoints<T>(count);
+
+  std::vector<Vec3<T>> skinned(count);
+  std::vector<Vec3<T>> directions(count);
+  std::vector<Vec3<T>> positions(count);
+  std::vector<Vec3<T>> normals(count);
+  skinPoints(palette, influences.data(), points.data(), skinned.data(), count);
+  skinDirections(palette, influences.data(), points.data(), directions.data(), count);
+  skinVertices(palette, influences.data(), points.data(), points.data(), positions.data(), normals.data(), count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const Mat4<T> m = blend(joints, influences[i]);
+    EXPECT_TRUE(skinned[i].isApprox(toVec3(m * toVec4(points[i])), epsilon)) << i;
+    EXPECT_TRUE(directions[i].isApprox(m.topLeft3x3() * points[i], epsilon)) << i;
+    EXPECT_EQ(positions[i], skinned[i]);
+    EXPECT_EQ(normals[i], directions[i]);
+  }
+
+  // A single full-weight influence is the joint transform itself.
+  std::vector<JointInfluences<T>> rigid(count, JointInfluences<T>{{2, 0, 0, 0}, {T(1), T(0), T(0), T(0)}});
+  std::vector<Vec3<T>>            in_place = points;
+  skinPoints(palette, rigid.data(), in_place.data(), in_place.data(), count);
+  for(std::size_t i = 0; i < count; ++i) {
+    EXPECT_TRUE(in_place[i].isApprox(toVec3(joints[2] * toVec4(points[i])), epsilon)) << i;
+  }
+
+  skinPoints(palette, influences.data(), points.data(), skinned.data(), 0);
+}
@@ -0,0 +1,273 @@
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> std::vector<Vec3<T>> makeVec3s(std::size_t count, T offset) {
+  std::vector<Vec3<T>> vectors;
+  for(std::size_t i = 0; i < count; ++i) {
+    const T t = static_cast<T>(i) + offset;
+    vectors.emplace_back(t - 4, 2 - t / 2, t * t / 8 - 3);
+  }
+  return vectors;
+}
+
+template <typename T> std::vector<Vec4<T>> makeVec4s(std::size_t count, T offset) {
+  std::vector<Vec4<T>> vectors;
+  for(std::size_t i = 0; i < count; ++i) {
+    const T t = static_cast<T>(i) + offset;
+    vectors.emplace_back(t - 4, 2 - t / 2, t * t / 8 - 3, 1 - t);
+  }
+  return vectors;
+}
+
+// Sizes covering empty containers, scalar tails and several full packs.
+const std::vector<std::size_t> SIZES = {0, 1, 3, 4, 7, 8, 9, 17};
+
+} // namespace
+
+template <typename T> class SoATest : public ::testing::Test {};
+
+using SoATypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(SoATest, SoATypes);
+
+TYPED_TEST(SoATest, AoSRoundTrip) {
+  using T                         = TypeParam;
+  const std::vector<Vec3<T>> aos3 = makeVec3s<T>(11, 0);
+  const Vec3SoA<T>           soa3 = Vec3SoA<T>::FromAoS(aos3.data(), aos3.size());
+  std::vector<Vec3<T>>       back3(aos3.size());
+  soa3.toAoS(back3.data());
+  EXPECT_EQ(soa3.size(), aos3.size());
+  for(std::size_t i = 0; i < aos3.size(); ++i) {
+    EXPECT_EQ(back3[i], aos3[i]);
+    EXPECT_EQ(soa3.get(i), aos3[i]);
+  }
+
+  const std::vector<Vec4<T>> aos4 = makeVec4s<T>(11, 0);
+  const Vec4SoA<T>           soa4 = Vec4SoA<T>::FromAoS(aos4.data(), aos4.size());
+  std::vector<Vec4<T>>       back4(aos4.size());
+  soa4.toAoS(back4.data());
+  for(std::size_t i = 0; i < aos4.size(); ++i) {
+    EXPECT_EQ(back4[i], aos4[i]);
+  }
+}
+
+TYPED_TEST(SoATest, StorageIsCacheLineAligned) {
+  using T = TypeParam;
+  Vec4SoA<T> soa(5);
+  for(const T* ptr : {soa.x(), soa.y(), soa.z(), soa.w()}) {
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % DEFAULT_ALIGNMENT, 0U);
+  }
+}
+
+TYPED_TEST(SoATest, SetAndResize) {
+  using T = TypeParam;
+  Vec3SoA<T> soa(2);
+  soa.set(1, Vec3<T>(1, 2, 3));
+  EXPECT_EQ(soa.get(0), Vec3<T>(0, 0, 0));
+  EXPECT_EQ(soa.get(1), Vec3<T>(1, 2, 3));
+  soa.resize(4);
+  EXPECT_EQ(soa.size(), 4U);
+  EXPECT_EQ(soa.get(1), Vec3<T>(1, 2, 3));
+  EXPECT_EQ(soa.get(3), Vec3<T>(0, 0, 0));
+}
+
+TYPED_TEST(SoATest, DotAndCrossMatchVec3) {
+  using T = TypeParam;
+  for(const std::size_t count : SIZES) {
+    const std::vector<Vec3<T>> a = makeVec3s<T>(count, 0);
+    const std::vector<Vec3<T>> b = makeVec3s<T>(count, static_cast<T>(0.5));
+    const Vec3SoA<T>           sa = Vec3SoA<T>::FromAoS(a.data(), count);
+    const Vec3SoA<T>           sb = Vec3SoA<T>::FromAoS(b.data(), count);
+
+    std::vector<T> dots(count);
+    dot(sa, sb, dots.data());
+    Vec3SoA<T> crosses;
+    cross(sa, sb, crosses);
+    ASSERT_EQ(crosses.size(), count);
+
+    for(std::size_t i = 0; i < count; ++i) {
+      EXPECT_NEAR(dots[i], dot(a[i], b[i]), static_cast<T>(1e-4)) << "count " << count << ", index " << i;
+      EXPECT_TRUE(crosses.get(i).isApprox(a[i].cross(b[i]), static_cast<T>(1e-4)));
+    }
+  }
+}
+
+TYPED_TEST(SoATest, NormalizedMatchesVec3) {
+  using T                = TypeParam;
+  std::vector<Vec3<T>> a = makeVec3s<T>(9, 0);
+  a[2]                   = Vec3<T>(0, 0, 0);
+  Vec3SoA<T> sa          = Vec3SoA<T>::FromAoS(a.data(), a.size());
+
+  Vec3SoA<T> out;
+  normalized(sa, out);
+  normalize(sa);
+  for(std::size_t i = 0; i < a.size(); ++i) {
+    EXPECT_TRUE(out.get(i).isApprox(a[i].normalized(), static_cast<T>(1e-6)));
+    Vec3<T> expected = a[i];
+    expected.normalize();
+    EXPECT_TRUE(sa.get(i).isApprox(expected, static_cast<T>(1e-6)));
+  }
+  EXPECT_EQ(out.get(2), Vec3<T>(0, 0, 0));
+}
+
+TYPED_TEST(SoATest, NormalizedFastMatchesVec3) {
+  using T                = TypeParam;
+  std::vector<Vec3<T>> a = makeVec3s<T>(19, 0);
+  a[2]                   = Vec3<T>(0, 0, 0);
+  const Vec3SoA<T> sa    = Vec3SoA<T>::FromAoS(a.data(), a.size());
+
+  Vec3SoA<T> out;
+  normalizedFast(sa, out);
+  for(std::size_t i = 0; i < a.size(); ++i) {
+    EXPECT_TRUE(out.get(i).isApprox(a[i].normalized(), static_cast<T>(1e-5)));
+  }
+  EXPECT_EQ(out.get(2), Vec3<T>(0, 0, 0));
+}
+
+TYPED_TEST(SoATest, CwiseMinMaxClampMatchVec3) {
+  using T                         = TypeParam;
+  const std::vector<Vec3<T>> a    = makeVec3s<T>(13, 0);
+  const std::vector<Vec3<T>> lo   = std::vector<Vec3<T>>(13, Vec3<T>(-1, -2, -1));
+  const std::vector<Vec3<T>> hi   = std::vector<Vec3<T>>(13, Vec3<T>(1, 2, 3));
+  const Vec3SoA<T>           sa   = Vec3SoA<T>::FromAoS(a.data(), a.size());
+  const Vec3SoA<T>           slo  = Vec3SoA<T>::FromAoS(lo.data(), lo.size());
+  const Vec3SoA<T>           shi  = Vec3SoA<T>::FromAoS(hi.data(), hi.size());
+  Vec3SoA<T>                 mins;
+  Vec3SoA<T>                 maxs;
+  Vec3SoA<T>                 clamped;
+  cwiseMin(sa, shi, mins);
+  cwiseMax(sa, slo, maxs);
+  cwiseClamp(sa, slo, shi, clamped);
+  for(std::size_t i = 0; i < a.size(); ++i) {
+    EXPECT_EQ(mins.get(i), cwiseMin(a[i], hi[i]));
+    EXPECT_EQ(maxs.get(i), cwiseMax(a[i], lo[i]));
+    EXPECT_EQ(clamped.get(i), cwiseClamp(a[i], lo[i], hi[i]));
+  }
+}
+
+TYPED_TEST(SoATest, CwiseMinMaxIgnoreNaN) {
+  using T                      = TypeParam;
+  const T              nan     = std::numeric_limits<T>::quiet_NaN();
+  std::vector<Vec3<T>> a       = makeVec3s<T>(9, 0);
+  std::vector<Vec3<T>> b       = makeVec3s<T>(9, static_cast<T>(0.5));
+  std::vector<Vec4<T>> a4      = makeVec4s<T>(9, 0);
+  std::vector<Vec4<T>> b4      = makeVec4s<T>(9, static_cast<T>(0.5));
+  // NaN components in a, in b and in both, in the packed body and the tail.
+  for(const std::size_t i : {std::size_t(0), std::size_t(5), std::size_t(8)}) {
+    a[i].x = a4[i].x = nan;
+    b[i].y = b4[i].y = nan;
+    a[i].z = b[i].z = a4[i].w = b4[i].w = nan;
+  }
+  const Vec3SoA<T> sa  = Vec3SoA<T>::FromAoS(a.data(), a.size());
+  const Vec3SoA<T> sb  = Vec3SoA<T>::FromAoS(b.data(), b.size());
+  const Vec4SoA<T> sa4 = Vec4SoA<T>::FromAoS(a4.data(), a4.size());
+  const Vec4SoA<T> sb4 = Vec4SoA<T>::FromAoS(b4.data(), b4.size());
+  Vec3SoA<T>       mins;
+  Vec3SoA<T>       maxs;
+  Vec4SoA<T>       mins4;
+  Vec4SoA<T>       maxs4;
+  cwiseMin(sa, sb, mins);
+  cwiseMax(sa, sb, maxs);
+  cwiseMin(sa4, sb4, mins4);
+  cwiseMax(sa4, sb4, maxs4);
+
+  // Vec3 equality is false for NaN: compare the components that are not both NaN.
+  for(std::size_t i = 0; i < a.size(); ++i) {
+    for(int c = 0; c < 3; ++c) {
+      if(!(std::isnan(a[i][c]) && std::isnan(b[i][c]))) {
+        EXPECT_EQ(mins.get(i)[c], cwiseMin(a[i], b[i])[c]) << i << ' ' << c;
+        EXPECT_EQ(maxs.get(i)[c], cwiseMax(a[i], b[i])[c]) << i << ' ' << c;
+      }
+    }
+    for(int c = 0; c < 4; ++c) {
+      if(!(std::isnan(a4[i][c]) && std::isnan(b4[i][c]))) {
+        EXPECT_EQ(mins4.get(i)[c], cwiseMin(a4[i], b4[i])[c]) << i << ' ' << c;
+        EXPECT_EQ(maxs4.get(i)[c], cwiseMax(a4[i], b4[i])[c]) << i << ' ' << c;
+      }
+    }
+  }
+  EXPECT_TRUE(std::isnan(mins.get(5).z));
+  EXPECT_TRUE(std::isnan(maxs4.get(8).w));
+}
+
+TYPED_TEST(SoATest, ReflectAndRefractMatchScalar) {
+  using T = TypeParam;
+  std::vector<Vec3<T>> incident;
+  std::vector<Vec3<T>> normal;
+  for(std::size_t i = 0; i < 11; ++i) {
+    const T t = static_cast<T>(i) / 10;
+    incident.push_back(Vec3<T>(t, -1, 0).normalized());
+    normal.push_back(Vec3<T>(0, 1, t / 2).normalized());
+  }
+  const Vec3SoA<T> si = Vec3SoA<T>::FromAoS(incident.data(), incident.size());
+  const Vec3SoA<T> sn = Vec3SoA<T>::FromAoS(normal.data(), normal.size());
+
+  Vec3SoA<T> reflected;
+  reflect(si, sn, reflected);
+  // eta of 1.5 puts the most grazing rays in total internal reflection.
+  for(const T eta : {static_cast<T>(0.75), static_cast<T>(1.5)}) {
+    Vec3SoA<T> refracted;
+    refract(si, sn, eta, refracted);
+    for(std::size_t i = 0; i < incident.size(); ++i) {
+      EXPECT_TRUE(refracted.get(i).isApprox(refract(incident[i], normal[i], eta), static_cast<T>(1e-5)))
+          << "eta " << eta << ", index " << i;
+    }
+  }
+  for(std::size_t i = 0; i < incident.size(); ++i) {
+    EXPECT_TRUE(reflected.get(i).isApprox(reflect(incident[i], normal[i]), static_cast<T>(1e-5)));
+  }
+}
+
+TYPED_TEST(SoATest, Vec4OperationsMatchVec4) {
+  using T = TypeParam;
+  for(const std::size_t count : SIZES) {
+    std::vector<Vec4<T>>       a  = makeVec4s<T>(count, 0);
+    const std::vector<Vec4<T>> b  = makeVec4s<T>(count, static_cast<T>(0.5));
+    const Vec4SoA<T>           sa = Vec4SoA<T>::FromAoS(a.data(), count);
+    const Vec4SoA<T>           sb = Vec4SoA<T>::FromAoS(b.data(), count);
+
+    std::vector<T> dots(count);
+    dot(sa, sb, dots.data());
+    Vec4SoA<T> norms;
+    normalized(sa, norms);
+    Vec4SoA<T> mins;
+    cwiseMin(sa, sb, mins);
+    Vec4SoA<T> maxs;
+    cwiseMax(sa, sb, maxs);
+    Vec4SoA<T> clamped;
+    cwiseClamp(sa, mins, maxs, clamped);
+
+    for(std::size_t i = 0; i < count; ++i) {
+      EXPECT_NEAR(dots[i], dot(a[i], b[i]), static_cast<T>(1e-4));
+      EXPECT_TRUE(norms.get(i).isApprox(a[i].normalized(), static_cast<T>(1e-6)));
+      EXPECT_EQ(mins.get(i), cwiseMin(a[i], b[i]));
+      EXPECT_EQ(maxs.get(i), cwiseMax(a[i], b[i]));
+      EXPECT_EQ(clamped.get(i), a[i]);
+    }
+  }
+}
+
+TYPED_TEST(SoATest, MismatchedSizesThrow) {
+  using T = TypeParam;
+  const Vec3SoA<T> a(3);
+  const Vec3SoA<T> b(4);
+  Vec3SoA<T>       out;
+  std::vector<T>   dots(4);
+  EXPECT_THROW(dot(a, b, dots.data()), std::invalid_argument);
+  EXPECT_THROW(cross(a, b, out), std::invalid_argument);
+  EXPECT_THROW(cwiseClamp(a, a, b, out), std::invalid_argument);
+  EXPECT_THROW(refract(a, b, T(1), out), std::invalid_argument);
+
+  const Vec4SoA<T> c(3);
+  const Vec4SoA<T> d(5);
+  Vec4SoA<T>       out4;
+  EXPECT_THROW(cwiseMin(c, d, out4), std::invalid_argument);
+}
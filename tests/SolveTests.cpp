@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> T tolerance() { return sizeof(T) == sizeof(float) ? T(1e-4) : T(1e-10); }
+
+template <typename T, typename Matrix> Matrix scaled(Matrix m, T scale) {
+  for(auto& row : m.m) {
+    for(T& element : row) {
+      element *= scale;
+    }
+  }
+  return m;
+}
+
+// Well-conditioned matrices whose first pivot is small, so that pivoting
+// matters, with a singular one every 10 matrices.
+template <typename T> Mat3<T> makeMat3(std::size_t i) {
+  const T t = static_cast<T>(i);
+  if(i % 10 == 9) {
+    return Mat3<T>(1, 2, 3, 2, 4, 6, t, 1, 0);
+  }
+  return Mat3<T>(T(0.001) * t, 2, -1, 3 + t / 8, 1, 2, -1, 4, 1 + t / 16);
+}
+
+template <typename T> Mat4<T> makeMat4(std::size_t i) {
+  const T t = static_cast<T>(i);
+  if(i % 10 == 9) {
+    return Mat4<T>(1, 2, 3, 4, 2, 4, 6, 8, 0, 1, t, 0, 1, 0, 0, 1);
+  }
+  return Mat4<T>(0, 2, -1, 1, 3 + t / 8, 1, 2, 0, -1, 4, 1, t / 16, 1, 0, 2, 5);
+}
+
+// Symmetric positive definite: a * a^T plus a multiple of the identity.
+template <typename T> Mat3<T> makeSpd3(std::size_t i) {
+  const Mat3<T> a   = makeMat3<T>(i % 10 == 9 ? 0 : i);
+  Mat3<T>       spd = a * a.transposed();
+  for(int k = 0; k < 3; ++k) {
+    spd.m[k][k] += T(0.5);
+  }
+  return spd;
+}
+
+template <typename T> Vec3<T> makeVec3(std::size_t i) {
+  const T t = static_cast<T>(i);
+  return Vec3<T>(1 - t, t / 4, 2);
+}
+
+template <typename T> Vec4<T> makeVec4(std::size_t i) {
+  const T t = static_cast<T>(i);
+  return Vec4<T>(1 - t, t / 4, 2, -1);
+}
+
+} // namespace
+
+template <typename T> class SolveTest : public ::testing::Test {};
+
+using SolveTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(SolveTest, SolveTypes);
+
+TYPED_TEST(SolveTest, SolvesWithPivoting) {
+  using T = TypeParam;
+  // A zero first pivot fails without row exchanges.
+  const Mat3<T> a3(0, 1, 2, 1, 0, 3, 4, -3, 8);
+  const Vec3<T> x3(1, -2, 3);
+  EXPECT_TRUE(solve(a3, a3 * x3).isApprox(x3, tolerance<T>()));
+
+  const Mat4<T> a4(0, 2, 0, 1, 2, 2, 3, 2, 4, -3, 0, 1, 6, 1, -6, -5);
+  const Vec4<T> x4(1, -2, 3, -4);
+  Vec4<T>       b4 = a4 * x4;
+  EXPECT_TRUE(trySolve(a4, b4, b4));
+  EXPECT_TRUE(b4.isApprox(x4, tolerance<T>()));
+}
+
+TYPED_TEST(SolveTest, SingularSystems) {
+  using T = TypeParam;
+  const Mat3<T> a3(1, 2, 3, 2, 4, 6, 0, 1, 0);
+  Vec3<T>       x3(7);
+  EXPECT_FALSE(trySolve(a3, Vec3<T>(1, 2, 3), x3));
+  EXPECT_EQ(x3, Vec3<T>(7));
+  EXPECT_EQ(solve(a3, Vec3<T>(1, 2, 3)), Vec3<T>(0));
+  EXPECT_EQ(solve(Mat4<T>(0), Vec4<T>(1)), Vec4<T>(0));
+
+  // NaNs are never solvable, whichever pivot they reach.
+  Mat3<T> nan3 = Mat3<T>::Identity();
+  nan3.m[0][0] = std::numeric_limits<T>::quiet_NaN();
+  Mat4<T> nan4 = Mat4<T>::Identity();
+  nan4.m[2][1] = std::numeric_limits<T>::quiet_NaN();
+  Vec4<T> x4(7);
+  EXPECT_FALSE(trySolve(nan3, Vec3<T>(1), x3));
+  EXPECT_FALSE(trySolve(nan4, Vec4<T>(1), x4));
+  EXPECT_FALSE(trySolveCholesky(nan3, Vec3<T>(1), x3));
+  EXPECT_EQ(x3, Vec3<T>(7));
+  EXPECT_EQ(x4, Vec4<T>(7));
+}
+
+TYPED_TEST(SolveTest, SingularityIsRelativeToScale) {
+  using T       = TypeParam;
+  const T small = sizeof(T) == sizeof(float) ? T(1e-7) : T(1e-16);
+  const T large = sizeof(T) == sizeof(float) ? T(1e7) : T(1e16);
+  for(const T scale : {small, large}) {
+    const Mat3<T> a3 = scaled(Mat3<T>::Identity(), scale);
+    const Mat4<T> a4 = scaled(Mat4<T>::Identity(), scale);
+    EXPECT_TRUE(solve(a3, Vec3<T>(1, 2, 3) * scale).isApprox(Vec3<T>(1, 2, 3), tolerance<T>())) << scale;
+    EXPECT_TRUE(solve(a4, Vec4<T>(1, 2, 3, 4) * scale).isApprox(Vec4<T>(1, 2, 3, 4), tolerance<T>())) << scale;
+    EXPECT_TRUE(solveCholesky(a3, Vec3<T>(1, 2, 3) * scale).isApprox(Vec3<T>(1, 2, 3), tolerance<T>())) << scale;
+    // A rank-deficient matrix stays singular at any scale.
+    EXPECT_EQ(solve(scaled(Mat3<T>(1, 2, 3, 2, 4, 6, 0, 1, 0), scale), Vec3<T>(1)), Vec3<T>(0)) << scale;
+  }
+}
+
+TYPED_TEST(SolveTest, Cholesky) {
+  using T = TypeParam;
+  const Mat3<T> spd(4, 2, -2, 2, 10, 2, -2, 2, 5);
+  const Vec3<T> x3(1, -2, 3);
+  EXPECT_TRUE(solveCholesky(spd, spd * x3).isApprox(x3, tolerance<T>()));
+  // Only the lower triangle is read.
+  Mat3<T> lower = spd;
+  lower.m[0][1] = lower.m[0][2] = lower.m[1][2] = 100;
+  EXPECT_TRUE(solveCholesky(lower, spd * x3).isApprox(x3, tolerance<T>()));
+
+  const Mat4<T> spd4(4, 1, 0, 1, 1, 3, 1, 0, 0, 1, 2, 0, 1, 0, 0, 2);
+  const Vec4<T> x4(1, -2, 3, -4);
+  Vec4<T>       b4 = spd4 * x4;
+  EXPECT_TRUE(trySolveCholesky(spd4, b4, b4));
+  EXPECT_TRUE(b4.isApprox(x4, tolerance<T>()));
+
+  // Indefinite and semidefinite matrices are rejected.
+  Vec3<T> x(7);
+  EXPECT_FALSE(trySolveCholesky(Mat3<T>(1, 2, 0, 2, 1, 0, 0, 0, 1), Vec3<T>(1), x));
+  EXPECT_FALSE(trySolveCholesky(Mat3<T>(1, 1, 0, 1, 1, 0, 0, 0, 1), Vec3<T>(1), x));
+  EXPECT_EQ(x, Vec3<T>(7));
+  EXPECT_EQ(solveCholesky(Mat4<T>(0), Vec4<T>(1)), Vec4<T>(0));
+}
+
+TYPED_TEST(SolveTest, SymmetricEigen) {
+  using T = TypeParam;
+  const Mat3<T>           a(2, 1, 0, 1, 2, 0, 0, 0, 5);
+  const SymmetricEigen<T> eigen = symmetricEigen(a);
+  EXPECT_TRUE(eigen.values.isApprox(Vec3<T>(5, 3, 1), tolerance<T>()));
+  const Mat3<T> diagonal(eigen.values.x, 0, 0, 0, eigen.values.y, 0, 0, 0, eigen.values.z);
+  EXPECT_TRUE((eigen.vectors * diagonal * eigen.vectors.transposed()).isApprox(a, tolerance<T>()));
+  EXPECT_TRUE((eigen.vectors * eigen.vectors.transposed()).isApprox(Mat3<T>{}, tolerance<T>()));
+  EXPECT_NEAR(eigen.vectors.determinant(), T(1), tolerance<T>());
+  // The principal axis of the cluster.
+  EXPECT_NEAR(std::abs(eigen.vectors.m[2][0]), T(1), tolerance<T>());
+
+  for(std::size_t i = 0; i < 20; ++i) {
+    const Mat3<T>           spd = makeSpd3<T>(i);
+    const SymmetricEigen<T> e   = symmetricEigen(spd);
+    const Mat3<T>           d(e.values.x, 0, 0, 0, e.values.y, 0, 0, 0, e.values.z);
+    EXPECT_GE(e.values.x, e.values.y);
+    EXPECT_GE(e.values.y, e.values.z);
+    EXPECT_TRUE((e.vectors * d * e.vectors.transposed()).isApprox(spd, tolerance<T>() * 100)) << i;
+    EXPECT_NEAR(e.vectors.determinant(), T(1), tolerance<T>());
+  }
+
+  // Repeated eigenvalues.
+  const SymmetricEigen<T> identity = symmetricEigen(Mat3<T>{});
+  EXPECT_EQ(identity.values, Vec3<T>(1));
+  EXPECT_EQ(identity.vectors, Mat3<T>{});
+}
+
+TYPED_TEST(SolveTest, MatrixSoARoundTrip) {
+  using T = TypeParam;
+  std::vector<Mat3<T>> aos3;
+  std::vector<Mat4<T>> aos4;
+  for(std::size_t i = 0; i < 7; ++i) {
+    aos3.push_back(makeMat3<T>(i));
+    aos4.push_back(makeMat4<T>(i));
+  }
+  const Mat3SoA<T>     soa3 = Mat3SoA<T>::FromAoS(aos3.data(), aos3.size());
+  const Mat4SoA<T>     soa4 = Mat4SoA<T>::FromAoS(aos4.data(), aos4.size());
+  std::vector<Mat3<T>> back3(aos3.size());
+  std::vector<Mat4<T>> back4(aos4.size());
+  soa3.toAoS(back3.data());
+  soa4.toAoS(back4.data());
+  EXPECT_EQ(soa3.size(), 7U);
+  for(std::size_t i = 0; i < aos3.size(); ++i) {
+    EXPECT_EQ(back3[i], aos3[i]);
+    EXPECT_EQ(back4[i], aos4[i]);
+    EXPECT_EQ(soa4.row(1).get(i), Vec4<T>(aos4[i].m[1][0], aos4[i].m[1][1], aos4[i].m[1][2], aos4[i].m[1][3]));
+  }
+  Mat3SoA<T> resized(2);
+  resized.resize(3);
+  EXPECT_EQ(resized.get(2), Mat3<T>(0));
+}
+
+TYPED_TEST(SolveTest, BatchedMatchesSingle) {
+  using T                 = TypeParam;
+  const std::size_t count = 37; // Several packs and a scalar tail.
+  Mat3SoA<T>        a3(count);
+  Mat4SoA<T>        a4(count);
+  Mat3SoA<T>        spd3(count);
+  Vec3SoA<T>        b3(count);
+  Vec4SoA<T>        b4(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    a3.set(i, makeMat3<T>(i));
+    a4.set(i, makeMat4<T>(i));
+    spd3.set(i, makeSpd3<T>(i));
+    b3.set(i, makeVec3<T>(i));
+    b4.set(i, makeVec4<T>(i));
+  }
+  // Systems 9, 19 and 29 are singular.
+  Vec3SoA<T> x3;
+  Vec4SoA<T> x4;
+  EXPECT_EQ(solve(a3, b3, x3), 3U);
+  EXPECT_EQ(solve(a4, b4, x4), 3U);
+  Vec3SoA<T> y3;
+  EXPECT_EQ(solveCholesky(spd3, b3, y3), 0U);
+  Vec3SoA<T> values;
+  Mat3SoA<T> vectors;
+  symmetricEigen(spd3, values, vectors);
+
+  ASSERT_EQ(x3.size(), count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const T scale = 1 + static_cast<T>(i);
+    EXPECT_TRUE(x3.get(i).isApprox(solve(a3.get(i), b3.get(i)), tolerance<T>() * scale)) << i;
+    EXPECT_TRUE(x4.get(i).isApprox(solve(a4.get(i), b4.get(i)), tolerance<T>() * scale)) << i;
+    EXPECT_TRUE(y3.get(i).isApprox(solveCholesky(spd3.get(i), b3.get(i)), tolerance<T>() * scale)) << i;
+    const SymmetricEigen<T> eigen = symmetricEigen(spd3.get(i));
+    EXPECT_TRUE(values.get(i).isApprox(eigen.values, tolerance<T>() * scale * scale)) << i;
+    EXPECT_TRUE(vectors.get(i).isApprox(eigen.vectors, tolerance<T>() * 10)) << i;
+  }
+  EXPECT_EQ(x3.get(9), Vec3<T>(0));
+
+  // In place, and with mismatched sizes.
+  solve(a4, b4, b4);
+  EXPECT_TRUE(b4.get(0).isApprox(x4.get(0), tolerance<T>()));
+  EXPECT_THROW(solve(a3, Vec3SoA<T>(count - 1), x3), std::invalid_argument);
+  EXPECT_THROW(solveCholesky(Mat4SoA<T>(2), Vec4SoA<T>(3), x4), std::invalid_argument);
+}
+
+TYPED_TEST(SolveTest, BatchedRejectsNaN) {
+  using T                 = TypeParam;
+  const std::size_t count = 37;
+  const T           small = sizeof(T) == sizeof(float) ? T(1e-7) : T(1e-16);
+  Mat3SoA<T>        a3(count);
+  Mat4SoA<T>        a4(count);
+  Vec3SoA<T>        b3(count);
+  Vec4SoA<T>        b4(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    // Scaled identities, including tiny ones, are well conditioned.
+    const T scale = i % 2 == 0 ? small : T(1);
+    a3.set(i, scaled(Mat3<T>::Identity(), scale));
+    a4.set(i, scaled(Mat4<T>::Identity(), scale));
+    b3.set(i, Vec3<T>(scale));
+    b4.set(i, Vec4<T>(scale));
+  }
+  // One NaN system within the packs and one in the scalar tail.
+  for(const std::size_t i : {std::size_t(2), count - 1}) {
+    Mat3<T> m3 = a3.get(i);
+    Mat4<T> m4 = a4.get(i);
+    m3.m[0][0] = std::numeric_limits<T>::quiet_NaN();
+    m4.m[1][1] = std::numeric_limits<T>::quiet_NaN();
+    a3.set(i, m3);
+    a4.set(i, m4);
+  }
+  Vec3SoA<T> x3;
+  Vec4SoA<T> x4;
+  Vec3SoA<T> y3;
+  EXPECT_EQ(solve(a3, b3, x3), 2U);
+  EXPECT_EQ(solve(a4, b4, x4), 2U);
+  EXPECT_EQ(solveCholesky(a3, b3, y3), 2U);
+  for(std::size_t i = 0; i < count; ++i) {
+    const bool nan = i == 2 || i == count - 1;
+    if(nan) {
+      EXPECT_EQ(x3.get(i), Vec3<T>(0)) << i;
+      EXPECT_EQ(x4.get(i), Vec4<T>(0)) << i;
+      EXPECT_EQ(y3.get(i), Vec3<T>(0)) << i;
+    } else {
+      EXPECT_TRUE(x3.get(i).isApprox(Vec3<T>(1), tolerance<T>())) << i;
+      EXPECT_TRUE(x4.get(i).isApprox(Vec4<T>(1), tolerance<T>())) << i;
+      EXPECT_TRUE(y3.get(i).isApprox(Vec3<T>(1), tolerance<T>())) << i;
+    }
+  }
+}
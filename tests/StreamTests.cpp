@@ -0,0 +1,222 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "TestUtils.hpp"
+#include "linalg/Stream.hpp"
+
+using namespace linalg;
+using test::makeVec3s;
+
+namespace {
+
+template <typename T> std::string serialize(const std::vector<Vec3<T>>& points) {
+  std::ostringstream os(std::ios::binary);
+  writeArray(os, points.data(), points.size());
+  return os.str();
+}
+
+// Source of the integers [0, count) in chunks of at most limit elements.
+class CountingSource final : public ChunkSource<int> {
+public:
+  CountingSource(int count, std::size_t limit) : m_count(count), m_limit(limit) {}
+
+  std::size_t read(int* out, std::size_t capacity) override {
+    ++reads;
+    std::size_t n = 0;
+    for(; n < capacity && n < m_limit && m_next < m_count; ++n) {
+      out[n] = m_next++;
+    }
+    return n;
+  }
+
+  std::atomic<int> reads{0};
+
+private:
+  int         m_count;
+  std::size_t m_limit;
+  int         m_next = 0;
+};
+
+class VectorSink final : public ChunkSink<int> {
+public:
+  void write(const int* data, std::size_t count) override { values.insert(values.end(), data, data + count); }
+  void finish() override { finished = true; }
+
+  std::vector<int> values;
+  bool             finished = false;
+};
+
+class FailingSink final : public ChunkSink<int> {
+public:
+  void write(const int*, std::size_t) override { throw std::runtime_error("disk full"); }
+  void finish() override { FAIL(); }
+};
+
+} // namespace
+
+TEST(StreamTest, StagesSeeEveryChunkInOrder) {
+  CountingSource   source(1000, 1000);
+  VectorSink       sink;
+  std::vector<int> sizes;
+  const std::size_t total = streamChunks(source, sink, 64, [&](int* data, std::size_t count) {
+    sizes.push_back(static_cast<int>(count));
+    for(std::size_t i = 0; i < count; ++i) {
+      data[i] *= 2;
+    }
+  });
+
+  EXPECT_EQ(total, 1000U);
+  ASSERT_EQ(sizes.size(), 16U);
+  EXPECT_EQ(sizes.front(), 64);
+  EXPECT_EQ(sizes.back(), 1000 - 15 * 64);
+  ASSERT_EQ(sink.values.size(), 1000U);
+  for(int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(sink.values[i], 2 * i);
+  }
+  EXPECT_TRUE(sink.finished);
+}
+
+TEST(StreamTest, ShortReadsAreNotTheEnd) {
+  CountingSource source(100, 7);
+  long           sum   = 0;
+  const auto     total = streamChunks(source, 32, [&](int* data, std::size_t count) {
+    EXPECT_LE(count, 7U);
+    for(std::size_t i = 0; i < count; ++i) {
+      sum += data[i];
+    }
+  });
+  EXPECT_EQ(total, 100U);
+  EXPECT_EQ(sum, 99 * 100 / 2);
+
+  CountingSource empty(0, 7);
+  VectorSink     sink;
+  EXPECT_EQ(streamChunks(empty, sink, 32, [](int*, std::size_t) { FAIL(); }), 0U);
+  EXPECT_TRUE(sink.values.empty());
+  EXPECT_TRUE(sink.finished);
+}
+
+TEST(StreamTest, ReadsAheadWhileProcessing) {
+  CountingSource source(40, 10);
+  int            chunks = 0;
+  streamChunks(source, 10, [&](int*, std::size_t) {
+    // The next chunk is read while this one is being processed.
+    const int wanted   = chunks + 2;
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while(source.reads.load() < wanted && std::chrono::steady_clock::now() < timeout) {
+      std::this_thread::yield();
+    }
+    EXPECT_GE(source.reads.load(), wanted) << chunks;
+    ++chunks;
+  });
+  EXPECT_EQ(chunks, 4);
+}
+
+TEST(StreamTest, ErrorsStopTheStream) {
+  CountingSource source(1000, 1000);
+  VectorSink     sink;
+  EXPECT_THROW(streamChunks(source, sink, 10,
+                            [](int* data, std::size_t) {
+                              if(data[0] == 500) {
+                                throw std::runtime_error("bad chunk");
+                              }
+                            }),
+               std::runtime_error);
+  EXPECT_FALSE(sink.finished);
+  EXPECT_LE(sink.values.size(), 500U);
+
+  CountingSource other(1000, 1000);
+  FailingSink    failing;
+  EXPECT_THROW(streamChunks(other, failing, 10, [](int*, std::size_t) {}), std::runtime_error);
+}
+
+template <typename T> class StreamPointsTest : public ::testing::Test {};
+using StreamTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(StreamPointsTest, StreamTypes);
+
+TYPED_TEST(StreamPointsTest, ArraySinkWritesReadableArrays) {
+  using T                          = TypeParam;
+  const std::vector<Vec3<T>> input = makeVec3s<T>(1234);
+  std::istringstream         is(serialize(input), std::ios::binary);
+  ArraySource<Vec3<T>>       source(is);
+  EXPECT_EQ(source.size(), input.size());
+
+  std::stringstream    out(std::ios::in | std::ios::out | std::ios::binary);
+  ArraySink<Vec3<T>>   sink(out);
+  const std::size_t    total = streamChunks(source, sink, 100, [](Vec3<T>*, std::size_t) {});
+  EXPECT_EQ(total, input.size());
+  EXPECT_EQ(sink.size(), input.size());
+
+  out.seekg(0);
+  const AlignedVector<Vec3<T>> copy = readArray<Vec3<T>>(out);
+  ASSERT_EQ(copy.size(), input.size());
+  for(std::size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(copy[i], input[i]);
+  }
+}
+
+TYPED_TEST(StreamPointsTest, TruncatedArraysThrow) {
+  using T                          = TypeParam;
+  const std::vector<Vec3<T>> input = makeVec3s<T>(100);
+  const std::string          bytes = serialize(input);
+  // The count of a seekable stream is checked against its size up front.
+  std::istringstream         is(bytes.substr(0, bytes.size() - sizeof(Vec3<T>) / 2), std::ios::binary);
+  EXPECT_THROW(ArraySource<Vec3<T>>{is}, std::runtime_error);
+
+  // Other streams only find the truncation when the data runs out.
+  test::ForwardOnlyBuffer buffer(bytes.substr(0, bytes.size() - sizeof(Vec3<T>) / 2));
+  std::istream            forward(&buffer);
+  ArraySource<Vec3<T>>    source(forward);
+  EXPECT_THROW(streamBounds(source, 16), std::runtime_error);
+
+  std::istringstream garbage("not an array", std::ios::binary);
+  EXPECT_THROW(ArraySource<Vec3<T>>{garbage}, std::runtime_error);
+}
+
+TYPED_TEST(StreamPointsTest, TransformPointsMatchesBatchKernels) {
+  using T                       = TypeParam;
+  const std::size_t    count    = 3 * parallelChunkSize<Vec3<T>>() + 123;
+  std::vector<Vec3<T>> input    = makeVec3s<T>(count);
+  input[17]                     = Vec3<T>(std::numeric_limits<T>::quiet_NaN(), 0, 0);
+  const Mat4<T>        mat      = Mat4<T>::LookAt(Vec3<T>(5, -6, 7), Vec3<T>(1, 2, 3));
+  std::vector<Vec3<T>> expected(count);
+  transformPoints(mat, input.data(), expected.data(), count);
+  // FromPoints also ignores the NaN point.
+  const AABB<T> expected_bounds = AABB<T>::FromPoints(expected.data(), count);
+
+  const std::string bytes = serialize(input);
+  ThreadPool        pool(4);
+  for(const bool parallel : {false, true}) {
+    std::istringstream   is(bytes, std::ios::binary);
+    ArraySource<Vec3<T>> source(is);
+    std::stringstream    out(std::ios::in | std::ios::out | std::ios::binary);
+    ArraySink<Vec3<T>>   sink(out);
+    // A chunk that is not a multiple of the parallel ranges.
+    const std::size_t chunk  = parallelChunkSize<Vec3<T>>() + 1000;
+    const AABB<T>     bounds = parallel ? transformPoints(pool, source, mat, sink, chunk)
+                                        : transformPoints(source, mat, sink, chunk);
+    EXPECT_EQ(bounds.min, expected_bounds.min) << parallel;
+    EXPECT_EQ(bounds.max, expected_bounds.max) << parallel;
+
+    out.seekg(0);
+    const AlignedVector<Vec3<T>> output = readArray<Vec3<T>>(out);
+    ASSERT_EQ(output.size(), count);
+    for(std::size_t i = 0; i < count; ++i) {
+      if(i != 17) {
+        EXPECT_EQ(output[i], expected[i]) << i;
+      }
+    }
+    EXPECT_TRUE(std::isnan(output[17].x));
+
+    std::istringstream   again(std::string(out.str()), std::ios::binary);
+    ArraySource<Vec3<T>> transformed(again);
+    const AABB<T>        reduced = streamBounds(transformed, 1000);
+    EXPECT_EQ(reduced.min, expected_bounds.min);
+    EXPECT_EQ(reduced.max, expected_bounds.max);
+  }
+}
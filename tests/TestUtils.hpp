@@ -0,0 +1,47 @@
+/**
+ * @file TestUtils.hpp
+ * @brief Fixtures shared by the test sources.
+ */
+#ifndef LINALG_TEST_UTILS_HPP
+#define LINALG_TEST_UTILS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+#include "linalg/Vec3.hpp"
+
+namespace test {
+
+/**
+ * @brief Returns count vectors of varied signs and magnitudes, repeating every
+ * 1000 elements.
+ */
+template <typename T> std::vector<linalg::Vec3<T>> makeVec3s(std::size_t count) {
+  std::vector<linalg::Vec3<T>> vectors;
+  vectors.reserve(count);
+  for(std::size_t i = 0; i < count; ++i) {
+    const T t = static_cast<T>(i % 1000) / 10;
+    vectors.emplace_back(t - 4, 2 - t / 2, std::sin(t) * 10);
+  }
+  return vectors;
+}
+
+/**
+ * @brief Stream buffer over a string that cannot seek, as a pipe or a socket.
+ */
+class ForwardOnlyBuffer : public std::streambuf {
+public:
+  explicit ForwardOnlyBuffer(std::string bytes) : m_bytes(std::move(bytes)) {
+    setg(&m_bytes[0], &m_bytes[0], &m_bytes[0] + m_bytes.size());
+  }
+
+private:
+  std::string m_bytes;
+};
+
+} // namespace test
+
+#endif // LINALG_TEST_UTILS_HPP
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+template <typename T> class ToleranceTest : public ::testing::Test {};
+
+using ToleranceTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(ToleranceTest, ToleranceTypes);
+
+TYPED_TEST(ToleranceTest, ScalarComparison) {
+  using T                     = TypeParam;
+  const T            eps      = std::numeric_limits<T>::epsilon();
+  const T            nan      = std::numeric_limits<T>::quiet_NaN();
+  const T            large    = T(1e6);
+  const Tolerance<T> ulps     = Tolerance<T>::Ulps(4);
+  const Tolerance<T> absolute = Tolerance<T>::Absolute(T(0.5));
+
+  EXPECT_TRUE(ulps(T(1), T(1) + 2 * eps));
+  EXPECT_FALSE(ulps(T(1), T(1) + 16 * eps));
+  // The relative bound scales with the magnitude.
+  EXPECT_TRUE(ulps(large, large * (T(1) + 2 * eps)));
+  EXPECT_TRUE(ulps(T(0), T(0)));
+  EXPECT_TRUE(ulps(T(0), -T(0)));
+  EXPECT_FALSE(ulps(T(0), eps));
+
+  EXPECT_TRUE(absolute(T(1), T(1.5)));
+  EXPECT_FALSE(absolute(T(1), T(1.6)));
+  EXPECT_FALSE(absolute(large, large * T(1.01)));
+
+  EXPECT_FALSE(Tolerance<T>::Default()(nan, nan));
+  EXPECT_FALSE(Tolerance<T>::Default()(T(1), nan));
+  EXPECT_TRUE(Tolerance<T>::Default()(T(1), T(1) + 32 * eps));
+  EXPECT_TRUE(Tolerance<T>::Default()(T(0), 32 * eps));
+}
+
+TYPED_TEST(ToleranceTest, MatricesCompareEveryElement) {
+  using T = TypeParam;
+  const Mat3<T> a3(1, 2, 3, 4, 5, 6, 7, 8, 9);
+  const Mat4<T> a4(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+  EXPECT_EQ(a3, a3);
+  EXPECT_EQ(a4, a4);
+  EXPECT_TRUE(a3.isApprox(a3, T(0)));
+  EXPECT_TRUE(a4.isApprox(a4, T(0)));
+
+  // A difference in any single element, including those handled by the
+  // narrower packs of the remainder, is detected.
+  for(int i = 0; i < 9; ++i) {
+    Mat3<T> b = a3;
+    b(i / 3, i % 3) += T(0.5);
+    EXPECT_NE(a3, b) << i;
+    EXPECT_FALSE(a3.isApprox(b, T(0.25))) << i;
+    EXPECT_TRUE(a3.isApprox(b, T(0.5))) << i;
+    EXPECT_FALSE(a3.isApprox(b)) << i;
+  }
+  for(int i = 0; i < 16; ++i) {
+    Mat4<T> b = a4;
+    b[i] -= T(0.5);
+    EXPECT_NE(a4, b) << i;
+    EXPECT_FALSE(a4.isApprox(b, T(0.25))) << i;
+    EXPECT_TRUE(a4.isApprox(b, T(0.5))) << i;
+    EXPECT_FALSE(a4.isApprox(b)) << i;
+  }
+}
+
+TYPED_TEST(ToleranceTest, MatricesWithSpecialValues) {
+  using T       = TypeParam;
+  const T nan   = std::numeric_limits<T>::quiet_NaN();
+  Mat4<T> zero  = Mat4<T>(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  Mat4<T> minus = zero;
+  minus[5]      = -T(0);
+  EXPECT_EQ(zero, minus);
+
+  Mat4<T> with_nan = Mat4<T>::Identity();
+  with_nan[10]     = nan;
+  EXPECT_NE(with_nan, with_nan);
+  EXPECT_FALSE(with_nan.isApprox(with_nan, T(1)));
+  EXPECT_FALSE(with_nan.isApprox(with_nan));
+
+  Mat3<T> with_nan3 = Mat3<T>::Identity();
+  with_nan3(2, 2)   = nan;
+  EXPECT_NE(with_nan3, with_nan3);
+  EXPECT_FALSE(with_nan3.isApprox(with_nan3, T(1)));
+}
+
+TYPED_TEST(ToleranceTest, RelativeToleranceScalesWithElements) {
+  using T = TypeParam;
+  Mat4<T> a;
+  for(int i = 0; i < 16; ++i) {
+    a[i] = T(1e5) * T(i + 1);
+  }
+  Mat4<T> b = a;
+  b[3] *= T(1) + 8 * std::numeric_limits<T>::epsilon();
+  // An absolute epsilon tuned for elements of magnitude 1 rejects a rounding
+  // difference on large elements, the relative tolerance does not.
+  EXPECT_FALSE(a.isApprox(b, 8 * std::numeric_limits<T>::epsilon()));
+  EXPECT_TRUE(a.isApprox(b));
+  EXPECT_TRUE(a.isApprox(b, Tolerance<T>::Ulps(16)));
+}
+
+TEST(ToleranceInverseTest, Mat3SingularThresholdDependsOnType) {
+  // det = 1e-9: singular within float precision, invertible for double.
+  const Mat3d small(1e-3, 0, 0, 0, 1e-3, 0, 0, 0, 1e-3);
+  const Mat3d inverse = small.inverse();
+  EXPECT_TRUE((small * inverse).isApprox(Mat3d::Identity()));
+  EXPECT_EQ(Mat3f(1e-3F, 0, 0, 0, 1e-3F, 0, 0, 0, 1e-3F).inverse(), Mat3f::Identity());
+  EXPECT_LT(Tolerance<double>::SingularDeterminant(), Tolerance<float>::SingularDeterminant());
+}
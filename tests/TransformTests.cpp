@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename T> Mat4<T> translation(const Vec3<T>& t) {
+  return Mat4<T>(1, 0, 0, t.x, 0, 1, 0, t.y, 0, 0, 1, t.z, 0, 0, 0, 1);
+}
+
+template <typename T> Mat4<T> scaling(const Vec3<T>& s) {
+  return Mat4<T>(s.x, 0, 0, 0, 0, s.y, 0, 0, 0, 0, s.z, 0, 0, 0, 0, 1);
+}
+
+template <typename T> Transform<T> makeTransform() {
+  return {Vec3<T>(1, -2, 3), Quat<T>::FromAxisAngle(Vec3<T>(1, 2, -1).normalized(), T(0.7)), Vec3<T>(2, 0.5, -3)};
+}
+
+// The matrices built with the general Mat4 products and inverses.
+template <typename T> Mat4<T> referenceMatrix(const Transform<T>& transform) {
+  return translation(transform.translation()) * transform.rotation().toMat4() * scaling(transform.scale());
+}
+
+} // namespace
+
+template <typename T> class TransformTest : public ::testing::Test {};
+
+using TransformTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(TransformTest, TransformTypes);
+
+TYPED_TEST(TransformTest, DefaultIsIdentity) {
+  using T = TypeParam;
+  const Transform<T> transform;
+  EXPECT_EQ(transform.matrix(), Mat4<T>::Identity());
+  EXPECT_EQ(transform.inverseMatrix(), Mat4<T>::Identity());
+  EXPECT_EQ(transform.normalMatrix(), Mat3<T>::Identity());
+  EXPECT_EQ(transform.transformPoint(Vec3<T>(1, 2, 3)), Vec3<T>(1, 2, 3));
+}
+
+TYPED_TEST(TransformTest, MatricesMatchGeneralProducts) {
+  using T                      = TypeParam;
+  const Transform<T> transform = makeTransform<T>();
+  const Mat4<T>      expected  = referenceMatrix(transform);
+  const T            epsilon   = T(1e-5);
+  EXPECT_TRUE(transform.matrix().isApprox(expected, epsilon));
+  EXPECT_TRUE(transform.inverseMatrix().isApprox(expected.inverse(), epsilon));
+  EXPECT_TRUE((transform.matrix() * transform.inverseMatrix()).isApprox(Mat4<T>::Identity(), epsilon));
+  EXPECT_TRUE(transform.normalMatrix().isApprox(expected.topLeft3x3().inverse().transposed(), epsilon));
+
+  const Vec3<T> p(0.5, -1, 2);
+  EXPECT_TRUE(transform.transformPoint(p).isApprox(toVec3(expected * toVec4(p)), epsilon));
+  EXPECT_TRUE(transform.transformDirection(p).isApprox(expected.topLeft3x3() * p, epsilon));
+}
+
+TYPED_TEST(TransformTest, SettersInvalidateCaches) {
+  using T                 = TypeParam;
+  const T       epsilon   = T(1e-5);
+  Transform<T>  transform = makeTransform<T>();
+  const Mat3<T> normal    = transform.normalMatrix();
+  transform.matrix();
+  transform.inverseMatrix();
+
+  transform.setTranslation(Vec3<T>(-4, 0, 1));
+  EXPECT_TRUE(transform.matrix().isApprox(referenceMatrix(transform), epsilon));
+  EXPECT_TRUE(transform.inverseMatrix().isApprox(referenceMatrix(transform).inverse(), epsilon));
+  EXPECT_EQ(transform.normalMatrix(), normal);
+
+  transform.setRotation(Quat<T>::FromEuler(T(0.1), T(-0.4), T(1.2)));
+  EXPECT_TRUE(transform.matrix().isApprox(referenceMatrix(transform), epsilon));
+  EXPECT_TRUE(transform.inverseMatrix().isApprox(referenceMatrix(transform).inverse(), epsilon));
+  EXPECT_TRUE(transform.normalMatrix().isApprox(referenceMatrix(transform).topLeft3x3().inverse().transposed(), epsilon));
+
+  transform.setScale(Vec3<T>(0.25, 4, 1));
+  EXPECT_TRUE(transform.matrix().isApprox(referenceMatrix(transform), epsilon));
+  EXPECT_TRUE(transform.inverseMatrix().isApprox(referenceMatrix(transform).inverse(), epsilon));
+  EXPECT_TRUE(transform.normalMatrix().isApprox(referenceMatrix(transform).topLeft3x3().inverse().transposed(), epsilon));
+}
+
+TYPED_TEST(TransformTest, ZeroScaleHasIdentityInverse) {
+  using T = TypeParam;
+  const Transform<T> transform(Vec3<T>(1, 2, 3), Quat<T>(), Vec3<T>(1, 0, 1));
+  EXPECT_EQ(transform.matrix().m[1][1], T(0));
+  EXPECT_EQ(transform.inverseMatrix(), Mat4<T>::Identity());
+  EXPECT_EQ(transform.normalMatrix(), Mat3<T>::Identity());
+}
+
+TYPED_TEST(TransformTest, FromMat4RoundTrips) {
+  using T                       = TypeParam;
+  const T            epsilon    = T(1e-4);
+  const Transform<T> original   = makeTransform<T>();
+  const Transform<T> decomposed = Transform<T>::FromMat4(original.matrix());
+  EXPECT_TRUE(decomposed.matrix().isApprox(original.matrix(), epsilon));
+  EXPECT_TRUE(decomposed.translation().isApprox(original.translation(), epsilon));
+
+  // A rotation with positive scale is recovered exactly, up to the sign of the
+  // quaternion.
+  const Transform<T> positive(Vec3<T>(0, 1, 0), Quat<T>::FromEuler(T(0.3), T(0.2), T(-0.5)), Vec3<T>(1, 2, 3));
+  const Transform<T> recovered = Transform<T>::FromMat4(positive.matrix());
+  EXPECT_TRUE(recovered.scale().isApprox(positive.scale(), epsilon));
+  const Quat<T>& q = recovered.rotation();
+  EXPECT_TRUE(q.isApprox(positive.rotation(), epsilon) || (-q).isApprox(positive.rotation(), epsilon));
+}
@@ -156,6 +156,16 @@ TEST(Vec2dTest, NormalizeZeroVector) {
     EXPECT_EQ(n.y, 0.0);
 }
 
+TEST(Vec2fTest, NormalizedFast) {
+    Vec2f v(3.0f, -4.0f);
+    EXPECT_TRUE(v.normalizedFast().isApprox(v.normalized(), 1e-6f));
+    EXPECT_NEAR(v.lengthFast(), 5.0f, 1e-5f);
+    v.normalizeFast();
+    EXPECT_NEAR(v.x, 0.6f, 1e-6f);
+    EXPECT_NEAR(v.y, -0.8f, 1e-6f);
+    EXPECT_EQ(Vec2f(0.0f, 0.0f).normalizedFast(), Vec2f(0.0f, 0.0f));
+}
+
 TEST(Vec2dTest, IsApproxTrue) {
     Vec2d a(1.0, 2.0);
     Vec2d b(1.0000001, 2.0000001);
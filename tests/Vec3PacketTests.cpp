@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "linalg/linalg.hpp"
+
+using namespace linalg;
+
+namespace {
+
+template <typename P> std::vector<Vec3<float>> makeVectors(float offset) {
+  std::vector<Vec3<float>> vectors;
+  for(int i = 0; i < P::WIDTH; ++i) {
+    const float t = static_cast<float>(i) + offset;
+    vectors.emplace_back(t - 3, 1 - t / 2, t * t / 8);
+  }
+  return vectors;
+}
+
+} // namespace
+
+template <typename P> class Vec3PacketTest : public ::testing::Test {};
+
+using Vec3PacketTypes = ::testing::Types<Vec3x4f, Vec3x8f, Vec3Packet<double, 2>, Vec3Packet<float, 3>>;
+TYPED_TEST_SUITE(Vec3PacketTest, Vec3PacketTypes);
+
+TYPED_TEST(Vec3PacketTest, GatherScatterAndLanes) {
+  using P = TypeParam;
+  using T = decltype(P().x.lane(0));
+  std::vector<Vec3<T>> in;
+  for(const auto& v : makeVectors<P>(0)) {
+    in.emplace_back(v);
+  }
+  const P p = P::Gather(in.data());
+  std::vector<Vec3<T>> out(in.size());
+  p.scatter(out.data());
+  for(int i = 0; i < P::WIDTH; ++i) {
+    EXPECT_EQ(p.lane(i), in[i]);
+    EXPECT_EQ(out[i], in[i]);
+  }
+  EXPECT_EQ(P::Broadcast(in[1]).lane(P::WIDTH - 1), in[1]);
+  EXPECT_EQ(P().lane(0), Vec3<T>(0, 0, 0));
+}
+
+TYPED_TEST(Vec3PacketTest, MatchesScalarOperations) {
+  using P = TypeParam;
+  using T = decltype(P().x.lane(0));
+  std::vector<Vec3<T>> a;
+  std::vector<Vec3<T>> b;
+  for(const auto& v : makeVectors<P>(0)) {
+    a.emplace_back(v);
+  }
+  for(const auto& v : makeVectors<P>(0.5F)) {
+    b.emplace_back(v);
+  }
+  a[0] = Vec3<T>(0, 0, 0);
+
+  const P    pa  = P::Gather(a.data());
+  const P    pb  = P::Gather(b.data());
+  const auto d   = dot(pa, pb);
+  const P    c   = cross(pa, pb);
+  const P    n   = normalized(pa);
+  const P    nf  = normalizedFast(pa);
+  const P    s   = pa + pb * T(2) - (-pb);
+  const T    eps = static_cast<T>(1e-5);
+  for(int i = 0; i < P::WIDTH; ++i) {
+    EXPECT_NEAR(d.lane(i), dot(a[i], b[i]), eps);
+    EXPECT_TRUE(c.lane(i).isApprox(a[i].cross(b[i]), eps));
+    EXPECT_TRUE(n.lane(i).isApprox(a[i].normalized(), eps));
+    EXPECT_TRUE(nf.lane(i).isApprox(a[i].normalizedFast(), eps));
+    EXPECT_TRUE(s.lane(i).isApprox(a[i] + b[i] * T(3), eps));
+  }
+  // x and z grow with the lane index while y shrinks.
+  const Vec3<T>& first = b.front();
+  const Vec3<T>& last  = b.back();
+  EXPECT_EQ(hmin(pb), Vec3<T>(first.x, last.y, first.z));
+  EXPECT_EQ(hmax(pb), Vec3<T>(last.x, first.y, last.z));
+}
+
+TYPED_TEST(Vec3PacketTest, RefractBlendsTotalInternalReflection) {
+  using P = TypeParam;
+  using T = decltype(P().x.lane(0));
+  std::vector<Vec3<T>> incident;
+  std::vector<Vec3<T>> normal;
+  for(int i = 0; i < P::WIDTH; ++i) {
+    // Grazing angles in the last lanes trigger total internal reflection for
+    // eta = 1.5.
+    const T t = static_cast<T>(i + 1) / static_cast<T>(P::WIDTH);
+    incident.push_back(Vec3<T>(t, -1 + t, 0).normalized());
+    normal.emplace_back(0, 1, 0);
+  }
+  const P pi = P::Gather(incident.data());
+  const P pn = P::Gather(normal.data());
+  for(const T eta : {static_cast<T>(0.75), static_cast<T>(1.5)}) {
+    const P refracted = refract(pi, pn, eta);
+    const P reflected = reflect(pi, pn);
+    for(int i = 0; i < P::WIDTH; ++i) {
+      EXPECT_TRUE(refracted.lane(i).isApprox(refract(incident[i], normal[i], eta), static_cast<T>(1e-5)))
+          << "eta " << eta << ", lane " << i;
+      EXPECT_TRUE(reflected.lane(i).isApprox(reflect(incident[i], normal[i]), static_cast<T>(1e-5)));
+    }
+  }
+}
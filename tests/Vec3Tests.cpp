@@ -144,6 +144,32 @@ TEST(Vec3dTest, Normalized) {
     EXPECT_NEAR(n.z, 0.8, 1e-12);
 }
 
+TEST(Vec3fTest, NormalizedFast) {
+    const Vec3f v(1.0f, -3.0f, 4.5f);
+    const Vec3f n = v.normalizedFast();
+    EXPECT_TRUE(n.isApprox(v.normalized(), 1e-6f));
+    EXPECT_NEAR(v.lengthFast(), v.length(), 1e-5f);
+
+    Vec3f w = v;
+    w.normalizeFast();
+    EXPECT_EQ(w, n);
+
+    // Zero and subnormal squared lengths go through normalized().
+    EXPECT_EQ(Vec3f(0.0f).normalizedFast(), Vec3f(0.0f));
+    EXPECT_EQ(Vec3f(0.0f).lengthFast(), 0.0f);
+    const Vec3f tiny(1e-20f, 0.0f, 0.0f);
+    EXPECT_EQ(tiny.normalizedFast(), tiny.normalized());
+    Vec3f zero(0.0f);
+    zero.normalizeFast();
+    EXPECT_EQ(zero, Vec3f(0.0f));
+}
+
+TEST(Vec3dTest, NormalizedFast) {
+    const Vec3d v(0.0, 3.0, 4.0);
+    EXPECT_TRUE(v.normalizedFast().isApprox(v.normalized(), 1e-15));
+    EXPECT_DOUBLE_EQ(v.lengthFast(), 5.0);
+}
+
 TEST(Vec3dTest, CrossProduct) {
     Vec3d a(1.0, 0.0, 0.0);
     Vec3d b(0.0, 1.0, 0.0);
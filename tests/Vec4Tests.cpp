@@ -153,6 +153,15 @@ TEST(Vec4dTest, Normalized) {
   EXPECT_DOUBLE_EQ(n.w, 0.0);
 }
 
+TEST(Vec4fTest, NormalizedFast) {
+  Vec4f v(1, -2, 3, 0.5F);
+  EXPECT_TRUE(v.normalizedFast().isApprox(v.normalized(), 1e-6F));
+  EXPECT_NEAR(v.lengthFast(), v.length(), 1e-5F);
+  v.normalizeFast();
+  EXPECT_NEAR(v.length(), 1.0F, 1e-6F);
+  EXPECT_EQ(Vec4f(0, 0, 0, 0).normalizedFast(), Vec4f(0, 0, 0, 0));
+}
+
 TEST(Vec4dTest, IsApproxTrue) {
   Vec4d a(1.0001, 2.0001, 3.0001, 4.0001);
   Vec4d b(1.0002, 2.0002, 3.0002, 4.0002);
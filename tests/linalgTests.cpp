@@ -1,4 +1,6 @@
+#include <cmath>
 #include <gtest/gtest.h>
+#include <vector>
 #include "linalg/linalg.hpp"
 
 using namespace linalg;
@@ -162,6 +164,16 @@ TEST(LinMatrixTest, Mat4dVec4dMultiplication) {
     EXPECT_EQ(result, Vec4d(30, 70, 110, 150));
 }
 
+TEST(LinMatrixTest, Mat4fVec4fMultiplication) {
+    Mat4f m({{1, 2, 3, 4},
+            {5, 6, 7, 8},
+            {9, 10, 11, 12},
+            {13, 14, 15, 16}});
+    Vec4f v = {1, 2, 3, 4};
+    Vec4f result = m * v;
+    EXPECT_EQ(result, Vec4f(30, 70, 110, 150));
+}
+
 TEST(LinRotationTest, RotationMatrixOrthogonality) {
     Mat3d rot = getRotationMatrix(0.1, 0.2, 0.3);
     Mat3d transposed = rot.transposed();
@@ -170,3 +182,36 @@ TEST(LinRotationTest, RotationMatrixOrthogonality) {
         for (int j = 0; j < 3; ++j)
             EXPECT_NEAR(identity.m[i][j], i == j ? 1.0 : 0.0, EPS);
 }
+
+TEST(RotationMatrixTest, MatchesProductOfAxisRotations) {
+  const double x = 0.4;
+  const double y = -1.2;
+  const double z = 2.1;
+  const Mat3d  rx({{1, 0, 0}, {0, std::cos(x), -std::sin(x)}, {0, std::sin(x), std::cos(x)}});
+  const Mat3d  ry({{std::cos(y), 0, std::sin(y)}, {0, 1, 0}, {-std::sin(y), 0, std::cos(y)}});
+  const Mat3d  rz({{std::cos(z), -std::sin(z), 0}, {std::sin(z), std::cos(z), 0}, {0, 0, 1}});
+  static_assert(noexcept(getRotationMatrix(x, y, z)), "getRotationMatrix must not throw");
+  EXPECT_TRUE(getRotationMatrix(x, y, z).isApprox(rz * ry * rx, 1e-12));
+}
+
+TEST(RotationMatrixTest, BulkMatchesSingle) {
+  // 37 angles exercise the packs and the scalar tail.
+  std::vector<float>  xf, yf, zf;
+  std::vector<double> xd, yd, zd;
+  for(int i = 0; i < 37; ++i) {
+    xd.push_back(0.37 * i - 6);
+    yd.push_back(-0.81 * i + 10);
+    zd.push_back(2.5 * std::sin(i));
+    xf.push_back(static_cast<float>(xd.back()));
+    yf.push_back(static_cast<float>(yd.back()));
+    zf.push_back(static_cast<float>(zd.back()));
+  }
+  std::vector<Mat3f> outf(xf.size());
+  std::vector<Mat3d> outd(xd.size());
+  getRotationMatrices(xf.data(), yf.data(), zf.data(), outf.data(), outf.size());
+  getRotationMatrices(xd.data(), yd.data(), zd.data(), outd.data(), outd.size());
+  for(std::size_t i = 0; i < outf.size(); ++i) {
+    EXPECT_TRUE(outf[i].isApprox(getRotationMatrix(xf[i], yf[i], zf[i]), 1e-6F)) << i;
+    EXPECT_TRUE(outd[i].isApprox(getRotationMatrix(xd[i], yd[i], zd[i]), 1e-14)) << i;
+  }
+}